@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+//lock-free queue for many producers and one consumer
+//producers push single elements, the consumer takes all queued elements at once in the order in which they were pushed
+template <typename T>
+class ConcurrentQueue
+{
+public:
+    ConcurrentQueue() = default;
+    ~ConcurrentQueue();
+
+    ConcurrentQueue(ConcurrentQueue const&) = delete;
+    ConcurrentQueue& operator=(ConcurrentQueue const&) = delete;
+
+    void push(T&& value);
+
+    bool isEmpty() const;
+    std::vector<T> popAll();
+
+private:
+    struct Node
+    {
+        T value;
+        Node* next = nullptr;
+    };
+    std::atomic<Node*> _head{nullptr};  //most recently pushed element
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+template <typename T>
+ConcurrentQueue<T>::~ConcurrentQueue()
+{
+    auto node = _head.load();
+    while (node) {
+        auto next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+template <typename T>
+void ConcurrentQueue<T>::push(T&& value)
+{
+    auto node = new Node{std::move(value), _head.load(std::memory_order_relaxed)};
+    while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+template <typename T>
+bool ConcurrentQueue<T>::isEmpty() const
+{
+    return _head.load(std::memory_order_relaxed) == nullptr;
+}
+
+template <typename T>
+std::vector<T> ConcurrentQueue<T>::popAll()
+{
+    auto node = _head.exchange(nullptr, std::memory_order_acquire);
+
+    //the nodes are linked from the newest to the oldest element
+    Node* oldestNode = nullptr;
+    while (node) {
+        auto next = node->next;
+        node->next = oldestNode;
+        oldestNode = node;
+        node = next;
+    }
+
+    std::vector<T> result;
+    while (oldestNode) {
+        result.emplace_back(std::move(oldestNode->value));
+        auto next = oldestNode->next;
+        delete oldestNode;
+        oldestNode = next;
+    }
+    return result;
+}
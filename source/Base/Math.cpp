@@ -1,5 +1,6 @@
 #include "Math.h"
 
+#include <algorithm>
 #include <cmath>
 
 float Math::length(RealVector2D const& v)
@@ -7,6 +8,21 @@ float Math::length(RealVector2D const& v)
     return sqrt(v.x * v.x + v.y * v.y);
 }
 
+float Math::lengthSquared(RealVector2D const& v)
+{
+    return v.x * v.x + v.y * v.y;
+}
+
+float Math::lengthMax(RealVector2D const& v)
+{
+    return std::max(std::abs(v.x), std::abs(v.y));
+}
+
+float Math::dot(RealVector2D const& p, RealVector2D const& q)
+{
+    return p.x * q.x + p.y * q.y;
+}
+
 float Math::angleOfVector(RealVector2D const& v)
 {
     auto vLength = length(v);
@@ -23,6 +39,14 @@ float Math::angleOfVector(RealVector2D const& v)
     return angle;
 }
 
+RealVector2D Math::rotateQuarterClockwise(RealVector2D v)
+{
+    auto temp = v.x;
+    v.x = -v.y;
+    v.y = temp;
+    return v;
+}
+
 RealVector2D Math::rotateQuarterCounterClockwise(RealVector2D v)
 {
     auto temp = v.x;
@@ -61,6 +85,12 @@ void Math::normalize(RealVector2D& v)
     }
 }
 
+RealVector2D Math::normalized(RealVector2D v)
+{
+    normalize(v);
+    return v;
+}
+
 float Math::subtractAngle(float angleMinuend, float angleSubtrahend)
 {
     auto angleDiff = angleMinuend - angleSubtrahend;
@@ -88,6 +118,28 @@ bool Math::isAngleInBetween(float angle1, float angle2, float angleBetweenCandid
     return angle2 - angle1 < 360.0f;
 }
 
+bool Math::isInBetweenModulo(float value1, float value2, float candidate, float size)
+{
+    if (value2 - value1 >= size) {
+        return true;
+    }
+    auto valueMod1 = modulo(value1, size);
+    auto valueMod2 = modulo(value2, size);
+    auto candidateMod = modulo(candidate, size);
+
+    if (valueMod1 == valueMod2 && valueMod1 != candidateMod) {
+        return false;
+    }
+    if (candidateMod < valueMod1) {
+        candidateMod += size;
+        valueMod2 += size;
+    }
+    if (valueMod2 < candidateMod) {
+        valueMod2 += size;
+    }
+    return valueMod2 - valueMod1 < size;
+}
+
 bool Math::crossing(
     RealVector2D const& segmentStart,
     RealVector2D const& segmentEnd,
@@ -125,6 +177,27 @@ float Math::modulo(float value, float size)
     return fmodf(fmodf(value, size) + size, size);
 }
 
+float Math::calcDistanceToLineSegment(RealVector2D const& startSegment, RealVector2D const& endSegment, RealVector2D const& pos, float boundary)
+{
+    auto relPos = pos - startSegment;
+    auto segmentDirection = endSegment - startSegment;
+    auto segmentLength = length(segmentDirection);
+    if (segmentLength < NEAR_ZERO) {
+        return boundary + 1.0f;
+    }
+    segmentDirection = segmentDirection / segmentLength;
+    auto normal = rotateQuarterCounterClockwise(segmentDirection);
+    auto signedDistanceFromLine = dot(relPos, normal);
+    if (std::abs(signedDistanceFromLine) > boundary) {
+        return boundary + 1.0f;
+    }
+    auto signedDistanceFromStart = dot(relPos, segmentDirection);
+    if (signedDistanceFromStart < 0 || signedDistanceFromStart > segmentLength) {
+        return boundary + 1.0f;
+    }
+    return std::abs(signedDistanceFromLine);
+}
+
 float Math::sigmoid(float x)
 {
     return 2.0f / (1.0f + expf(-x)) - 1.0f;
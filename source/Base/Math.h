@@ -13,16 +13,23 @@ class Math
 {
 public:
     static float length(RealVector2D const& v);
+    static float lengthSquared(RealVector2D const& v);
+    static float lengthMax(RealVector2D const& v);
+    static float dot(RealVector2D const& p, RealVector2D const& q);
     static float angleOfVector(RealVector2D const& v);
+    static RealVector2D rotateQuarterClockwise(RealVector2D v);
     static RealVector2D rotateQuarterCounterClockwise(RealVector2D v);
     static RealVector2D unitVectorOfAngle(float angleInDeg);
     static RealMatrix2D calcRotationMatrix(float angleInDeg);  //rotation is clockwise
     static RealVector2D rotateClockwise(RealVector2D const& v, float angle);
     static void normalize(RealVector2D& v);
+    static RealVector2D normalized(RealVector2D v);
     static float subtractAngle(float angleMinuend, float angleSubtrahend);
     static bool isAngleInBetween(float angle1, float angle2, float angleBetweenCandidate);
+    static bool isInBetweenModulo(float value1, float value2, float candidate, float size);
     static bool crossing(RealVector2D const& segmentStart, RealVector2D const& segmentEnd, RealVector2D const& otherSegmentStart, RealVector2D const& otherSegmentEnd);
     static float modulo(float value, float size);
+    static float calcDistanceToLineSegment(RealVector2D const& startSegment, RealVector2D const& endSegment, RealVector2D const& pos, float boundary = 0);
 
     static float sigmoid(float x);
     static float binaryStep(float x);
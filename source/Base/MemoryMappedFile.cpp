@@ -0,0 +1,102 @@
+#include "MemoryMappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+_MemoryMappedFile::_MemoryMappedFile(std::string const& filename)
+{
+    auto fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open " + filename + ".");
+    }
+    _fileHandle = fileHandle;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size)) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Could not determine size of " + filename + ".");
+    }
+    _size = static_cast<uint64_t>(size.QuadPart);
+    if (_size == 0) {
+        return;
+    }
+
+    auto mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Could not map " + filename + ".");
+    }
+    _mappingHandle = mappingHandle;
+
+    _data = static_cast<uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0));
+    if (!_data) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Could not map " + filename + ".");
+    }
+}
+
+_MemoryMappedFile::~_MemoryMappedFile()
+{
+    if (_data) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mappingHandle) {
+        CloseHandle(_mappingHandle);
+    }
+    if (_fileHandle) {
+        CloseHandle(_fileHandle);
+    }
+}
+#else
+_MemoryMappedFile::_MemoryMappedFile(std::string const& filename)
+{
+    auto fileDescriptor = open(filename.c_str(), O_RDONLY);
+    if (fileDescriptor == -1) {
+        throw std::runtime_error("Could not open " + filename + ".");
+    }
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) == -1) {
+        close(fileDescriptor);
+        throw std::runtime_error("Could not determine size of " + filename + ".");
+    }
+    _size = static_cast<uint64_t>(fileStatus.st_size);
+    if (_size == 0) {
+        close(fileDescriptor);
+        return;
+    }
+
+    auto data = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);  //mapping stays valid
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Could not map " + filename + ".");
+    }
+    madvise(data, _size, MADV_SEQUENTIAL);
+    _data = static_cast<uint8_t*>(data);
+}
+
+_MemoryMappedFile::~_MemoryMappedFile()
+{
+    if (_data) {
+        munmap(_data, _size);
+    }
+}
+#endif
+
+uint8_t* _MemoryMappedFile::getData() const
+{
+    return _data;
+}
+
+uint64_t _MemoryMappedFile::getSize() const
+{
+    return _size;
+}
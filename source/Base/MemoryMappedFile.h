@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+#include "Definitions.h"
+
+//private (copy-on-write) mapping of a whole file: writes to the mapped memory are never propagated to the file
+class _MemoryMappedFile
+{
+public:
+    _MemoryMappedFile(std::string const& filename);
+    ~_MemoryMappedFile();
+
+    _MemoryMappedFile(_MemoryMappedFile const&) = delete;
+    _MemoryMappedFile& operator=(_MemoryMappedFile const&) = delete;
+
+    uint8_t* getData() const;
+    uint64_t getSize() const;
+
+private:
+    uint8_t* _data = nullptr;
+    uint64_t _size = 0;
+
+#ifdef _WIN32
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#endif
+};
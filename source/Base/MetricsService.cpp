@@ -0,0 +1,304 @@
+#include "MetricsService.h"
+
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "Definitions.h"
+
+namespace
+{
+    auto constexpr ThreadBufferCapacity = 8192;  //must be a power of two
+    auto constexpr MaxTraceEvents = 500000;
+    std::chrono::milliseconds const CollectInterval(100);
+
+    std::string escapeJson(std::string const& value)
+    {
+        std::string result;
+        for (auto const& c : value) {
+            if (c == '"' || c == '\\') {
+                result.push_back('\\');
+            }
+            result.push_back(c);
+        }
+        return result;
+    }
+}
+
+//ring buffer with the emitting thread as the only producer and the collector as the only consumer
+class MetricsService::ThreadBuffer
+{
+public:
+    ThreadBuffer(int threadId)
+        : _threadId(threadId)
+    {}
+
+    int getThreadId() const { return _threadId; }
+
+    void push(Event const& event)
+    {
+        auto head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= ThreadBufferCapacity) {
+            _numDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        _events[head % ThreadBufferCapacity] = event;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    template <typename Func>
+    void popAll(Func const& func)
+    {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        auto head = _head.load(std::memory_order_acquire);
+        for (auto i = tail; i != head; ++i) {
+            func(_events[i % ThreadBufferCapacity]);
+        }
+        _tail.store(head, std::memory_order_release);
+    }
+
+    bool isEmpty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_relaxed); }
+    uint64_t fetchNumDroppedEvents() { return _numDroppedEvents.exchange(0, std::memory_order_relaxed); }
+
+private:
+    int _threadId;
+    std::array<Event, ThreadBufferCapacity> _events;
+    std::atomic<uint64_t> _head{0};
+    std::atomic<uint64_t> _tail{0};
+    std::atomic<uint64_t> _numDroppedEvents{0};
+};
+
+std::atomic<bool> MetricsService::_enabled{false};
+
+namespace
+{
+    thread_local char const* currentThreadName = nullptr;
+}
+
+MetricsService::MetricsService()
+    : _startTimepoint(std::chrono::steady_clock::now())
+{}
+
+MetricsService::~MetricsService()
+{
+    setEnabled(false);
+}
+
+void MetricsService::setEnabled(bool value)
+{
+    std::lock_guard enableLock(_enableMutex);
+    std::thread* collectorThread = nullptr;
+    {
+        std::lock_guard lock(_mutex);
+        _enabled.store(value);
+        if (value && !_collectorThread) {
+            _collectorThread = new std::thread(&MetricsService::runCollectorLoop, this);
+        }
+        if (!value) {
+            collectorThread = _collectorThread;
+            _collectorThread = nullptr;
+        }
+    }
+    if (collectorThread) {
+        _condition.notify_all();
+        collectorThread->join();
+        delete collectorThread;
+
+        std::lock_guard lock(_mutex);
+        collect();
+    }
+}
+
+void MetricsService::incrementCounter(char const* name, int64_t delta)
+{
+    if (isEnabled()) {
+        pushEvent({EventType::Counter, name, std::chrono::steady_clock::now(), static_cast<double>(delta)});
+    }
+}
+
+void MetricsService::setGauge(char const* name, double value)
+{
+    if (isEnabled()) {
+        pushEvent({EventType::Gauge, name, std::chrono::steady_clock::now(), value});
+    }
+}
+
+void MetricsService::addDuration(
+    char const* name,
+    std::chrono::steady_clock::time_point const& startTimepoint,
+    std::chrono::steady_clock::time_point const& endTimepoint)
+{
+    if (isEnabled()) {
+        pushEvent({EventType::Timer, name, startTimepoint, std::chrono::duration<double, std::micro>(endTimepoint - startTimepoint).count()});
+    }
+}
+
+void MetricsService::setThreadName(char const* name)
+{
+    currentThreadName = name;
+}
+
+void MetricsService::setPeriodicDump(std::optional<std::filesystem::path> const& filename, std::chrono::milliseconds const& interval)
+{
+    std::lock_guard lock(_mutex);
+    _dumpFilename = filename;
+    _dumpInterval = interval;
+    _lastDumpTimepoint.reset();
+}
+
+std::string MetricsService::getMetricsDump()
+{
+    std::lock_guard lock(_mutex);
+    collect();
+    return getMetricsDumpIntern();
+}
+
+int64_t MetricsService::getCounter(std::string const& name)
+{
+    std::lock_guard lock(_mutex);
+    collect();
+    auto findResult = _counters.find(name);
+    return findResult != _counters.end() ? findResult->second : 0;
+}
+
+std::string MetricsService::getChromeTraceJson()
+{
+    std::lock_guard lock(_mutex);
+    collect();
+
+    std::stringstream stream;
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    auto separator = "";
+    for (auto const& [threadId, name] : _threadNames) {
+        stream << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId << ",\"args\":{\"name\":\"" << escapeJson(name)
+               << "\"}}";
+        separator = ",";
+    }
+    for (auto const& event : _traceEvents) {
+        stream << separator << "{\"name\":\"" << escapeJson(event.name) << "\",\"pid\":1,\"tid\":" << event.threadId << ",\"ts\":" << event.timestamp;
+        if (event.type == EventType::Timer) {
+            stream << ",\"ph\":\"X\",\"dur\":" << event.value << "}";
+        } else {
+            stream << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+        }
+        separator = ",";
+    }
+    stream << "]}";
+    return stream.str();
+}
+
+bool MetricsService::writeChromeTraceToFile(std::filesystem::path const& filename)
+{
+    std::ofstream stream(filename, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    stream << getChromeTraceJson();
+    return static_cast<bool>(stream);
+}
+
+void MetricsService::reset()
+{
+    std::lock_guard lock(_mutex);
+    collect();
+    _counters.clear();
+    _gauges.clear();
+    _timers.clear();
+    _traceEvents.clear();
+    _numDroppedEvents = 0;
+}
+
+void MetricsService::pushEvent(Event const& event)
+{
+    thread_local std::shared_ptr<ThreadBuffer> threadBuffer;
+    if (!threadBuffer) {
+        threadBuffer = get().registerThreadBuffer();
+    }
+    threadBuffer->push(event);
+}
+
+auto MetricsService::registerThreadBuffer() -> std::shared_ptr<ThreadBuffer>
+{
+    std::lock_guard lock(_mutex);
+    auto result = std::make_shared<ThreadBuffer>(_nextThreadId++);
+    if (currentThreadName) {
+        _threadNames.emplace(result->getThreadId(), currentThreadName);
+    }
+    _threadBuffers.emplace_back(result);
+    return result;
+}
+
+void MetricsService::runCollectorLoop()
+{
+    std::unique_lock lock(_mutex);
+    while (_enabled.load()) {
+        _condition.wait_for(lock, CollectInterval, [] { return !_enabled.load(); });
+        collect();
+
+        auto now = std::chrono::steady_clock::now();
+        if (_dumpFilename && (!_lastDumpTimepoint || now - *_lastDumpTimepoint >= _dumpInterval)) {
+            _lastDumpTimepoint = now;
+            std::ofstream stream(*_dumpFilename, std::ios::app);
+            stream << getMetricsDumpIntern() << std::endl;
+        }
+    }
+}
+
+void MetricsService::collect()
+{
+    for (auto const& threadBuffer : _threadBuffers) {
+        auto threadId = threadBuffer->getThreadId();
+        threadBuffer->popAll([&](Event const& event) {
+            auto timestamp = std::chrono::duration<double, std::micro>(event.timepoint - _startTimepoint).count();
+            auto traceValue = event.value;
+            switch (event.type) {
+            case EventType::Counter: {
+                auto& counter = _counters[event.name];
+                counter += static_cast<int64_t>(event.value);
+                traceValue = static_cast<double>(counter);
+            } break;
+            case EventType::Gauge:
+                _gauges[event.name] = event.value;
+                break;
+            case EventType::Timer: {
+                auto& timer = _timers[event.name];
+                ++timer.count;
+                timer.totalDuration += event.value;
+                timer.maxDuration = std::max(timer.maxDuration, event.value);
+            } break;
+            }
+            _traceEvents.push_back({event.type, event.name, threadId, timestamp, traceValue});
+        });
+        _numDroppedEvents += threadBuffer->fetchNumDroppedEvents();
+    }
+    while (_traceEvents.size() > MaxTraceEvents) {
+        _traceEvents.pop_front();
+    }
+
+    //buffers of terminated threads are only referenced here
+    std::erase_if(_threadBuffers, [](auto const& threadBuffer) { return threadBuffer.use_count() == 1 && threadBuffer->isEmpty(); });
+}
+
+std::string MetricsService::getMetricsDumpIntern()
+{
+    std::stringstream stream;
+    stream << std::fixed << std::setprecision(3);
+    stream << "time: " << std::chrono::duration<double>(std::chrono::steady_clock::now() - _startTimepoint).count() << " s" << std::endl;
+    stream << "timers (count, total ms, mean ms, max ms):" << std::endl;
+    for (auto const& [name, timer] : _timers) {
+        stream << "  " << name << " " << timer.count << " " << timer.totalDuration / 1000 << " " << timer.totalDuration / 1000 / toDouble(timer.count) << " "
+               << timer.maxDuration / 1000 << std::endl;
+    }
+    stream << "counters:" << std::endl;
+    for (auto const& [name, value] : _counters) {
+        stream << "  " << name << " " << value << std::endl;
+    }
+    stream << "gauges:" << std::endl;
+    for (auto const& [name, value] : _gauges) {
+        stream << "  " << name << " " << value << std::endl;
+    }
+    stream << "dropped events: " << _numDroppedEvents << std::endl;
+    return stream.str();
+}
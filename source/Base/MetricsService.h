@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Singleton.h"
+
+//instrumentation of named counters, gauges and timers
+//events are written into lock-free buffers of the emitting threads and are collected by a background thread as long as metrics are enabled
+//if metrics are disabled recording an event only costs a relaxed atomic load
+//names must refer to string literals since only the pointers are stored in the buffers
+class MetricsService
+{
+    MAKE_SINGLETON_NO_DEFAULT_CONSTRUCTION(MetricsService);
+
+public:
+    ~MetricsService();
+
+    static bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool value);
+
+    static void incrementCounter(char const* name, int64_t delta = 1);
+    static void setGauge(char const* name, double value);
+    static void
+    addDuration(char const* name, std::chrono::steady_clock::time_point const& startTimepoint, std::chrono::steady_clock::time_point const& endTimepoint);
+
+    //name of the calling thread shown in traces, should be set before the thread records its first event
+    static void setThreadName(char const* name);
+
+    //appends the metrics dump to the given file in the specified interval as long as metrics are enabled
+    void setPeriodicDump(std::optional<std::filesystem::path> const& filename, std::chrono::milliseconds const& interval = std::chrono::seconds(10));
+
+    std::string getMetricsDump();
+    int64_t getCounter(std::string const& name);  //0 if the counter has not been incremented since the last reset
+    std::string getChromeTraceJson();  //can be opened in chrome://tracing or Perfetto
+    bool writeChromeTraceToFile(std::filesystem::path const& filename);
+    void reset();
+
+private:
+    MetricsService();
+
+    enum class EventType
+    {
+        Counter,
+        Gauge,
+        Timer
+    };
+    struct Event
+    {
+        EventType type;
+        char const* name;
+        std::chrono::steady_clock::time_point timepoint;
+        double value;  //delta for counters, duration in microseconds for timers
+    };
+    class ThreadBuffer;
+    static void pushEvent(Event const& event);
+    std::shared_ptr<ThreadBuffer> registerThreadBuffer();
+
+    void runCollectorLoop();
+    void collect();  //_mutex must be locked
+    std::string getMetricsDumpIntern();  //_mutex must be locked
+
+    static std::atomic<bool> _enabled;
+
+    std::mutex _enableMutex;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::thread* _collectorThread = nullptr;
+    std::chrono::steady_clock::time_point _startTimepoint;
+    std::vector<std::shared_ptr<ThreadBuffer>> _threadBuffers;
+    int _nextThreadId = 1;
+
+    std::optional<std::filesystem::path> _dumpFilename;
+    std::chrono::milliseconds _dumpInterval = std::chrono::seconds(10);
+    std::optional<std::chrono::steady_clock::time_point> _lastDumpTimepoint;
+
+    //aggregated data
+    struct TimerStatistics
+    {
+        uint64_t count = 0;
+        double totalDuration = 0;  //in microseconds
+        double maxDuration = 0;
+    };
+    struct TraceEvent
+    {
+        EventType type;
+        char const* name;
+        int threadId;
+        double timestamp;  //in microseconds since _startTimepoint
+        double value;      //counter total, gauge value or timer duration
+    };
+    std::map<std::string, int64_t> _counters;
+    std::map<std::string, double> _gauges;
+    std::map<std::string, TimerStatistics> _timers;
+    std::map<int, std::string> _threadNames;
+    std::deque<TraceEvent> _traceEvents;
+    uint64_t _numDroppedEvents = 0;
+};
+
+//measures the duration of its lifetime if metrics are enabled on construction
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(char const* name)
+        : _name(name)
+    {
+        if (MetricsService::isEnabled()) {
+            _startTimepoint = std::chrono::steady_clock::now();
+        }
+    }
+    ~ScopedTimer()
+    {
+        if (_startTimepoint) {
+            MetricsService::addDuration(_name, *_startTimepoint, std::chrono::steady_clock::now());
+        }
+    }
+
+    ScopedTimer(ScopedTimer const&) = delete;
+    ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+private:
+    char const* _name;
+    std::optional<std::chrono::steady_clock::time_point> _startTimepoint;
+};
+
+#define MEASURE_SCOPE_CONCAT_INTERN(a, b) a##b
+#define MEASURE_SCOPE_CONCAT(a, b) MEASURE_SCOPE_CONCAT_INTERN(a, b)
+#define MEASURE_SCOPE(name) ScopedTimer MEASURE_SCOPE_CONCAT(scopedTimer, __LINE__)(name)
@@ -1,20 +1,96 @@
-#include <sstream>
-#include <thread>
+#include <limits>
+#include <optional>
 #include <random>
 
 #include "NumberGenerator.h"
 
-NumberGenerator::NumberGenerator()
+namespace
 {
-    _arrayOfRandomNumbers.reserve(1323781);
-    _runningNumber = 0;
-    std::random_device rd;   //Will be used to obtain a seed for the random number engine
-    std::mt19937 gen(rd());  //Standard mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<> distrib(0);
+    auto constexpr ThreadStreamFlag = static_cast<uint64_t>(1) << 63;  //separates thread streams from streams created by createStream
+
+    uint64_t splitMix64(uint64_t& value)
+    {
+        value += 0x9e3779b97f4a7c15ull;
+        auto result = value;
+        result = (result ^ (result >> 30)) * 0xbf58476d1ce4e5b9ull;
+        result = (result ^ (result >> 27)) * 0x94d049bb133111ebull;
+        return result ^ (result >> 31);
+    }
 
-    for (uint32_t i = 0; i < 1323781; ++i) {
-        _arrayOfRandomNumbers.emplace_back(distrib(gen));
+    uint64_t rotateLeft(uint64_t value, int shift)
+    {
+        return (value << shift) | (value >> (64 - shift));
     }
+
+    struct ThreadStreamData
+    {
+        uint64_t epoch = std::numeric_limits<uint64_t>::max();
+        std::optional<RandomStream> stream;
+    };
+    thread_local ThreadStreamData threadStreamData;
+}
+
+RandomStream::RandomStream(uint64_t seed, uint64_t streamId)
+{
+    auto value = seed ^ splitMix64(streamId);
+    for (auto& state : _state) {
+        state = splitMix64(value);
+    }
+}
+
+uint64_t RandomStream::next()
+{
+    auto result = rotateLeft(_state[1] * 5, 7) * 9;
+    auto t = _state[1] << 17;
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = rotateLeft(_state[3], 45);
+    return result;
+}
+
+uint32_t RandomStream::getRandomInt()
+{
+    return static_cast<uint32_t>(next() >> 33);
+}
+
+uint32_t RandomStream::getRandomInt(uint32_t range)
+{
+    return getRandomInt() % range;
+}
+
+uint32_t RandomStream::getRandomInt(uint32_t min, uint32_t max)
+{
+    auto delta = max - min + 1;
+    return min + (getRandomInt() % delta);
+}
+
+uint32_t RandomStream::getLargeRandomInt(uint32_t range)
+{
+    return getRandomInt() % (range + 1);
+}
+
+double RandomStream::getRandomReal(double min, double max)
+{
+    return static_cast<double>(getLargeRandomInt(static_cast<int>((max - min) * 1000)) / 1000.0 + min);
+}
+
+float RandomStream::getRandomFloat(float min, float max)
+{
+    return toFloat(getRandomReal(min, max));
+}
+
+double RandomStream::getRandomReal()
+{
+    return static_cast<double>(getRandomInt()) / static_cast<double>(std::numeric_limits<int>::max());
+}
+
+NumberGenerator::NumberGenerator()
+{
+    std::random_device rd;
+    _seed = (static_cast<uint64_t>(rd()) << 32) | rd();
 }
 
 NumberGenerator::~NumberGenerator()
@@ -27,40 +103,58 @@ NumberGenerator& NumberGenerator::get()
     return instance;
 }
 
+void NumberGenerator::setSeed(uint64_t seed)
+{
+    std::lock_guard lock(_mutex);
+    _seed = seed;
+    _nextStreamId = 0;
+    ++_epoch;
+}
+
+uint64_t NumberGenerator::getSeed() const
+{
+    std::lock_guard lock(_mutex);
+    return _seed;
+}
+
+RandomStream NumberGenerator::createStream(uint64_t streamId) const
+{
+    return RandomStream(getSeed(), streamId & ~ThreadStreamFlag);
+}
+
 uint32_t NumberGenerator::getRandomInt()
 {
-	return getNumberFromArray();
+    return getThreadStream().getRandomInt();
 }
 
 uint32_t NumberGenerator::getRandomInt(uint32_t range)
 {
-	return getNumberFromArray() % range;
+    return getThreadStream().getRandomInt(range);
 }
 
 uint32_t NumberGenerator::getRandomInt(uint32_t min, uint32_t max)
 {
-    auto delta = max - min + 1;
-    return min + (getNumberFromArray() % delta);
+    return getThreadStream().getRandomInt(min, max);
 }
 
 uint32_t NumberGenerator::getLargeRandomInt(uint32_t range)
 {
-	return getNumberFromArray() % (range + 1);
+    return getThreadStream().getLargeRandomInt(range);
 }
 
 double NumberGenerator::getRandomReal(double min, double max)
 {
-	return static_cast<double>(getLargeRandomInt(static_cast<int>((max - min) * 1000)) / 1000.0 + min);
+    return getThreadStream().getRandomReal(min, max);
 }
 
 float NumberGenerator::getRandomFloat(float min, float max)
 {
-    return toFloat(getRandomReal(min, max));
+    return getThreadStream().getRandomFloat(min, max);
 }
 
 double NumberGenerator::getRandomReal()
 {
-    return static_cast<double>(getNumberFromArray()) / static_cast<double>(std::numeric_limits<int>::max());
+    return getThreadStream().getRandomReal();
 }
 
 uint64_t NumberGenerator::getId()
@@ -68,8 +162,13 @@ uint64_t NumberGenerator::getId()
     return (static_cast<uint64_t>(1) << 48) | ++_runningNumber; //first term is to avoid collisions with GPU-generated ids
 }
 
-uint32_t NumberGenerator::getNumberFromArray()
+RandomStream& NumberGenerator::getThreadStream()
 {
-	_index = (_index + 1) % _arrayOfRandomNumbers.size();
-	return _arrayOfRandomNumbers[_index];
+    auto& data = threadStreamData;
+    if (data.epoch != _epoch.load(std::memory_order_acquire)) {
+        std::lock_guard lock(_mutex);
+        data.epoch = _epoch;
+        data.stream.emplace(_seed, ThreadStreamFlag | _nextStreamId++);
+    }
+    return *data.stream;
 }
@@ -1,7 +1,34 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "Definitions.h"
 
+//xoshiro256** generator whose state is derived from a seed and a stream id
+//equal (seed, stream id) pairs produce equal sequences, independent of the thread in which they are used
+class RandomStream
+{
+public:
+    RandomStream(uint64_t seed, uint64_t streamId);
+
+    uint64_t next();
+
+    uint32_t getRandomInt();  //in [0, 2^31 - 1]
+    uint32_t getRandomInt(uint32_t range);
+    uint32_t getRandomInt(uint32_t min, uint32_t max);
+    double getRandomReal();
+    double getRandomReal(double min, double max);
+    float getRandomFloat(float min, float max);
+
+    uint32_t getLargeRandomInt(uint32_t range);
+
+private:
+    uint64_t _state[4];
+};
+
+//thread-safe random number service: each thread draws from its own RandomStream
+//the streams of the threads are numbered in order of their first use after the last call of setSeed
 class NumberGenerator
 {
 public:
@@ -9,6 +36,12 @@ public:
     NumberGenerator(NumberGenerator const&) = delete;
     void operator=(NumberGenerator const&) = delete;
 
+    void setSeed(uint64_t seed);
+    uint64_t getSeed() const;
+
+    //for reproducible results of parallel computations where the assignment of work to threads is not fixed
+    RandomStream createStream(uint64_t streamId) const;
+
 	uint32_t getRandomInt();
     uint32_t getRandomInt(uint32_t range);
     uint32_t getRandomInt(uint32_t min, uint32_t max);
@@ -19,14 +52,16 @@ public:
 	uint64_t getId();
 
 	uint32_t getLargeRandomInt(uint32_t range);
-    uint32_t getNumberFromArray();
 
 private:
     NumberGenerator();
     ~NumberGenerator();
 
-	int _index = 0;
-	std::vector<uint32_t> _arrayOfRandomNumbers;
-	uint64_t _runningNumber = 0;
-};
+    RandomStream& getThreadStream();
 
+    mutable std::mutex _mutex;
+    uint64_t _seed = 0;  //guarded by _mutex
+    std::atomic<uint64_t> _epoch{0};
+    uint64_t _nextStreamId = 0;  //guarded by _mutex
+	std::atomic<uint64_t> _runningNumber{0};
+};
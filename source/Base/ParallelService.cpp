@@ -0,0 +1,203 @@
+#include "ParallelService.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+int ParallelService::getNumThreads()
+{
+    return std::max(1, toInt(std::thread::hardware_concurrency()));
+}
+
+namespace
+{
+    thread_local bool isWorkerThread = false;
+
+    //persistent worker threads so that frequent small parallel sections do not pay for thread creation
+    //parallel sections of several callers are queued and processed in order, the callers take part in processing their own sections
+    class WorkerPool
+    {
+    public:
+        static WorkerPool& get()
+        {
+            static WorkerPool instance;
+            return instance;
+        }
+
+        void run(uint64_t numTasks, std::function<void(uint64_t)> const& func)
+        {
+            Job job;
+            job.func = &func;
+            job.numTasks = numTasks;
+            {
+                std::lock_guard lock(_mutex);
+                _jobs.emplace_back(&job);
+            }
+            _wakeCondition.notify_all();
+
+            isWorkerThread = true;
+            processTasks(job);
+            isWorkerThread = false;
+            {
+                std::unique_lock lock(_mutex);
+                removeJob(job);
+                _doneCondition.wait(lock, [&] { return job.numActiveWorkers == 0; });
+            }
+            if (job.exception) {
+                std::rethrow_exception(job.exception);
+            }
+        }
+
+        void enqueue(std::function<void()>&& task)
+        {
+            if (_threads.empty()) {
+                task();
+                return;
+            }
+            {
+                std::lock_guard lock(_mutex);
+                _detachedTasks.emplace_back(std::move(task));
+            }
+            _wakeCondition.notify_one();
+        }
+
+    private:
+        struct Job
+        {
+            std::function<void(uint64_t)> const* func = nullptr;
+            uint64_t numTasks = 0;
+            std::atomic<uint64_t> nextTask{0};
+            int numActiveWorkers = 0;  //guarded by _mutex
+            std::exception_ptr exception;
+        };
+
+        WorkerPool()
+        {
+            auto numWorkers = ParallelService::getNumThreads() - 1;
+            for (int i = 0; i < numWorkers; ++i) {
+                _threads.emplace_back(&WorkerPool::workerLoop, this);
+            }
+        }
+
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard lock(_mutex);
+                _shutdown = true;
+            }
+            _wakeCondition.notify_all();
+            for (auto& thread : _threads) {
+                thread.join();
+            }
+        }
+
+        void workerLoop()
+        {
+            isWorkerThread = true;
+            while (true) {
+                std::unique_lock lock(_mutex);
+                _wakeCondition.wait(lock, [&] { return _shutdown || !_jobs.empty() || !_detachedTasks.empty(); });
+                if (_shutdown) {
+                    return;
+                }
+
+                //parallel sections are preferred since their callers are waiting
+                if (!_jobs.empty()) {
+                    auto& job = *_jobs.front();
+                    ++job.numActiveWorkers;
+                    lock.unlock();
+                    processTasks(job);
+                    lock.lock();
+                    removeJob(job);
+                    if (--job.numActiveWorkers == 0) {
+                        _doneCondition.notify_all();
+                    }
+                } else {
+                    auto task = std::move(_detachedTasks.front());
+                    _detachedTasks.pop_front();
+                    lock.unlock();
+                    task();
+                }
+            }
+        }
+
+        void processTasks(Job& job)
+        {
+            try {
+                for (auto task = job.nextTask++; task < job.numTasks; task = job.nextTask++) {
+                    (*job.func)(task);
+                }
+            } catch (...) {
+                std::lock_guard lock(_exceptionMutex);
+                if (!job.exception) {
+                    job.exception = std::current_exception();
+                }
+                job.nextTask = job.numTasks;
+            }
+        }
+
+        //all tasks of the job have been taken as soon as one of its participants returns from processTasks
+        void removeJob(Job& job)
+        {
+            auto iter = std::find(_jobs.begin(), _jobs.end(), &job);
+            if (iter != _jobs.end()) {
+                _jobs.erase(iter);
+            }
+        }
+
+        std::vector<std::thread> _threads;
+
+        std::mutex _mutex;
+        std::condition_variable _wakeCondition;
+        std::condition_variable _doneCondition;
+        std::deque<Job*> _jobs;
+        std::deque<std::function<void()>> _detachedTasks;
+        bool _shutdown = false;
+
+        std::mutex _exceptionMutex;
+    };
+}
+
+void ParallelService::forEach(uint64_t numTasks, std::function<void(uint64_t)> const& func)
+{
+    auto numThreads = std::min(static_cast<uint64_t>(getNumThreads()), numTasks);
+
+    //nested parallel sections are executed on the calling worker thread
+    if (numThreads <= 1 || isWorkerThread) {
+        for (uint64_t i = 0; i < numTasks; ++i) {
+            func(i);
+        }
+        return;
+    }
+    WorkerPool::get().run(numTasks, func);
+}
+
+void ParallelService::enqueue(std::function<void()>&& task)
+{
+    WorkerPool::get().enqueue(std::move(task));
+}
+
+void ParallelService::forEachRange(uint64_t numElements, std::function<void(uint64_t, uint64_t)> const& func)
+{
+    auto constexpr MinRangeSize = 4096;
+    auto constexpr RangesPerThread = 4;
+
+    auto numRanges = std::min(static_cast<uint64_t>(getNumThreads() * RangesPerThread), (numElements + MinRangeSize - 1) / MinRangeSize);
+    if (numRanges <= 1) {
+        func(0, numElements);
+        return;
+    }
+    auto rangeSize = (numElements + numRanges - 1) / numRanges;
+    forEach(numRanges, [&](uint64_t rangeIndex) {
+        auto startIndex = rangeIndex * rangeSize;
+        auto endIndex = std::min(numElements, startIndex + rangeSize);
+        if (startIndex < endIndex) {
+            func(startIndex, endIndex);
+        }
+    });
+}
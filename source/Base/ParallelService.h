@@ -0,0 +1,41 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "Definitions.h"
+
+class ParallelService
+{
+public:
+    static int getNumThreads();
+
+    //calls func(index) for every index in [0, numTasks) on a set of worker threads
+    //blocks until all tasks are finished, the first exception thrown by a task is rethrown
+    static void forEach(uint64_t numTasks, std::function<void(uint64_t)> const& func);
+
+    //calls func(startIndex, endIndex) for consecutive ranges covering [0, numElements), small inputs are processed on the calling thread
+    static void forEachRange(uint64_t numElements, std::function<void(uint64_t, uint64_t)> const& func);
+
+    //runs func on a worker thread without blocking the caller, exceptions are passed to the returned future
+    //without worker threads func is executed immediately on the calling thread
+    template <typename Func>
+    static auto async(Func&& func) -> std::future<decltype(func())>;
+
+private:
+    static void enqueue(std::function<void()>&& task);
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+auto ParallelService::async(Func&& func) -> std::future<decltype(func())>
+{
+    auto task = std::make_shared<std::packaged_task<decltype(func())()>>(std::forward<Func>(func));
+    auto result = task->get_future();
+    enqueue([task] { (*task)(); });
+    return result;
+}
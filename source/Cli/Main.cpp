@@ -1,15 +1,20 @@
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 
 #include "CLI/CLI.hpp"
 
 #include "Base/GlobalSettings.h"
 #include "Base/LoggingService.h"
+#include "Base/MetricsService.h"
+#include "Base/NumberGenerator.h"
 #include "Base/Resources.h"
 #include "Base/StringHelper.h"
 #include "Base/FileLogger.h"
 #include "EngineInterface/SerializerService.h"
+#include "EngineCpu/SimulationFacadeCpu.h"
 #include "EngineImpl/SimulationFacadeImpl.h"
+#include "Network/MetricsEndpointService.h"
 
 int main(int argc, char** argv)
 {
@@ -23,15 +28,48 @@ int main(int argc, char** argv)
         std::string outputFilename;
         std::string statisticsFilename;
         int timesteps = 0;
+        bool snapshot = false;
+        bool cpu = false;
+        uint64_t seed = 0;
+        std::string traceFilename;
+        std::string metricsFilename;
+        int metricsInterval = 10;
+        int metricsPort = 0;
         app.add_option(
             "-i", inputFilename, "Specifies the name of the input file for the simulation to run. The corresponding *.settings.json should also be available.");
         app.add_option(
             "-o",
             outputFilename,
-            "Specifies the name of the output file for the simulation. The *.settings.json and *.statistics.csv file will also be saved.");
+            "Specifies the name of the output file for the simulation. The *.settings.json and *.statistics.bin file will also be saved.");
         app.add_option("-t", timesteps, "The number of time steps to be calculated.");
+        app.add_option("--statistics", statisticsFilename, "Specifies the name of a CSV file to which the statistics history is exported.");
+        app.add_flag(
+            "-s",
+            snapshot,
+            "The output file contains a raw snapshot of the simulation data, which is loaded via memory mapping. Snapshot input files are detected "
+            "automatically. Snapshots are only valid for program versions with the same data layout.");
+        app.add_flag("--cpu", cpu, "Runs the simulation on the CPU instead of the GPU. Snapshots are not supported in this mode.");
+        auto seedOption = app.add_option("--seed", seed, "Seed for the random number generator of the host. Allows reproducible batch runs.");
+        app.add_option("--trace", traceFilename, "Specifies the name of a JSON file to which a Chrome trace of the run is written.");
+        app.add_option("--metrics", metricsFilename, "Specifies the name of a file to which the collected metrics are appended periodically.");
+        app.add_option("--metrics-interval", metricsInterval, "Interval in seconds in which the metrics are written (default: 10).");
+        app.add_option("--metrics-port", metricsPort, "Port of a local HTTP endpoint which serves the collected metrics and the trace.");
         CLI11_PARSE(app, argc, argv);
 
+        if (seedOption->count() > 0) {
+            NumberGenerator::get().setSeed(seed);
+        }
+        if (!traceFilename.empty() || !metricsFilename.empty() || metricsPort != 0) {
+            if (!metricsFilename.empty()) {
+                MetricsService::get().setPeriodicDump(metricsFilename, std::chrono::seconds(metricsInterval));
+            }
+            if (metricsPort != 0 && !MetricsEndpointService::get().start(metricsPort)) {
+                std::cout << "Could not start metrics endpoint on port " << metricsPort << "." << std::endl;
+                return 1;
+            }
+            MetricsService::get().setEnabled(true);
+        }
+
         //read input
         std::cout << "Reading input" << std::endl;
         if (inputFilename.empty()) {
@@ -47,9 +85,18 @@ int main(int argc, char** argv)
         //run simulation
         auto startTimepoint = std::chrono::steady_clock::now();
 
-        auto simulationFacade = std::make_shared<_SimulationFacadeImpl>();
+        SimulationFacade simulationFacade;
+        if (cpu) {
+            simulationFacade = std::make_shared<_SimulationFacadeCpu>();
+        } else {
+            simulationFacade = std::make_shared<_SimulationFacadeImpl>();
+        }
         simulationFacade->newSimulation("", simData.auxiliaryData.timestep, simData.auxiliaryData.generalSettings, simData.auxiliaryData.simulationParameters);
-        simulationFacade->setClusteredSimulationData(simData.mainData);
+        if (simData.snapshotFilename) {
+            simulationFacade->setSimulationDataFromSnapshotFile(*simData.snapshotFilename);
+        } else {
+            simulationFacade->setClusteredSimulationData(simData.mainData);
+        }
         simulationFacade->setStatisticsHistory(simData.statistics);
         simulationFacade->setRealTime(simData.auxiliaryData.realTime);
         std::cout << "Device: " << simulationFacade->getGpuName() << std::endl;
@@ -66,18 +113,41 @@ int main(int argc, char** argv)
         //write output simulation file
         std::cout << "Writing output" << std::endl;
         simData.auxiliaryData.timestep = static_cast<uint32_t>(simulationFacade->getCurrentTimestep());
-        simData.mainData = simulationFacade->getClusteredSimulationData();
         simData.auxiliaryData.simulationParameters = simulationFacade->getSimulationParameters();
-        simData.statistics = simulationFacade->getStatisticsHistory().getCopiedData();
+        simData.statistics = simulationFacade->getStatisticsHistory().getSnapshot();
         simData.auxiliaryData.realTime = simulationFacade->getRealTime();
         if (outputFilename.empty()) {
             std::cout << "No output file given." << std::endl;
             return 1;
         }
-        if (!SerializerService::serializeSimulationToFiles(outputFilename, simData)) {
-            std::cout << "Could not write to output files." << std::endl;
+        if (snapshot) {
+            simulationFacade->saveSimulationDataToSnapshotFile(outputFilename);
+            if (!SerializerService::serializeSimulationWithoutMainDataToFiles(outputFilename, simData)) {
+                std::cout << "Could not write to output files." << std::endl;
+                return 1;
+            }
+        } else {
+            simData.mainData = simulationFacade->getClusteredSimulationData();
+            if (!SerializerService::serializeSimulationToFiles(outputFilename, simData)) {
+                std::cout << "Could not write to output files." << std::endl;
+                return 1;
+            }
+        }
+        if (!statisticsFilename.empty() && !SerializerService::serializeStatisticsToFile(statisticsFilename, simData.statistics)) {
+            std::cout << "Could not write statistics file." << std::endl;
             return 1;
         }
+        if (MetricsService::isEnabled()) {
+            MetricsEndpointService::get().stop();
+            MetricsService::get().setEnabled(false);
+            if (!metricsFilename.empty()) {
+                std::ofstream(metricsFilename, std::ios::app) << MetricsService::get().getMetricsDump() << std::endl;
+            }
+            if (!traceFilename.empty() && !MetricsService::get().writeChromeTraceToFile(traceFilename)) {
+                std::cout << "Could not write trace file." << std::endl;
+                return 1;
+            }
+        }
 
         std::cout << "Finished" << std::endl;
     } catch (std::exception const& e) {
@@ -0,0 +1,35 @@
+#include "ClusteredDataReaderCpu.h"
+
+#include <algorithm>
+
+_ClusteredDataReaderCpu::_ClusteredDataReaderCpu(DataDescription&& data)
+    : _data(std::move(data))
+{
+    _cellClusters = CpuDescriptionConverter::calcCellClusters(_data);
+}
+
+std::optional<ClusteredDataDescription> _ClusteredDataReaderCpu::readNextChunk()
+{
+    ClusteredDataDescription result;
+    auto numClusters = _cellClusters.getNumClusters();
+    if (_clusterIndex < numClusters) {
+        auto const& startIndices = _cellClusters.clusterStartIndices;
+
+        //complete clusters are added until MaxCellsPerChunk is reached
+        auto endClusterIndex = _clusterIndex + 1;
+        while (endClusterIndex < numClusters && startIndices[endClusterIndex + 1] - startIndices[_clusterIndex] <= MaxCellsPerChunk) {
+            ++endClusterIndex;
+        }
+        result.clusters = CpuDescriptionConverter::extractClusterDescriptions(_data, _cellClusters, _clusterIndex, endClusterIndex);
+        _clusterIndex = endClusterIndex;
+        return result;
+    }
+    auto numParticles = _data.particles.size();
+    if (_particleIndex < numParticles) {
+        auto endIndex = std::min(numParticles, _particleIndex + MaxParticlesPerChunk);
+        result.particles.assign(_data.particles.begin() + _particleIndex, _data.particles.begin() + endIndex);
+        _particleIndex = endIndex;
+        return result;
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "EngineInterface/ClusteredDataReader.h"
+
+#include "CpuDescriptionConverter.h"
+#include "Definitions.h"
+
+class _ClusteredDataReaderCpu : public _ClusteredDataReader
+{
+public:
+    _ClusteredDataReaderCpu(DataDescription&& data);
+
+    std::optional<ClusteredDataDescription> readNextChunk() override;
+
+private:
+    static auto constexpr MaxCellsPerChunk = 100000;
+    static auto constexpr MaxParticlesPerChunk = 500000;
+
+    DataDescription _data;
+    CpuDescriptionConverter::CellClusters _cellClusters;
+    uint64_t _clusterIndex = 0;
+    uint64_t _particleIndex = 0;
+};
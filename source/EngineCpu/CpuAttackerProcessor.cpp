@@ -0,0 +1,327 @@
+#include "CpuAttackerProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Math.h"
+
+#include "CpuConnectionService.h"
+#include "CpuGenomeDecoder.h"
+
+void CpuAttackerProcessor::process(CpuCellFunctionData& data, AccumulatedStatistics& statistics)
+{
+    for (auto const& cellIndex : data.cellFunctionOperations[CellFunction_Attacker]) {
+        processCell(data, statistics, cellIndex);
+    }
+}
+
+void CpuAttackerProcessor::processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex)
+{
+    auto& cells = data.data.cells;
+    auto const& parameters = data.parameters;
+    auto activity = CpuCellFunctionProcessor::calcInputActivity(cells, cells[cellIndex], parameters);
+    CpuCellFunctionProcessor::updateInvocationState(cells[cellIndex], activity);
+
+    if (std::abs(activity.channels[0]) >= parameters.cellFunctionAttackerActivityThreshold) {
+        auto& cell = cells[cellIndex];
+        auto const& properties = cell.properties;
+        auto const& features = parameters.features;
+        float energyDelta = 0;
+        auto cellMinEnergy = parameters.baseValues.cellMinEnergy[properties.color];
+        auto baseValue = parameters.cellFunctionAttackerDestroyCells ? cellMinEnergy * 0.1f : cellMinEnergy;
+
+        int someOtherCellIndex = -1;
+        CpuCellFunctionProcessor::forEachCell(
+            data, properties.pos, parameters.cellFunctionAttackerRadius[properties.color], cell.detached, [&](int otherIndex) {
+                auto& otherCell = cells[otherIndex];
+                auto& otherProperties = otherCell.properties;
+                if (properties.creatureId != 0 && otherProperties.creatureId == properties.creatureId) {
+                    return;
+                }
+                if (properties.creatureId == 0 && CpuConnectionService::isConnectedConnected(cells, cellIndex, otherIndex)) {
+                    return;
+                }
+                if (otherProperties.barrier) {
+                    return;
+                }
+
+                auto energyToTransfer = (otherProperties.energy - baseValue) * parameters.cellFunctionAttackerStrength[properties.color];
+                if (energyToTransfer < 0) {
+                    return;
+                }
+
+                auto color = properties.color % MAX_COLORS;
+                auto otherColor = otherProperties.color % MAX_COLORS;
+
+                if (features.advancedAttackerControl && otherProperties.detectedByCreatureId != (properties.creatureId & 0xffff)) {
+                    energyToTransfer *= (1.0f - parameters.cellFunctionAttackerSensorDetectionFactor[color]);
+                }
+
+                if (features.advancedAttackerControl && otherProperties.genomeComplexity > properties.genomeComplexity) {
+                    auto cellFunctionAttackerGenomeComplexityBonus = parameters.baseValues.cellFunctionAttackerGenomeComplexityBonus[color][otherColor];
+                    energyToTransfer /= (1.0f + cellFunctionAttackerGenomeComplexityBonus * (otherProperties.genomeComplexity - properties.genomeComplexity));
+                }
+                if (features.advancedAttackerControl
+                    && ((otherProperties.mutationId == properties.mutationId)
+                        || (otherProperties.ancestorMutationId == static_cast<uint8_t>(properties.mutationId & 0xff)))
+                    && properties.mutationId != 0) {
+                    energyToTransfer *= (1.0f - parameters.cellFunctionAttackerSameMutantPenalty[color][otherColor]);
+                }
+
+                if (features.advancedAttackerControl && properties.mutationId < otherProperties.mutationId
+                    && properties.genomeComplexity <= otherProperties.genomeComplexity) {
+                    auto cellFunctionAttackerArisingComplexMutantPenalty = parameters.baseValues.cellFunctionAttackerNewComplexMutantPenalty[color][otherColor];
+                    energyToTransfer *= (1.0f - cellFunctionAttackerArisingComplexMutantPenalty);
+                }
+
+                auto numDefenderCells = countAndTrackDefenderCells(cells, statistics, otherCell);
+                float defendStrength =
+                    numDefenderCells == 0 ? 1.0f : std::pow(parameters.cellFunctionDefenderAgainstAttackerStrength[color], toFloat(numDefenderCells));
+                energyToTransfer /= defendStrength;
+
+                if (!isHomogene(cells, otherCell)) {
+                    energyToTransfer *= parameters.cellFunctionAttackerColorInhomogeneityFactor[color];
+                }
+
+                if (features.advancedAttackerControl) {
+                    auto cellFunctionAttackerGeometryDeviationExponent = parameters.baseValues.cellFunctionAttackerGeometryDeviationExponent[properties.color];
+
+                    if (std::abs(cellFunctionAttackerGeometryDeviationExponent) > 0) {
+                        auto d = otherProperties.pos - properties.pos;
+                        auto angle1 = calcOpenAngle(data, cell, d);
+                        auto angle2 = calcOpenAngle(data, otherCell, d * (-1));
+                        auto deviation = 1.0f - std::abs(360.0f - (angle1 + angle2)) / 360.0f;  //1 = no deviation, 0 = max deviation
+                        energyToTransfer *= std::pow(std::max(0.0f, std::min(1.0f, deviation)), cellFunctionAttackerGeometryDeviationExponent);
+                    }
+                }
+
+                if (features.advancedAttackerControl) {
+                    auto cellFunctionAttackerConnectionsMismatchPenalty = parameters.baseValues.cellFunctionAttackerConnectionsMismatchPenalty[properties.color];
+                    if (otherCell.numConnections > cell.numConnections + 1) {
+                        energyToTransfer *= (1.0f - cellFunctionAttackerConnectionsMismatchPenalty) * (1.0f - cellFunctionAttackerConnectionsMismatchPenalty);
+                    }
+                    if (otherCell.numConnections == cell.numConnections + 1) {
+                        energyToTransfer *= (1.0f - cellFunctionAttackerConnectionsMismatchPenalty);
+                    }
+                }
+
+                energyToTransfer *= parameters.baseValues.cellFunctionAttackerFoodChainColorMatrix[color][otherColor];
+
+                if (std::abs(energyToTransfer) < NEAR_ZERO) {
+                    return;
+                }
+
+                someOtherCellIndex = otherIndex;
+                if (energyToTransfer > NEAR_ZERO) {
+
+                    //notify attacked cell
+                    otherProperties.activity.channels[7] += 1.0f;
+
+                    if (otherProperties.energy > baseValue + energyToTransfer) {
+                        otherProperties.energy -= energyToTransfer;
+                        energyDelta += energyToTransfer;
+                    }
+                } else if (energyToTransfer < -NEAR_ZERO) {
+                    if (otherProperties.energy >= baseValue - (energyDelta + energyToTransfer)) {
+                        otherProperties.energy -= energyToTransfer;
+                        energyDelta += energyToTransfer;
+                    }
+                }
+            });
+
+        if (energyDelta > NEAR_ZERO) {
+            distributeEnergy(data, cellIndex, energyDelta);
+        } else {
+            auto origEnergy = cell.properties.energy;
+            cell.properties.energy += energyDelta;
+            if (origEnergy + energyDelta < 0 && someOtherCellIndex != -1) {
+                cells[someOtherCellIndex].properties.energy -= energyDelta;  //revert
+            }
+        }
+
+        radiate(data, cellIndex);
+
+        //output
+        activity.channels[0] = energyDelta / 10;
+
+        if (energyDelta > NEAR_ZERO) {
+            ++statistics.numAttacks[cell.properties.color];
+        }
+    }
+
+    CpuCellFunctionProcessor::setActivity(cells[cellIndex], activity);
+}
+
+void CpuAttackerProcessor::radiate(CpuCellFunctionData& data, int cellIndex)
+{
+    auto const& parameters = data.parameters;
+    auto& properties = data.data.cells[cellIndex].properties;
+    auto cellFunctionWeaponEnergyCost = parameters.baseValues.cellFunctionAttackerEnergyCost[properties.color];
+    if (cellFunctionWeaponEnergyCost > 0) {
+        auto const radiationEnergy = std::min(properties.energy, cellFunctionWeaponEnergyCost);
+        if (properties.energy < 1.0f) {
+            return;
+        }
+        properties.energy -= radiationEnergy;
+
+        CpuRandom random(data.seed, data.timestep, CpuRandomStage_Attacker, cellIndex);
+        RealVector2D particleVel = (properties.vel * parameters.radiationVelocityMultiplier)
+            + RealVector2D{(random.random() - 0.5f) * parameters.radiationVelocityPerturbation, (random.random() - 0.5f) * parameters.radiationVelocityPerturbation};
+        RealVector2D particlePos = data.spaceCalculator.getCorrectedPosition(properties.pos + Math::normalized(particleVel) * 1.5f - particleVel);
+
+        data.radiate(random, particlePos, particleVel, properties.color, radiationEnergy);
+    }
+}
+
+void CpuAttackerProcessor::distributeEnergy(CpuCellFunctionData& data, int cellIndex, float energyDelta)
+{
+    auto& cells = data.data.cells;
+    auto& cell = cells[cellIndex];
+    auto const& parameters = data.parameters;
+    auto const& energyDistribution = parameters.cellFunctionAttackerEnergyDistributionValue[cell.properties.color];
+    if (cell.properties.energy > parameters.cellNormalEnergy[cell.properties.color]) {
+        cell.properties.energy -= energyDistribution;
+        energyDelta += energyDistribution;
+    }
+
+    auto const& attacker = CpuCellFunctionProcessor::getCellFunction<AttackerDescription>(cell);
+    if (attacker.mode == EnergyDistributionMode_ConnectedCells) {
+        int numReceivers = cell.numConnections;
+        for (int i = 0; i < cell.numConnections; ++i) {
+            numReceivers += cells[cell.connections[i].cellIndex].numConnections;
+        }
+        float energyPerReceiver = energyDelta / toFloat(numReceivers + 1);
+
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto& connectedCell = cells[cell.connections[i].cellIndex];
+            connectedCell.properties.energy += energyPerReceiver;
+            energyDelta -= energyPerReceiver;
+            for (int j = 0; j < connectedCell.numConnections; ++j) {
+                cells[connectedCell.connections[j].cellIndex].properties.energy += energyPerReceiver;
+                energyDelta -= energyPerReceiver;
+            }
+        }
+    }
+
+    if (attacker.mode == EnergyDistributionMode_TransmittersAndConstructors) {
+        auto creatureId = cell.properties.creatureId;
+        auto matchActiveConstructorFunc = [&](int otherIndex) {
+            auto& otherCell = cells[otherIndex];
+            if (otherCell.properties.livingState != LivingState_Ready) {
+                return false;
+            }
+            if (otherCell.properties.getCellFunctionType() == CellFunction_Constructor) {
+                if (!CpuGenomeDecoder::isFinished(CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(otherCell))
+                    && otherCell.properties.creatureId == creatureId) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        auto matchTransmitterFunc = [&](int otherIndex) {
+            auto const& otherProperties = cells[otherIndex].properties;
+            if (otherProperties.livingState != LivingState_Ready) {
+                return false;
+            }
+            return otherProperties.getCellFunctionType() == CellFunction_Transmitter && otherProperties.creatureId == creatureId;
+        };
+
+        std::vector<int> receiverCells;
+        auto radius = parameters.cellFunctionAttackerEnergyDistributionRadius[cell.properties.color];
+        CpuCellFunctionProcessor::getMatchingCells(data, receiverCells, 20, cell.properties.pos, radius, cell.detached, matchActiveConstructorFunc);
+        if (receiverCells.empty()) {
+            CpuCellFunctionProcessor::getMatchingCells(data, receiverCells, 20, cell.properties.pos, radius, cell.detached, matchTransmitterFunc);
+        }
+        float energyPerReceiver = energyDelta / toFloat(receiverCells.size() + 1);
+
+        for (auto const& receiverIndex : receiverCells) {
+            cells[receiverIndex].properties.energy += energyPerReceiver;
+            energyDelta -= energyPerReceiver;
+        }
+    }
+    cell.properties.energy += energyDelta;
+}
+
+float CpuAttackerProcessor::calcOpenAngle(CpuCellFunctionData const& data, CpuCell const& cell, RealVector2D const& direction)
+{
+    if (0 == cell.numConnections) {
+        return 0.0f;
+    }
+    if (1 == cell.numConnections) {
+        return 365.0f;
+    }
+
+    auto const& cells = data.data.cells;
+    auto refAngle = Math::angleOfVector(direction);
+
+    float largerAngle = Math::angleOfVector(cells[cell.connections[0].cellIndex].properties.pos - cell.properties.pos);
+    float smallerAngle = largerAngle;
+
+    for (int i = 1; i < cell.numConnections; ++i) {
+        auto angle = Math::angleOfVector(cells[cell.connections[i].cellIndex].properties.pos - cell.properties.pos);
+        if (largerAngle >= refAngle) {
+            if (largerAngle > angle && angle >= refAngle) {
+                largerAngle = angle;
+            }
+        } else {
+            if (largerAngle > angle || angle >= refAngle) {
+                largerAngle = angle;
+            }
+        }
+
+        if (smallerAngle <= refAngle) {
+            if (smallerAngle < angle && angle <= refAngle) {
+                smallerAngle = angle;
+            }
+        } else {
+            if (smallerAngle < angle || angle <= refAngle) {
+                smallerAngle = angle;
+            }
+        }
+    }
+    return Math::subtractAngle(largerAngle, smallerAngle);
+}
+
+int CpuAttackerProcessor::countAndTrackDefenderCells(std::vector<CpuCell> const& cells, AccumulatedStatistics& statistics, CpuCell const& cell)
+{
+    auto isDefender = [](CpuCell const& cell) {
+        if (!cell.properties.cellFunction) {
+            return false;
+        }
+        auto defender = std::get_if<DefenderDescription>(&*cell.properties.cellFunction);
+        return defender && defender->mode == DefenderMode_DefendAgainstAttacker;
+    };
+
+    int result = 0;
+    if (!cell.properties.cellFunction) {
+        return result;
+    }
+    if (isDefender(cell)) {
+        ++result;
+    }
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto const& connectedCell = cells[cell.connections[i].cellIndex];
+        if (isDefender(connectedCell)) {
+            ++statistics.numDefenderActivities[connectedCell.properties.color];
+            ++result;
+        }
+    }
+    return result;
+}
+
+bool CpuAttackerProcessor::isHomogene(std::vector<CpuCell> const& cells, CpuCell const& cell)
+{
+    auto color = cell.properties.color;
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto const& otherCell = cells[cell.connections[i].cellIndex];
+        if (color != otherCell.properties.color) {
+            return false;
+        }
+        for (int j = 0; j < otherCell.numConnections; ++j) {
+            if (color != cells[otherCell.connections[j].cellIndex].properties.color) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "CpuCellFunctionProcessor.h"
+
+//counterpart of AttackerProcessor on the GPU
+class CpuAttackerProcessor
+{
+public:
+    static void process(CpuCellFunctionData& data, AccumulatedStatistics& statistics);
+
+private:
+    static void processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex);
+    static void radiate(CpuCellFunctionData& data, int cellIndex);
+    static void distributeEnergy(CpuCellFunctionData& data, int cellIndex, float energyDelta);
+
+    static float calcOpenAngle(CpuCellFunctionData const& data, CpuCell const& cell, RealVector2D const& direction);
+    static int countAndTrackDefenderCells(std::vector<CpuCell> const& cells, AccumulatedStatistics& statistics, CpuCell const& cell);
+    static bool isHomogene(std::vector<CpuCell> const& cells, CpuCell const& cell);
+};
@@ -0,0 +1,227 @@
+#include "CpuCellFunctionProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Math.h"
+
+void CpuCellFunctionProcessor::collectCellFunctionOperations(CpuCellFunctionData& data)
+{
+    auto const& cells = data.data.cells;
+    auto executionOrderNumber = toInt(data.timestep % data.parameters.cellNumExecutionOrderNumbers);
+    for (auto& operations : data.cellFunctionOperations) {
+        operations.clear();
+    }
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        auto const& properties = cells[index].properties;
+        if (!properties.cellFunction || properties.executionOrderNumber != executionOrderNumber) {
+            continue;
+        }
+        auto cellFunction = properties.getCellFunctionType();
+        auto detonator = std::get_if<DetonatorDescription>(&*properties.cellFunction);
+        if (detonator && detonator->state == DetonatorState_Activated) {
+            data.cellFunctionOperations[cellFunction].emplace_back(index);
+        } else if (properties.livingState == LivingState_Ready && properties.activationTime == 0) {
+            data.cellFunctionOperations[cellFunction].emplace_back(index);
+        }
+    }
+}
+
+ActivityDescription CpuCellFunctionProcessor::calcInputActivity(std::vector<CpuCell> const& cells, CpuCell const& cell, SimulationParameters const& parameters)
+{
+    ActivityDescription result;
+    auto inputExecutionOrderNumber = cell.getInputExecutionOrderNumber();
+    auto const& properties = cell.properties;
+    if (inputExecutionOrderNumber == -1 || inputExecutionOrderNumber == properties.executionOrderNumber) {
+        return result;
+    }
+
+    int numSensorActivities = 0;
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto const& connectedCell = cells[cell.connections[i].cellIndex];
+        auto const& connectedProperties = connectedCell.properties;
+        if (connectedProperties.outputBlocked || connectedProperties.livingState != LivingState_Ready) {
+            continue;
+        }
+        if (!isLegacyDirectionalConnections(parameters) && connectedCell.getInputExecutionOrderNumber() == properties.executionOrderNumber
+            && connectedProperties.executionOrderNumber > properties.executionOrderNumber && !properties.outputBlocked) {
+            continue;
+        }
+        if (connectedProperties.executionOrderNumber == inputExecutionOrderNumber) {
+            for (int j = 0; j < MAX_CHANNELS; ++j) {
+                result.channels[j] += connectedProperties.activity.channels[j];
+                result.channels[j] = std::max(-10.0f, std::min(10.0f, result.channels[j]));  //truncate value to avoid overflow
+            }
+            if (connectedProperties.activity.origin == ActivityOrigin_Sensor) {
+                result.origin = ActivityOrigin_Sensor;
+                result.targetX += connectedProperties.activity.targetX;
+                result.targetY += connectedProperties.activity.targetY;
+                ++numSensorActivities;
+            }
+        }
+    }
+    if (numSensorActivities > 0) {
+        result.targetX /= toFloat(numSensorActivities);
+        result.targetY /= toFloat(numSensorActivities);
+    }
+    return result;
+}
+
+void CpuCellFunctionProcessor::setActivity(CpuCell& cell, ActivityDescription const& newActivity)
+{
+    cell.properties.activity = newActivity;
+}
+
+void CpuCellFunctionProcessor::updateInvocationState(CpuCell& cell, ActivityDescription const& activity)
+{
+    if (cell.properties.cellFunctionUsed == CellFunctionUsed_No) {
+        for (int i = 0; i < MAX_CHANNELS - 1; ++i) {
+            if (activity.channels[i] != 0) {
+                cell.properties.cellFunctionUsed = CellFunctionUsed_Yes;
+                break;
+            }
+        }
+    }
+}
+
+void CpuCellFunctionProcessor::resetFetchedActivity(std::vector<CpuCell>& cells, CpuCell& cell, SimulationParameters const& parameters, int executionOrderNumber)
+{
+    auto& properties = cell.properties;
+    if (!properties.cellFunction) {
+        properties.activity.channels = {};
+        return;
+    }
+    int maxOtherExecutionOrderNumber = -1;
+    if (!properties.outputBlocked) {
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto const& connectedCell = cells[cell.connections[i].cellIndex];
+            auto otherExecutionOrderNumber = connectedCell.properties.executionOrderNumber;
+            auto otherInputExecutionOrderNumber = connectedCell.getInputExecutionOrderNumber();
+            auto flowToCell = !isLegacyDirectionalConnections(parameters)
+                ? cell.getInputExecutionOrderNumber() == otherExecutionOrderNumber && !connectedCell.properties.outputBlocked
+                    && properties.executionOrderNumber > otherInputExecutionOrderNumber
+                : false;
+            if (otherInputExecutionOrderNumber == properties.executionOrderNumber && !flowToCell) {
+                if (maxOtherExecutionOrderNumber == -1) {
+                    maxOtherExecutionOrderNumber = otherExecutionOrderNumber;
+                } else if (
+                    (maxOtherExecutionOrderNumber > properties.executionOrderNumber
+                     && (otherExecutionOrderNumber > maxOtherExecutionOrderNumber || otherExecutionOrderNumber < properties.executionOrderNumber))
+                    || (maxOtherExecutionOrderNumber < properties.executionOrderNumber && otherExecutionOrderNumber > maxOtherExecutionOrderNumber
+                        && otherExecutionOrderNumber < properties.executionOrderNumber)) {
+                    maxOtherExecutionOrderNumber = otherExecutionOrderNumber;
+                }
+            }
+        }
+    }
+    if ((maxOtherExecutionOrderNumber == -1 && executionOrderNumber == (properties.executionOrderNumber + 1) % parameters.cellNumExecutionOrderNumbers)
+        || (maxOtherExecutionOrderNumber != -1 && maxOtherExecutionOrderNumber == executionOrderNumber)) {
+        properties.activity.channels = {};
+    }
+}
+
+auto CpuCellFunctionProcessor::calcLargestGapReferenceAndActualAngle(CpuCellFunctionData const& data, CpuRandom& random, int cellIndex, float angleDeviation)
+    -> ReferenceAndActualAngle
+{
+    auto const& cells = data.data.cells;
+    auto const& cell = cells[cellIndex];
+    if (0 == cell.numConnections) {
+        return ReferenceAndActualAngle{0, random.random() * 360};
+    }
+    auto displacement = data.spaceCalculator.getCorrectedDirection(cells[cell.connections[0].cellIndex].properties.pos - cell.properties.pos);
+    auto angle = Math::angleOfVector(displacement);
+    int index = 0;
+    float largestAngleGap = 0;
+    float angleOfLargestAngleGap = 0;
+    auto numConnections = cell.numConnections;
+    for (int i = 1; i <= numConnections; ++i) {
+        auto angleDiff = cell.connections[i % numConnections].angleFromPrevious;
+        if (angleDiff > largestAngleGap) {
+            largestAngleGap = angleDiff;
+            index = i % numConnections;
+            angleOfLargestAngleGap = angle;
+        }
+        angle += angleDiff;
+    }
+
+    auto angleFromPrev = cell.connections[index].angleFromPrevious;
+    for (int i = 0; i < numConnections - 1; ++i) {
+        if (angleDeviation > angleFromPrev / 2) {
+            angleDeviation -= angleFromPrev / 2;
+            index = (index + 1) % numConnections;
+            angleOfLargestAngleGap += angleFromPrev;
+            angleFromPrev = cell.connections[index].angleFromPrevious;
+            angleDeviation = angleDeviation - angleFromPrev / 2;
+        }
+        if (angleDeviation < -angleFromPrev / 2) {
+            angleDeviation += angleFromPrev / 2;
+            index = (index + numConnections - 1) % numConnections;
+            angleFromPrev = cell.connections[index].angleFromPrevious;
+            angleDeviation = angleDeviation + angleFromPrev / 2;
+            angleOfLargestAngleGap -= angleFromPrev;
+        }
+    }
+    auto angleFromPreviousConnection = angleFromPrev / 2 + angleDeviation;
+
+    if (angleFromPreviousConnection > 360.0f) {
+        angleFromPreviousConnection -= 360;
+    }
+    angleFromPreviousConnection = std::max(30.0f, std::min(angleFromPrev - 30.0f, angleFromPreviousConnection));
+
+    return ReferenceAndActualAngle{angleFromPreviousConnection, angleOfLargestAngleGap + angleFromPreviousConnection};
+}
+
+RealVector2D CpuCellFunctionProcessor::calcSignalDirection(CpuCellFunctionData const& data, int cellIndex)
+{
+    auto const& cells = data.data.cells;
+    auto const& cell = cells[cellIndex];
+    RealVector2D result;
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto const& connectedProperties = cells[cell.connections[i].cellIndex].properties;
+        if (connectedProperties.executionOrderNumber == cell.getInputExecutionOrderNumber() && !connectedProperties.outputBlocked) {
+            result += Math::normalized(data.spaceCalculator.getCorrectedDirection(cell.properties.pos - connectedProperties.pos));
+        }
+    }
+    return Math::normalized(result);
+}
+
+bool CpuCellFunctionProcessor::isLegacyDirectionalConnections(SimulationParameters const& parameters)
+{
+    return parameters.features.legacyModes && parameters.legacyCellDirectionalConnections;
+}
+
+int CpuCellFunctionProcessor::getFirstCellInSlot(CpuCellFunctionData const& data, RealVector2D const& pos)
+{
+    return data.cellGrid.getMaxIndexInUnitSlot(data.spaceCalculator.getCorrectedPosition(pos), data.cellGridPositions);
+}
+
+bool CpuCellFunctionProcessor::existCrossingConnections(
+    CpuCellFunctionData const& data,
+    RealVector2D const& pos1,
+    RealVector2D const& pos2,
+    int detached,
+    int color)
+{
+    auto distance = data.spaceCalculator.distance(pos1, pos2);
+    if (distance > data.parameters.cellMaxBindingDistance[color]) {
+        return false;
+    }
+
+    auto const& cells = data.data.cells;
+    auto center = data.spaceCalculator.getCorrectedPosition(pos1 + data.spaceCalculator.getCorrectedDirection(pos2 - pos1) / 2);
+    bool result = false;
+    forEachCell(data, center, distance, detached, [&](int index) {
+        auto const& otherCell = cells[index];
+        auto const& otherPos = otherCell.properties.pos;
+        if (result || (otherPos.x == pos1.x && otherPos.y == pos1.y) || (otherPos.x == pos2.x && otherPos.y == pos2.y)) {
+            return;
+        }
+        for (int i = 0; i < otherCell.numConnections; ++i) {
+            if (Math::crossing(pos1, pos2, otherPos, cells[otherCell.connections[i].cellIndex].properties.pos)) {
+                result = true;
+                return;
+            }
+        }
+    });
+    return result;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <vector>
+
+#include "EngineInterface/CellFunctionConstants.h"
+#include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/SpaceCalculator.h"
+
+#include "CpuDensityMap.h"
+#include "CpuObjects.h"
+#include "CpuRandom.h"
+#include "CpuSpatialGrid.h"
+#include "Definitions.h"
+
+//data of the current time step on which the cell function processors operate (corresponds to SimulationData on the GPU)
+//cell functions are executed sequentially in cell index order so that the result only depends on the seed
+struct CpuCellFunctionData
+{
+    CpuSimulationData& data;
+    SimulationParameters const& parameters;
+    SpaceCalculator const& spaceCalculator;
+    CpuSpatialGrid const& cellGrid;
+    std::vector<RealVector2D> const& cellGridPositions;
+    CpuDensityMap const& densityMap;
+    uint64_t seed = 0;
+    uint64_t timestep = 0;
+    double& externalEnergy;
+    std::vector<int>& deleteCells;
+    std::vector<std::pair<int, int>>& addConnectionPairs;
+    std::vector<std::pair<int, int>>& deleteConnections;  //(cell index, connected cell index) for one-way deletions
+
+    //creates a particle at an active radiation source (or at pos if there is none)
+    std::function<void(CpuRandom& random, RealVector2D const& pos, RealVector2D const& vel, int color, float energy)> radiate;
+
+    //cell indices per cell function, collected after the living state transitions
+    std::array<std::vector<int>, CellFunction_Count> cellFunctionOperations;
+};
+
+//counterpart of CellFunctionProcessor on the GPU
+class CpuCellFunctionProcessor
+{
+public:
+    static void collectCellFunctionOperations(CpuCellFunctionData& data);
+
+    static ActivityDescription calcInputActivity(std::vector<CpuCell> const& cells, CpuCell const& cell, SimulationParameters const& parameters);
+    static void setActivity(CpuCell& cell, ActivityDescription const& newActivity);
+    static void updateInvocationState(CpuCell& cell, ActivityDescription const& activity);
+    static void resetFetchedActivity(std::vector<CpuCell>& cells, CpuCell& cell, SimulationParameters const& parameters, int executionOrderNumber);
+
+    struct ReferenceAndActualAngle
+    {
+        float referenceAngle;
+        float actualAngle;
+    };
+    static ReferenceAndActualAngle calcLargestGapReferenceAndActualAngle(CpuCellFunctionData const& data, CpuRandom& random, int cellIndex, float angleDeviation);
+
+    static RealVector2D calcSignalDirection(CpuCellFunctionData const& data, int cellIndex);
+
+    static bool isLegacyDirectionalConnections(SimulationParameters const& parameters);
+
+    //cell map queries corresponding to the methods of CellMap on the GPU, distances are measured in the periodic world
+    template <typename Func>
+    static void forEachCell(CpuCellFunctionData const& data, RealVector2D const& pos, float radius, int detached, Func const& func);
+    template <typename MatchFunc>
+    static void getMatchingCells(
+        CpuCellFunctionData const& data,
+        std::vector<int>& result,
+        int maxCells,
+        RealVector2D const& pos,
+        float radius,
+        int detached,
+        MatchFunc const& matchFunc);
+    static int getFirstCellInSlot(CpuCellFunctionData const& data, RealVector2D const& pos);
+
+    //corresponds to CellConnectionProcessor::existCrossingConnections on the GPU
+    static bool existCrossingConnections(CpuCellFunctionData const& data, RealVector2D const& pos1, RealVector2D const& pos2, int detached, int color);
+
+    template <typename T>
+    static T& getCellFunction(CpuCell& cell);
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+void CpuCellFunctionProcessor::forEachCell(CpuCellFunctionData const& data, RealVector2D const& pos, float radius, int detached, Func const& func)
+{
+    auto const& cells = data.data.cells;
+    data.cellGrid.forEachCandidate(pos, radius, [&](int index) {
+        auto const& cell = cells[index];
+        if (cell.deleted || data.spaceCalculator.distance(cell.properties.pos, pos) > radius || detached + cell.detached == 1) {
+            return;
+        }
+        func(index);
+    });
+}
+
+template <typename MatchFunc>
+void CpuCellFunctionProcessor::getMatchingCells(
+    CpuCellFunctionData const& data,
+    std::vector<int>& result,
+    int maxCells,
+    RealVector2D const& pos,
+    float radius,
+    int detached,
+    MatchFunc const& matchFunc)
+{
+    result.clear();
+    forEachCell(data, pos, radius, detached, [&](int index) {
+        if (toInt(result.size()) < maxCells && matchFunc(index)) {
+            result.emplace_back(index);
+        }
+    });
+}
+
+template <typename T>
+T& CpuCellFunctionProcessor::getCellFunction(CpuCell& cell)
+{
+    return std::get<T>(*cell.properties.cellFunction);
+}
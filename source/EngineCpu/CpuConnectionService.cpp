@@ -0,0 +1,228 @@
+#include "CpuConnectionService.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Math.h"
+
+namespace
+{
+    //corresponds to Math::alignAngle on the GPU
+    float alignAngle(float angle, ConstructorAngleAlignment alignment)
+    {
+        if (ConstructorAngleAlignment_None == alignment) {
+            return angle;
+        }
+        auto unitAngle = 360.0f / toFloat(alignment + 1);
+        return std::floor(angle / unitAngle + 0.5f) * unitAngle;
+    }
+
+    //corresponds to Math::alignAngleOnBoundaries on the GPU
+    float alignAngleOnBoundaries(float angle, float maxAngle, ConstructorAngleAlignment alignment)
+    {
+        if (alignment != ConstructorAngleAlignment_None) {
+            auto unitAngle = 360.0f / toFloat(alignment + 1);
+            if (angle < NEAR_ZERO && unitAngle < maxAngle - NEAR_ZERO) {
+                angle = unitAngle;
+            }
+            if (angle > maxAngle - NEAR_ZERO && maxAngle - unitAngle > NEAR_ZERO) {
+                angle = maxAngle - unitAngle;
+            }
+        }
+        return angle;
+    }
+}
+
+bool CpuConnectionService::tryAddConnections(
+    std::vector<CpuCell>& cells,
+    SpaceCalculator const& spaceCalculator,
+    int cellIndex1,
+    int cellIndex2,
+    float desiredAngleOnCell1,
+    float desiredAngleOnCell2,
+    float desiredDistance,
+    ConstructorAngleAlignment angleAlignment)
+{
+    auto& cell1 = cells[cellIndex1];
+    auto posDelta = spaceCalculator.getCorrectedDirection(cells[cellIndex2].properties.pos - cell1.properties.pos);
+
+    auto origConnections = cell1.connections;
+    auto origNumConnections = cell1.numConnections;
+    if (!tryAddConnectionOneWay(cells, spaceCalculator, cellIndex1, cellIndex2, posDelta, desiredDistance, desiredAngleOnCell1, angleAlignment)) {
+        return false;
+    }
+    if (!tryAddConnectionOneWay(cells, spaceCalculator, cellIndex2, cellIndex1, posDelta * (-1.0f), desiredDistance, desiredAngleOnCell2, angleAlignment)) {
+        cell1.connections = origConnections;
+        cell1.numConnections = origNumConnections;
+        return false;
+    }
+    return true;
+}
+
+void CpuConnectionService::deleteConnections(std::vector<CpuCell>& cells, int cellIndex1, int cellIndex2)
+{
+    deleteConnectionOneWay(cells[cellIndex1], cellIndex2);
+    deleteConnectionOneWay(cells[cellIndex2], cellIndex1);
+}
+
+void CpuConnectionService::deleteConnectionOneWay(CpuCell& cell, int connectedCellIndex)
+{
+    for (int i = 0; i < cell.numConnections; ++i) {
+        if (cell.connections[i].cellIndex == connectedCellIndex) {
+            auto angleToAdd = cell.connections[i].angleFromPrevious;
+            for (int j = i; j < cell.numConnections - 1; ++j) {
+                cell.connections[j] = cell.connections[j + 1];
+            }
+            if (i < cell.numConnections - 1) {
+                cell.connections[i].angleFromPrevious += angleToAdd;
+            } else {
+                cell.connections[0].angleFromPrevious += angleToAdd;
+            }
+            --cell.numConnections;
+            return;
+        }
+    }
+}
+
+bool CpuConnectionService::isConnectedConnected(std::vector<CpuCell> const& cells, int cellIndex, int otherCellIndex)
+{
+    if (cellIndex == otherCellIndex) {
+        return true;
+    }
+    auto const& otherCell = cells[otherCellIndex];
+    for (int i = 0; i < otherCell.numConnections; ++i) {
+        auto connectedCellIndex = otherCell.connections[i].cellIndex;
+        if (connectedCellIndex == cellIndex || cells[connectedCellIndex].isConnectedTo(cellIndex)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CpuConnectionService::tryAddConnectionOneWay(
+    std::vector<CpuCell>& cells,
+    SpaceCalculator const& spaceCalculator,
+    int cellIndex1,
+    int cellIndex2,
+    RealVector2D const& posDelta,
+    float desiredDistance,
+    float desiredAngleOnCell1,
+    ConstructorAngleAlignment angleAlignment)
+{
+    auto& cell1 = cells[cellIndex1];
+    if (cell1.numConnections == MAX_CELL_BONDS || wouldResultInOverlappingConnection(cells, cellIndex1, cells[cellIndex2].properties.pos)) {
+        return false;
+    }
+    angleAlignment %= ConstructorAngleAlignment_Count;
+
+    auto newAngle = Math::angleOfVector(posDelta);
+    if (desiredDistance == 0) {
+        desiredDistance = Math::length(posDelta);
+    }
+
+    if (0 == cell1.numConnections) {
+        cell1.connections[0] = {cellIndex2, desiredDistance, 360.0f};
+        cell1.numConnections = 1;
+        return true;
+    }
+    auto getAngleToConnectedCell = [&](int connectionIndex) {
+        auto const& connectedCell = cells[cell1.connections[connectionIndex].cellIndex];
+        return Math::angleOfVector(spaceCalculator.getCorrectedDirection(connectedCell.properties.pos - cell1.properties.pos));
+    };
+    if (1 == cell1.numConnections) {
+        auto angleDiff = newAngle - getAngleToConnectedCell(0);
+        if (0 != desiredAngleOnCell1) {
+            angleDiff = desiredAngleOnCell1;
+        }
+        angleDiff = alignAngle(angleDiff, angleAlignment);
+        if (angleDiff < 0) {
+            angleDiff += 360.0f;
+        }
+        angleDiff = alignAngleOnBoundaries(angleDiff, 360.0f, angleAlignment);
+        if (std::abs(angleDiff) < NEAR_ZERO || std::abs(angleDiff - 360.0f) < NEAR_ZERO || std::abs(angleDiff + 360.0f) < NEAR_ZERO) {
+            return false;
+        }
+        cell1.connections[1] = {cellIndex2, desiredDistance, angleDiff};
+        cell1.connections[0].angleFromPrevious = 360.0f - angleDiff;
+        cell1.numConnections = 2;
+        return true;
+    }
+
+    //find appropriate index for new connection
+    int index = 0;
+    float prevAngle = 0;
+    float nextAngle = 0;
+    for (; index < cell1.numConnections; ++index) {
+        prevAngle = getAngleToConnectedCell((index + cell1.numConnections - 1) % cell1.numConnections);
+        nextAngle = getAngleToConnectedCell(index);
+        if (Math::isAngleInBetween(prevAngle, nextAngle, newAngle)) {
+            break;
+        }
+    }
+    if (index == cell1.numConnections) {
+        return false;
+    }
+
+    auto refAngle = cell1.connections[index].angleFromPrevious;
+    auto angleFromPrevious = desiredAngleOnCell1;
+    if (0 == desiredAngleOnCell1) {
+        auto angleDiff1 = Math::subtractAngle(newAngle, prevAngle);
+        auto angleDiff2 = Math::subtractAngle(nextAngle, prevAngle);
+        auto factor = angleDiff2 != 0 ? angleDiff1 / angleDiff2 : 0.5f;
+        angleFromPrevious = refAngle * factor;
+    }
+    angleFromPrevious = std::min(angleFromPrevious, refAngle);
+    angleFromPrevious = alignAngle(angleFromPrevious, angleAlignment);
+    angleFromPrevious = alignAngleOnBoundaries(angleFromPrevious, refAngle, angleAlignment);
+    if (angleFromPrevious < NEAR_ZERO) {
+        return false;
+    }
+
+    //adjust reference angle of next connection
+    auto nextAngleFromPrevious = refAngle - angleFromPrevious;
+    auto nextAngleFromPreviousAligned = alignAngle(nextAngleFromPrevious, angleAlignment);
+    auto angleDiff = nextAngleFromPreviousAligned - nextAngleFromPrevious;
+
+    auto nextNextIndex = (index + 1) % cell1.numConnections;
+    auto nextNextAngleFromPrevious = cell1.connections[nextNextIndex].angleFromPrevious;
+    if (nextNextAngleFromPrevious - angleDiff >= 0.0f && nextNextAngleFromPrevious - angleDiff <= 360.0f) {
+        if (nextAngleFromPreviousAligned < NEAR_ZERO || nextNextAngleFromPrevious - angleDiff < NEAR_ZERO) {
+            return false;
+        }
+        cell1.connections[index].angleFromPrevious = nextAngleFromPreviousAligned;
+        cell1.connections[nextNextIndex].angleFromPrevious = nextNextAngleFromPrevious - angleDiff;
+    } else {
+        if (nextAngleFromPrevious < NEAR_ZERO) {
+            return false;
+        }
+        cell1.connections[index].angleFromPrevious = nextAngleFromPrevious;
+    }
+
+    for (int j = cell1.numConnections; j > index; --j) {
+        cell1.connections[j] = cell1.connections[j - 1];
+    }
+    cell1.connections[index] = {cellIndex2, desiredDistance, angleFromPrevious};
+    ++cell1.numConnections;
+    return true;
+}
+
+bool CpuConnectionService::wouldResultInOverlappingConnection(std::vector<CpuCell> const& cells, int cellIndex, RealVector2D const& otherCellPos)
+{
+    auto const& cell = cells[cellIndex];
+    auto n = cell.numConnections;
+    if (n < 2) {
+        return false;
+    }
+    for (int i = 0; i < n; ++i) {
+        auto connectedCellIndex = cell.connections[i].cellIndex;
+        auto nextConnectedCellIndex = cell.connections[(i + 1) % n].cellIndex;
+        auto const& connectedCell = cells[connectedCellIndex];
+        if (!connectedCell.isConnectedTo(nextConnectedCellIndex)) {
+            continue;
+        }
+        if (Math::crossing(cell.properties.pos, otherCellPos, connectedCell.properties.pos, cells[nextConnectedCellIndex].properties.pos)) {
+            return true;
+        }
+    }
+    return false;
+}
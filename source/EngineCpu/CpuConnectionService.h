@@ -0,0 +1,42 @@
+#pragma once
+
+#include "EngineInterface/CellFunctionConstants.h"
+#include "EngineInterface/SpaceCalculator.h"
+
+#include "CpuObjects.h"
+#include "Definitions.h"
+
+//counterpart of CellConnectionProcessor on the GPU
+class CpuConnectionService
+{
+public:
+    //desiredAngleOnCell1/2 = 0: the angles result from the positions
+    //desiredDistance = 0: the current distance is used as reference distance
+    static bool tryAddConnections(
+        std::vector<CpuCell>& cells,
+        SpaceCalculator const& spaceCalculator,
+        int cellIndex1,
+        int cellIndex2,
+        float desiredAngleOnCell1 = 0,
+        float desiredAngleOnCell2 = 0,
+        float desiredDistance = 0,
+        ConstructorAngleAlignment angleAlignment = ConstructorAngleAlignment_None);
+    static void deleteConnections(std::vector<CpuCell>& cells, int cellIndex1, int cellIndex2);
+    static void deleteConnectionOneWay(CpuCell& cell, int connectedCellIndex);
+
+    //returns true if both cells are identical, directly connected or connected via a third cell
+    static bool isConnectedConnected(std::vector<CpuCell> const& cells, int cellIndex, int otherCellIndex);
+
+    static bool wouldResultInOverlappingConnection(std::vector<CpuCell> const& cells, int cellIndex, RealVector2D const& otherCellPos);
+
+private:
+    static bool tryAddConnectionOneWay(
+        std::vector<CpuCell>& cells,
+        SpaceCalculator const& spaceCalculator,
+        int cellIndex1,
+        int cellIndex2,
+        RealVector2D const& posDelta,
+        float desiredDistance,
+        float desiredAngleOnCell1,
+        ConstructorAngleAlignment angleAlignment);
+};
@@ -0,0 +1,712 @@
+#include "CpuConstructorProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+#include "Base/Math.h"
+#include "EngineInterface/ShapeGenerator.h"
+
+#include "CpuConnectionService.h"
+
+namespace
+{
+    std::optional<int> toOptional(int value)
+    {
+        return value != -1 ? std::make_optional(value) : std::nullopt;
+    }
+}
+
+void CpuConstructorProcessor::preprocess(CpuCellFunctionData& data)
+{
+    for (auto const& cellIndex : data.cellFunctionOperations[CellFunction_Constructor]) {
+        completenessCheck(data, cellIndex);
+    }
+}
+
+void CpuConstructorProcessor::process(CpuCellFunctionData& data, AccumulatedStatistics& statistics)
+{
+    auto const& operations = data.cellFunctionOperations[CellFunction_Constructor];
+
+    //each constructor creates at most one cell, reserving the capacity keeps the references to the cells valid
+    data.data.cells.reserve(data.data.cells.size() + operations.size());
+    for (auto const& cellIndex : operations) {
+        processCell(data, statistics, cellIndex);
+    }
+}
+
+void CpuConstructorProcessor::completenessCheck(CpuCellFunctionData& data, int cellIndex)
+{
+    if (!data.parameters.cellFunctionConstructorCheckCompletenessForSelfReplication) {
+        return;
+    }
+    auto& cells = data.data.cells;
+    auto& cell = cells[cellIndex];
+    auto const& constructor = CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(cell);
+    if (!CpuGenomeDecoder::isFirstNode(constructor)) {
+        return;
+    }
+    auto activity = CpuCellFunctionProcessor::calcInputActivity(cells, cell, data.parameters);
+    if (!isConstructionTriggered(data, cell, activity)) {
+        return;
+    }
+
+    if (constructor.numInheritedGenomeNodes == 0 || CpuGenomeDecoder::isFinished(constructor)
+        || !CpuGenomeDecoder::containsSelfReplication(constructor.genome)) {
+        cell.constructorComplete = true;
+        return;
+    }
+
+    //count the connected cells of the same creature
+    std::unordered_set<int> visitedCells{cellIndex};
+    std::vector<int> cellsToVisit{cellIndex};
+    while (!cellsToVisit.empty()) {
+        auto const& currentCell = cells[cellsToVisit.back()];
+        cellsToVisit.pop_back();
+        for (int i = 0; i < currentCell.numConnections; ++i) {
+            auto nextCellIndex = currentCell.connections[i].cellIndex;
+            if (cells[nextCellIndex].properties.creatureId == cell.properties.creatureId && visitedCells.insert(nextCellIndex).second) {
+                cellsToVisit.emplace_back(nextCellIndex);
+            }
+        }
+    }
+    cell.constructorComplete = toInt(visitedCells.size()) >= constructor.numInheritedGenomeNodes;
+}
+
+void CpuConstructorProcessor::processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex)
+{
+    auto& cell = data.data.cells[cellIndex];
+    auto& constructor = CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(cell);
+    auto activity = CpuCellFunctionProcessor::calcInputActivity(data.data.cells, cell, data.parameters);
+    CpuCellFunctionProcessor::updateInvocationState(cell, activity);
+    if (!CpuGenomeDecoder::isFinished(constructor)) {
+        auto constructionData = readConstructionData(data, cellIndex);
+        auto cellBuilt = false;
+        if (isConstructionTriggered(data, cell, activity)) {
+            auto newCellIndex = constructionData.lastConstructionCellIndex != -1 ? continueConstruction(data, statistics, cellIndex, constructionData)
+                                                                                 : startNewConstruction(data, statistics, cellIndex, constructionData);
+            if (newCellIndex != -1) {
+                cellBuilt = true;
+                cell.properties.cellFunctionUsed = CellFunctionUsed_Yes;
+            }
+        }
+
+        if (cellBuilt) {
+            activity.channels[0] = 1;
+            if (CpuGenomeDecoder::isLastNode(constructor)) {
+                constructor.genomeCurrentNodeIndex = 0;
+                if (!constructionData.genomeHeader.hasInfiniteRepetitions()) {
+                    ++constructor.genomeCurrentRepetition;
+                    if (constructor.genomeCurrentRepetition == constructionData.genomeHeader.numRepetitions) {
+                        constructor.genomeCurrentRepetition = 0;
+                        if (!constructionData.genomeHeader.separateConstruction) {
+                            ++constructor.currentBranch;
+                        }
+                    }
+                }
+            } else {
+                ++constructor.genomeCurrentNodeIndex;
+            }
+        } else {
+            activity.channels[0] = 0;
+        }
+    }
+    CpuCellFunctionProcessor::setActivity(cell, activity);
+}
+
+auto CpuConstructorProcessor::readConstructionData(CpuCellFunctionData& data, int cellIndex) -> ConstructionData
+{
+    auto& cell = data.data.cells[cellIndex];
+    auto& constructor = CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(cell);
+    auto genome = constructor.genome.data();
+    auto genomeSize = toInt(constructor.genome.size());
+
+    ConstructionData result;
+    result.genomeHeader = CpuGenomeDecoder::readGenomeHeader(constructor);
+    result.hasInfiniteRepetitions = CpuGenomeDecoder::hasInfiniteRepetitions(constructor);
+    result.containsSelfReplication = isSelfReplicator(cell);
+    auto genomeNodesPerRepetition = CpuGenomeDecoder::getNumNodes(genome, genomeSize);
+    if (!CpuGenomeDecoder::hasInfiniteRepetitions(constructor) && constructor.genomeCurrentNodeIndex == 0 && constructor.genomeCurrentRepetition == 0) {
+        result.lastConstructionCellIndex = -1;
+    } else {
+        result.lastConstructionCellIndex = getLastConstructedCell(data.data.cells, cell);
+    }
+
+    if (result.lastConstructionCellIndex == -1) {
+        //finished => reset indices
+        constructor.genomeCurrentNodeIndex = 0;
+        constructor.genomeCurrentRepetition = 0;
+    } else if (data.data.cells[result.lastConstructionCellIndex].numConnections == 1 && constructor.numInheritedGenomeNodes > 1) {
+        int numConstructedCells = constructor.genomeCurrentRepetition * genomeNodesPerRepetition + constructor.genomeCurrentNodeIndex;
+        if (numConstructedCells > 1) {
+
+            //construction is broken => reset indices
+            constructor.genomeCurrentNodeIndex = 0;
+            constructor.genomeCurrentRepetition = 0;
+        }
+    }
+    result.genomeCurrentBytePosition = CpuGenomeDecoder::getNodeAddress(genome, genomeSize, constructor.genomeCurrentNodeIndex);
+    result.isLastNode = CpuGenomeDecoder::isLastNode(constructor);
+    result.isLastNodeOfLastRepetition = result.isLastNode && CpuGenomeDecoder::isLastRepetition(constructor);
+
+    if (auto shapeGenerator = ShapeGeneratorFactory::create(result.genomeHeader.shape)) {
+        for (int i = 0; i <= constructor.genomeCurrentNodeIndex; ++i) {
+            auto generationResult = shapeGenerator->generateNextConstructionData();
+            if (i == constructor.genomeCurrentNodeIndex) {
+                result.numRequiredAdditionalConnections = generationResult.numRequiredAdditionalConnections.value_or(-1);
+                result.angle = generationResult.angle;
+                result.genomeHeader.angleAlignment = shapeGenerator->getConstructorAngleAlignment();
+            }
+        }
+    }
+
+    auto const& numExecutionOrderNumbers = data.parameters.cellNumExecutionOrderNumbers;
+    result.cellFunction = CpuGenomeDecoder::readByte(constructor, result.genomeCurrentBytePosition) % CellFunction_Count;
+    auto angle = CpuGenomeDecoder::readAngle(constructor, result.genomeCurrentBytePosition);
+    result.energy = CpuGenomeDecoder::readEnergy(constructor, result.genomeCurrentBytePosition);
+    int numRequiredAdditionalConnections = CpuGenomeDecoder::readByte(constructor, result.genomeCurrentBytePosition);
+    numRequiredAdditionalConnections = numRequiredAdditionalConnections > 127 ? -1 : numRequiredAdditionalConnections % (MAX_CELL_BONDS + 1);
+    result.executionOrderNumber = CpuGenomeDecoder::readByte(constructor, result.genomeCurrentBytePosition) % numExecutionOrderNumbers;
+    result.color = CpuGenomeDecoder::readByte(constructor, result.genomeCurrentBytePosition) % MAX_COLORS;
+    result.inputExecutionOrderNumber = CpuGenomeDecoder::readOptionalByte(constructor, result.genomeCurrentBytePosition, numExecutionOrderNumbers);
+    result.outputBlocked = CpuGenomeDecoder::readBool(constructor, result.genomeCurrentBytePosition);
+
+    if (result.genomeHeader.shape == ConstructionShape_Custom) {
+        result.angle = angle;
+        result.numRequiredAdditionalConnections = numRequiredAdditionalConnections;
+    }
+
+    if (genomeNodesPerRepetition == 1) {
+        result.numRequiredAdditionalConnections = -1;
+    }
+
+    auto isAtFirstNode = CpuGenomeDecoder::isFirstNode(constructor);
+    if (isAtFirstNode) {
+        if (CpuGenomeDecoder::isFirstRepetition(constructor)) {
+            result.angle = constructor.constructionAngle1;
+        } else {
+            result.angle = result.genomeHeader.concatenationAngle1;
+        }
+    }
+    if (result.isLastNode && !isAtFirstNode) {
+        if (result.isLastNodeOfLastRepetition) {
+            result.angle = constructor.constructionAngle2;
+        } else {
+            result.angle = result.genomeHeader.concatenationAngle2;
+        }
+    }
+    return result;
+}
+
+bool CpuConstructorProcessor::isConstructionTriggered(CpuCellFunctionData const& data, CpuCell const& cell, ActivityDescription const& activity)
+{
+    auto const& properties = cell.properties;
+    auto const& constructor = std::get<ConstructorDescription>(*properties.cellFunction);
+    if (constructor.activationMode == 0 && std::abs(activity.channels[0]) < data.parameters.cellFunctionConstructorActivityThreshold[properties.color]) {
+        return false;
+    }
+    if (constructor.activationMode > 0
+        && (data.timestep % (data.parameters.cellNumExecutionOrderNumbers * constructor.activationMode) != static_cast<uint64_t>(properties.executionOrderNumber))) {
+        return false;
+    }
+    return true;
+}
+
+int CpuConstructorProcessor::getLastConstructedCell(std::vector<CpuCell> const& cells, CpuCell const& hostCell)
+{
+    auto const& constructor = std::get<ConstructorDescription>(*hostCell.properties.cellFunction);
+    if (constructor.lastConstructedCellId != 0) {
+        for (int i = 0; i < hostCell.numConnections; ++i) {
+            auto connectedCellIndex = hostCell.connections[i].cellIndex;
+            if (cells[connectedCellIndex].properties.id == constructor.lastConstructedCellId) {
+                return connectedCellIndex;
+            }
+        }
+    }
+
+    //if lastConstructedCellId is not set (in older version or if cells got new ids)
+    else {
+        for (int i = 0; i < hostCell.numConnections; ++i) {
+            auto connectedCellIndex = hostCell.connections[i].cellIndex;
+            if (cells[connectedCellIndex].properties.livingState == LivingState_UnderConstruction) {
+                return connectedCellIndex;
+            }
+        }
+        for (int i = 0; i < hostCell.numConnections; ++i) {
+            auto connectedCellIndex = hostCell.connections[i].cellIndex;
+            if (cells[connectedCellIndex].properties.livingState == LivingState_Dying) {
+                return connectedCellIndex;
+            }
+        }
+    }
+    return -1;
+}
+
+int CpuConstructorProcessor::startNewConstruction(
+    CpuCellFunctionData& data,
+    AccumulatedStatistics& statistics,
+    int hostCellIndex,
+    ConstructionData const& constructionData)
+{
+    auto& cells = data.data.cells;
+    auto& hostCell = cells[hostCellIndex];
+    auto& constructor = CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(hostCell);
+
+    if (!isConnectable(hostCell.numConnections, hostCell.properties.maxConnections, true)) {
+        return -1;
+    }
+    CpuRandom random(data.seed, data.timestep, CpuRandomStage_Constructor, hostCellIndex);
+    auto anglesForNewConnection = CpuCellFunctionProcessor::calcLargestGapReferenceAndActualAngle(data, random, hostCellIndex, constructionData.angle);
+
+    auto newCellDirection = Math::unitVectorOfAngle(anglesForNewConnection.actualAngle);
+    auto newCellPos = hostCell.properties.pos + newCellDirection;
+
+    if (CpuCellFunctionProcessor::existCrossingConnections(data, hostCell.properties.pos, newCellPos, hostCell.detached, hostCell.properties.color)) {
+        return -1;
+    }
+
+    if (data.parameters.cellFunctionConstructorCheckCompletenessForSelfReplication && !hostCell.constructorComplete) {
+        return -1;
+    }
+
+    if (!checkAndReduceHostEnergy(data, hostCell, constructionData)) {
+        return -1;
+    }
+
+    if (constructionData.containsSelfReplication) {
+        constructor.offspringCreatureId = 1 + random.random(65535);
+
+        hostCell.properties.genomeComplexity = calcGenomeComplexity(data.parameters, hostCell.properties.color, constructor.genome);
+    } else {
+        constructor.offspringCreatureId = hostCell.properties.creatureId;
+    }
+
+    auto newCellIndex = constructCellIntern(data, statistics, hostCellIndex, newCellPos, 0, constructionData);
+    auto& newCell = cells[newCellIndex];
+
+    if (!constructionData.isLastNodeOfLastRepetition || !constructionData.genomeHeader.separateConstruction) {
+        auto distance = constructionData.isLastNodeOfLastRepetition && !constructionData.genomeHeader.separateConstruction
+            ? 1.0f
+            : data.parameters.cellFunctionConstructorOffspringDistance[hostCell.properties.color];
+        if (!CpuConnectionService::tryAddConnections(cells, data.spaceCalculator, hostCellIndex, newCellIndex, anglesForNewConnection.referenceAngle, 0, distance)) {
+            data.deleteCells.emplace_back(newCellIndex);
+        }
+    }
+    if (constructionData.isLastNodeOfLastRepetition || (constructionData.isLastNode && constructionData.hasInfiniteRepetitions)) {
+        newCell.properties.livingState = LivingState_Activating;
+    }
+    hostCell.properties.maxConnections = std::max(hostCell.numConnections, hostCell.properties.maxConnections);
+    newCell.properties.maxConnections = std::max(newCell.numConnections, newCell.properties.maxConnections);
+
+    return newCellIndex;
+}
+
+int CpuConstructorProcessor::continueConstruction(
+    CpuCellFunctionData& data,
+    AccumulatedStatistics& statistics,
+    int hostCellIndex,
+    ConstructionData const& constructionData)
+{
+    auto& cells = data.data.cells;
+    auto& hostCell = cells[hostCellIndex];
+    auto lastConstructionCellIndex = constructionData.lastConstructionCellIndex;
+    auto& lastConstructionCell = cells[lastConstructionCellIndex];
+    auto const& spaceCalculator = data.spaceCalculator;
+
+    auto posDelta = spaceCalculator.getCorrectedDirection(lastConstructionCell.properties.pos - hostCell.properties.pos);
+
+    auto desiredDistance = constructionData.genomeHeader.connectionDistance;
+    auto constructionSiteDistance = Math::length(posDelta);
+    posDelta = Math::normalized(posDelta) * (constructionSiteDistance - desiredDistance);
+
+    if (Math::length(posDelta) <= data.parameters.cellMinDistance || constructionSiteDistance - desiredDistance < data.parameters.cellMinDistance) {
+        return -1;
+    }
+
+    auto newCellPos = spaceCalculator.getCorrectedPosition(hostCell.properties.pos + posDelta);
+
+    //get surrounding cells
+    std::vector<int> otherCellCandidates;
+    auto offspringCreatureId = std::get<ConstructorDescription>(*hostCell.properties.cellFunction).offspringCreatureId;
+    CpuCellFunctionProcessor::getMatchingCells(
+        data,
+        otherCellCandidates,
+        MAX_CELL_BONDS * 2,
+        newCellPos,
+        data.parameters.cellFunctionConstructorConnectingCellMaxDistance[hostCell.properties.color],
+        hostCell.detached,
+        [&](int otherCellIndex) {
+            auto const& otherProperties = cells[otherCellIndex].properties;
+            if (otherCellIndex == lastConstructionCellIndex || otherCellIndex == hostCellIndex
+                || (otherProperties.livingState != LivingState_UnderConstruction && otherProperties.activationTime == 0)
+                || otherProperties.creatureId != offspringCreatureId) {
+                return false;
+            }
+            return true;
+        });
+
+    //assemble surrounding cell candidates
+    std::vector<int> otherCells;
+    for (auto const& otherCellIndex : otherCellCandidates) {
+        if (!CpuConnectionService::wouldResultInOverlappingConnection(cells, otherCellIndex, newCellPos)) {
+            otherCells.emplace_back(otherCellIndex);
+        }
+        if (otherCells.size() == MAX_CELL_BONDS) {
+            break;
+        }
+    }
+    if (constructionData.numRequiredAdditionalConnections != -1) {
+        if (toInt(otherCells.size()) < constructionData.numRequiredAdditionalConnections) {
+            return -1;
+        }
+    }
+
+    if (!checkAndReduceHostEnergy(data, hostCell, constructionData)) {
+        return -1;
+    }
+    auto newCellIndex = constructCellIntern(data, statistics, hostCellIndex, newCellPos, 0, constructionData);
+    auto& newCell = cells[newCellIndex];
+
+    if (lastConstructionCell.properties.livingState == LivingState_Dying) {
+        newCell.properties.livingState = LivingState_Dying;
+    }
+
+    if (constructionData.isLastNodeOfLastRepetition || (constructionData.isLastNode && constructionData.hasInfiniteRepetitions)) {
+        newCell.properties.livingState = LivingState_Activating;
+    }
+
+    float angleFromPreviousForUnderConstructionCell = 0;
+    for (int i = 0; i < lastConstructionCell.numConnections; ++i) {
+        if (lastConstructionCell.connections[i].cellIndex == hostCellIndex) {
+            angleFromPreviousForUnderConstructionCell = lastConstructionCell.connections[i].angleFromPrevious;
+            break;
+        }
+    }
+
+    //possibly connect newCell to hostCell
+    bool adaptReferenceAngle = false;
+    if (!constructionData.isLastNodeOfLastRepetition || !constructionData.genomeHeader.separateConstruction) {
+
+        //move connection between lastConstructionCell and hostCell to a connection between newCell and hostCell
+        auto distance = constructionData.isLastNodeOfLastRepetition && !constructionData.genomeHeader.separateConstruction
+            ? 1.0f
+            : data.parameters.cellFunctionConstructorOffspringDistance[hostCell.properties.color];
+        for (int i = 0; i < hostCell.numConnections; ++i) {
+            auto& connection = hostCell.connections[i];
+            if (connection.cellIndex == lastConstructionCellIndex) {
+                connection.cellIndex = newCellIndex;
+                connection.distance = distance;
+                newCell.numConnections = 1;
+                newCell.connections[0].cellIndex = hostCellIndex;
+                newCell.connections[0].distance = distance;
+                newCell.connections[0].angleFromPrevious = 360.0f;
+                adaptReferenceAngle = true;
+                CpuConnectionService::deleteConnectionOneWay(lastConstructionCell, hostCellIndex);
+                break;
+            }
+        }
+    } else {
+
+        //cut connections
+        CpuConnectionService::deleteConnections(cells, hostCellIndex, lastConstructionCellIndex);
+    }
+
+    //connect newCell to lastConstructionCell
+    auto angleFromPreviousForNewCell = 180.0f - constructionData.angle;
+    if (!CpuConnectionService::tryAddConnections(
+            cells, spaceCalculator, newCellIndex, lastConstructionCellIndex, 0, angleFromPreviousForUnderConstructionCell, desiredDistance)) {
+        adaptReferenceAngle = false;
+        data.deleteCells.emplace_back(newCellIndex);
+        hostCell.properties.livingState = LivingState_Dying;
+        for (int i = 0; i < hostCell.numConnections; ++i) {
+            auto& connectedProperties = cells[hostCell.connections[i].cellIndex].properties;
+            if (connectedProperties.creatureId == hostCell.properties.creatureId) {
+                connectedProperties.livingState = LivingState_Detaching;
+            }
+        }
+    }
+
+    //connect surrounding cells if possible
+    if (!otherCells.empty()) {
+
+        //sort surrounding cells by distance from newCell
+        std::stable_sort(otherCells.begin(), otherCells.end(), [&](int cellIndex1, int cellIndex2) {
+            return spaceCalculator.distance(cells[cellIndex1].properties.pos, newCellPos) < spaceCalculator.distance(cells[cellIndex2].properties.pos, newCellPos);
+        });
+
+        if (constructionData.numRequiredAdditionalConnections != -1) {
+            //it is already ensured that otherCells contains at least constructionData.numRequiredAdditionalConnections entries
+            otherCells.resize(constructionData.numRequiredAdditionalConnections);
+        }
+
+        for (auto const& otherCellIndex : otherCells) {
+            auto& otherCell = cells[otherCellIndex];
+            if (isConnectable(newCell.numConnections, newCell.properties.maxConnections, true)
+                && isConnectable(otherCell.numConnections, otherCell.properties.maxConnections, true)) {
+
+                CpuConnectionService::tryAddConnections(
+                    cells, spaceCalculator, newCellIndex, otherCellIndex, 0, 0, desiredDistance, constructionData.genomeHeader.angleAlignment);
+                otherCell.properties.maxConnections = std::max(otherCell.numConnections, otherCell.properties.maxConnections);
+            }
+        }
+    }
+
+    if (adaptReferenceAngle) {
+        auto n = newCell.numConnections;
+        int constructionIndex = 0;
+        for (; constructionIndex < n; ++constructionIndex) {
+            if (newCell.connections[constructionIndex].cellIndex == lastConstructionCellIndex) {
+                break;
+            }
+        }
+        int hostIndex = 0;
+        for (; hostIndex < n; ++hostIndex) {
+            if (newCell.connections[hostIndex].cellIndex == hostCellIndex) {
+                break;
+            }
+        }
+
+        float consumedAngle1 = 0;
+        if (n > 2) {
+            for (int i = constructionIndex; (i + n) % n != (hostIndex + 1) % n && (i + n) % n != hostIndex; --i) {
+                consumedAngle1 += newCell.connections[(i + n) % n].angleFromPrevious;
+            }
+        }
+
+        float consumedAngle2 = 0;
+        if (n > 2) {
+            for (int i = constructionIndex + 1; i % n != hostIndex; ++i) {
+                consumedAngle2 += newCell.connections[i % n].angleFromPrevious;
+            }
+        }
+        if (angleFromPreviousForNewCell - consumedAngle1 >= 0 && 360.0f - angleFromPreviousForNewCell - consumedAngle2 >= 0) {
+            newCell.connections[(hostIndex + 1) % n].angleFromPrevious = angleFromPreviousForNewCell - consumedAngle1;
+            newCell.connections[hostIndex].angleFromPrevious = 360.0f - angleFromPreviousForNewCell - consumedAngle2;
+        }
+    }
+    hostCell.properties.maxConnections = std::max(hostCell.numConnections, hostCell.properties.maxConnections);
+    newCell.properties.maxConnections = std::max(newCell.numConnections, newCell.properties.maxConnections);
+
+    return newCellIndex;
+}
+
+bool CpuConstructorProcessor::isConnectable(int numConnections, int maxConnections, bool adaptMaxConnections)
+{
+    if (!adaptMaxConnections) {
+        if (numConnections >= maxConnections) {
+            return false;
+        }
+    } else {
+        if (numConnections >= MAX_CELL_BONDS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int CpuConstructorProcessor::constructCellIntern(
+    CpuCellFunctionData& data,
+    AccumulatedStatistics& statistics,
+    int hostCellIndex,
+    RealVector2D const& newCellPos,
+    int maxConnections,
+    ConstructionData const& constructionData)
+{
+    auto& cells = data.data.cells;
+    auto& hostCell = cells[hostCellIndex];
+    auto& constructor = CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(hostCell);
+    auto const& hostProperties = hostCell.properties;
+
+    CpuCell result;
+    auto& properties = result.properties;
+    properties.id = data.data.createNewId();
+    constructor.lastConstructedCellId = properties.id;
+    properties.energy = constructionData.energy;
+    properties.stiffness = constructionData.genomeHeader.stiffness;
+    properties.pos = data.spaceCalculator.getCorrectedPosition(newCellPos);
+    properties.maxConnections = maxConnections;
+    properties.executionOrderNumber = constructionData.executionOrderNumber;
+    properties.livingState = LivingState_UnderConstruction;
+    properties.creatureId = constructor.offspringCreatureId;
+    properties.mutationId = constructor.offspringMutationId;
+    properties.ancestorMutationId = static_cast<uint8_t>(hostProperties.mutationId & 0xff);
+    properties.color = constructionData.color;
+    properties.inputExecutionOrderNumber = toOptional(constructionData.inputExecutionOrderNumber);
+    properties.outputBlocked = constructionData.outputBlocked;
+
+    properties.activationTime = constructionData.containsSelfReplication ? constructor.constructionActivationTime : 0;
+    properties.genomeComplexity = hostProperties.genomeComplexity;
+
+    auto genomeCurrentBytePosition = constructionData.genomeCurrentBytePosition;
+    switch (constructionData.cellFunction) {
+    case CellFunction_Neuron: {
+        NeuronDescription neuron;
+        for (int i = 0; i < MAX_CHANNELS * MAX_CHANNELS; ++i) {
+            neuron.weights[i / MAX_CHANNELS][i % MAX_CHANNELS] = CpuGenomeDecoder::readFloat(constructor, genomeCurrentBytePosition) * 4;
+        }
+        for (int i = 0; i < MAX_CHANNELS; ++i) {
+            neuron.biases[i] = CpuGenomeDecoder::readFloat(constructor, genomeCurrentBytePosition) * 4;
+        }
+        for (int i = 0; i < MAX_CHANNELS; ++i) {
+            neuron.activationFunctions[i] = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition) % NeuronActivationFunction_Count;
+        }
+        properties.cellFunction = neuron;
+    } break;
+    case CellFunction_Transmitter: {
+        TransmitterDescription transmitter;
+        transmitter.mode = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition) % EnergyDistributionMode_Count;
+        properties.cellFunction = transmitter;
+    } break;
+    case CellFunction_Constructor: {
+        ConstructorDescription newConstructor;
+        newConstructor.activationMode = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition);
+        newConstructor.constructionActivationTime = CpuGenomeDecoder::readWord(constructor, genomeCurrentBytePosition) % MaxActivationTime;
+        newConstructor.lastConstructedCellId = 0;
+        newConstructor.currentBranch = 0;
+        newConstructor.genomeCurrentNodeIndex = 0;
+        newConstructor.genomeCurrentRepetition = 0;
+        newConstructor.constructionAngle1 = CpuGenomeDecoder::readAngle(constructor, genomeCurrentBytePosition);
+        newConstructor.constructionAngle2 = CpuGenomeDecoder::readAngle(constructor, genomeCurrentBytePosition);
+        newConstructor.genome = CpuGenomeDecoder::copyGenome(constructor.genome, genomeCurrentBytePosition);
+        auto numInheritedGenomeNodes =
+            CpuGenomeDecoder::getNumNodesRecursively(newConstructor.genome.data(), toInt(newConstructor.genome.size()), true, false);
+        newConstructor.numInheritedGenomeNodes = std::min(0xffff, numInheritedGenomeNodes);
+        newConstructor.genomeGeneration = constructor.genomeGeneration + 1;
+        newConstructor.offspringMutationId = constructor.offspringMutationId;
+        if (CpuGenomeDecoder::containsSelfReplication(newConstructor.genome)) {
+            ++statistics.numCreatedReplicators[hostProperties.color];
+        }
+        properties.cellFunction = std::move(newConstructor);
+    } break;
+    case CellFunction_Sensor: {
+        SensorDescription sensor;
+        auto mode = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition) % SensorMode_Count;
+        auto angle = CpuGenomeDecoder::readAngle(constructor, genomeCurrentBytePosition);
+        if (mode == SensorMode_FixedAngle) {
+            sensor.fixedAngle = angle;
+        }
+        sensor.minDensity = (CpuGenomeDecoder::readFloat(constructor, genomeCurrentBytePosition) + 1.0f) / 2;
+        sensor.restrictToColor = toOptional(CpuGenomeDecoder::readOptionalByte(constructor, genomeCurrentBytePosition, MAX_COLORS));
+        sensor.restrictToMutants = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition) % SensorRestrictToMutants_Count;
+        sensor.minRange = toOptional(CpuGenomeDecoder::readOptionalByte(constructor, genomeCurrentBytePosition));
+        sensor.maxRange = toOptional(CpuGenomeDecoder::readOptionalByte(constructor, genomeCurrentBytePosition));
+        properties.cellFunction = sensor;
+    } break;
+    case CellFunction_Nerve: {
+        NerveDescription nerve;
+        nerve.pulseMode = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition);
+        nerve.alternationMode = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition);
+        properties.cellFunction = nerve;
+    } break;
+    case CellFunction_Attacker: {
+        AttackerDescription attacker;
+        attacker.mode = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition) % EnergyDistributionMode_Count;
+        properties.cellFunction = attacker;
+    } break;
+    case CellFunction_Injector: {
+        InjectorDescription injector;
+        injector.mode = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition) % InjectorMode_Count;
+        injector.counter = 0;
+        injector.genome = CpuGenomeDecoder::copyGenome(constructor.genome, genomeCurrentBytePosition);
+        injector.genomeGeneration = constructor.genomeGeneration + 1;
+        properties.cellFunction = std::move(injector);
+    } break;
+    case CellFunction_Muscle: {
+        MuscleDescription muscle;
+        muscle.mode = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition) % MuscleMode_Count;
+        properties.cellFunction = muscle;
+    } break;
+    case CellFunction_Defender: {
+        DefenderDescription defender;
+        defender.mode = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition) % DefenderMode_Count;
+        properties.cellFunction = defender;
+    } break;
+    case CellFunction_Reconnector: {
+        ReconnectorDescription reconnector;
+        reconnector.restrictToColor = toOptional(CpuGenomeDecoder::readOptionalByte(constructor, genomeCurrentBytePosition, MAX_COLORS));
+        reconnector.restrictToMutants = CpuGenomeDecoder::readByte(constructor, genomeCurrentBytePosition) % ReconnectorRestrictToMutants_Count;
+        properties.cellFunction = reconnector;
+    } break;
+    case CellFunction_Detonator: {
+        DetonatorDescription detonator;
+        detonator.state = DetonatorState_Ready;
+        detonator.countdown = CpuGenomeDecoder::readWord(constructor, genomeCurrentBytePosition);
+        properties.cellFunction = detonator;
+    } break;
+    }
+
+    ++statistics.numCreatedCells[hostProperties.color];
+    cells.emplace_back(std::move(result));
+    return toInt(cells.size()) - 1;
+}
+
+bool CpuConstructorProcessor::checkAndReduceHostEnergy(CpuCellFunctionData& data, CpuCell& hostCell, ConstructionData const& constructionData)
+{
+    auto const& parameters = data.parameters;
+    auto& hostEnergy = hostCell.properties.energy;
+    auto const& color = hostCell.properties.color;
+    if (parameters.features.externalEnergyControl && hostEnergy < constructionData.energy + parameters.cellNormalEnergy[color]
+        && parameters.externalEnergyInflowFactor[color] > 0) {
+        auto externalEnergyPortion = constructionData.energy * parameters.externalEnergyInflowFactor[color];
+
+        if (std::isinf(data.externalEnergy)) {
+            hostEnergy += externalEnergyPortion;
+        } else {
+            externalEnergyPortion = std::max(0.0f, std::min(toFloat(data.externalEnergy), externalEnergyPortion));
+            data.externalEnergy -= externalEnergyPortion;
+            hostEnergy += externalEnergyPortion;
+        }
+    }
+
+    auto externalEnergyConditionalInflowFactor = parameters.features.externalEnergyControl ? parameters.externalEnergyConditionalInflowFactor[color] : 0.0f;
+
+    auto energyNeededFromHost = std::max(0.0f, constructionData.energy - parameters.cellNormalEnergy[color])
+        + std::min(constructionData.energy, parameters.cellNormalEnergy[color]) * (1.0f - externalEnergyConditionalInflowFactor);
+
+    if (externalEnergyConditionalInflowFactor < 1.0f && hostEnergy < parameters.cellNormalEnergy[color] + energyNeededFromHost) {
+        return false;
+    }
+    auto energyNeededFromExternalSource = constructionData.energy - energyNeededFromHost;
+    if (data.externalEnergy < energyNeededFromExternalSource) {
+        if (hostEnergy < parameters.cellNormalEnergy[color] + constructionData.energy) {
+            return false;
+        }
+        hostEnergy -= constructionData.energy;
+    } else {
+        data.externalEnergy -= energyNeededFromExternalSource;
+        hostEnergy -= energyNeededFromHost;
+    }
+    return true;
+}
+
+bool CpuConstructorProcessor::isSelfReplicator(CpuCell const& cell)
+{
+    if (cell.properties.getCellFunctionType() != CellFunction_Constructor) {
+        return false;
+    }
+    return CpuGenomeDecoder::containsSelfReplication(std::get<ConstructorDescription>(*cell.properties.cellFunction).genome);
+}
+
+float CpuConstructorProcessor::calcGenomeComplexity(SimulationParameters const& parameters, int color, std::vector<uint8_t> const& genome)
+{
+    auto result = 0.0f;
+
+    auto lastDepth = 0;
+    auto numRamifications = 1;
+    auto genomeComplexityRamificationFactor =
+        parameters.features.genomeComplexityMeasurement ? parameters.genomeComplexityRamificationFactor[color] : 0.0f;
+    auto sizeFactor = parameters.features.genomeComplexityMeasurement ? parameters.genomeComplexitySizeFactor[color] : 1.0f;
+    auto genomeSize = toInt(genome.size());
+    CpuGenomeDecoder::executeForEachNodeRecursively(genome.data(), genomeSize, false, false, [&](int depth, int nodeAddress, int repetitions) {
+        auto ramificationFactor = depth > lastDepth ? genomeComplexityRamificationFactor * toFloat(numRamifications) : 0.0f;
+        auto cellFunctionType = CpuGenomeDecoder::getNextCellFunctionType(genome.data(), genomeSize, nodeAddress);
+        auto neuronFactor = cellFunctionType == CellFunction_Neuron ? parameters.genomeComplexityNeuronFactor[color] : 0.0f;
+        result += toFloat(repetitions) * (ramificationFactor + sizeFactor + neuronFactor);
+        lastDepth = depth;
+        if (ramificationFactor > 0) {
+            ++numRamifications;
+        }
+    });
+
+    return result;
+}
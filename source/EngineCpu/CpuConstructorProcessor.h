@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CpuCellFunctionProcessor.h"
+#include "CpuGenomeDecoder.h"
+
+//counterpart of ConstructorProcessor on the GPU
+class CpuConstructorProcessor
+{
+public:
+    static void preprocess(CpuCellFunctionData& data);
+    static void process(CpuCellFunctionData& data, AccumulatedStatistics& statistics);
+
+private:
+    struct ConstructionData
+    {
+        //genome-wide data
+        CpuGenomeDecoder::GenomeHeader genomeHeader;
+
+        //node position data
+        int genomeCurrentBytePosition = 0;
+        bool isLastNode = false;
+        bool isLastNodeOfLastRepetition = false;
+        bool hasInfiniteRepetitions = false;
+
+        //node data
+        float angle = 0;
+        float energy = 0;
+        int numRequiredAdditionalConnections = -1;
+        int executionOrderNumber = 0;
+        int color = 0;
+        int inputExecutionOrderNumber = -1;
+        bool outputBlocked = false;
+        CellFunction cellFunction = CellFunction_None;
+
+        //construction data
+        int lastConstructionCellIndex = -1;
+        bool containsSelfReplication = false;
+    };
+
+    static void completenessCheck(CpuCellFunctionData& data, int cellIndex);
+
+    static void processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex);
+    static ConstructionData readConstructionData(CpuCellFunctionData& data, int cellIndex);
+    static bool isConstructionTriggered(CpuCellFunctionData const& data, CpuCell const& cell, ActivityDescription const& activity);
+
+    static int getLastConstructedCell(std::vector<CpuCell> const& cells, CpuCell const& hostCell);
+    static int startNewConstruction(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int hostCellIndex, ConstructionData const& constructionData);
+    static int continueConstruction(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int hostCellIndex, ConstructionData const& constructionData);
+
+    static bool isConnectable(int numConnections, int maxConnections, bool adaptMaxConnections);
+
+    static int constructCellIntern(
+        CpuCellFunctionData& data,
+        AccumulatedStatistics& statistics,
+        int hostCellIndex,
+        RealVector2D const& newCellPos,
+        int maxConnections,
+        ConstructionData const& constructionData);
+
+    static bool checkAndReduceHostEnergy(CpuCellFunctionData& data, CpuCell& hostCell, ConstructionData const& constructionData);
+
+    static bool isSelfReplicator(CpuCell const& cell);
+    static float calcGenomeComplexity(SimulationParameters const& parameters, int color, std::vector<uint8_t> const& genome);
+};
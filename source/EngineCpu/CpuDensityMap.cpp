@@ -0,0 +1,204 @@
+#include "CpuDensityMap.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "EngineInterface/EngineConstants.h"
+
+void CpuDensityMap::build(IntVector2D const& worldSize, uint64_t timestep, std::vector<CpuCell> const& cells)
+{
+    _densityMapSize = {worldSize.x / SlotSize, worldSize.y / SlotSize};
+    auto size = static_cast<size_t>(std::max(0, _densityMapSize.x * _densityMapSize.y));
+    for (auto map : {&_colorDensityMap,
+                     &_otherMutantDensityMap,
+                     &_sameMutantDensityMap1,
+                     &_sameMutantDensityMap2,
+                     &_lessGenomeComplexityDensityMap1,
+                     &_lessGenomeComplexityDensityMap2,
+                     &_moreGenomeComplexityDensityMap1,
+                     &_moreGenomeComplexityDensityMap2}) {
+        map->assign(size, 0);
+    }
+    _specificMutantDensityMap.assign(size, 0);
+
+    for (auto const& cell : cells) {
+        if (!cell.deleted) {
+            addCell(timestep, cell);
+        }
+    }
+}
+
+uint32_t CpuDensityMap::getCellDensity(RealVector2D const& pos) const
+{
+    auto index = getIndex(pos);
+    if (index != -1) {
+        return static_cast<uint32_t>((_colorDensityMap[index] >> 56) & 0xff);
+    }
+    return 0;
+}
+
+uint32_t CpuDensityMap::getColorDensity(RealVector2D const& pos, int color) const
+{
+    auto index = getIndex(pos);
+    if (index != -1) {
+        return static_cast<uint32_t>((_colorDensityMap[index] >> (color * 8)) & 0xff);
+    }
+    return 0;
+}
+
+uint32_t CpuDensityMap::getOtherMutantDensity(uint64_t timestep, RealVector2D const& pos, uint32_t mutationId) const
+{
+    auto index = getIndex(pos);
+    if (index != -1) {
+        auto bucket = calcOtherMutantsBucket(mutationId, timestep);
+        return static_cast<uint32_t>((_otherMutantDensityMap[index] >> (bucket * 8)) & 0xff);
+    }
+    return 0;
+}
+
+uint32_t CpuDensityMap::getSameMutantDensity(RealVector2D const& pos, uint32_t mutationId) const
+{
+    auto index = getIndex(pos);
+    if (index != -1) {
+        uint64_t bucket1 = mutationId % 3;
+        uint64_t bucket2 = mutationId % 5;
+        uint64_t bucket3 = mutationId % 7;
+        auto densityMapEntry = _sameMutantDensityMap1[index];
+        auto density1 = (densityMapEntry >> (bucket1 * 8)) & 0xff;
+        auto density2 = (densityMapEntry >> ((bucket2 + 3) * 8)) & 0xff;
+        auto density3 = (_sameMutantDensityMap2[index] >> (bucket3 * 8)) & 0xff;
+        return static_cast<uint32_t>(std::min(std::min(density1, density2), density3));
+    }
+    return 0;
+}
+
+uint32_t CpuDensityMap::getEmergentCellDensity(RealVector2D const& pos) const
+{
+    auto index = getIndex(pos);
+    if (index != -1) {
+        return (_specificMutantDensityMap[index] >> 8) & 0xff;
+    }
+    return 0;
+}
+
+uint32_t CpuDensityMap::getZeroMutantDensity(RealVector2D const& pos) const
+{
+    auto index = getIndex(pos);
+    if (index != -1) {
+        return _specificMutantDensityMap[index] & 0xff;
+    }
+    return 0;
+}
+
+uint32_t CpuDensityMap::getLessComplexMutantDensity(RealVector2D const& pos, float genomeComplexity) const
+{
+    auto index = getIndex(pos);
+    if (index != -1) {
+        auto bucket = std::min(16, std::max(0, 31 - std::countl_zero(convertGenomeComplexityToIntValue(genomeComplexity))));
+        if (bucket < 8) {
+            return (_lessGenomeComplexityDensityMap1[index] >> (bucket * 8)) & 0xff;
+        } else {
+            return (_lessGenomeComplexityDensityMap2[index] >> ((bucket - 8) * 8)) & 0xff;
+        }
+    }
+    return 0;
+}
+
+uint32_t CpuDensityMap::getMoreComplexMutantDensity(RealVector2D const& pos, float genomeComplexity) const
+{
+    auto index = getIndex(pos);
+    if (index != -1) {
+        auto bucket = std::min(16, std::max(0, 33 - std::countl_zero(convertGenomeComplexityToIntValue(genomeComplexity))));
+        if (bucket < 8) {
+            return (_moreGenomeComplexityDensityMap1[index] >> (bucket * 8)) & 0xff;
+        } else {
+            return (_moreGenomeComplexityDensityMap2[index] >> ((bucket - 8) * 8)) & 0xff;
+        }
+    }
+    return 0;
+}
+
+void CpuDensityMap::addCell(uint64_t timestep, CpuCell const& cell)
+{
+    auto const& properties = cell.properties;
+    auto index = getIndex(properties.pos);
+    if (index == -1) {
+        return;
+    }
+    auto color = ((properties.color % MAX_COLORS) + MAX_COLORS) % MAX_COLORS;
+    _colorDensityMap[index] += (1ull << (color * 8)) | (1ull << 56);
+
+    auto mutationId = static_cast<uint32_t>(properties.mutationId);
+    if (mutationId == 0) {
+        _specificMutantDensityMap[index] += 1;
+    } else if (mutationId == 1) {
+        _specificMutantDensityMap[index] += 0x100;
+    } else {
+        {
+            auto bucket = calcOtherMutantsBucket(mutationId, timestep);
+            _otherMutantDensityMap[index] += 0x0101010101010101ull ^ (1ull << (bucket * 8));
+        }
+        {
+            uint64_t bucket1 = mutationId % 3;
+            uint64_t bucket2 = mutationId % 5;
+            uint64_t bucket3 = mutationId % 7;
+            _sameMutantDensityMap1[index] += (1ull << (bucket1 * 8)) | (1ull << ((bucket2 + 3) * 8));
+            _sameMutantDensityMap2[index] += 1ull << (bucket3 * 8);
+        }
+        {
+            auto bucket = 32 - std::countl_zero(convertGenomeComplexityToIntValue(properties.genomeComplexity));
+            if (bucket < 8) {
+                {
+                    auto bitset = 1ull << (bucket * 8);
+                    for (int i = 0; i < 7; ++i) {
+                        bitset |= (bitset << 8);
+                    }
+                    _lessGenomeComplexityDensityMap1[index] += bitset;
+                    _lessGenomeComplexityDensityMap2[index] += 0x0101010101010101ull;
+                }
+                {
+                    auto bitset = 1ull << (bucket * 8);
+                    for (int i = 0; i < 7; ++i) {
+                        bitset |= (bitset >> 8);
+                    }
+                    _moreGenomeComplexityDensityMap1[index] += bitset;
+                }
+            } else if (bucket < 16) {
+                {
+                    auto bitset = 1ull << ((bucket - 8) * 8);
+                    for (int i = 0; i < 7; ++i) {
+                        bitset |= (bitset << 8);
+                    }
+                    _lessGenomeComplexityDensityMap2[index] += bitset;
+                }
+                {
+                    auto bitset = 1ull << ((bucket - 8) * 8);
+                    for (int i = 0; i < 7; ++i) {
+                        bitset |= (bitset >> 8);
+                    }
+                    _moreGenomeComplexityDensityMap2[index] += bitset;
+                    _moreGenomeComplexityDensityMap1[index] += 0x0101010101010101ull;
+                }
+            }
+        }
+    }
+}
+
+int CpuDensityMap::getIndex(RealVector2D const& pos) const
+{
+    auto index = toInt(pos.x) / SlotSize + toInt(pos.y) / SlotSize * _densityMapSize.x;
+    if (index >= 0 && index < _densityMapSize.x * _densityMapSize.y) {
+        return index;
+    }
+    return -1;
+}
+
+uint64_t CpuDensityMap::calcOtherMutantsBucket(uint32_t mutationId, uint64_t timestep)
+{
+    return mutationId != 0 ? (static_cast<uint64_t>(mutationId) + timestep / 23) % 8 : 0;
+}
+
+uint32_t CpuDensityMap::convertGenomeComplexityToIntValue(float genomeComplexity)
+{
+    return static_cast<uint32_t>(toInt(genomeComplexity * 10));
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Base/Vector2D.h"
+
+#include "CpuObjects.h"
+
+//counterpart of DensityMap on the GPU: cell densities per 8x8 slot packed into 8 bit counters
+class CpuDensityMap
+{
+public:
+    void build(IntVector2D const& worldSize, uint64_t timestep, std::vector<CpuCell> const& cells);
+
+    uint32_t getCellDensity(RealVector2D const& pos) const;
+    uint32_t getColorDensity(RealVector2D const& pos, int color) const;
+    uint32_t getOtherMutantDensity(uint64_t timestep, RealVector2D const& pos, uint32_t mutationId) const;
+    uint32_t getSameMutantDensity(RealVector2D const& pos, uint32_t mutationId) const;
+    uint32_t getEmergentCellDensity(RealVector2D const& pos) const;
+    uint32_t getZeroMutantDensity(RealVector2D const& pos) const;
+    uint32_t getLessComplexMutantDensity(RealVector2D const& pos, float genomeComplexity) const;
+    uint32_t getMoreComplexMutantDensity(RealVector2D const& pos, float genomeComplexity) const;
+
+private:
+    static auto constexpr SlotSize = 8;
+
+    void addCell(uint64_t timestep, CpuCell const& cell);
+    int getIndex(RealVector2D const& pos) const;
+
+    //timestep is used as an offset to avoid same buckets for different mutationIds for all times
+    static uint64_t calcOtherMutantsBucket(uint32_t mutationId, uint64_t timestep);
+    static uint32_t convertGenomeComplexityToIntValue(float genomeComplexity);
+
+    IntVector2D _densityMapSize;
+    std::vector<uint64_t> _colorDensityMap;
+    std::vector<uint64_t> _otherMutantDensityMap;
+    std::vector<uint64_t> _sameMutantDensityMap1;
+    std::vector<uint64_t> _sameMutantDensityMap2;
+    std::vector<uint32_t> _specificMutantDensityMap;
+    std::vector<uint64_t> _lessGenomeComplexityDensityMap1;
+    std::vector<uint64_t> _lessGenomeComplexityDensityMap2;
+    std::vector<uint64_t> _moreGenomeComplexityDensityMap1;
+    std::vector<uint64_t> _moreGenomeComplexityDensityMap2;
+};
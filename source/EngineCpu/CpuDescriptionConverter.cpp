@@ -0,0 +1,248 @@
+#include "CpuDescriptionConverter.h"
+
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+
+#include "Base/NumberGenerator.h"
+#include "Base/ParallelService.h"
+#include "EngineInterface/GenomeConstants.h"
+
+namespace
+{
+    void checkAndCorrectInvalidEnergy(float& energy)
+    {
+        if (std::isnan(energy) || energy < 0 || energy > 1e12) {
+            energy = 0;
+        }
+    }
+
+    int findRoot(std::vector<int>& parents, int index)
+    {
+        while (parents[index] != index) {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+        }
+        return index;
+    }
+}
+
+CpuDescriptionConverter::CpuDescriptionConverter(IntVector2D const& worldSize)
+    : _spaceCalculator(worldSize)
+{}
+
+void CpuDescriptionConverter::addDescription(CpuSimulationData& data, DataDescription const& description, bool createIds, bool selectNewData) const
+{
+    for (auto const& cellDesc : description.cells) {
+        checkCell(cellDesc);
+    }
+
+    auto startIndex = data.cells.size();
+    auto numCells = description.cells.size();
+
+    std::unordered_map<uint64_t, int> cellIndexById;
+    cellIndexById.reserve(numCells);
+    std::vector<uint64_t> ids(numCells);
+    for (size_t i = 0; i < numCells; ++i) {
+        auto const& cellDesc = description.cells[i];
+        if (cellDesc.id != 0) {
+            cellIndexById.emplace(cellDesc.id, toInt(startIndex + i));
+        }
+        if (createIds) {
+            ids[i] = data.createNewId();
+        } else {
+            ids[i] = cellDesc.id == 0 ? NumberGenerator::get().getId() : cellDesc.id;
+            data.adaptMaxId(ids[i]);
+        }
+        data.adaptMaxSmallId(static_cast<uint32_t>(cellDesc.mutationId));
+        if (auto constructor = cellDesc.cellFunction ? std::get_if<ConstructorDescription>(&*cellDesc.cellFunction) : nullptr) {
+            data.adaptMaxSmallId(static_cast<uint32_t>(constructor->offspringMutationId));
+        }
+    }
+
+    data.cells.resize(startIndex + numCells);
+    ParallelService::forEachRange(numCells, [&](uint64_t startRange, uint64_t endRange) {
+        for (auto i = startRange; i < endRange; ++i) {
+            auto const& cellDesc = description.cells[i];
+            auto& cell = data.cells[startIndex + i];
+            cell.properties = cellDesc;
+            cell.properties.connections.clear();
+            cell.properties.id = ids[i];
+            cell.properties.pos = _spaceCalculator.getCorrectedPosition(cellDesc.pos);
+            checkAndCorrectInvalidEnergy(cell.properties.energy);
+            if (cell.properties.inputExecutionOrderNumber && *cell.properties.inputExecutionOrderNumber < 0) {
+                cell.properties.inputExecutionOrderNumber.reset();
+            }
+            cell.selected = selectNewData ? 1 : 0;
+
+            int numConnections = 0;
+            float angleOffset = 0;
+            if (cellDesc.id != 0) {
+                for (auto const& connection : cellDesc.connections) {
+                    auto findResult = connection.cellId != 0 ? cellIndexById.find(connection.cellId) : cellIndexById.end();
+                    if (findResult == cellIndexById.end() || numConnections == MAX_CELL_BONDS) {
+                        angleOffset += connection.angleFromPrevious;
+                        continue;
+                    }
+                    cell.connections[numConnections++] = {findResult->second, connection.distance, connection.angleFromPrevious + angleOffset};
+                    angleOffset = 0;
+                }
+            }
+            if (angleOffset != 0 && numConnections > 0) {
+                cell.connections[0].angleFromPrevious += angleOffset;
+            }
+            cell.numConnections = numConnections;
+        }
+    });
+
+    for (auto const& particleDesc : description.particles) {
+        CpuParticle particle;
+        particle.properties = particleDesc;
+        if (createIds) {
+            particle.properties.id = data.createNewId();
+        } else {
+            if (particle.properties.id == 0) {
+                particle.properties.id = NumberGenerator::get().getId();
+            }
+            data.adaptMaxId(particle.properties.id);
+        }
+        particle.properties.pos = _spaceCalculator.getCorrectedPosition(particleDesc.pos);
+        checkAndCorrectInvalidEnergy(particle.properties.energy);
+        particle.selected = selectNewData ? 1 : 0;
+        data.particles.emplace_back(particle);
+    }
+}
+
+void CpuDescriptionConverter::checkCell(CellDescription const& cell)
+{
+    if (cell.getCellFunctionType() == CellFunction_Constructor) {
+        CHECK(std::get<ConstructorDescription>(*cell.cellFunction).genome.size() >= Const::GenomeHeaderSize)
+    }
+    if (cell.getCellFunctionType() == CellFunction_Injector) {
+        CHECK(std::get<InjectorDescription>(*cell.cellFunction).genome.size() >= Const::GenomeHeaderSize)
+    }
+}
+
+DataDescription CpuDescriptionConverter::convertToDataDescription(
+    CpuSimulationData const& data,
+    CellFilter const& cellFilter,
+    ParticleFilter const& particleFilter) const
+{
+    std::vector<int> exportedIndices;
+    std::vector<bool> exported(data.cells.size(), false);
+    for (size_t i = 0; i < data.cells.size(); ++i) {
+        auto const& cell = data.cells[i];
+        if (!cell.deleted && cellFilter(cell)) {
+            exportedIndices.emplace_back(toInt(i));
+            exported[i] = true;
+        }
+    }
+
+    DataDescription result;
+    result.cells.resize(exportedIndices.size());
+    ParallelService::forEachRange(exportedIndices.size(), [&](uint64_t startRange, uint64_t endRange) {
+        for (auto i = startRange; i < endRange; ++i) {
+            auto const& cell = data.cells[exportedIndices[i]];
+            auto& cellDesc = result.cells[i];
+            cellDesc = cell.properties;
+            cellDesc.connections.reserve(cell.numConnections);
+            for (int j = 0; j < cell.numConnections; ++j) {
+                auto const& connection = cell.connections[j];
+                auto connectedCellId = exported[connection.cellIndex] ? data.cells[connection.cellIndex].properties.id : 0;
+                cellDesc.connections.emplace_back(
+                    ConnectionDescription().setCellId(connectedCellId).setDistance(connection.distance).setAngleFromPrevious(connection.angleFromPrevious));
+            }
+        }
+    });
+
+    for (auto const& particle : data.particles) {
+        if (!particle.deleted && particleFilter(particle)) {
+            result.particles.emplace_back(particle.properties);
+        }
+    }
+    return result;
+}
+
+auto CpuDescriptionConverter::calcCellClusters(DataDescription const& data) -> CellClusters
+{
+    auto numCells = toInt(data.cells.size());
+    std::unordered_map<uint64_t, int> cellIndexById;
+    cellIndexById.reserve(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        cellIndexById.emplace(data.cells[i].id, i);
+    }
+
+    std::vector<int> parents(numCells);
+    std::iota(parents.begin(), parents.end(), 0);
+    for (int i = 0; i < numCells; ++i) {
+        for (auto const& connection : data.cells[i].connections) {
+            auto findResult = cellIndexById.find(connection.cellId);
+            if (connection.cellId == 0 || findResult == cellIndexById.end()) {
+                continue;
+            }
+            auto root1 = findRoot(parents, i);
+            auto root2 = findRoot(parents, findResult->second);
+            if (root1 != root2) {
+                parents[std::max(root1, root2)] = std::min(root1, root2);
+            }
+        }
+    }
+
+    //clusters are ordered by their first cell, cells inside a cluster by index
+    std::vector<int> clusterIndexByRoot(numCells, -1);
+    std::vector<uint64_t> clusterSizes;
+    std::vector<int> clusterIndices(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        auto root = findRoot(parents, i);
+        if (clusterIndexByRoot[root] == -1) {
+            clusterIndexByRoot[root] = toInt(clusterSizes.size());
+            clusterSizes.emplace_back(0);
+        }
+        clusterIndices[i] = clusterIndexByRoot[root];
+        ++clusterSizes[clusterIndices[i]];
+    }
+
+    CellClusters result;
+    result.clusterStartIndices.resize(clusterSizes.size() + 1, 0);
+    for (size_t i = 0; i < clusterSizes.size(); ++i) {
+        result.clusterStartIndices[i + 1] = result.clusterStartIndices[i] + clusterSizes[i];
+    }
+    result.cellIndices.resize(numCells);
+    auto insertIndices = result.clusterStartIndices;
+    for (int i = 0; i < numCells; ++i) {
+        result.cellIndices[insertIndices[clusterIndices[i]]++] = i;
+    }
+    return result;
+}
+
+std::vector<ClusterDescription> CpuDescriptionConverter::extractClusterDescriptions(
+    DataDescription& data,
+    CellClusters const& cellClusters,
+    uint64_t startClusterIndex,
+    uint64_t endClusterIndex)
+{
+    std::vector<ClusterDescription> result(endClusterIndex - startClusterIndex);
+    ParallelService::forEachRange(result.size(), [&](uint64_t startRange, uint64_t endRange) {
+        for (auto i = startRange; i < endRange; ++i) {
+            auto clusterIndex = startClusterIndex + i;
+            auto& cluster = result[i];
+            auto start = cellClusters.clusterStartIndices[clusterIndex];
+            auto end = cellClusters.clusterStartIndices[clusterIndex + 1];
+            cluster.cells.reserve(end - start);
+            for (auto j = start; j < end; ++j) {
+                cluster.cells.emplace_back(std::move(data.cells[cellClusters.cellIndices[j]]));
+            }
+        }
+    });
+    return result;
+}
+
+ClusteredDataDescription CpuDescriptionConverter::convertToClusteredDataDescription(DataDescription&& data)
+{
+    auto cellClusters = calcCellClusters(data);
+
+    ClusteredDataDescription result;
+    result.clusters = extractClusterDescriptions(data, cellClusters, 0, cellClusters.getNumClusters());
+    result.particles = std::move(data.particles);
+    return result;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <functional>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SpaceCalculator.h"
+
+#include "CpuObjects.h"
+#include "Definitions.h"
+
+class CpuDescriptionConverter
+{
+public:
+    CpuDescriptionConverter(IntVector2D const& worldSize);
+
+    //cells without id receive a new one and lose their connections, connections to unknown cells are dropped
+    //createIds = true: all objects receive new ids (used for pasting data)
+    void addDescription(CpuSimulationData& data, DataDescription const& description, bool createIds, bool selectNewData) const;
+
+    //throws for cells which the GPU description converter rejects as well
+    static void checkCell(CellDescription const& cell);
+
+    using CellFilter = std::function<bool(CpuCell const&)>;
+    using ParticleFilter = std::function<bool(CpuParticle const&)>;
+
+    //connections to cells not passing the filter are exported with cell id 0
+    DataDescription convertToDataDescription(CpuSimulationData const& data, CellFilter const& cellFilter, ParticleFilter const& particleFilter) const;
+
+    //cellIndices contains the cell indices ordered by cluster, cluster i consists of the range [clusterStartIndices[i], clusterStartIndices[i + 1])
+    struct CellClusters
+    {
+        std::vector<int> cellIndices;
+        std::vector<uint64_t> clusterStartIndices;
+
+        uint64_t getNumClusters() const { return clusterStartIndices.size() - 1; }
+    };
+    static CellClusters calcCellClusters(DataDescription const& data);
+
+    //moves the cells of the clusters in [startClusterIndex, endClusterIndex) out of data
+    static std::vector<ClusterDescription>
+    extractClusterDescriptions(DataDescription& data, CellClusters const& cellClusters, uint64_t startClusterIndex, uint64_t endClusterIndex);
+
+    static ClusteredDataDescription convertToClusteredDataDescription(DataDescription&& data);
+
+private:
+    SpaceCalculator _spaceCalculator;
+};
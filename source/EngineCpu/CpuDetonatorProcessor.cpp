@@ -0,0 +1,72 @@
+#include "CpuDetonatorProcessor.h"
+
+#include <cmath>
+
+#include "Base/Math.h"
+
+void CpuDetonatorProcessor::process(CpuCellFunctionData& data, AccumulatedStatistics& statistics)
+{
+    std::vector<int> chainExplosionCells;
+    for (auto const& cellIndex : data.cellFunctionOperations[CellFunction_Detonator]) {
+        processCell(data, statistics, cellIndex, chainExplosionCells);
+    }
+    for (auto const& cellIndex : chainExplosionCells) {
+        auto& detonator = CpuCellFunctionProcessor::getCellFunction<DetonatorDescription>(data.data.cells[cellIndex]);
+        if (detonator.state != DetonatorState_Exploded) {
+            detonator.state = DetonatorState_Activated;
+            detonator.countdown = 1;
+        }
+    }
+}
+
+void CpuDetonatorProcessor::processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, std::vector<int>& chainExplosionCells)
+{
+    auto& cells = data.data.cells;
+    auto const& parameters = data.parameters;
+    auto activity = CpuCellFunctionProcessor::calcInputActivity(cells, cells[cellIndex], parameters);
+    CpuCellFunctionProcessor::updateInvocationState(cells[cellIndex], activity);
+
+    auto& cell = cells[cellIndex];
+    auto const& properties = cell.properties;
+    auto& detonator = CpuCellFunctionProcessor::getCellFunction<DetonatorDescription>(cell);
+    if (activity.channels[0] >= std::abs(parameters.cellFunctionDetonatorActivityThreshold) && detonator.state == DetonatorState_Ready) {
+        detonator.state = DetonatorState_Activated;
+    }
+    if (detonator.state == DetonatorState_Activated) {
+        if (detonator.countdown >= 0) {
+            --detonator.countdown;
+        }
+        if (detonator.countdown == -1) {
+            detonator.countdown = 0;
+            ++statistics.numDetonations[properties.color];
+            CpuRandom random(data.seed, data.timestep, CpuRandomStage_Detonator, cellIndex);
+            auto radius = parameters.cellFunctionDetonatorRadius[properties.color];
+            CpuCellFunctionProcessor::forEachCell(data, properties.pos, radius, cell.detached, [&](int otherIndex) {
+                if (otherIndex == cellIndex) {
+                    return;
+                }
+                auto& otherProperties = cells[otherIndex].properties;
+                if (otherProperties.barrier) {
+                    return;
+                }
+                auto delta = data.spaceCalculator.getCorrectedDirection(otherProperties.pos - properties.pos);
+                auto lengthSquared = Math::lengthSquared(delta);
+                if (lengthSquared > NEAR_ZERO) {
+                    auto force = delta / lengthSquared * radius * 2;
+                    otherProperties.vel += force;
+                }
+                if (!otherProperties.cellFunction) {
+                    return;
+                }
+                auto otherDetonator = std::get_if<DetonatorDescription>(&*otherProperties.cellFunction);
+                if (otherDetonator && otherDetonator->state != DetonatorState_Exploded) {
+                    if (random.random() < parameters.cellFunctionDetonatorChainExplosionProbability[properties.color]) {
+                        chainExplosionCells.emplace_back(otherIndex);
+                    }
+                }
+            });
+            detonator.state = DetonatorState_Exploded;
+        }
+    }
+    CpuCellFunctionProcessor::setActivity(cell, activity);
+}
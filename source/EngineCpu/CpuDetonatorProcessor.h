@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CpuCellFunctionProcessor.h"
+
+//counterpart of DetonatorProcessor on the GPU
+class CpuDetonatorProcessor
+{
+public:
+    static void process(CpuCellFunctionData& data, AccumulatedStatistics& statistics);
+
+private:
+    //chain reactions are returned in chainExplosionCells and applied after all detonators have been processed,
+    //so that the result does not depend on the processing order
+    static void processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, std::vector<int>& chainExplosionCells);
+};
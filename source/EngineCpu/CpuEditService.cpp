@@ -0,0 +1,515 @@
+#include "CpuEditService.h"
+
+#include <vector>
+
+#include "Base/Math.h"
+
+#include "CpuConnectionService.h"
+#include "CpuDescriptionConverter.h"
+#include "CpuSpatialGrid.h"
+
+namespace
+{
+    auto constexpr ReconnectionRadius = 1.3f;
+    auto constexpr MaxRolloutSteps = 30;
+
+    bool isSelected(CpuCell const& cell, bool includeClusters)
+    {
+        return (includeClusters && cell.selected != 0) || (!includeClusters && cell.selected == 1);
+    }
+
+    //corresponds to BaseMap::getCorrectionIncrement
+    RealVector2D getCorrectionIncrement(IntVector2D const& worldSize, RealVector2D const& pos1, RealVector2D const& pos2)
+    {
+        auto worldSizeFloat = RealVector2D{toFloat(worldSize.x), toFloat(worldSize.y)};
+        auto delta = pos1 - pos2 + worldSizeFloat / 2;
+        return {delta.x - Math::modulo(delta.x, worldSizeFloat.x), delta.y - Math::modulo(delta.y, worldSizeFloat.y)};
+    }
+
+    template <typename Func>
+    void forEachSelectedObject(CpuSimulationData& data, bool includeClusters, Func const& func)
+    {
+        for (auto& cell : data.cells) {
+            if (isSelected(cell, includeClusters)) {
+                func(cell.properties.pos, cell.properties.vel);
+            }
+        }
+        for (auto& particle : data.particles) {
+            if (particle.selected != 0) {
+                func(particle.properties.pos, particle.properties.vel);
+            }
+        }
+    }
+}
+
+void CpuEditService::removeSelectedObjects(CpuSimulationData& data, bool includeClusters)
+{
+    //connections to removed cells are deleted during compaction
+    for (auto& cell : data.cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.deleted = true;
+        }
+    }
+    for (auto& particle : data.particles) {
+        if (particle.selected == 1) {
+            particle.deleted = true;
+        }
+    }
+    data.compact();
+}
+
+void CpuEditService::relaxSelectedObjects(CpuSimulationData& data, IntVector2D const& worldSize, bool includeClusters)
+{
+    SpaceCalculator spaceCalculator(worldSize);
+    auto& cells = data.cells;
+    for (auto& cell : cells) {
+        if (!isSelected(cell, includeClusters)) {
+            continue;
+        }
+        auto const numConnections = cell.numConnections;
+        auto getDisplacement = [&](int connectionIndex) {
+            return spaceCalculator.getCorrectedDirection(cells[cell.connections[connectionIndex].cellIndex].properties.pos - cell.properties.pos);
+        };
+        for (int i = 0; i < numConnections; ++i) {
+            if (isSelected(cells[cell.connections[i].cellIndex], includeClusters)) {
+                cell.connections[i].distance = Math::length(getDisplacement(i));
+            }
+        }
+
+        if (numConnections > 1) {
+            for (int i = 0; i < numConnections; ++i) {
+                auto prevIndex = (i + numConnections - 1) % numConnections;
+                auto nextIndex = (i + 1) % numConnections;
+                if (isSelected(cells[cell.connections[i].cellIndex], includeClusters)
+                    && isSelected(cells[cell.connections[prevIndex].cellIndex], includeClusters)) {
+                    auto prevAngle = Math::angleOfVector(getDisplacement(prevIndex));
+                    auto angle = Math::angleOfVector(getDisplacement(i));
+
+                    auto actualAngleFromPrevious = Math::subtractAngle(angle, prevAngle);
+                    auto angleDiff = actualAngleFromPrevious - cell.connections[i].angleFromPrevious;
+
+                    auto nextAngleFromPrevious = cell.connections[nextIndex].angleFromPrevious;
+                    if (nextAngleFromPrevious - angleDiff >= 0) {
+                        cell.connections[i].angleFromPrevious = actualAngleFromPrevious;
+                        cell.connections[nextIndex].angleFromPrevious = nextAngleFromPrevious - angleDiff;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CpuEditService::uniformVelocities(CpuSimulationData& data, bool includeClusters)
+{
+    RealVector2D velocity;
+    int numObjects = 0;
+    forEachSelectedObject(data, includeClusters, [&](RealVector2D&, RealVector2D& vel) {
+        velocity += vel;
+        ++numObjects;
+    });
+    if (numObjects != 0) {
+        velocity = velocity / toFloat(numObjects);
+    }
+    forEachSelectedObject(data, includeClusters, [&](RealVector2D&, RealVector2D& vel) { vel = velocity; });
+}
+
+void CpuEditService::makeSticky(CpuSimulationData& data, bool includeClusters)
+{
+    for (auto& cell : data.cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.properties.maxConnections = MAX_CELL_BONDS;
+        }
+    }
+}
+
+void CpuEditService::removeStickiness(CpuSimulationData& data, bool includeClusters)
+{
+    for (auto& cell : data.cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.properties.maxConnections = cell.numConnections;
+        }
+    }
+}
+
+void CpuEditService::setBarrier(CpuSimulationData& data, bool value, bool includeClusters)
+{
+    for (auto& cell : data.cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.properties.barrier = value;
+        }
+    }
+}
+
+void CpuEditService::colorSelectedObjects(CpuSimulationData& data, unsigned char color, bool includeClusters)
+{
+    for (auto& cell : data.cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.properties.color = color;
+        }
+    }
+    for (auto& particle : data.particles) {
+        if (particle.selected != 0) {
+            particle.properties.color = color;
+        }
+    }
+}
+
+void CpuEditService::setDetached(CpuSimulationData& data, bool value)
+{
+    for (auto& cell : data.cells) {
+        if (cell.selected != 0) {
+            cell.detached = value ? 1 : 0;
+        }
+    }
+}
+
+void CpuEditService::reconnectSelectedObjects(CpuSimulationData& data, IntVector2D const& worldSize, SimulationParameters const& parameters)
+{
+    disconnectSelectionFromRemainings(data, SpaceCalculator(worldSize), parameters);
+    connectSelection(data, worldSize);
+    updateSelection(data);
+}
+
+void CpuEditService::shallowUpdateSelectedObjects(
+    CpuSimulationData& data,
+    IntVector2D const& worldSize,
+    SimulationParameters const& parameters,
+    ShallowUpdateSelectionData const& updateData)
+{
+    SpaceCalculator spaceCalculator(worldSize);
+    auto reconnectionRequired = !updateData.considerClusters && (updateData.posDeltaX != 0 || updateData.posDeltaY != 0 || updateData.angleDelta != 0);
+
+    if (reconnectionRequired) {
+        disconnectSelectionFromRemainings(data, spaceCalculator, parameters);
+    }
+
+    if (updateData.posDeltaX != 0 || updateData.posDeltaY != 0 || updateData.velDeltaX != 0 || updateData.velDeltaY != 0) {
+        RealVector2D posDelta{updateData.posDeltaX, updateData.posDeltaY};
+        RealVector2D velDelta{updateData.velDeltaX, updateData.velDeltaY};
+        forEachSelectedObject(data, updateData.considerClusters, [&](RealVector2D& pos, RealVector2D& vel) {
+            pos = spaceCalculator.getCorrectedPosition(pos + posDelta);
+            vel += velDelta;
+        });
+    }
+
+    if (updateData.angleDelta != 0 || updateData.angularVelDelta != 0) {
+        RealVector2D center;
+        int numObjects = 0;
+        forEachSelectedObject(data, updateData.considerClusters, [&](RealVector2D& pos, RealVector2D&) {
+            center += pos;
+            ++numObjects;
+        });
+        if (numObjects != 0) {
+            center = center / toFloat(numObjects);
+        }
+
+        auto rotationMatrix = Math::calcRotationMatrix(updateData.angleDelta);
+        for (auto& cell : data.cells) {
+            if (!isSelected(cell, updateData.considerClusters)) {
+                continue;
+            }
+            auto relPos = spaceCalculator.getCorrectedDirection(cell.properties.pos - center);
+            if (updateData.angleDelta != 0) {
+                cell.properties.pos = spaceCalculator.getCorrectedPosition(rotationMatrix * relPos + center);
+            }
+            if (updateData.angularVelDelta != 0) {
+                cell.properties.vel += Math::rotateQuarterClockwise(relPos) * updateData.angularVelDelta * Const::DegToRad;
+            }
+        }
+        for (auto& particle : data.particles) {
+            if (particle.selected != 0) {
+                auto relPos = spaceCalculator.getCorrectedDirection(particle.properties.pos - center);
+                particle.properties.pos = spaceCalculator.getCorrectedPosition(rotationMatrix * relPos + center);
+            }
+        }
+    }
+
+    if (reconnectionRequired) {
+        connectSelection(data, worldSize);
+        updateSelection(data);
+    }
+}
+
+void CpuEditService::changeCell(CpuSimulationData& data, IntVector2D const& worldSize, CellDescription const& changedCell)
+{
+    CpuDescriptionConverter::checkCell(changedCell);
+
+    SpaceCalculator spaceCalculator(worldSize);
+    for (auto& cell : data.cells) {
+        if (cell.properties.id == changedCell.id) {
+            cell.properties = changedCell;
+            cell.properties.connections.clear();
+            cell.properties.pos = spaceCalculator.getCorrectedPosition(changedCell.pos);
+            cell.genomeInfo.reset();
+        }
+    }
+}
+
+void CpuEditService::changeParticle(CpuSimulationData& data, IntVector2D const& worldSize, ParticleDescription const& changedParticle)
+{
+    SpaceCalculator spaceCalculator(worldSize);
+    for (auto& particle : data.particles) {
+        if (particle.properties.id == changedParticle.id) {
+            particle.properties = changedParticle;
+            particle.properties.pos = spaceCalculator.getCorrectedPosition(changedParticle.pos);
+        }
+    }
+}
+
+void CpuEditService::applyForce(
+    CpuSimulationData& data,
+    IntVector2D const& worldSize,
+    RealVector2D const& start,
+    RealVector2D const& end,
+    RealVector2D const& force,
+    float radius)
+{
+    for (auto& cell : data.cells) {
+        auto pos = cell.properties.pos + getCorrectionIncrement(worldSize, start, cell.properties.pos);
+        if (Math::calcDistanceToLineSegment(start, end, pos, radius) < radius && !cell.properties.barrier) {
+            cell.properties.vel += force;
+        }
+    }
+    for (auto& particle : data.particles) {
+        if (Math::calcDistanceToLineSegment(start, end, particle.properties.pos, radius) < radius) {
+            particle.properties.vel += force;
+        }
+    }
+}
+
+void CpuEditService::switchSelection(CpuSimulationData& data, IntVector2D const& worldSize, RealVector2D const& pos, float radius)
+{
+    SpaceCalculator spaceCalculator(worldSize);
+    for (auto const& cell : data.cells) {
+        if (cell.selected == 1 && spaceCalculator.distance(pos, cell.properties.pos) < radius) {
+            return;
+        }
+    }
+    for (auto const& particle : data.particles) {
+        if (particle.selected == 1 && spaceCalculator.distance(pos, particle.properties.pos) < radius) {
+            return;
+        }
+    }
+    setSelection(data, spaceCalculator, pos, radius);
+    rolloutSelection(data);
+}
+
+void CpuEditService::swapSelection(CpuSimulationData& data, IntVector2D const& worldSize, RealVector2D const& pos, float radius)
+{
+    SpaceCalculator spaceCalculator(worldSize);
+    removeSelection(data, true);
+    for (auto& cell : data.cells) {
+        if (spaceCalculator.distance(pos, cell.properties.pos) < radius) {
+            if (cell.selected == 0) {
+                cell.selected = 1;
+            } else if (cell.selected == 1) {
+                cell.selected = 0;
+            }
+        }
+    }
+    for (auto& particle : data.particles) {
+        if (spaceCalculator.distance(pos, particle.properties.pos) < radius) {
+            particle.selected = 1 - particle.selected;
+        }
+    }
+    rolloutSelection(data);
+}
+
+void CpuEditService::setSelection(CpuSimulationData& data, IntVector2D const& worldSize, RealVector2D const& startPos, RealVector2D const& endPos)
+{
+    auto isInArea = [&](RealVector2D const& pos) {
+        return Math::isInBetweenModulo(startPos.x, endPos.x, pos.x, toFloat(worldSize.x))
+            && Math::isInBetweenModulo(startPos.y, endPos.y, pos.y, toFloat(worldSize.y));
+    };
+    for (auto& cell : data.cells) {
+        cell.selected = isInArea(cell.properties.pos) ? 1 : 0;
+    }
+    for (auto& particle : data.particles) {
+        particle.selected = isInArea(particle.properties.pos) ? 1 : 0;
+    }
+    rolloutSelection(data);
+}
+
+void CpuEditService::removeSelection(CpuSimulationData& data, bool onlyClusterSelection)
+{
+    for (auto& cell : data.cells) {
+        if (!onlyClusterSelection || cell.selected == 2) {
+            cell.selected = 0;
+        }
+    }
+    for (auto& particle : data.particles) {
+        if (!onlyClusterSelection || particle.selected == 2) {
+            particle.selected = 0;
+        }
+    }
+}
+
+void CpuEditService::updateSelection(CpuSimulationData& data)
+{
+    removeSelection(data, true);
+    rolloutSelection(data);
+}
+
+void CpuEditService::rolloutSelection(CpuSimulationData& data)
+{
+    auto& cells = data.cells;
+    bool changes;
+    do {
+        changes = false;
+        for (auto const& cell : cells) {
+            if (cell.selected == 0) {
+                continue;
+            }
+
+            //heuristics to cover connected cells
+            auto currentCell = &cell;
+            for (int i = 0; i < MaxRolloutSteps; ++i) {
+                CpuCell* nextCell = nullptr;
+                for (int j = 0; j < currentCell->numConnections; ++j) {
+                    auto& candidateCell = cells[currentCell->connections[j].cellIndex];
+                    if (candidateCell.selected == 0) {
+                        nextCell = &candidateCell;
+                        break;
+                    }
+                }
+                if (!nextCell) {
+                    break;
+                }
+                nextCell->selected = 2;
+                currentCell = nextCell;
+                changes = true;
+            }
+        }
+    } while (changes);
+}
+
+SelectionShallowData
+CpuEditService::getSelectionShallowData(CpuSimulationData const& data, IntVector2D const& worldSize, RealVector2D const& refPos, bool mapCorrection)
+{
+    SelectionShallowData result;
+    for (auto const& cell : data.cells) {
+        if (cell.selected == 0) {
+            continue;
+        }
+        auto pos = cell.properties.pos + getCorrectionIncrement(worldSize, refPos, cell.properties.pos);
+        auto const& vel = cell.properties.vel;
+        if (cell.selected == 1) {
+            ++result.numCells;
+            result.centerPosX += pos.x;
+            result.centerPosY += pos.y;
+            result.centerVelX += vel.x;
+            result.centerVelY += vel.y;
+        }
+        ++result.numClusterCells;
+        result.clusterCenterPosX += pos.x;
+        result.clusterCenterPosY += pos.y;
+        result.clusterCenterVelX += vel.x;
+        result.clusterCenterVelY += vel.y;
+    }
+    for (auto const& particle : data.particles) {
+        if (particle.selected == 0) {
+            continue;
+        }
+        auto pos = particle.properties.pos + getCorrectionIncrement(worldSize, refPos, particle.properties.pos);
+        auto const& vel = particle.properties.vel;
+        ++result.numParticles;
+        result.centerPosX += pos.x;
+        result.centerPosY += pos.y;
+        result.centerVelX += vel.x;
+        result.centerVelY += vel.y;
+        result.clusterCenterPosX += pos.x;
+        result.clusterCenterPosY += pos.y;
+        result.clusterCenterVelX += vel.x;
+        result.clusterCenterVelY += vel.y;
+    }
+
+    SpaceCalculator spaceCalculator(worldSize);
+    auto numObjects = result.numCells + result.numParticles;
+    if (numObjects > 0) {
+        result.centerPosX /= toFloat(numObjects);
+        result.centerPosY /= toFloat(numObjects);
+        result.centerVelX /= toFloat(numObjects);
+        result.centerVelY /= toFloat(numObjects);
+        if (mapCorrection) {
+            auto correctedPos = spaceCalculator.getCorrectedPosition({result.centerPosX, result.centerPosY});
+            result.centerPosX = correctedPos.x;
+            result.centerPosY = correctedPos.y;
+        }
+    }
+    auto numClusterObjects = result.numClusterCells + result.numParticles;
+    if (numClusterObjects > 0) {
+        result.clusterCenterPosX /= toFloat(numClusterObjects);
+        result.clusterCenterPosY /= toFloat(numClusterObjects);
+        result.clusterCenterVelX /= toFloat(numClusterObjects);
+        result.clusterCenterVelY /= toFloat(numClusterObjects);
+        if (mapCorrection) {
+            auto correctedPos = spaceCalculator.getCorrectedPosition({result.clusterCenterPosX, result.clusterCenterPosY});
+            result.clusterCenterPosX = correctedPos.x;
+            result.clusterCenterPosY = correctedPos.y;
+        }
+    }
+    return result;
+}
+
+void CpuEditService::setSelection(CpuSimulationData& data, SpaceCalculator const& spaceCalculator, RealVector2D const& pos, float radius)
+{
+    for (auto& cell : data.cells) {
+        cell.selected = spaceCalculator.distance(pos, cell.properties.pos) < radius ? 1 : 0;
+    }
+    for (auto& particle : data.particles) {
+        particle.selected = spaceCalculator.distance(pos, particle.properties.pos) < radius ? 1 : 0;
+    }
+}
+
+void CpuEditService::disconnectSelectionFromRemainings(CpuSimulationData& data, SpaceCalculator const& spaceCalculator, SimulationParameters const& parameters)
+{
+    auto& cells = data.cells;
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        auto& cell = cells[index];
+        if (cell.selected != 1) {
+            continue;
+        }
+        auto maxBindingDistance = parameters.cellMaxBindingDistance[cell.properties.color];
+        for (int i = 0; i < cell.numConnections;) {
+            auto connectedCellIndex = cell.connections[i].cellIndex;
+            auto const& connectedCell = cells[connectedCellIndex];
+            if (connectedCell.selected != 1 && spaceCalculator.distance(cell.properties.pos, connectedCell.properties.pos) > maxBindingDistance) {
+                CpuConnectionService::deleteConnections(cells, index, connectedCellIndex);
+            } else {
+                ++i;
+            }
+        }
+    }
+}
+
+void CpuEditService::connectSelection(CpuSimulationData& data, IntVector2D const& worldSize)
+{
+    SpaceCalculator spaceCalculator(worldSize);
+    auto& cells = data.cells;
+
+    std::vector<RealVector2D> positions;
+    positions.reserve(cells.size());
+    for (auto const& cell : cells) {
+        positions.emplace_back(cell.properties.pos);
+    }
+    CpuSpatialGrid grid;
+    grid.build(worldSize, ReconnectionRadius, positions);
+
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        if (cells[index].selected != 1) {
+            continue;
+        }
+        auto pos = cells[index].properties.pos;
+        grid.forEachCandidate(pos, ReconnectionRadius, [&](int otherIndex) {
+            auto& cell = cells[index];
+            auto& otherCell = cells[otherIndex];
+            if (otherIndex == index || otherCell.selected == 1 || cell.detached != otherCell.detached
+                || spaceCalculator.distance(pos, otherCell.properties.pos) > ReconnectionRadius || cell.isConnectedTo(otherIndex)) {
+                return;
+            }
+            if (cell.numConnections < cell.properties.maxConnections && otherCell.numConnections < otherCell.properties.maxConnections) {
+                CpuConnectionService::tryAddConnections(cells, spaceCalculator, index, otherIndex);
+            }
+        });
+    }
+}
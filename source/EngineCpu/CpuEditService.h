@@ -0,0 +1,56 @@
+#pragma once
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/SpaceCalculator.h"
+
+#include "CpuObjects.h"
+#include "Definitions.h"
+
+//CPU counterpart of EditKernelsLauncher
+//selected: 0 = no, 1 = selected, 2 = cluster selected (connected to a selected cell)
+class CpuEditService
+{
+public:
+    static void removeSelectedObjects(CpuSimulationData& data, bool includeClusters);
+    static void relaxSelectedObjects(CpuSimulationData& data, IntVector2D const& worldSize, bool includeClusters);
+    static void uniformVelocities(CpuSimulationData& data, bool includeClusters);
+    static void makeSticky(CpuSimulationData& data, bool includeClusters);
+    static void removeStickiness(CpuSimulationData& data, bool includeClusters);
+    static void setBarrier(CpuSimulationData& data, bool value, bool includeClusters);
+    static void colorSelectedObjects(CpuSimulationData& data, unsigned char color, bool includeClusters);
+    static void setDetached(CpuSimulationData& data, bool value);
+    static void reconnectSelectedObjects(CpuSimulationData& data, IntVector2D const& worldSize, SimulationParameters const& parameters);
+    static void shallowUpdateSelectedObjects(
+        CpuSimulationData& data,
+        IntVector2D const& worldSize,
+        SimulationParameters const& parameters,
+        ShallowUpdateSelectionData const& updateData);
+    static void changeCell(CpuSimulationData& data, IntVector2D const& worldSize, CellDescription const& changedCell);
+    static void changeParticle(CpuSimulationData& data, IntVector2D const& worldSize, ParticleDescription const& changedParticle);
+
+    static void applyForce(
+        CpuSimulationData& data,
+        IntVector2D const& worldSize,
+        RealVector2D const& start,
+        RealVector2D const& end,
+        RealVector2D const& force,
+        float radius);
+
+    static void switchSelection(CpuSimulationData& data, IntVector2D const& worldSize, RealVector2D const& pos, float radius);
+    static void swapSelection(CpuSimulationData& data, IntVector2D const& worldSize, RealVector2D const& pos, float radius);
+    static void setSelection(CpuSimulationData& data, IntVector2D const& worldSize, RealVector2D const& startPos, RealVector2D const& endPos);
+    static void removeSelection(CpuSimulationData& data, bool onlyClusterSelection = false);
+    static void updateSelection(CpuSimulationData& data);
+    static void rolloutSelection(CpuSimulationData& data);
+
+    static SelectionShallowData
+    getSelectionShallowData(CpuSimulationData const& data, IntVector2D const& worldSize, RealVector2D const& refPos, bool mapCorrection);
+
+private:
+    static void setSelection(CpuSimulationData& data, SpaceCalculator const& spaceCalculator, RealVector2D const& pos, float radius);
+    static void disconnectSelectionFromRemainings(CpuSimulationData& data, SpaceCalculator const& spaceCalculator, SimulationParameters const& parameters);
+    static void connectSelection(CpuSimulationData& data, IntVector2D const& worldSize);
+};
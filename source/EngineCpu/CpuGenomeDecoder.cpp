@@ -0,0 +1,570 @@
+#include "CpuGenomeDecoder.h"
+
+#include <algorithm>
+#include <climits>
+
+bool CpuGenomeDecoder::GenomeHeader::hasInfiniteRepetitions() const
+{
+    return numRepetitions == INT_MAX;
+}
+
+auto CpuGenomeDecoder::readGenomeHeader(ConstructorDescription const& constructor) -> GenomeHeader
+{
+    auto genome = constructor.genome.data();
+    auto genomeSize = toInt(constructor.genome.size());
+
+    GenomeHeader result;
+    result.shape = getByte(genome, genomeSize, Const::GenomeHeaderShapePos) % ConstructionShape_Count;
+    result.numBranches = getNumBranches(genome, genomeSize);
+    result.separateConstruction = isSeparating(genome, genomeSize);
+    result.angleAlignment = getByte(genome, genomeSize, Const::GenomeHeaderAlignmentPos) % ConstructorAngleAlignment_Count;
+    result.stiffness = toFloat(getByte(genome, genomeSize, Const::GenomeHeaderStiffnessPos)) / 255;
+    result.connectionDistance = toFloat(getByte(genome, genomeSize, Const::GenomeHeaderConstructionDistancePos)) / 255 + 0.5f;
+    result.numRepetitions = getNumRepetitions(genome, genomeSize);
+    result.concatenationAngle1 = convertByteToAngle(getByte(genome, genomeSize, Const::GenomeHeaderConcatenationAngle1Pos));
+    result.concatenationAngle2 = convertByteToAngle(getByte(genome, genomeSize, Const::GenomeHeaderConcatenationAngle2Pos));
+    return result;
+}
+
+int CpuGenomeDecoder::getGenomeDepth(uint8_t const* genome, int genomeSize)
+{
+    auto result = 0;
+    executeForEachNodeRecursively(genome, genomeSize, true, false, [&result](int depth, int nodeAddress, int repetitions) { result = std::max(result, depth); });
+    return result;
+}
+
+int CpuGenomeDecoder::getNumNodesRecursively(uint8_t const* genome, int genomeSize, bool includeRepetitions, bool includedSeparatedParts)
+{
+    auto result = 0;
+    if (!includeRepetitions) {
+        executeForEachNodeRecursively(genome, genomeSize, includedSeparatedParts, true, [&result](int depth, int nodeAddress, int repetitions) { ++result; });
+    } else {
+        executeForEachNodeRecursively(
+            genome, genomeSize, includedSeparatedParts, true, [&result](int depth, int nodeAddress, int repetitions) { result += repetitions; });
+    }
+    return result;
+}
+
+int CpuGenomeDecoder::getRandomGenomeNodeAddress(
+    CpuRandom& random,
+    uint8_t const* genome,
+    int genomeSize,
+    bool considerZeroSubGenomes,
+    std::vector<int>* subGenomesSizeIndices,
+    int randomRefIndex)
+{
+    if (subGenomesSizeIndices) {
+        subGenomesSizeIndices->clear();
+    }
+    if (genomeSize <= Const::GenomeHeaderSize) {
+        return Const::GenomeHeaderSize;
+    }
+    if (randomRefIndex == 0) {
+        randomRefIndex = random.random(genomeSize - 1);
+    }
+
+    int result = 0;
+    for (int depth = 0; depth < MAX_SUBGENOME_RECURSION_DEPTH; ++depth) {
+        auto nodeAddress = findStartNodeAddress(genome, genomeSize, randomRefIndex);
+        result += nodeAddress;
+        auto cellFunction = getNextCellFunctionType(genome, genomeSize, nodeAddress);
+
+        if (cellFunction != CellFunction_Constructor && cellFunction != CellFunction_Injector) {
+            break;
+        }
+        auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
+        auto makeSelfCopy = convertByteToBool(getByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes));
+        if (makeSelfCopy || nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes > randomRefIndex) {
+            break;
+        }
+        if (subGenomesSizeIndices) {
+            subGenomesSizeIndices->emplace_back(result + Const::CellBasicBytes + cellFunctionFixedBytes + 1);
+        }
+        auto subGenomeStartIndex = nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes + 3;
+        auto subGenomeSize = getNextSubGenomeSize(genome, genomeSize, nodeAddress);
+        if (subGenomeSize <= Const::GenomeHeaderSize) {
+            if (considerZeroSubGenomes && subGenomeSize == Const::GenomeHeaderSize && random.randomBool()) {
+                result += Const::CellBasicBytes + cellFunctionFixedBytes + 3 + Const::GenomeHeaderSize;
+            } else if (subGenomesSizeIndices) {
+                subGenomesSizeIndices->pop_back();
+            }
+            break;
+        }
+        genomeSize = subGenomeSize;
+        genome = genome + subGenomeStartIndex;
+        randomRefIndex -= subGenomeStartIndex;
+        result += Const::CellBasicBytes + cellFunctionFixedBytes + 3;
+    }
+    return result;
+}
+
+int CpuGenomeDecoder::getNumNodes(uint8_t const* genome, int genomeSize)
+{
+    int result = 0;
+    int currentNodeAddress = Const::GenomeHeaderSize;
+    for (; result < genomeSize && currentNodeAddress < genomeSize; ++result) {
+        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
+    }
+    return result;
+}
+
+int CpuGenomeDecoder::getNodeAddress(uint8_t const* genome, int genomeSize, int nodeIndex)
+{
+    int currentNodeAddress = Const::GenomeHeaderSize;
+    for (int currentNodeIndex = 0; currentNodeIndex < nodeIndex; ++currentNodeIndex) {
+        if (currentNodeAddress >= genomeSize) {
+            break;
+        }
+        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
+    }
+    return currentNodeAddress;
+}
+
+bool CpuGenomeDecoder::isFirstNode(ConstructorDescription const& constructor)
+{
+    return constructor.genomeCurrentNodeIndex == 0;
+}
+
+bool CpuGenomeDecoder::isFirstRepetition(ConstructorDescription const& constructor)
+{
+    return constructor.genomeCurrentRepetition == 0;
+}
+
+bool CpuGenomeDecoder::isLastNode(ConstructorDescription const& constructor)
+{
+    if (hasEmptyGenome(constructor)) {
+        return true;
+    }
+    auto genome = constructor.genome.data();
+    auto genomeSize = toInt(constructor.genome.size());
+    auto nodeAddress = getNodeAddress(genome, genomeSize, constructor.genomeCurrentNodeIndex);
+    auto nextNodeBytes = Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
+    return nodeAddress + nextNodeBytes >= genomeSize;
+}
+
+bool CpuGenomeDecoder::isLastRepetition(ConstructorDescription const& constructor)
+{
+    return getNumRepetitions(constructor.genome.data(), toInt(constructor.genome.size())) - 1 == constructor.genomeCurrentRepetition;
+}
+
+bool CpuGenomeDecoder::hasInfiniteRepetitions(ConstructorDescription const& constructor)
+{
+    return getNumRepetitions(constructor.genome.data(), toInt(constructor.genome.size())) == INT_MAX;
+}
+
+bool CpuGenomeDecoder::hasEmptyGenome(ConstructorDescription const& constructor)
+{
+    return toInt(constructor.genome.size()) <= Const::GenomeHeaderSize;
+}
+
+bool CpuGenomeDecoder::isFinished(ConstructorDescription const& constructor)
+{
+    if (hasEmptyGenome(constructor)) {
+        return true;
+    }
+    return getNumBranches(constructor.genome.data(), toInt(constructor.genome.size())) <= constructor.currentBranch;
+}
+
+bool CpuGenomeDecoder::containsSelfReplication(std::vector<uint8_t> const& genome)
+{
+    auto genomeSize = toInt(genome.size());
+    for (int currentNodeAddress = Const::GenomeHeaderSize; currentNodeAddress < genomeSize;) {
+        if (isNextCellSelfReplication(genome.data(), genomeSize, currentNodeAddress)) {
+            return true;
+        }
+        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome.data(), genomeSize, currentNodeAddress);
+    }
+    return false;
+}
+
+std::vector<uint8_t> CpuGenomeDecoder::copyGenome(std::vector<uint8_t> const& sourceGenome, int genomeBytePosition)
+{
+    auto genome = sourceGenome.data();
+    auto genomeSize = toInt(sourceGenome.size());
+    bool makeGenomeCopy = convertByteToBool(getByte(genome, genomeSize, genomeBytePosition));
+    if (makeGenomeCopy) {
+        return sourceGenome;
+    }
+    auto size = readWord(genome, genomeSize, genomeBytePosition + 1);
+    std::vector<uint8_t> result(size);
+    for (int i = 0; i < size; ++i) {
+        result[i] = getByte(genome, genomeSize, genomeBytePosition + 3 + i);
+    }
+    return result;
+}
+
+bool CpuGenomeDecoder::isSeparating(uint8_t const* genome, int genomeSize)
+{
+    return convertByteToBool(getByte(genome, genomeSize, Const::GenomeHeaderSeparationPos));
+}
+
+int CpuGenomeDecoder::getNumRepetitions(uint8_t const* genome, int genomeSize, bool countInfinityAsOne)
+{
+    int result = std::max(1, toInt(getByte(genome, genomeSize, Const::GenomeHeaderNumRepetitionsPos)));
+    if (!countInfinityAsOne) {
+        return result == 255 ? INT_MAX : result;
+    } else {
+        return result == 255 ? 1 : result;
+    }
+}
+
+int CpuGenomeDecoder::getNumBranches(uint8_t const* genome, int genomeSize)
+{
+    return isSeparating(genome, genomeSize) ? 1 : (getByte(genome, genomeSize, Const::GenomeHeaderNumBranchesPos) + 5) % 6 + 1;
+}
+
+int CpuGenomeDecoder::getNextCellFunctionDataSize(uint8_t const* genome, int genomeSize, int nodeAddress, bool withSubgenome)
+{
+    auto cellFunction = getNextCellFunctionType(genome, genomeSize, nodeAddress);
+    switch (cellFunction) {
+    case CellFunction_Neuron:
+        return Const::NeuronBytes;
+    case CellFunction_Transmitter:
+        return Const::TransmitterBytes;
+    case CellFunction_Constructor:
+    case CellFunction_Injector: {
+        auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
+        if (!withSubgenome) {
+            return cellFunctionFixedBytes;
+        }
+        auto isMakeCopy = convertByteToBool(getByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes));
+        if (isMakeCopy) {
+            return cellFunctionFixedBytes + 1;
+        } else {
+            return cellFunctionFixedBytes + 3 + getNextSubGenomeSize(genome, genomeSize, nodeAddress);
+        }
+    }
+    case CellFunction_Sensor:
+        return Const::SensorBytes;
+    case CellFunction_Nerve:
+        return Const::NerveBytes;
+    case CellFunction_Attacker:
+        return Const::AttackerBytes;
+    case CellFunction_Muscle:
+        return Const::MuscleBytes;
+    case CellFunction_Defender:
+        return Const::DefenderBytes;
+    case CellFunction_Reconnector:
+        return Const::ReconnectorBytes;
+    case CellFunction_Detonator:
+        return Const::DetonatorBytes;
+    default:
+        return 0;
+    }
+}
+
+CellFunction CpuGenomeDecoder::getNextCellFunctionType(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    return getByte(genome, genomeSize, nodeAddress) % CellFunction_Count;
+}
+
+bool CpuGenomeDecoder::isNextCellSelfReplication(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    switch (getNextCellFunctionType(genome, genomeSize, nodeAddress)) {
+    case CellFunction_Constructor:
+        return convertByteToBool(getByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes));
+    case CellFunction_Injector:
+        return convertByteToBool(getByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + Const::InjectorFixedBytes));
+    }
+    return false;
+}
+
+int CpuGenomeDecoder::getNextCellColor(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    return getByte(genome, genomeSize, nodeAddress + Const::CellColorPos) % MAX_COLORS;
+}
+
+int CpuGenomeDecoder::getNextExecutionNumber(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    return getByte(genome, genomeSize, nodeAddress + Const::CellExecutionNumberPos);
+}
+
+int CpuGenomeDecoder::getNextInputExecutionNumber(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    return getByte(genome, genomeSize, nodeAddress + Const::CellInputExecutionNumberPos);
+}
+
+void CpuGenomeDecoder::setNextCellFunctionType(uint8_t* genome, int genomeSize, int nodeAddress, CellFunction cellFunction)
+{
+    setByte(genome, genomeSize, nodeAddress, static_cast<uint8_t>(cellFunction));
+}
+
+void CpuGenomeDecoder::setNextCellSelfReplication(uint8_t* genome, int genomeSize, int nodeAddress, bool value)
+{
+    switch (getNextCellFunctionType(genome, genomeSize, nodeAddress)) {
+    case CellFunction_Constructor: {
+        setByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes, convertBoolToByte(value));
+    } break;
+    case CellFunction_Injector: {
+        setByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + Const::InjectorFixedBytes, convertBoolToByte(value));
+    } break;
+    }
+}
+
+void CpuGenomeDecoder::setNextCellSubgenomeSize(uint8_t* genome, int genomeSize, int nodeAddress, int size)
+{
+    switch (getNextCellFunctionType(genome, genomeSize, nodeAddress)) {
+    case CellFunction_Constructor: {
+        writeWord(genome, genomeSize, nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes + 1, size);
+    } break;
+    case CellFunction_Injector: {
+        writeWord(genome, genomeSize, nodeAddress + Const::CellBasicBytes + Const::InjectorFixedBytes + 1, size);
+    } break;
+    }
+}
+
+void CpuGenomeDecoder::setNextCellColor(uint8_t* genome, int genomeSize, int nodeAddress, int color)
+{
+    setByte(genome, genomeSize, nodeAddress + Const::CellColorPos, static_cast<uint8_t>(color));
+}
+
+void CpuGenomeDecoder::setNextInputExecutionNumber(uint8_t* genome, int genomeSize, int nodeAddress, int value)
+{
+    setByte(genome, genomeSize, nodeAddress + Const::CellInputExecutionNumberPos, static_cast<uint8_t>(value));
+}
+
+void CpuGenomeDecoder::setNextOutputBlocked(uint8_t* genome, int genomeSize, int nodeAddress, bool value)
+{
+    setByte(genome, genomeSize, nodeAddress + Const::CellOutputBlockedPos, value ? 1 : 0);
+}
+
+void CpuGenomeDecoder::setNextAngle(uint8_t* genome, int genomeSize, int nodeAddress, uint8_t angle)
+{
+    setByte(genome, genomeSize, nodeAddress + Const::CellAnglePos, angle);
+}
+
+void CpuGenomeDecoder::setNextRequiredConnections(uint8_t* genome, int genomeSize, int nodeAddress, uint8_t value)
+{
+    setByte(genome, genomeSize, nodeAddress + Const::CellRequiredConnectionsPos, value);
+}
+
+void CpuGenomeDecoder::setNextConstructionAngle1(uint8_t* genome, int genomeSize, int nodeAddress, uint8_t angle)
+{
+    setByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + Const::ConstructorConstructionAngle1Pos, angle);
+}
+
+void CpuGenomeDecoder::setNextConstructionAngle2(uint8_t* genome, int genomeSize, int nodeAddress, uint8_t angle)
+{
+    setByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + Const::ConstructorConstructionAngle2Pos, angle);
+}
+
+void CpuGenomeDecoder::setNextConstructorSeparation(uint8_t* genome, int genomeSize, int nodeAddress, bool separation)
+{
+    setByte(
+        genome, genomeSize, nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes + 3 + Const::GenomeHeaderSeparationPos, convertBoolToByte(separation));
+}
+
+void CpuGenomeDecoder::setNextConstructorNumBranches(uint8_t* genome, int genomeSize, int nodeAddress, int numBranches)
+{
+    setByte(
+        genome,
+        genomeSize,
+        nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes + 3 + Const::GenomeHeaderNumBranchesPos,
+        static_cast<uint8_t>(numBranches));
+}
+
+void CpuGenomeDecoder::setNextConstructorNumRepetitions(uint8_t* genome, int genomeSize, int nodeAddress, int numRepetitions)
+{
+    setByte(
+        genome,
+        genomeSize,
+        nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes + 3 + Const::GenomeHeaderNumRepetitionsPos,
+        static_cast<uint8_t>(numRepetitions));
+}
+
+bool CpuGenomeDecoder::containsSectionSelfReplication(uint8_t const* genome, int genomeSize)
+{
+    bool result;
+    getNodeAddressForSelfReplication(genome, genomeSize, result);
+    return result;
+}
+
+int CpuGenomeDecoder::getNodeAddressForSelfReplication(uint8_t const* genome, int genomeSize, bool& containsSelfReplicator)
+{
+    for (int nodeAddress = 0; nodeAddress < genomeSize;) {
+        if (isNextCellSelfReplication(genome, genomeSize, nodeAddress)) {
+            containsSelfReplicator = true;
+            return nodeAddress;
+        }
+        nodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
+    }
+    containsSelfReplicator = false;
+    return 0;
+}
+
+void CpuGenomeDecoder::setRandomCellFunctionData(
+    CpuRandom& random,
+    uint8_t* genome,
+    int genomeSize,
+    int nodeAddress,
+    CellFunction const& cellFunction,
+    bool makeSelfCopy,
+    int subGenomeSize)
+{
+    auto newCellFunctionSize = getCellFunctionDataSize(cellFunction, makeSelfCopy, subGenomeSize);
+    for (int i = 0; i < newCellFunctionSize; ++i) {
+        setByte(genome, genomeSize, nodeAddress + i, random.randomByte());
+    }
+    if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
+        auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
+        setByte(genome, genomeSize, nodeAddress + cellFunctionFixedBytes, makeSelfCopy ? 1 : 0);
+
+        auto subGenomeRelPos = getCellFunctionDataSize(cellFunction, makeSelfCopy, 0);
+        setByte(genome, genomeSize, nodeAddress + subGenomeRelPos + Const::GenomeHeaderNumRepetitionsPos, 1);
+
+        if (!makeSelfCopy) {
+            writeWord(genome, genomeSize, nodeAddress + cellFunctionFixedBytes + 1, subGenomeSize);
+        }
+    }
+}
+
+int CpuGenomeDecoder::getCellFunctionDataSize(CellFunction cellFunction, bool makeSelfCopy, int genomeSize)
+{
+    switch (cellFunction) {
+    case CellFunction_Neuron:
+        return Const::NeuronBytes;
+    case CellFunction_Transmitter:
+        return Const::TransmitterBytes;
+    case CellFunction_Constructor:
+        return makeSelfCopy ? Const::ConstructorFixedBytes + 1 : Const::ConstructorFixedBytes + 3 + genomeSize;
+    case CellFunction_Sensor:
+        return Const::SensorBytes;
+    case CellFunction_Nerve:
+        return Const::NerveBytes;
+    case CellFunction_Attacker:
+        return Const::AttackerBytes;
+    case CellFunction_Injector:
+        return makeSelfCopy ? Const::InjectorFixedBytes + 1 : Const::InjectorFixedBytes + 3 + genomeSize;
+    case CellFunction_Muscle:
+        return Const::MuscleBytes;
+    case CellFunction_Defender:
+        return Const::DefenderBytes;
+    case CellFunction_Reconnector:
+        return Const::ReconnectorBytes;
+    case CellFunction_Detonator:
+        return Const::DetonatorBytes;
+    default:
+        return 0;
+    }
+}
+
+int CpuGenomeDecoder::getNextSubGenomeSize(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    auto cellFunction = getNextCellFunctionType(genome, genomeSize, nodeAddress);
+    auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
+    auto subGenomeSizeIndex = nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes + 1;
+    return std::max(std::min(readWord(genome, genomeSize, subGenomeSizeIndex), genomeSize - (subGenomeSizeIndex + 2)), 0);
+}
+
+uint8_t CpuGenomeDecoder::getByte(uint8_t const* genome, int genomeSize, int address)
+{
+    return address >= 0 && address < genomeSize ? genome[address] : 0;
+}
+
+void CpuGenomeDecoder::setByte(uint8_t* genome, int genomeSize, int address, uint8_t value)
+{
+    if (address >= 0 && address < genomeSize) {
+        genome[address] = value;
+    }
+}
+
+bool CpuGenomeDecoder::readBool(ConstructorDescription const& constructor, int& genomeBytePosition)
+{
+    return convertByteToBool(readByte(constructor, genomeBytePosition));
+}
+
+uint8_t CpuGenomeDecoder::readByte(ConstructorDescription const& constructor, int& genomeBytePosition)
+{
+    if (isFinished(constructor)) {
+        return 0;
+    }
+    return getByte(constructor.genome.data(), toInt(constructor.genome.size()), genomeBytePosition++);
+}
+
+int CpuGenomeDecoder::readOptionalByte(ConstructorDescription const& constructor, int& genomeBytePosition)
+{
+    auto result = static_cast<int>(readByte(constructor, genomeBytePosition));
+    return result > 127 ? -1 : result;
+}
+
+int CpuGenomeDecoder::readOptionalByte(ConstructorDescription const& constructor, int& genomeBytePosition, int moduloValue)
+{
+    auto result = static_cast<int>(readByte(constructor, genomeBytePosition));
+    return result > 127 ? -1 : result % moduloValue;
+}
+
+int CpuGenomeDecoder::readWord(ConstructorDescription const& constructor, int& genomeBytePosition)
+{
+    auto b1 = readByte(constructor, genomeBytePosition);
+    auto b2 = readByte(constructor, genomeBytePosition);
+    return convertBytesToWord(b1, b2);
+}
+
+float CpuGenomeDecoder::readFloat(ConstructorDescription const& constructor, int& genomeBytePosition)
+{
+    return static_cast<float>(static_cast<int8_t>(readByte(constructor, genomeBytePosition))) / 128;
+}
+
+float CpuGenomeDecoder::readEnergy(ConstructorDescription const& constructor, int& genomeBytePosition)
+{
+    return static_cast<float>(static_cast<int8_t>(readByte(constructor, genomeBytePosition))) / 128 * 100 + 150;
+}
+
+float CpuGenomeDecoder::readAngle(ConstructorDescription const& constructor, int& genomeBytePosition)
+{
+    return convertByteToAngle(readByte(constructor, genomeBytePosition));
+}
+
+int CpuGenomeDecoder::readWord(uint8_t const* genome, int genomeSize, int address)
+{
+    return convertBytesToWord(getByte(genome, genomeSize, address), getByte(genome, genomeSize, address + 1));
+}
+
+void CpuGenomeDecoder::writeWord(uint8_t* genome, int genomeSize, int address, int word)
+{
+    setByte(genome, genomeSize, address, static_cast<uint8_t>(word & 0xff));
+    setByte(genome, genomeSize, address + 1, static_cast<uint8_t>((word >> 8) & 0xff));
+}
+
+bool CpuGenomeDecoder::convertByteToBool(uint8_t b)
+{
+    return static_cast<int8_t>(b) > 0;
+}
+
+uint8_t CpuGenomeDecoder::convertBoolToByte(bool value)
+{
+    return value ? 1 : 0;
+}
+
+int CpuGenomeDecoder::convertBytesToWord(uint8_t b1, uint8_t b2)
+{
+    return static_cast<int>(b1) | (static_cast<int>(b2) << 8);
+}
+
+uint8_t CpuGenomeDecoder::convertAngleToByte(float angle)
+{
+    if (angle > 180.0f) {
+        angle -= 360.0f;
+    }
+    if (angle < -180.0f) {
+        angle += 360.0f;
+    }
+    return static_cast<uint8_t>(static_cast<int8_t>(angle / 180 * 120));
+}
+
+float CpuGenomeDecoder::convertByteToAngle(uint8_t b)
+{
+    return static_cast<float>(static_cast<int8_t>(b)) / 120 * 180;
+}
+
+int CpuGenomeDecoder::findStartNodeAddress(uint8_t const* genome, int genomeSize, int refIndex)
+{
+    for (int currentNodeAddress = Const::GenomeHeaderSize; currentNodeAddress <= refIndex;) {
+        auto prevCurrentNodeAddress = currentNodeAddress;
+        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
+        if (currentNodeAddress > refIndex) {
+            return prevCurrentNodeAddress;
+        }
+    }
+    return Const::GenomeHeaderSize;
+}
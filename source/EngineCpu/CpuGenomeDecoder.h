@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "EngineInterface/CellFunctionConstants.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeConstants.h"
+
+#include "CpuRandom.h"
+#include "Definitions.h"
+
+//counterpart of GenomeDecoder on the GPU operating on the genome bytes
+//in contrast to the GPU all accesses are bounds-checked: bytes outside the genome are read as 0 and writes outside are ignored
+class CpuGenomeDecoder
+{
+public:
+    struct GenomeHeader
+    {
+        ConstructionShape shape = ConstructionShape_Custom;
+        int numBranches = 1;
+        bool separateConstruction = true;
+        ConstructorAngleAlignment angleAlignment = ConstructorAngleAlignment_None;
+        float stiffness = 1.0f;
+        float connectionDistance = 1.0f;
+        int numRepetitions = 1;
+        float concatenationAngle1 = 0;
+        float concatenationAngle2 = 0;
+
+        bool hasInfiniteRepetitions() const;
+    };
+
+    //genome-wide methods
+    template <typename Func>
+    static void executeForEachNodeRecursively(uint8_t const* genome, int genomeSize, bool includedSeparatedParts, bool countBranches, Func const& func);
+    static GenomeHeader readGenomeHeader(ConstructorDescription const& constructor);
+    static int getGenomeDepth(uint8_t const* genome, int genomeSize);
+    static int getNumNodesRecursively(uint8_t const* genome, int genomeSize, bool includeRepetitions, bool includedSeparatedParts);
+    static int getRandomGenomeNodeAddress(
+        CpuRandom& random,
+        uint8_t const* genome,
+        int genomeSize,
+        bool considerZeroSubGenomes,
+        std::vector<int>* subGenomesSizeIndices = nullptr,
+        int randomRefIndex = 0);
+    static int getNumNodes(uint8_t const* genome, int genomeSize);
+    static int getNodeAddress(uint8_t const* genome, int genomeSize, int nodeIndex);
+    static bool isFirstNode(ConstructorDescription const& constructor);
+    static bool isFirstRepetition(ConstructorDescription const& constructor);
+    static bool isLastNode(ConstructorDescription const& constructor);
+    static bool isLastRepetition(ConstructorDescription const& constructor);
+    static bool hasInfiniteRepetitions(ConstructorDescription const& constructor);
+    static bool hasEmptyGenome(ConstructorDescription const& constructor);
+    static bool isFinished(ConstructorDescription const& constructor);
+    static bool containsSelfReplication(std::vector<uint8_t> const& genome);
+    static std::vector<uint8_t> copyGenome(std::vector<uint8_t> const& sourceGenome, int genomeBytePosition);
+    static bool isSeparating(uint8_t const* genome, int genomeSize);
+    static int getNumRepetitions(uint8_t const* genome, int genomeSize, bool countInfinityAsOne = false);
+    static int getNumBranches(uint8_t const* genome, int genomeSize);
+
+    //node-wide methods
+    static int getNextCellFunctionDataSize(uint8_t const* genome, int genomeSize, int nodeAddress, bool withSubgenome = true);
+    static CellFunction getNextCellFunctionType(uint8_t const* genome, int genomeSize, int nodeAddress);
+    static bool isNextCellSelfReplication(uint8_t const* genome, int genomeSize, int nodeAddress);
+    static int getNextCellColor(uint8_t const* genome, int genomeSize, int nodeAddress);
+    static int getNextExecutionNumber(uint8_t const* genome, int genomeSize, int nodeAddress);
+    static int getNextInputExecutionNumber(uint8_t const* genome, int genomeSize, int nodeAddress);
+    static void setNextCellFunctionType(uint8_t* genome, int genomeSize, int nodeAddress, CellFunction cellFunction);
+    static void setNextCellSelfReplication(uint8_t* genome, int genomeSize, int nodeAddress, bool value);
+    static void setNextCellSubgenomeSize(uint8_t* genome, int genomeSize, int nodeAddress, int size);
+    static void setNextCellColor(uint8_t* genome, int genomeSize, int nodeAddress, int color);
+    static void setNextInputExecutionNumber(uint8_t* genome, int genomeSize, int nodeAddress, int value);
+    static void setNextOutputBlocked(uint8_t* genome, int genomeSize, int nodeAddress, bool value);
+    static void setNextAngle(uint8_t* genome, int genomeSize, int nodeAddress, uint8_t angle);
+    static void setNextRequiredConnections(uint8_t* genome, int genomeSize, int nodeAddress, uint8_t value);
+    static void setNextConstructionAngle1(uint8_t* genome, int genomeSize, int nodeAddress, uint8_t angle);
+    static void setNextConstructionAngle2(uint8_t* genome, int genomeSize, int nodeAddress, uint8_t angle);
+    static void setNextConstructorSeparation(uint8_t* genome, int genomeSize, int nodeAddress, bool separation);
+    static void setNextConstructorNumBranches(uint8_t* genome, int genomeSize, int nodeAddress, int numBranches);
+    static void setNextConstructorNumRepetitions(uint8_t* genome, int genomeSize, int nodeAddress, int numRepetitions);
+    static bool containsSectionSelfReplication(uint8_t const* genome, int genomeSize);
+    static int getNodeAddressForSelfReplication(uint8_t const* genome, int genomeSize, bool& containsSelfReplicator);
+    static void setRandomCellFunctionData(
+        CpuRandom& random,
+        uint8_t* genome,
+        int genomeSize,
+        int nodeAddress,
+        CellFunction const& cellFunction,
+        bool makeSelfCopy,
+        int subGenomeSize);
+    static int getCellFunctionDataSize(CellFunction cellFunction, bool makeSelfCopy, int genomeSize);  //genomeSize only relevant for constructors and injectors
+    static int getNextSubGenomeSize(uint8_t const* genome, int genomeSize, int nodeAddress);  //prerequisites: (constructor or injector) and !makeSelfCopy
+
+    //low level read-write methods
+    static uint8_t getByte(uint8_t const* genome, int genomeSize, int address);
+    static void setByte(uint8_t* genome, int genomeSize, int address, uint8_t value);
+    static bool readBool(ConstructorDescription const& constructor, int& genomeBytePosition);
+    static uint8_t readByte(ConstructorDescription const& constructor, int& genomeBytePosition);
+    static int readOptionalByte(ConstructorDescription const& constructor, int& genomeBytePosition);
+    static int readOptionalByte(ConstructorDescription const& constructor, int& genomeBytePosition, int moduloValue);
+    static int readWord(ConstructorDescription const& constructor, int& genomeBytePosition);
+    static float readFloat(ConstructorDescription const& constructor, int& genomeBytePosition);  //return values from -1 to 1
+    static float readEnergy(ConstructorDescription const& constructor, int& genomeBytePosition);  //return values from 36 to 1060
+    static float readAngle(ConstructorDescription const& constructor, int& genomeBytePosition);
+    static int readWord(uint8_t const* genome, int genomeSize, int address);
+    static void writeWord(uint8_t* genome, int genomeSize, int address, int word);
+
+    //conversion methods
+    static bool convertByteToBool(uint8_t b);
+    static uint8_t convertBoolToByte(bool value);
+    static int convertBytesToWord(uint8_t b1, uint8_t b2);
+    static uint8_t convertAngleToByte(float angle);
+    static float convertByteToAngle(uint8_t b);
+
+    static auto constexpr MAX_SUBGENOME_RECURSION_DEPTH = 15;
+
+private:
+    static int findStartNodeAddress(uint8_t const* genome, int genomeSize, int refIndex);
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+void CpuGenomeDecoder::executeForEachNodeRecursively(
+    uint8_t const* genome,
+    int genomeSize,
+    bool includedSeparatedParts,
+    bool countBranches,
+    Func const& func)
+{
+    if (genomeSize < Const::GenomeHeaderSize) {
+        return;
+    }
+    int subGenomeEndAddresses[MAX_SUBGENOME_RECURSION_DEPTH];
+    int subGenomeNumRepetitions[MAX_SUBGENOME_RECURSION_DEPTH + 1];
+    int depth = 0;
+    subGenomeNumRepetitions[0] = getNumRepetitions(genome, genomeSize, true);
+    for (auto nodeAddress = Const::GenomeHeaderSize; nodeAddress < genomeSize;) {
+        auto cellFunction = getNextCellFunctionType(genome, genomeSize, nodeAddress);
+        func(depth, nodeAddress, subGenomeNumRepetitions[depth]);
+
+        bool goToNextSibling = true;
+        if ((cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) && depth < MAX_SUBGENOME_RECURSION_DEPTH) {
+            auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
+            auto makeSelfCopy = convertByteToBool(getByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes));
+            if (!makeSelfCopy) {
+                auto deltaSubGenomeStartPos = Const::CellBasicBytes + cellFunctionFixedBytes + 3;
+                auto subGenomeSize = getNextSubGenomeSize(genome, genomeSize, nodeAddress);
+                auto subGenome = genome + nodeAddress + deltaSubGenomeStartPos;
+                if (subGenomeSize < Const::GenomeHeaderSize || (!includedSeparatedParts && isSeparating(subGenome, subGenomeSize))) {
+                    //skip scanning sub-genome
+                } else {
+                    nodeAddress += deltaSubGenomeStartPos;
+                    subGenomeEndAddresses[depth++] = nodeAddress + subGenomeSize;
+
+                    auto numBranches = countBranches ? getNumBranches(subGenome, subGenomeSize) : 1;
+                    auto numRepetitions = getNumRepetitions(subGenome, subGenomeSize, true);
+                    subGenomeNumRepetitions[depth] = subGenomeNumRepetitions[depth - 1] * numRepetitions * numBranches;
+                    nodeAddress += Const::GenomeHeaderSize;
+                    goToNextSibling = false;
+                }
+            }
+        }
+        if (goToNextSibling) {
+            nodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
+        }
+        while (depth > 0 && subGenomeEndAddresses[depth - 1] == nodeAddress) {
+            --depth;
+        }
+    }
+}
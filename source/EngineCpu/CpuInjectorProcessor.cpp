@@ -0,0 +1,127 @@
+#include "CpuInjectorProcessor.h"
+
+#include <cmath>
+
+#include "EngineInterface/GenomeConstants.h"
+
+void CpuInjectorProcessor::process(CpuCellFunctionData& data, AccumulatedStatistics& statistics)
+{
+    for (auto const& cellIndex : data.cellFunctionOperations[CellFunction_Injector]) {
+        processCell(data, statistics, cellIndex);
+    }
+}
+
+void CpuInjectorProcessor::processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex)
+{
+    auto& cells = data.data.cells;
+    auto const& parameters = data.parameters;
+    auto activity = CpuCellFunctionProcessor::calcInputActivity(cells, cells[cellIndex], parameters);
+    CpuCellFunctionProcessor::updateInvocationState(cells[cellIndex], activity);
+
+    if (std::abs(activity.channels[0]) >= parameters.cellFunctionInjectorActivityThreshold) {
+        auto& cell = cells[cellIndex];
+        auto& injector = CpuCellFunctionProcessor::getCellFunction<InjectorDescription>(cell);
+        auto color = cell.properties.color;
+
+        bool match = false;
+        bool injection = false;
+
+        switch (injector.mode) {
+        case InjectorMode_InjectAll: {
+            CpuCellFunctionProcessor::forEachCell(data, cell.properties.pos, parameters.cellFunctionInjectorRadius[color], cell.detached, [&](int otherIndex) {
+                if (otherIndex == cellIndex) {
+                    return;
+                }
+                auto& otherCell = cells[otherIndex];
+                auto otherCellFunction = otherCell.properties.getCellFunctionType();
+                if (otherCellFunction != CellFunction_Constructor && otherCellFunction != CellFunction_Injector) {
+                    return;
+                }
+                if (otherCellFunction == CellFunction_Constructor
+                    && CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(otherCell).genomeCurrentNodeIndex != 0) {
+                    return;
+                }
+                match = true;
+                auto injectorDuration = parameters.cellFunctionInjectorDurationColorMatrix[color][otherCell.properties.color];
+
+                auto numDefenderCells = countAndTrackDefenderCells(cells, statistics, otherCell);
+                float defendStrength =
+                    numDefenderCells == 0 ? 1.0f : std::pow(parameters.cellFunctionDefenderAgainstInjectorStrength[color], toFloat(numDefenderCells));
+                injectorDuration = toInt(toFloat(injectorDuration) * defendStrength);
+                if (injector.counter < injectorDuration) {
+                    return;
+                }
+                injectGenome(otherCell, injector.genome);
+                injection = true;
+            });
+        } break;
+
+        case InjectorMode_InjectOnlyEmptyCells: {
+            CpuCellFunctionProcessor::forEachCell(data, cell.properties.pos, parameters.cellFunctionInjectorRadius[color], cell.detached, [&](int otherIndex) {
+                if (otherIndex == cellIndex) {
+                    return;
+                }
+                auto& otherCell = cells[otherIndex];
+                auto otherCellFunction = otherCell.properties.getCellFunctionType();
+                if (otherCellFunction != CellFunction_Constructor && otherCellFunction != CellFunction_Injector) {
+                    return;
+                }
+                auto otherGenomeSize = otherCellFunction == CellFunction_Constructor
+                    ? CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(otherCell).genome.size()
+                    : CpuCellFunctionProcessor::getCellFunction<InjectorDescription>(otherCell).genome.size();
+                if (toInt(otherGenomeSize) > Const::GenomeHeaderSize) {
+                    return;
+                }
+                injectGenome(otherCell, injector.genome);
+                match = true;
+                injection = true;
+            });
+        } break;
+        }
+
+        if (match) {
+            ++statistics.numInjectionActivities[color];
+            if (injection) {
+                ++statistics.numCompletedInjections[color];
+                injector.counter = 0;
+            } else {
+                ++injector.counter;
+            }
+            activity.channels[0] = 1;
+        } else {
+            injector.counter = 0;
+            activity.channels[0] = 0;
+        }
+    }
+    CpuCellFunctionProcessor::setActivity(cells[cellIndex], activity);
+}
+
+void CpuInjectorProcessor::injectGenome(CpuCell& targetCell, std::vector<uint8_t> const& genome)
+{
+    if (targetCell.properties.getCellFunctionType() == CellFunction_Constructor) {
+        auto& constructor = CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(targetCell);
+        constructor.genome = genome;
+        constructor.numInheritedGenomeNodes = 0;
+    } else {
+        CpuCellFunctionProcessor::getCellFunction<InjectorDescription>(targetCell).genome = genome;
+    }
+    targetCell.genomeInfo.reset();
+}
+
+int CpuInjectorProcessor::countAndTrackDefenderCells(std::vector<CpuCell> const& cells, AccumulatedStatistics& statistics, CpuCell const& cell)
+{
+    int result = 0;
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto const& connectedCell = cells[cell.connections[i].cellIndex];
+        auto const& cellFunction = connectedCell.properties.cellFunction;
+        if (!cellFunction) {
+            continue;
+        }
+        auto defender = std::get_if<DefenderDescription>(&*cellFunction);
+        if (defender && defender->mode == DefenderMode_DefendAgainstInjector) {
+            ++statistics.numDefenderActivities[connectedCell.properties.color];
+            ++result;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CpuCellFunctionProcessor.h"
+
+//counterpart of InjectorProcessor on the GPU
+class CpuInjectorProcessor
+{
+public:
+    static void process(CpuCellFunctionData& data, AccumulatedStatistics& statistics);
+
+private:
+    static void processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex);
+    static void injectGenome(CpuCell& targetCell, std::vector<uint8_t> const& genome);
+    static int countAndTrackDefenderCells(std::vector<CpuCell> const& cells, AccumulatedStatistics& statistics, CpuCell const& cell);
+};
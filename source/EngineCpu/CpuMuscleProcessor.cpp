@@ -0,0 +1,228 @@
+#include "CpuMuscleProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Math.h"
+
+void CpuMuscleProcessor::process(CpuCellFunctionData& data, AccumulatedStatistics& statistics)
+{
+    for (auto const& cellIndex : data.cellFunctionOperations[CellFunction_Muscle]) {
+        processCell(data, statistics, cellIndex);
+    }
+}
+
+void CpuMuscleProcessor::processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex)
+{
+    auto& cells = data.data.cells;
+    auto activity = CpuCellFunctionProcessor::calcInputActivity(cells, cells[cellIndex], data.parameters);
+    CpuCellFunctionProcessor::updateInvocationState(cells[cellIndex], activity);
+
+    auto& muscle = CpuCellFunctionProcessor::getCellFunction<MuscleDescription>(cells[cellIndex]);
+    muscle.lastMovementX = 0;
+    muscle.lastMovementY = 0;
+
+    switch (muscle.mode) {
+    case MuscleMode_Movement: {
+        movement(data, statistics, cellIndex, activity);
+    } break;
+    case MuscleMode_ContractionExpansion: {
+        contractionExpansion(data, statistics, cellIndex, activity);
+    } break;
+    case MuscleMode_Bending: {
+        bending(data, statistics, cellIndex, activity);
+    } break;
+    }
+
+    CpuCellFunctionProcessor::setActivity(cells[cellIndex], activity);
+}
+
+void CpuMuscleProcessor::movement(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription& activity)
+{
+    if (std::abs(activity.channels[0]) < NEAR_ZERO) {
+        return;
+    }
+    auto& cells = data.data.cells;
+    auto& cell = cells[cellIndex];
+    auto const& parameters = data.parameters;
+    auto color = cell.properties.color;
+
+    auto direction = RealVector2D{0, 0};
+    auto acceleration = 0.0f;
+    if (parameters.cellFunctionMuscleMovementTowardTargetedObject) {
+        if (parameters.features.legacyModes && parameters.legacyCellFunctionMuscleMovementAngleFromSensor) {
+            auto sensorCellIndex = findNearbySensor(cells, cell);
+            if (sensorCellIndex != -1) {
+                auto const& sensor = CpuCellFunctionProcessor::getCellFunction<SensorDescription>(cells[sensorCellIndex]);
+                if (sensor.memoryTargetX != 0 || sensor.memoryTargetY != 0) {
+                    direction = {sensor.memoryTargetX, sensor.memoryTargetY};
+                    acceleration = parameters.cellFunctionMuscleMovementAcceleration[color];
+                }
+            }
+        } else {
+            if (activity.origin == ActivityOrigin_Sensor && (activity.targetX != 0 || activity.targetY != 0)) {
+                direction = {activity.targetX, activity.targetY};
+                acceleration = parameters.cellFunctionMuscleMovementAcceleration[color];
+            }
+        }
+    } else {
+        direction = CpuCellFunctionProcessor::calcSignalDirection(data, cellIndex);
+        acceleration = parameters.cellFunctionMuscleMovementAcceleration[color];
+    }
+    float angle = std::max(-0.5f, std::min(0.5f, activity.channels[3])) * 360.0f;
+    direction = Math::normalized(Math::rotateClockwise(direction, angle)) * acceleration * getTruncatedUnitValue(activity);
+    cell.properties.vel += direction;
+
+    auto& muscle = CpuCellFunctionProcessor::getCellFunction<MuscleDescription>(cell);
+    muscle.lastMovementX = direction.x;
+    muscle.lastMovementY = direction.y;
+    if (!(parameters.features.legacyModes && parameters.legacyCellFunctionMuscleNoActivityReset)) {
+        activity.channels[0] = 0;
+        activity.origin = ActivityOrigin_Unknown;
+    }
+    ++statistics.numMuscleActivities[color];
+}
+
+void CpuMuscleProcessor::contractionExpansion(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription const& activity)
+{
+    if (std::abs(activity.channels[0]) < NEAR_ZERO) {
+        return;
+    }
+    auto& cells = data.data.cells;
+    auto& cell = cells[cellIndex];
+    auto const& parameters = data.parameters;
+    auto color = cell.properties.color;
+
+    auto const minDistance = parameters.cellMinDistance * 1.2f;
+    auto const maxDistance = std::max(parameters.cellMaxBindingDistance[color] * 0.5f, minDistance);
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto& connection = cell.connections[i];
+        auto& connectedCell = cells[connection.cellIndex];
+        if (connectedCell.properties.executionOrderNumber == cell.getInputExecutionOrderNumber()) {
+            auto newDistance = connection.distance + parameters.cellFunctionMuscleContractionExpansionDelta[color] * getTruncatedUnitValue(activity);
+            if (activity.channels[0] > 0 && newDistance >= maxDistance) {
+                continue;
+            }
+            if (activity.channels[0] < 0 && newDistance <= minDistance) {
+                continue;
+            }
+            connection.distance = newDistance;
+
+            auto otherIndex = getConnectionIndex(connectedCell, cellIndex);
+            connectedCell.connections[otherIndex].distance = newDistance;
+        }
+    }
+    ++statistics.numMuscleActivities[color];
+}
+
+void CpuMuscleProcessor::bending(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription const& activity)
+{
+    auto& cells = data.data.cells;
+    auto& cell = cells[cellIndex];
+    if (std::abs(activity.channels[0]) < NEAR_ZERO) {
+        return;
+    }
+    if (cell.numConnections < 2) {
+        return;
+    }
+    auto const& parameters = data.parameters;
+    auto color = cell.properties.color;
+    auto& muscle = CpuCellFunctionProcessor::getCellFunction<MuscleDescription>(cell);
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto& connection = cell.connections[i];
+        auto& connectedCell = cells[connection.cellIndex];
+        if (connectedCell.properties.executionOrderNumber == cell.getInputExecutionOrderNumber()) {
+            auto intensityChannel0 = getTruncatedUnitValue(activity);
+            auto bendingAngle = parameters.cellFunctionMuscleBendingAngle[color] * intensityChannel0;
+
+            if (bendingAngle < 0 && connection.angleFromPrevious <= -bendingAngle) {
+                continue;
+            }
+            auto& nextConnection = cell.connections[(i + 1) % cell.numConnections];
+            if (bendingAngle > 0 && nextConnection.angleFromPrevious <= bendingAngle) {
+                continue;
+            }
+            connection.angleFromPrevious += bendingAngle;
+            nextConnection.angleFromPrevious -= bendingAngle;
+
+            MuscleBendingDirection bendingDirection = [&] {
+                if (intensityChannel0 > NEAR_ZERO) {
+                    return MuscleBendingDirection_Positive;
+                } else if (intensityChannel0 < -NEAR_ZERO) {
+                    return MuscleBendingDirection_Negative;
+                } else {
+                    return MuscleBendingDirection_None;
+                }
+            }();
+            if (muscle.lastBendingDirection == bendingDirection && muscle.lastBendingSourceIndex == i) {
+                muscle.consecutiveBendingAngle += std::abs(bendingAngle);
+            } else {
+                muscle.consecutiveBendingAngle = 0;
+            }
+            muscle.lastBendingDirection = bendingDirection;
+            muscle.lastBendingSourceIndex = i;
+
+            if (std::abs(activity.channels[1]) > parameters.cellFunctionMuscleBendingAccelerationThreshold
+                && !hasTriangularConnection(cells, cell, connection.cellIndex)) {
+                auto delta = Math::normalized(data.spaceCalculator.getCorrectedDirection(connectedCell.properties.pos - cell.properties.pos));
+                delta = Math::rotateQuarterCounterClockwise(delta);
+                auto intensityChannel1 = getTruncatedUnitValue(activity, 1);
+                if ((intensityChannel0 < -NEAR_ZERO && intensityChannel1 < -NEAR_ZERO) || (intensityChannel0 > NEAR_ZERO && intensityChannel1 > NEAR_ZERO)) {
+                    auto acceleration = delta * intensityChannel0 * parameters.cellFunctionMuscleBendingAcceleration[color]
+                        * std::sqrt(muscle.consecutiveBendingAngle + 1.0f) / 20;
+                    connectedCell.properties.vel += acceleration;
+                }
+            }
+        }
+    }
+    ++statistics.numMuscleActivities[color];
+}
+
+int CpuMuscleProcessor::findNearbySensor(std::vector<CpuCell> const& cells, CpuCell const& cell)
+{
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto connectedCellIndex = cell.connections[i].cellIndex;
+        if (cells[connectedCellIndex].properties.getCellFunctionType() == CellFunction_Sensor) {
+            return connectedCellIndex;
+        }
+    }
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto const& connectedCell = cells[cell.connections[i].cellIndex];
+        for (int j = 0; j < connectedCell.numConnections; ++j) {
+            auto connectedConnectedCellIndex = connectedCell.connections[j].cellIndex;
+            if (cells[connectedConnectedCellIndex].properties.getCellFunctionType() == CellFunction_Sensor) {
+                return connectedConnectedCellIndex;
+            }
+        }
+    }
+    return -1;
+}
+
+int CpuMuscleProcessor::getConnectionIndex(CpuCell const& cell, int otherCellIndex)
+{
+    for (int i = 0; i < cell.numConnections; ++i) {
+        if (cell.connections[i].cellIndex == otherCellIndex) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+bool CpuMuscleProcessor::hasTriangularConnection(std::vector<CpuCell> const& cells, CpuCell const& cell, int otherCellIndex)
+{
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto connectedCellIndex = cell.connections[i].cellIndex;
+        if (connectedCellIndex == otherCellIndex) {
+            continue;
+        }
+        if (cells[connectedCellIndex].isConnectedTo(otherCellIndex)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float CpuMuscleProcessor::getTruncatedUnitValue(ActivityDescription const& activity, int channel)
+{
+    return std::max(-0.3f, std::min(0.3f, activity.channels[channel])) / 0.3f;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CpuCellFunctionProcessor.h"
+
+//counterpart of MuscleProcessor on the GPU
+class CpuMuscleProcessor
+{
+public:
+    static void process(CpuCellFunctionData& data, AccumulatedStatistics& statistics);
+
+private:
+    static void processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex);
+
+    static void movement(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription& activity);
+    static void contractionExpansion(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription const& activity);
+    static void bending(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription const& activity);
+
+    static int findNearbySensor(std::vector<CpuCell> const& cells, CpuCell const& cell);
+    static int getConnectionIndex(CpuCell const& cell, int otherCellIndex);
+    static bool hasTriangularConnection(std::vector<CpuCell> const& cells, CpuCell const& cell, int otherCellIndex);
+    static float getTruncatedUnitValue(ActivityDescription const& activity, int channel = 0);
+};
@@ -0,0 +1,849 @@
+#include "CpuMutationProcessor.h"
+
+#include <algorithm>
+
+#include "EngineInterface/EngineConstants.h"
+#include "EngineInterface/GenomeConstants.h"
+#include "EngineInterface/ShapeGenerator.h"
+
+#include "CpuGenomeDecoder.h"
+
+namespace
+{
+    ConstructorDescription& getConstructor(CpuCell& cell)
+    {
+        return std::get<ConstructorDescription>(*cell.properties.cellFunction);
+    }
+}
+
+void CpuMutationProcessor::applyRandomMutations(CpuSimulationData& data, SimulationParameters const& parameters, uint64_t seed, uint64_t timestep)
+{
+    for (int index = 0; index < toInt(data.cells.size()); ++index) {
+        auto& cell = data.cells[index];
+        if (cell.properties.livingState == LivingState_Activating && cell.properties.getCellFunctionType() == CellFunction_Constructor) {
+            CpuRandom random(seed, timestep, CpuRandomStage_Mutation, index);
+            applyRandomMutationsForCell(data, parameters, random, cell);
+        }
+    }
+}
+
+void CpuMutationProcessor::applyMutation(
+    CpuSimulationData& data,
+    SimulationParameters const& parameters,
+    CpuRandom& random,
+    CpuCell& cell,
+    MutationType mutationType)
+{
+    if (cell.properties.getCellFunctionType() != CellFunction_Constructor) {
+        return;
+    }
+    switch (mutationType) {
+    case MutationType::Properties:
+        propertiesMutation(random, cell);
+        break;
+    case MutationType::NeuronData:
+        neuronDataMutation(random, cell);
+        break;
+    case MutationType::Geometry:
+        geometryMutation(data, random, cell);
+        break;
+    case MutationType::CustomGeometry:
+        customGeometryMutation(random, cell);
+        break;
+    case MutationType::CellFunction:
+        cellFunctionMutation(parameters, random, cell);
+        break;
+    case MutationType::Insertion:
+        insertMutation(data, parameters, random, cell);
+        break;
+    case MutationType::Deletion:
+        deleteMutation(data, parameters, random, cell);
+        break;
+    case MutationType::Translation:
+        translateMutation(data, parameters, random, cell);
+        break;
+    case MutationType::Duplication:
+        duplicateMutation(data, parameters, random, cell);
+        break;
+    case MutationType::CellColor:
+        cellColorMutation(parameters, random, cell);
+        break;
+    case MutationType::SubgenomeColor:
+        subgenomeColorMutation(data, parameters, random, cell);
+        break;
+    case MutationType::GenomeColor:
+        genomeColorMutation(data, parameters, random, cell);
+        break;
+    }
+    cell.genomeInfo.reset();
+}
+
+void CpuMutationProcessor::applyRandomMutationsForCell(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    auto const& values = parameters.baseValues;
+    auto color = cell.properties.color;
+    auto numNodes = toFloat(CpuGenomeDecoder::getNumNodesRecursively(constructor.genome.data(), toInt(constructor.genome.size()), false, true));
+
+    executeMultipleEvents(random, values.cellCopyMutationCellProperties[color] * numNodes, [&] { propertiesMutation(random, cell); });
+    executeMultipleEvents(random, values.cellCopyMutationNeuronData[color] * numNodes, [&] { neuronDataMutation(random, cell); });
+    executeEvent(random, values.cellCopyMutationGeometry[color] * numNodes, [&] { geometryMutation(data, random, cell); });
+    executeEvent(random, values.cellCopyMutationCustomGeometry[color] * numNodes, [&] { customGeometryMutation(random, cell); });
+    executeMultipleEvents(random, values.cellCopyMutationCellFunction[color] * numNodes, [&] { cellFunctionMutation(parameters, random, cell); });
+    executeEvent(random, values.cellCopyMutationInsertion[color] * numNodes, [&] {
+        auto numNonSeparatedNodes =
+            toFloat(CpuGenomeDecoder::getNumNodesRecursively(constructor.genome.data(), toInt(constructor.genome.size()), false, false));
+        if (numNodes < 2 * numNonSeparatedNodes) {
+            insertMutation(data, parameters, random, cell);
+        }
+    });
+    executeEvent(random, values.cellCopyMutationDeletion[color] * numNodes, [&] { deleteMutation(data, parameters, random, cell); });
+    executeEvent(random, values.cellCopyMutationCellColor[color] * numNodes, [&] { cellColorMutation(parameters, random, cell); });
+    executeEvent(random, values.cellCopyMutationTranslation[color], [&] { translateMutation(data, parameters, random, cell); });
+    executeEvent(random, values.cellCopyMutationDuplication[color], [&] {
+        auto genomeSize = toInt(constructor.genome.size());
+        auto numNodes = toFloat(CpuGenomeDecoder::getNumNodesRecursively(constructor.genome.data(), genomeSize, false, true));
+        auto numNonSeparatedNodes = toFloat(CpuGenomeDecoder::getNumNodesRecursively(constructor.genome.data(), genomeSize, false, false));
+        if (numNodes < 2 * numNonSeparatedNodes) {
+            duplicateMutation(data, parameters, random, cell);
+        }
+    });
+    executeEvent(random, values.cellCopyMutationSubgenomeColor[color], [&] { subgenomeColorMutation(data, parameters, random, cell); });
+    executeEvent(random, values.cellCopyMutationGenomeColor[color], [&] { genomeColorMutation(data, parameters, random, cell); });
+    cell.genomeInfo.reset();
+}
+
+void CpuMutationProcessor::neuronDataMutation(CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    auto genome = constructor.genome.data();
+    auto genomeSize = toInt(constructor.genome.size());
+    auto nodeAddress = CpuGenomeDecoder::getRandomGenomeNodeAddress(random, genome, genomeSize, false);
+
+    auto type = CpuGenomeDecoder::getNextCellFunctionType(genome, genomeSize, nodeAddress);
+    if (type == CellFunction_Neuron) {
+        auto delta = random.random(Const::NeuronBytes - 1);
+        CpuGenomeDecoder::setByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + delta, random.randomByte());
+    }
+}
+
+void CpuMutationProcessor::propertiesMutation(CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    auto genome = constructor.genome.data();
+    auto genomeSize = toInt(constructor.genome.size());
+    auto numNodes = CpuGenomeDecoder::getNumNodesRecursively(genome, genomeSize, false, true);
+    auto node = random.random(numNodes - 1);
+    auto sequenceNumber = 0;
+
+    uint8_t prevExecutionNumber = random.randomByte();
+    uint8_t nextExecutionNumber = random.randomByte();
+    int nodeAddress = 0;
+    CpuGenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddressIntern, int repetition) {
+        auto origSequenceNumber = sequenceNumber;
+        ++sequenceNumber;
+        if (origSequenceNumber == node - 1) {
+            prevExecutionNumber = toUInt8(CpuGenomeDecoder::getNextExecutionNumber(genome, genomeSize, nodeAddressIntern));
+        }
+        if (origSequenceNumber == node + 1) {
+            nextExecutionNumber = toUInt8(CpuGenomeDecoder::getNextExecutionNumber(genome, genomeSize, nodeAddressIntern));
+        }
+        if (origSequenceNumber == node) {
+            nodeAddress = nodeAddressIntern;
+        }
+    });
+    if (nodeAddress == 0) {
+        return;
+    }
+
+    //basic property mutation
+    if (random.randomBool()) {
+        if (random.randomBool()) {
+            auto randomByte = random.randomByte();
+            if (random.random() < 0.8f) {
+                randomByte = random.randomBool() ? prevExecutionNumber : nextExecutionNumber;
+            }
+            CpuGenomeDecoder::setNextInputExecutionNumber(genome, genomeSize, nodeAddress, randomByte);
+        } else {
+            auto randomDelta = random.random(Const::CellBasicBytes - 1);
+            auto randomByte = random.randomByte();
+            if (randomDelta == 0) {  //no cell function type change
+                return;
+            }
+            if (randomDelta == Const::CellColorPos) {  //no color change
+                return;
+            }
+            if (randomDelta == Const::CellAnglePos || randomDelta == Const::CellRequiredConnectionsPos) {  //no structure change
+                return;
+            }
+            CpuGenomeDecoder::setByte(genome, genomeSize, nodeAddress + randomDelta, randomByte);
+        }
+    }
+
+    //cell function specific mutation
+    else {
+        auto nextCellFunctionDataSize = CpuGenomeDecoder::getNextCellFunctionDataSize(genome, genomeSize, nodeAddress, false);
+        if (nextCellFunctionDataSize > 0) {
+            auto randomDelta = random.random(nextCellFunctionDataSize - 1);
+            auto cellFunction = CpuGenomeDecoder::getNextCellFunctionType(genome, genomeSize, nodeAddress);
+            if (cellFunction == CellFunction_Constructor
+                && (randomDelta == Const::ConstructorConstructionAngle1Pos
+                    || randomDelta == Const::ConstructorConstructionAngle2Pos)) {  //no construction angles change
+                return;
+            }
+            CpuGenomeDecoder::setByte(genome, genomeSize, nodeAddress + Const::CellBasicBytes + randomDelta, random.randomByte());
+        }
+    }
+}
+
+void CpuMutationProcessor::geometryMutation(CpuSimulationData& data, CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    auto genome = constructor.genome.data();
+    auto genomeSize = toInt(constructor.genome.size());
+
+    SubGenome subGenomeRange{0, genomeSize};
+    if (genomeSize > Const::GenomeHeaderSize) {
+        std::vector<int> subGenomesSizeIndices;
+        CpuGenomeDecoder::getRandomGenomeNodeAddress(random, genome, genomeSize, false, &subGenomesSizeIndices);  //return value will be discarded
+        subGenomeRange = getSubGenome(constructor.genome, subGenomesSizeIndices);
+    }
+    auto subGenome = genome + subGenomeRange.address;
+    auto subGenomeSize = subGenomeRange.size;
+    if (subGenomeSize < Const::GenomeHeaderSize) {
+        return;
+    }
+
+    auto delta = random.random(Const::GenomeHeaderSize - 1);
+
+    if (delta == Const::GenomeHeaderNumRepetitionsPos) {
+        auto choice = random.random(250);
+        if (choice < 230) {
+            subGenome[delta] = static_cast<uint8_t>(1 + random.random(2));
+        } else if (choice < 240) {
+            subGenome[delta] = static_cast<uint8_t>(1 + random.random(10));
+        } else if (choice == 240) {
+            subGenome[delta] = static_cast<uint8_t>(1 + random.random(20));
+        } else {
+            //no infinite repetitions
+        }
+        return;
+    }
+    if (delta == Const::GenomeHeaderNumBranchesPos) {
+        subGenome[delta] = random.randomBool() ? 1 : random.randomByte();
+    }
+
+    auto mutatedByte = random.randomByte();
+    if (delta == Const::GenomeHeaderShapePos) {
+        auto shape = mutatedByte % ConstructionShape_Count;
+        auto origShape = subGenome[delta] % ConstructionShape_Count;
+        if (origShape != ConstructionShape_Custom && shape == ConstructionShape_Custom) {
+            subGenome[Const::GenomeHeaderAlignmentPos] = ConstructorAngleAlignment_60;  //alignment of the custom shape on the GPU
+
+            auto shapeGenerator = ShapeGeneratorFactory::create(origShape);
+            for (int nodeAddress = Const::GenomeHeaderSize; nodeAddress < subGenomeSize;) {
+                auto generationResult = shapeGenerator->generateNextConstructionData();
+                CpuGenomeDecoder::setNextAngle(subGenome, subGenomeSize, nodeAddress, CpuGenomeDecoder::convertAngleToByte(generationResult.angle));
+                CpuGenomeDecoder::setNextRequiredConnections(
+                    subGenome, subGenomeSize, nodeAddress, static_cast<uint8_t>(generationResult.numRequiredAdditionalConnections.value_or(-1)));
+                nodeAddress += Const::CellBasicBytes + CpuGenomeDecoder::getNextCellFunctionDataSize(subGenome, subGenomeSize, nodeAddress);
+            }
+        }
+    }
+    if (subGenome[delta] != mutatedByte) {
+        adaptMutationId(data, constructor);
+    }
+    subGenome[delta] = mutatedByte;
+}
+
+void CpuMutationProcessor::customGeometryMutation(CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    auto genome = constructor.genome.data();
+    auto genomeSize = toInt(constructor.genome.size());
+
+    auto numNodes = CpuGenomeDecoder::getNumNodesRecursively(genome, genomeSize, false, true);
+    auto node = random.random(numNodes - 1);
+    auto sequenceNumber = 0;
+    CpuGenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) {
+        if (sequenceNumber++ != node) {
+            return;
+        }
+        auto cellFunction = CpuGenomeDecoder::getNextCellFunctionType(genome, genomeSize, nodeAddress);
+        auto choice = cellFunction == CellFunction_Constructor ? random.random(3) : random.random(1);
+        switch (choice) {
+        case 0:
+            CpuGenomeDecoder::setNextAngle(genome, genomeSize, nodeAddress, random.randomByte());
+            break;
+        case 1:
+            CpuGenomeDecoder::setNextRequiredConnections(genome, genomeSize, nodeAddress, random.randomByte());
+            break;
+        case 2:
+            CpuGenomeDecoder::setNextConstructionAngle1(genome, genomeSize, nodeAddress, random.randomByte());
+            break;
+        case 3:
+            CpuGenomeDecoder::setNextConstructionAngle2(genome, genomeSize, nodeAddress, random.randomByte());
+            break;
+        }
+    });
+}
+
+void CpuMutationProcessor::cellFunctionMutation(SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    auto const& genome = constructor.genome;
+    auto genomeSize = toInt(genome.size());
+
+    std::vector<int> subGenomesSizeIndices;
+    auto nodeAddress = CpuGenomeDecoder::getRandomGenomeNodeAddress(random, genome.data(), genomeSize, false, &subGenomesSizeIndices);
+    auto numSubGenomesSizeIndices = toInt(subGenomesSizeIndices.size());
+
+    auto newCellFunction = random.random(CellFunction_Count - 1);
+    auto makeSelfCopy = parameters.cellFunctionConstructorMutationSelfReplication ? random.randomBool() : false;
+    if (newCellFunction == CellFunction_Injector) {  //not injection mutation allowed at the moment
+        return;
+    }
+    if ((newCellFunction == CellFunction_Constructor || newCellFunction == CellFunction_Injector) && !makeSelfCopy) {
+        if (parameters.cellFunctionConstructorMutationPreventDepthIncrease
+            && CpuGenomeDecoder::getGenomeDepth(genome.data(), genomeSize) <= numSubGenomesSizeIndices) {
+            return;
+        }
+    }
+
+    auto origCellFunction = CpuGenomeDecoder::getNextCellFunctionType(genome.data(), genomeSize, nodeAddress);
+    if (origCellFunction == CellFunction_Constructor || origCellFunction == CellFunction_Injector) {
+        if (CpuGenomeDecoder::getNextSubGenomeSize(genome.data(), genomeSize, nodeAddress) > Const::GenomeHeaderSize) {
+            return;
+        }
+    }
+    auto newCellFunctionSize = CpuGenomeDecoder::getCellFunctionDataSize(newCellFunction, makeSelfCopy, Const::GenomeHeaderSize);
+    auto origCellFunctionSize = CpuGenomeDecoder::getNextCellFunctionDataSize(genome.data(), genomeSize, nodeAddress);
+    auto sizeDelta = newCellFunctionSize - origCellFunctionSize;
+
+    if (!parameters.cellFunctionConstructorMutationSelfReplication) {
+        if (CpuGenomeDecoder::containsSectionSelfReplication(genome.data() + nodeAddress, Const::CellBasicBytes + origCellFunctionSize)) {
+            return;
+        }
+    }
+
+    auto targetGenomeSize = genomeSize + sizeDelta;
+    if (targetGenomeSize > MAX_GENOME_BYTES || nodeAddress + Const::CellBasicBytes + origCellFunctionSize > genomeSize) {
+        return;
+    }
+    std::vector<uint8_t> targetGenome(targetGenomeSize);
+    std::copy(genome.begin(), genome.begin() + nodeAddress + Const::CellBasicBytes, targetGenome.begin());
+    CpuGenomeDecoder::setNextCellFunctionType(targetGenome.data(), targetGenomeSize, nodeAddress, newCellFunction);
+    CpuGenomeDecoder::setRandomCellFunctionData(
+        random, targetGenome.data(), targetGenomeSize, nodeAddress + Const::CellBasicBytes, newCellFunction, makeSelfCopy, Const::GenomeHeaderSize);
+    if (newCellFunction == CellFunction_Constructor && !makeSelfCopy) {
+        CpuGenomeDecoder::setNextConstructorSeparation(
+            targetGenome.data(), targetGenomeSize, nodeAddress, false);  //currently no sub-genome with separation property wished
+    }
+    std::copy(genome.begin() + nodeAddress + Const::CellBasicBytes + origCellFunctionSize, genome.end(), targetGenome.begin() + nodeAddress + Const::CellBasicBytes + newCellFunctionSize);
+
+    for (auto const& sizeIndex : subGenomesSizeIndices) {
+        auto subGenomeSize = CpuGenomeDecoder::readWord(genome.data(), genomeSize, sizeIndex);
+        CpuGenomeDecoder::writeWord(targetGenome.data(), targetGenomeSize, sizeIndex, subGenomeSize + sizeDelta);
+    }
+    constructor.genome = std::move(targetGenome);
+}
+
+void CpuMutationProcessor::insertMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    auto const& genome = constructor.genome;
+    auto genomeSize = toInt(genome.size());
+
+    uint8_t prevExecutionNumber = random.randomByte();
+    uint8_t nextExecutionNumber = random.randomByte();
+
+    //calculate addess where the new node should be inserted
+    int nodeAddress = 0;
+    if (random.randomBool() && genomeSize > Const::GenomeHeaderSize) {
+        nodeAddress = getRandomConstructorSubGenomeAddress(random, genome, &prevExecutionNumber);
+    }
+    std::vector<int> subGenomesSizeIndices;
+    nodeAddress = CpuGenomeDecoder::getRandomGenomeNodeAddress(random, genome.data(), genomeSize, true, &subGenomesSizeIndices, nodeAddress);
+    auto numSubGenomesSizeIndices = toInt(subGenomesSizeIndices.size());
+    if (numSubGenomesSizeIndices >= CpuGenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH - 2 || nodeAddress > genomeSize) {
+        return;
+    }
+
+    //insert node
+    auto newColor = cell.properties.color;
+    if (nodeAddress < genomeSize) {
+        newColor = CpuGenomeDecoder::getNextCellColor(genome.data(), genomeSize, nodeAddress);
+        nextExecutionNumber = toUInt8(CpuGenomeDecoder::getNextExecutionNumber(genome.data(), genomeSize, nodeAddress));
+    }
+    auto newCellFunction = random.random(CellFunction_Count - 1);
+    auto makeSelfCopy = parameters.cellFunctionConstructorMutationSelfReplication ? random.randomBool() : false;
+    if (newCellFunction == CellFunction_Injector) {  //not injection mutation allowed at the moment
+        return;
+    }
+    if ((newCellFunction == CellFunction_Constructor || newCellFunction == CellFunction_Injector) && !makeSelfCopy) {
+        if (parameters.cellFunctionConstructorMutationPreventDepthIncrease
+            && CpuGenomeDecoder::getGenomeDepth(genome.data(), genomeSize) <= numSubGenomesSizeIndices) {
+            return;
+        }
+    }
+
+    auto newCellFunctionSize = CpuGenomeDecoder::getCellFunctionDataSize(newCellFunction, makeSelfCopy, Const::GenomeHeaderSize);
+    auto sizeDelta = newCellFunctionSize + Const::CellBasicBytes;
+
+    auto targetGenomeSize = genomeSize + sizeDelta;
+    if (targetGenomeSize > MAX_GENOME_BYTES) {
+        return;
+    }
+    std::vector<uint8_t> targetGenome(targetGenomeSize);
+    std::copy(genome.begin(), genome.begin() + nodeAddress, targetGenome.begin());
+    for (int i = 0; i < Const::CellBasicBytes; ++i) {
+        targetGenome[nodeAddress + i] = random.randomByte();
+    }
+    CpuGenomeDecoder::setNextCellFunctionType(targetGenome.data(), targetGenomeSize, nodeAddress, newCellFunction);
+    CpuGenomeDecoder::setNextCellColor(targetGenome.data(), targetGenomeSize, nodeAddress, newColor);
+    if (random.random() < 0.9f) {  //fitting input execution number should be more often
+        CpuGenomeDecoder::setNextInputExecutionNumber(
+            targetGenome.data(), targetGenomeSize, nodeAddress, random.randomBool() ? prevExecutionNumber : nextExecutionNumber);
+    }
+    if (random.random() < 0.9f) {  //non-blocking output should be more often
+        CpuGenomeDecoder::setNextOutputBlocked(targetGenome.data(), targetGenomeSize, nodeAddress, false);
+    }
+    CpuGenomeDecoder::setRandomCellFunctionData(
+        random, targetGenome.data(), targetGenomeSize, nodeAddress + Const::CellBasicBytes, newCellFunction, makeSelfCopy, Const::GenomeHeaderSize);
+    if (newCellFunction == CellFunction_Constructor && !makeSelfCopy) {
+        CpuGenomeDecoder::setNextConstructorSeparation(
+            targetGenome.data(), targetGenomeSize, nodeAddress, false);  //currently no sub-genome with separation property wished
+        auto numBranches = random.randomBool() ? 1 : random.randomByte();
+        CpuGenomeDecoder::setNextConstructorNumBranches(targetGenome.data(), targetGenomeSize, nodeAddress, numBranches);
+    }
+    std::copy(genome.begin() + nodeAddress, genome.end(), targetGenome.begin() + nodeAddress + sizeDelta);
+
+    for (auto const& sizeIndex : subGenomesSizeIndices) {
+        auto subGenomeSize = CpuGenomeDecoder::readWord(genome.data(), genomeSize, sizeIndex);
+        CpuGenomeDecoder::writeWord(targetGenome.data(), targetGenomeSize, sizeIndex, subGenomeSize + sizeDelta);
+    }
+    constructor.genome = std::move(targetGenome);
+    adaptMutationId(data, constructor);
+}
+
+void CpuMutationProcessor::deleteMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    auto& genome = constructor.genome;
+    auto genomeSize = toInt(genome.size());
+
+    std::vector<int> subGenomesSizeIndices;
+    auto nodeAddress = CpuGenomeDecoder::getRandomGenomeNodeAddress(random, genome.data(), genomeSize, false, &subGenomesSizeIndices);
+
+    auto origCellFunctionSize = CpuGenomeDecoder::getNextCellFunctionDataSize(genome.data(), genomeSize, nodeAddress);
+    auto deleteSize = Const::CellBasicBytes + origCellFunctionSize;
+    if (nodeAddress + deleteSize > genomeSize) {
+        return;
+    }
+
+    if (!parameters.cellFunctionConstructorMutationSelfReplication) {
+        if (CpuGenomeDecoder::containsSectionSelfReplication(genome.data() + nodeAddress, deleteSize)) {
+            return;
+        }
+    }
+
+    genome.erase(genome.begin() + nodeAddress, genome.begin() + nodeAddress + deleteSize);
+    auto targetGenomeSize = toInt(genome.size());
+    for (auto const& sizeIndex : subGenomesSizeIndices) {
+        auto subGenomeSize = CpuGenomeDecoder::readWord(genome.data(), targetGenomeSize, sizeIndex);
+        CpuGenomeDecoder::writeWord(genome.data(), targetGenomeSize, sizeIndex, subGenomeSize - deleteSize);
+    }
+    constructor.genomeCurrentNodeIndex = 0;
+    adaptMutationId(data, constructor);
+}
+
+void CpuMutationProcessor::translateMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    //calc source range
+    auto const& genome = constructor.genome;
+    auto genomeSize = toInt(genome.size());
+    std::vector<int> subGenomesSizeIndices1;
+    auto startSourceIndex = CpuGenomeDecoder::getRandomGenomeNodeAddress(random, genome.data(), genomeSize, false, &subGenomesSizeIndices1);
+
+    auto subGenome = getSubGenome(genome, subGenomesSizeIndices1);
+    auto numCells = CpuGenomeDecoder::getNumNodes(genome.data() + subGenome.address, subGenome.size);
+    auto endRelativeCellIndex = random.random(numCells - 1) + 1;
+    auto endRelativeNodeAddress = CpuGenomeDecoder::getNodeAddress(genome.data() + subGenome.address, subGenome.size, endRelativeCellIndex);
+    auto endSourceIndex = endRelativeNodeAddress + subGenome.address;
+    if (endSourceIndex <= startSourceIndex || endSourceIndex > genomeSize) {
+        return;
+    }
+    auto sourceRangeSize = endSourceIndex - startSourceIndex;
+    if (!parameters.cellFunctionConstructorMutationSelfReplication) {
+        if (CpuGenomeDecoder::containsSectionSelfReplication(genome.data() + startSourceIndex, sourceRangeSize)) {
+            return;
+        }
+    }
+
+    //calc target insertion point
+    std::vector<int> subGenomesSizeIndices2;
+    auto startTargetIndex = CpuGenomeDecoder::getRandomGenomeNodeAddress(random, genome.data(), genomeSize, true, &subGenomesSizeIndices2);
+    auto numSubGenomesSizeIndices2 = toInt(subGenomesSizeIndices2.size());
+
+    if ((startTargetIndex >= startSourceIndex && startTargetIndex <= endSourceIndex) || startTargetIndex > genomeSize) {
+        return;
+    }
+    auto sourceRangeDepth = CpuGenomeDecoder::getGenomeDepth(genome.data() + subGenome.address, subGenome.size);
+    if (parameters.cellFunctionConstructorMutationPreventDepthIncrease) {
+        auto genomeDepth = CpuGenomeDecoder::getGenomeDepth(genome.data(), genomeSize);
+        if (genomeDepth < sourceRangeDepth + numSubGenomesSizeIndices2) {
+            return;
+        }
+    }
+    if (sourceRangeDepth + numSubGenomesSizeIndices2 >= CpuGenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH - 2) {
+        return;
+    }
+
+    std::vector<uint8_t> targetGenome(genomeSize);
+    if (startTargetIndex > endSourceIndex) {
+
+        //copy genome
+        auto targetIt = std::copy(genome.begin(), genome.begin() + startSourceIndex, targetGenome.begin());
+        targetIt = std::copy(genome.begin() + endSourceIndex, genome.begin() + startTargetIndex, targetIt);
+        targetIt = std::copy(genome.begin() + startSourceIndex, genome.begin() + endSourceIndex, targetIt);
+        std::copy(genome.begin() + startTargetIndex, genome.end(), targetIt);
+
+        //adjust sub genome size fields
+        for (auto const& sizeIndex : subGenomesSizeIndices1) {
+            auto subGenomeSize = CpuGenomeDecoder::readWord(targetGenome.data(), genomeSize, sizeIndex);
+            CpuGenomeDecoder::writeWord(targetGenome.data(), genomeSize, sizeIndex, subGenomeSize - sourceRangeSize);
+        }
+        for (auto address : subGenomesSizeIndices2) {
+            if (address >= startSourceIndex) {
+                address -= sourceRangeSize;
+            }
+            auto subGenomeSize = CpuGenomeDecoder::readWord(targetGenome.data(), genomeSize, address);
+            CpuGenomeDecoder::writeWord(targetGenome.data(), genomeSize, address, subGenomeSize + sourceRangeSize);
+        }
+
+    } else {
+
+        //copy genome
+        auto targetIt = std::copy(genome.begin(), genome.begin() + startTargetIndex, targetGenome.begin());
+        targetIt = std::copy(genome.begin() + startSourceIndex, genome.begin() + endSourceIndex, targetIt);
+        targetIt = std::copy(genome.begin() + startTargetIndex, genome.begin() + startSourceIndex, targetIt);
+        std::copy(genome.begin() + endSourceIndex, genome.end(), targetIt);
+
+        //adjust sub genome size fields
+        for (auto address : subGenomesSizeIndices1) {
+            if (address >= startTargetIndex) {
+                address += sourceRangeSize;
+            }
+            auto subGenomeSize = CpuGenomeDecoder::readWord(targetGenome.data(), genomeSize, address);
+            CpuGenomeDecoder::writeWord(targetGenome.data(), genomeSize, address, subGenomeSize - sourceRangeSize);
+        }
+        for (auto const& sizeIndex : subGenomesSizeIndices2) {
+            auto subGenomeSize = CpuGenomeDecoder::readWord(targetGenome.data(), genomeSize, sizeIndex);
+            CpuGenomeDecoder::writeWord(targetGenome.data(), genomeSize, sizeIndex, subGenomeSize + sourceRangeSize);
+        }
+    }
+
+    constructor.genome = std::move(targetGenome);
+    constructor.genomeCurrentNodeIndex = 0;
+    adaptMutationId(data, constructor);
+}
+
+void CpuMutationProcessor::duplicateMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    auto const& genome = constructor.genome;
+    auto genomeSize = toInt(genome.size());
+
+    int startSourceIndex;
+    int endSourceIndex;
+    SubGenome subGenome;
+    {
+        std::vector<int> subGenomesSizeIndices;
+        startSourceIndex = CpuGenomeDecoder::getRandomGenomeNodeAddress(random, genome.data(), genomeSize, false, &subGenomesSizeIndices);
+
+        subGenome = getSubGenome(genome, subGenomesSizeIndices);
+        auto numCells = CpuGenomeDecoder::getNumNodes(genome.data() + subGenome.address, subGenome.size);
+        auto endRelativeCellIndex = random.random(numCells - 1) + 1;
+        auto endRelativeNodeAddress = CpuGenomeDecoder::getNodeAddress(genome.data() + subGenome.address, subGenome.size, endRelativeCellIndex);
+        endSourceIndex = endRelativeNodeAddress + subGenome.address;
+        if (endSourceIndex <= startSourceIndex || endSourceIndex > genomeSize) {
+            return;
+        }
+    }
+    auto sourceRangeSize = endSourceIndex - startSourceIndex;
+    auto sizeDelta = sourceRangeSize;
+    auto nodeAddressForSelfReplication = -1;
+    auto duplicatedSegmentContainsSelfReplicator = false;
+    if (!parameters.cellFunctionConstructorMutationSelfReplication) {
+        nodeAddressForSelfReplication =
+            CpuGenomeDecoder::getNodeAddressForSelfReplication(genome.data() + startSourceIndex, sourceRangeSize, duplicatedSegmentContainsSelfReplicator)
+            + startSourceIndex;
+        if (duplicatedSegmentContainsSelfReplicator) {
+            sizeDelta += 2 + Const::GenomeHeaderSize;  //additional size for empty subgenome
+        }
+    }
+
+    //calculate target addess where the new node should be inserted
+    int startTargetIndex = 0;
+    if (random.randomBool() && genomeSize > Const::GenomeHeaderSize) {
+        startTargetIndex = getRandomConstructorSubGenomeAddress(random, genome);
+    }
+    std::vector<int> subGenomesSizeIndices;
+    startTargetIndex = CpuGenomeDecoder::getRandomGenomeNodeAddress(random, genome.data(), genomeSize, true, &subGenomesSizeIndices, startTargetIndex);
+    auto numSubGenomesSizeIndices = toInt(subGenomesSizeIndices.size());
+
+    auto targetGenomeSize = genomeSize + sizeDelta;
+    if (targetGenomeSize > MAX_GENOME_BYTES || startTargetIndex > genomeSize) {
+        return;
+    }
+
+    auto sourceRangeDepth = CpuGenomeDecoder::getGenomeDepth(genome.data() + subGenome.address, subGenome.size);
+    if (parameters.cellFunctionConstructorMutationPreventDepthIncrease) {
+        auto genomeDepth = CpuGenomeDecoder::getGenomeDepth(genome.data(), genomeSize);
+        if (genomeDepth < sourceRangeDepth + numSubGenomesSizeIndices) {
+            return;
+        }
+    }
+    if (sourceRangeDepth + numSubGenomesSizeIndices >= CpuGenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH - 2) {
+        return;
+    }
+
+    std::vector<uint8_t> targetGenome(targetGenomeSize);
+
+    //copy segment before duplication
+    std::copy(genome.begin(), genome.begin() + startTargetIndex, targetGenome.begin());
+
+    //copy segment for duplication
+    if (!duplicatedSegmentContainsSelfReplicator) {
+        std::copy(genome.begin() + startSourceIndex, genome.begin() + endSourceIndex, targetGenome.begin() + startTargetIndex);
+    } else {
+        auto nodeSize = Const::CellBasicBytes + CpuGenomeDecoder::getNextCellFunctionDataSize(genome.data(), genomeSize, nodeAddressForSelfReplication);
+        auto endOfSelfReplicator = std::min(nodeAddressForSelfReplication + nodeSize, endSourceIndex);
+        std::copy(genome.begin() + startSourceIndex, genome.begin() + endOfSelfReplicator, targetGenome.begin() + startTargetIndex);
+
+        //make construction non-self-replicating + insert empty subgenome
+        auto targetNodeAddress = startTargetIndex + nodeAddressForSelfReplication - startSourceIndex;
+        CpuGenomeDecoder::setNextCellSelfReplication(targetGenome.data(), targetGenomeSize, targetNodeAddress, false);
+        CpuGenomeDecoder::setNextCellSubgenomeSize(targetGenome.data(), targetGenomeSize, targetNodeAddress, Const::GenomeHeaderSize);
+
+        auto const emptySubgenomeSize = 2 + Const::GenomeHeaderSize;
+        std::copy(
+            genome.begin() + endOfSelfReplicator,
+            genome.begin() + endSourceIndex,
+            targetGenome.begin() + startTargetIndex + (endOfSelfReplicator - startSourceIndex) + emptySubgenomeSize);
+    }
+
+    //copy segment after duplication
+    std::copy(genome.begin() + startTargetIndex, genome.end(), targetGenome.begin() + startTargetIndex + sizeDelta);
+
+    for (auto const& sizeIndex : subGenomesSizeIndices) {
+        auto subGenomeSize = CpuGenomeDecoder::readWord(targetGenome.data(), targetGenomeSize, sizeIndex);
+        CpuGenomeDecoder::writeWord(targetGenome.data(), targetGenomeSize, sizeIndex, subGenomeSize + sizeDelta);
+    }
+    constructor.genome = std::move(targetGenome);
+    adaptMutationId(data, constructor);
+}
+
+void CpuMutationProcessor::cellColorMutation(SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    auto genome = constructor.genome.data();
+    auto genomeSize = toInt(constructor.genome.size());
+    auto numNodes = CpuGenomeDecoder::getNumNodesRecursively(genome, genomeSize, false, true);
+    auto randomNode = random.random(numNodes - 1);
+    auto sequenceNumber = 0;
+    CpuGenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) {
+        if (sequenceNumber++ != randomNode) {
+            return;
+        }
+        auto origColor = CpuGenomeDecoder::getNextCellColor(genome, genomeSize, nodeAddress);
+        auto newColor = getNewColorFromTransition(parameters, random, origColor);
+        if (newColor == -1) {
+            return;
+        }
+        CpuGenomeDecoder::setNextCellColor(genome, genomeSize, nodeAddress, newColor);
+    });
+}
+
+void CpuMutationProcessor::subgenomeColorMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    auto genome = constructor.genome.data();
+    auto genomeSize = toInt(constructor.genome.size());
+
+    std::vector<int> subGenomesSizeIndices;
+    CpuGenomeDecoder::getRandomGenomeNodeAddress(random, genome, genomeSize, false, &subGenomesSizeIndices);  //return value will be discarded
+
+    auto subGenomeRange = getSubGenome(constructor.genome, subGenomesSizeIndices);
+    auto subGenome = genome + subGenomeRange.address;
+    auto subGenomeSize = subGenomeRange.size;
+    int nodeAddress = Const::GenomeHeaderSize;
+
+    auto origColor = CpuGenomeDecoder::getNextCellColor(subGenome, subGenomeSize, nodeAddress);
+    auto newColor = getNewColorFromTransition(parameters, random, origColor);
+    if (newColor == -1) {
+        return;
+    }
+    if (origColor != newColor) {
+        adaptMutationId(data, constructor);
+    }
+
+    while (nodeAddress < subGenomeSize) {
+        CpuGenomeDecoder::setNextCellColor(subGenome, subGenomeSize, nodeAddress, newColor);
+        nodeAddress += Const::CellBasicBytes + CpuGenomeDecoder::getNextCellFunctionDataSize(subGenome, subGenomeSize, nodeAddress);
+    }
+}
+
+void CpuMutationProcessor::genomeColorMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell)
+{
+    auto& constructor = getConstructor(cell);
+    if (CpuGenomeDecoder::hasEmptyGenome(constructor)) {
+        return;
+    }
+
+    auto genome = constructor.genome.data();
+    auto genomeSize = toInt(constructor.genome.size());
+
+    auto origColor = CpuGenomeDecoder::getNextCellColor(genome, genomeSize, Const::GenomeHeaderSize);
+    auto newColor = getNewColorFromTransition(parameters, random, origColor);
+    if (newColor == -1) {
+        return;
+    }
+    if (origColor != newColor) {
+        adaptMutationId(data, constructor);
+    }
+
+    CpuGenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) {
+        CpuGenomeDecoder::setNextCellColor(genome, genomeSize, nodeAddress, newColor);
+    });
+}
+
+auto CpuMutationProcessor::getSubGenome(std::vector<uint8_t> const& genome, std::vector<int> const& subGenomesSizeIndices) -> SubGenome
+{
+    auto genomeSize = toInt(genome.size());
+    if (subGenomesSizeIndices.empty()) {
+        return SubGenome{0, genomeSize};
+    }
+    auto sizeIndex = subGenomesSizeIndices.back();
+    auto address = std::min(sizeIndex + 2, genomeSize);  //after the 2 size bytes the sub-genome starts
+    auto size = std::min(CpuGenomeDecoder::readWord(genome.data(), genomeSize, sizeIndex), genomeSize - address);
+    return SubGenome{address, size};
+}
+
+int CpuMutationProcessor::getRandomConstructorSubGenomeAddress(CpuRandom& random, std::vector<uint8_t> const& genome, uint8_t* executionNumber)
+{
+    auto genomeSize = toInt(genome.size());
+    auto isConstructorWithSubGenome = [&](int nodeAddress) {
+        return CpuGenomeDecoder::getNextCellFunctionType(genome.data(), genomeSize, nodeAddress) == CellFunction_Constructor
+            && !CpuGenomeDecoder::isNextCellSelfReplication(genome.data(), genomeSize, nodeAddress);
+    };
+
+    int numConstructorsWithSubgenome = 0;
+    CpuGenomeDecoder::executeForEachNodeRecursively(genome.data(), genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) {
+        if (isConstructorWithSubGenome(nodeAddress)) {
+            ++numConstructorsWithSubgenome;
+        }
+    });
+    if (numConstructorsWithSubgenome == 0) {
+        return 0;
+    }
+
+    int result = 0;
+    auto randomIndex = random.random(numConstructorsWithSubgenome - 1);
+    auto counter = 0;
+    CpuGenomeDecoder::executeForEachNodeRecursively(genome.data(), genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) {
+        if (isConstructorWithSubGenome(nodeAddress)) {
+            if (randomIndex == counter) {
+                result = nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes + 3 + 1;
+                if (executionNumber) {
+                    *executionNumber = CpuGenomeDecoder::getByte(genome.data(), genomeSize, nodeAddress + Const::CellExecutionNumberPos);
+                }
+            }
+            ++counter;
+        }
+    });
+    return result;
+}
+
+void CpuMutationProcessor::adaptMutationId(CpuSimulationData& data, ConstructorDescription& constructor)
+{
+    if (CpuGenomeDecoder::containsSelfReplication(constructor.genome)) {
+        constructor.offspringMutationId = toInt(data.createNewSmallId());
+    }
+}
+
+bool CpuMutationProcessor::isRandomEvent(CpuRandom& random, float probability)
+{
+    if (probability > 0.001f) {
+        return random.random() < probability;
+    } else {
+        return random.random() < probability * 1000 && random.random() < 0.001f;
+    }
+}
+
+int CpuMutationProcessor::getNewColorFromTransition(SimulationParameters const& parameters, CpuRandom& random, int origColor)
+{
+    int numAllowedColors = 0;
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        if (parameters.cellFunctionConstructorMutationColorTransitions[origColor][i]) {
+            ++numAllowedColors;
+        }
+    }
+    if (numAllowedColors == 0) {
+        return -1;
+    }
+    int randomAllowedColorIndex = random.random(numAllowedColors - 1);
+    int allowedColorIndex = 0;
+    int result = 0;
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        if (parameters.cellFunctionConstructorMutationColorTransitions[origColor][i]) {
+            if (allowedColorIndex == randomAllowedColorIndex) {
+                result = i;
+                break;
+            }
+            ++allowedColorIndex;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+
+#include "EngineInterface/MutationType.h"
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CpuObjects.h"
+#include "CpuRandom.h"
+#include "Definitions.h"
+
+//counterpart of MutationProcessor on the GPU
+//the genome of a constructor is replaced by a new vector for mutations changing its size
+class CpuMutationProcessor
+{
+public:
+    static void applyRandomMutations(CpuSimulationData& data, SimulationParameters const& parameters, uint64_t seed, uint64_t timestep);
+    static void applyMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell, MutationType mutationType);
+
+private:
+    static void applyRandomMutationsForCell(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell);
+
+    static void neuronDataMutation(CpuRandom& random, CpuCell& cell);
+    static void propertiesMutation(CpuRandom& random, CpuCell& cell);
+    static void geometryMutation(CpuSimulationData& data, CpuRandom& random, CpuCell& cell);
+    static void customGeometryMutation(CpuRandom& random, CpuCell& cell);
+    static void cellFunctionMutation(SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell);
+    static void insertMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell);
+    static void deleteMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell);
+    static void translateMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell);
+    static void duplicateMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell);
+    static void cellColorMutation(SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell);
+    static void subgenomeColorMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell);
+    static void genomeColorMutation(CpuSimulationData& data, SimulationParameters const& parameters, CpuRandom& random, CpuCell& cell);
+
+    struct SubGenome
+    {
+        int address = 0;
+        int size = 0;
+    };
+    //returns the sub-genome belonging to the last size index, its size is limited to the genome bounds
+    static SubGenome getSubGenome(std::vector<uint8_t> const& genome, std::vector<int> const& subGenomesSizeIndices);
+    //returns a position inside the sub-genome of a random constructor which is not a self-copy (or 0 if there is none) and optionally its execution number
+    static int getRandomConstructorSubGenomeAddress(CpuRandom& random, std::vector<uint8_t> const& genome, uint8_t* executionNumber = nullptr);
+
+    template <typename Func>
+    static void executeEvent(CpuRandom& random, float probability, Func const& eventFunc);
+    template <typename Func>
+    static void executeMultipleEvents(CpuRandom& random, float probability, Func const& eventFunc);
+    static void adaptMutationId(CpuSimulationData& data, ConstructorDescription& constructor);
+    static bool isRandomEvent(CpuRandom& random, float probability);
+    static int getNewColorFromTransition(SimulationParameters const& parameters, CpuRandom& random, int origColor);
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+void CpuMutationProcessor::executeEvent(CpuRandom& random, float probability, Func const& eventFunc)
+{
+    if (isRandomEvent(random, probability)) {
+        eventFunc();
+    }
+}
+
+template <typename Func>
+void CpuMutationProcessor::executeMultipleEvents(CpuRandom& random, float probability, Func const& eventFunc)
+{
+    for (int i = 0, j = toInt(probability); i < j; ++i) {
+        eventFunc();
+    }
+    if (isRandomEvent(random, probability)) {
+        eventFunc();
+    }
+}
@@ -0,0 +1,63 @@
+#include "CpuObjects.h"
+
+#include "EngineInterface/GenomeDescriptionService.h"
+
+auto CpuCell::getGenomeInfo() -> GenomeInfo const&
+{
+    if (!genomeInfo) {
+        genomeInfo = GenomeInfo();
+        if (properties.hasGenome()) {
+            auto const& genome = properties.getGenomeRef();
+            for (auto const& node : GenomeDescriptionService::convertBytesToDescription(genome).cells) {
+                if (node.isMakeGenomeCopy().value_or(false)) {
+                    genomeInfo->selfReplicating = true;
+                    break;
+                }
+            }
+            genomeInfo->numNodes = GenomeDescriptionService::getNumNodesRecursively(genome, true);
+        }
+    }
+    return *genomeInfo;
+}
+
+void CpuSimulationData::compact()
+{
+    std::vector<int> newIndices(cells.size(), -1);
+    int numRemainingCells = 0;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        if (!cells[i].deleted) {
+            newIndices[i] = numRemainingCells++;
+        }
+    }
+    if (numRemainingCells != toInt(cells.size())) {
+        std::vector<CpuCell> remainingCells;
+        remainingCells.reserve(numRemainingCells);
+        for (auto& cell : cells) {
+            if (cell.deleted) {
+                continue;
+            }
+            int numConnections = 0;
+            float angleOffset = 0;
+            for (int i = 0; i < cell.numConnections; ++i) {
+                auto connection = cell.connections[i];
+                auto newIndex = newIndices[connection.cellIndex];
+                if (newIndex == -1) {
+                    angleOffset += connection.angleFromPrevious;
+                    continue;
+                }
+                connection.cellIndex = newIndex;
+                connection.angleFromPrevious += angleOffset;
+                angleOffset = 0;
+                cell.connections[numConnections++] = connection;
+            }
+            if (angleOffset != 0 && numConnections > 0) {
+                cell.connections[0].angleFromPrevious += angleOffset;
+            }
+            cell.numConnections = numConnections;
+            remainingCells.emplace_back(std::move(cell));
+        }
+        cells = std::move(remainingCells);
+    }
+
+    std::erase_if(particles, [](CpuParticle const& particle) { return particle.deleted; });
+}
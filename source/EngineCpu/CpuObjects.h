@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/EngineConstants.h"
+
+#include "Definitions.h"
+
+struct CpuConnection
+{
+    int cellIndex = -1;
+    float distance = 0;
+    float angleFromPrevious = 0;
+};
+
+struct CpuCell
+{
+    CellDescription properties;     //connections are held in 'connections', properties.connections is always empty
+    std::array<CpuConnection, MAX_CELL_BONDS> connections;
+    int numConnections = 0;
+
+    //temporary data during a time step (corresponds to shared1/shared2 on the GPU)
+    RealVector2D force;
+    RealVector2D prevForce;
+    float density = 1.0f;
+    bool constructorComplete = false;   //result of the completeness check before self-replication (corresponds to constructor.isComplete on the GPU)
+
+    uint8_t selected = 0;   //0 = no, 1 = selected, 2 = cluster selected
+    uint8_t detached = 0;
+    bool deleted = false;
+
+    //genome information of constructors and injectors, decoded on first access
+    struct GenomeInfo
+    {
+        bool selfReplicating = false;
+        int numNodes = 0;
+    };
+    std::optional<GenomeInfo> genomeInfo;
+    GenomeInfo const& getGenomeInfo();
+
+    int getInputExecutionOrderNumber() const { return properties.inputExecutionOrderNumber.value_or(-1); }
+    bool isConnectedTo(int cellIndex) const
+    {
+        for (int i = 0; i < numConnections; ++i) {
+            if (connections[i].cellIndex == cellIndex) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+struct CpuParticle
+{
+    ParticleDescription properties;
+    uint64_t lastAbsorbedCellId = 0;
+    uint8_t selected = 0;
+    bool deleted = false;
+};
+
+struct CpuSimulationData
+{
+    std::vector<CpuCell> cells;
+    std::vector<CpuParticle> particles;
+
+    uint64_t timestep = 0;
+    uint64_t currentId = 1;
+    uint32_t currentSmallId = 1;  //used for mutation ids
+
+    uint64_t createNewId() { return currentId++; }
+    void adaptMaxId(uint64_t id) { currentId = std::max(currentId, id + 1); }
+    uint32_t createNewSmallId() { return currentSmallId++; }
+    void adaptMaxSmallId(uint32_t id) { currentSmallId = std::max(currentSmallId, id + 1); }
+
+    //removes deleted objects and remaps the connection indices
+    void compact();
+};
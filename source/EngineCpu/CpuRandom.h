@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Base/Definitions.h"
+
+using CpuRandomStage = int;
+enum CpuRandomStage_
+{
+    CpuRandomStage_Radiation,
+    CpuRandomStage_CheckForces,
+    CpuRandomStage_ParticleSplitting,
+    CpuRandomStage_Decay,
+    CpuRandomStage_CellDeletion,
+    CpuRandomStage_ParticleTransformation,
+    CpuRandomStage_Mutation,
+    CpuRandomStage_Constructor,
+    CpuRandomStage_Attacker,
+    CpuRandomStage_Detonator
+};
+
+//counter-based random numbers: the sequence only depends on the seed, the time step, the processing stage and the object index,
+//so that the result of a time step does not depend on how the objects are distributed to the threads
+//the value ranges correspond to CudaNumberGenerator
+class CpuRandom
+{
+public:
+    CpuRandom(uint64_t seed, uint64_t timestep, int stage, uint64_t index)
+        : _state(mix(seed ^ mix(timestep ^ mix(static_cast<uint64_t>(stage) ^ mix(index)))))
+    {}
+
+    //in [0, 1)
+    float random() { return toFloat(next() >> 40) / toFloat(1 << 24); }
+    float random(float maxValue) { return random() * maxValue; }
+    float random(float minValue, float maxValue) { return minValue + random() * (maxValue - minValue); }
+
+    //in [0, maxValue]
+    int random(int maxValue) { return toInt(next() % (static_cast<uint64_t>(maxValue) + 1)); }
+    bool randomBool() { return random(1) == 0; }
+    uint8_t randomByte() { return static_cast<uint8_t>(random(255)); }
+
+private:
+    uint64_t next()
+    {
+        _state += 0x9e3779b97f4a7c15ull;
+        return mix(_state);
+    }
+
+    static uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t _state;
+};
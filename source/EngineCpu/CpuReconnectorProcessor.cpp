@@ -0,0 +1,106 @@
+#include "CpuReconnectorProcessor.h"
+
+#include <algorithm>
+
+#include "CpuConnectionService.h"
+
+void CpuReconnectorProcessor::process(CpuCellFunctionData& data, AccumulatedStatistics& statistics)
+{
+    for (auto const& cellIndex : data.cellFunctionOperations[CellFunction_Reconnector]) {
+        processCell(data, statistics, cellIndex);
+    }
+}
+
+void CpuReconnectorProcessor::processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex)
+{
+    auto& cells = data.data.cells;
+    auto activity = CpuCellFunctionProcessor::calcInputActivity(cells, cells[cellIndex], data.parameters);
+    CpuCellFunctionProcessor::updateInvocationState(cells[cellIndex], activity);
+
+    if (activity.channels[0] >= data.parameters.cellFunctionReconnectorActivityThreshold) {
+        tryCreateConnection(data, statistics, cellIndex, activity);
+    } else if (activity.channels[0] <= -data.parameters.cellFunctionReconnectorActivityThreshold) {
+        removeConnections(data, statistics, cellIndex, activity);
+    }
+    CpuCellFunctionProcessor::setActivity(cells[cellIndex], activity);
+}
+
+void CpuReconnectorProcessor::tryCreateConnection(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription& activity)
+{
+    auto& cells = data.data.cells;
+    auto& cell = cells[cellIndex];
+    auto const& properties = cell.properties;
+    auto const& reconnector = CpuCellFunctionProcessor::getCellFunction<ReconnectorDescription>(cell);
+    int closestCellIndex = -1;
+    float closestDistance = 0;
+    CpuCellFunctionProcessor::forEachCell(
+        data, properties.pos, data.parameters.cellFunctionReconnectorRadius[properties.color], cell.detached, [&](int otherIndex) {
+            auto const& otherProperties = cells[otherIndex].properties;
+            if (properties.creatureId != 0 && otherProperties.creatureId == properties.creatureId) {
+                return;
+            }
+            if (otherProperties.barrier) {
+                return;
+            }
+            if (reconnector.restrictToColor && otherProperties.color != *reconnector.restrictToColor) {
+                return;
+            }
+            if (reconnector.restrictToMutants == ReconnectorRestrictToMutants_RestrictToSameMutants && otherProperties.mutationId != properties.mutationId) {
+                return;
+            }
+            if (reconnector.restrictToMutants == ReconnectorRestrictToMutants_RestrictToOtherMutants
+                && (otherProperties.mutationId == properties.mutationId || otherProperties.mutationId == 0 || otherProperties.mutationId == 1)) {
+                return;
+            }
+            if (reconnector.restrictToMutants == ReconnectorRestrictToMutants_RestrictToHandcraftedCells && otherProperties.mutationId != 0) {
+                return;
+            }
+            if (reconnector.restrictToMutants == ReconnectorRestrictToMutants_RestrictToFreeCells && otherProperties.mutationId != 1) {
+                return;
+            }
+            if (reconnector.restrictToMutants == ReconnectorRestrictToMutants_RestrictToLessComplexMutants
+                && otherProperties.genomeComplexity >= properties.genomeComplexity) {
+                return;
+            }
+            if (reconnector.restrictToMutants == ReconnectorRestrictToMutants_RestrictToMoreComplexMutants
+                && otherProperties.genomeComplexity <= properties.genomeComplexity) {
+                return;
+            }
+            if (CpuConnectionService::isConnectedConnected(cells, cellIndex, otherIndex)) {
+                return;
+            }
+            auto distance = data.spaceCalculator.distance(properties.pos, otherProperties.pos);
+            if (closestCellIndex == -1 || distance < closestDistance) {
+                closestCellIndex = otherIndex;
+                closestDistance = distance;
+            }
+        });
+
+    activity.channels[0] = 0;
+    if (closestCellIndex != -1) {
+        auto& closestCell = cells[closestCellIndex];
+        if (cell.numConnections < MAX_CELL_BONDS && closestCell.numConnections < MAX_CELL_BONDS) {
+            closestCell.properties.maxConnections = std::min(std::max(closestCell.properties.maxConnections, closestCell.numConnections + 1), MAX_CELL_BONDS);
+            cell.properties.maxConnections = std::min(std::max(cell.properties.maxConnections, cell.numConnections + 1), MAX_CELL_BONDS);
+            data.addConnectionPairs.emplace_back(cellIndex, closestCellIndex);
+            activity.channels[0] = 1;
+            ++statistics.numReconnectorCreated[cell.properties.color];
+        }
+    }
+}
+
+void CpuReconnectorProcessor::removeConnections(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription& activity)
+{
+    auto& cells = data.data.cells;
+    auto const& cell = cells[cellIndex];
+    activity.channels[0] = 0;
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto connectedCellIndex = cell.connections[i].cellIndex;
+        if (cells[connectedCellIndex].properties.creatureId != cell.properties.creatureId) {
+            data.deleteConnections.emplace_back(cellIndex, connectedCellIndex);
+            data.deleteConnections.emplace_back(connectedCellIndex, cellIndex);
+            activity.channels[0] = 1;
+            ++statistics.numReconnectorRemoved[cell.properties.color];
+        }
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CpuCellFunctionProcessor.h"
+
+//counterpart of ReconnectorProcessor on the GPU
+class CpuReconnectorProcessor
+{
+public:
+    static void process(CpuCellFunctionData& data, AccumulatedStatistics& statistics);
+
+private:
+    static void processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex);
+
+    static void tryCreateConnection(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription& activity);
+    static void removeConnections(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription& activity);
+};
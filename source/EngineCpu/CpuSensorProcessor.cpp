@@ -0,0 +1,230 @@
+#include "CpuSensorProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Math.h"
+
+void CpuSensorProcessor::process(CpuCellFunctionData& data, AccumulatedStatistics& statistics)
+{
+    for (auto const& cellIndex : data.cellFunctionOperations[CellFunction_Sensor]) {
+        processCell(data, statistics, cellIndex);
+    }
+}
+
+void CpuSensorProcessor::processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex)
+{
+    auto& cells = data.data.cells;
+    auto activity = CpuCellFunctionProcessor::calcInputActivity(cells, cells[cellIndex], data.parameters);
+    CpuCellFunctionProcessor::updateInvocationState(cells[cellIndex], activity);
+
+    if (std::abs(activity.channels[0]) > data.parameters.cellFunctionSensorActivityThreshold) {
+        auto const& cell = cells[cellIndex];
+        ++statistics.numSensorActivities[cell.properties.color];
+        switch (CpuCellFunctionProcessor::getCellFunction<SensorDescription>(cells[cellIndex]).getSensorMode()) {
+        case SensorMode_Neighborhood: {
+            searchNeighborhood(data, statistics, cellIndex, activity);
+            activity.origin = ActivityOrigin_Sensor;
+        } break;
+        }
+    }
+
+    CpuCellFunctionProcessor::setActivity(cells[cellIndex], activity);
+}
+
+uint32_t CpuSensorProcessor::getCellDensity(
+    uint64_t timestep,
+    CpuCell const& cell,
+    uint8_t restrictToColor,
+    SensorRestrictToMutants restrictToMutants,
+    CpuDensityMap const& densityMap,
+    RealVector2D const& scanPos)
+{
+    uint32_t result = 0;
+    auto mutationId = static_cast<uint32_t>(cell.properties.mutationId);
+    if (restrictToMutants == SensorRestrictToMutants_NoRestriction) {
+        if (restrictToColor == 255) {
+            result = densityMap.getCellDensity(scanPos);
+        }
+        if (restrictToColor != 255) {
+            result = densityMap.getColorDensity(scanPos, restrictToColor);
+        }
+    } else {
+        if (restrictToMutants == SensorRestrictToMutants_RestrictToSameMutants) {
+            result = densityMap.getSameMutantDensity(scanPos, mutationId);
+        }
+        if (restrictToMutants == SensorRestrictToMutants_RestrictToOtherMutants) {
+            result = densityMap.getOtherMutantDensity(timestep, scanPos, mutationId);
+        }
+        if (restrictToMutants == SensorRestrictToMutants_RestrictToFreeCells) {
+            result = densityMap.getEmergentCellDensity(scanPos);
+        }
+        if (restrictToMutants == SensorRestrictToMutants_RestrictToHandcraftedCells) {
+            result = densityMap.getZeroMutantDensity(scanPos);
+        }
+        if (restrictToMutants == SensorRestrictToMutants_RestrictToLessComplexMutants) {
+            result = densityMap.getLessComplexMutantDensity(scanPos, cell.properties.genomeComplexity);
+        }
+        if (restrictToMutants == SensorRestrictToMutants_RestrictToMoreComplexMutants) {
+            result = densityMap.getMoreComplexMutantDensity(scanPos, cell.properties.genomeComplexity);
+        }
+        if (restrictToColor != 255) {
+            result = std::min(result, densityMap.getColorDensity(scanPos, restrictToColor));
+        }
+    }
+    return result;
+}
+
+void CpuSensorProcessor::searchNeighborhood(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription& activity)
+{
+    auto& cell = data.data.cells[cellIndex];
+    auto& sensor = CpuCellFunctionProcessor::getCellFunction<SensorDescription>(cell);
+    auto const& parameters = data.parameters;
+
+    auto refScanAngle = Math::angleOfVector(CpuCellFunctionProcessor::calcSignalDirection(data, cellIndex));
+    auto minDensity = static_cast<uint32_t>(toInt(sensor.minDensity * 100));
+    auto minRange = sensor.minRange.value_or(-1);
+    auto restrictToColor = static_cast<uint8_t>(sensor.restrictToColor.value_or(255));
+    auto restrictToMutants = sensor.restrictToMutants;
+    uint64_t lookupResult = 0xffffffffffffffff;
+    std::array<bool, NumScanAngles> blockedByWall = {};
+
+    auto const startRadius = calcStartDistanceForScanning(restrictToColor, restrictToMutants, cell.properties.color);
+    auto const& densityMap = data.densityMap;
+
+    auto maxRange = parameters.cellFunctionSensorRange[cell.properties.color];
+    if (sensor.maxRange.value_or(-1) >= 0) {
+        maxRange = std::min(maxRange, toFloat(*sensor.maxRange));
+    }
+    for (float radius = startRadius; radius <= maxRange; radius += ScanStep) {
+        if (minRange < 0 || minRange <= radius) {
+            for (int angleIndex = 0; angleIndex < NumScanAngles; ++angleIndex) {
+                float angle = 360.0f / NumScanAngles * toFloat(angleIndex);
+
+                auto delta = Math::unitVectorOfAngle(angle) * radius;
+                auto scanPos = data.spaceCalculator.getCorrectedPosition(cell.properties.pos + delta);
+
+                uint32_t density = 0;
+                if (!blockedByWall[angleIndex]) {
+                    if (restrictToMutants == SensorRestrictToMutants_NoRestriction || restrictToMutants == SensorRestrictToMutants_RestrictToHandcraftedCells
+                        || densityMap.getZeroMutantDensity(scanPos) == 0) {
+                        density = getCellDensity(data.timestep, cell, restrictToColor, restrictToMutants, densityMap, scanPos);
+                    } else {
+                        blockedByWall[angleIndex] = true;
+                    }
+                }
+                if (density < minDensity) {
+                    continue;
+                }
+                auto relAngle = Math::subtractAngle(angle, refScanAngle);
+                uint32_t relAngleData = convertAngleToData(relAngle);
+                uint64_t combined = static_cast<uint64_t>(radius) << 48 | static_cast<uint64_t>(density) << 40 | static_cast<uint64_t>(relAngleData) << 32;
+                lookupResult = std::min(lookupResult, combined);
+            }
+        }
+    }
+
+    if (lookupResult != 0xffffffffffffffff) {
+        auto angle = convertDataToAngle(static_cast<uint8_t>((lookupResult >> 32) & 0xff));
+        auto distance = toFloat(lookupResult >> 48);
+        auto scanAngle = refScanAngle + angle;
+        auto scanPos = cell.properties.pos + Math::unitVectorOfAngle(scanAngle) * distance;
+        flagDetectedCells(data, cellIndex, scanPos);
+
+        activity.channels[0] = 1;                                                       //something found
+        activity.channels[1] = toFloat((lookupResult >> 40) & 0xff) / 256;              //density
+        activity.channels[2] = 1.0f - std::min(1.0f, distance / 256);                   //distance: 1 = close, 0 = far away
+
+        auto legacyMode_unrestrictedMovements = !parameters.cellFunctionMuscleMovementTowardTargetedObject;
+        activity.channels[3] = legacyMode_unrestrictedMovements ? angle / 360.0f : 0;  //angle: between -0.5 and 0.5
+        sensor.memoryChannel1 = activity.channels[1];
+        sensor.memoryChannel2 = activity.channels[2];
+        sensor.memoryChannel3 = activity.channels[3];
+        ++statistics.numSensorMatches[cell.properties.color];
+        auto delta = data.spaceCalculator.getCorrectedDirection(scanPos - cell.properties.pos);
+        activity.targetX = delta.x;
+        activity.targetY = delta.y;
+        sensor.memoryTargetX = delta.x;
+        sensor.memoryTargetY = delta.y;
+    } else {
+        activity.channels[0] = 0;  //nothing found
+        activity.targetX = 0;
+        activity.targetY = 0;
+    }
+}
+
+void CpuSensorProcessor::flagDetectedCells(CpuCellFunctionData& data, int cellIndex, RealVector2D const& scanPos)
+{
+    auto& cells = data.data.cells;
+    auto const& properties = cells[cellIndex].properties;
+    auto const& sensor = std::get<SensorDescription>(*properties.cellFunction);
+    auto const& restrictToColor = sensor.restrictToColor;
+    auto const& restrictToMutants = sensor.restrictToMutants;
+
+    for (float dx = -3.0f; dx < 3.0f + NEAR_ZERO; dx += 1.0f) {
+        for (float dy = -3.0f; dy < 3.0f + NEAR_ZERO; dy += 1.0f) {
+            auto otherCellIndex = CpuCellFunctionProcessor::getFirstCellInSlot(data, scanPos + RealVector2D{dx, dy});
+            if (otherCellIndex == -1 || otherCellIndex == cellIndex) {
+                continue;
+            }
+            auto& otherProperties = cells[otherCellIndex].properties;
+            if (restrictToColor && otherProperties.color != *restrictToColor) {
+                continue;
+            }
+            if (restrictToMutants == SensorRestrictToMutants_RestrictToSameMutants && properties.mutationId != otherProperties.mutationId) {
+                continue;
+            }
+            if (restrictToMutants == SensorRestrictToMutants_RestrictToOtherMutants
+                && (properties.mutationId == otherProperties.mutationId || otherProperties.mutationId == 0 || otherProperties.mutationId == 1
+                    || static_cast<uint8_t>(properties.mutationId & 0xff) == otherProperties.ancestorMutationId)) {
+                continue;
+            }
+            if (restrictToMutants == SensorRestrictToMutants_RestrictToFreeCells && otherProperties.mutationId != 1) {
+                continue;
+            }
+            if (restrictToMutants == SensorRestrictToMutants_RestrictToHandcraftedCells && otherProperties.mutationId != 0) {
+                continue;
+            }
+            if (restrictToMutants == SensorRestrictToMutants_RestrictToLessComplexMutants
+                && (otherProperties.genomeComplexity >= properties.genomeComplexity || otherProperties.mutationId == 0 || otherProperties.mutationId == 1)) {
+                continue;
+            }
+            if (restrictToMutants == SensorRestrictToMutants_RestrictToMoreComplexMutants
+                && (otherProperties.genomeComplexity <= properties.genomeComplexity || otherProperties.mutationId == 0 || otherProperties.mutationId == 1)) {
+                continue;
+            }
+            otherProperties.detectedByCreatureId = static_cast<uint16_t>(properties.creatureId & 0xffff);
+        }
+    }
+}
+
+float CpuSensorProcessor::calcStartDistanceForScanning(uint8_t restrictToColor, SensorRestrictToMutants restrictToMutants, int color)
+{
+    return (restrictToColor == 255 || restrictToColor == color)
+            && (restrictToMutants == SensorRestrictToMutants_NoRestriction || restrictToMutants == SensorRestrictToMutants_RestrictToSameMutants)
+        ? 14.0f
+        : 0.0f;
+}
+
+uint8_t CpuSensorProcessor::convertAngleToData(float angle)
+{
+    //0 to 180 degree => 0 to 128
+    //-180 to 0 degree => 128 to 256 (= 0)
+    angle = std::remainder(std::remainder(angle, 360.0f) + 360.0f, 360.0f);  //get angle between 0 and 360
+    if (angle > 180.0f) {
+        angle -= 360.0f;
+    }
+    int result = static_cast<int>(angle * 128.0f / 180.0f);
+    return static_cast<uint8_t>(result);
+}
+
+float CpuSensorProcessor::convertDataToAngle(uint8_t b)
+{
+    //0 to 127 => 0 to 179 degree
+    //128 to 255 => -179 to 0 degree
+    if (b < 128) {
+        return (0.5f + static_cast<float>(b)) * (180.0f / 128.0f);
+    } else {
+        return (-256.0f - 0.5f + static_cast<float>(b)) * (180.0f / 128.0f);
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CpuCellFunctionProcessor.h"
+#include "CpuDensityMap.h"
+
+//counterpart of SensorProcessor on the GPU (the fixed angle mode is not executed on the GPU either)
+class CpuSensorProcessor
+{
+public:
+    static void process(CpuCellFunctionData& data, AccumulatedStatistics& statistics);
+
+private:
+    static int constexpr NumScanAngles = 64;
+    static float constexpr ScanStep = 8.0f;
+
+    static void processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex);
+    static uint32_t getCellDensity(
+        uint64_t timestep,
+        CpuCell const& cell,
+        uint8_t restrictToColor,
+        SensorRestrictToMutants restrictToMutants,
+        CpuDensityMap const& densityMap,
+        RealVector2D const& scanPos);
+    static void searchNeighborhood(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex, ActivityDescription& activity);
+
+    static void flagDetectedCells(CpuCellFunctionData& data, int cellIndex, RealVector2D const& scanPos);
+
+    static float calcStartDistanceForScanning(uint8_t restrictToColor, SensorRestrictToMutants restrictToMutants, int color);
+
+    static uint8_t convertAngleToData(float angle);
+    static float convertDataToAngle(uint8_t b);
+};
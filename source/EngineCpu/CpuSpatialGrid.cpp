@@ -0,0 +1,54 @@
+#include "CpuSpatialGrid.h"
+
+#include <algorithm>
+
+#include "Base/Definitions.h"
+
+namespace
+{
+    int getSlot(float value, float slotSize, int numSlots)
+    {
+        return std::clamp(static_cast<int>(value / slotSize), 0, numSlots - 1);
+    }
+}
+
+void CpuSpatialGrid::build(IntVector2D const& worldSize, float minSlotSize, std::vector<RealVector2D> const& positions)
+{
+    _numSlots.x = std::max(1, toInt(toFloat(worldSize.x) / minSlotSize));
+    _numSlots.y = std::max(1, toInt(toFloat(worldSize.y) / minSlotSize));
+    while (static_cast<int64_t>(_numSlots.x) * _numSlots.y > MaxSlots) {
+        _numSlots.x = std::max(1, _numSlots.x / 2);
+        _numSlots.y = std::max(1, _numSlots.y / 2);
+    }
+    _slotSize = {toFloat(worldSize.x) / toFloat(_numSlots.x), toFloat(worldSize.y) / toFloat(_numSlots.y)};
+
+    auto numObjects = positions.size();
+    std::vector<int> slots(numObjects);
+    _slotStartIndices.assign(_numSlots.x * _numSlots.y + 1, 0);
+    for (size_t i = 0; i < numObjects; ++i) {
+        auto const& pos = positions[i];
+        slots[i] = getSlot(pos.y, _slotSize.y, _numSlots.y) * _numSlots.x + getSlot(pos.x, _slotSize.x, _numSlots.x);
+        ++_slotStartIndices[slots[i] + 1];
+    }
+    for (size_t slot = 1; slot < _slotStartIndices.size(); ++slot) {
+        _slotStartIndices[slot] += _slotStartIndices[slot - 1];
+    }
+    _objectIndices.resize(numObjects);
+    auto insertIndices = _slotStartIndices;
+    for (size_t i = 0; i < numObjects; ++i) {
+        _objectIndices[insertIndices[slots[i]]++] = toInt(i);
+    }
+}
+
+int CpuSpatialGrid::getMaxIndexInUnitSlot(RealVector2D const& pos, std::vector<RealVector2D> const& positions) const
+{
+    RealVector2D slotPos{std::floor(pos.x), std::floor(pos.y)};
+    int result = -1;
+    forEachCandidate(pos, 0, [&](int index) {
+        auto const& objectPos = positions[index];
+        if (std::floor(objectPos.x) == slotPos.x && std::floor(objectPos.y) == slotPos.y) {
+            result = std::max(result, index);
+        }
+    });
+    return result;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "Base/Vector2D.h"
+
+//uniform grid over the periodic world for neighbor queries, rebuilt from scratch via counting sort
+class CpuSpatialGrid
+{
+public:
+    //positions must be corrected, i.e. inside the world
+    void build(IntVector2D const& worldSize, float minSlotSize, std::vector<RealVector2D> const& positions);
+
+    //calls func(index) for all objects in slots overlapping the square around pos, distances have to be checked by the caller
+    template <typename Func>
+    void forEachCandidate(RealVector2D const& pos, float radius, Func const& func) const;
+
+    //returns the largest index of the objects whose positions lie in the unit square containing pos or -1
+    int getMaxIndexInUnitSlot(RealVector2D const& pos, std::vector<RealVector2D> const& positions) const;
+
+private:
+    static auto constexpr MaxSlots = 1 << 22;
+
+    IntVector2D _numSlots;
+    RealVector2D _slotSize;
+    std::vector<int> _slotStartIndices;
+    std::vector<int> _objectIndices;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+void CpuSpatialGrid::forEachCandidate(RealVector2D const& pos, float radius, Func const& func) const
+{
+    if (_objectIndices.empty()) {
+        return;
+    }
+    auto startX = static_cast<int>(std::floor((pos.x - radius) / _slotSize.x));
+    auto endX = static_cast<int>(std::floor((pos.x + radius) / _slotSize.x));
+    if (endX - startX + 1 >= _numSlots.x) {
+        startX = 0;
+        endX = _numSlots.x - 1;
+    }
+    auto startY = static_cast<int>(std::floor((pos.y - radius) / _slotSize.y));
+    auto endY = static_cast<int>(std::floor((pos.y + radius) / _slotSize.y));
+    if (endY - startY + 1 >= _numSlots.y) {
+        startY = 0;
+        endY = _numSlots.y - 1;
+    }
+    for (int y = startY; y <= endY; ++y) {
+        auto slotY = ((y % _numSlots.y) + _numSlots.y) % _numSlots.y;
+        for (int x = startX; x <= endX; ++x) {
+            auto slotX = ((x % _numSlots.x) + _numSlots.x) % _numSlots.x;
+            auto slot = slotY * _numSlots.x + slotX;
+            for (auto i = _slotStartIndices[slot]; i < _slotStartIndices[slot + 1]; ++i) {
+                func(_objectIndices[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include "CpuStatisticsService.h"
+
+#include <unordered_map>
+
+namespace
+{
+    auto constexpr MinColonySize = 40;
+
+    struct MutantStatistics
+    {
+        int count = 0;
+        int color = 0;
+        float genomeComplexity = 0;
+    };
+
+    bool isSelfReplicator(CpuCell& cell, CellFunction cellFunction)
+    {
+        return cell.properties.getCellFunctionType() == cellFunction && cell.getGenomeInfo().selfReplicating;
+    }
+}
+
+RawStatisticsData CpuStatisticsService::calcRawStatistics(CpuSimulationData& data, AccumulatedStatistics const& accumulatedStatistics)
+{
+    RawStatisticsData result;
+    auto& timestep = result.timeline.timestep;
+    result.timeline.accumulated = accumulatedStatistics;
+
+    std::unordered_map<int, MutantStatistics> mutantStatisticsById;
+    for (auto& cell : data.cells) {
+        auto const& properties = cell.properties;
+        auto const& color = properties.color;
+        ++timestep.numCells[color];
+        timestep.numConnections[color] += cell.numConnections;
+        timestep.totalEnergy[color] += properties.energy;
+        if (isSelfReplicator(cell, CellFunction_Constructor)) {
+            ++timestep.numSelfReplicators[color];
+            auto& mutantStatistics = mutantStatisticsById[properties.mutationId];
+            ++mutantStatistics.count;
+            mutantStatistics.color = std::max(mutantStatistics.color, color);
+            mutantStatistics.genomeComplexity += properties.genomeComplexity;
+            timestep.numGenomeCells[color] += cell.getGenomeInfo().numNodes;
+            timestep.genomeComplexity[color] += properties.genomeComplexity;
+        }
+        if (isSelfReplicator(cell, CellFunction_Injector)) {
+            ++timestep.numViruses[color];
+        }
+    }
+    for (auto const& particle : data.particles) {
+        auto const& properties = particle.properties;
+        ++timestep.numParticles[properties.color];
+        timestep.totalEnergy[properties.color] += properties.energy;
+    }
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        timestep.numConnections[i] /= 2;
+    }
+
+    //colonies
+    for (auto const& [mutationId, mutantStatistics] : mutantStatisticsById) {
+        if (mutantStatistics.count >= MinColonySize) {
+            ++timestep.numColonies[mutantStatistics.color];
+            timestep.maxGenomeComplexityOfColonies[mutantStatistics.color] = std::max(
+                timestep.maxGenomeComplexityOfColonies[mutantStatistics.color], mutantStatistics.genomeComplexity / toFloat(mutantStatistics.count));
+        }
+    }
+
+    //genome complexity variance
+    auto numReplicators = 0.0;
+    auto summedGenomeComplexity = 0.0;
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        numReplicators += toDouble(timestep.numSelfReplicators[i]);
+        summedGenomeComplexity += toDouble(timestep.genomeComplexity[i]);
+    }
+    if (numReplicators > 0) {
+        auto averageGenomeComplexity = summedGenomeComplexity / numReplicators;
+        for (auto& cell : data.cells) {
+            if (isSelfReplicator(cell, CellFunction_Constructor)) {
+                auto variance = toDouble(cell.properties.genomeComplexity) - averageGenomeComplexity;
+                timestep.genomeComplexityVariance[cell.properties.color] += variance * variance / numReplicators;
+            }
+        }
+    }
+
+    //histogram
+    auto& histogram = result.histogram;
+    histogram.maxValue = 0;
+    for (auto const& cell : data.cells) {
+        if (!cell.properties.barrier) {
+            histogram.maxValue = std::max(histogram.maxValue, cell.properties.age);
+        }
+    }
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        for (int j = 0; j < MAX_HISTOGRAM_SLOTS; ++j) {
+            histogram.numCellsByColorBySlot[i][j] = 0;
+        }
+    }
+    for (auto const& cell : data.cells) {
+        if (!cell.properties.barrier) {
+            auto slot = cell.properties.age * MAX_HISTOGRAM_SLOTS / (histogram.maxValue + 1);
+            ++histogram.numCellsByColorBySlot[cell.properties.color][slot];
+        }
+    }
+    return result;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "EngineInterface/RawStatisticsData.h"
+
+#include "CpuObjects.h"
+#include "Definitions.h"
+
+//counterpart of the statistics kernels on the GPU
+class CpuStatisticsService
+{
+public:
+    static RawStatisticsData calcRawStatistics(CpuSimulationData& data, AccumulatedStatistics const& accumulatedStatistics);
+};
@@ -0,0 +1,1296 @@
+#include "CpuTimestepProcessor.h"
+
+#include <climits>
+#include <cmath>
+
+#include "Base/Math.h"
+#include "Base/ParallelService.h"
+
+#include "CpuAttackerProcessor.h"
+#include "CpuCellFunctionProcessor.h"
+#include "CpuConnectionService.h"
+#include "CpuConstructorProcessor.h"
+#include "CpuDetonatorProcessor.h"
+#include "CpuGenomeDecoder.h"
+#include "CpuInjectorProcessor.h"
+#include "CpuMuscleProcessor.h"
+#include "CpuMutationProcessor.h"
+#include "CpuReconnectorProcessor.h"
+#include "CpuSensorProcessor.h"
+#include "CpuTransmitterProcessor.h"
+
+namespace
+{
+    auto constexpr ChunkSize = 1024;
+    auto constexpr MaxBarrierCellsForCollision = 10;
+
+    float calcKernel(float q)
+    {
+        float result;
+        if (q < 1) {
+            result = 2.0f / 3.0f - q * q + 0.5f * q * q * q;
+        } else if (q < 2) {
+            result = 2.0f - q;
+            result = result * result * result / 6;
+        } else {
+            result = 0;
+        }
+        result *= 3.0f / (2.0f * Const::Pi);
+        return result;
+    }
+
+    float calcKernel_d(float q)
+    {
+        float result;
+        if (q < 1) {
+            result = -2 * q + 3.0f / 2.0f * q * q;
+        } else if (q < 2) {
+            result = -0.5f * (2.0f - q) * (2.0f - q);
+        } else {
+            result = 0;
+        }
+        result *= 3.0f / (2.0f * Const::Pi);
+        return result;
+    }
+
+    float applyActivationFunction(NeuronActivationFunction activationFunction, float x)
+    {
+        switch (activationFunction) {
+        case NeuronActivationFunction_Sigmoid:
+            return 2.0f / (1.0f + std::exp(-x)) - 1.0f;
+        case NeuronActivationFunction_BinaryStep:
+            return x >= NEAR_ZERO ? 1.0f : 0.0f;
+        case NeuronActivationFunction_Identity:
+            return std::max(-1.0f, std::min(1.0f, x));
+        case NeuronActivationFunction_Abs:
+            return std::min(1.0f, std::abs(x));
+        case NeuronActivationFunction_Gaussian:
+            return std::exp(-2 * x * x);
+        }
+        return 0;
+    }
+
+    void addStatistics(AccumulatedStatistics& target, AccumulatedStatistics const& source)
+    {
+        for (auto member :
+             {&AccumulatedStatistics::numCreatedCells,
+              &AccumulatedStatistics::numCreatedReplicators,
+              &AccumulatedStatistics::numAttacks,
+              &AccumulatedStatistics::numMuscleActivities,
+              &AccumulatedStatistics::numDefenderActivities,
+              &AccumulatedStatistics::numTransmitterActivities,
+              &AccumulatedStatistics::numInjectionActivities,
+              &AccumulatedStatistics::numCompletedInjections,
+              &AccumulatedStatistics::numNervePulses,
+              &AccumulatedStatistics::numNeuronActivities,
+              &AccumulatedStatistics::numSensorActivities,
+              &AccumulatedStatistics::numSensorMatches,
+              &AccumulatedStatistics::numReconnectorCreated,
+              &AccumulatedStatistics::numReconnectorRemoved,
+              &AccumulatedStatistics::numDetonations}) {
+            for (int i = 0; i < MAX_COLORS; ++i) {
+                (target.*member)[i] += (source.*member)[i];
+            }
+        }
+    }
+
+    void scheduleDeleteAllConnections(std::vector<std::pair<int, int>>& deleteConnections, std::vector<CpuCell> const& cells, int cellIndex)
+    {
+        auto const& cell = cells[cellIndex];
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto connectedCellIndex = cell.connections[i].cellIndex;
+            deleteConnections.emplace_back(connectedCellIndex, cellIndex);
+            deleteConnections.emplace_back(cellIndex, connectedCellIndex);
+        }
+    }
+}
+
+void CpuTimestepProcessor::ChunkOutput::clear()
+{
+    forces.clear();
+    addConnectionPairs.clear();
+    deleteConnections.clear();
+    deleteCells.clear();
+    flaggedObjects.clear();
+    newParticles.clear();
+    externalEnergy = 0;
+    statistics = AccumulatedStatistics();
+}
+
+CpuTimestepProcessor::CpuTimestepProcessor(IntVector2D const& worldSize, uint64_t seed)
+    : _worldSize(worldSize)
+    , _spaceCalculator(worldSize)
+    , _seed(seed)
+{}
+
+void CpuTimestepProcessor::calcTimestep(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics)
+{
+    _timestep = data.timestep;
+    if (toFloat(_externalEnergy) != parameters.externalEnergy) {
+        _externalEnergy = parameters.externalEnergy;
+    }
+
+    //not all stages need to be executed in each time step for performance reasons (as on the GPU)
+    bool considerForcesFromAngleDifferences = (data.timestep % 3 == 0);
+    bool considerInnerFriction = (data.timestep % 3 == 0);
+
+    prepare(data, parameters);
+    radiation(data, parameters, statistics);
+    if (parameters.motionType == MotionType_Fluid) {
+        calcFluidForces(data, parameters, statistics);
+    } else {
+        calcCollisionForces(data, parameters, statistics);
+    }
+    checkAndApplyForces(data, parameters, statistics);
+    particleMovementAndCollision(data, parameters);
+    calcConnectionForces(data, parameters, statistics, considerForcesFromAngleDifferences);
+    verletPositionUpdate(data, parameters, statistics);
+    particleSplitting(data, parameters, statistics);
+    calcConnectionForces(data, parameters, statistics, considerForcesFromAngleDifferences);
+    verletVelocityUpdate(data, parameters);
+
+    //cell functions
+    aging(data, parameters);
+    CpuMutationProcessor::applyRandomMutations(data, parameters, _seed, _timestep);
+    livingStateTransition(data, parameters);
+    cellFunctions(data, parameters, statistics);
+
+    if (considerInnerFriction) {
+        applyInnerFriction(data, parameters);
+    }
+    applyFriction_decay(data, parameters, statistics);
+
+    structuralOperations(data, parameters);
+    particleTransformation(data, parameters);
+
+    data.compact();
+    ++data.timestep;
+}
+
+bool CpuTimestepProcessor::updateSimulationParametersAfterTimestep(SimulationParameters& parameters) const
+{
+    auto result = false;
+    for (int i = 0; i < parameters.numRadiationSources; ++i) {
+        auto& source = parameters.radiationSources[i];
+        if (source.velX != 0) {
+            source.posX += source.velX * parameters.timestepSize;
+            result = true;
+        }
+        if (source.velY != 0) {
+            source.posY += source.velY * parameters.timestepSize;
+            result = true;
+        }
+        auto correctedPosition = _spaceCalculator.getCorrectedPosition({source.posX, source.posY});
+        source.posX = correctedPosition.x;
+        source.posY = correctedPosition.y;
+    }
+    for (int i = 0; i < parameters.numSpots; ++i) {
+        auto& spot = parameters.spots[i];
+        if (spot.velX != 0) {
+            spot.posX += spot.velX * parameters.timestepSize;
+            result = true;
+        }
+        if (spot.velY != 0) {
+            spot.posY += spot.velY * parameters.timestepSize;
+            result = true;
+        }
+        auto correctedPosition = _spaceCalculator.getCorrectedPosition({spot.posX, spot.posY});
+        spot.posX = correctedPosition.x;
+        spot.posY = correctedPosition.y;
+    }
+
+    auto externalEnergyPresent = parameters.externalEnergy > 0;
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        externalEnergyPresent |= parameters.externalEnergyBackflowFactor[i] > 0;
+    }
+    externalEnergyPresent &= parameters.features.externalEnergyControl;
+    if (externalEnergyPresent) {
+        parameters.externalEnergy = toFloat(_externalEnergy);
+        result = true;
+    }
+    return result;
+}
+
+template <typename Func>
+void CpuTimestepProcessor::processChunks(CpuSimulationData& data, int numElements, AccumulatedStatistics& statistics, Func const& func)
+{
+    auto numChunks = (numElements + ChunkSize - 1) / ChunkSize;
+    if (toInt(_chunkOutputs.size()) < numChunks) {
+        _chunkOutputs.resize(numChunks);
+    }
+    ParallelService::forEach(numChunks, [&](uint64_t chunkIndex) {
+        auto& output = _chunkOutputs[chunkIndex];
+        output.clear();
+        auto startIndex = toInt(chunkIndex) * ChunkSize;
+        auto endIndex = std::min(numElements, startIndex + ChunkSize);
+        for (int index = startIndex; index < endIndex; ++index) {
+            func(index, output);
+        }
+    });
+
+    //merge in chunk order
+    for (int chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex) {
+        auto& output = _chunkOutputs[chunkIndex];
+        for (auto const& [cellIndex, force] : output.forces) {
+            data.cells[cellIndex].force += force;
+        }
+        _addConnectionPairs.insert(_addConnectionPairs.end(), output.addConnectionPairs.begin(), output.addConnectionPairs.end());
+        _deleteConnections.insert(_deleteConnections.end(), output.deleteConnections.begin(), output.deleteConnections.end());
+        _deleteCells.insert(_deleteCells.end(), output.deleteCells.begin(), output.deleteCells.end());
+        for (auto& particle : output.newParticles) {
+            particle.properties.id = data.createNewId();
+            data.particles.emplace_back(std::move(particle));
+        }
+        output.newParticles.clear();
+        _externalEnergy += output.externalEnergy;
+        addStatistics(statistics, output.statistics);
+    }
+    for (int chunkIndex = numChunks; chunkIndex < toInt(_chunkOutputs.size()); ++chunkIndex) {
+        _chunkOutputs[chunkIndex].clear();
+    }
+}
+
+void CpuTimestepProcessor::prepare(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    _addConnectionPairs.clear();
+    _deleteConnections.clear();
+    _deleteCells.clear();
+
+    _activeRadiationSources.clear();
+    if (!parameters.baseValues.radiationDisableSources) {
+        for (int i = 0; i < parameters.numRadiationSources; ++i) {
+            _activeRadiationSources.emplace_back(i);
+        }
+    }
+
+    ParallelService::forEachRange(data.cells.size(), [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            data.cells[index].force = {0, 0};
+        }
+    });
+    buildCellGrid(data, parameters);
+    _densityMap.build(_worldSize, data.timestep, data.cells);
+}
+
+void CpuTimestepProcessor::buildCellGrid(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    auto numCells = data.cells.size();
+    _cellGridPositions.resize(numCells);
+    ParallelService::forEachRange(numCells, [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            _cellGridPositions[index] = data.cells[index].properties.pos;
+        }
+    });
+    auto cellMapRadius = parameters.motionType == MotionType_Fluid ? parameters.motionData.fluidMotion.smoothingLength * 2
+                                                                   : parameters.motionData.collisionMotion.cellMaxCollisionDistance;
+    _cellGrid.build(_worldSize, std::max(1.0f, cellMapRadius), _cellGridPositions);
+}
+
+void CpuTimestepProcessor::radiation(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics)
+{
+    processChunks(data, toInt(data.cells.size()), statistics, [&](int index, ChunkOutput& output) {
+        auto& cell = data.cells[index];
+        auto& properties = cell.properties;
+        if (properties.barrier) {
+            return;
+        }
+        CpuRandom random(_seed, _timestep, CpuRandomStage_Radiation, index);
+        if (random.random() >= parameters.radiationProb) {
+            return;
+        }
+        auto radiationFactor = 0.0f;
+        if (properties.energy > parameters.highRadiationMinCellEnergy[properties.color]) {
+            radiationFactor += parameters.highRadiationFactor[properties.color];
+        }
+        if (properties.age > parameters.radiationMinCellAge[properties.color]) {
+            radiationFactor += parameters.baseValues.radiationCellAgeStrength[properties.color];
+        }
+        if (radiationFactor > 0) {
+            auto const& cellEnergy = properties.energy;
+            auto energyLoss = cellEnergy * radiationFactor;
+            energyLoss = energyLoss / parameters.radiationProb;
+            energyLoss = 2 * energyLoss * random.random();
+            if (cellEnergy > 1) {
+                auto particleVel = properties.vel * parameters.radiationVelocityMultiplier
+                    + Math::unitVectorOfAngle(random.random() * 360) * parameters.radiationVelocityPerturbation;
+                auto particlePos = properties.pos + Math::normalized(particleVel) * 1.5f - particleVel;  //"- particleVel" because particle will still be moved in current time step
+                particlePos = _spaceCalculator.getCorrectedPosition(particlePos);
+                if (energyLoss > cellEnergy - 1) {
+                    energyLoss = cellEnergy - 1;
+                }
+                radiate(output, parameters, random, particlePos, particleVel, properties.color, energyLoss);
+                properties.energy -= energyLoss;
+            }
+        }
+    });
+}
+
+void CpuTimestepProcessor::calcFluidForces(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics)
+{
+    auto& cells = data.cells;
+    auto const& smoothingLength = parameters.motionData.fluidMotion.smoothingLength;
+    _posDeltas.assign(cells.size(), RealVector2D());
+    _densities.assign(cells.size(), 0.0f);
+
+    processChunks(data, toInt(cells.size()), statistics, [&](int index, ChunkOutput& output) {
+        auto& cell = cells[index];
+        auto const& properties = cell.properties;
+        RealVector2D F_pressure;
+        RealVector2D F_viscosity;
+        RealVector2D cellPosDelta;
+        float density = 0;
+        auto const& cellMaxBindingEnergy = parameters.baseValues.cellMaxBindingEnergy;
+        auto const& cellFusionVelocity = parameters.baseValues.cellFusionVelocity;
+
+        int barrierCells[MaxBarrierCellsForCollision];
+        int numBarrierCells = 0;
+
+        _cellGrid.forEachCandidate(properties.pos, smoothingLength * 2, [&](int otherIndex) {
+            auto const& otherCell = cells[otherIndex];
+            auto const& otherProperties = otherCell.properties;
+            auto posDelta = _spaceCalculator.getCorrectedDirection(properties.pos - otherProperties.pos);
+            auto distance = Math::length(posDelta);
+            if (distance > smoothingLength * 2 || cell.detached + otherCell.detached == 1) {
+                return;
+            }
+            if (otherProperties.barrier) {
+                if (numBarrierCells < MaxBarrierCellsForCollision) {
+                    barrierCells[numBarrierCells++] = otherIndex;
+                }
+                return;
+            }
+
+            //calc density
+            density += calcKernel(distance / smoothingLength) / (smoothingLength * smoothingLength);
+
+            if (otherIndex == index) {
+                return;
+            }
+
+            //overlap correction
+            if (!properties.barrier && distance < parameters.cellMinDistance) {
+                cellPosDelta += posDelta * parameters.cellMinDistance / 5;
+            }
+
+            if (!cell.isConnectedTo(otherIndex)) {
+
+                //calc forces: for simplicity pressure = density
+                auto velDelta = properties.vel - otherProperties.vel;
+                auto const& cellPressure = cell.density;            //optimization: using the density from last time step
+                auto const& otherCellPressure = otherCell.density;  //optimization: using the density from last time step
+                auto factor = (cellPressure / (cell.density * cell.density) + otherCellPressure / (otherCell.density * otherCell.density));
+
+                if (std::abs(distance) > NEAR_ZERO) {
+                    float kernel_d = calcKernel_d(distance / smoothingLength) / (smoothingLength * smoothingLength * smoothingLength);
+                    F_pressure += posDelta / (-distance) * factor * kernel_d;
+                    F_viscosity += velDelta / otherCell.density * distance * kernel_d / (distance * distance + 0.25f);
+                }
+
+                //fusion
+                if (Math::length(velDelta) >= cellFusionVelocity && cell.numConnections < properties.maxConnections
+                    && otherCell.numConnections < otherProperties.maxConnections && properties.energy <= cellMaxBindingEnergy
+                    && otherProperties.energy <= cellMaxBindingEnergy && !properties.barrier && !otherProperties.barrier) {
+                    output.addConnectionPairs.emplace_back(index, otherIndex);
+                }
+            }
+        });
+
+        //calculate barrier forces
+        if (numBarrierCells > 0) {
+            int closestBarrierCellIndex = -1;
+            float closestBarrierCellDistance = 0;
+            for (int i = 0; i < numBarrierCells; ++i) {
+                auto distance = _spaceCalculator.distance(properties.pos, cells[barrierCells[i]].properties.pos);
+                if (closestBarrierCellIndex == -1 || distance < closestBarrierCellDistance) {
+                    closestBarrierCellIndex = barrierCells[i];
+                    closestBarrierCellDistance = distance;
+                }
+            }
+            auto const& closestBarrierCell = cells[closestBarrierCellIndex];
+            auto const& barrierPos = closestBarrierCell.properties.pos;
+
+            RealVector2D r;
+            if (closestBarrierCell.numConnections <= 1) {
+                r = _spaceCalculator.getCorrectedDirection(properties.pos - barrierPos);
+            } else {
+                auto angleToCell = Math::angleOfVector(_spaceCalculator.getCorrectedDirection(properties.pos - barrierPos));
+                auto numConnections = closestBarrierCell.numConnections;
+                for (int i = 0; i < numConnections; ++i) {
+                    auto const& otherPos1 = cells[closestBarrierCell.connections[i].cellIndex].properties.pos;
+                    auto const& otherPos2 = cells[closestBarrierCell.connections[(i + 1) % numConnections].cellIndex].properties.pos;
+                    auto angleToOtherCell1 = Math::angleOfVector(_spaceCalculator.getCorrectedDirection(otherPos1 - barrierPos));
+                    auto angleToOtherCell2 = Math::angleOfVector(_spaceCalculator.getCorrectedDirection(otherPos2 - barrierPos));
+                    if (Math::isAngleInBetween(angleToOtherCell1, angleToOtherCell2, angleToCell)) {
+                        r = Math::rotateQuarterCounterClockwise(otherPos2 - otherPos1);
+                        break;
+                    }
+                }
+            }
+            auto vr = properties.vel - closestBarrierCell.properties.vel;
+            auto dot_vr_r = Math::dot(vr, r);
+            if (dot_vr_r < 0) {
+                auto truncated_r_squared = std::max(0.05f, Math::lengthSquared(r));
+                auto truncated_distance = std::max(0.05f, closestBarrierCellDistance);
+                cell.force += (vr - r * 2 * dot_vr_r / truncated_r_squared + closestBarrierCell.properties.vel - properties.vel) / truncated_distance;
+            }
+        }
+
+        _posDeltas[index] = cellPosDelta;
+        cell.force += F_pressure * parameters.motionData.fluidMotion.pressureStrength + F_viscosity * parameters.motionData.fluidMotion.viscosityStrength;
+        _densities[index] = density;
+    });
+
+    ParallelService::forEachRange(cells.size(), [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto& cell = cells[index];
+            cell.properties.pos = _spaceCalculator.getCorrectedPosition(cell.properties.pos + _posDeltas[index]);
+            cell.density = _densities[index];
+        }
+    });
+}
+
+void CpuTimestepProcessor::calcCollisionForces(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics)
+{
+    auto& cells = data.cells;
+    auto const& collisionMotion = parameters.motionData.collisionMotion;
+    _posDeltas.assign(cells.size(), RealVector2D());
+
+    processChunks(data, toInt(cells.size()), statistics, [&](int index, ChunkOutput& output) {
+        auto& cell = cells[index];
+        auto const& properties = cell.properties;
+        RealVector2D cellPosDelta;
+        _cellGrid.forEachCandidate(properties.pos, collisionMotion.cellMaxCollisionDistance, [&](int otherIndex) {
+            if (otherIndex == index) {
+                return;
+            }
+            auto const& otherCell = cells[otherIndex];
+            auto const& otherProperties = otherCell.properties;
+            auto posDelta = _spaceCalculator.getCorrectedDirection(properties.pos - otherProperties.pos);
+            auto distance = Math::length(posDelta);
+            if (distance > collisionMotion.cellMaxCollisionDistance || cell.detached + otherCell.detached == 1) {
+                return;
+            }
+
+            //overlap correction
+            if (!properties.barrier && distance < parameters.cellMinDistance) {
+                cellPosDelta += posDelta * parameters.cellMinDistance / 5;
+            }
+
+            if (cell.isConnectedTo(otherIndex)) {
+                return;
+            }
+
+            //collision algorithm
+            auto velDelta = properties.vel - otherProperties.vel;
+            auto isApproaching = Math::dot(posDelta, velDelta) < 0;
+            auto barrierFactor = properties.barrier ? 2.0f : 1.0f;
+
+            RealVector2D force;
+            if (Math::length(properties.vel) > 0.5f && isApproaching) {
+                auto distanceSquared = distance * distance + 0.25f;
+                force = posDelta * Math::dot(velDelta, posDelta) / (-2 * distanceSquared) * barrierFactor;
+            } else {
+                force = Math::normalized(posDelta) * (collisionMotion.cellMaxCollisionDistance - distance) * collisionMotion.cellRepulsionStrength
+                    * barrierFactor;
+            }
+            cell.force += force;
+            output.forces.emplace_back(otherIndex, force * (-1.0f));
+
+            //fusion
+            auto const& cellMaxBindingEnergy = parameters.baseValues.cellMaxBindingEnergy;
+            if (cell.numConnections < properties.maxConnections && otherCell.numConnections < otherProperties.maxConnections
+                && Math::length(velDelta) >= parameters.baseValues.cellFusionVelocity && isApproaching && properties.energy <= cellMaxBindingEnergy
+                && otherProperties.energy <= cellMaxBindingEnergy && !properties.barrier && !otherProperties.barrier) {
+                output.addConnectionPairs.emplace_back(index, otherIndex);
+            }
+        });
+        _posDeltas[index] = cellPosDelta;
+    });
+
+    ParallelService::forEachRange(cells.size(), [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto& properties = cells[index].properties;
+            properties.pos = _spaceCalculator.getCorrectedPosition(properties.pos + _posDeltas[index]);
+        }
+    });
+}
+
+void CpuTimestepProcessor::checkAndApplyForces(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics)
+{
+    auto& cells = data.cells;
+    processChunks(data, toInt(cells.size()), statistics, [&](int index, ChunkOutput& output) {
+        auto& cell = cells[index];
+        auto& properties = cell.properties;
+        if (properties.barrier) {
+            return;
+        }
+        if (Math::length(cell.force) > parameters.baseValues.cellMaxForce[properties.color]) {
+            CpuRandom random(_seed, _timestep, CpuRandomStage_CheckForces, index);
+            if (random.random() < parameters.cellMaxForceDecayProb) {
+                scheduleDeleteAllConnections(output.deleteConnections, cells, index);
+            }
+        }
+
+        properties.vel += cell.force;
+        if (Math::length(properties.vel) > parameters.cellMaxVelocity) {
+            properties.vel = Math::normalized(properties.vel) * parameters.cellMaxVelocity;
+        }
+        cell.force = {0, 0};
+    });
+}
+
+void CpuTimestepProcessor::particleMovementAndCollision(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    auto& particles = data.particles;
+    auto& cells = data.cells;
+
+    _particleGridPositions.resize(particles.size());
+    for (size_t index = 0; index < particles.size(); ++index) {
+        _particleGridPositions[index] = particles[index].properties.pos;
+    }
+    _particleGrid.build(_worldSize, 1.0f, _particleGridPositions);
+
+    ParallelService::forEachRange(particles.size(), [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto& properties = particles[index].properties;
+            properties.pos = _spaceCalculator.getCorrectedPosition(properties.pos + properties.vel * parameters.timestepSize);
+        }
+    });
+
+    //particle collisions are processed sequentially since a particle may be absorbed by any cell or fused with any other particle
+    for (int index = 0; index < toInt(particles.size()); ++index) {
+        auto& particle = particles[index];
+        if (particle.deleted) {
+            continue;
+        }
+        auto& properties = particle.properties;
+
+        //corresponds to ParticleMap::get on the GPU
+        int otherIndex = -1;
+        auto slotPos = RealVector2D{std::floor(properties.pos.x), std::floor(properties.pos.y)};
+        _particleGrid.forEachCandidate(properties.pos, 0, [&](int candidateIndex) {
+            auto const& gridPos = _particleGridPositions[candidateIndex];
+            if (std::floor(gridPos.x) == slotPos.x && std::floor(gridPos.y) == slotPos.y) {
+                otherIndex = std::max(otherIndex, candidateIndex);
+            }
+        });
+
+        if (otherIndex != -1 && otherIndex != index && Math::lengthSquared(properties.pos - particles[otherIndex].properties.pos) < 0.5f) {
+            auto& otherParticle = particles[otherIndex];
+            auto& otherProperties = otherParticle.properties;
+            if (!otherParticle.deleted && properties.energy > NEAR_ZERO && otherProperties.energy > NEAR_ZERO) {
+                auto factor1 = properties.energy / (properties.energy + otherProperties.energy);
+                otherProperties.vel = properties.vel * factor1 + otherProperties.vel * (1.0f - factor1);
+                otherProperties.energy += properties.energy;
+                otherParticle.lastAbsorbedCellId = 0;
+                properties.energy = 0;
+                particle.deleted = true;
+            }
+            continue;
+        }
+
+        auto cellIndex = getFirstCellInSlot(properties.pos + properties.vel);
+        if (cellIndex == -1) {
+            continue;
+        }
+        auto& cellProperties = cells[cellIndex].properties;
+        if (cellProperties.barrier) {
+            auto vr = properties.vel - cellProperties.vel;
+            auto r = _spaceCalculator.getCorrectedDirection(properties.pos - cellProperties.pos);
+            auto dot_vr_r = Math::dot(vr, r);
+            if (dot_vr_r < 0) {
+                auto truncated_r_squared = std::max(0.1f, Math::lengthSquared(r));
+                properties.vel = vr - r * 2 * dot_vr_r / truncated_r_squared + cellProperties.vel;
+            }
+            continue;
+        }
+        if (particle.lastAbsorbedCellId == cellProperties.id) {
+            continue;
+        }
+        auto radiationAbsorption = parameters.baseValues.radiationAbsorption[cellProperties.color];
+        if (radiationAbsorption < NEAR_ZERO) {
+            continue;
+        }
+
+        auto energyToTransfer = properties.energy * radiationAbsorption;
+        if (parameters.features.advancedAbsorptionControl) {
+            auto cellSpeed = Math::length(cellProperties.vel);
+            energyToTransfer *= std::max(0.0f, 1.0f - cellSpeed * parameters.radiationAbsorptionHighVelocityPenalty[cellProperties.color]);
+            energyToTransfer *=
+                1.0f - parameters.baseValues.radiationAbsorptionLowVelocityPenalty[cellProperties.color] / std::pow(1.0f + cellSpeed, 10.0f);
+            energyToTransfer *=
+                std::pow(toFloat(cells[cellIndex].numConnections + 1) / 7.0f, parameters.radiationAbsorptionLowConnectionPenalty[cellProperties.color]);
+            energyToTransfer *= 1.0f
+                - parameters.baseValues.radiationAbsorptionLowGenomeComplexityPenalty[cellProperties.color]
+                    / std::pow(1.0f + cellProperties.genomeComplexity, 0.1f);
+        }
+        if (properties.energy < 0.01f) {
+            energyToTransfer = properties.energy;
+        }
+        cellProperties.energy += energyToTransfer;
+        properties.energy -= energyToTransfer;
+        if (properties.energy < NEAR_ZERO) {
+            particle.deleted = true;
+        } else {
+            particle.lastAbsorbedCellId = cellProperties.id;
+        }
+    }
+}
+
+void CpuTimestepProcessor::calcConnectionForces(
+    CpuSimulationData& data,
+    SimulationParameters const& parameters,
+    AccumulatedStatistics& statistics,
+    bool considerAngles)
+{
+    auto& cells = data.cells;
+    processChunks(data, toInt(cells.size()), statistics, [&](int index, ChunkOutput& output) {
+        auto& cell = cells[index];
+        auto const& properties = cell.properties;
+        if (0 == cell.numConnections || properties.barrier) {
+            return;
+        }
+        RealVector2D force;
+        auto prevDisplacement =
+            _spaceCalculator.getCorrectedDirection(cells[cell.connections[cell.numConnections - 1].cellIndex].properties.pos - properties.pos);
+        auto cellStiffnessSquared = properties.stiffness * properties.stiffness;
+
+        auto numConnections = cell.numConnections;
+        for (int i = 0; i < numConnections; ++i) {
+            auto connectedCellIndex = cell.connections[i].cellIndex;
+            auto const& connectedCell = cells[connectedCellIndex];
+            auto connectedCellStiffnessSquared = connectedCell.properties.stiffness * connectedCell.properties.stiffness;
+
+            auto displacement = _spaceCalculator.getCorrectedDirection(connectedCell.properties.pos - properties.pos);
+            auto actualDistance = Math::length(displacement);
+            auto deviation = actualDistance - cell.connections[i].distance;
+            force += Math::normalized(displacement) * deviation * (cellStiffnessSquared + connectedCellStiffnessSquared) / 6;
+
+            if (considerAngles && (numConnections > 2 || (numConnections == 2 && i == 0))) {
+                auto lastIndex = (i + numConnections - 1) % numConnections;
+                auto lastConnectedCellIndex = cell.connections[lastIndex].cellIndex;
+
+                //angle forces in case of no triangular connections
+                if (!connectedCell.isConnectedTo(lastConnectedCellIndex)) {
+                    auto angle = Math::angleOfVector(displacement);
+                    auto prevAngle = Math::angleOfVector(prevDisplacement);
+                    auto actualAngleFromPrevious = Math::subtractAngle(angle, prevAngle);
+                    if (actualAngleFromPrevious < 0) {
+                        continue;
+                    }
+                    auto referenceAngleFromPrevious = cell.connections[i].angleFromPrevious;
+                    auto strength = std::abs(referenceAngleFromPrevious - actualAngleFromPrevious) / 2000 * cellStiffnessSquared;
+
+                    auto force1 = Math::rotateQuarterClockwise(
+                        Math::normalized(displacement) / std::max(Math::length(displacement), parameters.cellMinDistance) * strength);
+                    auto force2 = Math::rotateQuarterCounterClockwise(
+                        Math::normalized(prevDisplacement) / std::max(Math::length(prevDisplacement), parameters.cellMinDistance) * strength);
+                    if (referenceAngleFromPrevious < actualAngleFromPrevious) {
+                        force1 = force1 * (-1.0f);
+                        force2 = force2 * (-1.0f);
+                    }
+                    if (!connectedCell.properties.barrier) {
+                        output.forces.emplace_back(connectedCellIndex, force1);
+                    }
+                    if (!cells[lastConnectedCellIndex].properties.barrier) {
+                        output.forces.emplace_back(lastConnectedCellIndex, force2);
+                    }
+                    force -= force1 + force2;
+                }
+            }
+            prevDisplacement = displacement;
+        }
+        cell.force += force;
+    });
+}
+
+void CpuTimestepProcessor::verletPositionUpdate(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics)
+{
+    auto& cells = data.cells;
+    auto const& timestepSize = parameters.timestepSize;
+    ParallelService::forEachRange(cells.size(), [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto& cell = cells[index];
+            auto& properties = cell.properties;
+            if (properties.barrier) {
+                properties.pos = _spaceCalculator.getCorrectedPosition(properties.pos + properties.vel * timestepSize);
+            } else {
+                properties.pos =
+                    _spaceCalculator.getCorrectedPosition(properties.pos + properties.vel * timestepSize + cell.force * timestepSize * timestepSize / 2);
+                cell.prevForce = cell.force;
+                cell.force = {0, 0};
+            }
+        }
+    });
+
+    //check connections
+    processChunks(data, toInt(cells.size()), statistics, [&](int index, ChunkOutput& output) {
+        auto const& cell = cells[index];
+        auto const& properties = cell.properties;
+        if (properties.barrier) {
+            return;
+        }
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto const& connectedCell = cells[cell.connections[i].cellIndex];
+            if (_spaceCalculator.distance(connectedCell.properties.pos, properties.pos) > parameters.cellMaxBindingDistance[properties.color]) {
+                scheduleDeleteAllConnections(output.deleteConnections, cells, index);
+                output.flaggedObjects.emplace_back(index);
+                break;
+            }
+        }
+    });
+    for (auto const& output : _chunkOutputs) {
+        for (auto const& index : output.flaggedObjects) {
+            auto const& cell = cells[index];
+            for (int i = 0; i < cell.numConnections; ++i) {
+                cells[cell.connections[i].cellIndex].properties.livingState = LivingState_Detaching;
+            }
+        }
+    }
+}
+
+void CpuTimestepProcessor::particleSplitting(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics)
+{
+    auto& particles = data.particles;
+    processChunks(data, toInt(particles.size()), statistics, [&](int index, ChunkOutput& output) {
+        auto& particle = particles[index];
+        if (particle.deleted) {
+            return;
+        }
+        CpuRandom random(_seed, _timestep, CpuRandomStage_ParticleSplitting, index);
+        if (random.random() >= 0.01f) {
+            return;
+        }
+        auto& properties = particle.properties;
+        if (properties.energy > parameters.particleSplitEnergy[properties.color]) {
+            properties.energy *= 0.5f;
+            auto velPerturbation = Math::unitVectorOfAngle(random.random() * 360);
+
+            auto otherPos = _spaceCalculator.getCorrectedPosition(properties.pos + velPerturbation / 5);
+            properties.pos = _spaceCalculator.getCorrectedPosition(properties.pos - velPerturbation / 5);
+
+            velPerturbation *= parameters.radiationVelocityPerturbation / (properties.energy + 1.0f);
+            auto otherVel = properties.vel + velPerturbation;
+            properties.vel -= velPerturbation;
+
+            CpuParticle newParticle;
+            newParticle.properties.setPos(otherPos).setVel(otherVel).setEnergy(properties.energy).setColor(properties.color);
+            output.newParticles.emplace_back(newParticle);
+        }
+    });
+}
+
+void CpuTimestepProcessor::verletVelocityUpdate(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    auto& cells = data.cells;
+    ParallelService::forEachRange(cells.size(), [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto& cell = cells[index];
+            if (cell.properties.barrier) {
+                continue;
+            }
+            auto acceleration = (cell.force + cell.prevForce) / 2;
+            cell.properties.vel += acceleration * parameters.timestepSize;
+        }
+    });
+}
+
+void CpuTimestepProcessor::aging(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    auto& cells = data.cells;
+    ParallelService::forEachRange(cells.size(), [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto& properties = cells[index].properties;
+            if (properties.barrier) {
+                continue;
+            }
+            ++properties.age;
+
+            if (parameters.features.cellColorTransitionRules) {
+                auto color = ((properties.color % MAX_COLORS) + MAX_COLORS) % MAX_COLORS;
+                auto transitionDuration = parameters.baseValues.cellColorTransitionDuration[color];
+                if (transitionDuration > 0 && properties.age > transitionDuration) {
+                    properties.color = parameters.baseValues.cellColorTransitionTargetColor[color];
+                    properties.age = 0;
+                }
+            }
+            if (properties.livingState == LivingState_Ready && properties.activationTime > 0) {
+                --properties.activationTime;
+            }
+        }
+    });
+}
+
+void CpuTimestepProcessor::livingStateTransition(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    //the transitions of a cell depend on the transitions of its neighbors in the same pass, hence sequential processing
+    auto& cells = data.cells;
+    auto resetAge = parameters.features.cellAgeLimiter && parameters.cellResetAgeAfterActivation;
+    for (auto& cell : cells) {
+        auto& livingState = cell.properties.livingState;
+        auto origLivingState = livingState;
+        if (origLivingState == LivingState_Activating) {
+            livingState = LivingState_Ready;
+            if (resetAge) {
+                cell.properties.age = 0;
+            }
+            for (int i = 0; i < cell.numConnections; ++i) {
+                auto& connectedProperties = cells[cell.connections[i].cellIndex].properties;
+                if (connectedProperties.livingState == LivingState_UnderConstruction) {
+                    connectedProperties.livingState = LivingState_Activating;
+                    if (resetAge) {
+                        connectedProperties.age = 0;
+                    }
+                }
+            }
+        }
+        if (origLivingState == LivingState_Reviving) {
+            livingState = LivingState_Ready;
+            for (int i = 0; i < cell.numConnections; ++i) {
+                auto& connectedProperties = cells[cell.connections[i].cellIndex].properties;
+                if (connectedProperties.creatureId == cell.properties.creatureId && connectedProperties.livingState == LivingState_Detaching) {
+                    connectedProperties.livingState = LivingState_Reviving;
+                }
+            }
+        }
+        if (origLivingState == LivingState_Detaching) {
+            if (parameters.cellDeathConsequences == CellDeathConsquences_DetachedPartsDie
+                || parameters.cellDeathConsequences == CellDeathConsquences_CreatureDies) {
+                for (int i = 0; i < cell.numConnections; ++i) {
+                    auto& connectedCell = cells[cell.connections[i].cellIndex];
+                    auto& connectedProperties = connectedCell.properties;
+                    if (connectedProperties.creatureId == cell.properties.creatureId) {
+                        if (parameters.cellDeathConsequences == CellDeathConsquences_DetachedPartsDie
+                            && connectedProperties.getCellFunctionType() == CellFunction_Constructor && connectedCell.getGenomeInfo().selfReplicating) {
+                            connectedProperties.livingState = LivingState_Reviving;
+                        } else if (connectedProperties.livingState == LivingState_Ready) {
+                            connectedProperties.livingState = LivingState_Detaching;
+                        }
+                    } else if (connectedProperties.livingState == LivingState_UnderConstruction) {
+                        connectedProperties.livingState = LivingState_Detaching;
+                    }
+                }
+            } else {
+                livingState = LivingState_Ready;
+            }
+        }
+        if (origLivingState == LivingState_Dying && parameters.cellDeathConsequences != CellDeathConsquences_None) {
+            for (int i = 0; i < cell.numConnections; ++i) {
+                auto& connectedCell = cells[cell.connections[i].cellIndex];
+                auto& connectedProperties = connectedCell.properties;
+                if (connectedProperties.creatureId != cell.properties.creatureId) {
+                    continue;
+                }
+                //non-separating self-replicators survive so that the creature can be rebuilt
+                if (connectedProperties.getCellFunctionType() == CellFunction_Constructor && connectedCell.getGenomeInfo().selfReplicating) {
+                    auto const& genome = std::get<ConstructorDescription>(*connectedProperties.cellFunction).genome;
+                    if (!CpuGenomeDecoder::isSeparating(genome.data(), toInt(genome.size()))) {
+                        continue;
+                    }
+                }
+                connectedProperties.livingState = LivingState_Dying;
+            }
+        }
+    }
+}
+
+void CpuTimestepProcessor::cellFunctions(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics)
+{
+    //the cells have been moved since the preparation of the time step
+    buildCellGrid(data, parameters);
+
+    ChunkOutput output;
+    CpuCellFunctionData cellFunctionData{
+        .data = data,
+        .parameters = parameters,
+        .spaceCalculator = _spaceCalculator,
+        .cellGrid = _cellGrid,
+        .cellGridPositions = _cellGridPositions,
+        .densityMap = _densityMap,
+        .seed = _seed,
+        .timestep = _timestep,
+        .externalEnergy = _externalEnergy,
+        .deleteCells = _deleteCells,
+        .addConnectionPairs = _addConnectionPairs,
+        .deleteConnections = _deleteConnections,
+        .radiate =
+            [&](CpuRandom& random, RealVector2D const& pos, RealVector2D const& vel, int color, float energy) {
+                radiate(output, parameters, random, pos, vel, color, energy);
+            },
+    };
+    CpuCellFunctionProcessor::collectCellFunctionOperations(cellFunctionData);
+
+    nerveAndNeuron(data, parameters, statistics);
+    CpuConstructorProcessor::preprocess(cellFunctionData);
+    CpuConstructorProcessor::process(cellFunctionData, statistics);
+    CpuInjectorProcessor::process(cellFunctionData, statistics);
+    CpuAttackerProcessor::process(cellFunctionData, statistics);
+    CpuTransmitterProcessor::process(cellFunctionData, statistics);
+    CpuMuscleProcessor::process(cellFunctionData, statistics);
+    CpuSensorProcessor::process(cellFunctionData, statistics);
+    CpuReconnectorProcessor::process(cellFunctionData, statistics);
+    CpuDetonatorProcessor::process(cellFunctionData, statistics);
+
+    for (auto& particle : output.newParticles) {
+        particle.properties.id = data.createNewId();
+        data.particles.emplace_back(std::move(particle));
+    }
+    _externalEnergy += output.externalEnergy;
+}
+
+void CpuTimestepProcessor::nerveAndNeuron(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics)
+{
+    //executing cells only read the activities of cells with a different execution order number, hence they can be processed in parallel
+    auto& cells = data.cells;
+    auto const& numExecutionOrderNumbers = parameters.cellNumExecutionOrderNumbers;
+    auto executionOrderNumber = toInt(data.timestep % numExecutionOrderNumbers);
+    processChunks(data, toInt(cells.size()), statistics, [&](int index, ChunkOutput& output) {
+        auto& cell = cells[index];
+        auto& properties = cell.properties;
+        if (!properties.cellFunction || properties.executionOrderNumber != executionOrderNumber || properties.livingState != LivingState_Ready
+            || properties.activationTime != 0) {
+            return;
+        }
+        if (auto nerve = std::get_if<NerveDescription>(&*properties.cellFunction)) {
+            auto activity = CpuCellFunctionProcessor::calcInputActivity(cells, cell, parameters);
+            CpuCellFunctionProcessor::updateInvocationState(cell, activity);
+
+            auto counter =
+                (properties.age / numExecutionOrderNumbers) * numExecutionOrderNumbers + properties.executionOrderNumber % numExecutionOrderNumbers;
+            if (nerve->pulseMode > 0 && (counter % (numExecutionOrderNumbers * nerve->pulseMode) == properties.executionOrderNumber)) {
+                ++output.statistics.numNervePulses[properties.color];
+                if (nerve->alternationMode == 0) {
+                    activity.channels[0] += 1.0f;
+                } else {
+                    auto evenPulse = counter % (numExecutionOrderNumbers * nerve->pulseMode * nerve->alternationMode * 2)
+                        < properties.executionOrderNumber + numExecutionOrderNumbers * nerve->pulseMode * nerve->alternationMode;
+                    activity.channels[0] += evenPulse ? 1.0f : -1.0f;
+                }
+            }
+            properties.activity = activity;
+        } else if (auto neuron = std::get_if<NeuronDescription>(&*properties.cellFunction)) {
+            auto inputActivity = CpuCellFunctionProcessor::calcInputActivity(cells, cell, parameters);
+            CpuCellFunctionProcessor::updateInvocationState(cell, inputActivity);
+
+            ActivityDescription outputActivity;
+            for (int row = 0; row < MAX_CHANNELS; ++row) {
+                auto sumInput = neuron->biases[row];
+                for (int col = 0; col < MAX_CHANNELS; ++col) {
+                    sumInput += neuron->weights[row][col] * inputActivity.channels[col];
+                }
+                outputActivity.channels[row] = applyActivationFunction(neuron->activationFunctions[row], sumInput);
+            }
+            outputActivity.origin = inputActivity.origin;
+            outputActivity.targetX = inputActivity.targetX;
+            outputActivity.targetY = inputActivity.targetY;
+            properties.activity = outputActivity;
+            ++output.statistics.numNeuronActivities[properties.color];
+        }
+    });
+}
+
+void CpuTimestepProcessor::applyInnerFriction(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    //velocities of connected cells are mixed pairwise, the GPU skips pairs which are locked by other threads
+    auto& cells = data.cells;
+    auto const& innerFriction = parameters.innerFriction;
+    for (auto& cell : cells) {
+        if (cell.properties.barrier) {
+            continue;
+        }
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto& connectedProperties = cells[cell.connections[i].cellIndex].properties;
+            if (connectedProperties.barrier) {
+                continue;
+            }
+            auto averageVel = (cell.properties.vel + connectedProperties.vel) / 2;
+            cell.properties.vel = cell.properties.vel * (1.0f - innerFriction) + averageVel * innerFriction;
+            connectedProperties.vel = connectedProperties.vel * (1.0f - innerFriction) + averageVel * innerFriction;
+        }
+    }
+}
+
+void CpuTimestepProcessor::applyFriction_decay(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics)
+{
+    auto& cells = data.cells;
+    auto executionOrderNumber = toInt(data.timestep % parameters.cellNumExecutionOrderNumbers);
+    processChunks(data, toInt(cells.size()), statistics, [&](int index, ChunkOutput& output) {
+        auto& cell = cells[index];
+        auto& properties = cell.properties;
+        CpuCellFunctionProcessor::resetFetchedActivity(cells, cell, parameters, executionOrderNumber);
+        if (properties.barrier) {
+            return;
+        }
+
+        //friction
+        properties.vel = properties.vel * (1.0f - parameters.baseValues.friction);
+
+        //decay
+        if (properties.energy > parameters.baseValues.cellMaxBindingEnergy) {
+            scheduleDeleteAllConnections(output.deleteConnections, cells, index);
+        }
+        if (properties.livingState == LivingState_Dying || properties.livingState == LivingState_Detaching) {
+            CpuRandom random(_seed, _timestep, CpuRandomStage_Decay, index);
+            if (random.random() < parameters.cellDeathProbability[properties.color]) {
+                output.deleteCells.emplace_back(index);
+            }
+        }
+
+        auto cellDestruction = properties.energy < parameters.baseValues.cellMinEnergy[properties.color];
+
+        auto cellMaxAge = parameters.cellMaxAge[properties.color];
+        if (parameters.features.cellAgeLimiter && parameters.cellInactiveMaxAgeActivated && properties.mutationId != 1
+            && properties.cellFunctionUsed == CellFunctionUsed_No && properties.livingState == LivingState_Ready && properties.activationTime == 0) {
+            bool adjacentCellsUsed = false;
+            for (int i = 0; i < cell.numConnections; ++i) {
+                if (cells[cell.connections[i].cellIndex].properties.cellFunctionUsed == CellFunctionUsed_Yes) {
+                    adjacentCellsUsed = true;
+                    break;
+                }
+            }
+            if (!adjacentCellsUsed) {
+                cellMaxAge = toInt(std::min(toDouble(INT_MAX), toDouble(parameters.baseValues.cellInactiveMaxAge[properties.color])));
+            }
+        }
+        if (parameters.features.cellAgeLimiter && parameters.cellEmergentMaxAgeActivated && properties.mutationId == 1) {
+            cellMaxAge = parameters.cellEmergentMaxAge[properties.color];
+        }
+        if (cellMaxAge > 0 && properties.age > cellMaxAge) {
+            cellDestruction = true;
+        }
+        if (cellDestruction) {
+            output.flaggedObjects.emplace_back(index);
+        }
+    });
+
+    for (auto const& output : _chunkOutputs) {
+        for (auto const& index : output.flaggedObjects) {
+            auto& cell = cells[index];
+            auto origLivingState = cell.properties.livingState;
+            cell.properties.livingState = LivingState_Dying;
+            if (origLivingState != LivingState_Dying) {
+                for (int i = 0; i < cell.numConnections; ++i) {
+                    auto& connectedProperties = cells[cell.connections[i].cellIndex].properties;
+                    if (connectedProperties.livingState != LivingState_Dying) {
+                        connectedProperties.livingState = LivingState_Detaching;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CpuTimestepProcessor::structuralOperations(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    auto& cells = data.cells;
+
+    for (auto const& [cellIndex1, cellIndex2] : _addConnectionPairs) {
+        auto const& cell1 = cells[cellIndex1];
+        auto const& cell2 = cells[cellIndex2];
+        if (!cell1.isConnectedTo(cellIndex2) && cell1.numConnections < cell1.properties.maxConnections
+            && cell2.numConnections < cell2.properties.maxConnections) {
+            CpuConnectionService::tryAddConnections(cells, _spaceCalculator, cellIndex1, cellIndex2);
+        }
+    }
+
+    ChunkOutput output;
+    for (auto const& cellIndex : _deleteCells) {
+        auto& cell = cells[cellIndex];
+        if (cell.deleted) {
+            continue;
+        }
+        cell.deleted = true;
+        auto const& properties = cell.properties;
+        CpuRandom random(_seed, _timestep, CpuRandomStage_CellDeletion, cellIndex);
+        radiate(output, parameters, random, properties.pos, properties.vel, properties.color, properties.energy);
+        for (int i = 0; i < cell.numConnections; ++i) {
+            _deleteConnections.emplace_back(cell.connections[i].cellIndex, cellIndex);
+        }
+    }
+    for (auto& particle : output.newParticles) {
+        particle.properties.id = data.createNewId();
+        data.particles.emplace_back(std::move(particle));
+    }
+    _externalEnergy += output.externalEnergy;
+
+    for (auto const& [cellIndex, connectedCellIndex] : _deleteConnections) {
+        auto& cell = cells[cellIndex];
+        if (!cell.deleted) {
+            CpuConnectionService::deleteConnectionOneWay(cell, connectedCellIndex);
+        }
+    }
+}
+
+void CpuTimestepProcessor::particleTransformation(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    if (!parameters.particleTransformationAllowed) {
+        return;
+    }
+    auto& particles = data.particles;
+    for (int index = 0; index < toInt(particles.size()); ++index) {
+        auto& particle = particles[index];
+        auto const& properties = particle.properties;
+        if (particle.deleted || properties.energy < parameters.cellNormalEnergy[properties.color]) {
+            continue;
+        }
+
+        //corresponds to ObjectFactory::createRandomCell, cell functions other than neurons are created with default values
+        CpuRandom random(_seed, _timestep, CpuRandomStage_ParticleTransformation, index);
+        auto const& numExecutionOrderNumbers = parameters.cellNumExecutionOrderNumbers;
+        CpuCell cell;
+        cell.properties.setId(data.createNewId())
+            .setPos(properties.pos)
+            .setVel(properties.vel)
+            .setEnergy(properties.energy)
+            .setStiffness(random.random())
+            .setMaxConnections(random.random(MAX_CELL_BONDS))
+            .setExecutionOrderNumber(random.random(numExecutionOrderNumbers - 1))
+            .setInputExecutionOrderNumber(random.random(numExecutionOrderNumbers - 1))
+            .setOutputBlocked(random.randomBool())
+            .setLivingState(LivingState_Ready)
+            .setMutationId(1)
+            .setColor(properties.color);
+        if (parameters.particleTransformationRandomCellFunction) {
+            switch (random.random(CellFunction_Count - 1)) {
+            case CellFunction_Neuron: {
+                NeuronDescription neuron;
+                for (auto& row : neuron.weights) {
+                    for (auto& weight : row) {
+                        weight = random.random(2.0f) - 1.0f;
+                    }
+                }
+                for (int i = 0; i < MAX_CHANNELS; ++i) {
+                    neuron.biases[i] = random.random(2.0f) - 1.0f;
+                    neuron.activationFunctions[i] = NeuronActivationFunction_Sigmoid;
+                }
+                cell.properties.setCellFunction(neuron);
+            } break;
+            case CellFunction_Transmitter: {
+                cell.properties.setCellFunction(TransmitterDescription().setMode(random.random(EnergyDistributionMode_Count - 1)));
+            } break;
+            case CellFunction_Constructor: {
+                cell.properties.setCellFunction(ConstructorDescription());
+            } break;
+            case CellFunction_Sensor: {
+                cell.properties.setCellFunction(SensorDescription());
+            } break;
+            case CellFunction_Nerve: {
+                cell.properties.setCellFunction(NerveDescription());
+            } break;
+            case CellFunction_Attacker: {
+                cell.properties.setCellFunction(AttackerDescription());
+            } break;
+            case CellFunction_Injector: {
+                cell.properties.setCellFunction(InjectorDescription());
+            } break;
+            case CellFunction_Muscle: {
+                cell.properties.setCellFunction(MuscleDescription());
+            } break;
+            case CellFunction_Defender: {
+                cell.properties.setCellFunction(DefenderDescription());
+            } break;
+            case CellFunction_Reconnector: {
+                cell.properties.setCellFunction(ReconnectorDescription());
+            } break;
+            case CellFunction_Detonator: {
+                cell.properties.setCellFunction(DetonatorDescription());
+            } break;
+            }
+        }
+        data.cells.emplace_back(std::move(cell));
+        particle.deleted = true;
+    }
+}
+
+void CpuTimestepProcessor::radiate(
+    ChunkOutput& output,
+    SimulationParameters const& parameters,
+    CpuRandom& random,
+    RealVector2D pos,
+    RealVector2D vel,
+    int color,
+    float energy) const
+{
+    if (!_activeRadiationSources.empty()) {
+        auto sourceIndex = _activeRadiationSources[random.random(toInt(_activeRadiationSources.size()) - 1)];
+        auto const& source = parameters.radiationSources[sourceIndex];
+        pos = {source.posX, source.posY};
+
+        if (source.shapeType == RadiationSourceShapeType_Circular) {
+            auto radius = std::max(1.0f, source.shapeData.circularRadiationSource.radius);
+            RealVector2D delta;
+            for (int i = 0; i < 10; ++i) {
+                delta.x = random.random() * radius * 2 - radius;
+                delta.y = random.random() * radius * 2 - radius;
+                if (Math::length(delta) <= radius) {
+                    break;
+                }
+            }
+            pos += delta;
+            if (source.useAngle) {
+                vel = Math::unitVectorOfAngle(source.angle) * random.random(0.5f, 1.0f);
+            } else {
+                vel = Math::normalized(delta) * random.random(0.5f, 1.0f);
+            }
+        }
+        if (source.shapeType == RadiationSourceShapeType_Rectangular) {
+            auto const& rectangle = source.shapeData.rectangularRadiationSource;
+            RealVector2D delta;
+            delta.x = random.random() * rectangle.width - rectangle.width / 2;
+            delta.y = random.random() * rectangle.height - rectangle.height / 2;
+            pos += delta;
+            if (source.useAngle) {
+                vel = Math::unitVectorOfAngle(source.angle) * random.random(0.5f, 1.0f);
+            } else {
+                auto roundSize = std::min(rectangle.width, rectangle.height) / 2;
+                RealVector2D corner1{-rectangle.width / 2, -rectangle.height / 2};
+                RealVector2D corner2{rectangle.width / 2, -rectangle.height / 2};
+                RealVector2D corner3{-rectangle.width / 2, rectangle.height / 2};
+                RealVector2D corner4{rectangle.width / 2, rectangle.height / 2};
+                if (Math::lengthMax(corner1 - delta) <= roundSize) {
+                    vel = Math::normalized(delta - (corner1 + RealVector2D{roundSize, roundSize}));
+                } else if (Math::lengthMax(corner2 - delta) <= roundSize) {
+                    vel = Math::normalized(delta - (corner2 + RealVector2D{-roundSize, roundSize}));
+                } else if (Math::lengthMax(corner3 - delta) <= roundSize) {
+                    vel = Math::normalized(delta - (corner3 + RealVector2D{roundSize, -roundSize}));
+                } else if (Math::lengthMax(corner4 - delta) <= roundSize) {
+                    vel = Math::normalized(delta - (corner4 + RealVector2D{-roundSize, -roundSize}));
+                } else {
+                    vel = {0, 0};
+                    auto dx1 = rectangle.width / 2 + delta.x;
+                    auto dx2 = rectangle.width / 2 - delta.x;
+                    auto dy1 = rectangle.height / 2 + delta.y;
+                    auto dy2 = rectangle.height / 2 - delta.y;
+                    if (dx1 <= dy1 && dx1 <= dy2 && delta.x <= 0) {
+                        vel.x = -1;
+                    }
+                    if (dy1 <= dx1 && dy1 <= dx2 && delta.y <= 0) {
+                        vel.y = -1;
+                    }
+                    if (dx2 <= dy1 && dx2 <= dy2 && delta.x > 0) {
+                        vel.x = 1;
+                    }
+                    if (dy2 <= dx1 && dy2 <= dx2 && delta.y > 0) {
+                        vel.y = 1;
+                    }
+                }
+                vel = vel * random.random(0.5f, 1.0f);
+            }
+        }
+    }
+    pos = _spaceCalculator.getCorrectedPosition(pos);
+
+    auto externalEnergyBackflowFactor = parameters.features.externalEnergyControl ? parameters.externalEnergyBackflowFactor[color] : 0.0f;
+    auto particleEnergy = energy * (1.0f - externalEnergyBackflowFactor);
+    if (particleEnergy > NEAR_ZERO) {
+        CpuParticle particle;
+        particle.properties.setPos(pos).setVel(vel).setEnergy(particleEnergy).setColor(color);
+        output.newParticles.emplace_back(particle);
+    }
+    output.externalEnergy += toDouble(energy * externalEnergyBackflowFactor);
+}
+
+int CpuTimestepProcessor::getFirstCellInSlot(RealVector2D const& pos) const
+{
+    return _cellGrid.getMaxIndexInUnitSlot(_spaceCalculator.getCorrectedPosition(pos), _cellGridPositions);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <vector>
+
+#include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/SpaceCalculator.h"
+
+#include "CpuDensityMap.h"
+#include "CpuObjects.h"
+#include "CpuRandom.h"
+#include "CpuSpatialGrid.h"
+#include "Definitions.h"
+
+//CPU counterpart of SimulationKernelsLauncher::calcTimestep
+//objects are processed in fixed chunks on the threads of ParallelService, effects on other objects are collected per chunk
+//and merged in chunk order so that the result only depends on the seed and not on the number of threads
+class CpuTimestepProcessor
+{
+public:
+    CpuTimestepProcessor(IntVector2D const& worldSize, uint64_t seed);
+
+    void calcTimestep(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics);
+
+    //corresponds to SimulationKernelsLauncher::updateSimulationParametersAfterTimestep, returns true if parameters have been changed
+    bool updateSimulationParametersAfterTimestep(SimulationParameters& parameters) const;
+
+private:
+    struct ChunkOutput
+    {
+        std::vector<std::pair<int, RealVector2D>> forces;  //forces acting on cells outside the chunk
+        std::vector<std::pair<int, int>> addConnectionPairs;
+        std::vector<std::pair<int, int>> deleteConnections;  //(cell index, connected cell index) for one-way deletions
+        std::vector<int> deleteCells;
+        std::vector<int> flaggedObjects;  //stage specific
+        std::vector<CpuParticle> newParticles;
+        double externalEnergy = 0;
+        AccumulatedStatistics statistics;
+
+        void clear();
+    };
+
+    template <typename Func>
+    void processChunks(CpuSimulationData& data, int numElements, AccumulatedStatistics& statistics, Func const& func);
+
+    void prepare(CpuSimulationData& data, SimulationParameters const& parameters);
+    void buildCellGrid(CpuSimulationData& data, SimulationParameters const& parameters);
+    void radiation(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics);
+    void calcFluidForces(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics);
+    void calcCollisionForces(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics);
+    void checkAndApplyForces(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics);
+    void particleMovementAndCollision(CpuSimulationData& data, SimulationParameters const& parameters);
+    void calcConnectionForces(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics, bool considerAngles);
+    void verletPositionUpdate(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics);
+    void particleSplitting(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics);
+    void verletVelocityUpdate(CpuSimulationData& data, SimulationParameters const& parameters);
+    void aging(CpuSimulationData& data, SimulationParameters const& parameters);
+    void livingStateTransition(CpuSimulationData& data, SimulationParameters const& parameters);
+    void cellFunctions(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics);
+    void nerveAndNeuron(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics);
+    void applyInnerFriction(CpuSimulationData& data, SimulationParameters const& parameters);
+    void applyFriction_decay(CpuSimulationData& data, SimulationParameters const& parameters, AccumulatedStatistics& statistics);
+    void structuralOperations(CpuSimulationData& data, SimulationParameters const& parameters);
+    void particleTransformation(CpuSimulationData& data, SimulationParameters const& parameters);
+
+    //creates a particle at an active radiation source (or at pos if there is none) and accounts for the external energy backflow
+    void radiate(
+        ChunkOutput& output,
+        SimulationParameters const& parameters,
+        CpuRandom& random,
+        RealVector2D pos,
+        RealVector2D vel,
+        int color,
+        float energy) const;
+
+    //corresponds to CellMap::getFirst on the GPU: returns the index of a cell assigned to the integer slot of pos or -1
+    int getFirstCellInSlot(RealVector2D const& pos) const;
+
+    IntVector2D _worldSize;
+    SpaceCalculator _spaceCalculator;
+    uint64_t _seed = 0;
+    uint64_t _timestep = 0;
+
+    CpuSpatialGrid _cellGrid;
+    std::vector<RealVector2D> _cellGridPositions;
+    CpuDensityMap _densityMap;
+    CpuSpatialGrid _particleGrid;
+    std::vector<RealVector2D> _particleGridPositions;
+
+    std::vector<int> _activeRadiationSources;
+    std::vector<RealVector2D> _posDeltas;
+    std::vector<float> _densities;
+    std::vector<ChunkOutput> _chunkOutputs;
+
+    std::vector<std::pair<int, int>> _addConnectionPairs;
+    std::vector<std::pair<int, int>> _deleteConnections;
+    std::vector<int> _deleteCells;
+    double _externalEnergy = 0;
+};
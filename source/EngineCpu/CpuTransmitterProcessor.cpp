@@ -0,0 +1,122 @@
+#include "CpuTransmitterProcessor.h"
+
+#include "CpuGenomeDecoder.h"
+
+void CpuTransmitterProcessor::process(CpuCellFunctionData& data, AccumulatedStatistics& statistics)
+{
+    for (auto const& cellIndex : data.cellFunctionOperations[CellFunction_Transmitter]) {
+        processCell(data, statistics, cellIndex);
+    }
+}
+
+void CpuTransmitterProcessor::processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex)
+{
+    auto& cells = data.data.cells;
+    auto activity = CpuCellFunctionProcessor::calcInputActivity(cells, cells[cellIndex], data.parameters);
+    CpuCellFunctionProcessor::updateInvocationState(cells[cellIndex], activity);
+
+    distributeEnergy(data, statistics, cellIndex);
+
+    CpuCellFunctionProcessor::setActivity(cells[cellIndex], activity);
+}
+
+void CpuTransmitterProcessor::distributeEnergy(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex)
+{
+    auto& cells = data.data.cells;
+    auto& cell = cells[cellIndex];
+    auto const& parameters = data.parameters;
+    auto color = cell.properties.color;
+    auto creatureId = cell.properties.creatureId;
+    auto sameCreature = parameters.cellFunctionTransmitterEnergyDistributionSameCreature;
+
+    float energyDelta = 0;
+    auto const& energyDistribution = parameters.cellFunctionTransmitterEnergyDistributionValue[color];
+    if (cell.properties.energy > parameters.cellNormalEnergy[color]) {
+        cell.properties.energy -= energyDistribution;
+        energyDelta = energyDistribution;
+    }
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto& connectedCell = cells[cell.connections[i].cellIndex];
+        auto connectedCellFunction = connectedCell.properties.getCellFunctionType();
+        if (connectedCellFunction == CellFunction_Transmitter) {
+            continue;
+        }
+        if (connectedCellFunction == CellFunction_Constructor) {
+            if (!CpuGenomeDecoder::isFinished(CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(connectedCell))) {
+                continue;
+            }
+        }
+        if (connectedCell.properties.energy > parameters.cellNormalEnergy[color]) {
+            connectedCell.properties.energy -= energyDistribution;
+            energyDelta += energyDistribution;
+        }
+    }
+
+    if (energyDelta > NEAR_ZERO) {
+        ++statistics.numTransmitterActivities[color];
+    }
+
+    auto const& transmitter = CpuCellFunctionProcessor::getCellFunction<TransmitterDescription>(cell);
+    if (transmitter.mode == EnergyDistributionMode_ConnectedCells) {
+        int numReceivers = cell.numConnections;
+        for (int i = 0; i < cell.numConnections; ++i) {
+            numReceivers += cells[cell.connections[i].cellIndex].numConnections;
+        }
+        float energyPerReceiver = energyDelta / toFloat(numReceivers + 1);
+
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto& connectedCell = cells[cell.connections[i].cellIndex];
+            if (sameCreature && connectedCell.properties.creatureId != creatureId) {
+                continue;
+            }
+            connectedCell.properties.energy += energyPerReceiver;
+            energyDelta -= energyPerReceiver;
+            for (int j = 0; j < connectedCell.numConnections; ++j) {
+                auto& connectedConnectedCell = cells[connectedCell.connections[j].cellIndex];
+                if (sameCreature && connectedConnectedCell.properties.creatureId != creatureId) {
+                    continue;
+                }
+                connectedConnectedCell.properties.energy += energyPerReceiver;
+                energyDelta -= energyPerReceiver;
+            }
+        }
+    }
+
+    if (transmitter.mode == EnergyDistributionMode_TransmittersAndConstructors) {
+        auto matchActiveConstructorFunc = [&](int otherIndex) {
+            auto& otherCell = cells[otherIndex];
+            if (otherCell.properties.livingState != LivingState_Ready) {
+                return false;
+            }
+            if (otherCell.properties.getCellFunctionType() == CellFunction_Constructor) {
+                if (!CpuGenomeDecoder::isFinished(CpuCellFunctionProcessor::getCellFunction<ConstructorDescription>(otherCell))
+                    && (!sameCreature || otherCell.properties.creatureId == creatureId)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        auto matchTransmitterFunc = [&](int otherIndex) {
+            auto const& otherProperties = cells[otherIndex].properties;
+            if (otherProperties.livingState != LivingState_Ready) {
+                return false;
+            }
+            return otherProperties.getCellFunctionType() == CellFunction_Transmitter && (!sameCreature || otherProperties.creatureId == creatureId);
+        };
+
+        std::vector<int> receiverCells;
+        auto const& radius = parameters.cellFunctionTransmitterEnergyDistributionRadius[color];
+        CpuCellFunctionProcessor::getMatchingCells(data, receiverCells, 20, cell.properties.pos, radius, cell.detached, matchActiveConstructorFunc);
+        if (receiverCells.empty()) {
+            CpuCellFunctionProcessor::getMatchingCells(data, receiverCells, 20, cell.properties.pos, radius, cell.detached, matchTransmitterFunc);
+        }
+        float energyPerReceiver = energyDelta / toFloat(receiverCells.size() + 1);
+
+        for (auto const& receiverIndex : receiverCells) {
+            cells[receiverIndex].properties.energy += energyPerReceiver;
+            energyDelta -= energyPerReceiver;
+        }
+    }
+
+    cell.properties.energy += energyDelta;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "CpuCellFunctionProcessor.h"
+
+//counterpart of TransmitterProcessor on the GPU
+class CpuTransmitterProcessor
+{
+public:
+    static void process(CpuCellFunctionData& data, AccumulatedStatistics& statistics);
+
+private:
+    static void processCell(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex);
+    static void distributeEnergy(CpuCellFunctionData& data, AccumulatedStatistics& statistics, int cellIndex);
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <memory>
+
+struct CpuCell;
+struct CpuParticle;
+struct CpuSimulationData;
+
+class _ClusteredDataReaderCpu;
+using ClusteredDataReaderCpu = std::shared_ptr<_ClusteredDataReaderCpu>;
@@ -0,0 +1,746 @@
+#include "SimulationFacadeCpu.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "Base/MetricsService.h"
+#include "Base/NumberGenerator.h"
+#include "Base/ParallelService.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/InspectedEntityIds.h"
+#include "EngineInterface/StatisticsService.h"
+#include "EngineInterface/TimestepBatchService.h"
+#include "EngineInterface/TransferBufferStatistics.h"
+
+#include "ClusteredDataReaderCpu.h"
+#include "CpuDescriptionConverter.h"
+#include "CpuEditService.h"
+#include "CpuMutationProcessor.h"
+#include "CpuStatisticsService.h"
+
+namespace
+{
+    std::chrono::milliseconds const StatisticsUpdate(30);
+
+    //editing operations are applied directly under the data lock since they are cheap compared to a time step
+    std::future<void> getCompletedFuture()
+    {
+        std::promise<void> promise;
+        promise.set_value();
+        return promise.get_future();
+    }
+
+    //failing edits are reported on their futures as by the GPU engine worker
+    std::future<void> getFailedFuture(std::exception_ptr const& exception)
+    {
+        std::promise<void> promise;
+        promise.set_exception(exception);
+        return promise.get_future();
+    }
+}
+
+_SimulationFacadeCpu::~_SimulationFacadeCpu()
+{
+    if (_thread.joinable()) {
+        closeSimulation();
+    }
+}
+
+void _SimulationFacadeCpu::newSimulation(
+    std::optional<std::string> const& simulationName,
+    uint64_t timestep,
+    GeneralSettings const& generalSettings,
+    SimulationParameters const& parameters)
+{
+    _simulationName = simulationName.value_or("<unnamed>");
+    _generalSettings = generalSettings;
+    _origSettings.generalSettings = generalSettings;
+    _origSettings.simulationParameters = parameters;
+
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        _data = CpuSimulationData();
+        _data.timestep = timestep;
+        _parameters = parameters;
+        auto& numberGenerator = NumberGenerator::get();
+        auto seed = (static_cast<uint64_t>(numberGenerator.getRandomInt()) << 32) | numberGenerator.getRandomInt();
+        _processor.emplace(getWorldSize(), seed);
+        _accumulatedStatistics = AccumulatedStatistics();
+        _lastStatisticsUpdateTime.reset();
+        _averageTimestepDuration = 0;
+        ++_parametersVersion;
+        onEntitiesChanged();
+        _statisticsService = std::make_shared<_StatisticsService>();
+        _statisticsHistory.clear();
+    }
+    {
+        std::lock_guard lock(_mutexForStatistics);
+        _statisticsData = RawStatisticsData();
+    }
+
+    _isShutdown = false;
+    _thread = std::thread(&_SimulationFacadeCpu::runThreadLoop, this);
+
+    _selectionNeedsUpdate = true;
+    _realTime = std::chrono::milliseconds(0);
+    _simRunTimePoint.reset();
+
+    ++_sessionId;
+}
+
+std::string _SimulationFacadeCpu::getSimulationName() const
+{
+    return _simulationName;
+}
+
+int _SimulationFacadeCpu::getSessionId() const
+{
+    return _sessionId;
+}
+
+void _SimulationFacadeCpu::clear()
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    _data.cells.clear();
+    _data.particles.clear();
+    onEntitiesChanged();
+
+    _selectionNeedsUpdate = true;
+}
+
+void _SimulationFacadeCpu::setImageResource(void* image) {}
+
+std::string _SimulationFacadeCpu::getGpuName() const
+{
+    return "CPU (" + std::to_string(ParallelService::getNumThreads()) + " threads)";
+}
+
+void _SimulationFacadeCpu::tryDrawVectorGraphics(
+    RealVector2D const& rectUpperLeft,
+    RealVector2D const& rectLowerRight,
+    IntVector2D const& imageSize,
+    double zoom)
+{
+    if (_syncSimulationWithRendering && _isSimulationRunning) {
+        std::lock_guard lock(_mutexForSimulationData);
+        for (int i = 0; i < _syncSimulationWithRenderingRatio; ++i) {
+            calcTimestepIntern();
+        }
+    }
+}
+
+std::optional<OverlayDescription> _SimulationFacadeCpu::tryDrawVectorGraphicsAndReturnOverlay(
+    RealVector2D const& rectUpperLeft,
+    RealVector2D const& rectLowerRight,
+    IntVector2D const& imageSize,
+    double zoom)
+{
+    tryDrawVectorGraphics(rectUpperLeft, rectLowerRight, imageSize, zoom);
+    return std::nullopt;
+}
+
+bool _SimulationFacadeCpu::isSyncSimulationWithRendering() const
+{
+    return _syncSimulationWithRendering;
+}
+
+void _SimulationFacadeCpu::setSyncSimulationWithRendering(bool value)
+{
+    {
+        std::lock_guard lock(_mutexForThreadLoop);
+        _syncSimulationWithRendering = value;
+    }
+    _conditionForThreadLoop.notify_all();
+}
+
+int _SimulationFacadeCpu::getSyncSimulationWithRenderingRatio() const
+{
+    return _syncSimulationWithRenderingRatio;
+}
+
+void _SimulationFacadeCpu::setSyncSimulationWithRenderingRatio(int value)
+{
+    _syncSimulationWithRenderingRatio = value;
+}
+
+ClusteredDataDescription _SimulationFacadeCpu::getClusteredSimulationData()
+{
+    return CpuDescriptionConverter::convertToClusteredDataDescription(getSimulationData());
+}
+
+ClusteredDataReader _SimulationFacadeCpu::getClusteredSimulationDataReader()
+{
+    return std::make_shared<_ClusteredDataReaderCpu>(getSimulationData());
+}
+
+DataDescription _SimulationFacadeCpu::getSimulationData()
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    ++_numTransfers;
+    CpuDescriptionConverter converter(getWorldSize());
+    return converter.convertToDataDescription(_data, [](CpuCell const&) { return true; }, [](CpuParticle const&) { return true; });
+}
+
+ClusteredDataDescription _SimulationFacadeCpu::getSelectedClusteredSimulationData(bool includeClusters)
+{
+    return CpuDescriptionConverter::convertToClusteredDataDescription(getSelectedSimulationData(includeClusters));
+}
+
+DataDescription _SimulationFacadeCpu::getSelectedSimulationData(bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    ++_numTransfers;
+    CpuEditService::updateSelection(_data);
+
+    CpuDescriptionConverter converter(getWorldSize());
+    return converter.convertToDataDescription(
+        _data,
+        [&](CpuCell const& cell) { return includeClusters ? cell.selected != 0 : cell.selected == 1; },
+        [](CpuParticle const& particle) { return particle.selected != 0; });
+}
+
+DataDescription _SimulationFacadeCpu::getInspectedSimulationData(std::vector<uint64_t> objectIds)
+{
+    if (objectIds.size() > Const::MaxInspectedObjects) {
+        return DataDescription();
+    }
+    auto isInspected = [&](uint64_t id) { return std::find(objectIds.begin(), objectIds.end(), id) != objectIds.end(); };
+
+    std::lock_guard lock(_mutexForSimulationData);
+    ++_numTransfers;
+    CpuDescriptionConverter converter(getWorldSize());
+    auto result = converter.convertToDataDescription(
+        _data,
+        [&](CpuCell const& cell) { return isInspected(cell.properties.id); },
+        [&](CpuParticle const& particle) { return isInspected(particle.properties.id); });
+
+    //inspected cells are delivered without connections as on the GPU
+    for (auto& cell : result.cells) {
+        cell.connections.clear();
+    }
+    return result;
+}
+
+void _SimulationFacadeCpu::addAndSelectSimulationData(DataDescription const& dataToAdd)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    ++_numTransfers;
+    CpuEditService::removeSelection(_data);
+
+    CpuDescriptionConverter converter(getWorldSize());
+    converter.addDescription(_data, dataToAdd, true, true);
+    CpuEditService::rolloutSelection(_data);
+    updateStatistics();
+    onEntitiesChanged();
+}
+
+void _SimulationFacadeCpu::setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate)
+{
+    setSimulationData(DataDescription(dataToUpdate));
+}
+
+void _SimulationFacadeCpu::setSimulationData(DataDescription const& dataToUpdate)
+{
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        ++_numTransfers;
+        _data.cells.clear();
+        _data.particles.clear();
+
+        CpuDescriptionConverter converter(getWorldSize());
+        converter.addDescription(_data, dataToUpdate, false, false);
+        updateStatistics();
+        onEntitiesChanged();
+    }
+    _selectionNeedsUpdate = true;
+}
+
+void _SimulationFacadeCpu::setSimulationDataFromSnapshotFile(std::string const& filename)
+{
+    throw std::runtime_error("Snapshot files are not supported by the CPU engine.");
+}
+
+void _SimulationFacadeCpu::saveSimulationDataToSnapshotFile(std::string const& filename)
+{
+    throw std::runtime_error("Snapshot files are not supported by the CPU engine.");
+}
+
+std::future<void> _SimulationFacadeCpu::removeSelectedObjects(bool includeClusters)
+{
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        CpuEditService::removeSelectedObjects(_data, includeClusters);
+        updateStatistics();
+    }
+    _selectionNeedsUpdate = true;
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::relaxSelectedObjects(bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::relaxSelectedObjects(_data, getWorldSize(), includeClusters);
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::uniformVelocitiesForSelectedObjects(bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::uniformVelocities(_data, includeClusters);
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::makeSticky(bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::makeSticky(_data, includeClusters);
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::removeStickiness(bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::removeStickiness(_data, includeClusters);
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::setBarrier(bool value, bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::setBarrier(_data, value, includeClusters);
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::colorSelectedObjects(unsigned char color, bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::colorSelectedObjects(_data, color, includeClusters);
+    updateStatistics();
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::reconnectSelectedObjects()
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::reconnectSelectedObjects(_data, getWorldSize(), _parameters);
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::setDetached(bool value)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::setDetached(_data, value);
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::changeCell(CellDescription const& changedCell)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    try {
+        CpuEditService::changeCell(_data, getWorldSize(), changedCell);
+    } catch (...) {
+        return getFailedFuture(std::current_exception());
+    }
+    updateStatistics();
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::changeParticle(ParticleDescription const& changedParticle)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::changeParticle(_data, getWorldSize(), changedParticle);
+    updateStatistics();
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+void _SimulationFacadeCpu::calcTimesteps(uint64_t timesteps)
+{
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        for (uint64_t i = 0; i < timesteps; ++i) {
+            calcTimestepIntern();
+        }
+        updateStatistics();
+    }
+    _selectionNeedsUpdate = true;
+}
+
+void _SimulationFacadeCpu::runSimulation()
+{
+    _simRunTimePoint = std::chrono::system_clock::now();
+    {
+        std::lock_guard lock(_mutexForThreadLoop);
+        _isSimulationRunning = true;
+    }
+    _conditionForThreadLoop.notify_all();
+}
+
+void _SimulationFacadeCpu::pauseSimulation()
+{
+    _isSimulationRunning = false;
+    {
+        //wait for the running time step
+        std::lock_guard lock(_mutexForSimulationData);
+    }
+    _tps.store(0);
+    _selectionNeedsUpdate = true;
+
+    _realTime = getRealTime();
+    _simRunTimePoint.reset();
+}
+
+void _SimulationFacadeCpu::applyCataclysm(int power) {}
+
+bool _SimulationFacadeCpu::isSimulationRunning() const
+{
+    return _isSimulationRunning;
+}
+
+void _SimulationFacadeCpu::closeSimulation()
+{
+    {
+        std::lock_guard lock(_mutexForThreadLoop);
+        _isShutdown = true;
+    }
+    _conditionForThreadLoop.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    _isSimulationRunning = false;
+    _selectionNeedsUpdate = true;
+}
+
+uint64_t _SimulationFacadeCpu::getCurrentTimestep() const
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    return _data.timestep;
+}
+
+void _SimulationFacadeCpu::setCurrentTimestep(uint64_t value)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    _data.timestep = value;
+    _statisticsService->resetTime(_statisticsHistory, value);
+    _accumulatedStatistics = AccumulatedStatistics();
+}
+
+std::chrono::milliseconds _SimulationFacadeCpu::getRealTime() const
+{
+    if (_simRunTimePoint) {
+        return _realTime + std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - *_simRunTimePoint);
+    } else {
+        return _realTime;
+    }
+}
+
+void _SimulationFacadeCpu::setRealTime(std::chrono::milliseconds const& value)
+{
+    _realTime = value;
+    if (_simRunTimePoint) {
+        _simRunTimePoint = std::chrono::system_clock::now();
+    }
+}
+
+SimulationParameters _SimulationFacadeCpu::getSimulationParameters() const
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    return _parameters;
+}
+
+SimulationParameters const& _SimulationFacadeCpu::getOriginalSimulationParameters() const
+{
+    return _origSettings.simulationParameters;
+}
+
+void _SimulationFacadeCpu::setSimulationParameters(SimulationParameters const& parameters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    _parameters = parameters;
+    ++_parametersVersion;
+}
+
+void _SimulationFacadeCpu::setOriginalSimulationParameters(SimulationParameters const& parameters)
+{
+    _origSettings.simulationParameters = parameters;
+}
+
+GpuSettings _SimulationFacadeCpu::getGpuSettings() const
+{
+    return _gpuSettings;
+}
+
+GpuSettings _SimulationFacadeCpu::getOriginalGpuSettings() const
+{
+    return _origSettings.gpuSettings;
+}
+
+void _SimulationFacadeCpu::setGpuSettings_async(GpuSettings const& gpuSettings)
+{
+    _gpuSettings = gpuSettings;
+}
+
+void _SimulationFacadeCpu::applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::applyForce(_data, getWorldSize(), start, end, force, radius);
+    onEntitiesChanged();
+}
+
+std::future<void> _SimulationFacadeCpu::switchSelection(RealVector2D const& pos, float radius)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::switchSelection(_data, getWorldSize(), pos, radius);
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::swapSelection(RealVector2D const& pos, float radius)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::swapSelection(_data, getWorldSize(), pos, radius);
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+SelectionShallowData _SimulationFacadeCpu::getSelectionShallowData(RealVector2D const& refPos)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    auto result = CpuEditService::getSelectionShallowData(_data, getWorldSize(), refPos, !_parameters.borderlessRendering);
+    _isSelectionEmpty = result.numCells == 0 && result.numClusterCells == 0 && result.numParticles == 0;
+    return result;
+}
+
+std::future<void> _SimulationFacadeCpu::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::shallowUpdateSelectedObjects(_data, getWorldSize(), _parameters, updateData);
+    updateStatistics();
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::setSelection(_data, getWorldSize(), startPos, endPos);
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+std::future<void> _SimulationFacadeCpu::removeSelection()
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    CpuEditService::removeSelection(_data);
+    updateStatistics();
+    onEntitiesChanged();
+    return getCompletedFuture();
+}
+
+bool _SimulationFacadeCpu::updateSelectionIfNecessary()
+{
+    auto result = _selectionNeedsUpdate;
+    _selectionNeedsUpdate = false;
+    if (result) {
+        std::lock_guard lock(_mutexForSimulationData);
+        CpuEditService::updateSelection(_data);
+        _isSelectionEmpty = false;
+        ++_selectionVersion;
+    }
+    return result;
+}
+
+GeneralSettings _SimulationFacadeCpu::getGeneralSettings() const
+{
+    return _generalSettings;
+}
+
+IntVector2D _SimulationFacadeCpu::getWorldSize() const
+{
+    return {_generalSettings.worldSizeX, _generalSettings.worldSizeY};
+}
+
+RawStatisticsData _SimulationFacadeCpu::getRawStatistics() const
+{
+    std::lock_guard lock(_mutexForStatistics);
+    return _statisticsData;
+}
+
+StatisticsHistory const& _SimulationFacadeCpu::getStatisticsHistory() const
+{
+    return _statisticsHistory;
+}
+
+void _SimulationFacadeCpu::setStatisticsHistory(StatisticsHistorySnapshot const& data)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    _statisticsService->rewriteHistory(_statisticsHistory, data);
+}
+
+TransferBufferStatistics _SimulationFacadeCpu::getTransferBufferStatistics() const
+{
+    //the CPU engine works directly on the host data, i.e. each transfer can be regarded as a hit
+    std::lock_guard lock(_mutexForSimulationData);
+    return TransferBufferStatistics{.numHits = _numTransfers};
+}
+
+std::optional<int> _SimulationFacadeCpu::getTpsRestriction() const
+{
+    auto result = _tpsRestriction.load();
+    return 0 != result ? std::optional<int>(result) : std::optional<int>();
+}
+
+void _SimulationFacadeCpu::setTpsRestriction(std::optional<int> const& value)
+{
+    _tpsRestriction.store(value ? *value : 0);
+}
+
+float _SimulationFacadeCpu::getTps() const
+{
+    return _tps.load();
+}
+
+SimulationVersions _SimulationFacadeCpu::getVersions() const
+{
+    return {.parameters = _parametersVersion.load(), .selection = _selectionVersion.load(), .entities = _entitiesVersion.load()};
+}
+
+void _SimulationFacadeCpu::testOnly_mutate(uint64_t cellId, MutationType mutationType)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    for (auto& cell : _data.cells) {
+        if (!cell.deleted && cell.properties.id == cellId) {
+            CpuRandom random(static_cast<uint64_t>(NumberGenerator::get().getRandomInt()), _data.timestep, CpuRandomStage_Mutation, cellId);
+            CpuMutationProcessor::applyMutation(_data, _parameters, random, cell, mutationType);
+        }
+    }
+    onEntitiesChanged();
+}
+
+void _SimulationFacadeCpu::runThreadLoop()
+{
+    while (true) {
+        {
+            std::unique_lock lock(_mutexForThreadLoop);
+            _conditionForThreadLoop.wait(lock, [this] { return _isShutdown || (_isSimulationRunning && !_syncSimulationWithRendering); });
+            MetricsService::incrementCounter("engine.wakeUps");
+            if (_isShutdown) {
+                break;
+            }
+        }
+        auto timesteps = calcTimestepBatch();
+        measureTPS(timesteps);
+        slowdownTPS();
+    }
+    _tps.store(0);
+}
+
+int _SimulationFacadeCpu::calcTimestepBatch()
+{
+    auto batchSize = TimestepBatchService::calcBatchSize(_averageTimestepDuration, _tpsRestriction.load());
+
+    std::lock_guard lock(_mutexForSimulationData);
+    if (isTimestepBatchStopped()) {
+        return 0;
+    }
+    auto startTimepoint = std::chrono::steady_clock::now();
+    auto result = TimestepBatchService::calcBatch(
+        batchSize, [this] { calcTimestepIntern(); }, [this] { return isTimestepBatchStopped() || _mutexForSimulationData.hasWaitingThreads(); });
+
+    auto timestepDuration = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - startTimepoint).count() / toFloat(result);
+    _averageTimestepDuration = TimestepBatchService::calcAverageTimestepDuration(_averageTimestepDuration, timestepDuration);
+    return result;
+}
+
+bool _SimulationFacadeCpu::isTimestepBatchStopped() const
+{
+    return !_isSimulationRunning.load() || _isShutdown.load() || _syncSimulationWithRendering.load();
+}
+
+void _SimulationFacadeCpu::calcTimestepIntern()
+{
+    _processor->calcTimestep(_data, _parameters, _accumulatedStatistics);
+    if (_processor->updateSimulationParametersAfterTimestep(_parameters)) {
+        ++_parametersVersion;
+    }
+    ++_entitiesVersion;
+    if (!_isSelectionEmpty) {
+        ++_selectionVersion;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (!_lastStatisticsUpdateTime || now - *_lastStatisticsUpdateTime > StatisticsUpdate) {
+        _lastStatisticsUpdateTime = now;
+        updateStatistics();
+    }
+}
+
+void _SimulationFacadeCpu::onEntitiesChanged()
+{
+    _isSelectionEmpty = false;
+    ++_selectionVersion;
+    ++_entitiesVersion;
+}
+
+void _SimulationFacadeCpu::updateStatistics()
+{
+    auto statistics = CpuStatisticsService::calcRawStatistics(_data, _accumulatedStatistics);
+    {
+        std::lock_guard lock(_mutexForStatistics);
+        _statisticsData = statistics;
+    }
+    _statisticsService->addDataPoint(_statisticsHistory, statistics.timeline, _data.timestep);
+}
+
+void _SimulationFacadeCpu::measureTPS(int timesteps)
+{
+    if (_isSimulationRunning) {
+        auto timepoint = std::chrono::steady_clock::now();
+        if (!_measureTimepoint) {
+            _measureTimepoint = timepoint;
+        } else {
+            int duration = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(timepoint - *_measureTimepoint).count());
+            if (duration > 199) {
+                _measureTimepoint = timepoint;
+                if (duration < 350) {
+                    _tps.store(toFloat(_timestepsSinceMeasurement) * 5 * 200 / duration);
+                } else {
+                    _tps.store(1000.0f / duration);
+                }
+                _timestepsSinceMeasurement = 0;
+            }
+        }
+        _timestepsSinceMeasurement += timesteps;
+    } else {
+        _tps.store(0);
+    }
+}
+
+void _SimulationFacadeCpu::slowdownTPS()
+{
+    if (_slowDownTimepoint) {
+        auto timestepDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - *_slowDownTimepoint);
+        if (_slowDownOvershot) {
+            timestepDuration += *_slowDownOvershot;
+        }
+        auto tpsRestriction = _tpsRestriction.load();
+        if (_isSimulationRunning && tpsRestriction > 0) {
+            auto desiredDuration = std::chrono::microseconds(1000000 / tpsRestriction);
+            if (desiredDuration > timestepDuration) {
+                std::this_thread::sleep_for(desiredDuration - timestepDuration);
+            }
+            _slowDownOvershot = std::min(std::max(timestepDuration - desiredDuration, std::chrono::microseconds(0)), desiredDuration);
+        }
+    }
+    _slowDownTimepoint = std::chrono::steady_clock::now();
+}
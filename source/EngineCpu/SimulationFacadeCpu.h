@@ -0,0 +1,210 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/OverlayDescriptions.h"
+#include "EngineInterface/SimulationFacade.h"
+#include "EngineInterface/StatisticsHistory.h"
+
+#include "CpuObjects.h"
+#include "CpuTimestepProcessor.h"
+#include "Definitions.h"
+
+//simulation backend running on the CPU threads of ParallelService, does not require CUDA
+//rendering and snapshot files are not supported
+class _SimulationFacadeCpu : public _SimulationFacade
+{
+public:
+    ~_SimulationFacadeCpu() override;
+
+    void newSimulation(
+        std::optional<std::string> const& simulationName,
+        uint64_t timestep,
+        GeneralSettings const& generalSettings,
+        SimulationParameters const& parameters) override;
+
+    std::string getSimulationName() const override;
+    int getSessionId() const override;
+
+    void clear() override;
+
+    void setImageResource(void* image) override;
+    std::string getGpuName() const override;
+
+    void tryDrawVectorGraphics(
+        RealVector2D const& rectUpperLeft,
+        RealVector2D const& rectLowerRight,
+        IntVector2D const& imageSize,
+        double zoom) override;
+    std::optional<OverlayDescription>
+    tryDrawVectorGraphicsAndReturnOverlay(
+        RealVector2D const& rectUpperLeft,
+        RealVector2D const& rectLowerRight,
+        IntVector2D const& imageSize,
+        double zoom) override;
+
+    bool isSyncSimulationWithRendering() const override;
+    void setSyncSimulationWithRendering(bool value) override;
+    int getSyncSimulationWithRenderingRatio() const override;
+    void setSyncSimulationWithRenderingRatio(int value) override;
+
+    ClusteredDataDescription getClusteredSimulationData() override;
+    ClusteredDataReader getClusteredSimulationDataReader() override;
+    DataDescription getSimulationData() override;
+    ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters) override;
+    DataDescription getSelectedSimulationData(bool includeClusters) override;
+    DataDescription getInspectedSimulationData(std::vector<uint64_t> objectIds) override;
+
+    void addAndSelectSimulationData(DataDescription const& dataToAdd) override;
+    void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) override;
+    void setSimulationData(DataDescription const& dataToUpdate) override;
+    void setSimulationDataFromSnapshotFile(std::string const& filename) override;
+    void saveSimulationDataToSnapshotFile(std::string const& filename) override;
+    std::future<void> removeSelectedObjects(bool includeClusters) override;
+    std::future<void> relaxSelectedObjects(bool includeClusters) override;
+    std::future<void> uniformVelocitiesForSelectedObjects(bool includeClusters) override;
+    std::future<void> makeSticky(bool includeClusters) override;
+    std::future<void> removeStickiness(bool includeClusters) override;
+    std::future<void> setBarrier(bool value, bool includeClusters) override;
+    std::future<void> colorSelectedObjects(unsigned char color, bool includeClusters) override;
+    std::future<void> reconnectSelectedObjects() override;
+    std::future<void> setDetached(bool value) override;
+    std::future<void> changeCell(CellDescription const& changedCell) override;
+    std::future<void> changeParticle(ParticleDescription const& changedParticle) override;
+
+    void calcTimesteps(uint64_t timesteps) override;
+    void runSimulation() override;
+    void pauseSimulation() override;
+    void applyCataclysm(int power) override;
+
+    bool isSimulationRunning() const override;
+
+    void closeSimulation() override;
+
+    uint64_t getCurrentTimestep() const override;
+    void setCurrentTimestep(uint64_t value) override;
+
+    std::chrono::milliseconds getRealTime() const override;
+    void setRealTime(std::chrono::milliseconds const& value) override;
+
+    SimulationParameters getSimulationParameters() const override;
+    SimulationParameters const& getOriginalSimulationParameters() const override;
+    void setSimulationParameters(SimulationParameters const& parameters) override;
+    void setOriginalSimulationParameters(SimulationParameters const& parameters) override;
+
+    GpuSettings getGpuSettings() const override;
+    GpuSettings getOriginalGpuSettings() const override;
+    void setGpuSettings_async(GpuSettings const& gpuSettings) override;
+
+    void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius) override;
+
+    std::future<void> switchSelection(RealVector2D const& pos, float radius) override;
+    std::future<void> swapSelection(RealVector2D const& pos, float radius) override;
+    SelectionShallowData getSelectionShallowData(RealVector2D const& refPos = RealVector2D()) override;
+    std::future<void> shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData) override;
+    std::future<void> setSelection(RealVector2D const& startPos, RealVector2D const& endPos) override;
+    std::future<void> removeSelection() override;
+    bool updateSelectionIfNecessary() override;
+
+    GeneralSettings getGeneralSettings() const override;
+    IntVector2D getWorldSize() const override;
+    RawStatisticsData getRawStatistics() const override;
+    StatisticsHistory const& getStatisticsHistory() const override;
+    void setStatisticsHistory(StatisticsHistorySnapshot const& data) override;
+    TransferBufferStatistics getTransferBufferStatistics() const override;
+
+    std::optional<int> getTpsRestriction() const override;
+    void setTpsRestriction(std::optional<int> const& value) override;
+
+    float getTps() const override;
+
+    SimulationVersions getVersions() const override;
+
+    //for tests
+    void testOnly_mutate(uint64_t cellId, MutationType mutationType) override;
+
+private:
+    void runThreadLoop();
+    int calcTimestepBatch();    //returns the number of calculated time steps
+    bool isTimestepBatchStopped() const;
+    void calcTimestepIntern();  //_mutexForSimulationData must be locked
+    void updateStatistics();    //_mutexForSimulationData must be locked
+    void onEntitiesChanged();   //conservatively regards the selection as changed too
+    void measureTPS(int timesteps = 1);
+    void slowdownTPS();
+
+    bool _selectionNeedsUpdate = false;
+    int _sessionId = 0;
+
+    std::string _simulationName;
+    Settings _origSettings;
+    GeneralSettings _generalSettings;
+    GpuSettings _gpuSettings;
+    std::chrono::milliseconds _realTime;
+    std::optional<std::chrono::time_point<std::chrono::system_clock>> _simRunTimePoint;
+
+    //simulation data
+    //the mutex counts the threads waiting for it such that the simulation thread can interrupt a batch of time steps
+    class DataMutex
+    {
+    public:
+        void lock()
+        {
+            ++_numWaitingThreads;
+            _mutex.lock();
+            --_numWaitingThreads;
+        }
+        void unlock() { _mutex.unlock(); }
+        bool hasWaitingThreads() const { return _numWaitingThreads.load() > 0; }
+
+    private:
+        std::mutex _mutex;
+        std::atomic<int> _numWaitingThreads{0};
+    };
+    mutable DataMutex _mutexForSimulationData;
+    CpuSimulationData _data;
+    SimulationParameters _parameters;
+    std::optional<CpuTimestepProcessor> _processor;
+    AccumulatedStatistics _accumulatedStatistics;
+    std::optional<std::chrono::steady_clock::time_point> _lastStatisticsUpdateTime;
+    uint64_t _numTransfers = 0;
+
+    mutable std::mutex _mutexForStatistics;
+    RawStatisticsData _statisticsData;
+    StatisticsService _statisticsService;
+    StatisticsHistory _statisticsHistory;
+
+    //simulation thread
+    std::thread _thread;
+    std::mutex _mutexForThreadLoop;
+    std::condition_variable _conditionForThreadLoop;
+    std::atomic<bool> _isSimulationRunning{false};
+    std::atomic<bool> _isShutdown{false};
+    std::atomic<bool> _syncSimulationWithRendering{false};
+    std::atomic<int> _syncSimulationWithRenderingRatio{2};
+
+    //time step measurements
+    std::atomic<int> _tpsRestriction{0};  //0 = no restriction
+    std::atomic<float> _tps{0};
+    int _timestepsSinceMeasurement = 0;
+    std::optional<std::chrono::steady_clock::time_point> _measureTimepoint;
+    std::optional<std::chrono::steady_clock::time_point> _slowDownTimepoint;
+    std::optional<std::chrono::microseconds> _slowDownOvershot;
+    float _averageTimestepDuration = 0;  //in microseconds, used to adapt the number of time steps per batch
+
+    //change versions
+    std::atomic<uint64_t> _parametersVersion{0};
+    std::atomic<uint64_t> _selectionVersion{0};
+    std::atomic<uint64_t> _entitiesVersion{0};
+    std::atomic<bool> _isSelectionEmpty{false};  //result of the last selection read back, time steps do not change an empty selection
+};
@@ -645,6 +645,21 @@ __inline__ __device__ void CellProcessor::livingStateTransition(SimulationData&
                 atomicExch(&cell->livingState, LivingState_Ready);
             }
         }
+        if (origLivingState == LivingState_Dying && cudaSimulationParameters.cellDeathConsequences != CellDeathConsquences_None) {
+            for (int i = 0; i < cell->numConnections; ++i) {
+                auto const& connectedCell = cell->connections[i].cell;
+                if (connectedCell->creatureId != cell->creatureId) {
+                    continue;
+                }
+                //non-separating self-replicators survive so that the creature can be rebuilt
+                if (connectedCell->cellFunction == CellFunction_Constructor
+                    && GenomeDecoder::containsSelfReplication(connectedCell->cellFunctionData.constructor)
+                    && !GenomeDecoder::isSeparating(connectedCell->cellFunctionData.constructor.genome)) {
+                    continue;
+                }
+                atomicExch(&connectedCell->livingState, LivingState_Dying);
+            }
+        }
     }
 }
 
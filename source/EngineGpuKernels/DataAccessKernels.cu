@@ -362,6 +362,66 @@ __global__ void cudaGetParticleData(int2 rectUpperLeft, int2 rectLowerRight, Sim
     }
 }
 
+//copies the cellTOs with the given indices in this order together with their auxiliary data
+//the connections still refer to indices of exportTO
+__global__ void cudaGetExportedCells(DataTO exportTO, uint64_t* cellIndices, uint64_t numCellIndices, DataTO dataTO)
+{
+    auto const partition = calcAllThreadsPartition(numCellIndices);
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const& sourceTO = exportTO.cells[cellIndices[index]];
+        auto& cellTO = dataTO.cells[index];
+        cellTO = sourceTO;
+        alienAtomicAdd64(dataTO.numCells, uint64_t(1));
+
+        copyAuxiliaryData(
+            sourceTO.metadata.nameSize,
+            exportTO.auxiliaryData + sourceTO.metadata.nameDataIndex,
+            cellTO.metadata.nameSize,
+            cellTO.metadata.nameDataIndex,
+            *dataTO.numAuxiliaryData,
+            dataTO.auxiliaryData);
+        copyAuxiliaryData(
+            sourceTO.metadata.descriptionSize,
+            exportTO.auxiliaryData + sourceTO.metadata.descriptionDataIndex,
+            cellTO.metadata.descriptionSize,
+            cellTO.metadata.descriptionDataIndex,
+            *dataTO.numAuxiliaryData,
+            dataTO.auxiliaryData);
+
+        switch (sourceTO.cellFunction) {
+        case CellFunction_Neuron: {
+            int targetSize;  //not used
+            copyAuxiliaryData<int>(
+                sizeof(NeuronFunction::NeuronState),
+                exportTO.auxiliaryData + sourceTO.cellFunctionData.neuron.weightsAndBiasesDataIndex,
+                targetSize,
+                cellTO.cellFunctionData.neuron.weightsAndBiasesDataIndex,
+                *dataTO.numAuxiliaryData,
+                dataTO.auxiliaryData);
+        } break;
+        case CellFunction_Constructor: {
+            copyAuxiliaryData(
+                sourceTO.cellFunctionData.constructor.genomeSize,
+                exportTO.auxiliaryData + sourceTO.cellFunctionData.constructor.genomeDataIndex,
+                cellTO.cellFunctionData.constructor.genomeSize,
+                cellTO.cellFunctionData.constructor.genomeDataIndex,
+                *dataTO.numAuxiliaryData,
+                dataTO.auxiliaryData);
+        } break;
+        case CellFunction_Injector: {
+            copyAuxiliaryData(
+                sourceTO.cellFunctionData.injector.genomeSize,
+                exportTO.auxiliaryData + sourceTO.cellFunctionData.injector.genomeDataIndex,
+                cellTO.cellFunctionData.injector.genomeSize,
+                cellTO.cellFunctionData.injector.genomeDataIndex,
+                *dataTO.numAuxiliaryData,
+                dataTO.auxiliaryData);
+        } break;
+        }
+    }
+}
+
 __global__ void cudaCreateDataFromTO(SimulationData data, DataTO dataTO, bool selectNewData, bool createIds)
 {
     __shared__ ObjectFactory factory;
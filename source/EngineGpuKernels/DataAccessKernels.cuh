@@ -22,6 +22,7 @@ __global__ void cudaGetOverlayData(int2 rectUpperLeft, int2 rectLowerRight, Simu
 __global__ void cudaGetCellDataWithoutConnections(int2 rectUpperLeft, int2 rectLowerRight, SimulationData data, DataTO dataTO);
 __global__ void cudaResolveConnections(SimulationData data, DataTO dataTO);
 __global__ void cudaGetParticleData(int2 rectUpperLeft, int2 rectLowerRight, SimulationData data, DataTO access);
+__global__ void cudaGetExportedCells(DataTO exportTO, uint64_t* cellIndices, uint64_t numCellIndices, DataTO dataTO);
 __global__ void cudaCreateDataFromTO(SimulationData data, DataTO dataTO, bool selectNewData, bool createIds);
 __global__ void cudaAdaptNumberGenerator(CudaNumberGenerator numberGen, DataTO dataTO);
 __global__ void cudaClearDataTO(DataTO dataTO);
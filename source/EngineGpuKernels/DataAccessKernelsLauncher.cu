@@ -59,6 +59,17 @@ void _DataAccessKernelsLauncher::getOverlayData(
     KERNEL_CALL(cudaGetOverlayData, rectUpperLeft, rectLowerRight, data, dataTO);
 }
 
+void _DataAccessKernelsLauncher::getExportedCells(
+    GpuSettings const& gpuSettings,
+    DataTO const& exportTO,
+    uint64_t* cellIndices,
+    uint64_t numCellIndices,
+    DataTO const& dataTO)
+{
+    KERNEL_CALL_1_1(cudaClearDataTO, dataTO);
+    KERNEL_CALL(cudaGetExportedCells, exportTO, cellIndices, numCellIndices, dataTO);
+}
+
 void _DataAccessKernelsLauncher::addData(GpuSettings const& gpuSettings, SimulationData const& data, DataTO const& dataTO, bool selectData, bool createIds)
 {
     KERNEL_CALL_1_1(cudaSaveNumEntries, data);
@@ -17,6 +17,7 @@ public:
     void getSelectedData(GpuSettings const& gpuSettings, SimulationData const& data, bool includeClusters, DataTO const& dataTO);
     void getInspectedData(GpuSettings const& gpuSettings, SimulationData const& data, InspectedEntityIds entityIds, DataTO const& dataTO);
     void getOverlayData(GpuSettings const& gpuSettings, SimulationData const& data, int2 rectUpperLeft, int2 rectLowerRight, DataTO const& dataTO);
+    void getExportedCells(GpuSettings const& gpuSettings, DataTO const& exportTO, uint64_t* cellIndices, uint64_t numCellIndices, DataTO const& dataTO);
 
     void addData(GpuSettings const& gpuSettings, SimulationData const& data, DataTO const& dataTO, bool selectData, bool createIds);
     void clearData(GpuSettings const& gpuSettings, SimulationData const& data);
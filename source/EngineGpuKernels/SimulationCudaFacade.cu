@@ -1,5 +1,6 @@
 #include "SimulationCudaFacade.cuh"
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <list>
@@ -17,6 +18,7 @@
 #include "EngineInterface/SimulationParameters.h"
 #include "EngineInterface/GpuSettings.h"
 #include "EngineInterface/SpaceCalculator.h"
+#include "EngineInterface/StatisticsService.h"
 
 #include "DataAccessKernels.cuh"
 #include "TOs.cuh"
@@ -39,7 +41,6 @@
 #include "SelectionResult.cuh"
 #include "RenderingData.cuh"
 #include "TestKernelsLauncher.cuh"
-#include "StatisticsService.cuh"
 
 namespace
 {
@@ -61,6 +62,7 @@ _SimulationCudaFacade::_SimulationCudaFacade(uint64_t timestep, Settings const&
     _cudaRenderingData = std::make_shared<RenderingData>();
     _cudaSelectionResult = std::make_shared<SelectionResult>();
     _cudaAccessTO = std::make_shared<DataTO>();
+    _cudaExportTO = std::make_shared<DataTO>();
     _cudaSimulationStatistics = std::make_shared<SimulationStatistics>();
     _statisticsService = std::make_shared<_StatisticsService>();
 
@@ -98,6 +100,7 @@ _SimulationCudaFacade::~_SimulationCudaFacade()
     _editKernels.reset();
     _statisticsKernels.reset();
 
+    releaseExportedData();
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->cells);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->particles);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->auxiliaryData);
@@ -142,6 +145,7 @@ void _SimulationCudaFacade::calcTimestep(uint64_t timesteps, bool forceUpdateSta
         {
             std::lock_guard lock(_mutexForSimulationParameters);
             if (_simulationKernels->updateSimulationParametersAfterTimestep(_settings, simulationData, statistics)) {
+                ++_numSimulationParametersUpdatesAfterTimestep;
                 CHECK_FOR_CUDA_ERROR(
                     cudaMemcpyToSymbol(cudaSimulationParameters, &_settings.simulationParameters, sizeof(SimulationParameters), 0, cudaMemcpyHostToDevice));
             }
@@ -247,6 +251,86 @@ void _SimulationCudaFacade::getOverlayData(int2 const& rectUpperLeft, int2 const
     copyToHost(dataTO.particles, _cudaAccessTO->particles, *dataTO.numParticles);
 }
 
+ArraySizes _SimulationCudaFacade::exportSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight)
+{
+    releaseExportedData();
+
+    _dataAccessKernels->getData(_settings.gpuSettings, getSimulationDataIntern(), rectUpperLeft, rectLowerRight, *_cudaAccessTO);
+    syncAndCheck();
+
+    ArraySizes result{copyToHost(_cudaAccessTO->numCells), copyToHost(_cudaAccessTO->numParticles), copyToHost(_cudaAccessTO->numAuxiliaryData)};
+
+    //the export buffer has the exact size of the data and not the capacity of the simulation arrays
+    CudaMemoryManager::getInstance().acquireMemory<CellTO>(std::max(result.cellArraySize, uint64_t(1)), _cudaExportTO->cells);
+    CudaMemoryManager::getInstance().acquireMemory<ParticleTO>(std::max(result.particleArraySize, uint64_t(1)), _cudaExportTO->particles);
+    CudaMemoryManager::getInstance().acquireMemory<uint8_t>(std::max(result.auxiliaryDataSize, uint64_t(1)), _cudaExportTO->auxiliaryData);
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(_cudaExportTO->cells, _cudaAccessTO->cells, sizeof(CellTO) * result.cellArraySize, cudaMemcpyDeviceToDevice));
+    CHECK_FOR_CUDA_ERROR(
+        cudaMemcpy(_cudaExportTO->particles, _cudaAccessTO->particles, sizeof(ParticleTO) * result.particleArraySize, cudaMemcpyDeviceToDevice));
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(_cudaExportTO->auxiliaryData, _cudaAccessTO->auxiliaryData, result.auxiliaryDataSize, cudaMemcpyDeviceToDevice));
+
+    _exportedDataSizes = result;
+    return result;
+}
+
+void _SimulationCudaFacade::getExportedCells(uint64_t startIndex, uint64_t endIndex, DataTO const& dataTO)
+{
+    CHECK(_exportedDataSizes && startIndex <= endIndex && endIndex <= _exportedDataSizes->cellArraySize);
+
+    *dataTO.numCells = endIndex - startIndex;
+    *dataTO.numParticles = 0;
+    *dataTO.numAuxiliaryData = 0;
+    copyToHost(dataTO.cells, _cudaExportTO->cells + startIndex, toInt(endIndex - startIndex));
+}
+
+void _SimulationCudaFacade::getExportedCells(std::vector<uint64_t> const& cellIndices, uint64_t auxiliaryDataSize, DataTO const& dataTO)
+{
+    CHECK(_exportedDataSizes);
+
+    //the cells and their auxiliary data are gathered in a temporary device buffer of the chunk size
+    auto numCells = cellIndices.size();
+    uint64_t* cudaCellIndices;
+    DataTO cudaChunkTO = *_cudaAccessTO;
+    CudaMemoryManager::getInstance().acquireMemory<uint64_t>(std::max(numCells, size_t(1)), cudaCellIndices);
+    CudaMemoryManager::getInstance().acquireMemory<CellTO>(std::max(numCells, size_t(1)), cudaChunkTO.cells);
+    CudaMemoryManager::getInstance().acquireMemory<uint8_t>(std::max(auxiliaryDataSize, uint64_t(1)), cudaChunkTO.auxiliaryData);
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(cudaCellIndices, cellIndices.data(), sizeof(uint64_t) * numCells, cudaMemcpyHostToDevice));
+
+    _dataAccessKernels->getExportedCells(_settings.gpuSettings, *_cudaExportTO, cudaCellIndices, numCells, cudaChunkTO);
+    syncAndCheck();
+
+    copyToHost(dataTO.numCells, cudaChunkTO.numCells);
+    copyToHost(dataTO.numAuxiliaryData, cudaChunkTO.numAuxiliaryData);
+    *dataTO.numParticles = 0;
+    copyToHost(dataTO.cells, cudaChunkTO.cells, toInt(*dataTO.numCells));
+    copyToHost(dataTO.auxiliaryData, cudaChunkTO.auxiliaryData, toInt(*dataTO.numAuxiliaryData));
+
+    CudaMemoryManager::getInstance().freeMemory(cudaCellIndices);
+    CudaMemoryManager::getInstance().freeMemory(cudaChunkTO.cells);
+    CudaMemoryManager::getInstance().freeMemory(cudaChunkTO.auxiliaryData);
+}
+
+void _SimulationCudaFacade::getExportedParticles(uint64_t startIndex, uint64_t endIndex, DataTO const& dataTO)
+{
+    CHECK(_exportedDataSizes && startIndex <= endIndex && endIndex <= _exportedDataSizes->particleArraySize);
+
+    *dataTO.numCells = 0;
+    *dataTO.numParticles = endIndex - startIndex;
+    *dataTO.numAuxiliaryData = 0;
+    copyToHost(dataTO.particles, _cudaExportTO->particles + startIndex, toInt(endIndex - startIndex));
+}
+
+void _SimulationCudaFacade::releaseExportedData()
+{
+    if (!_exportedDataSizes) {
+        return;
+    }
+    CudaMemoryManager::getInstance().freeMemory(_cudaExportTO->cells);
+    CudaMemoryManager::getInstance().freeMemory(_cudaExportTO->particles);
+    CudaMemoryManager::getInstance().freeMemory(_cudaExportTO->auxiliaryData);
+    _exportedDataSizes.reset();
+}
+
 void _SimulationCudaFacade::addAndSelectSimulationData(DataTO const& dataTO)
 {
     copyDataTOtoDevice(dataTO);
@@ -405,6 +489,12 @@ void _SimulationCudaFacade::setSimulationParameters(SimulationParameters const&
     _newSimulationParameters = parameters;
 }
 
+uint64_t _SimulationCudaFacade::getNumSimulationParametersUpdatesAfterTimestep() const
+{
+    std::lock_guard lock(_mutexForSimulationParameters);
+    return _numSimulationParametersUpdatesAfterTimestep;
+}
+
 auto _SimulationCudaFacade::getArraySizes() const -> ArraySizes
 {
     return {
@@ -441,9 +531,9 @@ StatisticsHistory const& _SimulationCudaFacade::getStatisticsHistory() const
     return _statisticsHistory;
 }
 
-void _SimulationCudaFacade::setStatisticsHistory(StatisticsHistoryData const& data)
+void _SimulationCudaFacade::setStatisticsHistory(StatisticsHistorySnapshot const& data)
 {
-    _statisticsService->rewriteHistory(_statisticsHistory, data, getCurrentTimestep());
+    _statisticsService->rewriteHistory(_statisticsHistory, data);
 }
 
 void _SimulationCudaFacade::resetTimeIntervalStatistics()
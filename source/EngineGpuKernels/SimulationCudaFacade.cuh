@@ -46,6 +46,15 @@ public:
     void getSelectedSimulationData(bool includeClusters, DataTO const& dataTO);
     void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO);
     void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO);
+
+    //copies the simulation data in the rect into a device buffer which is then transferred in parts to the host
+    //returns the number of exported cells, particles and auxiliary data bytes
+    ArraySizes exportSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight);
+    void getExportedCells(uint64_t startIndex, uint64_t endIndex, DataTO const& dataTO);  //without auxiliary data
+    void getExportedCells(std::vector<uint64_t> const& cellIndices, uint64_t auxiliaryDataSize, DataTO const& dataTO);
+    void getExportedParticles(uint64_t startIndex, uint64_t endIndex, DataTO const& dataTO);
+    void releaseExportedData();
+
     void addAndSelectSimulationData(DataTO const& dataTO);
     void setSimulationData(DataTO const& dataTO);
     void removeSelectedObjects(bool includeClusters);
@@ -71,13 +80,14 @@ public:
     void setGpuConstants(GpuSettings const& cudaConstants);
     SimulationParameters getSimulationParameters() const;
     void setSimulationParameters(SimulationParameters const& parameters);
+    uint64_t getNumSimulationParametersUpdatesAfterTimestep() const;  //e.g. caused by moving spots or radiation sources
 
     ArraySizes getArraySizes() const;
 
     RawStatisticsData getRawStatistics();
     void updateStatistics();
     StatisticsHistory const& getStatisticsHistory() const;
-    void setStatisticsHistory(StatisticsHistoryData const& data);
+    void setStatisticsHistory(StatisticsHistorySnapshot const& data);
 
     void resetTimeIntervalStatistics();
     uint64_t getCurrentTimestep() const;
@@ -107,6 +117,7 @@ private:
 
     mutable std::mutex _mutexForSimulationParameters;
     std::optional<SimulationParameters> _newSimulationParameters;
+    uint64_t _numSimulationParametersUpdatesAfterTimestep = 0;
     Settings _settings;
 
     mutable std::mutex _mutexForSimulationData;
@@ -115,6 +126,8 @@ private:
     std::shared_ptr<RenderingData> _cudaRenderingData;
     std::shared_ptr<SelectionResult> _cudaSelectionResult;
     std::shared_ptr<DataTO> _cudaAccessTO;
+    std::shared_ptr<DataTO> _cudaExportTO;
+    std::optional<ArraySizes> _exportedDataSizes;
 
     mutable std::mutex _mutexForStatistics;
     std::optional<std::chrono::steady_clock::time_point> _lastStatisticsUpdateTime;
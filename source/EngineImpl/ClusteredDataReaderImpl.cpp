@@ -0,0 +1,155 @@
+#include "ClusteredDataReaderImpl.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "EngineInterface/CellFunctionConstants.h"
+#include "EngineInterface/NeuronData.h"
+
+#include "DataTOPool.h"
+#include "EngineWorker.h"
+
+namespace
+{
+    //path halving, the root of a cluster is its smallest cell index
+    int findRoot(std::vector<int>& parents, int index)
+    {
+        while (parents[index] != index) {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+        }
+        return index;
+    }
+
+    void unite(std::vector<int>& parents, int index1, int index2)
+    {
+        auto root1 = findRoot(parents, index1);
+        auto root2 = findRoot(parents, index2);
+        if (root1 < root2) {
+            parents[root2] = root1;
+        } else {
+            parents[root1] = root2;
+        }
+    }
+
+    //must match the auxiliary data copied by cudaGetExportedCells
+    uint64_t getAuxiliaryDataSize(CellTO const& cellTO)
+    {
+        uint64_t result = cellTO.metadata.nameSize + cellTO.metadata.descriptionSize;
+        switch (cellTO.cellFunction) {
+        case CellFunction_Neuron:
+            result += sizeof(NeuronWeights) + sizeof(NeuronBiases);
+            break;
+        case CellFunction_Constructor:
+            result += cellTO.cellFunctionData.constructor.genomeSize;
+            break;
+        case CellFunction_Injector:
+            result += cellTO.cellFunctionData.injector.genomeSize;
+            break;
+        }
+        return result;
+    }
+}
+
+_ClusteredDataReaderImpl::_ClusteredDataReaderImpl(
+    EngineWorker* worker,
+    uint64_t exportId,
+    ArraySizes const& exportedSizes,
+    SimulationParameters const& parameters)
+    : _worker(worker)
+    , _exportId(exportId)
+    , _exportedSizes(exportedSizes)
+    , _converter(parameters)
+{
+    //the clusters are determined from the cells transferred chunk by chunk without their auxiliary data
+    auto numCells = toInt(_exportedSizes.cellArraySize);
+    std::vector<int> parents(numCells);
+    std::iota(parents.begin(), parents.end(), 0);
+    _auxiliaryDataSizes.resize(numCells);
+    for (int startIndex = 0; startIndex < numCells; startIndex += MaxCellsPerChunk) {
+        auto endIndex = std::min(numCells, startIndex + MaxCellsPerChunk);
+        auto dataTO = _worker->getExportedCells(_exportId, startIndex, endIndex);
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto const& cellTO = dataTO->cells[index - startIndex];
+            _auxiliaryDataSizes[index] = getAuxiliaryDataSize(cellTO);
+            for (int i = 0; i < cellTO.numConnections; ++i) {
+                auto const& connectionTO = cellTO.connections[i];
+                if (connectionTO.cellIndex != -1) {
+                    unite(parents, index, connectionTO.cellIndex);
+                }
+            }
+        }
+    }
+    for (int index = 0; index < numCells; ++index) {
+        parents[index] = findRoot(parents, index);
+    }
+    _cellClusters = _converter.calcCellClusters(parents);
+
+    _clusterPositions.resize(numCells);
+    for (int pos = 0; pos < numCells; ++pos) {
+        _clusterPositions[_cellClusters.cellIndices[pos]] = pos;
+    }
+}
+
+_ClusteredDataReaderImpl::~_ClusteredDataReaderImpl()
+{
+    try {
+        _worker->releaseExportedData(_exportId);
+    } catch (...) {
+        //the worker may be in an invalid state, the exported data is released with the simulation in this case
+    }
+}
+
+std::optional<ClusteredDataDescription> _ClusteredDataReaderImpl::readNextChunk()
+{
+    ClusteredDataDescription result;
+    auto numClusters = _cellClusters.getNumClusters();
+    if (_clusterIndex < numClusters) {
+        auto const& startIndices = _cellClusters.clusterStartIndices;
+
+        //complete clusters are added until MaxCellsPerChunk is reached
+        auto endClusterIndex = _clusterIndex + 1;
+        while (endClusterIndex < numClusters && startIndices[endClusterIndex + 1] - startIndices[_clusterIndex] <= MaxCellsPerChunk) {
+            ++endClusterIndex;
+        }
+
+        //the cells are gathered in cluster order, hence the chunk consists of consecutive clusters starting at index 0
+        auto startCellPos = startIndices[_clusterIndex];
+        auto endCellPos = startIndices[endClusterIndex];
+        std::vector<uint64_t> cellIndices(_cellClusters.cellIndices.begin() + startCellPos, _cellClusters.cellIndices.begin() + endCellPos);
+        uint64_t auxiliaryDataSize = 0;
+        for (auto const& cellIndex : cellIndices) {
+            auxiliaryDataSize += _auxiliaryDataSizes[cellIndex];
+        }
+        auto dataTO = _worker->getExportedCells(_exportId, cellIndices, auxiliaryDataSize);
+
+        //connections refer to the export and are mapped to the chunk, connected cells are always part of the same chunk
+        for (uint64_t index = 0; index < *dataTO->numCells; ++index) {
+            auto& cellTO = dataTO->cells[index];
+            for (int i = 0; i < cellTO.numConnections; ++i) {
+                auto& connectionTO = cellTO.connections[i];
+                if (connectionTO.cellIndex != -1) {
+                    connectionTO.cellIndex = _clusterPositions[connectionTO.cellIndex] - toInt(startCellPos);
+                }
+            }
+        }
+        DescriptionConverter::CellClusters chunkClusters;
+        chunkClusters.cellIndices.resize(cellIndices.size());
+        std::iota(chunkClusters.cellIndices.begin(), chunkClusters.cellIndices.end(), 0);
+        for (auto clusterIndex = _clusterIndex; clusterIndex <= endClusterIndex; ++clusterIndex) {
+            chunkClusters.clusterStartIndices.emplace_back(startIndices[clusterIndex] - startCellPos);
+        }
+        result.clusters = _converter.convertTOtoClusterDescriptions(*dataTO, chunkClusters, 0, chunkClusters.getNumClusters());
+        _clusterIndex = endClusterIndex;
+        return result;
+    }
+    auto numParticles = _exportedSizes.particleArraySize;
+    if (_particleIndex < numParticles) {
+        auto endIndex = std::min(numParticles, _particleIndex + MaxParticlesPerChunk);
+        auto dataTO = _worker->getExportedParticles(_exportId, _particleIndex, endIndex);
+        result.particles = _converter.convertTOtoParticleDescriptions(*dataTO, 0, endIndex - _particleIndex);
+        _particleIndex = endIndex;
+        return result;
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "EngineInterface/ArraySizes.h"
+#include "EngineInterface/ClusteredDataReader.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+#include "DescriptionConverter.h"
+
+class EngineWorker;
+
+//reads the simulation data exported on the GPU in chunks of complete clusters
+//only the cell connections and auxiliary data sizes are kept for the whole export, the transfer buffers are as large as a chunk
+class _ClusteredDataReaderImpl : public _ClusteredDataReader
+{
+public:
+    _ClusteredDataReaderImpl(EngineWorker* worker, uint64_t exportId, ArraySizes const& exportedSizes, SimulationParameters const& parameters);
+    ~_ClusteredDataReaderImpl() override;
+
+    std::optional<ClusteredDataDescription> readNextChunk() override;
+
+private:
+    static auto constexpr MaxCellsPerChunk = 100000;
+    static auto constexpr MaxParticlesPerChunk = 500000;
+
+    EngineWorker* _worker;
+    uint64_t _exportId;
+    ArraySizes _exportedSizes;
+    DescriptionConverter _converter;
+
+    DescriptionConverter::CellClusters _cellClusters;  //cell indices refer to the export
+    std::vector<int> _clusterPositions;                //inverse of _cellClusters.cellIndices
+    std::vector<uint64_t> _auxiliaryDataSizes;         //per cell of the export
+    uint64_t _clusterIndex = 0;
+    uint64_t _particleIndex = 0;
+};
@@ -0,0 +1,274 @@
+#include "DataTOFileService.h"
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+#include "Base/MemoryMappedFile.h"
+#include "Base/Resources.h"
+#include "EngineInterface/SerializerService.h"
+
+namespace
+{
+    uint32_t constexpr FormatVersion = 2;
+    uint64_t constexpr Alignment = 64;
+
+    struct FileHeader
+    {
+        char marker[8];
+        uint32_t formatVersion;
+        uint32_t cellTOSize;
+        uint32_t particleTOSize;
+        uint32_t numLayoutEntries;  //since format version 2
+        char programVersion[32];
+
+        uint64_t numCells;
+        uint64_t numParticles;
+        uint64_t numAuxiliaryData;
+        uint64_t cellsOffset;
+        uint64_t particlesOffset;
+        uint64_t auxiliaryDataOffset;
+        uint64_t layoutOffset;  //since format version 2
+    };
+
+    //format version 1 has no layout table and is only valid for the same program version
+    uint64_t constexpr FileHeaderSizeOfFormatVersion1 = offsetof(FileHeader, layoutOffset);
+
+#define ADD_LAYOUT_ENTRY(Type, member) \
+    result.emplace_back(static_cast<uint32_t>(offsetof(Type, member))); \
+    result.emplace_back(static_cast<uint32_t>(sizeof(Type::member)))
+
+    //offset and size of each TO member, snapshot files can be loaded by every program version with an identical layout
+    //needs to be extended when members are added to the TOs
+    std::vector<uint32_t> getLayout()
+    {
+        std::vector<uint32_t> result = {sizeof(CellTO), sizeof(ParticleTO), sizeof(CellFunctionTO), MAX_CELL_BONDS, MAX_CHANNELS};
+        ADD_LAYOUT_ENTRY(ParticleTO, id);
+        ADD_LAYOUT_ENTRY(ParticleTO, energy);
+        ADD_LAYOUT_ENTRY(ParticleTO, pos);
+        ADD_LAYOUT_ENTRY(ParticleTO, vel);
+        ADD_LAYOUT_ENTRY(ParticleTO, color);
+        ADD_LAYOUT_ENTRY(ParticleTO, selected);
+
+        ADD_LAYOUT_ENTRY(CellTO, id);
+        ADD_LAYOUT_ENTRY(CellTO, connections);
+        ADD_LAYOUT_ENTRY(CellTO, pos);
+        ADD_LAYOUT_ENTRY(CellTO, vel);
+        ADD_LAYOUT_ENTRY(CellTO, energy);
+        ADD_LAYOUT_ENTRY(CellTO, stiffness);
+        ADD_LAYOUT_ENTRY(CellTO, color);
+        ADD_LAYOUT_ENTRY(CellTO, maxConnections);
+        ADD_LAYOUT_ENTRY(CellTO, numConnections);
+        ADD_LAYOUT_ENTRY(CellTO, barrier);
+        ADD_LAYOUT_ENTRY(CellTO, age);
+        ADD_LAYOUT_ENTRY(CellTO, livingState);
+        ADD_LAYOUT_ENTRY(CellTO, creatureId);
+        ADD_LAYOUT_ENTRY(CellTO, mutationId);
+        ADD_LAYOUT_ENTRY(CellTO, ancestorMutationId);
+        ADD_LAYOUT_ENTRY(CellTO, genomeComplexity);
+        ADD_LAYOUT_ENTRY(CellTO, executionOrderNumber);
+        ADD_LAYOUT_ENTRY(CellTO, inputExecutionOrderNumber);
+        ADD_LAYOUT_ENTRY(CellTO, outputBlocked);
+        ADD_LAYOUT_ENTRY(CellTO, cellFunction);
+        ADD_LAYOUT_ENTRY(CellTO, cellFunctionData);
+        ADD_LAYOUT_ENTRY(CellTO, activity);
+        ADD_LAYOUT_ENTRY(CellTO, activationTime);
+        ADD_LAYOUT_ENTRY(CellTO, detectedByCreatureId);
+        ADD_LAYOUT_ENTRY(CellTO, cellFunctionUsed);
+        ADD_LAYOUT_ENTRY(CellTO, metadata);
+        ADD_LAYOUT_ENTRY(CellTO, selected);
+
+        ADD_LAYOUT_ENTRY(CellMetadataTO, nameSize);
+        ADD_LAYOUT_ENTRY(CellMetadataTO, nameDataIndex);
+        ADD_LAYOUT_ENTRY(CellMetadataTO, descriptionSize);
+        ADD_LAYOUT_ENTRY(CellMetadataTO, descriptionDataIndex);
+
+        ADD_LAYOUT_ENTRY(ConnectionTO, cellIndex);
+        ADD_LAYOUT_ENTRY(ConnectionTO, distance);
+        ADD_LAYOUT_ENTRY(ConnectionTO, angleFromPrevious);
+
+        ADD_LAYOUT_ENTRY(ActivityTO, channels);
+        ADD_LAYOUT_ENTRY(ActivityTO, origin);
+        ADD_LAYOUT_ENTRY(ActivityTO, targetX);
+        ADD_LAYOUT_ENTRY(ActivityTO, targetY);
+
+        ADD_LAYOUT_ENTRY(NeuronTO, weightsAndBiasesDataIndex);
+        ADD_LAYOUT_ENTRY(NeuronTO, activationFunctions);
+
+        ADD_LAYOUT_ENTRY(TransmitterTO, mode);
+
+        ADD_LAYOUT_ENTRY(ConstructorTO, activationMode);
+        ADD_LAYOUT_ENTRY(ConstructorTO, constructionActivationTime);
+        ADD_LAYOUT_ENTRY(ConstructorTO, genomeSize);
+        ADD_LAYOUT_ENTRY(ConstructorTO, numInheritedGenomeNodes);
+        ADD_LAYOUT_ENTRY(ConstructorTO, origGenomeSize);
+        ADD_LAYOUT_ENTRY(ConstructorTO, genomeDataIndex);
+        ADD_LAYOUT_ENTRY(ConstructorTO, genomeGeneration);
+        ADD_LAYOUT_ENTRY(ConstructorTO, constructionAngle1);
+        ADD_LAYOUT_ENTRY(ConstructorTO, constructionAngle2);
+        ADD_LAYOUT_ENTRY(ConstructorTO, lastConstructedCellId);
+        ADD_LAYOUT_ENTRY(ConstructorTO, genomeCurrentNodeIndex);
+        ADD_LAYOUT_ENTRY(ConstructorTO, genomeCurrentRepetition);
+        ADD_LAYOUT_ENTRY(ConstructorTO, currentBranch);
+        ADD_LAYOUT_ENTRY(ConstructorTO, offspringCreatureId);
+        ADD_LAYOUT_ENTRY(ConstructorTO, offspringMutationId);
+
+        ADD_LAYOUT_ENTRY(SensorTO, mode);
+        ADD_LAYOUT_ENTRY(SensorTO, angle);
+        ADD_LAYOUT_ENTRY(SensorTO, minDensity);
+        ADD_LAYOUT_ENTRY(SensorTO, minRange);
+        ADD_LAYOUT_ENTRY(SensorTO, maxRange);
+        ADD_LAYOUT_ENTRY(SensorTO, restrictToColor);
+        ADD_LAYOUT_ENTRY(SensorTO, restrictToMutants);
+        ADD_LAYOUT_ENTRY(SensorTO, memoryChannel1);
+        ADD_LAYOUT_ENTRY(SensorTO, memoryChannel2);
+        ADD_LAYOUT_ENTRY(SensorTO, memoryChannel3);
+        ADD_LAYOUT_ENTRY(SensorTO, memoryTargetX);
+        ADD_LAYOUT_ENTRY(SensorTO, memoryTargetY);
+
+        ADD_LAYOUT_ENTRY(NerveTO, pulseMode);
+        ADD_LAYOUT_ENTRY(NerveTO, alternationMode);
+
+        ADD_LAYOUT_ENTRY(AttackerTO, mode);
+
+        ADD_LAYOUT_ENTRY(InjectorTO, mode);
+        ADD_LAYOUT_ENTRY(InjectorTO, counter);
+        ADD_LAYOUT_ENTRY(InjectorTO, genomeSize);
+        ADD_LAYOUT_ENTRY(InjectorTO, genomeDataIndex);
+        ADD_LAYOUT_ENTRY(InjectorTO, genomeGeneration);
+
+        ADD_LAYOUT_ENTRY(MuscleTO, mode);
+        ADD_LAYOUT_ENTRY(MuscleTO, lastBendingDirection);
+        ADD_LAYOUT_ENTRY(MuscleTO, lastBendingSourceIndex);
+        ADD_LAYOUT_ENTRY(MuscleTO, consecutiveBendingAngle);
+        ADD_LAYOUT_ENTRY(MuscleTO, lastMovementX);
+        ADD_LAYOUT_ENTRY(MuscleTO, lastMovementY);
+
+        ADD_LAYOUT_ENTRY(DefenderTO, mode);
+
+        ADD_LAYOUT_ENTRY(ReconnectorTO, restrictToColor);
+        ADD_LAYOUT_ENTRY(ReconnectorTO, restrictToMutants);
+
+        ADD_LAYOUT_ENTRY(DetonatorTO, state);
+        ADD_LAYOUT_ENTRY(DetonatorTO, countdown);
+        return result;
+    }
+
+#undef ADD_LAYOUT_ENTRY
+
+    uint64_t align(uint64_t offset)
+    {
+        return (offset + Alignment - 1) / Alignment * Alignment;
+    }
+
+    //overflow-safe check for header values read from a file
+    template <typename T>
+    bool isArrayWithinFile(uint64_t offset, uint64_t num, uint64_t size)
+    {
+        return offset <= size && num <= (size - offset) / sizeof(T);
+    }
+
+    void writeSection(std::ofstream& stream, uint64_t offset, void const* data, uint64_t size)
+    {
+        auto position = static_cast<uint64_t>(stream.tellp());
+        if (position < offset) {
+            std::vector<char> padding(offset - position, 0);
+            stream.write(padding.data(), padding.size());
+        }
+        if (size > 0) {
+            stream.write(reinterpret_cast<char const*>(data), size);
+        }
+    }
+}
+
+void DataTOFileService::writeToFile(std::string const& filename, DataTO const& dataTO)
+{
+    static_assert(sizeof(FileHeader) % 8 == 0);
+
+    auto layout = getLayout();
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.marker, SerializerService::SnapshotFileMarker, sizeof(header.marker));
+    header.formatVersion = FormatVersion;
+    header.cellTOSize = sizeof(CellTO);
+    header.particleTOSize = sizeof(ParticleTO);
+    header.numLayoutEntries = static_cast<uint32_t>(layout.size());
+    std::strncpy(header.programVersion, Const::ProgramVersion.c_str(), sizeof(header.programVersion) - 1);
+    header.numCells = *dataTO.numCells;
+    header.numParticles = *dataTO.numParticles;
+    header.numAuxiliaryData = *dataTO.numAuxiliaryData;
+    header.layoutOffset = sizeof(FileHeader);
+    header.cellsOffset = align(header.layoutOffset + layout.size() * sizeof(uint32_t));
+    header.particlesOffset = align(header.cellsOffset + header.numCells * sizeof(CellTO));
+    header.auxiliaryDataOffset = align(header.particlesOffset + header.numParticles * sizeof(ParticleTO));
+
+    std::ofstream stream(filename, std::ios::binary);
+    if (!stream) {
+        throw std::runtime_error("Could not write to " + filename + ".");
+    }
+    stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    writeSection(stream, header.layoutOffset, layout.data(), layout.size() * sizeof(uint32_t));
+    writeSection(stream, header.cellsOffset, dataTO.cells, header.numCells * sizeof(CellTO));
+    writeSection(stream, header.particlesOffset, dataTO.particles, header.numParticles * sizeof(ParticleTO));
+    writeSection(stream, header.auxiliaryDataOffset, dataTO.auxiliaryData, header.numAuxiliaryData);
+    if (!stream) {
+        throw std::runtime_error("Could not write to " + filename + ".");
+    }
+}
+
+MappedDataTO DataTOFileService::mapFromFile(std::string const& filename)
+{
+    MappedDataTO result;
+    result.file = std::make_shared<_MemoryMappedFile>(filename);
+
+    auto data = result.file->getData();
+    auto size = result.file->getSize();
+    if (size < FileHeaderSizeOfFormatVersion1) {
+        throw std::runtime_error("Invalid snapshot file.");
+    }
+    auto header = reinterpret_cast<FileHeader*>(data);
+    if (std::memcmp(header->marker, SerializerService::SnapshotFileMarker, sizeof(header->marker)) != 0 || header->formatVersion == 0
+        || header->formatVersion > FormatVersion) {
+        throw std::runtime_error("Invalid snapshot file.");
+    }
+    if (header->cellTOSize != sizeof(CellTO) || header->particleTOSize != sizeof(ParticleTO)) {
+        throw std::runtime_error("Snapshot file has a different data layout.");
+    }
+
+    //compatibility with format version 1
+    //>>>
+    if (header->formatVersion == 1) {
+        header->programVersion[sizeof(header->programVersion) - 1] = '\0';
+        if (std::string(header->programVersion) != Const::ProgramVersion) {
+            throw std::runtime_error("Snapshot file has been created by a different program version.");
+        }
+    }
+    //<<<
+
+    else {
+        if (size < sizeof(FileHeader) || !isArrayWithinFile<uint32_t>(header->layoutOffset, header->numLayoutEntries, size)) {
+            throw std::runtime_error("Snapshot file is truncated.");
+        }
+        auto layout = getLayout();
+        if (header->numLayoutEntries != layout.size()
+            || std::memcmp(data + header->layoutOffset, layout.data(), layout.size() * sizeof(uint32_t)) != 0) {
+            throw std::runtime_error("Snapshot file has a different data layout.");
+        }
+    }
+    if (!isArrayWithinFile<CellTO>(header->cellsOffset, header->numCells, size)
+        || !isArrayWithinFile<ParticleTO>(header->particlesOffset, header->numParticles, size)
+        || !isArrayWithinFile<uint8_t>(header->auxiliaryDataOffset, header->numAuxiliaryData, size)) {
+        throw std::runtime_error("Snapshot file is truncated.");
+    }
+
+    //no copy: the arrays are referenced within the (private) mapping
+    result.dataTO.numCells = &header->numCells;
+    result.dataTO.numParticles = &header->numParticles;
+    result.dataTO.numAuxiliaryData = &header->numAuxiliaryData;
+    result.dataTO.cells = reinterpret_cast<CellTO*>(data + header->cellsOffset);
+    result.dataTO.particles = reinterpret_cast<ParticleTO*>(data + header->particlesOffset);
+    result.dataTO.auxiliaryData = data + header->auxiliaryDataOffset;
+    result.arraySizes = {header->numCells, header->numParticles, header->numAuxiliaryData};
+    return result;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "EngineInterface/ArraySizes.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+#include "Definitions.h"
+
+//DataTO whose arrays point directly into a memory-mapped snapshot file
+struct MappedDataTO
+{
+    MemoryMappedFile file;
+    DataTO dataTO;
+    ArraySizes arraySizes;
+};
+
+//snapshot files store the raw host layout of CellTO, ParticleTO and the auxiliary data together with a table of the member offsets
+//they can be loaded by every program version whose TOs have the same layout
+class DataTOFileService
+{
+public:
+    static void writeToFile(std::string const& filename, DataTO const& dataTO);
+    static MappedDataTO mapFromFile(std::string const& filename);
+};
@@ -0,0 +1,287 @@
+#include "DataTOPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <cuda_runtime.h>
+
+namespace
+{
+    auto constexpr Alignment = 64;
+
+    uint64_t alignSize(uint64_t size)
+    {
+        return (size + Alignment - 1) / Alignment * Alignment;
+    }
+
+    struct BufferLayout
+    {
+        uint64_t cellsOffset;
+        uint64_t particlesOffset;
+        uint64_t auxiliaryDataOffset;
+        uint64_t size;
+    };
+
+    //counts, cells, particles and auxiliary data are placed in one allocation
+    BufferLayout calcLayout(ArraySizes const& capacities)
+    {
+        BufferLayout result;
+        result.cellsOffset = alignSize(sizeof(uint64_t) * 3);
+        result.particlesOffset = result.cellsOffset + alignSize(sizeof(CellTO) * capacities.cellArraySize);
+        result.auxiliaryDataOffset = result.particlesOffset + alignSize(sizeof(ParticleTO) * capacities.particleArraySize);
+        result.size = result.auxiliaryDataOffset + capacities.auxiliaryDataSize;
+        return result;
+    }
+
+    uint64_t getNumBytesOfInit(ArraySizes const& capacities)
+    {
+        return sizeof(uint64_t) * 3 + sizeof(CellTO) * capacities.cellArraySize + sizeof(ParticleTO) * capacities.particleArraySize
+            + capacities.auxiliaryDataSize;
+    }
+
+    bool fits(ArraySizes const& capacities, ArraySizes const& arraySizes)
+    {
+        return capacities.cellArraySize >= arraySizes.cellArraySize && capacities.particleArraySize >= arraySizes.particleArraySize
+            && capacities.auxiliaryDataSize >= arraySizes.auxiliaryDataSize;
+    }
+
+    uint64_t grow(uint64_t size, double factor)
+    {
+        return static_cast<uint64_t>(std::ceil(static_cast<double>(size) * factor));
+    }
+
+    bool tryAllocatePinned(DataTO& dataTO, ArraySizes const& capacities)
+    {
+        auto layout = calcLayout(capacities);
+        void* memory = nullptr;
+        if (cudaHostAlloc(&memory, layout.size, cudaHostAllocDefault) != cudaSuccess) {
+            cudaGetLastError();
+            return false;
+        }
+        auto bytes = reinterpret_cast<uint8_t*>(memory);
+        dataTO.numCells = reinterpret_cast<uint64_t*>(bytes);
+        dataTO.numParticles = dataTO.numCells + 1;
+        dataTO.numAuxiliaryData = dataTO.numCells + 2;
+        dataTO.cells = reinterpret_cast<CellTO*>(bytes + layout.cellsOffset);
+        dataTO.particles = reinterpret_cast<ParticleTO*>(bytes + layout.particlesOffset);
+        dataTO.auxiliaryData = bytes + layout.auxiliaryDataOffset;
+        return true;
+    }
+
+    void resetCounts(DataTO const& dataTO)
+    {
+        *dataTO.numCells = 0;
+        *dataTO.numParticles = 0;
+        *dataTO.numAuxiliaryData = 0;
+    }
+}
+
+DataTOLease::DataTOLease(DataTOPool const& pool, DataTOBuffer const& buffer)
+    : _pool(pool)
+    , _buffer(buffer)
+{}
+
+DataTOLease::~DataTOLease()
+{
+    release();
+}
+
+DataTOLease::DataTOLease(DataTOLease&& other) noexcept
+    : _pool(std::move(other._pool))
+    , _buffer(other._buffer)
+{
+    other._pool.reset();
+}
+
+DataTOLease& DataTOLease::operator=(DataTOLease&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        _pool = std::move(other._pool);
+        _buffer = other._buffer;
+        other._pool.reset();
+    }
+    return *this;
+}
+
+DataTO& DataTOLease::operator*()
+{
+    return _buffer.dataTO;
+}
+
+DataTO const& DataTOLease::operator*() const
+{
+    return _buffer.dataTO;
+}
+
+DataTO* DataTOLease::operator->()
+{
+    return &_buffer.dataTO;
+}
+
+DataTO const* DataTOLease::operator->() const
+{
+    return &_buffer.dataTO;
+}
+
+ArraySizes const& DataTOLease::getCapacities() const
+{
+    return _buffer.capacities;
+}
+
+void DataTOLease::release()
+{
+    if (_pool) {
+        _pool->release(_buffer);
+        _pool.reset();
+    }
+}
+
+_DataTOPool::_DataTOPool(bool pinnedMemory, uint64_t maxFreeBytes, std::chrono::steady_clock::duration maxIdleDuration)
+    : _pinnedMemory(pinnedMemory)
+    , _maxFreeBytes(maxFreeBytes)
+    , _maxIdleDuration(maxIdleDuration)
+{}
+
+_DataTOPool::~_DataTOPool()
+{
+    for (auto const& buffer : _freeBuffers) {
+        deallocate(buffer);
+    }
+}
+
+DataTOLease _DataTOPool::acquire(ArraySizes const& arraySizes)
+{
+    {
+        std::lock_guard lock(_mutex);
+        evictIdleBuffers();
+
+        //take the smallest fitting buffer
+        auto bestIter = _freeBuffers.end();
+        for (auto iter = _freeBuffers.begin(); iter != _freeBuffers.end(); ++iter) {
+            if (fits(iter->capacities, arraySizes) && (bestIter == _freeBuffers.end() || iter->numBytes < bestIter->numBytes)) {
+                bestIter = iter;
+            }
+        }
+        if (bestIter != _freeBuffers.end()) {
+            auto buffer = *bestIter;
+            _freeBuffers.erase(bestIter);
+            ++_statistics.numHits;
+            ++_statistics.numLeasedBuffers;
+            resetCounts(buffer.dataTO);
+            return DataTOLease(shared_from_this(), buffer);
+        }
+
+        ++_statistics.numMisses;
+    }
+
+    ArraySizes capacities{
+        grow(arraySizes.cellArraySize, GrowthFactor), grow(arraySizes.particleArraySize, GrowthFactor), grow(arraySizes.auxiliaryDataSize, GrowthFactor)};
+    auto buffer = allocate(capacities);
+    resetCounts(buffer.dataTO);
+    {
+        std::lock_guard lock(_mutex);
+        _statistics.allocatedBytes += buffer.numBytes;
+        ++_statistics.numLeasedBuffers;
+    }
+    return DataTOLease(shared_from_this(), buffer);
+}
+
+TransferBufferStatistics _DataTOPool::getStatistics() const
+{
+    std::lock_guard lock(_mutex);
+    return _statistics;
+}
+
+void _DataTOPool::release(DataTOBuffer const& buffer)
+{
+    std::lock_guard lock(_mutex);
+    --_statistics.numLeasedBuffers;
+    evictIdleBuffers();
+
+    auto freeBuffer = buffer;
+    freeBuffer.releaseTimepoint = std::chrono::steady_clock::now();
+    _freeBuffers.emplace_back(freeBuffer);
+    if (_freeBuffers.size() > MaxFreeBuffers) {
+        auto smallestIter = std::min_element(_freeBuffers.begin(), _freeBuffers.end(), [](auto const& left, auto const& right) {
+            return left.numBytes < right.numBytes;
+        });
+        deallocate(*smallestIter);
+        _freeBuffers.erase(smallestIter);
+    }
+
+    //the page-locked memory of free buffers is not available to the OS, hence the least recently used ones are evicted above a limit
+    //the buffer just released is kept in any case since it is likely needed for the next transfer
+    uint64_t freeBytes = 0;
+    for (auto const& otherBuffer : _freeBuffers) {
+        freeBytes += otherBuffer.numBytes;
+    }
+    while (freeBytes > _maxFreeBytes && _freeBuffers.size() > 1) {
+        auto oldestIter = std::min_element(_freeBuffers.begin(), _freeBuffers.end(), [](auto const& left, auto const& right) {
+            return left.releaseTimepoint < right.releaseTimepoint;
+        });
+        freeBytes -= oldestIter->numBytes;
+        deallocate(*oldestIter);
+        _freeBuffers.erase(oldestIter);
+    }
+}
+
+void _DataTOPool::evictIdleBuffers()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::erase_if(_freeBuffers, [&](auto const& buffer) {
+        if (now - buffer.releaseTimepoint > _maxIdleDuration) {
+            deallocate(buffer);
+            return true;
+        }
+        return false;
+    });
+}
+
+//free buffers are evicted, largest first, only as long as the new buffer cannot be allocated
+DataTOBuffer _DataTOPool::allocate(ArraySizes const& capacities)
+{
+    while (true) {
+        if (auto result = tryAllocate(capacities)) {
+            return *result;
+        }
+        std::lock_guard lock(_mutex);
+        if (_freeBuffers.empty()) {
+            throw std::runtime_error("There is not sufficient CPU memory available.");
+        }
+        auto largestIter = std::max_element(
+            _freeBuffers.begin(), _freeBuffers.end(), [](auto const& left, auto const& right) { return left.numBytes < right.numBytes; });
+        deallocate(*largestIter);
+        _freeBuffers.erase(largestIter);
+    }
+}
+
+std::optional<DataTOBuffer> _DataTOPool::tryAllocate(ArraySizes const& capacities) const
+{
+    DataTOBuffer result;
+    result.capacities = capacities;
+    if (_pinnedMemory && tryAllocatePinned(result.dataTO, capacities)) {
+        result.pinned = true;
+        result.numBytes = calcLayout(capacities).size;
+        return result;
+    }
+    try {
+        result.dataTO.init(capacities);
+    } catch (std::bad_alloc const&) {
+        return std::nullopt;
+    }
+    result.numBytes = getNumBytesOfInit(capacities);
+    return result;
+}
+
+void _DataTOPool::deallocate(DataTOBuffer const& buffer)
+{
+    _statistics.allocatedBytes -= buffer.numBytes;
+    if (buffer.pinned) {
+        cudaFreeHost(buffer.dataTO.numCells);
+    } else {
+        auto dataTO = buffer.dataTO;
+        dataTO.destroy();
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "EngineInterface/ArraySizes.h"
+#include "EngineInterface/TransferBufferStatistics.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+#include "Definitions.h"
+
+struct DataTOBuffer
+{
+    DataTO dataTO;
+    ArraySizes capacities;
+    bool pinned = false;
+    uint64_t numBytes = 0;  //depends on whether the buffer is allocated in one page-locked block or via DataTO::init
+    std::chrono::steady_clock::time_point releaseTimepoint;
+};
+
+//gives exclusive access to a pooled DataTO and returns it to the pool on destruction
+class DataTOLease
+{
+public:
+    DataTOLease() = default;
+    DataTOLease(DataTOPool const& pool, DataTOBuffer const& buffer);
+    ~DataTOLease();
+
+    DataTOLease(DataTOLease&& other) noexcept;
+    DataTOLease& operator=(DataTOLease&& other) noexcept;
+    DataTOLease(DataTOLease const&) = delete;
+    DataTOLease& operator=(DataTOLease const&) = delete;
+
+    DataTO& operator*();
+    DataTO const& operator*() const;
+    DataTO* operator->();
+    DataTO const* operator->() const;
+    ArraySizes const& getCapacities() const;
+
+private:
+    void release();
+
+    DataTOPool _pool;
+    DataTOBuffer _buffer;
+};
+
+//host DataTOs shared by all accessors of an EngineWorker, several DataTOs can be leased concurrently
+//buffers are allocated with a growth factor and, if possible, in page-locked memory for faster transfers from and to the GPU
+//free buffers are evicted if their number or total size exceeds a limit, if they have not been used for a while
+//or if they prevent the allocation of a larger buffer
+class _DataTOPool : public std::enable_shared_from_this<_DataTOPool>
+{
+public:
+    static auto constexpr DefaultMaxFreeBytes = uint64_t(512) * 1024 * 1024;
+    static auto constexpr DefaultMaxIdleDuration = std::chrono::seconds(10);
+
+    _DataTOPool(
+        bool pinnedMemory,
+        uint64_t maxFreeBytes = DefaultMaxFreeBytes,
+        std::chrono::steady_clock::duration maxIdleDuration = DefaultMaxIdleDuration);
+    ~_DataTOPool();
+
+    DataTOLease acquire(ArraySizes const& arraySizes);
+
+    TransferBufferStatistics getStatistics() const;
+
+private:
+    friend class DataTOLease;
+    void release(DataTOBuffer const& buffer);
+
+    DataTOBuffer allocate(ArraySizes const& capacities);
+    std::optional<DataTOBuffer> tryAllocate(ArraySizes const& capacities) const;
+    void deallocate(DataTOBuffer const& buffer);
+    void evictIdleBuffers();  //_mutex must be locked
+
+    static auto constexpr GrowthFactor = 1.5;
+    static auto constexpr MaxFreeBuffers = 3;
+
+    bool _pinnedMemory = false;
+    uint64_t _maxFreeBytes = 0;
+    std::chrono::steady_clock::duration _maxIdleDuration;
+
+    mutable std::mutex _mutex;
+    std::vector<DataTOBuffer> _freeBuffers;
+    TransferBufferStatistics _statistics;
+};
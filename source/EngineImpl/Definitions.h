@@ -2,5 +2,5 @@
 
 #include <boost/shared_ptr.hpp>
 
-class _AccessDataTOCache;
-using AccessDataTOCache = std::shared_ptr<_AccessDataTOCache>;
+class _DataTOPool;
+using DataTOPool = std::shared_ptr<_DataTOPool>;
@@ -2,102 +2,75 @@
 
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
 #include <boost/range/adaptor/map.hpp>
 
+#include "Base/MetricsService.h"
 #include "Base/NumberGenerator.h"
+#include "Base/ParallelService.h"
 #include "Base/Exceptions.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/GenomeConstants.h"
+#include "EngineInterface/GenomePool.h"
 
 
 namespace
 {
-    union BytesAsFloat
-    {
-        float f;
-        uint8_t b[4];
-    };
-
     void convert(DataTO const& dataTO, uint64_t sourceSize, uint64_t sourceIndex, std::vector<uint8_t>& target)
     {
-        target.resize(sourceSize);
-        for (int i = 0; i < sourceSize; ++i) {
-            target[i] = dataTO.auxiliaryData[sourceIndex + i];
-        }
+        target.assign(dataTO.auxiliaryData + sourceIndex, dataTO.auxiliaryData + sourceIndex + sourceSize);
     }
 
-    void convert(DataTO const& dataTO, uint64_t sourceSize, uint64_t sourceIndex, std::vector<float>& target)
+    template <typename Container, typename SizeType>
+    void copyToAuxiliaryData(DataTO const& dataTO, Container const& source, SizeType& targetSize, uint64_t& targetIndex, uint64_t& auxiliaryDataIndex)
     {
-        BytesAsFloat bytesAsFloat;
-        target.resize(sourceSize / 4);
-        for (uint64_t i = 0; i < sourceSize / 4; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                bytesAsFloat.b[j] = dataTO.auxiliaryData[sourceIndex + i * 4 + j];
-            }
-            target[i] = bytesAsFloat.f;
+        targetSize = static_cast<SizeType>(source.size());
+        targetIndex = auxiliaryDataIndex;
+        if (!source.empty()) {
+            std::memcpy(dataTO.auxiliaryData + auxiliaryDataIndex, source.data(), source.size());
+            auxiliaryDataIndex += source.size();
         }
     }
 
-    template<typename Container, typename SizeType>
-    void convert(DataTO const& dataTO, Container const& source, SizeType& targetSize, uint64_t& targetIndex)
+    //weights and biases are stored consecutively as in NeuronFunction::NeuronState
+    void copyWeightsAndBiasesToAuxiliaryData(DataTO const& dataTO, NeuronDescription const& neuron, uint64_t& targetIndex, uint64_t& auxiliaryDataIndex)
     {
-        targetSize = source.size();
-        if (targetSize > 0) {
-            targetIndex = *dataTO.numAuxiliaryData;
-            uint64_t size = source.size();
-            for (uint64_t i = 0; i < size; ++i) {
-                dataTO.auxiliaryData[targetIndex + i] = source.at(i);
-            }
-            (*dataTO.numAuxiliaryData) += size;
-        }
+        targetIndex = auxiliaryDataIndex;
+        std::memcpy(dataTO.auxiliaryData + auxiliaryDataIndex, neuron.weights.data(), sizeof(NeuronWeights));
+        auxiliaryDataIndex += sizeof(NeuronWeights);
+        std::memcpy(dataTO.auxiliaryData + auxiliaryDataIndex, neuron.biases.data(), sizeof(NeuronBiases));
+        auxiliaryDataIndex += sizeof(NeuronBiases);
     }
 
-    template <>
-    void convert(DataTO const& dataTO, std::vector<float> const& source, int& targetSize, uint64_t& targetIndex)
+    void copyWeightsAndBiasesFromAuxiliaryData(DataTO const& dataTO, uint64_t sourceIndex, NeuronDescription& neuron)
     {
-        BytesAsFloat bytesAsFloat;
-        targetSize = source.size() * 4;
-        if (targetSize > 0) {
-            targetIndex = *dataTO.numAuxiliaryData;
-            uint64_t size = source.size();
-            for (uint64_t i = 0; i < size; ++i) {
-                bytesAsFloat.f = source.at(i);
-                for (int j = 0; j < 4; ++j) {
-                    dataTO.auxiliaryData[targetIndex + i * 4 + j] = bytesAsFloat.b[j];
-                }
-            }
-            (*dataTO.numAuxiliaryData) += targetSize;
-        }
+        std::memcpy(neuron.weights.data(), dataTO.auxiliaryData + sourceIndex, sizeof(NeuronWeights));
+        std::memcpy(neuron.biases.data(), dataTO.auxiliaryData + sourceIndex + sizeof(NeuronWeights), sizeof(NeuronBiases));
     }
 
-    std::vector<float> unitWeightsAndBias(std::vector<std::vector<float>> const& weights, std::vector<float> const& bias)
+    std::vector<uint8_t> const* getGenome(CellDescription const& cell)
     {
-        std::vector<float> result(MAX_CHANNELS * MAX_CHANNELS + MAX_CHANNELS, 0);
-        for (int row = 0; row < MAX_CHANNELS; ++row) {
-            for (int col = 0; col < MAX_CHANNELS; ++col) {
-                result[col + row * MAX_CHANNELS] = weights[row][col];
-            }
+        switch (cell.getCellFunctionType()) {
+        case CellFunction_Constructor:
+            return &std::get<ConstructorDescription>(*cell.cellFunction).genome;
+        case CellFunction_Injector:
+            return &std::get<InjectorDescription>(*cell.cellFunction).genome;
+        default:
+            return nullptr;
         }
-        for (int col = 0; col < MAX_CHANNELS; ++col) {
-            result[col + MAX_CHANNELS * MAX_CHANNELS] = bias[col];
-        }
-
-        return result;
     }
 
-    std::pair<std::vector<std::vector<float>>, std::vector<float>> splitWeightsAndBias(std::vector<float> const& weightsAndBias)
+    //cellIndexById is sorted by id, for duplicate ids the last cell is taken
+    int getCellIndex(std::vector<std::pair<uint64_t, int>> const& cellIndexById, uint64_t id)
     {
-        std::vector<std::vector<float>> weights(MAX_CHANNELS, std::vector<float>(MAX_CHANNELS, 0));
-        for (int row = 0; row < MAX_CHANNELS; ++row) {
-            for (int col = 0; col < MAX_CHANNELS; ++col) {
-                weights[row][col] = weightsAndBias[col + row * MAX_CHANNELS];
-            }
+        auto iter = std::upper_bound(
+            cellIndexById.begin(), cellIndexById.end(), id, [](uint64_t id, std::pair<uint64_t, int> const& element) { return id < element.first; });
+        if (iter == cellIndexById.begin() || (--iter)->first != id) {
+            throw std::out_of_range("Connected cell not found.");
         }
-
-        std::vector<float> bias;
-        bias = std::vector<float>(weightsAndBias.begin() + MAX_CHANNELS * MAX_CHANNELS, weightsAndBias.end());
-
-        return std::make_pair(weights, bias);
+        return iter->second;
     }
 }
 
@@ -131,50 +104,162 @@ ArraySizes DescriptionConverter::getArraySizes(ClusteredDataDescription const& d
 
 ClusteredDataDescription DescriptionConverter::convertTOtoClusteredDataDescription(DataTO const& dataTO) const
 {
+    MEASURE_SCOPE("converter.toClusteredDataDescription");
 	ClusteredDataDescription result;
 
-    //cells
-    std::vector<ClusterDescription> clusters;
-    std::unordered_set<int> freeCellIndices;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        freeCellIndices.insert(i);
-    }
-    std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-    std::unordered_map<int, int> cellTOIndexToClusterDescIndex;
-    int clusterDescIndex = 0;
-    while (!freeCellIndices.empty()) {
-        auto freeCellIndex = *freeCellIndices.begin();
-        auto createClusterData = scanAndCreateClusterDescription(dataTO, freeCellIndex, freeCellIndices);
-        clusters.emplace_back(createClusterData.cluster);
-
-        //update index maps
-        cellTOIndexToCellDescIndex.insert(
-            createClusterData.cellTOIndexToCellDescIndex.begin(), createClusterData.cellTOIndexToCellDescIndex.end());
-        for (auto const& cellTOIndex : createClusterData.cellTOIndexToCellDescIndex | boost::adaptors::map_keys) {
-            cellTOIndexToClusterDescIndex.emplace(cellTOIndex, clusterDescIndex);
+    auto cellClusters = calcCellClusters(dataTO);
+    result.clusters = convertTOtoClusterDescriptions(dataTO, cellClusters, 0, cellClusters.getNumClusters());
+    result.particles = convertTOtoParticleDescriptions(dataTO, 0, *dataTO.numParticles);
+
+    return result;
+}
+
+namespace
+{
+    //path halving, the root of a cluster is its smallest cell index
+    int findRoot(std::vector<std::atomic<int>>& parents, int index)
+    {
+        while (true) {
+            auto parent = parents[index].load(std::memory_order_relaxed);
+            if (parent == index) {
+                return index;
+            }
+            auto grandParent = parents[parent].load(std::memory_order_relaxed);
+            if (grandParent != parent) {
+                parents[index].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+            }
+            index = grandParent;
         }
-        ++clusterDescIndex;
     }
-    result.addClusters(clusters);
 
-    //particles
-    std::vector<ParticleDescription> particles;
-    for (int i = 0; i < *dataTO.numParticles; ++i) {
-        ParticleTO const& particle = dataTO.particles[i];
-        particles.emplace_back(ParticleDescription()
-                                   .setId(particle.id)
-                                   .setPos({particle.pos.x, particle.pos.y})
-                                   .setVel({particle.vel.x, particle.vel.y})
-                                   .setEnergy(particle.energy)
-                                   .setColor(particle.color));
+    void unite(std::vector<std::atomic<int>>& parents, int index1, int index2)
+    {
+        while (true) {
+            auto root1 = findRoot(parents, index1);
+            auto root2 = findRoot(parents, index2);
+            if (root1 == root2) {
+                return;
+            }
+            if (root1 < root2) {
+                std::swap(root1, root2);
+            }
+            if (parents[root1].compare_exchange_strong(root1, root2, std::memory_order_relaxed)) {
+                return;
+            }
+        }
     }
-    result.addParticles(particles);
+}
+
+auto DescriptionConverter::calcCellClusters(DataTO const& dataTO) const -> CellClusters
+{
+    MEASURE_SCOPE("converter.calcCellClusters");
+    auto numCells = toInt(*dataTO.numCells);
+
+    //label cells via parallel union-find over the connections
+    std::vector<std::atomic<int>> parents(numCells);
+    ParallelService::forEachRange(numCells, [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = toInt(startIndex); index < toInt(endIndex); ++index) {
+            parents[index].store(index, std::memory_order_relaxed);
+        }
+    });
+    ParallelService::forEachRange(numCells, [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = toInt(startIndex); index < toInt(endIndex); ++index) {
+            auto const& cellTO = dataTO.cells[index];
+            for (int i = 0; i < cellTO.numConnections; ++i) {
+                auto const& connectionTO = cellTO.connections[i];
+                if (connectionTO.cellIndex != -1) {
+                    unite(parents, index, connectionTO.cellIndex);
+                }
+            }
+        }
+    });
+    std::vector<int> roots(numCells);
+    ParallelService::forEachRange(numCells, [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto index = toInt(startIndex); index < toInt(endIndex); ++index) {
+            roots[index] = findRoot(parents, index);
+        }
+    });
+    return calcCellClusters(roots);
+}
+
+auto DescriptionConverter::calcCellClusters(std::vector<int> const& roots) const -> CellClusters
+{
+    auto numCells = toInt(roots.size());
+
+    //counting sort of the cells by cluster, clusters are ordered by their smallest cell index
+    CellClusters result;
+    std::vector<int> clusterIndexByRoot(numCells);
+    std::vector<uint64_t> numCellsByCluster;
+    for (int index = 0; index < numCells; ++index) {
+        if (roots[index] == index) {
+            clusterIndexByRoot[index] = toInt(numCellsByCluster.size());
+            numCellsByCluster.emplace_back(0);
+        }
+        ++numCellsByCluster[clusterIndexByRoot[roots[index]]];
+    }
+    result.clusterStartIndices.resize(numCellsByCluster.size() + 1);
+    result.clusterStartIndices[0] = 0;
+    for (size_t i = 0; i < numCellsByCluster.size(); ++i) {
+        result.clusterStartIndices[i + 1] = result.clusterStartIndices[i] + numCellsByCluster[i];
+    }
+    auto insertIndices = result.clusterStartIndices;
+    result.cellIndices.resize(numCells);
+    for (int index = 0; index < numCells; ++index) {
+        result.cellIndices[insertIndices[clusterIndexByRoot[roots[index]]]++] = index;
+    }
+    return result;
+}
+
+std::vector<ClusterDescription> DescriptionConverter::convertTOtoClusterDescriptions(
+    DataTO const& dataTO,
+    CellClusters const& cellClusters,
+    uint64_t startClusterIndex,
+    uint64_t endClusterIndex) const
+{
+    MEASURE_SCOPE("converter.toClusterDescriptions");
+    auto const& startIndices = cellClusters.clusterStartIndices;
+
+    std::vector<ClusterDescription> result(endClusterIndex - startClusterIndex);
+    for (auto clusterIndex = startClusterIndex; clusterIndex < endClusterIndex; ++clusterIndex) {
+        result[clusterIndex - startClusterIndex].cells.resize(startIndices[clusterIndex + 1] - startIndices[clusterIndex]);
+    }
+
+    //cell descriptions are created in parallel over the cell ranges, large clusters are thus split among several threads
+    auto startCellPos = startIndices[startClusterIndex];
+    ParallelService::forEachRange(startIndices[endClusterIndex] - startCellPos, [&](uint64_t startIndex, uint64_t endIndex) {
+        auto cellPos = startCellPos + startIndex;
+        auto clusterIndex = static_cast<uint64_t>(std::upper_bound(startIndices.begin(), startIndices.end(), cellPos) - startIndices.begin()) - 1;
+        for (; cellPos < startCellPos + endIndex; ++cellPos) {
+            while (startIndices[clusterIndex + 1] <= cellPos) {
+                ++clusterIndex;
+            }
+            result[clusterIndex - startClusterIndex].cells[cellPos - startIndices[clusterIndex]] =
+                createCellDescription(dataTO, cellClusters.cellIndices[cellPos]);
+        }
+    });
+    return result;
+}
 
+std::vector<ParticleDescription> DescriptionConverter::convertTOtoParticleDescriptions(DataTO const& dataTO, uint64_t startIndex, uint64_t endIndex) const
+{
+    MEASURE_SCOPE("converter.toParticleDescriptions");
+    std::vector<ParticleDescription> result;
+    result.reserve(endIndex - startIndex);
+    for (auto i = startIndex; i < endIndex; ++i) {
+        ParticleTO const& particle = dataTO.particles[i];
+        result.emplace_back(ParticleDescription()
+                                .setId(particle.id)
+                                .setPos({particle.pos.x, particle.pos.y})
+                                .setVel({particle.vel.x, particle.vel.y})
+                                .setEnergy(particle.energy)
+                                .setColor(particle.color));
+    }
     return result;
 }
 
 DataDescription DescriptionConverter::convertTOtoDataDescription(DataTO const& dataTO) const
 {
+    MEASURE_SCOPE("converter.toDataDescription");
     DataDescription result;
 
     //cells
@@ -202,6 +287,7 @@ DataDescription DescriptionConverter::convertTOtoDataDescription(DataTO const& d
 
 OverlayDescription DescriptionConverter::convertTOtoOverlayDescription(DataTO const& dataTO) const
 {
+    MEASURE_SCOPE("converter.toOverlayDescription");
     OverlayDescription result;
     result.elements.reserve(*dataTO.numCells + *dataTO.numParticles);
     for (int i = 0; i < *dataTO.numCells; ++i) {
@@ -230,134 +316,53 @@ OverlayDescription DescriptionConverter::convertTOtoOverlayDescription(DataTO co
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, ClusteredDataDescription const& description) const
 {
-    std::unordered_map<uint64_t, int> cellIndexByIds;
-    for (auto const& cluster: description.clusters) {
-        for (auto const& cell : cluster.cells) {
-            addCell(result, cell, cellIndexByIds);
-        }
-    }
+    MEASURE_SCOPE("converter.toTO");
+    std::vector<CellDescription const*> cells;
     for (auto const& cluster : description.clusters) {
         for (auto const& cell : cluster.cells) {
-            if (cell.id != 0) {
-                setConnections(result, cell, cellIndexByIds);
-            }
+            cells.emplace_back(&cell);
         }
     }
-    for (auto const& particle : description.particles) {
-        addParticle(result, particle);
-    }
+    addCells(result, cells);
+    addParticles(result, description.particles);
 }
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, DataDescription const& description) const
 {
-    std::unordered_map<uint64_t, int> cellIndexByIds;
-    for (auto const& cell : description.cells) {
-        addCell(result, cell, cellIndexByIds);
-    }
+    MEASURE_SCOPE("converter.toTO");
+    std::vector<CellDescription const*> cells;
+    cells.reserve(description.cells.size());
     for (auto const& cell : description.cells) {
-        if (cell.id != 0) {
-            setConnections(result, cell, cellIndexByIds);
-        }
-    }
-    for (auto const& particle : description.particles) {
-        addParticle(result, particle);
+        cells.emplace_back(&cell);
     }
+    addCells(result, cells);
+    addParticles(result, description.particles);
 }
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, CellDescription const& cell) const
 {
-    std::unordered_map<uint64_t, int> cellIndexByIds;
-    addCell(result, cell, cellIndexByIds);
+    addCells(result, {&cell}, false);
 }
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, ParticleDescription const& particle) const
 {
-    addParticle(result, particle);
+    addParticles(result, {particle});
 }
 
 void DescriptionConverter::addAdditionalDataSizeForCell(CellDescription const& cell, uint64_t& additionalDataSize) const
 {
-    additionalDataSize += cell.metadata.name.size() + cell.metadata.description.size();
-    switch (cell.getCellFunctionType()) {
-    case CellFunction_Neuron: {
-        additionalDataSize += MAX_CHANNELS * (MAX_CHANNELS + 1) * sizeof(float);
-    } break;
-    case CellFunction_Transmitter:
-        break;
-    case CellFunction_Constructor:
-        additionalDataSize += std::get<ConstructorDescription>(*cell.cellFunction).genome.size();
-        break;
-    case CellFunction_Sensor:
-        break;
-    case CellFunction_Nerve:
-        break;
-    case CellFunction_Attacker:
-        break;
-    case CellFunction_Injector:
-        additionalDataSize += std::get<InjectorDescription>(*cell.cellFunction).genome.size();
-        break;
-    case CellFunction_Muscle:
-        break;
-    case CellFunction_Defender:
-        break;
-    case CellFunction_Reconnector:
-        break;
-    case CellFunction_Detonator:
-        break;
-    }
-}    
-
-namespace
-{
-    template <typename T>
-    void setInplaceDifference(std::unordered_set<T>& a, std::unordered_set<T> const& b)
-    {
-        for (auto const& element : b) {
-            a.erase(element);
-        }
+    addAdditionalDataSizeForCellWithoutGenome(cell, additionalDataSize);
+    if (auto genome = getGenome(cell)) {
+        additionalDataSize += genome->size();
     }
 }
 
-auto DescriptionConverter::scanAndCreateClusterDescription(
-    DataTO const& dataTO,
-    int startCellIndex,
-    std::unordered_set<int>& freeCellIndices) const
-    -> CreateClusterReturnData
+void DescriptionConverter::addAdditionalDataSizeForCellWithoutGenome(CellDescription const& cell, uint64_t& additionalDataSize) const
 {
-    CreateClusterReturnData result; 
-
-    std::unordered_set<int> currentCellIndices;
-    currentCellIndices.insert(startCellIndex);
-    std::unordered_set<int> scannedCellIndices = currentCellIndices;
-
-    std::vector<CellDescription> cells;
-    std::unordered_set<int> nextCellIndices;
-    int cellDescIndex = 0;
-    do {
-        for (auto const& currentCellIndex : currentCellIndices) {
-            cells.emplace_back(createCellDescription(dataTO, currentCellIndex));
-            result.cellTOIndexToCellDescIndex.emplace(currentCellIndex, cellDescIndex);
-            auto const& cellTO = dataTO.cells[currentCellIndex];
-            for (int i = 0; i < cellTO.numConnections; ++i) {
-                auto connectionTO = cellTO.connections[i];
-                if (connectionTO.cellIndex != -1) {
-                    if (scannedCellIndices.find(connectionTO.cellIndex) == scannedCellIndices.end()) {
-                        nextCellIndices.insert(connectionTO.cellIndex);
-                        scannedCellIndices.insert(connectionTO.cellIndex);
-                    }
-                }
-            }
-            ++cellDescIndex;
-        }
-        currentCellIndices = nextCellIndices;
-        nextCellIndices.clear();
-    } while (!currentCellIndices.empty());
-
-    setInplaceDifference(freeCellIndices, scannedCellIndices);
-
-    result.cluster.addCells(cells);
-
-    return result;
+    additionalDataSize += cell.metadata.name.size() + cell.metadata.description.size();
+    if (cell.getCellFunctionType() == CellFunction_Neuron) {
+        additionalDataSize += MAX_CHANNELS * (MAX_CHANNELS + 1) * sizeof(float);
+    }
 }
 
 CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO, int cellIndex) const
@@ -415,12 +420,8 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
     switch (cellTO.cellFunction) {
     case CellFunction_Neuron: {
         NeuronDescription neuron;
-        std::vector<float> weigthsAndBias;
-        convert(dataTO, sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1), cellTO.cellFunctionData.neuron.weightsAndBiasesDataIndex, weigthsAndBias);
-        std::tie(neuron.weights, neuron.biases) = splitWeightsAndBias(weigthsAndBias);
-        for (int i = 0; i < MAX_CHANNELS; ++i) {
-            neuron.activationFunctions[i] = cellTO.cellFunctionData.neuron.activationFunctions[i];
-        }
+        copyWeightsAndBiasesFromAuxiliaryData(dataTO, cellTO.cellFunctionData.neuron.weightsAndBiasesDataIndex, neuron);
+        std::memcpy(neuron.activationFunctions.data(), cellTO.cellFunctionData.neuron.activationFunctions, sizeof(NeuronActivationFunctions));
         result.cellFunction = neuron;
     } break;
     case CellFunction_Transmitter: {
@@ -512,9 +513,7 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
     } break;
     }
 
-    for (int i = 0; i < MAX_CHANNELS; ++i) {
-        result.activity.channels[i] = cellTO.activity.channels[i];
-    }
+    std::memcpy(result.activity.channels.data(), cellTO.activity.channels, sizeof(ActivityChannels));
     result.activity.origin = cellTO.activity.origin;
     result.activity.targetX = cellTO.activity.targetX;
     result.activity.targetY = cellTO.activity.targetY;
@@ -532,25 +531,108 @@ namespace
     }
 }
 
-void DescriptionConverter::addParticle(DataTO const& dataTO, ParticleDescription const& particleDesc) const
+void DescriptionConverter::addParticles(DataTO const& dataTO, std::vector<ParticleDescription> const& particles) const
 {
-    auto particleIndex = (*dataTO.numParticles)++;
-
-	ParticleTO& particleTO = dataTO.particles[particleIndex];
-	particleTO.id = particleDesc.id == 0 ? NumberGenerator::get().getId() : particleDesc.id;
-    particleTO.pos = {particleDesc.pos.x, particleDesc.pos.y};
-    particleTO.vel = {particleDesc.vel.x, particleDesc.vel.y};
-    particleTO.energy = particleDesc.energy;
-    checkAndCorrectInvalidEnergy(particleTO.energy);
-    particleTO.color = particleDesc.color;
+    auto startIndex = *dataTO.numParticles;
+
+    std::vector<uint64_t> ids(particles.size());
+    for (size_t i = 0; i < particles.size(); ++i) {
+        ids[i] = particles[i].id == 0 ? NumberGenerator::get().getId() : particles[i].id;
+    }
+
+    ParallelService::forEachRange(particles.size(), [&](uint64_t startRange, uint64_t endRange) {
+        for (auto i = startRange; i < endRange; ++i) {
+            auto const& particleDesc = particles[i];
+            ParticleTO& particleTO = dataTO.particles[startIndex + i];
+            particleTO.id = ids[i];
+            particleTO.pos = {particleDesc.pos.x, particleDesc.pos.y};
+            particleTO.vel = {particleDesc.vel.x, particleDesc.vel.y};
+            particleTO.energy = particleDesc.energy;
+            checkAndCorrectInvalidEnergy(particleTO.energy);
+            particleTO.color = particleDesc.color;
+        }
+    });
+    *dataTO.numParticles += particles.size();
 }
 
-void DescriptionConverter::addCell(
-    DataTO const& dataTO, CellDescription const& cellDesc, std::unordered_map<uint64_t, int>& cellIndexTOByIds) const
+void DescriptionConverter::addCells(DataTO const& dataTO, std::vector<CellDescription const*> const& cells, bool resolveConnections) const
 {
-    int cellIndex = (*dataTO.numCells)++;
-    CellTO& cellTO = dataTO.cells[cellIndex];
-    cellTO.id = cellDesc.id == 0 ? NumberGenerator::get().getId() : cellDesc.id;
+    auto startIndex = *dataTO.numCells;
+    auto numCells = cells.size();
+
+    //first pass: ids, deduplicated genomes, auxiliary data offsets via prefix sum and id index
+    std::vector<uint64_t> ids(numCells);
+    for (size_t i = 0; i < numCells; ++i) {
+        ids[i] = cells[i]->id == 0 ? NumberGenerator::get().getId() : cells[i]->id;
+    }
+
+    //identical genomes share one auxiliary data block, the blocks are placed in front of the remaining auxiliary data
+    std::vector<uint64_t> genomeHashes(numCells);
+    ParallelService::forEachRange(numCells, [&](uint64_t startRange, uint64_t endRange) {
+        for (auto i = startRange; i < endRange; ++i) {
+            if (auto genome = getGenome(*cells[i])) {
+                genomeHashes[i] = GenomePool::calcHash(*genome);
+            }
+        }
+    });
+    GenomePool genomePool;
+    std::vector<int> genomeIndices(numCells, -1);
+    for (size_t i = 0; i < numCells; ++i) {
+        if (auto genome = getGenome(*cells[i])) {
+            genomeIndices[i] = genomePool.add(*genome, genomeHashes[i]);
+        }
+    }
+    auto const& genomes = genomePool.getGenomes();
+    std::vector<uint64_t> genomeDataIndices(genomes.size());
+    auto genomeDataIndex = *dataTO.numAuxiliaryData;
+    for (size_t i = 0; i < genomes.size(); ++i) {
+        genomeDataIndices[i] = genomeDataIndex;
+        std::memcpy(dataTO.auxiliaryData + genomeDataIndex, genomes[i].data(), genomes[i].size());
+        genomeDataIndex += genomes[i].size();
+    }
+
+    std::vector<uint64_t> auxiliaryDataIndices(numCells + 1, 0);
+    ParallelService::forEachRange(numCells, [&](uint64_t startRange, uint64_t endRange) {
+        for (auto i = startRange; i < endRange; ++i) {
+            addAdditionalDataSizeForCellWithoutGenome(*cells[i], auxiliaryDataIndices[i + 1]);
+        }
+    });
+    auxiliaryDataIndices[0] = genomeDataIndex;
+    for (size_t i = 0; i < numCells; ++i) {
+        auxiliaryDataIndices[i + 1] += auxiliaryDataIndices[i];
+    }
+    CellIndexById cellIndexById(numCells);
+    for (size_t i = 0; i < numCells; ++i) {
+        cellIndexById[i] = {ids[i], toInt(startIndex + i)};
+    }
+    std::ranges::stable_sort(cellIndexById, [](auto const& left, auto const& right) { return left.first < right.first; });
+
+    //second pass: fill cellTOs, copy auxiliary data and resolve connections
+    ParallelService::forEachRange(numCells, [&](uint64_t startRange, uint64_t endRange) {
+        for (auto i = startRange; i < endRange; ++i) {
+            auto& cellTO = dataTO.cells[startIndex + i];
+            auto auxiliaryDataIndex = auxiliaryDataIndices[i];
+            auto cellGenomeDataIndex = genomeIndices[i] != -1 ? genomeDataIndices[genomeIndices[i]] : 0;
+            setCellTO(dataTO, cellTO, *cells[i], ids[i], cellGenomeDataIndex, auxiliaryDataIndex);
+            CHECK(auxiliaryDataIndex == auxiliaryDataIndices[i + 1]);
+            if (resolveConnections && cells[i]->id != 0) {
+                setConnections(cellTO, *cells[i], cellIndexById);
+            }
+        }
+    });
+    *dataTO.numCells += numCells;
+    *dataTO.numAuxiliaryData = auxiliaryDataIndices[numCells];
+}
+
+void DescriptionConverter::setCellTO(
+    DataTO const& dataTO,
+    CellTO& cellTO,
+    CellDescription const& cellDesc,
+    uint64_t id,
+    uint64_t genomeDataIndex,
+    uint64_t& auxiliaryDataIndex) const
+{
+    cellTO.id = id;
 	cellTO.pos= { cellDesc.pos.x, cellDesc.pos.y };
     cellTO.vel = {cellDesc.vel.x, cellDesc.vel.y};
     cellTO.energy = cellDesc.energy;
@@ -571,13 +653,8 @@ void DescriptionConverter::addCell(
     case CellFunction_Neuron: {
         NeuronTO neuronTO;
         auto const& neuronDesc = std::get<NeuronDescription>(*cellDesc.cellFunction);
-        std::vector<float> weigthsAndBias = unitWeightsAndBias(neuronDesc.weights, neuronDesc.biases);
-        int targetSize;
-        convert(dataTO, weigthsAndBias, targetSize, neuronTO.weightsAndBiasesDataIndex);
-        CHECK(targetSize == sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1));
-        for (int i = 0; i < MAX_CHANNELS; ++i) {
-            neuronTO.activationFunctions[i] = neuronDesc.activationFunctions[i];
-        }
+        copyWeightsAndBiasesToAuxiliaryData(dataTO, neuronDesc, neuronTO.weightsAndBiasesDataIndex, auxiliaryDataIndex);
+        std::memcpy(neuronTO.activationFunctions, neuronDesc.activationFunctions.data(), sizeof(NeuronActivationFunctions));
         cellTO.cellFunctionData.neuron = neuronTO;
     } break;
     case CellFunction_Transmitter: {
@@ -592,7 +669,8 @@ void DescriptionConverter::addCell(
         constructorTO.activationMode = constructorDesc.activationMode;
         constructorTO.constructionActivationTime = constructorDesc.constructionActivationTime;
         CHECK(constructorDesc.genome.size() >= Const::GenomeHeaderSize)
-        convert(dataTO, constructorDesc.genome, constructorTO.genomeSize, constructorTO.genomeDataIndex);
+        constructorTO.genomeSize = static_cast<uint16_t>(constructorDesc.genome.size());
+        constructorTO.genomeDataIndex = genomeDataIndex;
         constructorTO.numInheritedGenomeNodes = static_cast<uint16_t>(constructorDesc.numInheritedGenomeNodes);
         constructorTO.lastConstructedCellId = constructorDesc.lastConstructedCellId;
         constructorTO.genomeCurrentNodeIndex = static_cast<uint16_t>(constructorDesc.genomeCurrentNodeIndex);
@@ -641,7 +719,8 @@ void DescriptionConverter::addCell(
         injectorTO.mode = injectorDesc.mode;
         injectorTO.counter = injectorDesc.counter;
         CHECK(injectorDesc.genome.size() >= Const::GenomeHeaderSize)
-        convert(dataTO, injectorDesc.genome, injectorTO.genomeSize, injectorTO.genomeDataIndex);
+        injectorTO.genomeSize = static_cast<uint16_t>(injectorDesc.genome.size());
+        injectorTO.genomeDataIndex = genomeDataIndex;
         injectorTO.genomeGeneration = injectorDesc.genomeGeneration;
         cellTO.cellFunctionData.injector = injectorTO;
     } break;
@@ -677,9 +756,7 @@ void DescriptionConverter::addCell(
         cellTO.cellFunctionData.detonator = detonatorTO;
     } break;
     }
-    for (int i = 0; i < MAX_CHANNELS; ++i) {
-        cellTO.activity.channels[i] = cellDesc.activity.channels[i];
-    }
+    std::memcpy(cellTO.activity.channels, cellDesc.activity.channels.data(), sizeof(ActivityChannels));
     cellTO.activity.origin = cellDesc.activity.origin;
     cellTO.activity.targetX = cellDesc.activity.targetX;
     cellTO.activity.targetY = cellDesc.activity.targetY;
@@ -689,19 +766,17 @@ void DescriptionConverter::addCell(
     cellTO.age = cellDesc.age;
     cellTO.color = cellDesc.color;
     cellTO.genomeComplexity = cellDesc.genomeComplexity;
-    convert(dataTO, cellDesc.metadata.name, cellTO.metadata.nameSize, cellTO.metadata.nameDataIndex);
-    convert(dataTO, cellDesc.metadata.description, cellTO.metadata.descriptionSize, cellTO.metadata.descriptionDataIndex);
-	cellIndexTOByIds.insert_or_assign(cellTO.id, cellIndex);
+    copyToAuxiliaryData(dataTO, cellDesc.metadata.name, cellTO.metadata.nameSize, cellTO.metadata.nameDataIndex, auxiliaryDataIndex);
+    copyToAuxiliaryData(dataTO, cellDesc.metadata.description, cellTO.metadata.descriptionSize, cellTO.metadata.descriptionDataIndex, auxiliaryDataIndex);
 }
 
-void DescriptionConverter::setConnections(DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int> const& cellIndexByIds) const
+void DescriptionConverter::setConnections(CellTO& cellTO, CellDescription const& cellToAdd, CellIndexById const& cellIndexById) const
 {
     int index = 0;
-    auto& cellTO = dataTO.cells[cellIndexByIds.at(cellToAdd.id)];
     float angleOffset = 0;
     for (ConnectionDescription const& connection : cellToAdd.connections) {
         if (connection.cellId != 0) {
-            cellTO.connections[index].cellIndex = cellIndexByIds.at(connection.cellId);
+            cellTO.connections[index].cellIndex = getCellIndex(cellIndexById, connection.cellId);
             cellTO.connections[index].distance = connection.distance;
             cellTO.connections[index].angleFromPrevious = connection.angleFromPrevious + angleOffset;
             ++index;
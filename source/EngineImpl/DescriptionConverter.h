@@ -19,6 +19,29 @@ public:
     ArraySizes getArraySizes(ClusteredDataDescription const& data) const;
 
     ClusteredDataDescription convertTOtoClusteredDataDescription(DataTO const& dataTO) const;
+
+    //clusters are determined by a parallel union-find over the cell connections
+    //cellIndices contains the cell indices ordered by cluster, cluster i consists of the range [clusterStartIndices[i], clusterStartIndices[i + 1])
+    struct CellClusters
+    {
+        std::vector<int> cellIndices;
+        std::vector<uint64_t> clusterStartIndices;
+
+        uint64_t getNumClusters() const { return clusterStartIndices.size() - 1; }
+    };
+    CellClusters calcCellClusters(DataTO const& dataTO) const;
+
+    //groups the cells by their roots, roots[i] is the smallest index of the cells belonging to the cluster of cell i
+    CellClusters calcCellClusters(std::vector<int> const& roots) const;
+
+    //for chunk-wise conversion: converts the clusters in [startClusterIndex, endClusterIndex)
+    std::vector<ClusterDescription> convertTOtoClusterDescriptions(
+        DataTO const& dataTO,
+        CellClusters const& cellClusters,
+        uint64_t startClusterIndex,
+        uint64_t endClusterIndex) const;
+    std::vector<ParticleDescription> convertTOtoParticleDescriptions(DataTO const& dataTO, uint64_t startIndex, uint64_t endIndex) const;
+
     DataDescription convertTOtoDataDescription(DataTO const& dataTO) const;
     OverlayDescription convertTOtoOverlayDescription(DataTO const& dataTO) const;
     void convertDescriptionToTO(DataTO& result, ClusteredDataDescription const& description) const;
@@ -27,25 +50,28 @@ public:
     void convertDescriptionToTO(DataTO& result, ParticleDescription const& particle) const;
 
 private:
+    //the sizes include a genome copy for each cell since the simulation holds the genomes separately
     void addAdditionalDataSizeForCell(CellDescription const& cell, uint64_t& additionalDataSize) const;
+    void addAdditionalDataSizeForCellWithoutGenome(CellDescription const& cell, uint64_t& additionalDataSize) const;
 
-	struct CreateClusterReturnData
-    {
-        ClusterDescription cluster;
-        std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-	};
-    CreateClusterReturnData scanAndCreateClusterDescription(
-        DataTO const& dataTO,
-        int startCellIndex,
-        std::unordered_set<int>& freeCellIndices) const;
     CellDescription createCellDescription(DataTO const& dataTO, int cellIndex) const;
 
-	void addCell(
-        DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int>& cellIndexTOByIds) const;
-    void addParticle(DataTO const& dataTO, ParticleDescription const& particleDesc) const;
+    //cells are converted in two passes: the first one writes the deduplicated genomes, determines the auxiliary data offsets and builds an id index,
+    //the second one fills the cellTOs in parallel
+    //connections are only resolved for a complete description, a single changed cell keeps its connections in the simulation
+    void addCells(DataTO const& dataTO, std::vector<CellDescription const*> const& cells, bool resolveConnections = true) const;
+    void addParticles(DataTO const& dataTO, std::vector<ParticleDescription> const& particles) const;
+
+    void setCellTO(
+        DataTO const& dataTO,
+        CellTO& cellTO,
+        CellDescription const& cellDesc,
+        uint64_t id,
+        uint64_t genomeDataIndex,
+        uint64_t& auxiliaryDataIndex) const;
 
-	void setConnections(
-        DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int> const& cellIndexByIds) const;
+    using CellIndexById = std::vector<std::pair<uint64_t, int>>;
+    void setConnections(CellTO& cellTO, CellDescription const& cellToAdd, CellIndexById const& cellIndexById) const;
 
 private:
 	SimulationParameters _parameters;
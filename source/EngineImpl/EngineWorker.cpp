@@ -1,31 +1,53 @@
 #include "EngineWorker.h"
 
+#include <algorithm>
 #include <chrono>
+#include <exception>
+#include <thread>
+
+#include "Base/MetricsService.h"
+#include "EngineInterface/TimestepBatchService.h"
 
 #include "EngineGpuKernels/TOs.cuh"
 #include "EngineGpuKernels/SimulationCudaFacade.cuh"
-#include "AccessDataTOCache.h"
+#include "ClusteredDataReaderImpl.h"
+#include "DataTOFileService.h"
+#include "DataTOPool.h"
 #include "DescriptionConverter.h"
 
 namespace
 {
     std::chrono::milliseconds const FrameTimeout(500);
+    std::chrono::seconds const AccessTimeout(7);
+
+    //the last part of a TPS slowdown is spent spinning since the wake-up time of the OS scheduler is not precise enough
+    std::chrono::microseconds const SpinDurationForSlowdown(1000);
 }
 
 void EngineWorker::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters)
 {
-    _accessState = 0;
+    {
+        std::lock_guard lock(_mutexForThreadLoop);
+        _accessState = 0;
+        _isThreadLoopTerminated = false;
+    }
+    _averageTimestepDuration = 0;
+    _numParametersUpdatesAfterTimestep = 0;
+    ++_parametersVersion;
+    onEntitiesChanged();
     _settings.generalSettings = generalSettings;
     _settings.simulationParameters = parameters;
-    _dataTOCache = std::make_shared<_AccessDataTOCache>();
+    _dataTOPool = std::make_shared<_DataTOPool>(true);
     _simulationCudaFacade = std::make_shared<_SimulationCudaFacade>(timestep, _settings);
+    _exportId.reset();
     _cudaResource = nullptr;
 }
 
 void EngineWorker::clear()
 {
     EngineWorkerGuard access(this);
-    return _simulationCudaFacade->clear();
+    _simulationCudaFacade->clear();
+    onEntitiesChanged();
 }
 
 void EngineWorker::setImageResource(void* image)
@@ -73,15 +95,15 @@ std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOv
         _simulationCudaFacade->drawVectorGraphics(
             {rectUpperLeft.x, rectUpperLeft.y}, {rectLowerRight.x, rectLowerRight.y}, _cudaResource, {imageSize.x, imageSize.y}, zoom);
 
-        DataTO dataTO = provideTO();
+        auto dataTO = provideTO();
 
         _simulationCudaFacade->getOverlayData(
             {toInt(rectUpperLeft.x), toInt(rectUpperLeft.y)},
             int2{toInt(rectLowerRight.x), toInt(rectLowerRight.y)},
-            dataTO);
+            *dataTO);
 
         DescriptionConverter converter(_settings.simulationParameters);
-        auto result = converter.convertTOtoOverlayDescription(dataTO);
+        auto result = converter.convertTOtoOverlayDescription(*dataTO);
 
         syncSimulationWithRenderingIfDesired();
         return result;
@@ -97,6 +119,7 @@ bool EngineWorker::isSyncSimulationWithRendering() const
 void EngineWorker::setSyncSimulationWithRendering(bool value)
 {
     _syncSimulationWithRendering = value;
+    notifyThreadLoop();
 }
 
 int EngineWorker::getSyncSimulationWithRenderingRatio() const
@@ -111,19 +134,71 @@ void EngineWorker::setSyncSimulationWithRenderingRatio(int value)
 
 ClusteredDataDescription EngineWorker::getClusteredSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
 {
-    DataTO dataTO;
+    DataTOLease dataTO;
     {
         EngineWorkerGuard access(this);
 
-        dataTO.init(_simulationCudaFacade->getArraySizes());
+        dataTO = provideTO();
 
-        _simulationCudaFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+        _simulationCudaFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, *dataTO);
     }
     DescriptionConverter converter(_settings.simulationParameters);
 
-    auto result = converter.convertTOtoClusteredDataDescription(dataTO);
-    dataTO.destroy();
-    return result;
+    return converter.convertTOtoClusteredDataDescription(*dataTO);
+}
+
+ClusteredDataReader EngineWorker::getClusteredSimulationDataReader(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    //the data is exported on the GPU in one step to obtain a consistent state and then transferred to the host in chunks
+    uint64_t exportId;
+    ArraySizes exportedSizes;
+    {
+        EngineWorkerGuard access(this);
+
+        exportedSizes = _simulationCudaFacade->exportSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y});
+        exportId = ++_numExports;
+        _exportId = exportId;
+    }
+    return std::make_shared<_ClusteredDataReaderImpl>(this, exportId, exportedSizes, _settings.simulationParameters);
+}
+
+DataTOLease EngineWorker::getExportedCells(uint64_t exportId, uint64_t startIndex, uint64_t endIndex)
+{
+    EngineWorkerGuard access(this);
+    checkExportId(exportId);
+
+    auto dataTO = _dataTOPool->acquire({endIndex - startIndex, 0, 0});
+    _simulationCudaFacade->getExportedCells(startIndex, endIndex, *dataTO);
+    return dataTO;
+}
+
+DataTOLease EngineWorker::getExportedCells(uint64_t exportId, std::vector<uint64_t> const& cellIndices, uint64_t auxiliaryDataSize)
+{
+    EngineWorkerGuard access(this);
+    checkExportId(exportId);
+
+    auto dataTO = _dataTOPool->acquire({cellIndices.size(), 0, auxiliaryDataSize});
+    _simulationCudaFacade->getExportedCells(cellIndices, auxiliaryDataSize, *dataTO);
+    return dataTO;
+}
+
+DataTOLease EngineWorker::getExportedParticles(uint64_t exportId, uint64_t startIndex, uint64_t endIndex)
+{
+    EngineWorkerGuard access(this);
+    checkExportId(exportId);
+
+    auto dataTO = _dataTOPool->acquire({0, endIndex - startIndex, 0});
+    _simulationCudaFacade->getExportedParticles(startIndex, endIndex, *dataTO);
+    return dataTO;
+}
+
+void EngineWorker::releaseExportedData(uint64_t exportId)
+{
+    EngineWorkerGuard access(this);
+    if (_exportId == exportId && _simulationCudaFacade) {
+        _simulationCudaFacade->releaseExportedData();
+        _exportId.reset();
+    }
 }
 
 DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
@@ -131,10 +206,10 @@ DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft
     EngineWorkerGuard access(this);
 
     auto dataTO = provideTO();
-    _simulationCudaFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+    _simulationCudaFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, *dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
-    auto result = converter.convertTOtoDataDescription(dataTO);
+    auto result = converter.convertTOtoDataDescription(*dataTO);
     return result;
 }
 
@@ -142,13 +217,13 @@ ClusteredDataDescription EngineWorker::getSelectedClusteredSimulationData(bool i
 {
     EngineWorkerGuard access(this);
 
-    DataTO dataTO = provideTO();
+    auto dataTO = provideTO();
     
-    _simulationCudaFacade->getSelectedSimulationData(includeClusters, dataTO);
+    _simulationCudaFacade->getSelectedSimulationData(includeClusters, *dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
 
-    auto result = converter.convertTOtoClusteredDataDescription(dataTO);
+    auto result = converter.convertTOtoClusteredDataDescription(*dataTO);
     return result;
 }
 
@@ -156,13 +231,13 @@ DataDescription EngineWorker::getSelectedSimulationData(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    DataTO dataTO = provideTO();
+    auto dataTO = provideTO();
     
-    _simulationCudaFacade->getSelectedSimulationData(includeClusters, dataTO);
+    _simulationCudaFacade->getSelectedSimulationData(includeClusters, *dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
 
-    auto result = converter.convertTOtoDataDescription(dataTO);
+    auto result = converter.convertTOtoDataDescription(*dataTO);
 
     return result;
 }
@@ -171,13 +246,13 @@ DataDescription EngineWorker::getInspectedSimulationData(std::vector<uint64_t> o
 {
     EngineWorkerGuard access(this);
 
-    DataTO dataTO = provideTO();
+    auto dataTO = provideTO();
     
-    _simulationCudaFacade->getInspectedSimulationData(objectsIds, dataTO);
+    _simulationCudaFacade->getInspectedSimulationData(objectsIds, *dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
 
-    auto result = converter.convertTOtoDataDescription(dataTO);
+    auto result = converter.convertTOtoDataDescription(*dataTO);
     return result;
 }
 
@@ -191,11 +266,16 @@ StatisticsHistory const& EngineWorker::getStatisticsHistory() const
     return _simulationCudaFacade->getStatisticsHistory();
 }
 
-void EngineWorker::setStatisticsHistory(StatisticsHistoryData const& data)
+void EngineWorker::setStatisticsHistory(StatisticsHistorySnapshot const& data)
 {
     _simulationCudaFacade->setStatisticsHistory(data);
 }
 
+TransferBufferStatistics EngineWorker::getTransferBufferStatistics() const
+{
+    return _dataTOPool->getStatistics();
+}
+
 void EngineWorker::addAndSelectSimulationData(DataDescription const& dataToUpdate)
 {
     DescriptionConverter converter(_settings.simulationParameters);
@@ -206,11 +286,12 @@ void EngineWorker::addAndSelectSimulationData(DataDescription const& dataToUpdat
 
     _simulationCudaFacade->resizeArraysIfNecessary(arraySizes);
 
-    DataTO dataTO = provideTO();
+    auto dataTO = provideTO();
 
-    converter.convertDescriptionToTO(dataTO, dataToUpdate);
+    converter.convertDescriptionToTO(*dataTO, dataToUpdate);
 
-    _simulationCudaFacade->addAndSelectSimulationData(dataTO);
+    _simulationCudaFacade->addAndSelectSimulationData(*dataTO);
+    onEntitiesChanged();
 }
 
 void EngineWorker::setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate)
@@ -221,11 +302,12 @@ void EngineWorker::setClusteredSimulationData(ClusteredDataDescription const& da
 
     _simulationCudaFacade->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate));
 
-    DataTO dataTO = provideTO();
+    auto dataTO = provideTO();
 
-    converter.convertDescriptionToTO(dataTO, dataToUpdate);
+    converter.convertDescriptionToTO(*dataTO, dataToUpdate);
 
-    _simulationCudaFacade->setSimulationData(dataTO);
+    _simulationCudaFacade->setSimulationData(*dataTO);
+    onEntitiesChanged();
 }
 
 void EngineWorker::setSimulationData(DataDescription const& dataToUpdate)
@@ -236,94 +318,118 @@ void EngineWorker::setSimulationData(DataDescription const& dataToUpdate)
 
     _simulationCudaFacade->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate));
 
-    DataTO dataTO = provideTO();
-    converter.convertDescriptionToTO(dataTO, dataToUpdate);
+    auto dataTO = provideTO();
+    converter.convertDescriptionToTO(*dataTO, dataToUpdate);
 
-    _simulationCudaFacade->setSimulationData(dataTO);
+    _simulationCudaFacade->setSimulationData(*dataTO);
+    onEntitiesChanged();
 }
 
-void EngineWorker::removeSelectedObjects(bool includeClusters)
+void EngineWorker::setSimulationDataFromSnapshotFile(std::string const& filename)
 {
+    auto mappedDataTO = DataTOFileService::mapFromFile(filename);
+
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->removeSelectedObjects(includeClusters);
+    _simulationCudaFacade->resizeArraysIfNecessary(mappedDataTO.arraySizes);
+    _simulationCudaFacade->setSimulationData(mappedDataTO.dataTO);
+    onEntitiesChanged();
 }
 
-void EngineWorker::relaxSelectedObjects(bool includeClusters)
+void EngineWorker::saveSimulationDataToSnapshotFile(std::string const& filename, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
 {
-    EngineWorkerGuard access(this);
+    DataTOLease dataTO;
+    {
+        EngineWorkerGuard access(this);
+
+        dataTO = provideTO();
 
-    _simulationCudaFacade->relaxSelectedObjects(includeClusters);
+        _simulationCudaFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, *dataTO);
+    }
+    DataTOFileService::writeToFile(filename, *dataTO);
 }
 
-void EngineWorker::uniformVelocitiesForSelectedObjects(bool includeClusters)
+std::future<void> EngineWorker::removeSelectedObjects(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _simulationCudaFacade->uniformVelocitiesForSelectedObjects(includeClusters);
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->removeSelectedObjects(includeClusters); }});
 }
 
-void EngineWorker::makeSticky(bool includeClusters)
+std::future<void> EngineWorker::relaxSelectedObjects(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _simulationCudaFacade->makeSticky(includeClusters);
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->relaxSelectedObjects(includeClusters); }});
 }
 
-void EngineWorker::removeStickiness(bool includeClusters)
+std::future<void> EngineWorker::uniformVelocitiesForSelectedObjects(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _simulationCudaFacade->removeStickiness(includeClusters);
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->uniformVelocitiesForSelectedObjects(includeClusters); }});
 }
 
-void EngineWorker::setBarrier(bool value, bool includeClusters)
+std::future<void> EngineWorker::makeSticky(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->makeSticky(includeClusters); }});
+}
 
-    _simulationCudaFacade->setBarrier(value, includeClusters);
+std::future<void> EngineWorker::removeStickiness(bool includeClusters)
+{
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->removeStickiness(includeClusters); }});
 }
 
-void EngineWorker::changeCell(CellDescription const& changedCell)
+std::future<void> EngineWorker::setBarrier(bool value, bool includeClusters)
 {
-    EngineWorkerGuard access(this);
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->setBarrier(value, includeClusters); }});
+}
 
-    auto dataTO = provideTO();
+std::future<void> EngineWorker::changeCell(CellDescription const& changedCell)
+{
+    return submitEditCommand(
+        {.function =
+             [=, this] {
+                 auto dataTO = provideTO();
 
-    DescriptionConverter converter(_settings.simulationParameters);
-    converter.convertDescriptionToTO(dataTO, changedCell);
+                 DescriptionConverter converter(_settings.simulationParameters);
+                 converter.convertDescriptionToTO(*dataTO, changedCell);
 
-    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+                 _simulationCudaFacade->changeInspectedSimulationData(*dataTO);
+             },
+         .coalescingKey = std::make_pair(CoalescingType::ChangeCell, changedCell.id)});
 }
 
-void EngineWorker::changeParticle(ParticleDescription const& changedParticle)
+std::future<void> EngineWorker::changeParticle(ParticleDescription const& changedParticle)
 {
-    EngineWorkerGuard access(this);
-
-    auto dataTO = provideTO();
+    return submitEditCommand(
+        {.function =
+             [=, this] {
+                 auto dataTO = provideTO();
 
-    DescriptionConverter converter(_settings.simulationParameters);
-    converter.convertDescriptionToTO(dataTO, changedParticle);
+                 DescriptionConverter converter(_settings.simulationParameters);
+                 converter.convertDescriptionToTO(*dataTO, changedParticle);
 
-    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+                 _simulationCudaFacade->changeInspectedSimulationData(*dataTO);
+             },
+         .coalescingKey = std::make_pair(CoalescingType::ChangeParticle, changedParticle.id)});
 }
 
 void EngineWorker::calcTimesteps(uint64_t timesteps)
 {
     EngineWorkerGuard access(this);
 
+    MEASURE_SCOPE("engine.calcTimesteps");
+    MetricsService::incrementCounter("engine.timesteps", static_cast<int64_t>(timesteps));
     _simulationCudaFacade->calcTimestep(timesteps, true);
+    onTimestepsCalculated();
 }
 
 void EngineWorker::applyCataclysm(int power)
 {
     EngineWorkerGuard access(this);
     _simulationCudaFacade->applyCataclysm(power);
+    onEntitiesChanged();
 }
 
 void EngineWorker::beginShutdown()
 {
     _isShutdown.store(true);
+    notifyThreadLoop();
 }
 
 void EngineWorker::endShutdown()
@@ -331,6 +437,7 @@ void EngineWorker::endShutdown()
     _isSimulationRunning = false;
     _isShutdown = false;
     _simulationCudaFacade.reset();
+    _exportId.reset();
 }
 
 int EngineWorker::getTpsRestriction() const
@@ -349,6 +456,11 @@ float EngineWorker::getTps() const
     return _tps.load();
 }
 
+SimulationVersions EngineWorker::getVersions() const
+{
+    return {.parameters = _parametersVersion.load(), .selection = _selectionVersion.load(), .entities = _entitiesVersion.load()};
+}
+
 uint64_t EngineWorker::getCurrentTimestep() const
 {
     return _simulationCudaFacade->getCurrentTimestep();
@@ -369,12 +481,14 @@ SimulationParameters EngineWorker::getSimulationParameters() const
 void EngineWorker::setSimulationParameters(SimulationParameters const& parameters)
 {
     _simulationCudaFacade->setSimulationParameters(parameters);
+    ++_parametersVersion;
 }
 
 void EngineWorker::setGpuSettings_async(GpuSettings const& gpuSettings)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _updateGpuSettingsJob = gpuSettings;
+    submitEditCommand(
+        {.function = [=, this] { _simulationCudaFacade->setGpuConstants(gpuSettings); },
+         .coalescingKey = std::make_pair(CoalescingType::GpuSettings, uint64_t(0))});
 }
 
 void EngineWorker::applyForce_async(
@@ -383,107 +497,131 @@ void EngineWorker::applyForce_async(
     RealVector2D const& force,
     float radius)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _applyForceJobs.emplace_back(ApplyForceJob{start, end, force, radius});
+    submitEditCommand(
+        {.function =
+             [=, this] {
+                 _simulationCudaFacade->applyForce({{start.x, start.y}, {end.x, end.y}, {force.x, force.y}, radius, false});
+             }});
 }
 
-void EngineWorker::switchSelection(RealVector2D const& pos, float radius)
+std::future<void> EngineWorker::switchSelection(RealVector2D const& pos, float radius)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->switchSelection(PointSelectionData{{pos.x, pos.y}, radius});
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->switchSelection(PointSelectionData{{pos.x, pos.y}, radius}); }});
 }
 
-void EngineWorker::swapSelection(RealVector2D const& pos, float radius)
+std::future<void> EngineWorker::swapSelection(RealVector2D const& pos, float radius)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->swapSelection(PointSelectionData{{pos.x, pos.y}, radius});
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->swapSelection(PointSelectionData{{pos.x, pos.y}, radius}); }});
 }
 
 SelectionShallowData EngineWorker::getSelectionShallowData(RealVector2D const& refPos)
 {
     EngineWorkerGuard access(this);
-    return _simulationCudaFacade->getSelectionShallowData({refPos.x, refPos.y});
+    auto result = _simulationCudaFacade->getSelectionShallowData({refPos.x, refPos.y});
+    _isSelectionEmpty = result.numCells == 0 && result.numClusterCells == 0 && result.numParticles == 0;
+    return result;
 }
 
-void EngineWorker::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
+std::future<void> EngineWorker::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->setSelection(AreaSelectionData{{startPos.x, startPos.y}, {endPos.x, endPos.y}});
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->setSelection(AreaSelectionData{{startPos.x, startPos.y}, {endPos.x, endPos.y}}); }});
 }
 
-void EngineWorker::removeSelection()
+std::future<void> EngineWorker::removeSelection()
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->removeSelection();
+    return submitEditCommand({.function = [this] { _simulationCudaFacade->removeSelection(); }});
 }
 
 void EngineWorker::updateSelection()
 {
     EngineWorkerGuard access(this);
     _simulationCudaFacade->updateSelection();
+    _isSelectionEmpty = false;
+    ++_selectionVersion;
 }
 
-void EngineWorker::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
+std::future<void> EngineWorker::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->shallowUpdateSelectedObjects(updateData);
+    return submitEditCommand({.shallowUpdateData = updateData});
 }
 
-void EngineWorker::colorSelectedObjects(unsigned char color, bool includeClusters)
+std::future<void> EngineWorker::colorSelectedObjects(unsigned char color, bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->colorSelectedObjects(color, includeClusters);
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->colorSelectedObjects(color, includeClusters); }});
 }
 
-void EngineWorker::reconnectSelectedObjects()
+std::future<void> EngineWorker::reconnectSelectedObjects()
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->reconnectSelectedObjects();
+    return submitEditCommand({.function = [this] { _simulationCudaFacade->reconnectSelectedObjects(); }});
 }
 
-void EngineWorker::setDetached(bool value)
+std::future<void> EngineWorker::setDetached(bool value)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->setDetached(value);
+    return submitEditCommand({.function = [=, this] { _simulationCudaFacade->setDetached(value); }});
 }
 
 void EngineWorker::runThreadLoop()
 {
+    MetricsService::setThreadName("engine worker");
     try {
-        std::mutex mutexForLoop;
-        std::unique_lock<std::mutex> lockForLoop(mutexForLoop);
-
-        while (!_isShutdown.load()) {
-
-            if (!_syncSimulationWithRendering && _accessState == 0) {
-                if (_isSimulationRunning.load()) {
-                    _simulationCudaFacade->calcTimestep(1, false);
+        while (true) {
+            {
+                std::unique_lock lock(_mutexForThreadLoop);
+                {
+                    MEASURE_SCOPE("engine.idle");
+                    _conditionForThreadLoop.wait(lock, [this] {
+                        return _isShutdown || _accessState == 1 || (_isSimulationRunning && !_syncSimulationWithRendering) || hasPendingJobs();
+                    });
+                }
+                MetricsService::incrementCounter("engine.wakeUps");
+                if (_isShutdown) {
+                    break;
+                }
+                if (_accessState == 1) {
+                    processJobsAndGrantAccessIfRequested(lock);
+                    continue;
                 }
-                measureTPS();
-                slowdownTPS();
             }
-            
+
             processJobs();
 
-            if (_accessState == 1) {
-                _accessState = 2;
+
+            if (!_syncSimulationWithRendering && _isSimulationRunning) {
+                auto timesteps = calcTimestepBatch();
+                onTimestepsCalculated();
+                measureTPS(timesteps);
+                slowdownTPS();
             }
         }
     } catch (std::exception const& e) {
-        std::unique_lock<std::mutex> uniqueLock(_exceptionData.mutex);
-        _exceptionData.errorMessage = e.what();
+        {
+            std::unique_lock<std::mutex> uniqueLock(_exceptionData.mutex);
+            _exceptionData.errorMessage = e.what();
+        }
+        {
+            std::lock_guard lock(_mutexForThreadLoop);
+            _isThreadLoopTerminated = true;
+        }
+        _conditionForThreadLoop.notify_all();
     }
 }
 
 void EngineWorker::runSimulation()
 {
     _isSimulationRunning.store(true);
+    notifyThreadLoop();
 }
 
 void EngineWorker::pauseSimulation()
 {
     EngineWorkerGuard access(this);
     _isSimulationRunning.store(false);
+
+    //the worker thread parks until the simulation is resumed, hence the measurements are reset here
+    _tps.store(0);
+    _measureTimepoint.reset();
+    _slowDownTimepoint.reset();
+    _slowDownOvershot.reset();
 }
 
 bool EngineWorker::isSimulationRunning() const
@@ -495,11 +633,19 @@ void EngineWorker::testOnly_mutate(uint64_t cellId, MutationType mutationType)
 {
     EngineWorkerGuard access(this);
     _simulationCudaFacade->testOnly_mutate(cellId, mutationType);
+    onEntitiesChanged();
 }
 
-DataTO EngineWorker::provideTO()
+DataTOLease EngineWorker::provideTO()
 {
-    return _dataTOCache->getDataTO(_simulationCudaFacade->getArraySizes());
+    return _dataTOPool->acquire(_simulationCudaFacade->getArraySizes());
+}
+
+void EngineWorker::checkExportId(uint64_t exportId) const
+{
+    if (_exportId != exportId || !_simulationCudaFacade) {
+        throw std::runtime_error("The exported simulation data is no longer available.");
+    }
 }
 
 void EngineWorker::resetTimeIntervalStatistics()
@@ -507,23 +653,119 @@ void EngineWorker::resetTimeIntervalStatistics()
     _simulationCudaFacade->resetTimeIntervalStatistics();
 }
 
+std::future<void> EngineWorker::submitEditCommand(EditCommand&& command)
+{
+    auto result = command.promise.get_future();
+
+    //the versions are increased before the command is applied since subsequent read accesses see its result anyway
+    onEntitiesChanged();
+    _editCommands.push(std::move(command));
+    notifyThreadLoop();
+    return result;
+}
+
 void EngineWorker::processJobs()
 {
-    std::unique_lock<std::mutex> asyncJobsLock(_mutexForAsyncJobs);
-    if (_updateGpuSettingsJob) {
-        _simulationCudaFacade->setGpuConstants(*_updateGpuSettingsJob);
-        _updateGpuSettingsJob = std::nullopt;
+    auto commands = _editCommands.popAll();
+    if (commands.empty()) {
+        return;
     }
-    if (!_applyForceJobs.empty()) {
-        for (auto const& applyForceJob : _applyForceJobs) {
-            _simulationCudaFacade->applyForce(
-                {{applyForceJob.start.x, applyForceJob.start.y},
-                 {applyForceJob.end.x, applyForceJob.end.y},
-                 {applyForceJob.force.x, applyForceJob.force.y},
-                 applyForceJob.radius,
-                 false});
+    MEASURE_SCOPE("engine.jobs");
+    MetricsService::incrementCounter("engine.editCommands", toInt(commands.size()));
+
+    //the promises of superseded commands are fulfilled together with the superseding command
+    std::vector<std::promise<void>> promises;
+    for (size_t i = 0; i < commands.size(); ++i) {
+        auto& command = commands.at(i);
+        promises.emplace_back(std::move(command.promise));
+
+        if (i + 1 < commands.size()) {
+            auto& nextCommand = commands.at(i + 1);
+            if (command.coalescingKey && command.coalescingKey == nextCommand.coalescingKey) {
+                continue;
+            }
+            if (command.shallowUpdateData && nextCommand.shallowUpdateData) {
+                auto& data = *command.shallowUpdateData;
+                auto& nextData = *nextCommand.shallowUpdateData;
+                auto isTranslation = [](ShallowUpdateSelectionData const& data) { return data.angleDelta == 0 && data.angularVelDelta == 0; };
+                if (data.considerClusters == nextData.considerClusters && isTranslation(data) && isTranslation(nextData)) {
+                    nextData.posDeltaX += data.posDeltaX;
+                    nextData.posDeltaY += data.posDeltaY;
+                    nextData.velDeltaX += data.velDeltaX;
+                    nextData.velDeltaY += data.velDeltaY;
+                    continue;
+                }
+            }
+        }
+
+        //a failing command is reported to its callers only, the worker thread keeps on running
+        std::exception_ptr exception;
+        try {
+            if (command.shallowUpdateData) {
+                _simulationCudaFacade->shallowUpdateSelectedObjects(*command.shallowUpdateData);
+            } else {
+                command.function();
+            }
+        } catch (...) {
+            exception = std::current_exception();
         }
-        _applyForceJobs.clear();
+        for (auto& promise : promises) {
+            if (exception) {
+                promise.set_exception(exception);
+            } else {
+                promise.set_value();
+            }
+        }
+        promises.clear();
+    }
+}
+
+bool EngineWorker::hasPendingJobs() const
+{
+    return !_editCommands.isEmpty();
+}
+
+void EngineWorker::onEntitiesChanged()
+{
+    _isSelectionEmpty = false;
+    ++_selectionVersion;
+    ++_entitiesVersion;
+}
+
+void EngineWorker::onTimestepsCalculated()
+{
+    ++_entitiesVersion;
+    if (!_isSelectionEmpty.load()) {
+        ++_selectionVersion;
+    }
+    auto numParametersUpdates = _simulationCudaFacade->getNumSimulationParametersUpdatesAfterTimestep();
+    if (numParametersUpdates != _numParametersUpdatesAfterTimestep) {
+        _numParametersUpdatesAfterTimestep = numParametersUpdates;
+        ++_parametersVersion;
+    }
+}
+
+void EngineWorker::notifyThreadLoop()
+{
+    //locking ensures that the notification cannot get lost between the evaluation of the wait predicate and the blocking of the worker thread
+    {
+        std::lock_guard lock(_mutexForThreadLoop);
+    }
+    _conditionForThreadLoop.notify_all();
+}
+
+void EngineWorker::processJobsAndGrantAccessIfRequested(std::unique_lock<std::mutex>& lock)
+{
+    //pending commands are applied before granting access such that the other thread sees the results of its own preceding commands
+    lock.unlock();
+    processJobs();
+    lock.lock();
+
+    if (_accessState == 1) {
+        MEASURE_SCOPE("engine.accessGranted");
+        _accessState = 2;
+        _conditionForThreadLoop.notify_all();
+        _conditionForThreadLoop.wait(lock, [this] { return _accessState != 2; });
     }
 }
 
@@ -531,7 +773,8 @@ void EngineWorker::syncSimulationWithRenderingIfDesired()
 {
     if (_syncSimulationWithRendering && _isSimulationRunning) {
         for (int i = 0; i < _syncSimulationWithRenderingRatio; ++i) {
-            calcTimesteps(1);
+            _simulationCudaFacade->calcTimestep(1, true);  //access is already held by the caller
+            onTimestepsCalculated();
             measureTPS();
             slowdownTPS();
         }
@@ -540,15 +783,47 @@ void EngineWorker::syncSimulationWithRenderingIfDesired()
 
 void EngineWorker::waitAndAllowAccess(std::chrono::microseconds const& duration)
 {
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint) < duration) {
-        if (_accessState == 1) {
-            _accessState = 2;
+    MEASURE_SCOPE("engine.slowdown");
+    auto endTimepoint = std::chrono::steady_clock::now() + duration;
+    auto spinTimepoint = endTimepoint - SpinDurationForSlowdown;
+    {
+        std::unique_lock lock(_mutexForThreadLoop);
+        while (std::chrono::steady_clock::now() < spinTimepoint && !_isShutdown) {
+            if (_accessState == 1 || hasPendingJobs()) {
+                processJobsAndGrantAccessIfRequested(lock);
+                continue;
+            }
+            _conditionForThreadLoop.wait_until(lock, spinTimepoint, [this] { return _isShutdown || _accessState == 1 || hasPendingJobs(); });
         }
     }
+    while (std::chrono::steady_clock::now() < endTimepoint && !_isShutdown) {
+        std::this_thread::yield();
+    }
+}
+
+int EngineWorker::calcTimestepBatch()
+{
+    auto batchSize = TimestepBatchService::calcBatchSize(_averageTimestepDuration, _tpsRestriction.load());
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    auto result = TimestepBatchService::calcBatch(
+        batchSize, [this] { _simulationCudaFacade->calcTimestep(1, false); }, [this] { return isTimestepBatchInterrupted(); });
+
+    auto endTimepoint = std::chrono::steady_clock::now();
+    MetricsService::addDuration("engine.timestepBatch", startTimepoint, endTimepoint);
+    MetricsService::incrementCounter("engine.timesteps", result);
+
+    auto timestepDuration = std::chrono::duration<float, std::micro>(endTimepoint - startTimepoint).count() / toFloat(result);
+    _averageTimestepDuration = TimestepBatchService::calcAverageTimestepDuration(_averageTimestepDuration, timestepDuration);
+    return result;
 }
 
-void EngineWorker::measureTPS()
+bool EngineWorker::isTimestepBatchInterrupted() const
+{
+    return _accessState.load() == 1 || !_editCommands.isEmpty() || _isShutdown.load() || !_isSimulationRunning.load() || _syncSimulationWithRendering.load();
+}
+
+void EngineWorker::measureTPS(int timesteps)
 {
     if (_isSimulationRunning.load()) {
         auto timepoint = std::chrono::steady_clock::now();
@@ -564,9 +839,10 @@ void EngineWorker::measureTPS()
                     _tps.store(1000.0f / duration);
                 }
                 _timestepsSinceMeasurement = 0;
+                MetricsService::setGauge("engine.tps", _tps.load());
             }
         }
-        ++_timestepsSinceMeasurement;
+        _timestepsSinceMeasurement += timesteps;
     } else {
         _tps.store(0);
     }
@@ -603,31 +879,45 @@ EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::ch
     : _worker(worker)
 {
     _worker->_mutexForEngineWorkerGuard.lock();
-    checkForException(worker->_exceptionData);
+    try {
+        checkForException(worker->_exceptionData);
+    } catch (...) {
+        _worker->_mutexForEngineWorkerGuard.unlock();
+        throw;
+    }
 
+    std::unique_lock lock(worker->_mutexForThreadLoop);
     worker->_accessState = 1;
-
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (worker->_accessState == 1) {
-        auto timePassed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
-        if (maxDuration) {
-            if (timePassed > *maxDuration) {
-                _isTimeout = true;
-                break;
-            }
-        } else {
-            if (timePassed > std::chrono::seconds(7)) {
-                _isTimeout = true;
-                throw std::runtime_error("GPU worker thread is not reachable.");
-            }
+    worker->_conditionForThreadLoop.notify_all();
+
+    auto waitStartTimepoint = std::chrono::steady_clock::now();
+    auto isAccessGranted = worker->_conditionForThreadLoop.wait_for(lock, maxDuration.value_or(AccessTimeout), [worker] {
+        return worker->_accessState == 2 || worker->_isThreadLoopTerminated;
+    });
+    MetricsService::addDuration("engine.guardWait", waitStartTimepoint, std::chrono::steady_clock::now());
+
+    auto isThreadLoopTerminated = worker->_isThreadLoopTerminated;
+    if (!isAccessGranted || isThreadLoopTerminated) {
+        _isTimeout = true;
+        MetricsService::incrementCounter("engine.guardTimeouts");
+
+        //the destructor is not called if the constructor throws
+        if (!maxDuration || isThreadLoopTerminated) {
+            worker->_accessState = 0;
+            lock.unlock();
+            _worker->_mutexForEngineWorkerGuard.unlock();
+            throw std::runtime_error(isThreadLoopTerminated ? "GPU worker thread is in an invalid state." : "GPU worker thread is not reachable.");
         }
     }
-
 }
 
 EngineWorkerGuard::~EngineWorkerGuard()
 {
-    _worker->_accessState = 0;
+    {
+        std::lock_guard lock(_worker->_mutexForThreadLoop);
+        _worker->_accessState = 0;
+    }
+    _worker->_conditionForThreadLoop.notify_all();
     _worker->_mutexForEngineWorkerGuard.unlock();
 }
 
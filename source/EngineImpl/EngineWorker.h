@@ -3,12 +3,15 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
+#include <future>
 
 #if defined(_WIN32)
 #include <windows.h>
 #endif
 #include <GL/gl.h>
 
+#include "Base/ConcurrentQueue.h"
 #include "Base/Definitions.h"
 
 #include "EngineInterface/Definitions.h"
@@ -19,8 +22,10 @@
 #include "EngineInterface/Settings.h"
 #include "EngineInterface/SelectionShallowData.h"
 #include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/SimulationVersions.h"
 #include "EngineInterface/MutationType.h"
 #include "EngineInterface/StatisticsHistory.h"
+#include "EngineInterface/TransferBufferStatistics.h"
 
 #include "EngineGpuKernels/Definitions.h"
 
@@ -32,7 +37,7 @@ struct ExceptionData
     std::optional<std::string> errorMessage;
 };
 
-struct DataTO;
+class DataTOLease;
 
 class EngineWorker
 {
@@ -54,25 +59,35 @@ public:
     void setSyncSimulationWithRenderingRatio(int value);
 
     ClusteredDataDescription getClusteredSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    ClusteredDataReader getClusteredSimulationDataReader(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);  //must not outlive the worker
     DataDescription getSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
     ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters);
     DataDescription getSelectedSimulationData(bool includeClusters);
     DataDescription getInspectedSimulationData(std::vector<uint64_t> objectsIds);
     RawStatisticsData getRawStatistics() const;
     StatisticsHistory const& getStatisticsHistory() const;
-    void setStatisticsHistory(StatisticsHistoryData const& data);
+    void setStatisticsHistory(StatisticsHistorySnapshot const& data);
+    TransferBufferStatistics getTransferBufferStatistics() const;
+
+    //chunk-wise transfer of the data exported for a clustered data reader, the buffers are only as large as the chunks
+    DataTOLease getExportedCells(uint64_t exportId, uint64_t startIndex, uint64_t endIndex);
+    DataTOLease getExportedCells(uint64_t exportId, std::vector<uint64_t> const& cellIndices, uint64_t auxiliaryDataSize);
+    DataTOLease getExportedParticles(uint64_t exportId, uint64_t startIndex, uint64_t endIndex);
+    void releaseExportedData(uint64_t exportId);
 
     void addAndSelectSimulationData(DataDescription const& dataToUpdate);
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate);
     void setSimulationData(DataDescription const& dataToUpdate);
-    void removeSelectedObjects(bool includeClusters);
-    void relaxSelectedObjects(bool includeClusters);
-    void uniformVelocitiesForSelectedObjects(bool includeClusters);
-    void makeSticky(bool includeClusters);
-    void removeStickiness(bool includeClusters);
-    void setBarrier(bool value, bool includeClusters);
-    void changeCell(CellDescription const& changedCell);
-    void changeParticle(ParticleDescription const& changedParticle);
+    void setSimulationDataFromSnapshotFile(std::string const& filename);
+    void saveSimulationDataToSnapshotFile(std::string const& filename, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    std::future<void> removeSelectedObjects(bool includeClusters);
+    std::future<void> relaxSelectedObjects(bool includeClusters);
+    std::future<void> uniformVelocitiesForSelectedObjects(bool includeClusters);
+    std::future<void> makeSticky(bool includeClusters);
+    std::future<void> removeStickiness(bool includeClusters);
+    std::future<void> setBarrier(bool value, bool includeClusters);
+    std::future<void> changeCell(CellDescription const& changedCell);
+    std::future<void> changeParticle(ParticleDescription const& changedParticle);
 
     void calcTimesteps(uint64_t timesteps);
     void applyCataclysm(int power);
@@ -84,6 +99,7 @@ public:
     void setTpsRestriction(int value);
 
     float getTps() const;
+    SimulationVersions getVersions() const;
     uint64_t getCurrentTimestep() const;
     void setCurrentTimestep(uint64_t value);
 
@@ -93,16 +109,16 @@ public:
 
     void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius);
 
-    void switchSelection(RealVector2D const& pos, float radius);
-    void swapSelection(RealVector2D const& pos, float radius);
+    std::future<void> switchSelection(RealVector2D const& pos, float radius);
+    std::future<void> swapSelection(RealVector2D const& pos, float radius);
     SelectionShallowData getSelectionShallowData(RealVector2D const& refPos);
-    void setSelection(RealVector2D const& startPos, RealVector2D const& endPos);
-    void removeSelection();
+    std::future<void> setSelection(RealVector2D const& startPos, RealVector2D const& endPos);
+    std::future<void> removeSelection();
     void updateSelection();
-    void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData);
-    void colorSelectedObjects(unsigned char color, bool includeClusters);
-    void reconnectSelectedObjects();
-    void setDetached(bool value);
+    std::future<void> shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData);
+    std::future<void> colorSelectedObjects(unsigned char color, bool includeClusters);
+    std::future<void> reconnectSelectedObjects();
+    std::future<void> setDetached(bool value);
 
     void runThreadLoop();
     void runSimulation();
@@ -113,13 +129,24 @@ public:
     void testOnly_mutate(uint64_t cellId, MutationType mutationType);
 
 private:
-    DataTO provideTO(); 
+    DataTOLease provideTO();
+    void checkExportId(uint64_t exportId) const;
     void resetTimeIntervalStatistics();
+    struct EditCommand;
+    std::future<void> submitEditCommand(EditCommand&& command);
     void processJobs();
+    bool hasPendingJobs() const;
+
+    void onEntitiesChanged();  //conservatively regards the selection as changed too
+    void onTimestepsCalculated();
 
+    void notifyThreadLoop();
+    void processJobsAndGrantAccessIfRequested(std::unique_lock<std::mutex>& lock);  //lock refers to _mutexForThreadLoop
     void syncSimulationWithRenderingIfDesired();
     void waitAndAllowAccess(std::chrono::microseconds const& duration);
-    void measureTPS();
+    int calcTimestepBatch();  //returns the number of calculated time steps
+    bool isTimestepBatchInterrupted() const;
+    void measureTPS(int timesteps = 1);
     void slowdownTPS();
 
     void registerImageResource();
@@ -132,24 +159,35 @@ private:
     //sync
     std::atomic<bool> _syncSimulationWithRendering{false};
     std::atomic<int> _syncSimulationWithRenderingRatio{2};
-    std::atomic<int> _accessState{0};  //0 = worker thread has access, 1 = require access from other thread, 2 = access granted to other thread
     std::atomic<bool> _isSimulationRunning{false};
     std::atomic<bool> _isShutdown{false};
     ExceptionData _exceptionData;
 
-    //async jobs
+    //the worker thread parks on _conditionForThreadLoop if there is nothing to do (e.g. simulation paused)
+    //and is woken up by access requests, async jobs, running the simulation and shutdown
+    std::mutex _mutexForThreadLoop;
+    std::condition_variable _conditionForThreadLoop;
+    std::atomic<int> _accessState{0};  //changed under _mutexForThreadLoop, 0 = worker thread has access, 1 = require access from other thread, 2 = access granted to other thread
+    bool _isThreadLoopTerminated = false;  //guarded by _mutexForThreadLoop
+
     std::mutex _mutexForEngineWorkerGuard;
-    mutable std::mutex _mutexForAsyncJobs;
-    std::optional<GpuSettings> _updateGpuSettingsJob;
 
-    struct ApplyForceJob
+    //async jobs: editing operations are queued from arbitrary threads and applied in batches by the worker thread
+    //before the next time step or before another thread gets access
+    enum class CoalescingType
+    {
+        ChangeCell,
+        ChangeParticle,
+        GpuSettings,
+    };
+    struct EditCommand
     {
-        RealVector2D start;
-        RealVector2D end;
-        RealVector2D force;
-        float radius;
+        std::function<void()> function;
+        std::optional<std::pair<CoalescingType, uint64_t>> coalescingKey;  //consecutive commands with the same key are superseded by the last one
+        std::optional<ShallowUpdateSelectionData> shallowUpdateData;     //consecutive translations are merged into one update
+        std::promise<void> promise;
     };
-    std::vector<ApplyForceJob> _applyForceJobs;
+    ConcurrentQueue<EditCommand> _editCommands;
 
     //time step measurements
     std::atomic<int> _tpsRestriction{0};  //0 = no restriction
@@ -158,11 +196,21 @@ private:
     std::optional<std::chrono::steady_clock::time_point> _measureTimepoint;
     std::optional<std::chrono::steady_clock::time_point> _slowDownTimepoint;
     std::optional<std::chrono::microseconds> _slowDownOvershot;
+    float _averageTimestepDuration = 0;  //in microseconds, used to adapt the number of time steps per batch
+
+    //change versions
+    std::atomic<uint64_t> _parametersVersion{0};
+    std::atomic<uint64_t> _selectionVersion{0};
+    std::atomic<uint64_t> _entitiesVersion{0};
+    std::atomic<bool> _isSelectionEmpty{false};  //result of the last selection read back, time steps do not change an empty selection
+    uint64_t _numParametersUpdatesAfterTimestep = 0;  //last known value from _simulationCudaFacade
   
     //internals
     std::optional<GLuint> _imageResource;
     void* _cudaResource = nullptr;
-    AccessDataTOCache _dataTOCache;
+    DataTOPool _dataTOPool;
+    std::optional<uint64_t> _exportId;  //data exported on the GPU for the current clustered data reader, only one export exists at a time
+    uint64_t _numExports = 0;
 };
 
 class EngineWorkerGuard
@@ -94,6 +94,12 @@ ClusteredDataDescription _SimulationFacadeImpl::getClusteredSimulationData()
     return _worker.getClusteredSimulationData({-10, -10}, {size.x + 10, size.y + 10});
 }
 
+ClusteredDataReader _SimulationFacadeImpl::getClusteredSimulationDataReader()
+{
+    auto size = getWorldSize();
+    return _worker.getClusteredSimulationDataReader({-10, -10}, {size.x + 10, size.y + 10});
+}
+
 DataDescription _SimulationFacadeImpl::getSimulationData()
 {
     auto size = getWorldSize();
@@ -134,60 +140,73 @@ void _SimulationFacadeImpl::setSimulationData(DataDescription const& dataToUpdat
     _selectionNeedsUpdate = true;
 }
 
-void _SimulationFacadeImpl::removeSelectedObjects(bool includeClusters)
+void _SimulationFacadeImpl::setSimulationDataFromSnapshotFile(std::string const& filename)
 {
-    _worker.removeSelectedObjects(includeClusters);
+    _worker.setSimulationDataFromSnapshotFile(filename);
     _selectionNeedsUpdate = true;
 }
 
-void _SimulationFacadeImpl::relaxSelectedObjects(bool includeClusters)
+void _SimulationFacadeImpl::saveSimulationDataToSnapshotFile(std::string const& filename)
+{
+    auto size = getWorldSize();
+    _worker.saveSimulationDataToSnapshotFile(filename, {-10, -10}, {size.x + 10, size.y + 10});
+}
+
+std::future<void> _SimulationFacadeImpl::removeSelectedObjects(bool includeClusters)
 {
-    _worker.relaxSelectedObjects(includeClusters);
+    auto result = _worker.removeSelectedObjects(includeClusters);
+    _selectionNeedsUpdate = true;
+    return result;
 }
 
-void _SimulationFacadeImpl::uniformVelocitiesForSelectedObjects(bool includeClusters)
+std::future<void> _SimulationFacadeImpl::relaxSelectedObjects(bool includeClusters)
 {
-    _worker.uniformVelocitiesForSelectedObjects(includeClusters);
+    return _worker.relaxSelectedObjects(includeClusters);
 }
 
-void _SimulationFacadeImpl::makeSticky(bool includeClusters)
+std::future<void> _SimulationFacadeImpl::uniformVelocitiesForSelectedObjects(bool includeClusters)
 {
-    _worker.makeSticky(includeClusters);
+    return _worker.uniformVelocitiesForSelectedObjects(includeClusters);
 }
 
-void _SimulationFacadeImpl::removeStickiness(bool includeClusters)
+std::future<void> _SimulationFacadeImpl::makeSticky(bool includeClusters)
 {
-    _worker.removeStickiness(includeClusters);
+    return _worker.makeSticky(includeClusters);
 }
 
-void _SimulationFacadeImpl::setBarrier(bool value, bool includeClusters)
+std::future<void> _SimulationFacadeImpl::removeStickiness(bool includeClusters)
 {
-    _worker.setBarrier(value, includeClusters);
+    return _worker.removeStickiness(includeClusters);
 }
 
-void _SimulationFacadeImpl::colorSelectedObjects(unsigned char color, bool includeClusters)
+std::future<void> _SimulationFacadeImpl::setBarrier(bool value, bool includeClusters)
 {
-    _worker.colorSelectedObjects(color, includeClusters);
+    return _worker.setBarrier(value, includeClusters);
 }
 
-void _SimulationFacadeImpl::reconnectSelectedObjects()
+std::future<void> _SimulationFacadeImpl::colorSelectedObjects(unsigned char color, bool includeClusters)
 {
-    _worker.reconnectSelectedObjects();
+    return _worker.colorSelectedObjects(color, includeClusters);
 }
 
-void _SimulationFacadeImpl::setDetached(bool value)
+std::future<void> _SimulationFacadeImpl::reconnectSelectedObjects()
 {
-    _worker.setDetached(value);
+    return _worker.reconnectSelectedObjects();
 }
 
-void _SimulationFacadeImpl::changeCell(CellDescription const& changedCell)
+std::future<void> _SimulationFacadeImpl::setDetached(bool value)
 {
-    _worker.changeCell(changedCell);
+    return _worker.setDetached(value);
 }
 
-void _SimulationFacadeImpl::changeParticle(ParticleDescription const& changedParticle)
+std::future<void> _SimulationFacadeImpl::changeCell(CellDescription const& changedCell)
 {
-    _worker.changeParticle(changedParticle);
+    return _worker.changeCell(changedCell);
+}
+
+std::future<void> _SimulationFacadeImpl::changeParticle(ParticleDescription const& changedParticle)
+{
+    return _worker.changeParticle(changedParticle);
 }
 
 void _SimulationFacadeImpl::calcTimesteps(uint64_t timesteps)
@@ -302,14 +321,14 @@ void _SimulationFacadeImpl::applyForce_async(
     _worker.applyForce_async(start, end, force, radius);
 }
 
-void _SimulationFacadeImpl::switchSelection(RealVector2D const& pos, float radius)
+std::future<void> _SimulationFacadeImpl::switchSelection(RealVector2D const& pos, float radius)
 {
-    _worker.switchSelection(pos, radius);
+    return _worker.switchSelection(pos, radius);
 }
 
-void _SimulationFacadeImpl::swapSelection(RealVector2D const& pos, float radius)
+std::future<void> _SimulationFacadeImpl::swapSelection(RealVector2D const& pos, float radius)
 {
-    _worker.swapSelection(pos, radius);
+    return _worker.swapSelection(pos, radius);
 }
 
 SelectionShallowData _SimulationFacadeImpl::getSelectionShallowData(RealVector2D const& refPos)
@@ -317,19 +336,19 @@ SelectionShallowData _SimulationFacadeImpl::getSelectionShallowData(RealVector2D
     return _worker.getSelectionShallowData(refPos);
 }
 
-void _SimulationFacadeImpl::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
+std::future<void> _SimulationFacadeImpl::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
 {
-    _worker.shallowUpdateSelectedObjects(updateData);
+    return _worker.shallowUpdateSelectedObjects(updateData);
 }
 
-void _SimulationFacadeImpl::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
+std::future<void> _SimulationFacadeImpl::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
 {
-    _worker.setSelection(startPos, endPos);
+    return _worker.setSelection(startPos, endPos);
 }
 
-void _SimulationFacadeImpl::removeSelection()
+std::future<void> _SimulationFacadeImpl::removeSelection()
 {
-    _worker.removeSelection();
+    return _worker.removeSelection();
 }
 
 bool _SimulationFacadeImpl::updateSelectionIfNecessary()
@@ -362,11 +381,16 @@ StatisticsHistory const& _SimulationFacadeImpl::getStatisticsHistory() const
     return _worker.getStatisticsHistory();
 }
 
-void _SimulationFacadeImpl::setStatisticsHistory(StatisticsHistoryData const& data)
+void _SimulationFacadeImpl::setStatisticsHistory(StatisticsHistorySnapshot const& data)
 {
     _worker.setStatisticsHistory(data);
 }
 
+TransferBufferStatistics _SimulationFacadeImpl::getTransferBufferStatistics() const
+{
+    return _worker.getTransferBufferStatistics();
+}
+
 std::optional<int> _SimulationFacadeImpl::getTpsRestriction() const
 {
     auto result = _worker.getTpsRestriction();
@@ -383,6 +407,11 @@ float _SimulationFacadeImpl::getTps() const
     return _worker.getTps();
 }
 
+SimulationVersions _SimulationFacadeImpl::getVersions() const
+{
+    return _worker.getVersions();
+}
+
 void _SimulationFacadeImpl::testOnly_mutate(uint64_t cellId, MutationType mutationType)
 {
     _worker.testOnly_mutate(cellId, mutationType);
@@ -52,6 +52,7 @@ public:
     void setSyncSimulationWithRenderingRatio(int value) override;
 
     ClusteredDataDescription getClusteredSimulationData() override;
+    ClusteredDataReader getClusteredSimulationDataReader() override;
     DataDescription getSimulationData() override;
     ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters) override;
     DataDescription getSelectedSimulationData(bool includeClusters) override;
@@ -60,17 +61,19 @@ public:
     void addAndSelectSimulationData(DataDescription const& dataToAdd) override;
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) override;
     void setSimulationData(DataDescription const& dataToUpdate) override;
-    void removeSelectedObjects(bool includeClusters) override;
-    void relaxSelectedObjects(bool includeClusters) override;
-    void uniformVelocitiesForSelectedObjects(bool includeClusters) override;
-    void makeSticky(bool includeClusters) override;
-    void removeStickiness(bool includeClusters) override;
-    void setBarrier(bool value, bool includeClusters) override;
-    void colorSelectedObjects(unsigned char color, bool includeClusters) override;
-    void reconnectSelectedObjects() override;
-    void setDetached(bool value) override;
-    void changeCell(CellDescription const& changedCell) override;
-    void changeParticle(ParticleDescription const& changedParticle) override;
+    void setSimulationDataFromSnapshotFile(std::string const& filename) override;
+    void saveSimulationDataToSnapshotFile(std::string const& filename) override;
+    std::future<void> removeSelectedObjects(bool includeClusters) override;
+    std::future<void> relaxSelectedObjects(bool includeClusters) override;
+    std::future<void> uniformVelocitiesForSelectedObjects(bool includeClusters) override;
+    std::future<void> makeSticky(bool includeClusters) override;
+    std::future<void> removeStickiness(bool includeClusters) override;
+    std::future<void> setBarrier(bool value, bool includeClusters) override;
+    std::future<void> colorSelectedObjects(unsigned char color, bool includeClusters) override;
+    std::future<void> reconnectSelectedObjects() override;
+    std::future<void> setDetached(bool value) override;
+    std::future<void> changeCell(CellDescription const& changedCell) override;
+    std::future<void> changeParticle(ParticleDescription const& changedParticle) override;
 
     void calcTimesteps(uint64_t timesteps) override;
     void runSimulation() override;
@@ -98,25 +101,28 @@ public:
 
     void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius) override;
 
-    void switchSelection(RealVector2D const& pos, float radius) override;
-    void swapSelection(RealVector2D const& pos, float radius) override;
+    std::future<void> switchSelection(RealVector2D const& pos, float radius) override;
+    std::future<void> swapSelection(RealVector2D const& pos, float radius) override;
     SelectionShallowData getSelectionShallowData(RealVector2D const& refPos = RealVector2D()) override;
-    void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData) override;
-    void setSelection(RealVector2D const& startPos, RealVector2D const& endPos) override;
-    void removeSelection() override;
+    std::future<void> shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData) override;
+    std::future<void> setSelection(RealVector2D const& startPos, RealVector2D const& endPos) override;
+    std::future<void> removeSelection() override;
     bool updateSelectionIfNecessary() override;
 
     GeneralSettings getGeneralSettings() const override;
     IntVector2D getWorldSize() const override;
     RawStatisticsData getRawStatistics() const override;
     StatisticsHistory const& getStatisticsHistory() const override;
-    void setStatisticsHistory(StatisticsHistoryData const& data) override;
+    void setStatisticsHistory(StatisticsHistorySnapshot const& data) override;
+    TransferBufferStatistics getTransferBufferStatistics() const override;
 
     std::optional<int> getTpsRestriction() const override;
     void setTpsRestriction(std::optional<int> const& value) override;
 
     float getTps() const override;
 
+    SimulationVersions getVersions() const override;
+
     //for tests
     void testOnly_mutate(uint64_t cellId, MutationType mutationType) override;
 
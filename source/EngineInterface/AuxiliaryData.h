@@ -8,7 +8,7 @@
 struct AuxiliaryData
 {
     uint64_t timestep = 0;
-    std::chrono::milliseconds realTime;
+    std::chrono::milliseconds realTime{0};
     float zoom = 0;
     RealVector2D center;
     GeneralSettings generalSettings;
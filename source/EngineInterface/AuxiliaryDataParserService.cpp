@@ -5,1065 +5,732 @@
 #include "Settings.h"
 
 #include "PropertyParser.h"
+#include "SettingsJson.h"
 #include "Base/Resources.h"
 
 namespace
 {
+    //the field list is applied to a codec (PropertyTreeCodec, SettingsJsonWriter or SettingsJsonReader)
+    //such that each field is encoded and decoded by the same code path
+    template <typename Codec>
     void encodeDecodeLatestSimulationParameters(
-        boost::property_tree::ptree& tree,
+        Codec& codec,
         SimulationParameters& parameters,
         MissingParameters& missingParameters,
-        MissingFeatures& missingFeatures,
-        ParserTask parserTask)
+        MissingFeatures& missingFeatures)
     {
         SimulationParameters defaultParameters;
 
-        PropertyParser::encodeDecode(tree, parameters.backgroundColor, defaultParameters.backgroundColor, "simulation parameters.background color", parserTask);
-        PropertyParser::encodeDecode(tree, parameters.cellColoring, defaultParameters.cellColoring, "simulation parameters.cell colorization", parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.cellGlowColoring, defaultParameters.cellGlowColoring, "simulation parameters.cell glow.coloring", parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellGlowRadius,
-            defaultParameters.cellGlowRadius,
-            "simulation parameters.cell glow.radius",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellGlowStrength,
-            defaultParameters.cellGlowStrength,
-            "simulation parameters.cell glow.strength",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.highlightedCellFunction,
-            defaultParameters.highlightedCellFunction,
-            "simulation parameters.highlighted cell function",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.zoomLevelNeuronalActivity,
-            defaultParameters.zoomLevelNeuronalActivity,
-            "simulation parameters.zoom level.neural activity",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.borderlessRendering, defaultParameters.borderlessRendering, "simulation parameters.borderless rendering", parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.markReferenceDomain, defaultParameters.markReferenceDomain, "simulation parameters.mark reference domain", parserTask);
-        PropertyParser::encodeDecode(tree, parameters.gridLines, defaultParameters.gridLines, "simulation parameters.grid lines", parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.attackVisualization, defaultParameters.attackVisualization, "simulation parameters.attack visualization", parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.muscleMovementVisualization,
-            defaultParameters.muscleMovementVisualization,
-            "simulation parameters.muscle movement visualization",
-            parserTask);
-        PropertyParser::encodeDecode(tree, parameters.cellRadius, defaultParameters.cellRadius, "simulation parameters.cek", parserTask);
-
-        PropertyParser::encodeDecode(tree, parameters.timestepSize, defaultParameters.timestepSize, "simulation parameters.time step size", parserTask);
-
-        PropertyParser::encodeDecode(tree, parameters.motionType, defaultParameters.motionType, "simulation parameters.motion.type", parserTask);
+        codec.encodeDecode(parameters.backgroundColor, defaultParameters.backgroundColor, "simulation parameters.background color");
+        codec.encodeDecode(parameters.cellColoring, defaultParameters.cellColoring, "simulation parameters.cell colorization");
+        codec.encodeDecode(parameters.cellGlowColoring, defaultParameters.cellGlowColoring, "simulation parameters.cell glow.coloring");
+        codec.encodeDecode(parameters.cellGlowRadius, defaultParameters.cellGlowRadius, "simulation parameters.cell glow.radius");
+        codec.encodeDecode(parameters.cellGlowStrength, defaultParameters.cellGlowStrength, "simulation parameters.cell glow.strength");
+        codec.encodeDecode(parameters.highlightedCellFunction, defaultParameters.highlightedCellFunction, "simulation parameters.highlighted cell function");
+        codec.encodeDecode(
+            parameters.zoomLevelNeuronalActivity, defaultParameters.zoomLevelNeuronalActivity, "simulation parameters.zoom level.neural activity");
+        codec.encodeDecode(parameters.borderlessRendering, defaultParameters.borderlessRendering, "simulation parameters.borderless rendering");
+        codec.encodeDecode(parameters.markReferenceDomain, defaultParameters.markReferenceDomain, "simulation parameters.mark reference domain");
+        codec.encodeDecode(parameters.gridLines, defaultParameters.gridLines, "simulation parameters.grid lines");
+        codec.encodeDecode(parameters.attackVisualization, defaultParameters.attackVisualization, "simulation parameters.attack visualization");
+        codec.encodeDecode(
+            parameters.muscleMovementVisualization, defaultParameters.muscleMovementVisualization, "simulation parameters.muscle movement visualization");
+        codec.encodeDecode(parameters.cellRadius, defaultParameters.cellRadius, "simulation parameters.cek");
+
+        codec.encodeDecode(parameters.timestepSize, defaultParameters.timestepSize, "simulation parameters.time step size");
+
+        codec.encodeDecode(parameters.motionType, defaultParameters.motionType, "simulation parameters.motion.type");
         if (parameters.motionType == MotionType_Fluid) {
-            PropertyParser::encodeDecode(
-                tree,
+            codec.encodeDecode(
                 parameters.motionData.fluidMotion.smoothingLength,
                 defaultParameters.motionData.fluidMotion.smoothingLength,
-                "simulation parameters.fluid.smoothing length",
-                parserTask);
-            PropertyParser::encodeDecode(
-                tree,
+                "simulation parameters.fluid.smoothing length");
+            codec.encodeDecode(
                 parameters.motionData.fluidMotion.pressureStrength,
                 defaultParameters.motionData.fluidMotion.pressureStrength,
-                "simulation parameters.fluid.pressure strength",
-                parserTask);
-            PropertyParser::encodeDecode(
-                tree,
+                "simulation parameters.fluid.pressure strength");
+            codec.encodeDecode(
                 parameters.motionData.fluidMotion.viscosityStrength,
                 defaultParameters.motionData.fluidMotion.viscosityStrength,
-                "simulation parameters.fluid.viscosity strength",
-                parserTask);
+                "simulation parameters.fluid.viscosity strength");
         } else {
-            PropertyParser::encodeDecode(
-                tree,
+            codec.encodeDecode(
                 parameters.motionData.collisionMotion.cellMaxCollisionDistance,
                 defaultParameters.motionData.collisionMotion.cellMaxCollisionDistance,
-                "simulation parameters.motion.collision.max distance",
-                parserTask);
-            PropertyParser::encodeDecode(
-                tree,
+                "simulation parameters.motion.collision.max distance");
+            codec.encodeDecode(
                 parameters.motionData.collisionMotion.cellRepulsionStrength,
                 defaultParameters.motionData.collisionMotion.cellRepulsionStrength,
-                "simulation parameters.motion.collision.repulsion strength",
-                parserTask);
+                "simulation parameters.motion.collision.repulsion strength");
         }
 
-        PropertyParser::encodeDecode(tree, parameters.baseValues.friction, defaultParameters.baseValues.friction, "simulation parameters.friction", parserTask);
-        PropertyParser::encodeDecode(tree, parameters.baseValues.rigidity, defaultParameters.baseValues.rigidity, "simulation parameters.rigidity", parserTask);
-        PropertyParser::encodeDecode(tree, parameters.cellMaxVelocity, defaultParameters.cellMaxVelocity, "simulation parameters.cell.max velocity", parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.cellMaxBindingDistance, defaultParameters.cellMaxBindingDistance, "simulation parameters.cell.max binding distance", parserTask);
-        PropertyParser::encodeDecode(tree, parameters.cellNormalEnergy, defaultParameters.cellNormalEnergy, "simulation parameters.cell.normal energy", parserTask);
-
-        PropertyParser::encodeDecode(tree, parameters.cellMinDistance, defaultParameters.cellMinDistance, "simulation parameters.cell.min distance", parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.baseValues.cellMaxForce, defaultParameters.baseValues.cellMaxForce, "simulation parameters.cell.max force", parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellMaxForceDecayProb,
-            defaultParameters.cellMaxForceDecayProb,
-            "simulation parameters.cell.max force decay probability",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellNumExecutionOrderNumbers,
-            defaultParameters.cellNumExecutionOrderNumbers,
-            "simulation parameters.cell.max execution order number",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.baseValues.cellMinEnergy, defaultParameters.baseValues.cellMinEnergy, "simulation parameters.cell.min energy", parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.baseValues.cellFusionVelocity,
-            defaultParameters.baseValues.cellFusionVelocity,
-            "simulation parameters.cell.fusion velocity",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.baseValues.cellMaxBindingEnergy,
-            parameters.baseValues.cellMaxBindingEnergy,
-            "simulation parameters.cell.max binding energy",
-            parserTask);
-        PropertyParser::encodeDecode(tree, parameters.cellMaxAge, defaultParameters.cellMaxAge, "simulation parameters.cell.max age", parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.cellMaxAgeBalancer, defaultParameters.cellMaxAgeBalancer, "simulation parameters.cell.max age.balance.enabled", parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellMaxAgeBalancerInterval,
-            defaultParameters.cellMaxAgeBalancerInterval,
-            "simulation parameters.cell.max age.balance.interval",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellInactiveMaxAgeActivated,
-            defaultParameters.cellInactiveMaxAgeActivated,
-            "simulation parameters.cell.inactive max age activated",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.baseValues.cellInactiveMaxAge,
-            defaultParameters.baseValues.cellInactiveMaxAge,
-            "simulation parameters.cell.inactive max age",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellEmergentMaxAgeActivated,
-            defaultParameters.cellEmergentMaxAgeActivated,
-            "simulation parameters.cell.nutrient max age activated",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.cellEmergentMaxAge, defaultParameters.cellEmergentMaxAge, "simulation parameters.cell.nutrient max age", parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellResetAgeAfterActivation,
-            defaultParameters.cellResetAgeAfterActivation,
-            "simulation parameters.cell.reset age after activation",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(parameters.baseValues.friction, defaultParameters.baseValues.friction, "simulation parameters.friction");
+        codec.encodeDecode(parameters.baseValues.rigidity, defaultParameters.baseValues.rigidity, "simulation parameters.rigidity");
+        codec.encodeDecode(parameters.cellMaxVelocity, defaultParameters.cellMaxVelocity, "simulation parameters.cell.max velocity");
+        codec.encodeDecode(parameters.cellMaxBindingDistance, defaultParameters.cellMaxBindingDistance, "simulation parameters.cell.max binding distance");
+        codec.encodeDecode(parameters.cellNormalEnergy, defaultParameters.cellNormalEnergy, "simulation parameters.cell.normal energy");
+
+        codec.encodeDecode(parameters.cellMinDistance, defaultParameters.cellMinDistance, "simulation parameters.cell.min distance");
+        codec.encodeDecode(parameters.baseValues.cellMaxForce, defaultParameters.baseValues.cellMaxForce, "simulation parameters.cell.max force");
+        codec.encodeDecode(parameters.cellMaxForceDecayProb, defaultParameters.cellMaxForceDecayProb, "simulation parameters.cell.max force decay probability");
+        codec.encodeDecode(
+            parameters.cellNumExecutionOrderNumbers, defaultParameters.cellNumExecutionOrderNumbers, "simulation parameters.cell.max execution order number");
+        codec.encodeDecode(parameters.baseValues.cellMinEnergy, defaultParameters.baseValues.cellMinEnergy, "simulation parameters.cell.min energy");
+        codec.encodeDecode(
+            parameters.baseValues.cellFusionVelocity, defaultParameters.baseValues.cellFusionVelocity, "simulation parameters.cell.fusion velocity");
+        codec.encodeDecode(
+            parameters.baseValues.cellMaxBindingEnergy, parameters.baseValues.cellMaxBindingEnergy, "simulation parameters.cell.max binding energy");
+        codec.encodeDecode(parameters.cellMaxAge, defaultParameters.cellMaxAge, "simulation parameters.cell.max age");
+        codec.encodeDecode(parameters.cellMaxAgeBalancer, defaultParameters.cellMaxAgeBalancer, "simulation parameters.cell.max age.balance.enabled");
+        codec.encodeDecode(
+            parameters.cellMaxAgeBalancerInterval, defaultParameters.cellMaxAgeBalancerInterval, "simulation parameters.cell.max age.balance.interval");
+        codec.encodeDecode(
+            parameters.cellInactiveMaxAgeActivated, defaultParameters.cellInactiveMaxAgeActivated, "simulation parameters.cell.inactive max age activated");
+        codec.encodeDecode(
+            parameters.baseValues.cellInactiveMaxAge, defaultParameters.baseValues.cellInactiveMaxAge, "simulation parameters.cell.inactive max age");
+        codec.encodeDecode(
+            parameters.cellEmergentMaxAgeActivated, defaultParameters.cellEmergentMaxAgeActivated, "simulation parameters.cell.nutrient max age activated");
+        codec.encodeDecode(parameters.cellEmergentMaxAge, defaultParameters.cellEmergentMaxAge, "simulation parameters.cell.nutrient max age");
+        codec.encodeDecode(
+            parameters.cellResetAgeAfterActivation, defaultParameters.cellResetAgeAfterActivation, "simulation parameters.cell.reset age after activation");
+        codec.encodeDecode(
             parameters.baseValues.cellColorTransitionDuration,
             defaultParameters.baseValues.cellColorTransitionDuration,
-            "simulation parameters.cell.color transition rules.duration",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.color transition rules.duration");
+        codec.encodeDecode(
             parameters.baseValues.cellColorTransitionTargetColor,
             defaultParameters.baseValues.cellColorTransitionTargetColor,
-            "simulation parameters.cell.color transition rules.target color",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.color transition rules.target color");
+        codec.encodeDecode(
             parameters.genomeComplexityRamificationFactor,
             defaultParameters.genomeComplexityRamificationFactor,
-            "simulation parameters.genome complexity.genome complexity ramification factor",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.genome complexity.genome complexity ramification factor");
+        codec.encodeDecode(
             parameters.genomeComplexitySizeFactor,
             defaultParameters.genomeComplexitySizeFactor,
-            "simulation parameters.genome complexity.genome complexity size factor",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.genome complexity.genome complexity size factor");
+        codec.encodeDecode(
             parameters.genomeComplexityNeuronFactor,
             defaultParameters.genomeComplexityNeuronFactor,
-            "simulation parameters.genome complexity.genome complexity neuron factor",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.baseValues.radiationCellAgeStrength,
-            defaultParameters.baseValues.radiationCellAgeStrength,
-            "simulation parameters.radiation.factor",
-            parserTask);
-        PropertyParser::encodeDecode(tree, parameters.radiationProb, defaultParameters.radiationProb, "simulation parameters.radiation.probability", parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.radiationVelocityMultiplier,
-            defaultParameters.radiationVelocityMultiplier,
-            "simulation parameters.radiation.velocity multiplier",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.radiationVelocityPerturbation,
-            defaultParameters.radiationVelocityPerturbation,
-            "simulation parameters.radiation.velocity perturbation",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.genome complexity.genome complexity neuron factor");
+        codec.encodeDecode(
+            parameters.baseValues.radiationCellAgeStrength, defaultParameters.baseValues.radiationCellAgeStrength, "simulation parameters.radiation.factor");
+        codec.encodeDecode(parameters.radiationProb, defaultParameters.radiationProb, "simulation parameters.radiation.probability");
+        codec.encodeDecode(
+            parameters.radiationVelocityMultiplier, defaultParameters.radiationVelocityMultiplier, "simulation parameters.radiation.velocity multiplier");
+        codec.encodeDecode(
+            parameters.radiationVelocityPerturbation, defaultParameters.radiationVelocityPerturbation, "simulation parameters.radiation.velocity perturbation");
+        codec.encodeDecode(
             parameters.baseValues.radiationDisableSources,
             defaultParameters.baseValues.radiationDisableSources,
-            "simulation parameters.radiation.disable sources",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.baseValues.radiationAbsorption,
-            defaultParameters.baseValues.radiationAbsorption,
-            "simulation parameters.radiation.absorption",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.radiation.disable sources");
+        codec.encodeDecode(
+            parameters.baseValues.radiationAbsorption, defaultParameters.baseValues.radiationAbsorption, "simulation parameters.radiation.absorption");
+        codec.encodeDecode(
             parameters.radiationAbsorptionHighVelocityPenalty,
             defaultParameters.radiationAbsorptionHighVelocityPenalty,
-            "simulation parameters.radiation.absorption velocity penalty",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.radiation.absorption velocity penalty");
+        codec.encodeDecode(
             parameters.baseValues.radiationAbsorptionLowVelocityPenalty,
             defaultParameters.baseValues.radiationAbsorptionLowVelocityPenalty,
-            "simulation parameters.radiation.absorption low velocity penalty",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.radiation.absorption low velocity penalty");
+        codec.encodeDecode(
             parameters.radiationAbsorptionLowConnectionPenalty,
             defaultParameters.radiationAbsorptionLowConnectionPenalty,
-            "simulation parameters.radiation.absorption low connection penalty",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.radiation.absorption low connection penalty");
+        codec.encodeDecode(
             parameters.baseValues.radiationAbsorptionLowGenomeComplexityPenalty,
             defaultParameters.baseValues.radiationAbsorptionLowGenomeComplexityPenalty,
-            "simulation parameters.radiation.absorption low genome complexity penalty",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.highRadiationMinCellEnergy,
-            defaultParameters.highRadiationMinCellEnergy,
-            "simulation parameters.high radiation.min cell energy",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.highRadiationFactor, defaultParameters.highRadiationFactor, "simulation parameters.high radiation.factor", parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.radiationMinCellAge, defaultParameters.radiationMinCellAge, "simulation parameters.radiation.min cell age", parserTask);
-
-        PropertyParser::encodeDecode(
-            tree, parameters.externalEnergy, defaultParameters.externalEnergy, "simulation parameters.cell.function.constructor.external energy", parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.radiation.absorption low genome complexity penalty");
+        codec.encodeDecode(
+            parameters.highRadiationMinCellEnergy, defaultParameters.highRadiationMinCellEnergy, "simulation parameters.high radiation.min cell energy");
+        codec.encodeDecode(parameters.highRadiationFactor, defaultParameters.highRadiationFactor, "simulation parameters.high radiation.factor");
+        codec.encodeDecode(parameters.radiationMinCellAge, defaultParameters.radiationMinCellAge, "simulation parameters.radiation.min cell age");
+
+        codec.encodeDecode(parameters.externalEnergy, defaultParameters.externalEnergy, "simulation parameters.cell.function.constructor.external energy");
+        codec.encodeDecode(
             parameters.externalEnergyInflowFactor,
             defaultParameters.externalEnergyInflowFactor,
-            "simulation parameters.cell.function.constructor.external energy supply rate",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.constructor.external energy supply rate");
+        codec.encodeDecode(
             parameters.externalEnergyConditionalInflowFactor,
             defaultParameters.externalEnergyConditionalInflowFactor,
-            "simulation parameters.cell.function.constructor.pump energy factor",
-            parserTask);
-        missingParameters.externalEnergyBackflowFactor = PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.constructor.pump energy factor");
+        missingParameters.externalEnergyBackflowFactor = codec.encodeDecode(
             parameters.externalEnergyBackflowFactor,
             defaultParameters.externalEnergyBackflowFactor,
-            "simulation parameters.cell.function.constructor.external energy backflow",
-            parserTask);
+            "simulation parameters.cell.function.constructor.external energy backflow");
 
-        missingParameters.cellDeathConsequences = PropertyParser::encodeDecode(
-            tree, parameters.cellDeathConsequences, defaultParameters.cellDeathConsequences, "simulation parameters.cell.death consequences", parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.cellDeathProbability, defaultParameters.cellDeathProbability, "simulation parameters.cell.death probability", parserTask);
+        missingParameters.cellDeathConsequences = codec.encodeDecode(
+            parameters.cellDeathConsequences, defaultParameters.cellDeathConsequences, "simulation parameters.cell.death consequences");
+        codec.encodeDecode(parameters.cellDeathProbability, defaultParameters.cellDeathProbability, "simulation parameters.cell.death probability");
 
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
             parameters.cellFunctionConstructorOffspringDistance,
             defaultParameters.cellFunctionConstructorOffspringDistance,
-            "simulation parameters.cell.function.constructor.offspring distance",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.constructor.offspring distance");
+        codec.encodeDecode(
             parameters.cellFunctionConstructorConnectingCellMaxDistance,
             defaultParameters.cellFunctionConstructorConnectingCellMaxDistance,
-            "simulation parameters.cell.function.constructor.connecting cell max distance",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.constructor.connecting cell max distance");
+        codec.encodeDecode(
             parameters.cellFunctionConstructorActivityThreshold,
             defaultParameters.cellFunctionConstructorActivityThreshold,
-            "simulation parameters.cell.function.constructor.activity threshold",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.constructor.activity threshold");
+        codec.encodeDecode(
             parameters.cellFunctionConstructorCheckCompletenessForSelfReplication,
             defaultParameters.cellFunctionConstructorCheckCompletenessForSelfReplication,
-            "simulation parameters.cell.function.constructor.completeness check for self-replication",
-            parserTask);
+            "simulation parameters.cell.function.constructor.completeness check for self-replication");
 
-        missingParameters.copyMutations = PropertyParser::encodeDecode(
-            tree,
+        missingParameters.copyMutations = codec.encodeDecode(
             parameters.baseValues.cellCopyMutationNeuronData,
             defaultParameters.baseValues.cellCopyMutationNeuronData,
-            "simulation parameters.cell.copy mutation.neuron data",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.neuron data");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationCellProperties,
             defaultParameters.baseValues.cellCopyMutationCellProperties,
-            "simulation parameters.cell.copy mutation.cell properties",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.cell properties");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationGeometry,
             defaultParameters.baseValues.cellCopyMutationGeometry,
-            "simulation parameters.cell.copy mutation.geometry",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.geometry");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationCustomGeometry,
             defaultParameters.baseValues.cellCopyMutationCustomGeometry,
-            "simulation parameters.cell.copy mutation.custom geometry",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.custom geometry");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationCellFunction,
             defaultParameters.baseValues.cellCopyMutationCellFunction,
-            "simulation parameters.cell.copy mutation.cell function",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.cell function");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationInsertion,
             defaultParameters.baseValues.cellCopyMutationInsertion,
-            "simulation parameters.cell.copy mutation.insertion",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.insertion");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationDeletion,
             defaultParameters.baseValues.cellCopyMutationDeletion,
-            "simulation parameters.cell.copy mutation.deletion",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.deletion");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationTranslation,
             defaultParameters.baseValues.cellCopyMutationTranslation,
-            "simulation parameters.cell.copy mutation.translation",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.translation");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationDuplication,
             defaultParameters.baseValues.cellCopyMutationDuplication,
-            "simulation parameters.cell.copy mutation.duplication",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.duplication");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationCellColor,
             defaultParameters.baseValues.cellCopyMutationCellColor,
-            "simulation parameters.cell.copy mutation.cell color",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.cell color");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationSubgenomeColor,
             defaultParameters.baseValues.cellCopyMutationSubgenomeColor,
-            "simulation parameters.cell.copy mutation.subgenome color",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.subgenome color");
+        codec.encodeDecode(
             parameters.baseValues.cellCopyMutationGenomeColor,
             defaultParameters.baseValues.cellCopyMutationGenomeColor,
-            "simulation parameters.cell.copy mutation.genome color",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.genome color");
+        codec.encodeDecode(
             parameters.cellFunctionConstructorMutationColorTransitions,
             defaultParameters.cellFunctionConstructorMutationColorTransitions,
-            "simulation parameters.cell.copy mutation.color transition",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.color transition");
+        codec.encodeDecode(
             parameters.cellFunctionConstructorMutationSelfReplication,
             defaultParameters.cellFunctionConstructorMutationSelfReplication,
-            "simulation parameters.cell.copy mutation.self replication flag",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.copy mutation.self replication flag");
+        codec.encodeDecode(
             parameters.cellFunctionConstructorMutationPreventDepthIncrease,
             defaultParameters.cellFunctionConstructorMutationPreventDepthIncrease,
-            "simulation parameters.cell.copy mutation.prevent depth increase",
-            parserTask);
+            "simulation parameters.cell.copy mutation.prevent depth increase");
 
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellFunctionInjectorRadius,
-            defaultParameters.cellFunctionInjectorRadius,
-            "simulation parameters.cell.function.injector.radius",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
+            parameters.cellFunctionInjectorRadius, defaultParameters.cellFunctionInjectorRadius, "simulation parameters.cell.function.injector.radius");
+        codec.encodeDecode(
             parameters.cellFunctionInjectorDurationColorMatrix,
             defaultParameters.cellFunctionInjectorDurationColorMatrix,
-            "simulation parameters.cell.function.injector.duration",
-            parserTask);
+            "simulation parameters.cell.function.injector.duration");
 
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellFunctionAttackerRadius,
-            defaultParameters.cellFunctionAttackerRadius,
-            "simulation parameters.cell.function.attacker.radius",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellFunctionAttackerStrength,
-            defaultParameters.cellFunctionAttackerStrength,
-            "simulation parameters.cell.function.attacker.strength",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
+            parameters.cellFunctionAttackerRadius, defaultParameters.cellFunctionAttackerRadius, "simulation parameters.cell.function.attacker.radius");
+        codec.encodeDecode(
+            parameters.cellFunctionAttackerStrength, defaultParameters.cellFunctionAttackerStrength, "simulation parameters.cell.function.attacker.strength");
+        codec.encodeDecode(
             parameters.cellFunctionAttackerEnergyDistributionRadius,
             defaultParameters.cellFunctionAttackerEnergyDistributionRadius,
-            "simulation parameters.cell.function.attacker.energy distribution radius",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.energy distribution radius");
+        codec.encodeDecode(
             parameters.cellFunctionAttackerEnergyDistributionValue,
             defaultParameters.cellFunctionAttackerEnergyDistributionValue,
-            "simulation parameters.cell.function.attacker.energy distribution value",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.energy distribution value");
+        codec.encodeDecode(
             parameters.cellFunctionAttackerColorInhomogeneityFactor,
             defaultParameters.cellFunctionAttackerColorInhomogeneityFactor,
-            "simulation parameters.cell.function.attacker.color inhomogeneity factor",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.color inhomogeneity factor");
+        codec.encodeDecode(
             parameters.cellFunctionAttackerActivityThreshold,
             defaultParameters.cellFunctionAttackerActivityThreshold,
-            "simulation parameters.cell.function.attacker.activity threshold",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.activity threshold");
+        codec.encodeDecode(
             parameters.baseValues.cellFunctionAttackerEnergyCost,
             defaultParameters.baseValues.cellFunctionAttackerEnergyCost,
-            "simulation parameters.cell.function.attacker.energy cost",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.energy cost");
+        codec.encodeDecode(
             parameters.baseValues.cellFunctionAttackerGeometryDeviationExponent,
             defaultParameters.baseValues.cellFunctionAttackerGeometryDeviationExponent,
-            "simulation parameters.cell.function.attacker.geometry deviation exponent",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.geometry deviation exponent");
+        codec.encodeDecode(
             parameters.baseValues.cellFunctionAttackerFoodChainColorMatrix,
             defaultParameters.baseValues.cellFunctionAttackerFoodChainColorMatrix,
-            "simulation parameters.cell.function.attacker.food chain color matrix",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.food chain color matrix");
+        codec.encodeDecode(
             parameters.baseValues.cellFunctionAttackerConnectionsMismatchPenalty,
             defaultParameters.baseValues.cellFunctionAttackerConnectionsMismatchPenalty,
-            "simulation parameters.cell.function.attacker.connections mismatch penalty",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.connections mismatch penalty");
+        codec.encodeDecode(
             parameters.baseValues.cellFunctionAttackerGenomeComplexityBonus,
             defaultParameters.baseValues.cellFunctionAttackerGenomeComplexityBonus,
-            "simulation parameters.cell.function.attacker.genome size bonus",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.genome size bonus");
+        codec.encodeDecode(
             parameters.cellFunctionAttackerSameMutantPenalty,
             defaultParameters.cellFunctionAttackerSameMutantPenalty,
-            "simulation parameters.cell.function.attacker.same mutant penalty",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.same mutant penalty");
+        codec.encodeDecode(
             parameters.baseValues.cellFunctionAttackerNewComplexMutantPenalty,
             defaultParameters.baseValues.cellFunctionAttackerNewComplexMutantPenalty,
-            "simulation parameters.cell.function.attacker.new complex mutant penalty",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.new complex mutant penalty");
+        codec.encodeDecode(
             parameters.cellFunctionAttackerSensorDetectionFactor,
             defaultParameters.cellFunctionAttackerSensorDetectionFactor,
-            "simulation parameters.cell.function.attacker.sensor detection factor",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.attacker.sensor detection factor");
+        codec.encodeDecode(
             parameters.cellFunctionAttackerDestroyCells,
             defaultParameters.cellFunctionAttackerDestroyCells,
-            "simulation parameters.cell.function.attacker.destroy cells",
-            parserTask);
+            "simulation parameters.cell.function.attacker.destroy cells");
 
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
             parameters.cellFunctionDefenderAgainstAttackerStrength,
             defaultParameters.cellFunctionDefenderAgainstAttackerStrength,
-            "simulation parameters.cell.function.defender.against attacker strength",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.defender.against attacker strength");
+        codec.encodeDecode(
             parameters.cellFunctionDefenderAgainstInjectorStrength,
             defaultParameters.cellFunctionDefenderAgainstInjectorStrength,
-            "simulation parameters.cell.function.defender.against injector strength",
-            parserTask);
+            "simulation parameters.cell.function.defender.against injector strength");
 
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
             parameters.cellFunctionTransmitterEnergyDistributionSameCreature,
             defaultParameters.cellFunctionTransmitterEnergyDistributionSameCreature,
-            "simulation parameters.cell.function.transmitter.energy distribution same creature",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.transmitter.energy distribution same creature");
+        codec.encodeDecode(
             parameters.cellFunctionTransmitterEnergyDistributionRadius,
             defaultParameters.cellFunctionTransmitterEnergyDistributionRadius,
-            "simulation parameters.cell.function.transmitter.energy distribution radius",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.transmitter.energy distribution radius");
+        codec.encodeDecode(
             parameters.cellFunctionTransmitterEnergyDistributionValue,
             defaultParameters.cellFunctionTransmitterEnergyDistributionValue,
-            "simulation parameters.cell.function.transmitter.energy distribution value",
-            parserTask);
+            "simulation parameters.cell.function.transmitter.energy distribution value");
 
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
             parameters.cellFunctionMuscleContractionExpansionDelta,
             defaultParameters.cellFunctionMuscleContractionExpansionDelta,
-            "simulation parameters.cell.function.muscle.contraction expansion delta",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.muscle.contraction expansion delta");
+        codec.encodeDecode(
             parameters.cellFunctionMuscleMovementAcceleration,
             defaultParameters.cellFunctionMuscleMovementAcceleration,
-            "simulation parameters.cell.function.muscle.movement acceleration",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.muscle.movement acceleration");
+        codec.encodeDecode(
             parameters.cellFunctionMuscleBendingAngle,
             defaultParameters.cellFunctionMuscleBendingAngle,
-            "simulation parameters.cell.function.muscle.bending angle",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.muscle.bending angle");
+        codec.encodeDecode(
             parameters.cellFunctionMuscleBendingAcceleration,
             defaultParameters.cellFunctionMuscleBendingAcceleration,
-            "simulation parameters.cell.function.muscle.bending acceleration",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.muscle.bending acceleration");
+        codec.encodeDecode(
             parameters.cellFunctionMuscleBendingAccelerationThreshold,
             defaultParameters.cellFunctionMuscleBendingAccelerationThreshold,
-            "simulation parameters.cell.function.muscle.bending acceleration threshold",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.muscle.bending acceleration threshold");
+        codec.encodeDecode(
             parameters.cellFunctionMuscleMovementTowardTargetedObject,
             defaultParameters.cellFunctionMuscleMovementTowardTargetedObject,
-            "simulation parameters.cell.function.muscle.movement toward targeted object",
-            parserTask);
+            "simulation parameters.cell.function.muscle.movement toward targeted object");
 
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.particleTransformationAllowed,
-            defaultParameters.particleTransformationAllowed,
-            "simulation parameters.particle.transformation allowed",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
+            parameters.particleTransformationAllowed, defaultParameters.particleTransformationAllowed, "simulation parameters.particle.transformation allowed");
+        codec.encodeDecode(
             parameters.particleTransformationRandomCellFunction,
             defaultParameters.particleTransformationRandomCellFunction,
-            "simulation parameters.particle.transformation.random cell function",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.particle.transformation.random cell function");
+        codec.encodeDecode(
             parameters.particleTransformationMaxGenomeSize,
             defaultParameters.particleTransformationMaxGenomeSize,
-            "simulation parameters.particle.transformation.max genome size",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree, parameters.particleSplitEnergy, defaultParameters.particleSplitEnergy, "simulation parameters.particle.split energy", parserTask);
+            "simulation parameters.particle.transformation.max genome size");
+        codec.encodeDecode(parameters.particleSplitEnergy, defaultParameters.particleSplitEnergy, "simulation parameters.particle.split energy");
 
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellFunctionSensorRange,
-            defaultParameters.cellFunctionSensorRange,
-            "simulation parameters.cell.function.sensor.range",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(parameters.cellFunctionSensorRange, defaultParameters.cellFunctionSensorRange, "simulation parameters.cell.function.sensor.range");
+        codec.encodeDecode(
             parameters.cellFunctionSensorActivityThreshold,
             defaultParameters.cellFunctionSensorActivityThreshold,
-            "simulation parameters.cell.function.sensor.activity threshold",
-            parserTask);
+            "simulation parameters.cell.function.sensor.activity threshold");
 
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
             parameters.cellFunctionReconnectorRadius,
             defaultParameters.cellFunctionReconnectorRadius,
-            "simulation parameters.cell.function.reconnector.radius",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.reconnector.radius");
+        codec.encodeDecode(
             parameters.cellFunctionReconnectorActivityThreshold,
             defaultParameters.cellFunctionReconnectorActivityThreshold,
-            "simulation parameters.cell.function.reconnector.activity threshold",
-            parserTask);
+            "simulation parameters.cell.function.reconnector.activity threshold");
 
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.cellFunctionDetonatorRadius,
-            defaultParameters.cellFunctionDetonatorRadius,
-            "simulation parameters.cell.function.detonator.radius",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
+            parameters.cellFunctionDetonatorRadius, defaultParameters.cellFunctionDetonatorRadius, "simulation parameters.cell.function.detonator.radius");
+        codec.encodeDecode(
             parameters.cellFunctionDetonatorChainExplosionProbability,
             defaultParameters.cellFunctionDetonatorChainExplosionProbability,
-            "simulation parameters.cell.function.detonator.chain explosion probability",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.cell.function.detonator.chain explosion probability");
+        codec.encodeDecode(
             parameters.cellFunctionDetonatorActivityThreshold,
             defaultParameters.cellFunctionDetonatorActivityThreshold,
-            "simulation parameters.cell.function.detonator.activity threshold",
-            parserTask);
+            "simulation parameters.cell.function.detonator.activity threshold");
 
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
             parameters.legacyCellFunctionMuscleMovementAngleFromSensor,
             defaultParameters.legacyCellFunctionMuscleMovementAngleFromSensor,
-            "simulation parameters.legacy.cell.function.muscle.movement angle from sensor",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.legacy.cell.function.muscle.movement angle from sensor");
+        codec.encodeDecode(
             parameters.legacyCellFunctionMuscleNoActivityReset,
             defaultParameters.legacyCellFunctionMuscleNoActivityReset,
-            "simulation parameters.legacy.cell.function.muscle.no activity reset",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.legacy.cell.function.muscle.no activity reset");
+        codec.encodeDecode(
             parameters.legacyCellDirectionalConnections,
             defaultParameters.legacyCellDirectionalConnections,
-            "simulation parameters.legacy.cell.bidirectional connections",
-            parserTask);
+            "simulation parameters.legacy.cell.bidirectional connections");
 
         //particle sources
-        PropertyParser::encodeDecode(
-            tree, parameters.numRadiationSources, defaultParameters.numRadiationSources, "simulation parameters.particle sources.num sources", parserTask);
+        codec.encodeDecode(parameters.numRadiationSources, defaultParameters.numRadiationSources, "simulation parameters.particle sources.num sources");
         for (int index = 0; index < parameters.numRadiationSources; ++index) {
             std::string base = "simulation parameters.particle sources." + std::to_string(index) + ".";
             auto& source = parameters.radiationSources[index];
             auto& defaultSource = defaultParameters.radiationSources[index];
-            PropertyParser::encodeDecode(tree, source.posX, defaultSource.posX, base + "pos.x", parserTask);
-            PropertyParser::encodeDecode(tree, source.posY, defaultSource.posY, base + "pos.y", parserTask);
-            PropertyParser::encodeDecode(tree, source.velX, defaultSource.velX, base + "vel.x", parserTask);
-            PropertyParser::encodeDecode(tree, source.velY, defaultSource.velY, base + "vel.y", parserTask);
-            PropertyParser::encodeDecode(tree, source.useAngle, defaultSource.useAngle, base + "use angle", parserTask);
-            PropertyParser::encodeDecode(tree, source.angle, defaultSource.angle, base + "angle", parserTask);
-            PropertyParser::encodeDecode(tree, source.shapeType, defaultSource.shapeType, base + "shape.type", parserTask);
+            codec.encodeDecode(source.posX, defaultSource.posX, base + "pos.x");
+            codec.encodeDecode(source.posY, defaultSource.posY, base + "pos.y");
+            codec.encodeDecode(source.velX, defaultSource.velX, base + "vel.x");
+            codec.encodeDecode(source.velY, defaultSource.velY, base + "vel.y");
+            codec.encodeDecode(source.useAngle, defaultSource.useAngle, base + "use angle");
+            codec.encodeDecode(source.angle, defaultSource.angle, base + "angle");
+            codec.encodeDecode(source.shapeType, defaultSource.shapeType, base + "shape.type");
             if (source.shapeType == SpotShapeType_Circular) {
-                PropertyParser::encodeDecode(
-                    tree,
-                    source.shapeData.circularRadiationSource.radius,
-                    defaultSource.shapeData.circularRadiationSource.radius,
-                    base + "shape.circular.radius",
-                    parserTask);
+                codec.encodeDecode(
+                    source.shapeData.circularRadiationSource.radius, defaultSource.shapeData.circularRadiationSource.radius, base + "shape.circular.radius");
             }
             if (source.shapeType == SpotShapeType_Rectangular) {
-                PropertyParser::encodeDecode(
-                    tree,
+                codec.encodeDecode(
                     source.shapeData.rectangularRadiationSource.width,
                     defaultSource.shapeData.rectangularRadiationSource.width,
-                    base + "shape.rectangular.width",
-                    parserTask);
-                PropertyParser::encodeDecode(
-                    tree,
+                    base + "shape.rectangular.width");
+                codec.encodeDecode(
                     source.shapeData.rectangularRadiationSource.height,
                     defaultSource.shapeData.rectangularRadiationSource.height,
-                    base + "shape.rectangular.height",
-                    parserTask);
+                    base + "shape.rectangular.height");
             }
         }
 
         //spots
-        PropertyParser::encodeDecode(tree, parameters.numSpots, defaultParameters.numSpots, "simulation parameters.spots.num spots", parserTask);
+        codec.encodeDecode(parameters.numSpots, defaultParameters.numSpots, "simulation parameters.spots.num spots");
         for (int index = 0; index < parameters.numSpots; ++index) {
             std::string base = "simulation parameters.spots." + std::to_string(index) + ".";
             auto& spot = parameters.spots[index];
             auto& defaultSpot = defaultParameters.spots[index];
-            PropertyParser::encodeDecode(tree, spot.color, defaultSpot.color, base + "color", parserTask);
-            PropertyParser::encodeDecode(tree, spot.posX, defaultSpot.posX, base + "pos.x", parserTask);
-            PropertyParser::encodeDecode(tree, spot.posY, defaultSpot.posY, base + "pos.y", parserTask);
-            PropertyParser::encodeDecode(tree, spot.velX, defaultSpot.velX, base + "vel.x", parserTask);
-            PropertyParser::encodeDecode(tree, spot.velY, defaultSpot.velY, base + "vel.y", parserTask);
+            codec.encodeDecode(spot.color, defaultSpot.color, base + "color");
+            codec.encodeDecode(spot.posX, defaultSpot.posX, base + "pos.x");
+            codec.encodeDecode(spot.posY, defaultSpot.posY, base + "pos.y");
+            codec.encodeDecode(spot.velX, defaultSpot.velX, base + "vel.x");
+            codec.encodeDecode(spot.velY, defaultSpot.velY, base + "vel.y");
 
-            PropertyParser::encodeDecode(tree, spot.shapeType, defaultSpot.shapeType, base + "shape.type", parserTask);
+            codec.encodeDecode(spot.shapeType, defaultSpot.shapeType, base + "shape.type");
             if (spot.shapeType == SpotShapeType_Circular) {
-                PropertyParser::encodeDecode(
-                    tree,
-                    spot.shapeData.circularSpot.coreRadius,
-                    defaultSpot.shapeData.circularSpot.coreRadius,
-                    base + "shape.circular.core radius",
-                    parserTask);
+                codec.encodeDecode(spot.shapeData.circularSpot.coreRadius, defaultSpot.shapeData.circularSpot.coreRadius, base + "shape.circular.core radius");
             }
             if (spot.shapeType == SpotShapeType_Rectangular) {
-                PropertyParser::encodeDecode(
-                    tree, spot.shapeData.rectangularSpot.width, defaultSpot.shapeData.rectangularSpot.width, base + "shape.rectangular.core width", parserTask);
-                PropertyParser::encodeDecode(
-                    tree,
-                    spot.shapeData.rectangularSpot.height,
-                    defaultSpot.shapeData.rectangularSpot.height,
-                    base + "shape.rectangular.core height",
-                    parserTask);
+                codec.encodeDecode(spot.shapeData.rectangularSpot.width, defaultSpot.shapeData.rectangularSpot.width, base + "shape.rectangular.core width");
+                codec.encodeDecode(spot.shapeData.rectangularSpot.height, defaultSpot.shapeData.rectangularSpot.height, base + "shape.rectangular.core height");
             }
-            PropertyParser::encodeDecode(tree, spot.flowType, defaultSpot.flowType, base + "flow.type", parserTask);
+            codec.encodeDecode(spot.flowType, defaultSpot.flowType, base + "flow.type");
             if (spot.flowType == FlowType_Radial) {
-                PropertyParser::encodeDecode(
-                    tree, spot.flowData.radialFlow.orientation, defaultSpot.flowData.radialFlow.orientation, base + "flow.radial.orientation", parserTask);
-                PropertyParser::encodeDecode(
-                    tree, spot.flowData.radialFlow.strength, defaultSpot.flowData.radialFlow.strength, base + "flow.radial.strength", parserTask);
-                PropertyParser::encodeDecode(
-                    tree, spot.flowData.radialFlow.driftAngle, defaultSpot.flowData.radialFlow.driftAngle, base + "flow.radial.drift angle", parserTask);
+                codec.encodeDecode(spot.flowData.radialFlow.orientation, defaultSpot.flowData.radialFlow.orientation, base + "flow.radial.orientation");
+                codec.encodeDecode(spot.flowData.radialFlow.strength, defaultSpot.flowData.radialFlow.strength, base + "flow.radial.strength");
+                codec.encodeDecode(spot.flowData.radialFlow.driftAngle, defaultSpot.flowData.radialFlow.driftAngle, base + "flow.radial.drift angle");
             }
             if (spot.flowType == FlowType_Central) {
-                PropertyParser::encodeDecode(
-                    tree, spot.flowData.centralFlow.strength, defaultSpot.flowData.centralFlow.strength, base + "flow.central.strength", parserTask);
+                codec.encodeDecode(spot.flowData.centralFlow.strength, defaultSpot.flowData.centralFlow.strength, base + "flow.central.strength");
             }
             if (spot.flowType == FlowType_Linear) {
-                PropertyParser::encodeDecode(tree, spot.flowData.linearFlow.angle, defaultSpot.flowData.linearFlow.angle, base + "flow.linear.angle", parserTask);
-                PropertyParser::encodeDecode(
-                    tree, spot.flowData.linearFlow.strength, defaultSpot.flowData.linearFlow.strength, base + "flow.linear.strength", parserTask);
+                codec.encodeDecode(spot.flowData.linearFlow.angle, defaultSpot.flowData.linearFlow.angle, base + "flow.linear.angle");
+                codec.encodeDecode(spot.flowData.linearFlow.strength, defaultSpot.flowData.linearFlow.strength, base + "flow.linear.strength");
             }
-            PropertyParser::encodeDecode(tree, spot.fadeoutRadius, defaultSpot.fadeoutRadius, base + "fadeout radius", parserTask);
+            codec.encodeDecode(spot.fadeoutRadius, defaultSpot.fadeoutRadius, base + "fadeout radius");
 
-            PropertyParser::encodeDecodeWithEnabled(tree, spot.values.friction, spot.activatedValues.friction, defaultSpot.values.friction, base + "friction", parserTask);
-            PropertyParser::encodeDecodeWithEnabled(tree, spot.values.rigidity, spot.activatedValues.rigidity, defaultSpot.values.rigidity, base + "rigidity", parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+            codec.encodeDecodeWithEnabled(spot.values.friction, spot.activatedValues.friction, defaultSpot.values.friction, base + "friction");
+            codec.encodeDecodeWithEnabled(spot.values.rigidity, spot.activatedValues.rigidity, defaultSpot.values.rigidity, base + "rigidity");
+            codec.encodeDecodeWithEnabled(
                 spot.values.radiationDisableSources,
                 spot.activatedValues.radiationDisableSources,
                 defaultSpot.values.radiationDisableSources,
-                base + "radiation.disable sources",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "radiation.disable sources");
+            codec.encodeDecodeWithEnabled(
                 spot.values.radiationAbsorption,
                 spot.activatedValues.radiationAbsorption,
                 defaultSpot.values.radiationAbsorption,
-                base + "radiation.absorption",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "radiation.absorption");
+            codec.encodeDecodeWithEnabled(
                 spot.values.radiationAbsorptionLowVelocityPenalty,
                 spot.activatedValues.radiationAbsorptionLowVelocityPenalty,
                 defaultSpot.values.radiationAbsorptionLowVelocityPenalty,
-                base + "radiation.absorption low velocity penalty",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "radiation.absorption low velocity penalty");
+            codec.encodeDecodeWithEnabled(
                 spot.values.radiationAbsorptionLowGenomeComplexityPenalty,
                 spot.activatedValues.radiationAbsorptionLowGenomeComplexityPenalty,
                 defaultSpot.values.radiationAbsorptionLowGenomeComplexityPenalty,
-                base +"radiation.absorption low genome complexity penalty",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base +"radiation.absorption low genome complexity penalty");
+            codec.encodeDecodeWithEnabled(
                 spot.values.radiationCellAgeStrength,
                 spot.activatedValues.radiationCellAgeStrength,
                 defaultSpot.values.radiationCellAgeStrength,
-                base + "radiation.factor",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree, spot.values.cellMaxForce, spot.activatedValues.cellMaxForce, defaultSpot.values.cellMaxForce, base + "cell.max force", parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree, spot.values.cellMinEnergy, spot.activatedValues.cellMinEnergy, defaultSpot.values.cellMinEnergy, base + "cell.min energy", parserTask);
-
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
-                spot.values.cellFusionVelocity,
-                spot.activatedValues.cellFusionVelocity,
-                defaultSpot.values.cellFusionVelocity,
-                base + "cell.fusion velocity",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "radiation.factor");
+            codec.encodeDecodeWithEnabled(
+                spot.values.cellMaxForce, spot.activatedValues.cellMaxForce, defaultSpot.values.cellMaxForce, base + "cell.max force");
+            codec.encodeDecodeWithEnabled(
+                spot.values.cellMinEnergy, spot.activatedValues.cellMinEnergy, defaultSpot.values.cellMinEnergy, base + "cell.min energy");
+
+            codec.encodeDecodeWithEnabled(
+                spot.values.cellFusionVelocity, spot.activatedValues.cellFusionVelocity, defaultSpot.values.cellFusionVelocity, base + "cell.fusion velocity");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellMaxBindingEnergy,
                 spot.activatedValues.cellMaxBindingEnergy,
                 defaultSpot.values.cellMaxBindingEnergy,
-                base + "cell.max binding energy",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
-                spot.values.cellInactiveMaxAge,
-                spot.activatedValues.cellInactiveMaxAge,
-                defaultSpot.values.cellInactiveMaxAge,
-                base + "cell.inactive max age",
-                parserTask);
-
-            PropertyParser::encodeDecode(tree, spot.activatedValues.cellColorTransition, false, base + "cell.color transition rules.activated", parserTask);
-            PropertyParser::encodeDecode(
-                tree,
-                spot.values.cellColorTransitionDuration,
-                defaultSpot.values.cellColorTransitionDuration,
-                base + "cell.color transition rules.duration",
-                parserTask);
-            PropertyParser::encodeDecode(
-                tree,
+                base + "cell.max binding energy");
+            codec.encodeDecodeWithEnabled(
+                spot.values.cellInactiveMaxAge, spot.activatedValues.cellInactiveMaxAge, defaultSpot.values.cellInactiveMaxAge, base + "cell.inactive max age");
+
+            codec.encodeDecode(spot.activatedValues.cellColorTransition, false, base + "cell.color transition rules.activated");
+            codec.encodeDecode(
+                spot.values.cellColorTransitionDuration, defaultSpot.values.cellColorTransitionDuration, base + "cell.color transition rules.duration");
+            codec.encodeDecode(
                 spot.values.cellColorTransitionTargetColor,
                 defaultSpot.values.cellColorTransitionTargetColor,
-                base + "cell.color transition rules.target color",
-                parserTask);
+                base + "cell.color transition rules.target color");
 
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellFunctionAttackerEnergyCost,
                 spot.activatedValues.cellFunctionAttackerEnergyCost,
                 defaultSpot.values.cellFunctionAttackerEnergyCost,
-                base + "cell.function.attacker.energy cost",
-                parserTask);
+                base + "cell.function.attacker.energy cost");
 
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellFunctionAttackerFoodChainColorMatrix,
                 spot.activatedValues.cellFunctionAttackerFoodChainColorMatrix,
                 defaultSpot.values.cellFunctionAttackerFoodChainColorMatrix,
-                base + "cell.function.attacker.food chain color matrix",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.function.attacker.food chain color matrix");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellFunctionAttackerGenomeComplexityBonus,
                 spot.activatedValues.cellFunctionAttackerGenomeComplexityBonus,
                 defaultSpot.values.cellFunctionAttackerGenomeComplexityBonus,
-                base + "cell.function.attacker.genome size bonus",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.function.attacker.genome size bonus");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellFunctionAttackerNewComplexMutantPenalty,
                 spot.activatedValues.cellFunctionAttackerNewComplexMutantPenalty,
                 defaultSpot.values.cellFunctionAttackerNewComplexMutantPenalty,
-                base + "cell.function.attacker.new complex mutant penalty",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.function.attacker.new complex mutant penalty");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellFunctionAttackerGeometryDeviationExponent,
                 spot.activatedValues.cellFunctionAttackerGeometryDeviationExponent,
                 defaultSpot.values.cellFunctionAttackerGeometryDeviationExponent,
-                base + "cell.function.attacker.geometry deviation exponent",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.function.attacker.geometry deviation exponent");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellFunctionAttackerConnectionsMismatchPenalty,
                 spot.activatedValues.cellFunctionAttackerConnectionsMismatchPenalty,
                 defaultSpot.values.cellFunctionAttackerConnectionsMismatchPenalty,
-                base + "cell.function.attacker.connections mismatch penalty",
-                parserTask);
+                base + "cell.function.attacker.connections mismatch penalty");
 
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationNeuronData,
                 spot.activatedValues.cellCopyMutationNeuronData,
                 defaultSpot.values.cellCopyMutationNeuronData,
-                base + "cell.copy mutation.neuron data",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.neuron data");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationCellProperties,
                 spot.activatedValues.cellCopyMutationCellProperties,
                 defaultSpot.values.cellCopyMutationCellProperties,
-                base + "cell.copy mutation.cell properties",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.cell properties");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationGeometry,
                 spot.activatedValues.cellCopyMutationGeometry,
                 defaultSpot.values.cellCopyMutationGeometry,
-                base + "cell.copy mutation.geometry",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.geometry");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationCustomGeometry,
                 spot.activatedValues.cellCopyMutationCustomGeometry,
                 defaultSpot.values.cellCopyMutationCustomGeometry,
-                base + "cell.copy mutation.custom geometry",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.custom geometry");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationCellFunction,
                 spot.activatedValues.cellCopyMutationCellFunction,
                 defaultSpot.values.cellCopyMutationCellFunction,
-                base + "cell.copy mutation.cell function",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.cell function");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationInsertion,
                 spot.activatedValues.cellCopyMutationInsertion,
                 defaultSpot.values.cellCopyMutationInsertion,
-                base + "cell.copy mutation.insertion",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.insertion");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationDeletion,
                 spot.activatedValues.cellCopyMutationDeletion,
                 defaultSpot.values.cellCopyMutationDeletion,
-                base + "cell.copy mutation.deletion",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.deletion");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationTranslation,
                 spot.activatedValues.cellCopyMutationTranslation,
                 defaultSpot.values.cellCopyMutationTranslation,
-                base + "cell.copy mutation.translation",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.translation");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationDuplication,
                 spot.activatedValues.cellCopyMutationDuplication,
                 defaultSpot.values.cellCopyMutationDuplication,
-                base + "cell.copy mutation.duplication",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.duplication");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationCellColor,
                 spot.activatedValues.cellCopyMutationCellColor,
                 defaultSpot.values.cellCopyMutationCellColor,
-                base + "cell.copy mutation.cell color",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.cell color");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationSubgenomeColor,
                 spot.activatedValues.cellCopyMutationSubgenomeColor,
                 defaultSpot.values.cellCopyMutationSubgenomeColor,
-                base + "cell.copy mutation.subgenome color",
-                parserTask);
-            PropertyParser::encodeDecodeWithEnabled(
-                tree,
+                base + "cell.copy mutation.subgenome color");
+            codec.encodeDecodeWithEnabled(
                 spot.values.cellCopyMutationGenomeColor,
                 spot.activatedValues.cellCopyMutationGenomeColor,
                 defaultSpot.values.cellCopyMutationGenomeColor,
-                base + "cell.copy mutation.genome color",
-                parserTask);
+                base + "cell.copy mutation.genome color");
         }
 
         //features
-        PropertyParser::encodeDecode(
-            tree,
+        codec.encodeDecode(
             parameters.features.genomeComplexityMeasurement,
             defaultParameters.features.genomeComplexityMeasurement,
-            "simulation parameters.features.genome complexity measurement",
-            parserTask);
-        missingFeatures.advancedAbsorptionControl = PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.features.genome complexity measurement");
+        missingFeatures.advancedAbsorptionControl = codec.encodeDecode(
             parameters.features.advancedAbsorptionControl,
             defaultParameters.features.advancedAbsorptionControl,
-            "simulation parameters.features.additional absorption control",
-            parserTask);
-        missingFeatures.advancedAttackerControl = PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.features.additional absorption control");
+        missingFeatures.advancedAttackerControl = codec.encodeDecode(
             parameters.features.advancedAttackerControl,
             defaultParameters.features.advancedAttackerControl,
-            "simulation parameters.features.additional attacker control",
-            parserTask);
-        missingFeatures.externalEnergyControl = PropertyParser::encodeDecode(
-            tree, parameters.features.externalEnergyControl, defaultParameters.features.externalEnergyControl, "simulation parameters.features.external energy", parserTask);
-        missingFeatures.cellColorTransitionRules = PropertyParser::encodeDecode(
-            tree,
+            "simulation parameters.features.additional attacker control");
+        missingFeatures.externalEnergyControl = codec.encodeDecode(
+            parameters.features.externalEnergyControl, defaultParameters.features.externalEnergyControl, "simulation parameters.features.external energy");
+        missingFeatures.cellColorTransitionRules = codec.encodeDecode(
             parameters.features.cellColorTransitionRules,
             defaultParameters.features.cellColorTransitionRules,
-            "simulation parameters.features.cell color transition rules",
-            parserTask);
-        missingFeatures.cellAgeLimiter = PropertyParser::encodeDecode(
-            tree,
-            parameters.features.cellAgeLimiter,
-            defaultParameters.features.cellAgeLimiter,
-            "simulation parameters.features.cell age limiter",
-            parserTask);
-        PropertyParser::encodeDecode(
-            tree,
-            parameters.features.cellGlow,
-            defaultParameters.features.cellGlow,
-            "simulation parameters.features.cell glow",
-            parserTask);
-        missingFeatures.legacyMode = PropertyParser::encodeDecode(
-            tree, parameters.features.legacyModes, defaultParameters.features.legacyModes, "simulation parameters.features.legacy modes", parserTask);
+            "simulation parameters.features.cell color transition rules");
+        missingFeatures.cellAgeLimiter = codec.encodeDecode(
+            parameters.features.cellAgeLimiter, defaultParameters.features.cellAgeLimiter, "simulation parameters.features.cell age limiter");
+        codec.encodeDecode(parameters.features.cellGlow, defaultParameters.features.cellGlow, "simulation parameters.features.cell glow");
+        missingFeatures.legacyMode = codec.encodeDecode(
+            parameters.features.legacyModes, defaultParameters.features.legacyModes, "simulation parameters.features.legacy modes");
     }
 
-    void encodeDecodeSimulationParameters(
-        boost::property_tree::ptree& tree,
-        SimulationParameters& parameters,
-        ParserTask parserTask)
+    template <typename Codec>
+    void encodeDecodeSimulationParameters(Codec& codec, SimulationParameters& parameters)
     {
         auto programVersion = Const::ProgramVersion;
-        PropertyParser::encodeDecode(tree, programVersion, std::string(), "simulation parameters.version", parserTask);
+        codec.encodeDecode(programVersion, std::string(), "simulation parameters.version");
 
         MissingParameters missingParameters;
         MissingFeatures missingFeatures;
-        encodeDecodeLatestSimulationParameters(tree, parameters, missingParameters, missingFeatures, parserTask);
+        encodeDecodeLatestSimulationParameters(codec, parameters, missingParameters, missingFeatures);
 
         // Compatibility with legacy parameters
-        if (parserTask == ParserTask::Decode) {
-            LegacyAuxiliaryDataParserService::searchAndApplyLegacyParameters(programVersion, tree, missingFeatures, missingParameters, parameters);
+        if constexpr (Codec::Task == ParserTask::Decode) {
+            LegacyAuxiliaryDataParserService::searchAndApplyLegacyParameters(programVersion, codec, missingFeatures, missingParameters, parameters);
         }
     }
 
-    void encodeDecode(boost::property_tree::ptree& tree, AuxiliaryData& data, ParserTask parserTask)
+    template <typename Codec>
+    void encodeDecode(Codec& codec, AuxiliaryData& data)
     {
         AuxiliaryData defaultSettings;
 
         //general settings
-        PropertyParser::encodeDecode(tree, data.timestep, uint64_t(0), "general.time step", parserTask);
-        PropertyParser::encodeDecode(tree, data.realTime, std::chrono::milliseconds(0), "general.real time", parserTask);
-        PropertyParser::encodeDecode(tree, data.zoom, 4.0f, "general.zoom", parserTask);
-        PropertyParser::encodeDecode(tree, data.center.x, 0.0f, "general.center.x", parserTask);
-        PropertyParser::encodeDecode(tree, data.center.y, 0.0f, "general.center.y", parserTask);
-        PropertyParser::encodeDecode(tree, data.generalSettings.worldSizeX, defaultSettings.generalSettings.worldSizeX, "general.world size.x", parserTask);
-        PropertyParser::encodeDecode(tree, data.generalSettings.worldSizeY, defaultSettings.generalSettings.worldSizeY, "general.world size.y", parserTask);
-
-        encodeDecodeSimulationParameters(tree, data.simulationParameters, parserTask);
+        codec.encodeDecode(data.timestep, uint64_t(0), "general.time step");
+        codec.encodeDecode(data.realTime, std::chrono::milliseconds(0), "general.real time");
+        codec.encodeDecode(data.zoom, 4.0f, "general.zoom");
+        codec.encodeDecode(data.center.x, 0.0f, "general.center.x");
+        codec.encodeDecode(data.center.y, 0.0f, "general.center.y");
+        codec.encodeDecode(data.generalSettings.worldSizeX, defaultSettings.generalSettings.worldSizeX, "general.world size.x");
+        codec.encodeDecode(data.generalSettings.worldSizeY, defaultSettings.generalSettings.worldSizeY, "general.world size.y");
+
+        encodeDecodeSimulationParameters(codec, data.simulationParameters);
     }
 }
 
 boost::property_tree::ptree AuxiliaryDataParserService::encodeAuxiliaryData(AuxiliaryData const& data)
 {
     boost::property_tree::ptree tree;
-    encodeDecode(tree, const_cast<AuxiliaryData&>(data), ParserTask::Encode);
+    PropertyTreeCodec<ParserTask::Encode> codec(tree);
+    encodeDecode(codec, const_cast<AuxiliaryData&>(data));
     return tree;
 }
 
 AuxiliaryData AuxiliaryDataParserService::decodeAuxiliaryData(boost::property_tree::ptree tree)
 {
     AuxiliaryData result;
-    encodeDecode(tree, result, ParserTask::Decode);
+    PropertyTreeCodec<ParserTask::Decode> codec(tree);
+    encodeDecode(codec, result);
     return result;
 }
 
 boost::property_tree::ptree AuxiliaryDataParserService::encodeSimulationParameters(SimulationParameters const& data)
 {
     boost::property_tree::ptree tree;
-    encodeDecodeSimulationParameters(tree, const_cast<SimulationParameters&>(data), ParserTask::Encode);
+    PropertyTreeCodec<ParserTask::Encode> codec(tree);
+    encodeDecodeSimulationParameters(codec, const_cast<SimulationParameters&>(data));
     return tree;
 }
 
 SimulationParameters AuxiliaryDataParserService::decodeSimulationParameters(boost::property_tree::ptree tree)
 {
     SimulationParameters result;
-    encodeDecodeSimulationParameters(tree, result, ParserTask::Decode);
+    PropertyTreeCodec<ParserTask::Decode> codec(tree);
+    encodeDecodeSimulationParameters(codec, result);
+    return result;
+}
+
+std::string AuxiliaryDataParserService::encodeAuxiliaryDataToJson(AuxiliaryData const& data)
+{
+    SettingsJsonWriter codec;
+    encodeDecode(codec, const_cast<AuxiliaryData&>(data));
+    return codec.getJson();
+}
+
+AuxiliaryData AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(std::string const& json)
+{
+    AuxiliaryData result;
+    SettingsJsonReader codec(json);
+    encodeDecode(codec, result);
+    return result;
+}
+
+std::string AuxiliaryDataParserService::encodeSimulationParametersToJson(SimulationParameters const& data)
+{
+    SettingsJsonWriter codec;
+    encodeDecodeSimulationParameters(codec, const_cast<SimulationParameters&>(data));
+    return codec.getJson();
+}
+
+SimulationParameters AuxiliaryDataParserService::decodeSimulationParametersFromJson(std::string const& json)
+{
+    SimulationParameters result;
+    SettingsJsonReader codec(json);
+    encodeDecodeSimulationParameters(codec, result);
     return result;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include <boost/property_tree/ptree.hpp>
 
 #include "Base/JsonParser.h"
@@ -16,4 +18,11 @@ public:
 
     static boost::property_tree::ptree encodeSimulationParameters(SimulationParameters const& data);
     static SimulationParameters decodeSimulationParameters(boost::property_tree::ptree tree);
+
+    //the JSON text is produced and parsed without building a property tree, the format is the same as above
+    static std::string encodeAuxiliaryDataToJson(AuxiliaryData const& data);
+    static AuxiliaryData decodeAuxiliaryDataFromJson(std::string const& json);
+
+    static std::string encodeSimulationParametersToJson(SimulationParameters const& data);
+    static SimulationParameters decodeSimulationParametersFromJson(std::string const& json);
 };
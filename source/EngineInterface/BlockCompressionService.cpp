@@ -0,0 +1,340 @@
+#include "BlockCompressionService.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <zlib.h>
+
+#include "Base/ParallelService.h"
+
+namespace
+{
+    char const ContainerMarker[8] = {'A', 'L', 'I', 'E', 'N', 'B', 'L', 'K'};
+    uint32_t constexpr FormatVersion = 2;
+
+    //version 1 stores the total size and the number of blocks in the header followed by the complete block index in front of the blocks
+    uint32_t constexpr FormatVersionWithLeadingIndex = 1;
+
+    struct ContainerHeader
+    {
+        char marker[8];
+        uint32_t formatVersion;
+        uint32_t codec;
+    };
+
+    struct LeadingIndexHeader
+    {
+        uint64_t uncompressedSize;
+        uint64_t numBlocks;
+    };
+
+    //an entry with uncompressedSize == 0 terminates the container
+    struct BlockIndexEntry
+    {
+        uint64_t compressedSize;
+        uint64_t uncompressedSize;
+    };
+
+    void writeHeader(std::ostream& stream, CompressionCodec codec)
+    {
+        ContainerHeader header;
+        std::memcpy(header.marker, ContainerMarker, sizeof(ContainerMarker));
+        header.formatVersion = FormatVersion;
+        header.codec = codec;
+        stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    }
+
+    void writeBlock(std::ostream& stream, uint64_t uncompressedSize, std::vector<char> const& compressedData)
+    {
+        BlockIndexEntry entry{compressedData.size(), uncompressedSize};
+        stream.write(reinterpret_cast<char const*>(&entry), sizeof(entry));
+        stream.write(compressedData.data(), compressedData.size());
+        if (!stream) {
+            throw std::runtime_error("Could not write compressed data.");
+        }
+    }
+
+    std::vector<char> compressBlock(char const* source, uint64_t size, CompressionSettings const& settings)
+    {
+        switch (settings._codec) {
+        case CompressionCodec_None:
+            return std::vector<char>(source, source + size);
+        case CompressionCodec_Zlib: {
+            auto compressedSize = compressBound(static_cast<uLong>(size));
+            std::vector<char> result(compressedSize);
+            auto level = std::clamp(settings._level, Z_NO_COMPRESSION, Z_BEST_COMPRESSION);
+            if (compress2(
+                    reinterpret_cast<Bytef*>(result.data()), &compressedSize, reinterpret_cast<Bytef const*>(source), static_cast<uLong>(size), level)
+                != Z_OK) {
+                throw std::runtime_error("Compression failed.");
+            }
+            result.resize(compressedSize);
+            return result;
+        }
+        default:
+            throw std::runtime_error("Unknown compression codec.");
+        }
+    }
+
+    void decompressBlock(char* target, uint64_t targetSize, std::vector<char> const& source, CompressionCodec codec)
+    {
+        switch (codec) {
+        case CompressionCodec_None:
+            if (source.size() != targetSize) {
+                throw std::runtime_error("Invalid block size.");
+            }
+            std::memcpy(target, source.data(), targetSize);
+            return;
+        case CompressionCodec_Zlib: {
+            auto decompressedSize = static_cast<uLongf>(targetSize);
+            if (uncompress(reinterpret_cast<Bytef*>(target), &decompressedSize, reinterpret_cast<Bytef const*>(source.data()), static_cast<uLong>(source.size()))
+                    != Z_OK
+                || decompressedSize != targetSize) {
+                throw std::runtime_error("Decompression failed.");
+            }
+            return;
+        }
+        default:
+            throw std::runtime_error("Unknown compression codec.");
+        }
+    }
+
+    ContainerHeader readHeader(std::istream& stream)
+    {
+        ContainerHeader result;
+        stream.read(reinterpret_cast<char*>(&result), sizeof(result));
+        if (!stream || std::memcmp(result.marker, ContainerMarker, sizeof(ContainerMarker)) != 0) {
+            throw std::runtime_error("Invalid compression container.");
+        }
+        if (result.formatVersion < FormatVersionWithLeadingIndex || result.formatVersion > FormatVersion) {
+            throw std::runtime_error("Compression container version not supported.");
+        }
+        return result;
+    }
+
+    struct CompressedBlock
+    {
+        uint64_t uncompressedSize;
+        std::vector<char> data;
+    };
+
+    //reads blocks until maxNumBlocks is reached or the end of the container
+    std::vector<CompressedBlock> readBlocks(std::istream& stream, uint64_t maxNumBlocks)
+    {
+        std::vector<CompressedBlock> result;
+        while (result.size() < maxNumBlocks) {
+            BlockIndexEntry entry;
+            stream.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+            if (!stream) {
+                throw std::runtime_error("Compressed data is truncated.");
+            }
+            if (entry.uncompressedSize == 0) {
+                break;
+            }
+            std::vector<char> compressedBlock(entry.compressedSize);
+            stream.read(compressedBlock.data(), compressedBlock.size());
+            if (!stream) {
+                throw std::runtime_error("Compressed data is truncated.");
+            }
+            result.emplace_back(entry.uncompressedSize, std::move(compressedBlock));
+        }
+        return result;
+    }
+
+    std::vector<CompressedBlock> readBlocksWithLeadingIndex(std::istream& stream)
+    {
+        LeadingIndexHeader header;
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!stream) {
+            throw std::runtime_error("Compressed data is truncated.");
+        }
+        std::vector<CompressedBlock> result;
+        uint64_t uncompressedSize = 0;
+        for (uint64_t i = 0; i < header.numBlocks; ++i) {
+            BlockIndexEntry entry;
+            stream.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+            if (!stream) {
+                throw std::runtime_error("Compressed data is truncated.");
+            }
+            result.emplace_back(entry.uncompressedSize, std::vector<char>());
+            result.back().data.resize(entry.compressedSize);
+            uncompressedSize += entry.uncompressedSize;
+        }
+        if (uncompressedSize != header.uncompressedSize) {
+            throw std::runtime_error("Invalid compression container.");
+        }
+        for (auto& block : result) {
+            stream.read(block.data.data(), block.data.size());
+        }
+        if (!stream) {
+            throw std::runtime_error("Compressed data is truncated.");
+        }
+        return result;
+    }
+
+    void decompressInParallel(std::string& data, std::vector<CompressedBlock> const& blocks, CompressionCodec codec)
+    {
+        std::vector<uint64_t> uncompressedOffsets;
+        uint64_t uncompressedOffset = 0;
+        for (auto const& block : blocks) {
+            uncompressedOffsets.emplace_back(uncompressedOffset);
+            uncompressedOffset += block.uncompressedSize;
+        }
+
+        data.resize(uncompressedOffset);
+        ParallelService::forEach(blocks.size(), [&](uint64_t index) {
+            auto const& block = blocks.at(index);
+            decompressBlock(data.data() + uncompressedOffsets.at(index), block.uncompressedSize, block.data, codec);
+        });
+    }
+}
+
+void BlockCompressionService::compress(std::ostream& stream, std::string const& data, CompressionSettings const& settings)
+{
+    BlockCompressionOutputStream compressedStream(stream, settings);
+    compressedStream.write(data.data(), data.size());
+    compressedStream.finish();
+}
+
+void BlockCompressionService::decompress(std::string& data, std::istream& stream)
+{
+    auto header = readHeader(stream);
+    auto blocks = header.formatVersion == FormatVersionWithLeadingIndex ? readBlocksWithLeadingIndex(stream)
+                                                                        : readBlocks(stream, std::numeric_limits<uint64_t>::max());
+    decompressInParallel(data, blocks, header.codec);
+}
+
+void BlockCompressionService::decompressBlocks(std::string& data, std::istream& stream, uint64_t blockOffset, uint64_t numBlocks)
+{
+    auto containerPosition = stream.tellg();
+    auto header = readHeader(stream);
+    if (header.formatVersion == FormatVersionWithLeadingIndex) {
+        throw std::runtime_error("Compression container version does not support partial decompression.");
+    }
+    stream.seekg(containerPosition + static_cast<std::streamoff>(blockOffset));
+    auto blocks = readBlocks(stream, numBlocks);
+    if (blocks.size() != numBlocks) {
+        throw std::runtime_error("Compressed data is truncated.");
+    }
+    decompressInParallel(data, blocks, header.codec);
+}
+
+bool BlockCompressionService::isBlockCompressed(std::istream& stream)
+{
+    char marker[sizeof(ContainerMarker)];
+    auto position = stream.tellg();
+    stream.read(marker, sizeof(marker));
+    auto result = stream.gcount() == sizeof(marker) && std::memcmp(marker, ContainerMarker, sizeof(ContainerMarker)) == 0;
+    stream.clear();
+    stream.seekg(position);
+    return result;
+}
+
+BlockCompressionOutputStream::BlockCompressionOutputStream(std::ostream& target, CompressionSettings const& settings)
+    : std::ostream(nullptr)
+    , _buffer(target, settings)
+{
+    rdbuf(&_buffer);
+    writeHeader(target, settings._codec);
+}
+
+BlockCompressionOutputStream::~BlockCompressionOutputStream() = default;
+
+void BlockCompressionOutputStream::finish()
+{
+    if (_finished) {
+        return;
+    }
+    _finished = true;
+    if (!*this) {
+        throw std::runtime_error("Could not compress data.");
+    }
+    _buffer.submitBlock();
+    _buffer.writeFinishedBlocks(0);
+    writeBlock(_buffer.getTarget(), 0, {});
+}
+
+uint64_t BlockCompressionOutputStream::startNewBlock()
+{
+    _buffer.submitBlock();
+    return _buffer.getNumSubmittedBlocks();
+}
+
+std::vector<uint64_t> const& BlockCompressionOutputStream::getBlockOffsets() const
+{
+    return _buffer.getBlockOffsets();
+}
+
+BlockCompressionOutputStream::Buffer::Buffer(std::ostream& target, CompressionSettings const& settings)
+    : _target(target)
+    , _settings(settings)
+    , _maxPendingBlocks(static_cast<size_t>(ParallelService::getNumThreads()))
+    , _block(std::max(uint64_t(1), settings._blockSize))
+    , _writtenSize(sizeof(ContainerHeader))
+{
+    _settings._blockSize = _block.size();
+    setp(_block.data(), _block.data() + _block.size());
+}
+
+void BlockCompressionOutputStream::Buffer::submitBlock()
+{
+    auto uncompressedSize = static_cast<uint64_t>(pptr() - pbase());
+    if (uncompressedSize == 0) {
+        return;
+    }
+    std::vector<char> block(_settings._blockSize);
+    block.swap(_block);
+    setp(_block.data(), _block.data() + _block.size());
+
+    block.resize(uncompressedSize);
+    auto compressedData = ParallelService::async([block = std::move(block), settings = _settings] {
+        return compressBlock(block.data(), block.size(), settings);
+    });
+    _pendingBlocks.emplace_back(uncompressedSize, std::move(compressedData));
+    ++_numSubmittedBlocks;
+    writeFinishedBlocks(_maxPendingBlocks);
+}
+
+void BlockCompressionOutputStream::Buffer::writeFinishedBlocks(size_t maxPendingBlocks)
+{
+    while (_pendingBlocks.size() > maxPendingBlocks) {
+        auto pendingBlock = std::move(_pendingBlocks.front());
+        _pendingBlocks.pop_front();
+        auto compressedData = pendingBlock.compressedData.get();
+        writeBlock(_target, pendingBlock.uncompressedSize, compressedData);
+        _blockOffsets.emplace_back(_writtenSize);
+        _writtenSize += sizeof(BlockIndexEntry) + compressedData.size();
+    }
+}
+
+std::ostream& BlockCompressionOutputStream::Buffer::getTarget() const
+{
+    return _target;
+}
+
+uint64_t BlockCompressionOutputStream::Buffer::getNumSubmittedBlocks() const
+{
+    return _numSubmittedBlocks;
+}
+
+std::vector<uint64_t> const& BlockCompressionOutputStream::Buffer::getBlockOffsets() const
+{
+    return _blockOffsets;
+}
+
+auto BlockCompressionOutputStream::Buffer::overflow(int_type ch) -> int_type
+{
+    try {
+        submitBlock();
+    } catch (...) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
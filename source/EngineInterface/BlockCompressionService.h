@@ -0,0 +1,98 @@
+#pragma once
+
+#include <deque>
+#include <future>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "Base/Definitions.h"
+
+using CompressionCodec = int;
+enum CompressionCodec_
+{
+    CompressionCodec_None,
+    CompressionCodec_Zlib,
+    CompressionCodec_Count
+};
+
+struct CompressionSettings
+{
+    MEMBER_DECLARATION(CompressionSettings, CompressionCodec, codec, CompressionCodec_Zlib);
+    MEMBER_DECLARATION(CompressionSettings, int, level, 6);
+    MEMBER_DECLARATION(CompressionSettings, uint64_t, blockSize, 4 * 1024 * 1024);
+};
+
+//container of independently compressed blocks, each block is preceded by its index entry (compressed and uncompressed size)
+//blocks are compressed and decompressed in parallel
+class BlockCompressionService
+{
+public:
+    static void compress(std::ostream& stream, std::string const& data, CompressionSettings const& settings);
+    static void decompress(std::string& data, std::istream& stream);
+
+    //containers of format version 1 with a leading block index are still readable but do not support partial decompression
+    //decompresses numBlocks consecutive blocks, the stream has to be positioned at the start of the container
+    //blockOffset is relative to the start of the container (see BlockCompressionOutputStream::getBlockOffsets)
+    static void decompressBlocks(std::string& data, std::istream& stream, uint64_t blockOffset, uint64_t numBlocks);
+
+    //checks the container marker and restores the stream position
+    static bool isBlockCompressed(std::istream& stream);
+};
+
+//writes a block container incrementally: filled blocks are compressed on worker threads while the caller continues writing
+//the number of blocks in flight is bounded so that memory usage does not depend on the total data size
+class BlockCompressionOutputStream : public std::ostream
+{
+public:
+    BlockCompressionOutputStream(std::ostream& target, CompressionSettings const& settings);
+    ~BlockCompressionOutputStream() override;
+
+    //writes the remaining blocks and the end of the container, errors from worker threads are rethrown
+    //a container which is not finished lacks its end entry and is rejected on decompression
+    void finish();
+
+    //completes the current block such that subsequent data starts in a new block, returns the index of that block
+    //data between two calls can thus be decompressed independently of the rest of the container
+    uint64_t startNewBlock();
+
+    //offsets of the blocks relative to the start of the container, complete after finish()
+    std::vector<uint64_t> const& getBlockOffsets() const;
+
+private:
+    class Buffer : public std::streambuf
+    {
+    public:
+        Buffer(std::ostream& target, CompressionSettings const& settings);
+
+        void submitBlock();
+        void writeFinishedBlocks(size_t maxPendingBlocks);
+        std::ostream& getTarget() const;
+        uint64_t getNumSubmittedBlocks() const;
+        std::vector<uint64_t> const& getBlockOffsets() const;
+
+    protected:
+        int_type overflow(int_type ch) override;
+
+    private:
+        std::ostream& _target;
+        CompressionSettings _settings;
+        size_t _maxPendingBlocks = 1;
+        std::vector<char> _block;
+
+        struct PendingBlock
+        {
+            uint64_t uncompressedSize;
+            std::future<std::vector<char>> compressedData;
+        };
+        std::deque<PendingBlock> _pendingBlocks;
+        uint64_t _numSubmittedBlocks = 0;
+        uint64_t _writtenSize = 0;
+        std::vector<uint64_t> _blockOffsets;
+    };
+
+    Buffer _buffer;
+    bool _finished = false;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <optional>
+
+#include "Descriptions.h"
+
+//provides simulation data in chunks of complete clusters so that large worlds can be processed with bounded memory
+//particles are provided after all clusters
+class _ClusteredDataReader
+{
+public:
+    virtual ~_ClusteredDataReader() = default;
+
+    //returns std::nullopt when all data has been read
+    virtual std::optional<ClusteredDataDescription> readNextChunk() = 0;
+};
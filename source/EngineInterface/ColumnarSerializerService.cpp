@@ -0,0 +1,822 @@
+#include "ColumnarSerializerService.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/vector.hpp>
+
+#include "GenomeDescriptionService.h"
+#include "GenomePool.h"
+
+static_assert(std::endian::native == std::endian::little, "Column data is stored in little-endian byte order.");
+
+std::string const ColumnarSerializerService::FormatMarker = "alien.columnar";
+
+namespace
+{
+    //block and column ids must never be changed or reused, new fields get new ids
+    auto constexpr Block_Clusters = 0;
+    auto constexpr Block_Cells = 1;
+    auto constexpr Block_Connections = 2;
+    auto constexpr Block_Particles = 3;
+    auto constexpr Block_Neurons = 4;
+    auto constexpr Block_Transmitters = 5;
+    auto constexpr Block_Constructors = 6;
+    auto constexpr Block_Sensors = 7;
+    auto constexpr Block_Nerves = 8;
+    auto constexpr Block_Attackers = 9;
+    auto constexpr Block_Injectors = 10;
+    auto constexpr Block_Muscles = 11;
+    auto constexpr Block_Defenders = 12;
+    auto constexpr Block_Reconnectors = 13;
+    auto constexpr Block_Detonators = 14;
+    auto constexpr Block_Genomes = 15;
+
+    auto constexpr Column_Cluster_NumCells = 0;
+
+    auto constexpr Column_Cell_Id = 0;
+    auto constexpr Column_Cell_NumConnections = 1;
+    auto constexpr Column_Cell_PosX = 2;
+    auto constexpr Column_Cell_PosY = 3;
+    auto constexpr Column_Cell_VelX = 4;
+    auto constexpr Column_Cell_VelY = 5;
+    auto constexpr Column_Cell_Energy = 6;
+    auto constexpr Column_Cell_Stiffness = 7;
+    auto constexpr Column_Cell_Color = 8;
+    auto constexpr Column_Cell_MaxConnections = 9;
+    auto constexpr Column_Cell_Barrier = 10;
+    auto constexpr Column_Cell_Age = 11;
+    auto constexpr Column_Cell_LivingState = 12;
+    auto constexpr Column_Cell_CreatureId = 13;
+    auto constexpr Column_Cell_MutationId = 14;
+    auto constexpr Column_Cell_AncestorMutationId = 15;
+    auto constexpr Column_Cell_GenomeComplexity = 16;
+    auto constexpr Column_Cell_ExecutionOrderNumber = 17;
+    auto constexpr Column_Cell_HasInputExecutionOrderNumber = 18;
+    auto constexpr Column_Cell_InputExecutionOrderNumber = 19;
+    auto constexpr Column_Cell_OutputBlocked = 20;
+    auto constexpr Column_Cell_CellFunction = 21;
+    auto constexpr Column_Cell_ActivityChannels = 22;
+    auto constexpr Column_Cell_ActivityOrigin = 23;
+    auto constexpr Column_Cell_ActivityTargetX = 24;
+    auto constexpr Column_Cell_ActivityTargetY = 25;
+    auto constexpr Column_Cell_ActivationTime = 26;
+    auto constexpr Column_Cell_DetectedByCreatureId = 27;
+    auto constexpr Column_Cell_CellFunctionUsed = 28;
+    auto constexpr Column_Cell_MetadataNameSize = 29;
+    auto constexpr Column_Cell_MetadataName = 30;
+    auto constexpr Column_Cell_MetadataDescriptionSize = 31;
+    auto constexpr Column_Cell_MetadataDescription = 32;
+
+    auto constexpr Column_Connection_CellId = 0;
+    auto constexpr Column_Connection_Distance = 1;
+    auto constexpr Column_Connection_AngleFromPrevious = 2;
+
+    auto constexpr Column_Particle_Id = 0;
+    auto constexpr Column_Particle_PosX = 1;
+    auto constexpr Column_Particle_PosY = 2;
+    auto constexpr Column_Particle_VelX = 3;
+    auto constexpr Column_Particle_VelY = 4;
+    auto constexpr Column_Particle_Energy = 5;
+    auto constexpr Column_Particle_Color = 6;
+
+    auto constexpr Column_Neuron_Weights = 0;
+    auto constexpr Column_Neuron_Biases = 1;
+    auto constexpr Column_Neuron_ActivationFunctions = 2;
+
+    auto constexpr Column_Transmitter_Mode = 0;
+
+    auto constexpr Column_Constructor_ActivationMode = 0;
+    auto constexpr Column_Constructor_ConstructionActivationTime = 1;
+    auto constexpr Column_Constructor_GenomeSize = 2;
+    auto constexpr Column_Constructor_Genome = 3;
+    auto constexpr Column_Constructor_NumInheritedGenomeNodes = 4;
+    auto constexpr Column_Constructor_GenomeGeneration = 5;
+    auto constexpr Column_Constructor_ConstructionAngle1 = 6;
+    auto constexpr Column_Constructor_ConstructionAngle2 = 7;
+    auto constexpr Column_Constructor_LastConstructedCellId = 8;
+    auto constexpr Column_Constructor_GenomeCurrentNodeIndex = 9;
+    auto constexpr Column_Constructor_GenomeCurrentRepetition = 10;
+    auto constexpr Column_Constructor_CurrentBranch = 11;
+    auto constexpr Column_Constructor_OffspringCreatureId = 12;
+    auto constexpr Column_Constructor_OffspringMutationId = 13;
+    auto constexpr Column_Constructor_GenomeIndex = 14;
+
+    auto constexpr Column_Sensor_HasFixedAngle = 0;
+    auto constexpr Column_Sensor_FixedAngle = 1;
+    auto constexpr Column_Sensor_MinDensity = 2;
+    auto constexpr Column_Sensor_HasMinRange = 3;
+    auto constexpr Column_Sensor_MinRange = 4;
+    auto constexpr Column_Sensor_HasMaxRange = 5;
+    auto constexpr Column_Sensor_MaxRange = 6;
+    auto constexpr Column_Sensor_HasRestrictToColor = 7;
+    auto constexpr Column_Sensor_RestrictToColor = 8;
+    auto constexpr Column_Sensor_RestrictToMutants = 9;
+    auto constexpr Column_Sensor_MemoryChannel1 = 10;
+    auto constexpr Column_Sensor_MemoryChannel2 = 11;
+    auto constexpr Column_Sensor_MemoryChannel3 = 12;
+    auto constexpr Column_Sensor_MemoryTargetX = 13;
+    auto constexpr Column_Sensor_MemoryTargetY = 14;
+
+    auto constexpr Column_Nerve_PulseMode = 0;
+    auto constexpr Column_Nerve_AlternationMode = 1;
+
+    auto constexpr Column_Attacker_Mode = 0;
+
+    auto constexpr Column_Injector_Mode = 0;
+    auto constexpr Column_Injector_Counter = 1;
+    auto constexpr Column_Injector_GenomeSize = 2;
+    auto constexpr Column_Injector_Genome = 3;
+    auto constexpr Column_Injector_GenomeGeneration = 4;
+    auto constexpr Column_Injector_GenomeIndex = 5;
+
+    auto constexpr Column_Muscle_Mode = 0;
+    auto constexpr Column_Muscle_LastBendingDirection = 1;
+    auto constexpr Column_Muscle_LastBendingSourceIndex = 2;
+    auto constexpr Column_Muscle_ConsecutiveBendingAngle = 3;
+    auto constexpr Column_Muscle_LastMovementX = 4;
+    auto constexpr Column_Muscle_LastMovementY = 5;
+
+    auto constexpr Column_Defender_Mode = 0;
+
+    auto constexpr Column_Reconnector_HasRestrictToColor = 0;
+    auto constexpr Column_Reconnector_RestrictToColor = 1;
+    auto constexpr Column_Reconnector_RestrictToMutants = 2;
+
+    auto constexpr Column_Detonator_State = 0;
+    auto constexpr Column_Detonator_Countdown = 1;
+
+    auto constexpr Column_Genome_Size = 0;
+    auto constexpr Column_Genome_Data = 1;
+    auto constexpr Column_Genome_EncodingVersion = 2;
+
+    enum class SerializationTask
+    {
+        Load,
+        Save
+    };
+
+    struct ColumnBlock
+    {
+        uint32_t type = 0;
+        uint64_t numRows = 0;
+        std::vector<uint32_t> columnIds;  //field-presence table
+        std::vector<std::vector<uint8_t>> columns;
+
+        template <class Archive>
+        void serialize(Archive& ar)
+        {
+            ar(type, numRows, columnIds, columns);
+        }
+    };
+
+    std::vector<uint8_t> const* findColumn(ColumnBlock const& block, uint32_t columnId)
+    {
+        for (size_t i = 0; i < block.columnIds.size(); ++i) {
+            if (block.columnIds.at(i) == columnId) {
+                return &block.columns.at(i);
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T, int Stride, typename Object, typename Getter>
+    void saveColumn(ColumnBlock& block, uint32_t columnId, std::vector<Object*> const& objects, Getter const& getter)
+    {
+        std::vector<uint8_t> column(objects.size() * sizeof(T) * Stride);
+        auto target = column.data();
+        for (auto const& object : objects) {
+            for (int i = 0; i < Stride; ++i) {
+                auto value = static_cast<T>(getter(*object, i));
+                std::memcpy(target, &value, sizeof(T));
+                target += sizeof(T);
+            }
+        }
+        block.columnIds.emplace_back(columnId);
+        block.columns.emplace_back(std::move(column));
+    }
+
+    template <typename T, int Stride, typename Object, typename Setter>
+    void loadColumn(ColumnBlock const& block, uint32_t columnId, std::vector<Object*> const& objects, Setter const& setter)
+    {
+        auto column = findColumn(block, columnId);
+        if (!column) {
+            return;
+        }
+        if (column->size() != objects.size() * sizeof(T) * Stride) {
+            throw std::runtime_error("Unexpected column size.");
+        }
+        auto source = column->data();
+        for (auto const& object : objects) {
+            for (int i = 0; i < Stride; ++i) {
+                T value;
+                std::memcpy(&value, source, sizeof(T));
+                setter(*object, i, value);
+                source += sizeof(T);
+            }
+        }
+    }
+
+    template <int Stride, typename Object, typename Accessor>
+    void loadSaveArrayColumn(SerializationTask task, ColumnBlock& block, uint32_t columnId, std::vector<Object*> const& objects, Accessor const& accessor)
+    {
+        using Value = std::remove_cvref_t<decltype(accessor(std::declval<Object&>(), 0))>;
+        using StoredValue = std::conditional_t<std::is_same_v<Value, bool>, uint8_t, Value>;
+        if (task == SerializationTask::Save) {
+            saveColumn<StoredValue, Stride>(block, columnId, objects, accessor);
+        } else {
+            loadColumn<StoredValue, Stride>(
+                block, columnId, objects, [&](Object& object, int index, StoredValue value) { accessor(object, index) = static_cast<Value>(value); });
+        }
+    }
+
+    template <typename Object, typename Accessor>
+    void loadSaveColumn(SerializationTask task, ColumnBlock& block, uint32_t columnId, std::vector<Object*> const& objects, Accessor const& accessor)
+    {
+        loadSaveArrayColumn<1>(task, block, columnId, objects, [&](Object& object, int) -> auto& { return accessor(object); });
+    }
+
+    template <typename Object, typename Accessor>
+    void loadSaveOptionalColumns(
+        SerializationTask task,
+        ColumnBlock& block,
+        uint32_t presenceColumnId,
+        uint32_t valueColumnId,
+        std::vector<Object*> const& objects,
+        Accessor const& accessor)
+    {
+        using Value = typename std::remove_cvref_t<decltype(accessor(std::declval<Object&>()))>::value_type;
+        if (task == SerializationTask::Save) {
+            saveColumn<uint8_t, 1>(block, presenceColumnId, objects, [&](Object& object, int) { return accessor(object).has_value(); });
+            saveColumn<Value, 1>(block, valueColumnId, objects, [&](Object& object, int) { return accessor(object).value_or(Value()); });
+        } else {
+            loadColumn<Value, 1>(block, valueColumnId, objects, [&](Object& object, int, Value value) { accessor(object) = value; });
+            loadColumn<uint8_t, 1>(block, presenceColumnId, objects, [&](Object& object, int, uint8_t hasValue) {
+                if (hasValue == 0) {
+                    accessor(object).reset();
+                }
+            });
+        }
+    }
+
+    //stores the size of a container, on load the container is resized accordingly
+    template <typename Object, typename Accessor>
+    void loadSaveSizeColumn(SerializationTask task, ColumnBlock& block, uint32_t columnId, std::vector<Object*> const& objects, Accessor const& accessor)
+    {
+        if (task == SerializationTask::Save) {
+            saveColumn<uint32_t, 1>(block, columnId, objects, [&](Object& object, int) { return accessor(object).size(); });
+        } else {
+            loadColumn<uint32_t, 1>(block, columnId, objects, [&](Object& object, int, uint32_t size) { accessor(object).resize(size); });
+        }
+    }
+
+    //stores byte containers (strings, genomes) as a size column and a concatenated payload column
+    template <typename Object, typename Accessor>
+    void loadSaveBytesColumns(
+        SerializationTask task,
+        ColumnBlock& block,
+        uint32_t sizeColumnId,
+        uint32_t dataColumnId,
+        std::vector<Object*> const& objects,
+        Accessor const& accessor)
+    {
+        loadSaveSizeColumn(task, block, sizeColumnId, objects, accessor);
+        if (task == SerializationTask::Save) {
+            size_t totalSize = 0;
+            for (auto const& object : objects) {
+                totalSize += accessor(*object).size();
+            }
+            std::vector<uint8_t> column(totalSize);
+            auto target = column.data();
+            for (auto const& object : objects) {
+                auto const& bytes = accessor(*object);
+                if (!bytes.empty()) {
+                    std::memcpy(target, bytes.data(), bytes.size());
+                    target += bytes.size();
+                }
+            }
+            block.columnIds.emplace_back(dataColumnId);
+            block.columns.emplace_back(std::move(column));
+        } else {
+            auto column = findColumn(block, dataColumnId);
+            if (!column) {
+                return;
+            }
+            size_t totalSize = 0;
+            for (auto const& object : objects) {
+                totalSize += accessor(*object).size();
+            }
+            if (column->size() != totalSize) {
+                throw std::runtime_error("Unexpected column size.");
+            }
+            auto source = column->data();
+            for (auto const& object : objects) {
+                auto& bytes = accessor(*object);
+                if (!bytes.empty()) {
+                    std::memcpy(bytes.data(), source, bytes.size());
+                    source += bytes.size();
+                }
+            }
+        }
+    }
+
+    //genomes of a chunk are stored once in the genome block, constructors and injectors reference them by index
+    struct GenomeTable
+    {
+        GenomePool pool;                            //filled on save
+        std::vector<std::vector<uint8_t>> genomes;  //filled on load
+    };
+
+    template <typename Object, typename Accessor>
+    void loadSaveGenomeIndexColumn(
+        SerializationTask task,
+        ColumnBlock& block,
+        uint32_t columnId,
+        GenomeTable& genomeTable,
+        std::vector<Object*> const& objects,
+        Accessor const& accessor)
+    {
+        if (task == SerializationTask::Save) {
+            saveColumn<uint32_t, 1>(block, columnId, objects, [&](Object& object, int) { return genomeTable.pool.add(accessor(object)); });
+        } else {
+            loadColumn<uint32_t, 1>(block, columnId, objects, [&](Object& object, int, uint32_t genomeIndex) {
+                if (genomeIndex >= genomeTable.genomes.size()) {
+                    throw std::runtime_error("Invalid genome index.");
+                }
+                accessor(object) = genomeTable.genomes[genomeIndex];
+            });
+        }
+    }
+
+    template <typename Processor>
+    void loadSaveBlock(SerializationTask task, std::vector<ColumnBlock>& blocks, uint32_t type, size_t numRows, Processor const& processor)
+    {
+        if (task == SerializationTask::Save) {
+            ColumnBlock block;
+            block.type = type;
+            block.numRows = numRows;
+            processor(block);
+            blocks.emplace_back(std::move(block));
+        } else {
+            for (auto& block : blocks) {
+                if (block.type == type) {
+                    if (block.numRows != numRows) {
+                        throw std::runtime_error("Unexpected number of rows in column block.");
+                    }
+                    processor(block);
+                    return;
+                }
+            }
+            //block not present => objects keep their default values
+        }
+    }
+
+    size_t getNumRows(std::vector<ColumnBlock> const& blocks, uint32_t type)
+    {
+        for (auto const& block : blocks) {
+            if (block.type == type) {
+                return block.numRows;
+            }
+        }
+        return 0;
+    }
+
+    template <typename T>
+    std::vector<T*> getPointers(std::vector<T>& objects)
+    {
+        std::vector<T*> result;
+        result.reserve(objects.size());
+        for (auto& object : objects) {
+            result.emplace_back(&object);
+        }
+        return result;
+    }
+
+    template <typename CellFunctionDesc>
+    std::vector<CellFunctionDesc*> getCellFunctions(std::vector<CellDescription*> const& cells)
+    {
+        std::vector<CellFunctionDesc*> result;
+        for (auto const& cell : cells) {
+            if (cell->cellFunction && std::holds_alternative<CellFunctionDesc>(*cell->cellFunction)) {
+                result.emplace_back(&std::get<CellFunctionDesc>(*cell->cellFunction));
+            }
+        }
+        return result;
+    }
+
+    CellFunctionDescription createCellFunction(CellFunction cellFunction)
+    {
+        switch (cellFunction) {
+        case CellFunction_Neuron:
+            return NeuronDescription();
+        case CellFunction_Transmitter:
+            return TransmitterDescription();
+        case CellFunction_Constructor:
+            return ConstructorDescription();
+        case CellFunction_Sensor:
+            return SensorDescription();
+        case CellFunction_Nerve:
+            return NerveDescription();
+        case CellFunction_Attacker:
+            return AttackerDescription();
+        case CellFunction_Injector:
+            return InjectorDescription();
+        case CellFunction_Muscle:
+            return MuscleDescription();
+        case CellFunction_Defender:
+            return DefenderDescription();
+        case CellFunction_Reconnector:
+            return ReconnectorDescription();
+        case CellFunction_Detonator:
+            return DetonatorDescription();
+        default:
+            return std::nullopt;
+        }
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<CellDescription*> const& cells)
+    {
+        loadSaveColumn(task, block, Column_Cell_Id, cells, [](CellDescription& cell) -> auto& { return cell.id; });
+        loadSaveSizeColumn(task, block, Column_Cell_NumConnections, cells, [](CellDescription& cell) -> auto& { return cell.connections; });
+        loadSaveColumn(task, block, Column_Cell_PosX, cells, [](CellDescription& cell) -> auto& { return cell.pos.x; });
+        loadSaveColumn(task, block, Column_Cell_PosY, cells, [](CellDescription& cell) -> auto& { return cell.pos.y; });
+        loadSaveColumn(task, block, Column_Cell_VelX, cells, [](CellDescription& cell) -> auto& { return cell.vel.x; });
+        loadSaveColumn(task, block, Column_Cell_VelY, cells, [](CellDescription& cell) -> auto& { return cell.vel.y; });
+        loadSaveColumn(task, block, Column_Cell_Energy, cells, [](CellDescription& cell) -> auto& { return cell.energy; });
+        loadSaveColumn(task, block, Column_Cell_Stiffness, cells, [](CellDescription& cell) -> auto& { return cell.stiffness; });
+        loadSaveColumn(task, block, Column_Cell_Color, cells, [](CellDescription& cell) -> auto& { return cell.color; });
+        loadSaveColumn(task, block, Column_Cell_MaxConnections, cells, [](CellDescription& cell) -> auto& { return cell.maxConnections; });
+        loadSaveColumn(task, block, Column_Cell_Barrier, cells, [](CellDescription& cell) -> auto& { return cell.barrier; });
+        loadSaveColumn(task, block, Column_Cell_Age, cells, [](CellDescription& cell) -> auto& { return cell.age; });
+        loadSaveColumn(task, block, Column_Cell_LivingState, cells, [](CellDescription& cell) -> auto& { return cell.livingState; });
+        loadSaveColumn(task, block, Column_Cell_CreatureId, cells, [](CellDescription& cell) -> auto& { return cell.creatureId; });
+        loadSaveColumn(task, block, Column_Cell_MutationId, cells, [](CellDescription& cell) -> auto& { return cell.mutationId; });
+        loadSaveColumn(task, block, Column_Cell_AncestorMutationId, cells, [](CellDescription& cell) -> auto& { return cell.ancestorMutationId; });
+        loadSaveColumn(task, block, Column_Cell_GenomeComplexity, cells, [](CellDescription& cell) -> auto& { return cell.genomeComplexity; });
+        loadSaveColumn(task, block, Column_Cell_ExecutionOrderNumber, cells, [](CellDescription& cell) -> auto& { return cell.executionOrderNumber; });
+        loadSaveOptionalColumns(
+            task,
+            block,
+            Column_Cell_HasInputExecutionOrderNumber,
+            Column_Cell_InputExecutionOrderNumber,
+            cells,
+            [](CellDescription& cell) -> auto& { return cell.inputExecutionOrderNumber; });
+        loadSaveColumn(task, block, Column_Cell_OutputBlocked, cells, [](CellDescription& cell) -> auto& { return cell.outputBlocked; });
+        if (task == SerializationTask::Save) {
+            saveColumn<uint8_t, 1>(block, Column_Cell_CellFunction, cells, [](CellDescription& cell, int) { return cell.getCellFunctionType(); });
+        } else {
+            loadColumn<uint8_t, 1>(
+                block, Column_Cell_CellFunction, cells, [](CellDescription& cell, int, uint8_t cellFunction) { cell.cellFunction = createCellFunction(cellFunction); });
+        }
+        loadSaveArrayColumn<MAX_CHANNELS>(
+            task, block, Column_Cell_ActivityChannels, cells, [](CellDescription& cell, int index) -> auto& { return cell.activity.channels[index]; });
+        loadSaveColumn(task, block, Column_Cell_ActivityOrigin, cells, [](CellDescription& cell) -> auto& { return cell.activity.origin; });
+        loadSaveColumn(task, block, Column_Cell_ActivityTargetX, cells, [](CellDescription& cell) -> auto& { return cell.activity.targetX; });
+        loadSaveColumn(task, block, Column_Cell_ActivityTargetY, cells, [](CellDescription& cell) -> auto& { return cell.activity.targetY; });
+        loadSaveColumn(task, block, Column_Cell_ActivationTime, cells, [](CellDescription& cell) -> auto& { return cell.activationTime; });
+        loadSaveColumn(task, block, Column_Cell_DetectedByCreatureId, cells, [](CellDescription& cell) -> auto& { return cell.detectedByCreatureId; });
+        loadSaveColumn(task, block, Column_Cell_CellFunctionUsed, cells, [](CellDescription& cell) -> auto& { return cell.cellFunctionUsed; });
+        loadSaveBytesColumns(
+            task, block, Column_Cell_MetadataNameSize, Column_Cell_MetadataName, cells, [](CellDescription& cell) -> auto& { return cell.metadata.name; });
+        loadSaveBytesColumns(
+            task,
+            block,
+            Column_Cell_MetadataDescriptionSize,
+            Column_Cell_MetadataDescription,
+            cells,
+            [](CellDescription& cell) -> auto& { return cell.metadata.description; });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<ConnectionDescription*> const& connections)
+    {
+        loadSaveColumn(task, block, Column_Connection_CellId, connections, [](ConnectionDescription& connection) -> auto& { return connection.cellId; });
+        loadSaveColumn(task, block, Column_Connection_Distance, connections, [](ConnectionDescription& connection) -> auto& { return connection.distance; });
+        loadSaveColumn(
+            task,
+            block,
+            Column_Connection_AngleFromPrevious,
+            connections,
+            [](ConnectionDescription& connection) -> auto& { return connection.angleFromPrevious; });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<ParticleDescription*> const& particles)
+    {
+        loadSaveColumn(task, block, Column_Particle_Id, particles, [](ParticleDescription& particle) -> auto& { return particle.id; });
+        loadSaveColumn(task, block, Column_Particle_PosX, particles, [](ParticleDescription& particle) -> auto& { return particle.pos.x; });
+        loadSaveColumn(task, block, Column_Particle_PosY, particles, [](ParticleDescription& particle) -> auto& { return particle.pos.y; });
+        loadSaveColumn(task, block, Column_Particle_VelX, particles, [](ParticleDescription& particle) -> auto& { return particle.vel.x; });
+        loadSaveColumn(task, block, Column_Particle_VelY, particles, [](ParticleDescription& particle) -> auto& { return particle.vel.y; });
+        loadSaveColumn(task, block, Column_Particle_Energy, particles, [](ParticleDescription& particle) -> auto& { return particle.energy; });
+        loadSaveColumn(task, block, Column_Particle_Color, particles, [](ParticleDescription& particle) -> auto& { return particle.color; });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<NeuronDescription*> const& neurons)
+    {
+        loadSaveArrayColumn<MAX_CHANNELS * MAX_CHANNELS>(task, block, Column_Neuron_Weights, neurons, [](NeuronDescription& neuron, int index) -> auto& {
+            return neuron.weights[index / MAX_CHANNELS][index % MAX_CHANNELS];
+        });
+        loadSaveArrayColumn<MAX_CHANNELS>(
+            task, block, Column_Neuron_Biases, neurons, [](NeuronDescription& neuron, int index) -> auto& { return neuron.biases[index]; });
+        loadSaveArrayColumn<MAX_CHANNELS>(task, block, Column_Neuron_ActivationFunctions, neurons, [](NeuronDescription& neuron, int index) -> auto& {
+            return neuron.activationFunctions[index];
+        });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<TransmitterDescription*> const& transmitters)
+    {
+        loadSaveColumn(task, block, Column_Transmitter_Mode, transmitters, [](TransmitterDescription& transmitter) -> auto& { return transmitter.mode; });
+    }
+
+    //genomes are stored in their byte representation, see loadSaveGenomeBlock
+    void loadSave(SerializationTask task, ColumnBlock& block, GenomeTable& genomeTable, std::vector<ConstructorDescription*> const& constructors)
+    {
+        loadSaveColumn(
+            task, block, Column_Constructor_ActivationMode, constructors, [](ConstructorDescription& constructor) -> auto& { return constructor.activationMode; });
+        loadSaveColumn(task, block, Column_Constructor_ConstructionActivationTime, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.constructionActivationTime;
+        });
+        if (task == SerializationTask::Load) {
+            //compatibility with format version 2 where each constructor holds its own genome copy
+            loadSaveBytesColumns(task, block, Column_Constructor_GenomeSize, Column_Constructor_Genome, constructors, [](ConstructorDescription& constructor) -> auto& {
+                return constructor.genome;
+            });
+        }
+        loadSaveGenomeIndexColumn(task, block, Column_Constructor_GenomeIndex, genomeTable, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.genome;
+        });
+        loadSaveColumn(task, block, Column_Constructor_NumInheritedGenomeNodes, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.numInheritedGenomeNodes;
+        });
+        loadSaveColumn(task, block, Column_Constructor_GenomeGeneration, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.genomeGeneration;
+        });
+        loadSaveColumn(task, block, Column_Constructor_ConstructionAngle1, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.constructionAngle1;
+        });
+        loadSaveColumn(task, block, Column_Constructor_ConstructionAngle2, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.constructionAngle2;
+        });
+        loadSaveColumn(task, block, Column_Constructor_LastConstructedCellId, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.lastConstructedCellId;
+        });
+        loadSaveColumn(task, block, Column_Constructor_GenomeCurrentNodeIndex, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.genomeCurrentNodeIndex;
+        });
+        loadSaveColumn(task, block, Column_Constructor_GenomeCurrentRepetition, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.genomeCurrentRepetition;
+        });
+        loadSaveColumn(
+            task, block, Column_Constructor_CurrentBranch, constructors, [](ConstructorDescription& constructor) -> auto& { return constructor.currentBranch; });
+        loadSaveColumn(task, block, Column_Constructor_OffspringCreatureId, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.offspringCreatureId;
+        });
+        loadSaveColumn(task, block, Column_Constructor_OffspringMutationId, constructors, [](ConstructorDescription& constructor) -> auto& {
+            return constructor.offspringMutationId;
+        });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<SensorDescription*> const& sensors)
+    {
+        loadSaveOptionalColumns(
+            task, block, Column_Sensor_HasFixedAngle, Column_Sensor_FixedAngle, sensors, [](SensorDescription& sensor) -> auto& { return sensor.fixedAngle; });
+        loadSaveColumn(task, block, Column_Sensor_MinDensity, sensors, [](SensorDescription& sensor) -> auto& { return sensor.minDensity; });
+        loadSaveOptionalColumns(
+            task, block, Column_Sensor_HasMinRange, Column_Sensor_MinRange, sensors, [](SensorDescription& sensor) -> auto& { return sensor.minRange; });
+        loadSaveOptionalColumns(
+            task, block, Column_Sensor_HasMaxRange, Column_Sensor_MaxRange, sensors, [](SensorDescription& sensor) -> auto& { return sensor.maxRange; });
+        loadSaveOptionalColumns(task, block, Column_Sensor_HasRestrictToColor, Column_Sensor_RestrictToColor, sensors, [](SensorDescription& sensor) -> auto& {
+            return sensor.restrictToColor;
+        });
+        loadSaveColumn(task, block, Column_Sensor_RestrictToMutants, sensors, [](SensorDescription& sensor) -> auto& { return sensor.restrictToMutants; });
+        loadSaveColumn(task, block, Column_Sensor_MemoryChannel1, sensors, [](SensorDescription& sensor) -> auto& { return sensor.memoryChannel1; });
+        loadSaveColumn(task, block, Column_Sensor_MemoryChannel2, sensors, [](SensorDescription& sensor) -> auto& { return sensor.memoryChannel2; });
+        loadSaveColumn(task, block, Column_Sensor_MemoryChannel3, sensors, [](SensorDescription& sensor) -> auto& { return sensor.memoryChannel3; });
+        loadSaveColumn(task, block, Column_Sensor_MemoryTargetX, sensors, [](SensorDescription& sensor) -> auto& { return sensor.memoryTargetX; });
+        loadSaveColumn(task, block, Column_Sensor_MemoryTargetY, sensors, [](SensorDescription& sensor) -> auto& { return sensor.memoryTargetY; });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<NerveDescription*> const& nerves)
+    {
+        loadSaveColumn(task, block, Column_Nerve_PulseMode, nerves, [](NerveDescription& nerve) -> auto& { return nerve.pulseMode; });
+        loadSaveColumn(task, block, Column_Nerve_AlternationMode, nerves, [](NerveDescription& nerve) -> auto& { return nerve.alternationMode; });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<AttackerDescription*> const& attackers)
+    {
+        loadSaveColumn(task, block, Column_Attacker_Mode, attackers, [](AttackerDescription& attacker) -> auto& { return attacker.mode; });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, GenomeTable& genomeTable, std::vector<InjectorDescription*> const& injectors)
+    {
+        loadSaveColumn(task, block, Column_Injector_Mode, injectors, [](InjectorDescription& injector) -> auto& { return injector.mode; });
+        loadSaveColumn(task, block, Column_Injector_Counter, injectors, [](InjectorDescription& injector) -> auto& { return injector.counter; });
+        if (task == SerializationTask::Load) {
+            //compatibility with format version 2 where each injector holds its own genome copy
+            loadSaveBytesColumns(
+                task, block, Column_Injector_GenomeSize, Column_Injector_Genome, injectors, [](InjectorDescription& injector) -> auto& { return injector.genome; });
+        }
+        loadSaveGenomeIndexColumn(
+            task, block, Column_Injector_GenomeIndex, genomeTable, injectors, [](InjectorDescription& injector) -> auto& { return injector.genome; });
+        loadSaveColumn(
+            task, block, Column_Injector_GenomeGeneration, injectors, [](InjectorDescription& injector) -> auto& { return injector.genomeGeneration; });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<MuscleDescription*> const& muscles)
+    {
+        loadSaveColumn(task, block, Column_Muscle_Mode, muscles, [](MuscleDescription& muscle) -> auto& { return muscle.mode; });
+        loadSaveColumn(
+            task, block, Column_Muscle_LastBendingDirection, muscles, [](MuscleDescription& muscle) -> auto& { return muscle.lastBendingDirection; });
+        loadSaveColumn(
+            task, block, Column_Muscle_LastBendingSourceIndex, muscles, [](MuscleDescription& muscle) -> auto& { return muscle.lastBendingSourceIndex; });
+        loadSaveColumn(
+            task, block, Column_Muscle_ConsecutiveBendingAngle, muscles, [](MuscleDescription& muscle) -> auto& { return muscle.consecutiveBendingAngle; });
+        loadSaveColumn(task, block, Column_Muscle_LastMovementX, muscles, [](MuscleDescription& muscle) -> auto& { return muscle.lastMovementX; });
+        loadSaveColumn(task, block, Column_Muscle_LastMovementY, muscles, [](MuscleDescription& muscle) -> auto& { return muscle.lastMovementY; });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<DefenderDescription*> const& defenders)
+    {
+        loadSaveColumn(task, block, Column_Defender_Mode, defenders, [](DefenderDescription& defender) -> auto& { return defender.mode; });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<ReconnectorDescription*> const& reconnectors)
+    {
+        loadSaveOptionalColumns(
+            task,
+            block,
+            Column_Reconnector_HasRestrictToColor,
+            Column_Reconnector_RestrictToColor,
+            reconnectors,
+            [](ReconnectorDescription& reconnector) -> auto& { return reconnector.restrictToColor; });
+        loadSaveColumn(task, block, Column_Reconnector_RestrictToMutants, reconnectors, [](ReconnectorDescription& reconnector) -> auto& {
+            return reconnector.restrictToMutants;
+        });
+    }
+
+    void loadSave(SerializationTask task, ColumnBlock& block, std::vector<DetonatorDescription*> const& detonators)
+    {
+        loadSaveColumn(task, block, Column_Detonator_State, detonators, [](DetonatorDescription& detonator) -> auto& { return detonator.state; });
+        loadSaveColumn(task, block, Column_Detonator_Countdown, detonators, [](DetonatorDescription& detonator) -> auto& { return detonator.countdown; });
+    }
+
+    template <typename CellFunctionDesc>
+    void loadSaveCellFunctionBlock(SerializationTask task, std::vector<ColumnBlock>& blocks, uint32_t type, std::vector<CellDescription*> const& cells)
+    {
+        auto cellFunctions = getCellFunctions<CellFunctionDesc>(cells);
+        loadSaveBlock(task, blocks, type, cellFunctions.size(), [&](ColumnBlock& block) { loadSave(task, block, cellFunctions); });
+    }
+
+    template <typename CellFunctionDesc>
+    void loadSaveCellFunctionBlock(
+        SerializationTask task,
+        std::vector<ColumnBlock>& blocks,
+        uint32_t type,
+        GenomeTable& genomeTable,
+        std::vector<CellDescription*> const& cells)
+    {
+        auto cellFunctions = getCellFunctions<CellFunctionDesc>(cells);
+        loadSaveBlock(task, blocks, type, cellFunctions.size(), [&](ColumnBlock& block) { loadSave(task, block, genomeTable, cellFunctions); });
+    }
+
+    //each genome is stored with the version of its byte encoding and converted to the current encoding on load
+    //genomes without version are written before the version was introduced and therefore have encoding version 2
+    void loadSaveGenomeBlock(SerializationTask task, std::vector<ColumnBlock>& blocks, GenomeTable& genomeTable)
+    {
+        std::vector<std::vector<uint8_t>*> genomes;
+        if (task == SerializationTask::Save) {
+            //genomes are only read on save
+            for (auto const& genome : genomeTable.pool.getGenomes()) {
+                genomes.emplace_back(const_cast<std::vector<uint8_t>*>(&genome));
+            }
+        } else {
+            genomeTable.genomes.resize(getNumRows(blocks, Block_Genomes));
+            genomes = getPointers(genomeTable.genomes);
+        }
+        std::vector<uint32_t> encodingVersions(genomes.size(), 2);
+        if (task == SerializationTask::Save) {
+            std::fill(encodingVersions.begin(), encodingVersions.end(), GenomeDescriptionService::EncodingVersion);
+        }
+        auto encodingVersionPointers = getPointers(encodingVersions);
+        loadSaveBlock(task, blocks, Block_Genomes, genomes.size(), [&](ColumnBlock& block) {
+            loadSaveBytesColumns(task, block, Column_Genome_Size, Column_Genome_Data, genomes, [](std::vector<uint8_t>& genome) -> auto& { return genome; });
+            loadSaveColumn(task, block, Column_Genome_EncodingVersion, encodingVersionPointers, [](uint32_t& encodingVersion) -> auto& { return encodingVersion; });
+        });
+        if (task == SerializationTask::Load) {
+            for (size_t i = 0; i < genomes.size(); ++i) {
+                if (encodingVersions.at(i) != GenomeDescriptionService::EncodingVersion) {
+                    *genomes.at(i) = GenomeDescriptionService::convertToCurrentEncoding(*genomes.at(i), encodingVersions.at(i));
+                }
+            }
+        }
+    }
+
+    void loadSave(SerializationTask task, std::vector<ColumnBlock>& blocks, ClusteredDataDescription& data)
+    {
+        if (task == SerializationTask::Load) {
+            data.clusters.resize(getNumRows(blocks, Block_Clusters));
+            data.particles.resize(getNumRows(blocks, Block_Particles));
+        }
+
+        auto clusters = getPointers(data.clusters);
+        loadSaveBlock(task, blocks, Block_Clusters, clusters.size(), [&](ColumnBlock& block) {
+            loadSaveSizeColumn(task, block, Column_Cluster_NumCells, clusters, [](ClusterDescription& cluster) -> auto& { return cluster.cells; });
+        });
+
+        std::vector<CellDescription*> cells;
+        for (auto& cluster : data.clusters) {
+            for (auto& cell : cluster.cells) {
+                cells.emplace_back(&cell);
+            }
+        }
+        loadSaveBlock(task, blocks, Block_Cells, cells.size(), [&](ColumnBlock& block) { loadSave(task, block, cells); });
+
+        std::vector<ConnectionDescription*> connections;
+        for (auto const& cell : cells) {
+            for (auto& connection : cell->connections) {
+                connections.emplace_back(&connection);
+            }
+        }
+        loadSaveBlock(task, blocks, Block_Connections, connections.size(), [&](ColumnBlock& block) { loadSave(task, block, connections); });
+
+        auto particles = getPointers(data.particles);
+        loadSaveBlock(task, blocks, Block_Particles, particles.size(), [&](ColumnBlock& block) { loadSave(task, block, particles); });
+
+        GenomeTable genomeTable;
+        if (task == SerializationTask::Load) {
+            loadSaveGenomeBlock(task, blocks, genomeTable);
+        }
+        loadSaveCellFunctionBlock<NeuronDescription>(task, blocks, Block_Neurons, cells);
+        loadSaveCellFunctionBlock<TransmitterDescription>(task, blocks, Block_Transmitters, cells);
+        loadSaveCellFunctionBlock<ConstructorDescription>(task, blocks, Block_Constructors, genomeTable, cells);
+        loadSaveCellFunctionBlock<SensorDescription>(task, blocks, Block_Sensors, cells);
+        loadSaveCellFunctionBlock<NerveDescription>(task, blocks, Block_Nerves, cells);
+        loadSaveCellFunctionBlock<AttackerDescription>(task, blocks, Block_Attackers, cells);
+        loadSaveCellFunctionBlock<InjectorDescription>(task, blocks, Block_Injectors, genomeTable, cells);
+        loadSaveCellFunctionBlock<MuscleDescription>(task, blocks, Block_Muscles, cells);
+        loadSaveCellFunctionBlock<DefenderDescription>(task, blocks, Block_Defenders, cells);
+        loadSaveCellFunctionBlock<ReconnectorDescription>(task, blocks, Block_Reconnectors, cells);
+        loadSaveCellFunctionBlock<DetonatorDescription>(task, blocks, Block_Detonators, cells);
+        if (task == SerializationTask::Save) {
+            loadSaveGenomeBlock(task, blocks, genomeTable);
+        }
+    }
+}
+
+void ColumnarSerializerService::serialize(cereal::PortableBinaryOutputArchive& archive, ClusteredDataDescription const& data)
+{
+    serializeChunk(archive, data);
+    serializeEnd(archive);
+}
+
+void ColumnarSerializerService::serializeChunk(cereal::PortableBinaryOutputArchive& archive, ClusteredDataDescription const& chunk)
+{
+    std::vector<ColumnBlock> blocks;
+    loadSave(SerializationTask::Save, blocks, const_cast<ClusteredDataDescription&>(chunk));
+    archive(true);
+    archive(blocks);
+}
+
+void ColumnarSerializerService::serializeEnd(cereal::PortableBinaryOutputArchive& archive)
+{
+    archive(false);
+}
+
+void ColumnarSerializerService::deserialize(ClusteredDataDescription& data, cereal::PortableBinaryInputArchive& archive, uint32_t formatVersion)
+{
+    data.clear();
+
+    //compatibility with older versions
+    //>>>
+    if (formatVersion < 2) {
+        std::vector<ColumnBlock> blocks;
+        archive(blocks);
+        loadSave(SerializationTask::Load, blocks, data);
+        return;
+    }
+    //<<<
+
+    ClusteredDataDescription chunk;
+    while (deserializeChunk(chunk, archive)) {
+        data.clusters.insert(data.clusters.end(), std::make_move_iterator(chunk.clusters.begin()), std::make_move_iterator(chunk.clusters.end()));
+        data.particles.insert(data.particles.end(), std::make_move_iterator(chunk.particles.begin()), std::make_move_iterator(chunk.particles.end()));
+    }
+}
+
+bool ColumnarSerializerService::deserializeChunk(ClusteredDataDescription& chunk, cereal::PortableBinaryInputArchive& archive)
+{
+    chunk.clear();
+
+    bool hasChunk = false;
+    archive(hasChunk);
+    if (!hasChunk) {
+        return false;
+    }
+    std::vector<ColumnBlock> blocks;
+    archive(blocks);
+    loadSave(SerializationTask::Load, blocks, chunk);
+    return true;
+}
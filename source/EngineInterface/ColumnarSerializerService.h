@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Base/Definitions.h"
+
+#include "Definitions.h"
+#include "Descriptions.h"
+
+namespace cereal
+{
+    class PortableBinaryOutputArchive;
+    class PortableBinaryInputArchive;
+}
+
+//stores cells, connections, particles and each cell function type as typed column blocks
+//each block carries a field-presence table: unknown fields are skipped on load and missing fields keep their default values
+//data can be written in several chunks of complete clusters so that large worlds do not need to be held in memory at once
+//identical genomes are stored once per chunk together with the version of their byte encoding
+class ColumnarSerializerService
+{
+public:
+    static std::string const FormatMarker;
+    static uint32_t constexpr FormatVersion = 3;
+
+    static void serialize(cereal::PortableBinaryOutputArchive& archive, ClusteredDataDescription const& data);
+    static void serializeChunk(cereal::PortableBinaryOutputArchive& archive, ClusteredDataDescription const& chunk);
+    static void serializeEnd(cereal::PortableBinaryOutputArchive& archive);
+
+    static void deserialize(ClusteredDataDescription& data, cereal::PortableBinaryInputArchive& archive, uint32_t formatVersion);
+
+    //reads a single chunk written by serializeChunk, returns false if the end written by serializeEnd is reached
+    static bool deserializeChunk(ClusteredDataDescription& chunk, cereal::PortableBinaryInputArchive& archive);
+};
@@ -1,5 +1,62 @@
 #include "DataPointCollection.h"
 
+#include <algorithm>
+
+namespace
+{
+    template <typename Operation>
+    DataPoint combine(DataPoint const& lhs, DataPoint const& rhs, Operation const& operation)
+    {
+        DataPoint result;
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            result.values[i] = operation(lhs.values[i], rhs.values[i]);
+        }
+        result.summedValues = operation(lhs.summedValues, rhs.summedValues);
+        return result;
+    }
+
+    template <typename Operation>
+    DataPointCollection combine(DataPointCollection const& lhs, DataPointCollection const& rhs, Operation const& operation)
+    {
+        DataPointCollection result;
+        result.time = operation(lhs.time, rhs.time);
+        result.systemClock = operation(lhs.systemClock, rhs.systemClock);
+        for (auto member : {
+                 &DataPointCollection::numCells,
+                 &DataPointCollection::numSelfReplicators,
+                 &DataPointCollection::numColonies,
+                 &DataPointCollection::numViruses,
+                 &DataPointCollection::numConnections,
+                 &DataPointCollection::numParticles,
+                 &DataPointCollection::averageGenomeCells,
+                 &DataPointCollection::averageGenomeComplexity,
+                 &DataPointCollection::varianceGenomeComplexity,
+                 &DataPointCollection::maxGenomeComplexityOfColonies,
+                 &DataPointCollection::totalEnergy,
+                 &DataPointCollection::numCreatedCells,
+                 &DataPointCollection::numAttacks,
+                 &DataPointCollection::numMuscleActivities,
+                 &DataPointCollection::numDefenderActivities,
+                 &DataPointCollection::numTransmitterActivities,
+                 &DataPointCollection::numInjectionActivities,
+                 &DataPointCollection::numCompletedInjections,
+                 &DataPointCollection::numNervePulses,
+                 &DataPointCollection::numNeuronActivities,
+                 &DataPointCollection::numSensorActivities,
+                 &DataPointCollection::numSensorMatches,
+                 &DataPointCollection::numReconnectorCreated,
+                 &DataPointCollection::numReconnectorRemoved,
+                 &DataPointCollection::numDetonations,
+             }) {
+            result.*member = combine(lhs.*member, rhs.*member, operation);
+        }
+        return result;
+    }
+
+    auto constexpr Min = [](double lhs, double rhs) { return std::min(lhs, rhs); };
+    auto constexpr Max = [](double lhs, double rhs) { return std::max(lhs, rhs); };
+}
+
 DataPoint DataPoint::operator+(DataPoint const& other) const
 {
     DataPoint result;
@@ -20,6 +77,16 @@ DataPoint DataPoint::operator/(double divisor) const
     return result;
 }
 
+DataPoint DataPoint::elementwiseMin(DataPoint const& other) const
+{
+    return combine(*this, other, Min);
+}
+
+DataPoint DataPoint::elementwiseMax(DataPoint const& other) const
+{
+    return combine(*this, other, Max);
+}
+
 DataPointCollection DataPointCollection::operator+(DataPointCollection const& other) const
 {
     DataPointCollection result;
@@ -85,3 +152,13 @@ DataPointCollection DataPointCollection::operator/(double divisor) const
     result.numDetonations = numDetonations / divisor;
     return result;
 }
+
+DataPointCollection DataPointCollection::elementwiseMin(DataPointCollection const& other) const
+{
+    return combine(*this, other, Min);
+}
+
+DataPointCollection DataPointCollection::elementwiseMax(DataPointCollection const& other) const
+{
+    return combine(*this, other, Max);
+}
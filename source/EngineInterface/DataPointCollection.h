@@ -9,6 +9,8 @@ struct DataPoint
 
     DataPoint operator+(DataPoint const& other) const;
     DataPoint operator/(double divisor) const;
+    DataPoint elementwiseMin(DataPoint const& other) const;
+    DataPoint elementwiseMax(DataPoint const& other) const;
 };
 
 struct DataPointCollection
@@ -45,4 +47,6 @@ struct DataPointCollection
 
     DataPointCollection operator+(DataPointCollection const& other) const;
     DataPointCollection operator/(double divisor) const;
+    DataPointCollection elementwiseMin(DataPointCollection const& other) const;
+    DataPointCollection elementwiseMax(DataPointCollection const& other) const;
 };
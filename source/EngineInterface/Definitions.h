@@ -24,6 +24,9 @@ struct Settings;
 class _SimulationFacade;
 using SimulationFacade = std::shared_ptr<_SimulationFacade>;
 
+class _ClusteredDataReader;
+using ClusteredDataReader = std::shared_ptr<_ClusteredDataReader>;
+
 struct TimelineStatistics;
 struct HistogramData;
 struct RawStatisticsData;
@@ -36,3 +39,6 @@ using ShapeGenerator = std::shared_ptr<_ShapeGenerator>;
 class ShapeGeneratorResult;
 
 class StatisticsHistory;
+
+class _StatisticsService;
+using StatisticsService = std::shared_ptr<_StatisticsService>;
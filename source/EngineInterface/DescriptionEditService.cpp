@@ -5,9 +5,9 @@
 #include <boost/range/adaptor/map.hpp>
 
 #include "Base/NumberGenerator.h"
+#include "Base/ParallelService.h"
 #include "Base/Math.h"
 #include "GenomeDescriptions.h"
-#include "SpaceCalculator.h"
 #include "GenomeDescriptionService.h"
 
 DataDescription DescriptionEditService::createRect(CreateRectParameters const& parameters)
@@ -200,40 +200,6 @@ void DescriptionEditService::duplicate(ClusteredDataDescription& data, IntVector
     data = result;
 }
 
-namespace
-{
-    std::vector<int> getCellIndicesWithinRadius(
-        DataDescription const& data,
-        std::unordered_map<int, std::unordered_map<int, std::vector<int>>> const& cellIndicesBySlot,
-        RealVector2D const& pos,
-        float radius)
-    {
-        std::vector<int> result;
-        IntVector2D upperLeftIntPos{toInt(pos.x - radius - 0.5f), toInt(pos.y - radius - 0.5f)};
-        IntVector2D lowerRightIntPos{toInt(pos.x + radius + 0.5f), toInt(pos.y + radius + 0.5f)};
-        for (int x = upperLeftIntPos.x; x <= lowerRightIntPos.x; ++x) {
-            for (int y = upperLeftIntPos.y; y <= lowerRightIntPos.y; ++y) {
-                if (cellIndicesBySlot.find(x) != cellIndicesBySlot.end()) {
-                    if (cellIndicesBySlot.at(x).find(y) != cellIndicesBySlot.at(x).end()) {
-                        for (auto const& cellIndex : cellIndicesBySlot.at(x).at(y)) {
-                            auto const& cell = data.cells.at(cellIndex);
-                            if (Math::length(cell.pos - pos) <= radius) {
-                                result.emplace_back(cellIndex);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        std::sort(result.begin(), result.end(), [&](int index1, int index2) {
-            auto const& cell1 = data.cells.at(index1);
-            auto const& cell2 = data.cells.at(index2);
-            return Math::length(cell1.pos - pos) < Math::length(cell2.pos - pos);
-        });
-        return result;
-    }
-}
-
 DataDescription DescriptionEditService::gridMultiply(DataDescription const& input, GridMultiplyParameters const& parameters)
 {
     DataDescription result;
@@ -263,113 +229,179 @@ DataDescription DescriptionEditService::gridMultiply(DataDescription const& inpu
     return result;
 }
 
-DataDescription DescriptionEditService::randomMultiply(
+namespace
+{
+    auto constexpr RandomMultiplyMaxAttemptsPerCopy = 200;
+    auto constexpr RandomMultiplyOverlappingDistance = 2.0f;
+    auto constexpr RandomMultiplyMinBatchSize = 64;
+    auto constexpr RandomMultiplyMaxBatchSize = 4096;
+    auto constexpr RandomMultiplyMaxCellsPerBatch = 1 << 22;
+    auto constexpr RandomMultiplyMinAcceptanceRate = 0.01;
+
+    struct PlacementCandidate
+    {
+        RealVector2D shift;
+        float angle = 0;
+        RealVector2D velDelta;
+        float angularVelDelta = 0;
+        std::vector<RealVector2D> cellPositions;
+        bool overlapping = false;
+    };
+
+    PlacementCandidate createPlacementCandidate(
+        RandomStream& stream,
+        DescriptionEditService::RandomMultiplyParameters const& parameters,
+        IntVector2D const& worldSize,
+        std::vector<RealVector2D> const& relCellPositions,
+        RealVector2D const& center)
+    {
+        PlacementCandidate result;
+        result.shift = {stream.getRandomFloat(0, toFloat(worldSize.x)), stream.getRandomFloat(0, toFloat(worldSize.y))};
+        result.angle = stream.getRandomFloat(parameters._minAngle, parameters._maxAngle);
+        result.velDelta = {stream.getRandomFloat(parameters._minVelX, parameters._maxVelX), stream.getRandomFloat(parameters._minVelY, parameters._maxVelY)};
+        result.angularVelDelta = stream.getRandomFloat(parameters._minAngularVel, parameters._maxAngularVel);
+
+        //same as DataDescription::shift followed by DataDescription::rotate
+        auto rotationMatrix = Math::calcRotationMatrix(result.angle);
+        result.cellPositions.reserve(relCellPositions.size());
+        for (auto const& relPos : relCellPositions) {
+            result.cellPositions.emplace_back(center + result.shift + rotationMatrix * relPos);
+        }
+        return result;
+    }
+
+    bool isOverlapping(SpatialIndex const& cellOccupancy, std::vector<RealVector2D> const& cellPositions)
+    {
+        for (auto const& pos : cellPositions) {
+            if (cellOccupancy.isAnyCloserThan(pos, RandomMultiplyOverlappingDistance)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+auto DescriptionEditService::randomMultiply(
     DataDescription const& input,
     RandomMultiplyParameters const& parameters,
     IntVector2D const& worldSize,
-    DataDescription&& existentData,
-    bool& overlappingCheckSuccessful)
+    DataDescription const& existentData) -> RandomMultiplyResult
 {
-    overlappingCheckSuccessful = true;
-    SpaceCalculator spaceCalculator(worldSize);
-    std::unordered_map<IntVector2D, std::vector<RealVector2D>> cellPosBySlot;
+    RandomMultiplyResult result;
+    result.data = input;
+    generateNewIds(result.data);
+    if (input.isEmpty() || parameters._number <= 0) {
+        return result;
+    }
+    auto& numberGen = NumberGenerator::get();
+    auto seed = parameters._seed ? *parameters._seed : (static_cast<uint64_t>(numberGen.getRandomInt()) << 32) | numberGen.getRandomInt();
 
-    //create map for overlapping check
+    //index for overlapping check
+    SpatialIndex cellOccupancy(worldSize, RandomMultiplyOverlappingDistance);
     if (parameters._overlappingCheck) {
-        int index = 0;
+        std::vector<RealVector2D> cellPositions;
+        cellPositions.reserve(existentData.cells.size());
         for (auto const& cell : existentData.cells) {
-            auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-            cellPosBySlot[intPos].emplace_back(cell.pos);
-            ++index;
+            cellPositions.emplace_back(cell.pos);
         }
+        cellOccupancy.build(cellPositions);
     }
 
-    //do multiplication
-    DataDescription result = input;
-    generateNewIds(result);
-    auto& numberGen = NumberGenerator::get();
-    for (int i = 0; i < parameters._number; ++i) {
-        bool overlapping = false;
-        DataDescription copy;
-        int attempts = 0;
-        do {
-            copy = input;
-            removeMetadata(copy);
-            copy.shift({toFloat(numberGen.getRandomReal(0, toInt(worldSize.x))), toFloat(numberGen.getRandomReal(0, toInt(worldSize.y)))});
-            copy.rotate(toInt(numberGen.getRandomReal(parameters._minAngle, parameters._maxAngle)));
-            copy.accelerate(
-                {toFloat(numberGen.getRandomReal(parameters._minVelX, parameters._maxVelX)),
-                 toFloat(numberGen.getRandomReal(parameters._minVelY, parameters._maxVelY))},
-                toFloat(numberGen.getRandomReal(parameters._minAngularVel, parameters._maxAngularVel)));
-
-            //overlapping check
-            overlapping = false;
-            if (parameters._overlappingCheck) {
-                for (auto const& cell : copy.cells) {
-                    auto pos = spaceCalculator.getCorrectedPosition(cell.pos);
-                    if (isCellPresent(cellPosBySlot, spaceCalculator, pos, 2.0f)) {
-                        overlapping = true;
-                    }
-                }
-            }
-            ++attempts;
-        } while (overlapping && attempts < 200 && overlappingCheckSuccessful);
-        if (attempts == 200) {
-            overlappingCheckSuccessful = false;
+    auto center = input.calcCenter();
+    std::vector<RealVector2D> relCellPositions;
+    relCellPositions.reserve(input.cells.size());
+    for (auto const& cell : input.cells) {
+        relCellPositions.emplace_back(cell.pos - center);
+    }
+
+    //candidate i is derived from the random stream (seed, i) and batch sizes only depend on previous results,
+    //hence the outcome does not depend on the number of threads
+    auto maxNumCandidates = static_cast<uint64_t>(parameters._number) * (parameters._overlappingCheck ? RandomMultiplyMaxAttemptsPerCopy : 1);
+    auto maxBatchSize = std::clamp(RandomMultiplyMaxCellsPerBatch / std::max(1, toInt(input.cells.size())), 1, RandomMultiplyMaxBatchSize);
+    uint64_t numCandidates = 0;
+    auto acceptanceRate = 1.0;
+    while (result.numCopies < parameters._number && numCandidates < maxNumCandidates) {
+        auto numRemainingCopies = parameters._number - result.numCopies;
+        auto batchSize = toInt(std::ceil(toDouble(numRemainingCopies) / acceptanceRate));
+        if (parameters._overlappingCheck) {
+            batchSize = std::max(batchSize, RandomMultiplyMinBatchSize);
         }
+        batchSize = toInt(std::min(static_cast<uint64_t>(std::min(batchSize, maxBatchSize)), maxNumCandidates - numCandidates));
 
-        generateNewIds(copy);
-        generateNewCreatureIds(copy);
-        result.add(copy);
+        //propose candidates and check them against the occupied space in parallel
+        std::vector<PlacementCandidate> candidates(batchSize);
+        ParallelService::forEach(batchSize, [&](uint64_t candidateIndex) {
+            RandomStream stream(seed, numCandidates + candidateIndex);
+            auto& candidate = candidates[candidateIndex];
+            candidate = createPlacementCandidate(stream, parameters, worldSize, relCellPositions, center);
+            if (parameters._overlappingCheck) {
+                candidate.overlapping = isOverlapping(cellOccupancy, candidate.cellPositions);
+            }
+        });
+        numCandidates += batchSize;
 
-        //add copy to existentData for overlapping check
-        if (parameters._overlappingCheck) {
-            for (auto const& cell : copy.cells) {
-                auto index = toInt(existentData.cells.size());
-                existentData.cells.emplace_back(cell);
-                auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-                cellPosBySlot[intPos].emplace_back(cell.pos);
+        //candidates of the same batch may overlap each other, earlier candidates win
+        int numExaminedCandidates = 0;
+        int numAcceptedCandidates = 0;
+        for (auto& candidate : candidates) {
+            if (result.numCopies == parameters._number) {
+                break;
+            }
+            ++numExaminedCandidates;
+            if (candidate.overlapping || (parameters._overlappingCheck && numAcceptedCandidates > 0 && isOverlapping(cellOccupancy, candidate.cellPositions))) {
+                continue;
+            }
+            if (parameters._overlappingCheck) {
+                for (auto const& pos : candidate.cellPositions) {
+                    cellOccupancy.insert(pos);
+                }
             }
-        }
-    }
 
+            auto copy = input;
+            removeMetadata(copy);
+            copy.shift(candidate.shift);
+            copy.rotate(candidate.angle);
+            copy.accelerate(candidate.velDelta, candidate.angularVelDelta);
+            generateNewIds(copy);
+            generateNewCreatureIds(copy);
+            result.data.add(copy);
+            ++result.numCopies;
+            ++numAcceptedCandidates;
+        }
+        acceptanceRate = std::max(RandomMultiplyMinAcceptanceRate, toDouble(numAcceptedCandidates) / toDouble(numExaminedCandidates));
+    }
+    result.fillRate = toFloat(result.numCopies) / toFloat(parameters._number);
     return result;
 }
 
-void DescriptionEditService::addIfSpaceAvailable(
-    DataDescription& result,
-    Occupancy& cellOccupancy,
-    DataDescription const& toAdd,
-    float distance,
-    IntVector2D const& worldSize)
+void DescriptionEditService::addIfSpaceAvailable(DataDescription& result, SpatialIndex& cellOccupancy, DataDescription const& toAdd, float distance)
 {
-    SpaceCalculator space(worldSize);
-
     for (auto const& cell : toAdd.cells) {
-        if (!isCellPresent(cellOccupancy, space, cell.pos, distance)) {
+        if (!cellOccupancy.isAnyCloserThan(cell.pos, distance)) {
             result.addCell(cell);
-            cellOccupancy[toIntVector2D(cell.pos)].emplace_back(cell.pos);
+            cellOccupancy.insert(cell.pos);
         }
     }
 }
 
 void DescriptionEditService::reconnectCells(DataDescription& data, float maxDistance)
 {
-    std::unordered_map<int, std::unordered_map<int, std::vector<int>>> cellIndicesBySlot;
-
-    int index = 0;
+    std::vector<RealVector2D> cellPositions;
+    cellPositions.reserve(data.cells.size());
     for (auto& cell : data.cells) {
         cell.connections.clear();
-        cellIndicesBySlot[toInt(cell.pos.x)][toInt(cell.pos.y)].emplace_back(toInt(index));
-        ++index;
+        cellPositions.emplace_back(cell.pos);
     }
+    SpatialIndex cellIndex(maxDistance);
+    cellIndex.build(cellPositions);
+    auto nearbyCellIndicesByCell = cellIndex.getIndicesWithinRadius(cellPositions, maxDistance);
 
     std::unordered_map<uint64_t, int> cache;
     for (auto const& [index, cell] : data.cells | boost::adaptors::indexed(0)) {
         cache.emplace(cell.id, static_cast<int>(index));
     }
-    for (auto& cell : data.cells) {
-        auto nearbyCellIndices = getCellIndicesWithinRadius(data, cellIndicesBySlot, cell.pos, maxDistance);
+    for (auto const& [index, nearbyCellIndices] : nearbyCellIndicesByCell | boost::adaptors::indexed(0)) {
+        auto& cell = data.cells.at(index);
         for (auto const& nearbyCellIndex : nearbyCellIndices) {
             auto const& nearbyCell = data.cells.at(nearbyCellIndex);
             if (cell.id != nearbyCell.id && cell.connections.size() < cell.maxConnections && nearbyCell.connections.size() < nearbyCell.maxConnections
@@ -614,39 +646,6 @@ void DescriptionEditService::removeMetadata(CellDescription& cell)
     cell.metadata.name.clear();
 }
 
-bool DescriptionEditService::isCellPresent(Occupancy const& cellPosBySlot, SpaceCalculator const& spaceCalculator, RealVector2D const& posToCheck, float distance)
-{
-    auto intPos = toIntVector2D(posToCheck);
-
-    auto getMatchingSlots = [&cellPosBySlot](IntVector2D const& intPos) {
-        auto findResult = cellPosBySlot.find(intPos);
-        if (findResult != cellPosBySlot.end()) {
-            return findResult->second;
-        }
-        return std::vector<RealVector2D>{};
-    };
-
-    auto isOccupied = [&](std::vector<RealVector2D> const& cellPositions) {
-        for (auto const& cellPos : cellPositions) {
-            auto otherPos = spaceCalculator.getCorrectedPosition(cellPos);
-            if (Math::length(posToCheck - otherPos) < distance) {
-                return true;
-            }
-        }
-        return false;
-    };
-
-    auto distanceInt = toInt(ceilf(distance));
-    for (int dx = -distanceInt; dx <= distanceInt; ++dx) {
-        for (int dy = -distanceInt; dy <= distanceInt; ++dy) {
-            if (isOccupied(getMatchingSlots({intPos.x + dx, intPos.y + dy}))) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 uint64_t DescriptionEditService::getId(CellOrParticleDescription const& entity)
 {
     if (std::holds_alternative<CellDescription>(entity)) {
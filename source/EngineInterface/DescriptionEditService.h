@@ -2,6 +2,7 @@
 
 #include "Base/Definitions.h"
 #include "Descriptions.h"
+#include "SpatialIndex.h"
 
 class DescriptionEditService
 {
@@ -84,17 +85,21 @@ public:
         MEMBER_DECLARATION(RandomMultiplyParameters, float, minAngularVel, 0);
         MEMBER_DECLARATION(RandomMultiplyParameters, float, maxAngularVel, 0);
         MEMBER_DECLARATION(RandomMultiplyParameters, bool, overlappingCheck, false);
+        MEMBER_DECLARATION(RandomMultiplyParameters, std::optional<uint64_t>, seed, std::nullopt);  //drawn from NumberGenerator if not set
     };
-    static DataDescription randomMultiply(
-        DataDescription const& input,
-        RandomMultiplyParameters const& parameters,
-        IntVector2D const& worldSize,
-        DataDescription&& existentData,
-        bool& overlappingCheckSuccessful);
+    struct RandomMultiplyResult
+    {
+        DataDescription data;
+        int numCopies = 0;  //can be smaller than the requested number if the overlapping check does not find enough free space
+        float fillRate = 1.0f;  //ratio of placed to requested copies
+    };
+    //copies are placed via rejection sampling: candidate placements are proposed in batches and checked for overlaps in parallel
+    //overlaps between candidates of the same batch are resolved in candidate order such that the result only depends on the seed
+    static RandomMultiplyResult
+    randomMultiply(DataDescription const& input, RandomMultiplyParameters const& parameters, IntVector2D const& worldSize, DataDescription const& existentData);
 
-    using Occupancy = std::unordered_map<IntVector2D, std::vector<RealVector2D>>;
-    static void
-    addIfSpaceAvailable(DataDescription& result, Occupancy& cellOccupancy, DataDescription const& toAdd, float distance, IntVector2D const& worldSize);
+    //cellOccupancy contains the positions of the cells in result and is updated accordingly
+    static void addIfSpaceAvailable(DataDescription& result, SpatialIndex& cellOccupancy, DataDescription const& toAdd, float distance);
 
     static void reconnectCells(DataDescription& data, float maxDistance);
     static void removeStickiness(DataDescription& data);
@@ -120,9 +125,4 @@ public:
 
 private:
     static void removeMetadata(CellDescription& cell);
-    static bool isCellPresent(
-        Occupancy const& cellPosBySlot,
-        SpaceCalculator const& spaceCalculator,
-        RealVector2D const& posToCheck,
-        float distance);
 };
@@ -293,7 +293,7 @@ DataDescription::addConnection(uint64_t const& cellId1, uint64_t const& cellId2,
             newConnection.cellId = otherCell.id;
             newConnection.distance = toFloat(Math::length(otherCell.pos - cell.pos));
 
-            auto connectedCell = getCellRef(cell.connections.front().cellId, cache);
+            auto const& connectedCell = getCellRef(cell.connections.front().cellId, cache);
             auto connectedCellDelta = connectedCell.pos - cell.pos;
             auto prevAngle = Math::angleOfVector(connectedCellDelta);
             auto angleDiff = newAngle - prevAngle;
@@ -308,7 +308,7 @@ DataDescription::addConnection(uint64_t const& cellId1, uint64_t const& cellId2,
             return;
         }
 
-        auto firstConnectedCell = getCellRef(cell.connections.front().cellId, cache);
+        auto const& firstConnectedCell = getCellRef(cell.connections.front().cellId, cache);
         auto firstConnectedCellDelta = firstConnectedCell.pos - cell.pos;
         auto angle = Math::angleOfVector(firstConnectedCellDelta);
         auto connectionIt = ++cell.connections.begin();
@@ -4,6 +4,7 @@
 
 #include "Base/Definitions.h"
 #include "EngineInterface/EngineConstants.h"
+#include "EngineInterface/NeuronData.h"
 
 #include "Definitions.h"
 
@@ -53,17 +54,16 @@ struct ConnectionDescription
 
 struct ActivityDescription
 {
-    std::vector<float> channels;
+    ActivityChannels channels = {};
     ActivityOrigin origin = ActivityOrigin_Unknown;
     float targetX = 0;
     float targetY = 0;
 
-    ActivityDescription() { channels.resize(MAX_CHANNELS, 0); }
+    ActivityDescription() = default;  //not an aggregate so that channel lists are not implicitly converted to ActivityDescription
     auto operator<=>(ActivityDescription const&) const = default;
 
-    ActivityDescription& setChannels(std::vector<float> const& value)
+    ActivityDescription& setChannels(ActivityChannels const& value)
     {
-        CHECK(value.size() == MAX_CHANNELS);
         channels = value;
         return *this;
     }
@@ -72,16 +72,10 @@ struct ActivityDescription
 
 struct NeuronDescription
 {
-    std::vector<std::vector<float>> weights;
-    std::vector<float> biases;
-    std::vector<NeuronActivationFunction> activationFunctions;
+    NeuronWeights weights = {};
+    NeuronBiases biases = {};
+    NeuronActivationFunctions activationFunctions = {};
 
-    NeuronDescription()
-    {
-        weights.resize(MAX_CHANNELS, std::vector<float>(MAX_CHANNELS, 0));
-        biases.resize(MAX_CHANNELS, 0);
-        activationFunctions.resize(MAX_CHANNELS, 0);
-    }
     auto operator<=>(NeuronDescription const&) const = default;
 };
 
@@ -495,10 +489,8 @@ struct CellDescription
         activity = value;
         return *this;
     }
-    CellDescription& setActivity(std::vector<float> const& value)
+    CellDescription& setActivity(ActivityChannels const& value)
     {
-        CHECK(value.size() == MAX_CHANNELS);
-
         ActivityDescription newActivity;
         newActivity.channels = value;
         activity = newActivity;
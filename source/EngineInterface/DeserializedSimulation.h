@@ -1,5 +1,8 @@
 #pragma once
 
+#include <optional>
+#include <string>
+
 #include "AuxiliaryData.h"
 #include "Descriptions.h"
 #include "StatisticsHistory.h"
@@ -7,6 +10,7 @@
 struct DeserializedSimulation
 {
     ClusteredDataDescription mainData;
+    std::optional<std::string> snapshotFilename;  //set instead of mainData if the main data is a snapshot file (see SimulationFacade)
     AuxiliaryData auxiliaryData;
-    StatisticsHistoryData statistics;
+    StatisticsHistorySnapshot statistics;
 };
@@ -2,6 +2,6 @@
 
 struct GeneralSettings
 {
-    int worldSizeX;
-    int worldSizeY;
+    int worldSizeX = 0;
+    int worldSizeY = 0;
 };
@@ -1,5 +1,6 @@
 #include "GenomeDescriptionService.h"
 
+#include <stdexcept>
 #include <variant>
 
 #include "Base/Definitions.h"
@@ -433,3 +434,21 @@ int GenomeDescriptionService::getNumRepetitions(std::vector<uint8_t> const& data
 {
     return convertByteToByteWithInfinity(data.at(Const::GenomeHeaderNumRepetitionsPos));
 }
+
+std::vector<uint8_t> GenomeDescriptionService::convertToCurrentEncoding(std::vector<uint8_t> const& data, uint32_t encodingVersion)
+{
+    if (encodingVersion == EncodingVersion) {
+        return data;
+    }
+    if (encodingVersion > EncodingVersion || encodingVersion == 0) {
+        throw std::runtime_error("Genome encoding version not supported.");
+    }
+    auto spec = GenomeEncodingSpecification().numRepetitions(false).concatenationAngle1(false).concatenationAngle2(false);
+    auto genome = convertBytesToDescription(data, spec);
+    for (auto& node : genome.cells) {
+        if (auto subgenome = node.getGenome()) {
+            node.setGenome(convertToCurrentEncoding(*subgenome, encodingVersion));
+        }
+    }
+    return convertDescriptionToBytes(genome);
+}
@@ -15,6 +15,10 @@ struct GenomeEncodingSpecification
 class GenomeDescriptionService
 {
 public:
+    //version of the byte representation, needs to be increased on every change of the encoding
+    //version 1: without repetitions and concatenation angles
+    static uint32_t constexpr EncodingVersion = 2;
+
     static std::vector<uint8_t> convertDescriptionToBytes(GenomeDescription const& genome, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
     static GenomeDescription convertBytesToDescription(std::vector<uint8_t> const& data, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
 
@@ -22,4 +26,7 @@ public:
     static int convertNodeIndexToNodeAddress(std::vector<uint8_t> const& data, int nodeIndex, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
     static int getNumNodesRecursively(std::vector<uint8_t> const& data, bool includeRepetitions, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
     static int getNumRepetitions(std::vector<uint8_t> const& data);
+
+    //converts a genome including its subgenomes from an older encoding version to the current one
+    static std::vector<uint8_t> convertToCurrentEncoding(std::vector<uint8_t> const& data, uint32_t encodingVersion);
 };
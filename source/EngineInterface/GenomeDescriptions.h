@@ -9,6 +9,7 @@
 #include "Base/Definitions.h"
 #include "EngineConstants.h"
 #include "CellFunctionConstants.h"
+#include "NeuronData.h"
 
 struct MakeGenomeCopy
 {
@@ -17,16 +18,10 @@ struct MakeGenomeCopy
 
 struct NeuronGenomeDescription
 {
-    std::vector<std::vector<float>> weights;
-    std::vector<float> biases;
-    std::vector<NeuronActivationFunction> activationFunctions;
+    NeuronWeights weights = {};
+    NeuronBiases biases = {};
+    NeuronActivationFunctions activationFunctions = {};
 
-    NeuronGenomeDescription()
-    {
-        weights.resize(MAX_CHANNELS, std::vector<float>(MAX_CHANNELS, 0));
-        biases.resize(MAX_CHANNELS, 0);
-        activationFunctions.resize(MAX_CHANNELS, 0);
-    }
     auto operator<=>(NeuronGenomeDescription const&) const = default;
 };
 
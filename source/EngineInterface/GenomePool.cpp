@@ -0,0 +1,65 @@
+#include "GenomePool.h"
+
+#include <cstring>
+
+uint64_t GenomePool::calcHash(std::vector<uint8_t> const& genome)
+{
+    //processes 8 bytes per step, multiplication and xor-shift as in the finalizer of MurmurHash3
+    auto constexpr Multiplier = 0xff51afd7ed558ccdull;
+    uint64_t result = 0x9e3779b97f4a7c15ull ^ genome.size();
+    auto mix = [&](uint64_t word) {
+        result ^= word;
+        result *= Multiplier;
+        result ^= result >> 33;
+    };
+    auto const size = genome.size();
+    size_t index = 0;
+    for (; index + sizeof(uint64_t) <= size; index += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, genome.data() + index, sizeof(uint64_t));
+        mix(word);
+    }
+    if (index < size) {
+        uint64_t word = 0;
+        std::memcpy(&word, genome.data() + index, size - index);
+        mix(word);
+    }
+    result *= Multiplier;
+    result ^= result >> 33;
+    return result;
+}
+
+int GenomePool::add(std::vector<uint8_t> const& genome)
+{
+    return add(genome, calcHash(genome));
+}
+
+int GenomePool::add(std::vector<uint8_t> const& genome, uint64_t hash)
+{
+    auto [begin, end] = _indexByHash.equal_range(hash);
+    for (auto iter = begin; iter != end; ++iter) {
+        if (_genomes.at(iter->second) == genome) {
+            return iter->second;
+        }
+    }
+    auto result = toInt(_genomes.size());
+    _genomes.emplace_back(genome);
+    _indexByHash.emplace(hash, result);
+    _totalSize += genome.size();
+    return result;
+}
+
+std::vector<uint8_t> const& GenomePool::at(int index) const
+{
+    return _genomes.at(index);
+}
+
+std::vector<std::vector<uint8_t>> const& GenomePool::getGenomes() const
+{
+    return _genomes;
+}
+
+uint64_t GenomePool::getTotalSize() const
+{
+    return _totalSize;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "Base/Definitions.h"
+
+//content-addressed store of genomes in their byte representation, identical genomes are held only once
+//genomes are identified by their index which is assigned in order of insertion
+class GenomePool
+{
+public:
+    static uint64_t calcHash(std::vector<uint8_t> const& genome);
+
+    int add(std::vector<uint8_t> const& genome);
+    int add(std::vector<uint8_t> const& genome, uint64_t hash);  //hash must be calculated by calcHash
+
+    std::vector<uint8_t> const& at(int index) const;
+    std::vector<std::vector<uint8_t>> const& getGenomes() const;
+    uint64_t getTotalSize() const;  //sum of the sizes of the unique genomes
+
+private:
+    std::vector<std::vector<uint8_t>> _genomes;
+    std::unordered_multimap<uint64_t, int> _indexByHash;
+    uint64_t _totalSize = 0;
+};
@@ -3,6 +3,7 @@
 #include <set>
 
 #include "PropertyParser.h"
+#include "SettingsJson.h"
 
 namespace
 {
@@ -61,106 +62,122 @@ namespace
         return true;
     }
 
-    template<typename T>
-    void readLegacyParameterForBase(LegacyProperty<T>& result, boost::property_tree::ptree& tree, std::string const& node)
+    template <typename T, typename Codec>
+    void readLegacyParameterForBase(LegacyProperty<T>& result, Codec& codec, std::string const& node)
     {
         T defaultDummy;
-        result.existent = !PropertyParser::encodeDecode(tree, result.parameter, defaultDummy, node, ParserTask::Decode);
+        result.existent = !codec.encodeDecode(result.parameter, defaultDummy, node);
     }
 
-    template <typename T>
-    void readLegacyParameterForSpot(LegacySpotProperty<T>& result, boost::property_tree::ptree& tree, std::string const& node)
+    template <typename T, typename Codec>
+    void readLegacyParameterForSpot(LegacySpotProperty<T>& result, Codec& codec, std::string const& node)
     {
         T defaultDummy;
-        result.existent = !PropertyParser::encodeDecodeWithEnabled(tree, result.parameter, result.active, defaultDummy, node, ParserTask::Decode);
+        result.existent = !codec.encodeDecodeWithEnabled(result.parameter, result.active, defaultDummy, node);
     }
 
-    LegacyParametersForBase readLegacyParametersForBase(boost::property_tree::ptree& tree, std::string const& nodeBase)
+    template <typename Codec>
+    LegacyParametersForBase readLegacyParametersForBase(Codec& codec, std::string const& nodeBase)
     {
         LegacyParametersForBase result;
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationNeuronDataProbability, tree, nodeBase + "cell.function.constructor.mutation probability.neuron data");
+            result.cellFunctionConstructorMutationNeuronDataProbability, codec, nodeBase + "cell.function.constructor.mutation probability.neuron data");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationPropertiesProbability, tree, nodeBase + "cell.function.constructor.mutation probability.data");
+            result.cellFunctionConstructorMutationPropertiesProbability, codec, nodeBase + "cell.function.constructor.mutation probability.data");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationCellFunctionProbability, tree, nodeBase + "cell.function.constructor.mutation probability.cell function");
+            result.cellFunctionConstructorMutationCellFunctionProbability, codec, nodeBase + "cell.function.constructor.mutation probability.cell function");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationGeometryProbability, tree, nodeBase + "cell.function.constructor.mutation probability.geometry");
+            result.cellFunctionConstructorMutationGeometryProbability, codec, nodeBase + "cell.function.constructor.mutation probability.geometry");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationCustomGeometryProbability, tree, nodeBase + "cell.function.constructor.mutation probability.custom geometry");
+            result.cellFunctionConstructorMutationCustomGeometryProbability, codec, nodeBase + "cell.function.constructor.mutation probability.custom geometry");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationInsertionProbability, tree, nodeBase + "cell.function.constructor.mutation probability.insertion");
+            result.cellFunctionConstructorMutationInsertionProbability, codec, nodeBase + "cell.function.constructor.mutation probability.insertion");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationDeletionProbability, tree, nodeBase + "cell.function.constructor.mutation probability.deletion");
+            result.cellFunctionConstructorMutationDeletionProbability, codec, nodeBase + "cell.function.constructor.mutation probability.deletion");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationTranslationProbability, tree, nodeBase + "cell.function.constructor.mutation probability.translation");
+            result.cellFunctionConstructorMutationTranslationProbability, codec, nodeBase + "cell.function.constructor.mutation probability.translation");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationDuplicationProbability, tree, nodeBase + "cell.function.constructor.mutation probability.duplication");
+            result.cellFunctionConstructorMutationDuplicationProbability, codec, nodeBase + "cell.function.constructor.mutation probability.duplication");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationCellColorProbability, tree, nodeBase + "cell.function.constructor.mutation probability.cell color");
+            result.cellFunctionConstructorMutationCellColorProbability, codec, nodeBase + "cell.function.constructor.mutation probability.cell color");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationSubgenomeColorProbability, tree, nodeBase + "cell.function.constructor.mutation probability.color");
+            result.cellFunctionConstructorMutationSubgenomeColorProbability, codec, nodeBase + "cell.function.constructor.mutation probability.color");
         readLegacyParameterForBase(
-            result.cellFunctionConstructorMutationGenomeColorProbability, tree, nodeBase + "cell.function.constructor.mutation probability.uniform color");
+            result.cellFunctionConstructorMutationGenomeColorProbability, codec, nodeBase + "cell.function.constructor.mutation probability.uniform color");
 
         readLegacyParameterForBase(
-            result.cellFunctionMuscleMovementAngleFromSensor, tree, nodeBase + "cell.function.muscle.movement angle from sensor");
+            result.cellFunctionMuscleMovementAngleFromSensor, codec, nodeBase + "cell.function.muscle.movement angle from sensor");
 
-        readLegacyParameterForBase(result.clusterDecay, tree, nodeBase + "cluster.decay");
-        readLegacyParameterForBase(result.clusterDecayProb, tree, nodeBase + "cluster.decay probability");
+        readLegacyParameterForBase(result.clusterDecay, codec, nodeBase + "cluster.decay");
+        readLegacyParameterForBase(result.clusterDecayProb, codec, nodeBase + "cluster.decay probability");
 
         return result;
     }
 
-    LegacyParametersForSpot readLegacyParametersForSpot(boost::property_tree::ptree& tree, std::string const& nodeBase)
+    template <typename Codec>
+    LegacyParametersForSpot readLegacyParametersForSpot(Codec& codec, std::string const& nodeBase)
     {
         LegacyParametersForSpot result;
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationNeuronDataProbability, tree, nodeBase + "cell.function.constructor.mutation probability.neuron data");
+            result.cellFunctionConstructorMutationNeuronDataProbability, codec, nodeBase + "cell.function.constructor.mutation probability.neuron data");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationPropertiesProbability, tree, nodeBase + "cell.function.constructor.mutation probability.data ");
+            result.cellFunctionConstructorMutationPropertiesProbability, codec, nodeBase + "cell.function.constructor.mutation probability.data ");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationCellFunctionProbability, tree, nodeBase + "cell.function.constructor.mutation probability.cell function");
+            result.cellFunctionConstructorMutationCellFunctionProbability, codec, nodeBase + "cell.function.constructor.mutation probability.cell function");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationGeometryProbability, tree, nodeBase + "cell.function.constructor.mutation probability.geometry");
+            result.cellFunctionConstructorMutationGeometryProbability, codec, nodeBase + "cell.function.constructor.mutation probability.geometry");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationCustomGeometryProbability, tree, nodeBase + "cell.function.constructor.mutation probability.custom geometry");
+            result.cellFunctionConstructorMutationCustomGeometryProbability, codec, nodeBase + "cell.function.constructor.mutation probability.custom geometry");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationInsertionProbability, tree, nodeBase + "cell.function.constructor.mutation probability.insertion");
+            result.cellFunctionConstructorMutationInsertionProbability, codec, nodeBase + "cell.function.constructor.mutation probability.insertion");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationDeletionProbability, tree, nodeBase + "cell.function.constructor.mutation probability.deletion");
+            result.cellFunctionConstructorMutationDeletionProbability, codec, nodeBase + "cell.function.constructor.mutation probability.deletion");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationTranslationProbability, tree, nodeBase + "cell.function.constructor.mutation probability.translation");
+            result.cellFunctionConstructorMutationTranslationProbability, codec, nodeBase + "cell.function.constructor.mutation probability.translation");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationDuplicationProbability, tree, nodeBase + "cell.function.constructor.mutation probability.duplication");
+            result.cellFunctionConstructorMutationDuplicationProbability, codec, nodeBase + "cell.function.constructor.mutation probability.duplication");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationCellColorProbability, tree, nodeBase + "cell.function.constructor.mutation probability.cell color");
+            result.cellFunctionConstructorMutationCellColorProbability, codec, nodeBase + "cell.function.constructor.mutation probability.cell color");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationSubgenomeColorProbability, tree, nodeBase + "cell.function.constructor.mutation probability.color");
+            result.cellFunctionConstructorMutationSubgenomeColorProbability, codec, nodeBase + "cell.function.constructor.mutation probability.color");
         readLegacyParameterForSpot(
-            result.cellFunctionConstructorMutationGenomeColorProbability, tree, nodeBase + "cell.function.constructor.mutation probability.uniform color");
+            result.cellFunctionConstructorMutationGenomeColorProbability, codec, nodeBase + "cell.function.constructor.mutation probability.uniform color");
         return result;
     }
 }
 
+template <typename Codec>
 void LegacyAuxiliaryDataParserService::searchAndApplyLegacyParameters(
     std::string const& programVersion,
-    boost::property_tree::ptree& tree,
+    Codec& codec,
     MissingFeatures const& missingFeatures,
     MissingParameters const& missingParameters,
     SimulationParameters& parameters)
 {
     LegacyFeatures legacyFeatures;
-    readLegacyParameterForBase(legacyFeatures.advancedMuscleControl, tree, "simulation parameters.features.additional muscle control");
+    readLegacyParameterForBase(legacyFeatures.advancedMuscleControl, codec, "simulation parameters.features.additional muscle control");
 
     LegacyParameters legacyParameters;
-    legacyParameters.base = readLegacyParametersForBase(tree, "simulation parameters.");
+    legacyParameters.base = readLegacyParametersForBase(codec, "simulation parameters.");
     for (int i = 0; i < parameters.numSpots; ++i) {
-        legacyParameters.spots[i] = readLegacyParametersForSpot(tree, "simulation parameters.spots." + std::to_string(i) + ".");
+        legacyParameters.spots[i] = readLegacyParametersForSpot(codec, "simulation parameters.spots." + std::to_string(i) + ".");
     }
     activateParametersAndFeaturesForLegacyFiles(programVersion, missingFeatures, legacyFeatures, missingParameters, legacyParameters, parameters);
 }
 
+template void LegacyAuxiliaryDataParserService::searchAndApplyLegacyParameters(
+    std::string const& programVersion,
+    PropertyTreeCodec<ParserTask::Decode>& codec,
+    MissingFeatures const& missingFeatures,
+    MissingParameters const& missingParameters,
+    SimulationParameters& parameters);
+template void LegacyAuxiliaryDataParserService::searchAndApplyLegacyParameters(
+    std::string const& programVersion,
+    SettingsJsonReader& codec,
+    MissingFeatures const& missingFeatures,
+    MissingParameters const& missingParameters,
+    SimulationParameters& parameters);
+
 void LegacyAuxiliaryDataParserService::activateParametersAndFeaturesForLegacyFiles(
     std::string const& programVersion,
     MissingFeatures const& missingFeatures,
@@ -1,8 +1,7 @@
 #pragma once
 
 #include <optional>
-
-#include <boost/property_tree/ptree_fwd.hpp>
+#include <string>
 
 #include "SimulationParameters.h"
 
@@ -88,9 +87,11 @@ class LegacyAuxiliaryDataParserService
 {
 public:
     //Note: missingFeatures and missingParameters are deprecated, use programVersion instead
+    //Codec is PropertyTreeCodec<ParserTask::Decode> or SettingsJsonReader
+    template <typename Codec>
     static void searchAndApplyLegacyParameters(
         std::string const& programVersion,
-        boost::property_tree::ptree& tree,
+        Codec& codec,
         MissingFeatures const& missingFeatures,
         MissingParameters const& missingParameters,
         SimulationParameters& parameters);
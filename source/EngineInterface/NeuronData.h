@@ -0,0 +1,14 @@
+#pragma once
+
+#include <array>
+
+#include "CellFunctionConstants.h"
+#include "EngineConstants.h"
+
+//fixed-size neuron and activity data with the same memory layout as on the GPU (see NeuronFunction::NeuronState and ActivityTO)
+using NeuronWeights = std::array<std::array<float, MAX_CHANNELS>, MAX_CHANNELS>;  //indexed by [output channel][input channel]
+using NeuronBiases = std::array<float, MAX_CHANNELS>;
+using NeuronActivationFunctions = std::array<NeuronActivationFunction, MAX_CHANNELS>;
+using ActivityChannels = std::array<float, MAX_CHANNELS>;
+
+static_assert(sizeof(NeuronWeights) == sizeof(float) * MAX_CHANNELS * MAX_CHANNELS);
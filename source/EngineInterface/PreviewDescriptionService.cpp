@@ -5,6 +5,7 @@
 
 #include "GenomeConstants.h"
 #include "ShapeGenerator.h"
+#include "SpatialIndex.h"
 #include "Base/Math.h"
 #include "EngineInterface/GenomeDescriptionService.h"
 
@@ -122,7 +123,7 @@ namespace
         result.direction = RealVector2D{0, 1};
 
         RealVector2D pos;
-        std::unordered_map<IntVector2D, std::vector<int>> cellInternIndicesBySlot;
+        SpatialIndex cellInternIndex(uniformConnectingCellMaxyDistance);
 
         auto hasInfiniteRepetitions = genome.header.numRepetitions == std::numeric_limits<int>::max();
         if (MaxRepetitions < genome.header.numRepetitions) {
@@ -194,32 +195,22 @@ namespace
                 }
 
                 //find nearby cells
-                std::vector<int> nearbyCellIndices;
-                IntVector2D intPos{toInt(pos.x), toInt(pos.y)};
-                auto radius = toInt(uniformConnectingCellMaxyDistance) + 1;
-                for (int dx = -radius; dx <= radius; ++dx) {
-                    for (int dy = -radius; dy <= radius; ++dy) {
-                        auto const& findResult = cellInternIndicesBySlot.find({intPos.x + dx, intPos.y + dy});
-                        if (findResult != cellInternIndicesBySlot.end()) {
-                            for (auto const& otherCellIndex : findResult->second) {
-                                auto& otherCell = result.previewDescription.cells.at(otherCellIndex);
-                                if (otherCellIndex != index && otherCellIndex != index - 1
-                                    && Math::length(otherCell.pos - pos) < uniformConnectingCellMaxyDistance) {
-                                    if (otherCell.connectionIndices.size() < MAX_CELL_BONDS && cellIntern.connectionIndices.size() < MAX_CELL_BONDS) {
-                                        nearbyCellIndices.emplace_back(otherCellIndex);
-                                    }
-                                }
-                            }
+                std::vector<std::pair<float, int>> nearbyCellDistancesAndIndices;
+                cellInternIndex.forEachWithinRadius(pos, uniformConnectingCellMaxyDistance, [&](int otherCellIndex, float distance) {
+                    auto& otherCell = result.previewDescription.cells.at(otherCellIndex);
+                    if (otherCellIndex != index && otherCellIndex != index - 1 && distance < uniformConnectingCellMaxyDistance) {
+                        if (otherCell.connectionIndices.size() < MAX_CELL_BONDS && cellIntern.connectionIndices.size() < MAX_CELL_BONDS) {
+                            nearbyCellDistancesAndIndices.emplace_back(distance, otherCellIndex);
                         }
                     }
-                }
+                });
 
                 //sort by distance
-                std::sort(nearbyCellIndices.begin(), nearbyCellIndices.end(), [&](int index1, int index2) {
-                    auto const& otherCell1 = result.previewDescription.cells.at(index1);
-                    auto const& otherCell2 = result.previewDescription.cells.at(index2);
-                    return Math::length(otherCell1.pos - pos) < Math::length(otherCell2.pos - pos);
-                });
+                std::sort(nearbyCellDistancesAndIndices.begin(), nearbyCellDistancesAndIndices.end());
+                std::vector<int> nearbyCellIndices;
+                for (auto const& [distance, otherCellIndex] : nearbyCellDistancesAndIndices) {
+                    nearbyCellIndices.emplace_back(otherCellIndex);
+                }
 
                 //add connections
                 for (auto const& [otherIndex, otherCellIndex] : nearbyCellIndices | boost::adaptors::indexed(0)) {
@@ -234,7 +225,7 @@ namespace
                     }
                 }
 
-                cellInternIndicesBySlot[intPos].emplace_back(toInt(result.previewDescription.cells.size()));
+                cellInternIndex.insert(pos);
                 result.previewDescription.cells.emplace_back(cellIntern);
                 ++index;
                 ++partIndex;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <string_view>
 
 #include "Colors.h"
 #include "Base/JsonParser.h"
@@ -206,3 +207,30 @@ bool PropertyParser::encodeDecodeWithEnabled(
 {
     return detail::encodeDecodeWithEnabledImpl(tree, parameter, isActivated, defaultValue, node, task);
 }
+
+//codec for the field list of the settings (see AuxiliaryDataParserService) operating on a property tree
+template <ParserTask ParserTaskValue>
+class PropertyTreeCodec
+{
+public:
+    static ParserTask constexpr Task = ParserTaskValue;
+
+    PropertyTreeCodec(boost::property_tree::ptree& tree)
+        : _tree(tree)
+    {}
+
+    template <typename T>
+    bool encodeDecode(T& parameter, T const& defaultValue, std::string_view node)
+    {
+        return PropertyParser::encodeDecode(_tree, parameter, defaultValue, std::string(node), Task);
+    }
+
+    template <typename T>
+    bool encodeDecodeWithEnabled(T& parameter, bool& isActivated, T const& defaultValue, std::string_view node)
+    {
+        return PropertyParser::encodeDecodeWithEnabled(_tree, parameter, isActivated, defaultValue, std::string(node), Task);
+    }
+
+private:
+    boost::property_tree::ptree& _tree;
+};
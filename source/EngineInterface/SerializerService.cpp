@@ -1,5 +1,12 @@
 #include "SerializerService.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <filesystem>
@@ -14,20 +21,24 @@
 #include <cereal/types/vector.hpp>
 #include <cereal/types/variant.hpp>
 #include <boost/algorithm/string/split.hpp>
-#include <boost/property_tree/json_parser.hpp>
 #include <boost/range/adaptors.hpp>
 #include <zstr.hpp>
 
 #include "Base/LoggingService.h"
+#include "Base/MetricsService.h"
+#include "Base/ParallelService.h"
 #include "Base/Resources.h"
 #include "Base/VersionChecker.h"
 
 #include "Descriptions.h"
 #include "SimulationParameters.h"
 #include "AuxiliaryDataParserService.h"
+#include "BlockCompressionService.h"
+#include "ColumnarSerializerService.h"
 #include "GenomeConstants.h"
 #include "GenomeDescriptions.h"
 #include "GenomeDescriptionService.h"
+#include "StatisticsSerializerService.h"
 
 #define SPLIT_SERIALIZATION(Classname) \
     template <class Archive> \
@@ -234,6 +245,64 @@ namespace cereal
         }
     }
 
+    //neuron data and activities are stored as vectors in this format
+    template <typename T, size_t N>
+    std::vector<T> toVector(std::array<T, N> const& data)
+    {
+        return std::vector<T>(data.begin(), data.end());
+    }
+    template <typename T, size_t N>
+    void fromVector(std::array<T, N>& data, std::vector<T> const& vector)
+    {
+        data = {};
+        std::copy_n(vector.begin(), std::min(N, vector.size()), data.begin());
+    }
+    template <class Archive, typename T, size_t N>
+    void loadSaveAsVector(SerializationTask task, Archive& ar, std::array<T, N>& data)
+    {
+        std::vector<T> vector;
+        if (task == SerializationTask::Save) {
+            vector = toVector(data);
+        }
+        ar(vector);
+        if (task == SerializationTask::Load) {
+            fromVector(data, vector);
+        }
+    }
+    template <class Archive>
+    void loadSaveAsVectors(SerializationTask task, Archive& ar, NeuronWeights& weights, NeuronBiases& biases)
+    {
+        std::vector<std::vector<float>> weightVectors;
+        std::vector<float> biasVector;
+        if (task == SerializationTask::Save) {
+            for (auto const& row : weights) {
+                weightVectors.emplace_back(toVector(row));
+            }
+            biasVector = toVector(biases);
+        }
+        ar(weightVectors, biasVector);
+        if (task == SerializationTask::Load) {
+            weights = {};
+            for (size_t row = 0; row < std::min(weights.size(), weightVectors.size()); ++row) {
+                fromVector(weights[row], weightVectors[row]);
+            }
+            fromVector(biases, biasVector);
+        }
+    }
+    void loadSave(
+        SerializationTask task,
+        std::unordered_map<int, VariantData>& loadSaveMap,
+        int key,
+        NeuronActivationFunctions& value,
+        NeuronActivationFunctions const& defaultValue)
+    {
+        auto vector = toVector(value);
+        loadSave<std::vector<int>>(task, loadSaveMap, key, vector, toVector(defaultValue));
+        if (task == SerializationTask::Load) {
+            fromVector(value, vector);
+        }
+    }
+
     template <class Archive>
     void serialize(Archive& ar, IntVector2D& data)
     {
@@ -250,10 +319,10 @@ namespace cereal
     {
         NeuronGenomeDescription defaultObject;
         auto auxiliaries = getLoadSaveMap(task, ar);
-        loadSave<std::vector<int>>(task, auxiliaries, Id_NeuronGenome_ActivationFunctions, data.activationFunctions, defaultObject.activationFunctions);
+        loadSave(task, auxiliaries, Id_NeuronGenome_ActivationFunctions, data.activationFunctions, defaultObject.activationFunctions);
         processLoadSaveMap(task, ar, auxiliaries);
 
-        ar(data.weights, data.biases);
+        loadSaveAsVectors(task, ar, data.weights, data.biases);
     }
     SPLIT_SERIALIZATION(NeuronGenomeDescription)
 
@@ -541,7 +610,7 @@ namespace cereal
     template <class Archive>
     void loadSave(SerializationTask task, Archive& ar, ActivityDescription& data)
     {
-        ar(data.channels);
+        loadSaveAsVector(task, ar, data.channels);
     }
     SPLIT_SERIALIZATION(ActivityDescription)
 
@@ -550,10 +619,10 @@ namespace cereal
     {
         NeuronDescription defaultObject;
         auto auxiliaries = getLoadSaveMap(task, ar);
-        loadSave<std::vector<int>>(task, auxiliaries, Id_Neuron_ActivationFunctions, data.activationFunctions, defaultObject.activationFunctions);
+        loadSave(task, auxiliaries, Id_Neuron_ActivationFunctions, data.activationFunctions, defaultObject.activationFunctions);
         processLoadSaveMap(task, ar, auxiliaries);
 
-        ar(data.weights, data.biases);
+        loadSaveAsVectors(task, ar, data.weights, data.biases);
     }
     SPLIT_SERIALIZATION(NeuronDescription)
 
@@ -854,23 +923,307 @@ namespace cereal
     }
 }
 
-bool SerializerService::serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data)
+namespace
 {
+    auto constexpr MaxTilesPerDimension = 16;
+
+    char const HeaderMarker[8] = {'A', 'L', 'I', 'E', 'N', 'H', 'D', 'R'};
+    uint32_t constexpr HeaderFormatVersion = 1;
+
+    //provides in-memory data in chunks such that it is written in the same way as data from a running simulation
+    class DataDescriptionReader : public _ClusteredDataReader
+    {
+    public:
+        DataDescriptionReader(ClusteredDataDescription const& data)
+            : _data(data)
+        {}
+
+        std::optional<ClusteredDataDescription> readNextChunk() override
+        {
+            ClusteredDataDescription result;
+            if (_clusterIndex < _data.clusters.size()) {
+                uint64_t numCells = 0;
+                while (_clusterIndex < _data.clusters.size() && numCells < MaxCellsPerChunk) {
+                    auto const& cluster = _data.clusters.at(_clusterIndex++);
+                    numCells += cluster.cells.size();
+                    result.clusters.emplace_back(cluster);
+                }
+                return result;
+            }
+            if (_particleIndex < _data.particles.size()) {
+                auto endIndex = std::min(_data.particles.size(), _particleIndex + MaxParticlesPerChunk);
+                result.particles.assign(_data.particles.begin() + _particleIndex, _data.particles.begin() + endIndex);
+                _particleIndex = endIndex;
+                return result;
+            }
+            return std::nullopt;
+        }
+
+    private:
+        static auto constexpr MaxCellsPerChunk = 100000;
+        static auto constexpr MaxParticlesPerChunk = 500000;
+
+        ClusteredDataDescription const& _data;
+        size_t _clusterIndex = 0;
+        size_t _particleIndex = 0;
+    };
+
+    IntVector2D calcNumTiles(IntVector2D const& worldSize)
+    {
+        if (worldSize.x <= 0 || worldSize.y <= 0) {
+            return {1, 1};
+        }
+        return {std::min(worldSize.x, MaxTilesPerDimension), std::min(worldSize.y, MaxTilesPerDimension)};
+    }
+
+    int calcTileIndex(RealVector2D const& pos, SimulationFileHeader const& header)
+    {
+        auto calcTile = [](float pos, int worldSize, int numTiles) {
+            if (worldSize <= 0) {
+                return 0;
+            }
+            return std::clamp(static_cast<int>(std::floor(pos / toFloat(worldSize) * toFloat(numTiles))), 0, numTiles - 1);
+        };
+        auto tileX = calcTile(pos.x, header.worldSize.x, header.numTiles.x);
+        auto tileY = calcTile(pos.y, header.worldSize.y, header.numTiles.y);
+        return tileX + tileY * header.numTiles.x;
+    }
+
+    //clusters are assigned to the tile of their first cell
+    std::map<int, ClusteredDataDescription> partitionIntoTiles(ClusteredDataDescription&& chunk, SimulationFileHeader const& header)
+    {
+        std::map<int, ClusteredDataDescription> result;
+        for (auto& cluster : chunk.clusters) {
+            auto tileIndex = cluster.cells.empty() ? 0 : calcTileIndex(cluster.cells.front().pos, header);
+            result[tileIndex].clusters.emplace_back(std::move(cluster));
+        }
+        for (auto& particle : chunk.particles) {
+            result[calcTileIndex(particle.pos, header)].particles.emplace_back(std::move(particle));
+        }
+        return result;
+    }
+
+    SimulationFileSegment calcSegment(int tileIndex, ClusteredDataDescription const& data, SimulationFileHeader const& header)
+    {
+        SimulationFileSegment result;
+        result.tile = {tileIndex % header.numTiles.x, tileIndex / header.numTiles.x};
+        result.boundingBoxMin = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+        result.boundingBoxMax = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+        auto extendBoundingBox = [&](RealVector2D const& pos) {
+            result.boundingBoxMin = {std::min(result.boundingBoxMin.x, pos.x), std::min(result.boundingBoxMin.y, pos.y)};
+            result.boundingBoxMax = {std::max(result.boundingBoxMax.x, pos.x), std::max(result.boundingBoxMax.y, pos.y)};
+        };
+        for (auto const& cluster : data.clusters) {
+            for (auto const& cell : cluster.cells) {
+                extendBoundingBox(cell.pos);
+            }
+            result.numCells += cluster.cells.size();
+        }
+        for (auto const& particle : data.particles) {
+            extendBoundingBox(particle.pos);
+        }
+        result.numClusters = data.clusters.size();
+        result.numParticles = data.particles.size();
+        return result;
+    }
+
+    bool isInside(RealVector2D const& pos, RealVector2D const& topLeft, RealVector2D const& bottomRight)
+    {
+        return pos.x >= topLeft.x && pos.x <= bottomRight.x && pos.y >= topLeft.y && pos.y <= bottomRight.y;
+    }
+
+    bool intersects(SimulationFileSegment const& segment, RealVector2D const& topLeft, RealVector2D const& bottomRight)
+    {
+        return segment.boundingBoxMin.x <= bottomRight.x && segment.boundingBoxMax.x >= topLeft.x && segment.boundingBoxMin.y <= bottomRight.y
+            && segment.boundingBoxMax.y >= topLeft.y;
+    }
+
+    void addObjectsInside(ClusteredDataDescription& target, ClusteredDataDescription&& source, RealVector2D const& topLeft, RealVector2D const& bottomRight)
+    {
+        for (auto& cluster : source.clusters) {
+            if (std::ranges::any_of(cluster.cells, [&](CellDescription const& cell) { return isInside(cell.pos, topLeft, bottomRight); })) {
+                target.clusters.emplace_back(std::move(cluster));
+            }
+        }
+        for (auto& particle : source.particles) {
+            if (isInside(particle.pos, topLeft, bottomRight)) {
+                target.particles.emplace_back(std::move(particle));
+            }
+        }
+    }
+
+    ClusteredDataDescription deserializeSegment(std::string const& filename, SimulationFileSegment const& segment)
+    {
+        std::string segmentData;
+        {
+            std::ifstream stream(filename, std::ios::binary);
+            BlockCompressionService::decompressBlocks(segmentData, stream, segment.blockOffset, segment.numBlocks);
+        }
+
+        //the archive header is only written at the beginning of the main data and is therefore restored here
+        std::stringstream stream;
+        {
+            cereal::PortableBinaryOutputArchive headerArchive(stream);
+        }
+        stream.write(segmentData.data(), segmentData.size());
+
+        cereal::PortableBinaryInputArchive archive(stream);
+        ClusteredDataDescription result;
+        if (!ColumnarSerializerService::deserializeChunk(result, archive)) {
+            throw std::runtime_error("Invalid segment.");
+        }
+        return result;
+    }
+
+    template <typename T>
+    void write(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void read(std::istream& stream, T& value)
+    {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+        if (!stream) {
+            throw std::runtime_error("Header incomplete.");
+        }
+    }
+}
+
+bool SerializerService::serializeSimulationToFiles(
+    std::string const& filename,
+    DeserializedSimulation const& data,
+    CompressionSettings const& compressionSettings)
+{
+    return serializeSimulationToFiles(filename, data, std::make_shared<DataDescriptionReader>(data.mainData), compressionSettings);
+}
+
+bool SerializerService::serializeSimulationToFiles(
+    std::string const& filename,
+    DeserializedSimulation const& data,
+    ClusteredDataReader const& mainDataReader,
+    CompressionSettings const& compressionSettings)
+{
+    MEASURE_SCOPE("serializer.saveSimulation");
     try {
         log(Priority::Important, "save simulation to " + filename);
-        std::filesystem::path settingsFilename(filename);
-        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
-        std::filesystem::path statisticsFilename(filename);
-        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
-
         {
-            zstr::ofstream stream(filename, std::ios::binary);
+            std::ofstream stream(filename, std::ios::binary);
             if (!stream) {
                 return false;
             }
-            serializeDataDescription(data.mainData, stream);
+            SimulationFileHeader header;
+            header.worldSize = {data.auxiliaryData.generalSettings.worldSizeX, data.auxiliaryData.generalSettings.worldSizeY};
+            header.timestep = data.auxiliaryData.timestep;
+            header.numTiles = calcNumTiles(header.worldSize);
+            serializeDataDescription(mainDataReader, header, stream, compressionSettings);
+            serializeSimulationFileHeader(header, stream);
+        }
+        return serializeSimulationWithoutMainDataToFiles(filename, data);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename)
+{
+    MEASURE_SCOPE("serializer.loadSimulation");
+    try {
+        log(Priority::Important, "load simulation from " + filename);
+        data.snapshotFilename.reset();
+        if (isSnapshotFile(filename)) {
+            data.mainData.clear();
+            data.snapshotFilename = filename;
+        } else if (!deserializeDataDescription(data.mainData, filename)) {
+            return false;
+        }
+        return deserializeSimulationWithoutMainDataFromFiles(data, filename);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::isSnapshotFile(std::string const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    char marker[sizeof(SnapshotFileMarker)];
+    if (!stream.read(marker, sizeof(marker))) {
+        return false;
+    }
+    return std::memcmp(marker, SnapshotFileMarker, sizeof(marker)) == 0;
+}
+
+bool SerializerService::deserializeSimulationHeaderFromFile(SimulationFileHeader& header, std::string const& filename)
+{
+    try {
+        std::ifstream stream(filename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        return deserializeSimulationFileHeader(header, stream);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::deserializeSimulationRegionFromFiles(
+    DeserializedSimulation& data,
+    std::string const& filename,
+    RealVector2D const& topLeft,
+    RealVector2D const& bottomRight)
+{
+    MEASURE_SCOPE("serializer.loadSimulationRegion");
+    try {
+        log(Priority::Important, "load simulation region from " + filename);
+        data.mainData.clear();
+
+        std::ifstream stream(filename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        SimulationFileHeader header;
+        auto hasHeader = deserializeSimulationFileHeader(header, stream);
+
+        //compatibility with older versions
+        //>>>
+        if (!hasHeader) {
+            ClusteredDataDescription mainData;
+            stream.clear();
+            stream.seekg(0);
+            deserializeDataDescription(mainData, stream);
+            addObjectsInside(data.mainData, std::move(mainData), topLeft, bottomRight);
+            return deserializeSimulationWithoutMainDataFromFiles(data, filename);
         }
+        //<<<
+
+        std::vector<SimulationFileSegment> segments;
+        std::ranges::copy_if(header.segments, std::back_inserter(segments), [&](auto const& segment) { return intersects(segment, topLeft, bottomRight); });
+
+        std::vector<ClusteredDataDescription> chunks(segments.size());
+        ParallelService::forEach(segments.size(), [&](uint64_t index) {
+            MEASURE_SCOPE("serializer.loadSegment");
+            chunks.at(index) = deserializeSegment(filename, segments.at(index));
+        });
+        for (auto& chunk : chunks) {
+            addObjectsInside(data.mainData, std::move(chunk), topLeft, bottomRight);
+        }
+        return deserializeSimulationWithoutMainDataFromFiles(data, filename);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::serializeSimulationWithoutMainDataToFiles(std::string const& filename, DeserializedSimulation const& data)
+{
+    try {
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+        std::filesystem::path statisticsFilename(filename);
+        statisticsFilename.replace_extension(std::filesystem::path(".statistics.bin"));
+
         {
+            MEASURE_SCOPE("serializer.saveAuxiliaryData");
             std::ofstream stream(settingsFilename.string(), std::ios::binary);
             if (!stream) {
                 return false;
@@ -878,11 +1231,8 @@ bool SerializerService::serializeSimulationToFiles(std::string const& filename,
             serializeAuxiliaryData(data.auxiliaryData, stream);
         }
         {
-            std::ofstream stream(statisticsFilename.string(), std::ios::binary);
-            if (!stream) {
-                return false;
-            }
-            serializeStatistics(data.statistics, stream);
+            MEASURE_SCOPE("serializer.saveStatistics");
+            StatisticsSerializerService::serializeToFile(statisticsFilename.string(), data.statistics);
         }
         return true;
     } catch (...) {
@@ -890,31 +1240,38 @@ bool SerializerService::serializeSimulationToFiles(std::string const& filename,
     }
 }
 
-bool SerializerService::deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename)
+bool SerializerService::deserializeSimulationWithoutMainDataFromFiles(DeserializedSimulation& data, std::string const& filename)
 {
     try {
-        log(Priority::Important, "load simulation from " + filename);
         std::filesystem::path settingsFilename(filename);
         settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
         std::filesystem::path statisticsFilename(filename);
-        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
+        statisticsFilename.replace_extension(std::filesystem::path(".statistics.bin"));
 
-        if (!deserializeDataDescription(data.mainData, filename)) {
-            return false;
-        }
         {
+            MEASURE_SCOPE("serializer.loadAuxiliaryData");
             std::ifstream stream(settingsFilename.string(), std::ios::binary);
             if (!stream) {
                 return false;
             }
             deserializeAuxiliaryData(data.auxiliaryData, stream);
         }
+
+        //compatibility with older versions which only have a *.statistics.csv file
+        //>>>
+        if (!std::filesystem::exists(statisticsFilename)) {
+            statisticsFilename.replace_extension(std::filesystem::path(".csv"));
+        }
+        //<<<
         {
+            MEASURE_SCOPE("serializer.loadStatistics");
             std::ifstream stream(statisticsFilename.string(), std::ios::binary);
             if (!stream) {
                 return true;
             }
-            deserializeStatistics(data.statistics, stream);
+            StatisticsHistoryData statistics;
+            deserializeStatistics(statistics, stream);
+            data.statistics = std::move(statistics);
         }
         return true;
     } catch (...) {
@@ -922,18 +1279,68 @@ bool SerializerService::deserializeSimulationFromFiles(DeserializedSimulation& d
     }
 }
 
-bool SerializerService::serializeSimulationToStrings(SerializedSimulation& output, DeserializedSimulation const& input)
+namespace
+{
+    std::vector<std::filesystem::path> getSimulationFilenames(std::filesystem::path const& filename)
+    {
+        std::vector<std::filesystem::path> result{filename};
+        for (auto const& extension : {".settings.json", ".statistics.bin", ".statistics.csv"}) {
+            result.emplace_back(std::filesystem::path(filename).replace_extension(std::filesystem::path(extension)));
+        }
+        return result;
+    }
+
+    std::filesystem::path getSlotFilename(std::string const& filename, int slot)
+    {
+        std::filesystem::path result(filename);
+        if (slot > 0) {
+            result.replace_extension(std::filesystem::path("." + std::to_string(slot) + std::filesystem::path(filename).extension().string()));
+        }
+        return result;
+    }
+}
+
+void SerializerService::rotateSimulationFiles(std::string const& filename, int numSlots)
+{
+    if (numSlots <= 1) {
+        return;
+    }
+    std::error_code errorCode;
+    for (int slot = numSlots - 1; slot > 0; --slot) {
+        auto sourceFiles = getSimulationFilenames(getSlotFilename(filename, slot - 1));
+        auto targetFiles = getSimulationFilenames(getSlotFilename(filename, slot));
+        for (size_t i = 0; i < sourceFiles.size(); ++i) {
+            std::filesystem::remove(targetFiles.at(i), errorCode);
+            if (std::filesystem::exists(sourceFiles.at(i), errorCode)) {
+                std::filesystem::rename(sourceFiles.at(i), targetFiles.at(i));
+            }
+        }
+    }
+}
+
+uint64_t SerializerService::getSimulationFilesSize(std::string const& filename)
+{
+    uint64_t result = 0;
+    std::error_code errorCode;
+    for (auto const& file : getSimulationFilenames(filename)) {
+        auto size = std::filesystem::file_size(file, errorCode);
+        if (!errorCode) {
+            result += size;
+        }
+    }
+    return result;
+}
+
+bool SerializerService::serializeSimulationToStrings(
+    SerializedSimulation& output,
+    DeserializedSimulation const& input,
+    CompressionSettings const& compressionSettings)
 {
     try {
         {
-            std::stringstream stdStream;
-            zstr::ostream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
-            serializeDataDescription(input.mainData, stream);
-            stream.flush();
-            output.mainData = stdStream.str();
+            std::stringstream stream;
+            serializeDataDescription(input.mainData, stream, compressionSettings);
+            output.mainData = stream.str();
         }
         {
             std::stringstream stream;
@@ -955,11 +1362,7 @@ bool SerializerService::deserializeSimulationFromStrings(DeserializedSimulation&
 {
     try {
         {
-            std::stringstream stdStream(input.mainData);
-            zstr::istream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
+            std::stringstream stream(input.mainData);
             deserializeDataDescription(output.mainData, stream);
         }
         {
@@ -968,7 +1371,9 @@ bool SerializerService::deserializeSimulationFromStrings(DeserializedSimulation&
         }
         {
             std::stringstream stream(input.statistics);
-            deserializeStatistics(output.statistics, stream);
+            StatisticsHistoryData statistics;
+            deserializeStatistics(statistics, stream);
+            output.statistics = std::move(statistics);
         }
         return true;
     } catch (...) {
@@ -976,7 +1381,10 @@ bool SerializerService::deserializeSimulationFromStrings(DeserializedSimulation&
     }
 }
 
-bool SerializerService::serializeGenomeToFile(std::string const& filename, std::vector<uint8_t> const& genome)
+bool SerializerService::serializeGenomeToFile(
+    std::string const& filename,
+    std::vector<uint8_t> const& genome,
+    CompressionSettings const& compressionSettings)
 {
     try {
         log(Priority::Important, "save genome to " + filename);
@@ -986,11 +1394,11 @@ bool SerializerService::serializeGenomeToFile(std::string const& filename, std::
             return false;
         }
 
-        zstr::ofstream stream(filename, std::ios::binary);
+        std::ofstream stream(filename, std::ios::binary);
         if (!stream) {
             return false;
         }
-        serializeDataDescription(data, stream);
+        serializeDataDescription(data, stream, compressionSettings);
 
         return true;
     } catch (...) {
@@ -1015,23 +1423,20 @@ bool SerializerService::deserializeGenomeFromFile(std::vector<uint8_t>& genome,
     }
 }
 
-bool SerializerService::serializeGenomeToString(std::string& output, std::vector<uint8_t> const& input)
+bool SerializerService::serializeGenomeToString(
+    std::string& output,
+    std::vector<uint8_t> const& input,
+    CompressionSettings const& compressionSettings)
 {
     try {
-        std::stringstream stdStream;
-        zstr::ostream stream(stdStream, std::ios::binary);
-        if (!stream) {
-            return false;
-        }
-
         ClusteredDataDescription data;
         if (!wrapGenome(data, input)) {
             return false;
         }
 
-        serializeDataDescription(data, stream);
-        stream.flush();
-        output = stdStream.str();
+        std::stringstream stream;
+        serializeDataDescription(data, stream, compressionSettings);
+        output = stream.str();
         return true;
     } catch (...) {
         return false;
@@ -1041,12 +1446,7 @@ bool SerializerService::serializeGenomeToString(std::string& output, std::vector
 bool SerializerService::deserializeGenomeFromString(std::vector<uint8_t>& output, std::string const& input)
 {
     try {
-        std::stringstream stdStream(input);
-        zstr::istream stream(stdStream, std::ios::binary);
-        if (!stream) {
-            return false;
-        }
-
+        std::stringstream stream(input);
         ClusteredDataDescription data;
         deserializeDataDescription(data, stream);
 
@@ -1091,7 +1491,7 @@ bool SerializerService::deserializeSimulationParametersFromFile(SimulationParame
     }
 }
 
-bool SerializerService::serializeStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics)
+bool SerializerService::serializeStatisticsToFile(std::string const& filename, std::span<DataPointCollection const> statistics)
 {
     try {
         log(Priority::Important, "save statistics history to " + filename);
@@ -1099,7 +1499,7 @@ bool SerializerService::serializeStatisticsToFile(std::string const& filename, S
         if (!stream) {
             return false;
         }
-        serializeStatistics(statistics, stream);
+        serializeStatisticsToCsv(statistics, stream);
         stream.close();
         return true;
     } catch (...) {
@@ -1107,14 +1507,17 @@ bool SerializerService::serializeStatisticsToFile(std::string const& filename, S
     }
 }
 
-bool SerializerService::serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content)
+bool SerializerService::serializeContentToFile(
+    std::string const& filename,
+    ClusteredDataDescription const& content,
+    CompressionSettings const& compressionSettings)
 {
     try {
-        zstr::ofstream fileStream(filename, std::ios::binary);
+        std::ofstream fileStream(filename, std::ios::binary);
         if (!fileStream) {
             return false;
         }
-        serializeDataDescription(content, fileStream);
+        serializeDataDescription(content, fileStream, compressionSettings);
 
         return true;
     } catch (...) {
@@ -1134,16 +1537,66 @@ bool SerializerService::deserializeContentFromFile(ClusteredDataDescription& con
     }
 }
 
-void SerializerService::serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream)
+void SerializerService::serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream, CompressionSettings const& compressionSettings)
 {
-    cereal::PortableBinaryOutputArchive archive(stream);
-    archive(Const::ProgramVersion);
-    archive(data);
+    BlockCompressionOutputStream compressedStream(stream, compressionSettings);
+    serializeUncompressedDataDescription(data, compressedStream);
+    compressedStream.finish();
+}
+
+void SerializerService::serializeDataDescription(
+    ClusteredDataReader const& dataReader,
+    SimulationFileHeader& header,
+    std::ostream& stream,
+    CompressionSettings const& compressionSettings)
+{
+    header.segments.clear();
+    std::vector<uint64_t> firstBlockIndices;
+
+    BlockCompressionOutputStream compressedStream(stream, compressionSettings);
+    {
+        cereal::PortableBinaryOutputArchive archive(compressedStream);
+        archive(ColumnarSerializerService::FormatMarker);
+        archive(ColumnarSerializerService::FormatVersion);
+        archive(Const::ProgramVersion);
+
+        //the next chunk is converted while the current one is serialized, compression takes place on the worker threads of compressedStream
+        auto readNextChunk = [&] {
+            return std::async(std::launch::async, [&] {
+                MEASURE_SCOPE("serializer.readChunk");
+                return dataReader->readNextChunk();
+            });
+        };
+        auto nextChunk = readNextChunk();
+        while (auto chunk = nextChunk.get()) {
+            nextChunk = readNextChunk();
+
+            //each tile of a chunk is written as a separate chunk in its own blocks such that it can be loaded on its own
+            for (auto const& [tileIndex, tileData] : partitionIntoTiles(std::move(*chunk), header)) {
+                header.segments.emplace_back(calcSegment(tileIndex, tileData, header));
+                MEASURE_SCOPE("serializer.writeChunk");
+                auto firstBlockIndex = compressedStream.startNewBlock();
+                ColumnarSerializerService::serializeChunk(archive, tileData);
+                header.segments.back().numBlocks = compressedStream.startNewBlock() - firstBlockIndex;
+                firstBlockIndices.emplace_back(firstBlockIndex);
+            }
+        }
+        ColumnarSerializerService::serializeEnd(archive);
+    }
+    {
+        MEASURE_SCOPE("serializer.finishCompression");
+        compressedStream.finish();
+    }
+
+    auto const& blockOffsets = compressedStream.getBlockOffsets();
+    for (size_t i = 0; i < header.segments.size(); ++i) {
+        header.segments.at(i).blockOffset = blockOffsets.at(firstBlockIndices.at(i));
+    }
 }
 
 bool SerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::string const& filename)
 {
-    zstr::ifstream stream(filename, std::ios::binary);
+    std::ifstream stream(filename, std::ios::binary);
     if (!stream) {
         return false;
     }
@@ -1152,42 +1605,168 @@ bool SerializerService::deserializeDataDescription(ClusteredDataDescription& dat
 }
 
 void SerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream)
+{
+    if (BlockCompressionService::isBlockCompressed(stream)) {
+        std::string uncompressedData;
+        {
+            MEASURE_SCOPE("serializer.decompress");
+            BlockCompressionService::decompress(uncompressedData, stream);
+        }
+        MEASURE_SCOPE("serializer.decode");
+        std::stringstream uncompressedStream(uncompressedData);
+        deserializeUncompressedDataDescription(data, uncompressedStream);
+    }
+
+    //compatibility with older versions
+    //>>>
+    else {
+        zstr::istream uncompressedStream(stream, std::ios::binary);
+        deserializeUncompressedDataDescription(data, uncompressedStream);
+    }
+    //<<<
+}
+
+void SerializerService::serializeUncompressedDataDescription(ClusteredDataDescription const& data, std::ostream& stream)
+{
+    cereal::PortableBinaryOutputArchive archive(stream);
+    archive(ColumnarSerializerService::FormatMarker);
+    archive(ColumnarSerializerService::FormatVersion);
+    archive(Const::ProgramVersion);
+    ColumnarSerializerService::serialize(archive, data);
+}
+
+void SerializerService::deserializeUncompressedDataDescription(ClusteredDataDescription& data, std::istream& stream)
 {
     cereal::PortableBinaryInputArchive archive(stream);
     std::string version;
     archive(version);
 
+    auto isColumnarFormat = version == ColumnarSerializerService::FormatMarker;
+    uint32_t formatVersion = 0;
+    if (isColumnarFormat) {
+        archive(formatVersion);
+        if (formatVersion > ColumnarSerializerService::FormatVersion) {
+            throw std::runtime_error("Format version not supported.");
+        }
+        archive(version);
+    }
+
     if (!VersionChecker::isVersionValid(version)) {
         throw std::runtime_error("No version detected.");
     }
     if (VersionChecker::isVersionOutdated(version)) {
         throw std::runtime_error("Version not supported.");
     }
-    archive(data);
+    if (isColumnarFormat) {
+        ColumnarSerializerService::deserialize(data, archive, formatVersion);
+    }
+
+    //compatibility with older versions
+    //>>>
+    else {
+        archive(data);
+    }
+    //<<<
+}
+
+//the header is appended to the compressed main data and is followed by its size and the marker
+void SerializerService::serializeSimulationFileHeader(SimulationFileHeader const& header, std::ostream& stream)
+{
+    auto startPos = stream.tellp();
+    write(stream, HeaderFormatVersion);
+    write(stream, header.worldSize.x);
+    write(stream, header.worldSize.y);
+    write(stream, header.timestep);
+    write(stream, header.numTiles.x);
+    write(stream, header.numTiles.y);
+    write(stream, static_cast<uint64_t>(header.segments.size()));
+    for (auto const& segment : header.segments) {
+        write(stream, segment.tile.x);
+        write(stream, segment.tile.y);
+        write(stream, segment.boundingBoxMin.x);
+        write(stream, segment.boundingBoxMin.y);
+        write(stream, segment.boundingBoxMax.x);
+        write(stream, segment.boundingBoxMax.y);
+        write(stream, segment.numClusters);
+        write(stream, segment.numCells);
+        write(stream, segment.numParticles);
+        write(stream, segment.blockOffset);
+        write(stream, segment.numBlocks);
+    }
+    write(stream, static_cast<uint64_t>(stream.tellp() - startPos));
+    stream.write(HeaderMarker, sizeof(HeaderMarker));
+    if (!stream) {
+        throw std::runtime_error("Could not write header.");
+    }
+}
+
+bool SerializerService::deserializeSimulationFileHeader(SimulationFileHeader& header, std::istream& stream)
+{
+    auto constexpr TrailerSize = static_cast<std::streamoff>(sizeof(uint64_t) + sizeof(HeaderMarker));
+    stream.seekg(0, std::ios::end);
+    auto fileSize = static_cast<std::streamoff>(stream.tellg());
+    if (fileSize < TrailerSize) {
+        return false;
+    }
+    stream.seekg(fileSize - TrailerSize);
+    uint64_t headerSize = 0;
+    char marker[sizeof(HeaderMarker)];
+    read(stream, headerSize);
+    read(stream, marker);
+    if (std::memcmp(marker, HeaderMarker, sizeof(HeaderMarker)) != 0 || static_cast<std::streamoff>(headerSize) > fileSize - TrailerSize) {
+        return false;
+    }
+
+    stream.seekg(fileSize - TrailerSize - static_cast<std::streamoff>(headerSize));
+    uint32_t formatVersion = 0;
+    read(stream, formatVersion);
+    if (formatVersion > HeaderFormatVersion) {
+        throw std::runtime_error("Header version not supported.");
+    }
+    read(stream, header.worldSize.x);
+    read(stream, header.worldSize.y);
+    read(stream, header.timestep);
+    read(stream, header.numTiles.x);
+    read(stream, header.numTiles.y);
+    uint64_t numSegments = 0;
+    read(stream, numSegments);
+    header.segments.resize(numSegments);
+    for (auto& segment : header.segments) {
+        read(stream, segment.tile.x);
+        read(stream, segment.tile.y);
+        read(stream, segment.boundingBoxMin.x);
+        read(stream, segment.boundingBoxMin.y);
+        read(stream, segment.boundingBoxMax.x);
+        read(stream, segment.boundingBoxMax.y);
+        read(stream, segment.numClusters);
+        read(stream, segment.numCells);
+        read(stream, segment.numParticles);
+        read(stream, segment.blockOffset);
+        read(stream, segment.numBlocks);
+    }
+    return true;
 }
 
 void SerializerService::serializeAuxiliaryData(AuxiliaryData const& auxiliaryData, std::ostream& stream)
 {
-    boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::encodeAuxiliaryData(auxiliaryData));
+    stream << AuxiliaryDataParserService::encodeAuxiliaryDataToJson(auxiliaryData);
 }
 
 void SerializerService::deserializeAuxiliaryData(AuxiliaryData& auxiliaryData, std::istream& stream)
 {
-    boost::property_tree::ptree tree;
-    boost::property_tree::read_json(stream, tree);
-    auxiliaryData = AuxiliaryDataParserService::decodeAuxiliaryData(tree);
+    std::string json{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    auxiliaryData = AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json);
 }
 
 void SerializerService::serializeSimulationParameters(SimulationParameters const& parameters, std::ostream& stream)
 {
-    boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::encodeSimulationParameters(parameters));
+    stream << AuxiliaryDataParserService::encodeSimulationParametersToJson(parameters);
 }
 
 void SerializerService::deserializeSimulationParameters(SimulationParameters& parameters, std::istream& stream)
 {
-    boost::property_tree::ptree tree;
-    boost::property_tree::read_json(stream, tree);
-    parameters = AuxiliaryDataParserService::decodeSimulationParameters(tree);
+    std::string json{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    parameters = AuxiliaryDataParserService::decodeSimulationParametersFromJson(json);
 }
 
 namespace
@@ -1262,7 +1841,21 @@ namespace
     }
 }
 
-void SerializerService::serializeStatistics(StatisticsHistoryData const& statistics, std::ostream& stream)
+void SerializerService::serializeStatistics(std::span<DataPointCollection const> statistics, std::ostream& stream)
+{
+    StatisticsSerializerService::serialize(statistics, stream);
+}
+
+void SerializerService::deserializeStatistics(StatisticsHistoryData& statistics, std::istream& stream)
+{
+    if (StatisticsSerializerService::isBinaryFormat(stream)) {
+        StatisticsSerializerService::deserialize(statistics, stream);
+    } else {
+        deserializeStatisticsFromCsv(statistics, stream);
+    }
+}
+
+void SerializerService::serializeStatisticsToCsv(std::span<DataPointCollection const> statistics, std::ostream& stream)
 {
     //header row
     stream << "Time step";
@@ -1308,7 +1901,7 @@ void SerializerService::serializeStatistics(StatisticsHistoryData const& statist
     }
 }
 
-void SerializerService::deserializeStatistics(StatisticsHistoryData& statistics, std::istream& stream)
+void SerializerService::deserializeStatisticsFromCsv(StatisticsHistoryData& statistics, std::istream& stream)
 {
     statistics.clear();
 
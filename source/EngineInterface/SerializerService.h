@@ -1,41 +1,106 @@
 #pragma once
 
+#include <span>
+
 #include "Base/Definitions.h"
 
 #include "Definitions.h"
 #include "AuxiliaryData.h"
+#include "BlockCompressionService.h"
+#include "ClusteredDataReader.h"
 #include "Descriptions.h"
 #include "StatisticsHistory.h"
 #include "DeserializedSimulation.h"
 #include "SerializedSimulation.h"
+#include "SimulationFileHeader.h"
 
 class SerializerService
 {
 public:
-    static bool serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data);
+    //marker at the beginning of snapshot files written by SimulationFacade::saveSimulationDataToSnapshotFile
+    static char constexpr SnapshotFileMarker[8] = {'A', 'L', 'I', 'E', 'N', 'T', 'O', '\0'};
+
+    static bool serializeSimulationToFiles(
+        std::string const& filename,
+        DeserializedSimulation const& data,
+        CompressionSettings const& compressionSettings = CompressionSettings());
+    //data.mainData is ignored, instead the main data is read chunk by chunk while previous chunks are serialized, compressed and written
+    static bool serializeSimulationToFiles(
+        std::string const& filename,
+        DeserializedSimulation const& data,
+        ClusteredDataReader const& mainDataReader,
+        CompressionSettings const& compressionSettings = CompressionSettings());
+    //for snapshot files, data.snapshotFilename is set instead of data.mainData so that the data can be fed directly to the engine
     static bool deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename);
+    static bool isSnapshotFile(std::string const& filename);
+
+    //reads only the header at the end of the simulation file, returns false for files of older versions without header
+    static bool deserializeSimulationHeaderFromFile(SimulationFileHeader& header, std::string const& filename);
+
+    //loads the clusters with at least one cell in the rectangle and the particles in the rectangle
+    //only the segments of the main data whose bounding boxes intersect the rectangle are decompressed
+    static bool deserializeSimulationRegionFromFiles(
+        DeserializedSimulation& data,
+        std::string const& filename,
+        RealVector2D const& topLeft,
+        RealVector2D const& bottomRight);
 
-    static bool serializeSimulationToStrings(SerializedSimulation& output, DeserializedSimulation const& input);
+    //only the *.settings.json and *.statistics.bin (or *.statistics.csv from older versions) files belonging to filename are processed
+    static bool serializeSimulationWithoutMainDataToFiles(std::string const& filename, DeserializedSimulation const& data);
+    static bool deserializeSimulationWithoutMainDataFromFiles(DeserializedSimulation& data, std::string const& filename);
+
+    //moves the files of a simulation to the next slot: filename (slot 0) to filename.1 (in front of the extension), filename.1 to filename.2 and so on
+    //the files in the last slot (numSlots - 1) are deleted, for numSlots <= 1 nothing happens
+    static void rotateSimulationFiles(std::string const& filename, int numSlots);
+
+    //total size of all files belonging to a simulation
+    static uint64_t getSimulationFilesSize(std::string const& filename);
+
+    static bool serializeSimulationToStrings(
+        SerializedSimulation& output,
+        DeserializedSimulation const& input,
+        CompressionSettings const& compressionSettings = CompressionSettings());
     static bool deserializeSimulationFromStrings(DeserializedSimulation& output, SerializedSimulation const& input);
 
-    static bool serializeGenomeToFile(std::string const& filename, std::vector<uint8_t> const& genome);
+    static bool serializeGenomeToFile(
+        std::string const& filename,
+        std::vector<uint8_t> const& genome,
+        CompressionSettings const& compressionSettings = CompressionSettings());
     static bool deserializeGenomeFromFile(std::vector<uint8_t>& genome, std::string const& filename);
 
-    static bool serializeGenomeToString(std::string& output, std::vector<uint8_t> const& input);
+    static bool serializeGenomeToString(
+        std::string& output,
+        std::vector<uint8_t> const& input,
+        CompressionSettings const& compressionSettings = CompressionSettings());
     static bool deserializeGenomeFromString(std::vector<uint8_t>& output, std::string const& input);
 
     static bool serializeSimulationParametersToFile(std::string const& filename, SimulationParameters const& parameters);
     static bool deserializeSimulationParametersFromFile(SimulationParameters& parameters, std::string const& filename);
 
-    static bool serializeStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics);
+    //exports the statistics as CSV
+    static bool serializeStatisticsToFile(std::string const& filename, std::span<DataPointCollection const> statistics);
 
-    static bool serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content);
+    static bool serializeContentToFile(
+        std::string const& filename,
+        ClusteredDataDescription const& content,
+        CompressionSettings const& compressionSettings = CompressionSettings());
     static bool deserializeContentFromFile(ClusteredDataDescription& content, std::string const& filename);
 
 private:
-    static void serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream);
+    static void serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream, CompressionSettings const& compressionSettings);
+    //header.segments is filled according to header.worldSize and header.numTiles
+    static void serializeDataDescription(
+        ClusteredDataReader const& dataReader,
+        SimulationFileHeader& header,
+        std::ostream& stream,
+        CompressionSettings const& compressionSettings);
     static bool deserializeDataDescription(ClusteredDataDescription& data, std::string const& filename);
     static void deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream);
+    static void serializeUncompressedDataDescription(ClusteredDataDescription const& data, std::ostream& stream);
+    static void deserializeUncompressedDataDescription(ClusteredDataDescription& data, std::istream& stream);
+
+    static void serializeSimulationFileHeader(SimulationFileHeader const& header, std::ostream& stream);
+    static bool deserializeSimulationFileHeader(SimulationFileHeader& header, std::istream& stream);
 
     static void serializeAuxiliaryData(AuxiliaryData const& auxiliaryData, std::ostream& stream);
     static void deserializeAuxiliaryData(AuxiliaryData& auxiliaryData, std::istream& stream);
@@ -43,8 +108,10 @@ private:
     static void serializeSimulationParameters(SimulationParameters const& parameters, std::ostream& stream);
     static void deserializeSimulationParameters(SimulationParameters& parameters, std::istream& stream);
 
-    static void serializeStatistics(StatisticsHistoryData const& statistics, std::ostream& stream);
+    static void serializeStatistics(std::span<DataPointCollection const> statistics, std::ostream& stream);
     static void deserializeStatistics(StatisticsHistoryData& statistics, std::istream& stream);
+    static void serializeStatisticsToCsv(std::span<DataPointCollection const> statistics, std::ostream& stream);
+    static void deserializeStatisticsFromCsv(StatisticsHistoryData& statistics, std::istream& stream);
 
     static bool wrapGenome(ClusteredDataDescription& output, std::vector<uint8_t> const& input);
     static bool unwrapGenome(std::vector<uint8_t>& output, ClusteredDataDescription const& input);
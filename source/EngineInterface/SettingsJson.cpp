@@ -0,0 +1,417 @@
+#include "SettingsJson.h"
+
+#include <stdexcept>
+
+namespace
+{
+    //same escaping as in boost::property_tree::json_parser::write_json
+    void appendEscaped(std::string& output, std::string_view text)
+    {
+        for (auto const& ch : text) {
+            auto c = static_cast<unsigned char>(ch);
+            if (c == 0x20 || c == 0x21 || (c >= 0x23 && c <= 0x2e) || (c >= 0x30 && c <= 0x5b) || c >= 0x5d) {
+                output.push_back(ch);
+            } else if (ch == '\b') {
+                output.append("\\b");
+            } else if (ch == '\f') {
+                output.append("\\f");
+            } else if (ch == '\n') {
+                output.append("\\n");
+            } else if (ch == '\r') {
+                output.append("\\r");
+            } else if (ch == '\t') {
+                output.append("\\t");
+            } else if (ch == '/') {
+                output.append("\\/");
+            } else if (ch == '"') {
+                output.append("\\\"");
+            } else if (ch == '\\') {
+                output.append("\\\\");
+            } else {
+                char const* hexDigits = "0123456789ABCDEF";
+                output.append("\\u00");
+                output.push_back(hexDigits[c / 16]);
+                output.push_back(hexDigits[c % 16]);
+            }
+        }
+    }
+
+    //recursive descent parser for JSON, the values are stored under their paths as in a property tree:
+    //keys are joined by '.', array elements have empty keys, numbers and literals are stored as text
+    template <typename Map>
+    struct JsonTreeParser
+    {
+        std::string_view json;
+        Map& valueByPath;
+        size_t pos = 0;
+
+        [[noreturn]] void fail(char const* message) const
+        {
+            throw std::runtime_error(std::string("Invalid settings JSON at position ") + std::to_string(pos) + ": " + message);
+        }
+
+        void skipWhitespace()
+        {
+            while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\n' || json[pos] == '\r')) {
+                ++pos;
+            }
+        }
+
+        void expect(char c)
+        {
+            skipWhitespace();
+            if (pos >= json.size() || json[pos] != c) {
+                fail("Unexpected character.");
+            }
+            ++pos;
+        }
+
+        void parseValue(std::string& path)
+        {
+            skipWhitespace();
+            if (pos >= json.size()) {
+                fail("Unexpected end of input.");
+            }
+            auto c = json[pos];
+            if (c == '{') {
+                valueByPath.emplace(path, std::string());
+                parseObject(path);
+            } else if (c == '[') {
+                valueByPath.emplace(path, std::string());
+                parseArray(path);
+            } else if (c == '"') {
+                std::string value;
+                parseString(value);
+                valueByPath.emplace(path, std::move(value));
+            } else {
+                valueByPath.emplace(path, std::string(parseLiteral()));
+            }
+        }
+
+        void parseObject(std::string& path)
+        {
+            ++pos;
+            skipWhitespace();
+            if (pos < json.size() && json[pos] == '}') {
+                ++pos;
+                return;
+            }
+            auto pathSize = path.size();
+            std::string key;
+            while (true) {
+                skipWhitespace();
+                key.clear();
+                parseString(key);
+                expect(':');
+                if (pathSize > 0) {
+                    path.push_back('.');
+                }
+                path.append(key);
+                parseValue(path);
+                path.resize(pathSize);
+
+                skipWhitespace();
+                if (pos < json.size() && json[pos] == ',') {
+                    ++pos;
+                    continue;
+                }
+                expect('}');
+                return;
+            }
+        }
+
+        void parseArray(std::string& path)
+        {
+            ++pos;
+            skipWhitespace();
+            if (pos < json.size() && json[pos] == ']') {
+                ++pos;
+                return;
+            }
+            auto pathSize = path.size();
+            while (true) {
+                if (pathSize > 0) {
+                    path.push_back('.');
+                }
+                parseValue(path);
+                path.resize(pathSize);
+
+                skipWhitespace();
+                if (pos < json.size() && json[pos] == ',') {
+                    ++pos;
+                    continue;
+                }
+                expect(']');
+                return;
+            }
+        }
+
+        void parseString(std::string& result)
+        {
+            if (pos >= json.size() || json[pos] != '"') {
+                fail("String expected.");
+            }
+            ++pos;
+            while (true) {
+                auto end = pos;
+                while (end < json.size() && json[end] != '"' && json[end] != '\\') {
+                    if (static_cast<unsigned char>(json[end]) < 0x20) {
+                        pos = end;
+                        fail("Control character in string.");
+                    }
+                    ++end;
+                }
+                result.append(json.substr(pos, end - pos));
+                pos = end;
+                if (pos >= json.size()) {
+                    fail("Unterminated string.");
+                }
+                if (json[pos] == '"') {
+                    ++pos;
+                    return;
+                }
+                parseEscape(result);
+            }
+        }
+
+        void parseEscape(std::string& result)
+        {
+            ++pos;
+            if (pos >= json.size()) {
+                fail("Unterminated escape sequence.");
+            }
+            auto c = json[pos++];
+            switch (c) {
+            case '"':
+            case '\\':
+            case '/':
+                result.push_back(c);
+                return;
+            case 'b':
+                result.push_back('\b');
+                return;
+            case 'f':
+                result.push_back('\f');
+                return;
+            case 'n':
+                result.push_back('\n');
+                return;
+            case 'r':
+                result.push_back('\r');
+                return;
+            case 't':
+                result.push_back('\t');
+                return;
+            case 'u': {
+                auto codepoint = parseHex4();
+                if (codepoint >= 0xd800 && codepoint <= 0xdbff) {
+                    if (json.substr(pos, 2) != "\\u") {
+                        fail("Invalid surrogate pair.");
+                    }
+                    pos += 2;
+                    auto low = parseHex4();
+                    if (low < 0xdc00 || low > 0xdfff) {
+                        fail("Invalid surrogate pair.");
+                    }
+                    codepoint = 0x10000 + ((codepoint - 0xd800) << 10) + (low - 0xdc00);
+                } else if (codepoint >= 0xdc00 && codepoint <= 0xdfff) {
+                    fail("Invalid surrogate pair.");
+                }
+                appendUtf8(result, codepoint);
+                return;
+            }
+            default:
+                fail("Invalid escape sequence.");
+            }
+        }
+
+        unsigned int parseHex4()
+        {
+            if (pos + 4 > json.size()) {
+                fail("Invalid unicode escape.");
+            }
+            unsigned int result = 0;
+            for (int i = 0; i < 4; ++i) {
+                auto c = json[pos++];
+                result <<= 4;
+                if (c >= '0' && c <= '9') {
+                    result |= c - '0';
+                } else if (c >= 'a' && c <= 'f') {
+                    result |= c - 'a' + 10;
+                } else if (c >= 'A' && c <= 'F') {
+                    result |= c - 'A' + 10;
+                } else {
+                    fail("Invalid unicode escape.");
+                }
+            }
+            return result;
+        }
+
+        static void appendUtf8(std::string& result, unsigned int codepoint)
+        {
+            if (codepoint < 0x80) {
+                result.push_back(static_cast<char>(codepoint));
+            } else if (codepoint < 0x800) {
+                result.push_back(static_cast<char>(0xc0 | (codepoint >> 6)));
+                result.push_back(static_cast<char>(0x80 | (codepoint & 0x3f)));
+            } else if (codepoint < 0x10000) {
+                result.push_back(static_cast<char>(0xe0 | (codepoint >> 12)));
+                result.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f)));
+                result.push_back(static_cast<char>(0x80 | (codepoint & 0x3f)));
+            } else {
+                result.push_back(static_cast<char>(0xf0 | (codepoint >> 18)));
+                result.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3f)));
+                result.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f)));
+                result.push_back(static_cast<char>(0x80 | (codepoint & 0x3f)));
+            }
+        }
+
+        //numbers, true, false and null
+        std::string_view parseLiteral()
+        {
+            auto start = pos;
+            for (auto const& literal : {"true", "false", "null"}) {
+                auto literalView = std::string_view(literal);
+                if (json.substr(pos, literalView.size()) == literalView) {
+                    pos += literalView.size();
+                    return literalView;
+                }
+            }
+            auto isDigit = [&] { return pos < json.size() && json[pos] >= '0' && json[pos] <= '9'; };
+            auto skipDigits = [&] {
+                if (!isDigit()) {
+                    fail("Digit expected.");
+                }
+                while (isDigit()) {
+                    ++pos;
+                }
+            };
+            if (pos < json.size() && json[pos] == '-') {
+                ++pos;
+            }
+            if (pos < json.size() && json[pos] == '0') {
+                ++pos;
+            } else {
+                skipDigits();
+            }
+            if (pos < json.size() && json[pos] == '.') {
+                ++pos;
+                skipDigits();
+            }
+            if (pos < json.size() && (json[pos] == 'e' || json[pos] == 'E')) {
+                ++pos;
+                if (pos < json.size() && (json[pos] == '+' || json[pos] == '-')) {
+                    ++pos;
+                }
+                skipDigits();
+            }
+            return json.substr(start, pos - start);
+        }
+    };
+
+    template <typename Map>
+    void parseJson(std::string_view json, Map& valueByPath)
+    {
+        if (json.substr(0, 3) == "\xEF\xBB\xBF") {
+            json.remove_prefix(3);
+        }
+        JsonTreeParser<Map> parser{json, valueByPath};
+        std::string path;
+        parser.parseValue(path);
+        parser.skipWhitespace();
+        if (parser.pos != json.size()) {
+            parser.fail("Unexpected data after JSON value.");
+        }
+    }
+}
+
+SettingsJsonWriter::SettingsJsonWriter()
+{
+    _nodes.emplace_back();
+    _values.reserve(64 * 1024);
+}
+
+std::string SettingsJsonWriter::getJson() const
+{
+    std::string result;
+    result.reserve(_values.size() * 4);
+    writeNode(result, 0, 0);
+    result.push_back('\n');
+    return result;
+}
+
+void SettingsJsonWriter::put(std::string_view node, std::string_view value)
+{
+    auto findResult = _nodeIndexByPath.find(node);
+    int nodeIndex;
+    if (findResult != _nodeIndexByPath.end()) {
+        nodeIndex = findResult->second;
+    } else {
+        int parentIndex = 0;
+        size_t keyStart = 0;
+        while (true) {
+            auto keyEnd = node.find('.', keyStart);
+            auto path = node.substr(0, keyEnd);
+            auto pathFindResult = _nodeIndexByPath.find(path);
+            if (pathFindResult != _nodeIndexByPath.end()) {
+                parentIndex = pathFindResult->second;
+            } else {
+                auto childIndex = static_cast<int>(_nodes.size());
+                auto const& storedPath = _nodeIndexByPath.emplace(std::string(path), childIndex).first->first;
+
+                Node child;
+                child.key = std::string_view(storedPath).substr(keyStart);
+                _nodes.emplace_back(child);
+                auto& parent = _nodes.at(parentIndex);
+                if (parent.lastChild != -1) {
+                    _nodes.at(parent.lastChild).nextSibling = childIndex;
+                } else {
+                    parent.firstChild = childIndex;
+                }
+                parent.lastChild = childIndex;
+                parentIndex = childIndex;
+            }
+            if (keyEnd == std::string_view::npos) {
+                break;
+            }
+            keyStart = keyEnd + 1;
+        }
+        nodeIndex = parentIndex;
+    }
+    auto& nodeData = _nodes.at(nodeIndex);
+    nodeData.valueStart = _values.size();
+    nodeData.valueSize = value.size();
+    _values.append(value);
+}
+
+void SettingsJsonWriter::writeNode(std::string& output, int nodeIndex, int indent) const
+{
+    auto const& node = _nodes.at(nodeIndex);
+    if (indent > 0 && node.firstChild == -1) {
+        output.push_back('"');
+        appendEscaped(output, std::string_view(_values).substr(node.valueStart, node.valueSize));
+        output.push_back('"');
+        return;
+    }
+    output.append("{\n");
+    for (auto childIndex = node.firstChild; childIndex != -1;) {
+        auto const& child = _nodes.at(childIndex);
+        output.append(4 * (indent + 1), ' ');
+        output.push_back('"');
+        appendEscaped(output, child.key);
+        output.append("\": ");
+        writeNode(output, childIndex, indent + 1);
+        if (child.nextSibling != -1) {
+            output.push_back(',');
+        }
+        output.push_back('\n');
+        childIndex = child.nextSibling;
+    }
+    output.append(4 * indent, ' ');
+    output.push_back('}');
+}
+
+SettingsJsonReader::SettingsJsonReader(std::string_view json)
+{
+    parseJson(json, _valueByPath);
+}
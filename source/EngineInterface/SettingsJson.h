@@ -0,0 +1,228 @@
+#pragma once
+
+#include <charconv>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/property_tree/stream_translator.hpp>
+
+#include "Base/JsonParser.h"
+
+#include "Colors.h"
+
+//base for the codecs which are applied to the field list of the settings (see AuxiliaryDataParserService)
+//colors, matrices, durations and activatable values are broken down into single values which are processed by Derived::encodeDecodeValue
+template <typename Derived>
+class SettingsCodec
+{
+public:
+    //returns true if the value does not exist (only relevant for decoding)
+    template <typename T>
+    bool encodeDecode(T& parameter, T const& defaultValue, std::string_view node);
+
+    template <typename T>
+    bool encodeDecodeWithEnabled(T& parameter, bool& isActivated, T const& defaultValue, std::string_view node);
+
+private:
+    std::string _elementNode;
+    std::string _enabledNode;
+};
+
+//writes the settings directly as JSON text
+//the output is identical to boost::property_tree::json_parser::write_json applied to the corresponding property tree
+class SettingsJsonWriter : public SettingsCodec<SettingsJsonWriter>
+{
+public:
+    static ParserTask constexpr Task = ParserTask::Encode;
+
+    SettingsJsonWriter();
+
+    std::string getJson() const;
+
+    template <typename T>
+    bool encodeDecodeValue(T& value, T const& defaultValue, std::string_view node);
+
+private:
+    //same semantics as ptree::put: existing nodes are overwritten, missing nodes are appended
+    void put(std::string_view node, std::string_view value);
+    void writeNode(std::string& output, int nodeIndex, int indent) const;
+
+    struct Node
+    {
+        std::string_view key;
+        size_t valueStart = 0;
+        size_t valueSize = 0;
+        int firstChild = -1;
+        int lastChild = -1;
+        int nextSibling = -1;
+    };
+    std::vector<Node> _nodes;
+    std::string _values;
+
+    struct PathHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view path) const { return std::hash<std::string_view>()(path); }
+    };
+    std::unordered_map<std::string, int, PathHash, std::equal_to<>> _nodeIndexByPath;
+};
+
+//parses JSON text into a flat map from node paths to values and reads the settings from there
+//values are converted as in ptree::get, i.e. values which cannot be converted are replaced by the default value
+class SettingsJsonReader : public SettingsCodec<SettingsJsonReader>
+{
+public:
+    static ParserTask constexpr Task = ParserTask::Decode;
+
+    SettingsJsonReader(std::string_view json);  //throws std::runtime_error for malformed input
+
+    template <typename T>
+    bool encodeDecodeValue(T& value, T const& defaultValue, std::string_view node);
+
+private:
+    template <typename T>
+    static bool convert(T& value, std::string const& text);
+
+    struct PathHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view path) const { return std::hash<std::string_view>()(path); }
+    };
+    std::unordered_map<std::string, std::string, PathHash, std::equal_to<>> _valueByPath;
+};
+
+/**
+ * Implementations
+ */
+
+template <typename Derived>
+template <typename T>
+bool SettingsCodec<Derived>::encodeDecode(T& parameter, T const& defaultValue, std::string_view node)
+{
+    auto& derived = static_cast<Derived&>(*this);
+    if constexpr (std::is_array_v<T>) {
+        auto result = false;
+        _elementNode.assign(node);
+        auto nodeSize = _elementNode.size();
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            if constexpr (std::rank_v<T> == 1) {
+                _elementNode.resize(nodeSize);
+                _elementNode.append("[").append(std::to_string(i)).append("]");
+                result |= derived.encodeDecodeValue(parameter[i], defaultValue[i], _elementNode);
+            } else {
+                for (int j = 0; j < MAX_COLORS; ++j) {
+                    _elementNode.resize(nodeSize);
+                    _elementNode.append("[").append(std::to_string(i)).append(", ").append(std::to_string(j)).append("]");
+                    result |= derived.encodeDecodeValue(parameter[i][j], defaultValue[i][j], _elementNode);
+                }
+            }
+        }
+        return result;
+    } else if constexpr (std::is_same_v<T, std::chrono::milliseconds>) {
+        if constexpr (Derived::Task == ParserTask::Encode) {
+            auto parameterAsString = std::to_string(parameter.count());
+            return derived.encodeDecodeValue(parameterAsString, std::string(), node);
+        } else {
+            std::string parameterAsString;
+            auto defaultAsString = std::to_string(defaultValue.count());
+            auto result = derived.encodeDecodeValue(parameterAsString, defaultAsString, node);
+            parameter = std::chrono::milliseconds(std::stoi(parameterAsString));
+            return result;
+        }
+    } else {
+        return derived.encodeDecodeValue(parameter, defaultValue, node);
+    }
+}
+
+template <typename Derived>
+template <typename T>
+bool SettingsCodec<Derived>::encodeDecodeWithEnabled(T& parameter, bool& isActivated, T const& defaultValue, std::string_view node)
+{
+    _enabledNode.assign(node).append(".activated");
+    auto result = encodeDecode(isActivated, false, _enabledNode);
+    //color vectors are stored without ".value" (color matrices with, as in PropertyParser)
+    if constexpr (std::rank_v<T> == 1) {
+        result |= encodeDecode(parameter, defaultValue, node);
+    } else {
+        _enabledNode.assign(node).append(".value");
+        result |= encodeDecode(parameter, defaultValue, _enabledNode);
+    }
+    return result;
+}
+
+template <typename T>
+bool SettingsJsonWriter::encodeDecodeValue(T& value, T const& defaultValue, std::string_view node)
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        put(node, value ? "true" : "false");
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        put(node, value);
+    } else {
+        //same result as to_string_with_precision(value, 8) without the stream overhead
+        char buffer[128];
+        std::to_chars_result result;
+        if constexpr (std::is_floating_point_v<T>) {
+            result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 8);
+        } else {
+            result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        }
+        if (result.ec == std::errc()) {
+            put(node, std::string_view(buffer, result.ptr - buffer));
+        } else {
+            put(node, to_string_with_precision(value, 8));
+        }
+    }
+    return false;
+}
+
+template <typename T>
+bool SettingsJsonReader::encodeDecodeValue(T& value, T const& defaultValue, std::string_view node)
+{
+    auto findResult = _valueByPath.find(node);
+    if (findResult == _valueByPath.end()) {
+        value = defaultValue;
+        return true;
+    }
+    if constexpr (std::is_same_v<T, std::string>) {
+        value = findResult->second;
+    } else {
+        if (!convert(value, findResult->second)) {
+            value = defaultValue;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+bool SettingsJsonReader::convert(T& value, std::string const& text)
+{
+    //fast path for the representations written by SettingsJsonWriter, all other cases are handled by the property tree translator
+    if constexpr (std::is_same_v<T, bool>) {
+        if (text == "true" || text == "1") {
+            value = true;
+            return true;
+        }
+        if (text == "false" || text == "0") {
+            value = false;
+            return true;
+        }
+    } else {
+        auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+        if (!text.empty() && (isDigit(text.front()) || (text.front() == '-' && text.size() > 1 && isDigit(text[1])))) {
+            auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (result.ec == std::errc() && result.ptr == text.data() + text.size()) {
+                return true;
+            }
+        }
+    }
+    auto translatedValue = boost::property_tree::stream_translator<char, std::char_traits<char>, std::allocator<char>, T>().get_value(text);
+    if (!translatedValue) {
+        return false;
+    }
+    value = *translatedValue;
+    return true;
+}
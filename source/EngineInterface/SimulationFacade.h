@@ -1,13 +1,18 @@
 #pragma once
+
+#include <future>
+
 #include "Definitions.h"
 #include "OverlayDescriptions.h"
 #include "SelectionShallowData.h"
 #include "Settings.h"
 #include "ShallowUpdateSelectionData.h"
 #include "SimulationFacade.h"
+#include "SimulationVersions.h"
 #include "MutationType.h"
 #include "DataPointCollection.h"
 #include "StatisticsHistory.h"
+#include "TransferBufferStatistics.h"
 
 class _SimulationFacade
 {
@@ -41,6 +46,8 @@ public:
     virtual void setSyncSimulationWithRenderingRatio(int value) = 0;
 
     virtual ClusteredDataDescription getClusteredSimulationData() = 0;
+    //reads the data from the GPU at once, the conversion into descriptions is performed chunk by chunk when reading from the returned object
+    virtual ClusteredDataReader getClusteredSimulationDataReader() = 0;
     virtual DataDescription getSimulationData() = 0;
     virtual ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters) = 0;
     virtual DataDescription getSelectedSimulationData(bool includeClusters) = 0;
@@ -49,17 +56,25 @@ public:
     virtual void addAndSelectSimulationData(DataDescription const& dataToAdd) = 0;
     virtual void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) = 0;
     virtual void setSimulationData(DataDescription const& dataToUpdate) = 0;
-    virtual void removeSelectedObjects(bool includeClusters) = 0;
-    virtual void relaxSelectedObjects(bool includeClusters) = 0;
-    virtual void uniformVelocitiesForSelectedObjects(bool includeClusters) = 0;
-    virtual void makeSticky(bool includeClusters) = 0;
-    virtual void removeStickiness(bool includeClusters) = 0;
-    virtual void setBarrier(bool value, bool includeClusters) = 0;
-    virtual void colorSelectedObjects(unsigned char color, bool includeClusters) = 0;
-    virtual void reconnectSelectedObjects() = 0;
-    virtual void setDetached(bool value) = 0;
-    virtual void changeCell(CellDescription const& changedCell) = 0;
-    virtual void changeParticle(ParticleDescription const& changedParticle) = 0;
+
+    //snapshot files contain the raw transfer data and are loaded via memory mapping, valid for program versions with the same data layout
+    //SerializerService::deserializeSimulationFromFiles recognizes them as regular simulation files
+    virtual void setSimulationDataFromSnapshotFile(std::string const& filename) = 0;
+    virtual void saveSimulationDataToSnapshotFile(std::string const& filename) = 0;
+
+    //editing operations may be applied asynchronously between two time steps, the returned future signals their completion
+    //subsequent read accesses from the same thread always see the result
+    virtual std::future<void> removeSelectedObjects(bool includeClusters) = 0;
+    virtual std::future<void> relaxSelectedObjects(bool includeClusters) = 0;
+    virtual std::future<void> uniformVelocitiesForSelectedObjects(bool includeClusters) = 0;
+    virtual std::future<void> makeSticky(bool includeClusters) = 0;
+    virtual std::future<void> removeStickiness(bool includeClusters) = 0;
+    virtual std::future<void> setBarrier(bool value, bool includeClusters) = 0;
+    virtual std::future<void> colorSelectedObjects(unsigned char color, bool includeClusters) = 0;
+    virtual std::future<void> reconnectSelectedObjects() = 0;
+    virtual std::future<void> setDetached(bool value) = 0;
+    virtual std::future<void> changeCell(CellDescription const& changedCell) = 0;
+    virtual std::future<void> changeParticle(ParticleDescription const& changedParticle) = 0;
 
     virtual void calcTimesteps(uint64_t timesteps) = 0;
     virtual void runSimulation() = 0;
@@ -87,25 +102,29 @@ public:
 
     virtual void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius) = 0;
 
-    virtual void switchSelection(RealVector2D const& pos, float radius) = 0;
-    virtual void swapSelection(RealVector2D const& pos, float radius) = 0;
+    virtual std::future<void> switchSelection(RealVector2D const& pos, float radius) = 0;
+    virtual std::future<void> swapSelection(RealVector2D const& pos, float radius) = 0;
     virtual SelectionShallowData getSelectionShallowData(RealVector2D const& refPos = RealVector2D()) = 0;
-    virtual void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData) = 0;
-    virtual void setSelection(RealVector2D const& startPos, RealVector2D const& endPos) = 0;
-    virtual void removeSelection() = 0;
+    virtual std::future<void> shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData) = 0;
+    virtual std::future<void> setSelection(RealVector2D const& startPos, RealVector2D const& endPos) = 0;
+    virtual std::future<void> removeSelection() = 0;
     virtual bool updateSelectionIfNecessary() = 0;
 
     virtual GeneralSettings getGeneralSettings() const = 0;
     virtual IntVector2D getWorldSize() const = 0;
     virtual RawStatisticsData getRawStatistics() const = 0;
     virtual StatisticsHistory const& getStatisticsHistory() const = 0;
-    virtual void setStatisticsHistory(StatisticsHistoryData const& data) = 0;
+    virtual void setStatisticsHistory(StatisticsHistorySnapshot const& data) = 0;
+    virtual TransferBufferStatistics getTransferBufferStatistics() const = 0;
 
     virtual std::optional<int> getTpsRestriction() const = 0;
     virtual void setTpsRestriction(std::optional<int> const& value) = 0;
 
     virtual float getTps() const = 0;
 
+    //cheap to call, can be used to poll for changes (see SimulationSubscription)
+    virtual SimulationVersions getVersions() const = 0;
+
     //for tests
     virtual void testOnly_mutate(uint64_t cellId, MutationType mutationType) = 0;
 };
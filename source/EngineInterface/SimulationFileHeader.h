@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "Base/Vector2D.h"
+
+//part of the main data of a simulation file which can be decompressed on its own
+//it contains the clusters (assigned by their first cell) and particles of one tile of a chunk
+struct SimulationFileSegment
+{
+    IntVector2D tile;
+    RealVector2D boundingBoxMin;  //contains all cells of the clusters and all particles
+    RealVector2D boundingBoxMax;
+    uint64_t numClusters = 0;
+    uint64_t numCells = 0;
+    uint64_t numParticles = 0;
+    uint64_t blockOffset = 0;  //offset of the first compressed block in the simulation file
+    uint64_t numBlocks = 0;
+};
+
+//index stored at the end of a simulation file, it can be read without decompressing the main data
+//the cell and particle counts per tile also serve as a low-resolution preview of the world
+struct SimulationFileHeader
+{
+    IntVector2D worldSize;
+    uint64_t timestep = 0;
+    IntVector2D numTiles;
+    std::vector<SimulationFileSegment> segments;
+
+    uint64_t getNumClusters() const
+    {
+        uint64_t result = 0;
+        for (auto const& segment : segments) {
+            result += segment.numClusters;
+        }
+        return result;
+    }
+
+    uint64_t getNumCells() const
+    {
+        uint64_t result = 0;
+        for (auto const& segment : segments) {
+            result += segment.numCells;
+        }
+        return result;
+    }
+
+    uint64_t getNumParticles() const
+    {
+        uint64_t result = 0;
+        for (auto const& segment : segments) {
+            result += segment.numParticles;
+        }
+        return result;
+    }
+};
@@ -0,0 +1,93 @@
+#include "SimulationSubscription.h"
+
+#include <unordered_set>
+
+#include "DescriptionEditService.h"
+#include "SimulationFacade.h"
+
+SimulationSubscription::SimulationSubscription(SimulationFacade const& simulationFacade)
+    : _simulationFacade(simulationFacade)
+{}
+
+std::optional<SimulationParameters> SimulationSubscription::pollSimulationParameters()
+{
+    auto version = _simulationFacade->getVersions().parameters;
+    if (_parametersVersion == version) {
+        return std::nullopt;
+    }
+    auto isFirstPoll = !_parametersVersion.has_value();
+    _parametersVersion = version;
+
+    auto parameters = _simulationFacade->getSimulationParameters();
+    if (!isFirstPoll && parameters == _parameters) {
+        return std::nullopt;
+    }
+    _parameters = parameters;
+    return _parameters;
+}
+
+std::optional<SelectionShallowData> SimulationSubscription::pollSelectionShallowData(RealVector2D const& refPos)
+{
+    auto version = _simulationFacade->getVersions().selection;
+    if (_selectionVersion == version && _selectionRefPos == refPos) {
+        return std::nullopt;
+    }
+    auto isFirstPoll = !_selectionVersion.has_value();
+    _selectionVersion = version;
+    _selectionRefPos = refPos;
+
+    auto selectionShallowData = _simulationFacade->getSelectionShallowData(refPos);
+    if (!isFirstPoll && selectionShallowData == _selectionShallowData) {
+        return std::nullopt;
+    }
+    _selectionShallowData = selectionShallowData;
+    return _selectionShallowData;
+}
+
+InspectedEntityChanges SimulationSubscription::pollInspectedEntities(std::vector<uint64_t> const& entityIds)
+{
+    InspectedEntityChanges result;
+
+    //forget entities which are no longer subscribed
+    std::unordered_set<uint64_t> entityIdSet(entityIds.begin(), entityIds.end());
+    std::erase_if(_inspectedEntityById, [&](auto const& idAndEntity) { return !entityIdSet.contains(idAndEntity.first); });
+
+    auto version = _simulationFacade->getVersions().entities;
+    auto areAllEntitiesDelivered = _inspectedEntityById.size() == entityIdSet.size();
+    if ((_entitiesVersion == version && areAllEntitiesDelivered) || entityIds.empty()) {
+        _entitiesVersion = version;
+        return result;
+    }
+    _entitiesVersion = version;
+
+    auto inspectedData = _simulationFacade->getInspectedSimulationData(entityIds);
+    std::unordered_set<uint64_t> existingIds;
+    for (auto const& entity : DescriptionEditService::getObjects(inspectedData)) {
+        auto id = DescriptionEditService::getId(entity);
+        existingIds.insert(id);
+
+        auto findResult = _inspectedEntityById.find(id);
+        if (findResult == _inspectedEntityById.end() || findResult->second != entity) {
+            _inspectedEntityById.insert_or_assign(id, entity);
+            result.changedEntities.emplace_back(entity);
+        }
+    }
+    for (auto const& id : entityIdSet) {
+        if (!existingIds.contains(id)) {
+            auto findResult = _inspectedEntityById.find(id);
+            if (findResult == _inspectedEntityById.end() || findResult->second.has_value()) {
+                _inspectedEntityById.insert_or_assign(id, std::nullopt);
+                result.vanishedEntityIds.emplace_back(id);
+            }
+        }
+    }
+    return result;
+}
+
+void SimulationSubscription::reset()
+{
+    _parametersVersion.reset();
+    _selectionVersion.reset();
+    _entitiesVersion.reset();
+    _inspectedEntityById.clear();
+}
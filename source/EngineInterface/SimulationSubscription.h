@@ -0,0 +1,52 @@
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+
+#include "Definitions.h"
+#include "Descriptions.h"
+#include "SelectionShallowData.h"
+#include "SimulationParameters.h"
+#include "SimulationVersions.h"
+
+struct InspectedEntityChanges
+{
+    std::vector<CellOrParticleDescription> changedEntities;
+    std::vector<uint64_t> vanishedEntityIds;
+
+    bool isEmpty() const { return changedEntities.empty() && vanishedEntityIds.empty(); }
+};
+
+//delivers only the parts of the simulation which have changed since the last poll
+//the data is read from the simulation facade only if the corresponding version counter has been increased
+class SimulationSubscription
+{
+public:
+    SimulationSubscription() = default;
+    SimulationSubscription(SimulationFacade const& simulationFacade);
+
+    //returns nullopt if the parameters are unchanged
+    std::optional<SimulationParameters> pollSimulationParameters();
+
+    //returns nullopt if the selection is unchanged
+    std::optional<SelectionShallowData> pollSelectionShallowData(RealVector2D const& refPos = RealVector2D());
+
+    //entities which are not delivered before (e.g. after changing the ids) are regarded as changed
+    InspectedEntityChanges pollInspectedEntities(std::vector<uint64_t> const& entityIds);
+
+    //the next poll delivers all subscribed data
+    void reset();
+
+private:
+    SimulationFacade _simulationFacade;
+
+    std::optional<uint64_t> _parametersVersion;
+    SimulationParameters _parameters;
+
+    std::optional<uint64_t> _selectionVersion;
+    RealVector2D _selectionRefPos;
+    SelectionShallowData _selectionShallowData;
+
+    std::optional<uint64_t> _entitiesVersion;
+    std::unordered_map<uint64_t, std::optional<CellOrParticleDescription>> _inspectedEntityById;  //nullopt for vanished entities
+};
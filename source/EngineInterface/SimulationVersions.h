@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+//the counters are increased monotonically whenever the corresponding part of the simulation may have changed
+//they allow to poll the simulation facade without reading back unchanged data
+struct SimulationVersions
+{
+    uint64_t parameters = 0;
+    uint64_t selection = 0;  //also increased by time steps as long as objects are selected
+    uint64_t entities = 0;   //refers to all cells and particles, i.e. also to inspected entities
+
+    bool operator==(SimulationVersions const&) const = default;
+};
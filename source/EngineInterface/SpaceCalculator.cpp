@@ -31,8 +31,15 @@ void SpaceCalculator::correctDisplacement(RealVector2D& displacement) const
 
 void SpaceCalculator::correctPosition(RealVector2D& pos) const
 {
-    pos.x = std::fmod(std::fmod(pos.x, _worldSizeFloat.x) + _worldSizeFloat.x, _worldSizeFloat.x);
-    pos.y = std::fmod(std::fmod(pos.y, _worldSizeFloat.y) + _worldSizeFloat.y, _worldSizeFloat.y);
+    //same splitting as in BaseMap::correctPosition such that positions inside the world remain unchanged
+    auto intPartX = toInt(std::floor(pos.x));
+    auto intPartY = toInt(std::floor(pos.y));
+    auto fracPartX = pos.x - toFloat(intPartX);
+    auto fracPartY = pos.y - toFloat(intPartY);
+    intPartX = ((intPartX % _worldSize.x) + _worldSize.x) % _worldSize.x;
+    intPartY = ((intPartY % _worldSize.y) + _worldSize.y) % _worldSize.y;
+    pos.x = toFloat(intPartX) + fracPartX;
+    pos.y = toFloat(intPartY) + fracPartY;
 }
 
 RealVector2D SpaceCalculator::getCorrectedPosition(RealVector2D const& pos) const
@@ -0,0 +1,267 @@
+#include "SpatialIndex.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Base/Definitions.h"
+#include "Base/ParallelService.h"
+
+namespace
+{
+    int getNextPowerOfTwo(int value)
+    {
+        auto result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    int getLog2(int powerOfTwo)
+    {
+        auto result = 0;
+        while ((1 << result) < powerOfTwo) {
+            ++result;
+        }
+        return result;
+    }
+
+    float getCorrectedDisplacement(float displacement, float worldSize)
+    {
+        if (displacement > worldSize / 2) {
+            return displacement - worldSize;
+        }
+        if (displacement < -worldSize / 2) {
+            return displacement + worldSize;
+        }
+        return displacement;
+    }
+}
+
+SpatialIndex::SpatialIndex(float minSlotSize)
+{
+    _slotSize = {minSlotSize, minSlotSize};
+    clear();
+}
+
+SpatialIndex::SpatialIndex(IntVector2D const& worldSize, float minSlotSize)
+    : _spaceCalculator(worldSize)
+    , _worldSize{toFloat(worldSize.x), toFloat(worldSize.y)}
+{
+    _numWorldSlots.x = std::max(1, toInt(_worldSize.x / minSlotSize));
+    _numWorldSlots.y = std::max(1, toInt(_worldSize.y / minSlotSize));
+    _slotSize = {_worldSize.x / toFloat(_numWorldSlots.x), _worldSize.y / toFloat(_numWorldSlots.y)};
+    clear();
+}
+
+void SpatialIndex::build(std::vector<RealVector2D> const& positions)
+{
+    _positions = positions;
+    rebuild();
+}
+
+int SpatialIndex::insert(RealVector2D const& pos)
+{
+    auto index = toInt(_positions.size());
+    _positions.emplace_back(pos);
+    _lowerBound = {std::min(_lowerBound.x, pos.x), std::min(_lowerBound.y, pos.y)};
+    _upperBound = {std::max(_upperBound.x, pos.x), std::max(_upperBound.y, pos.y)};
+
+    //rebuilding as soon as the chained entries outnumber the sorted ones keeps insertions amortized constant
+    if (toInt(_insertedEntries.size()) >= std::max(MinTableSize, toInt(_entries.size()))) {
+        rebuild();
+        return index;
+    }
+    Entry entry{getCorrectedPosition(pos), index};
+    auto slot = getTableSlot(entry.pos);
+    _insertedNextIndices.emplace_back(_insertedHeadIndices[slot]);
+    _insertedHeadIndices[slot] = toInt(_insertedEntries.size());
+    _insertedEntries.emplace_back(entry);
+    return index;
+}
+
+void SpatialIndex::clear()
+{
+    _positions.clear();
+    _entries.clear();
+    _insertedEntries.clear();
+    _insertedNextIndices.clear();
+    _lowerBound = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    _upperBound = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    initTable(0);
+}
+
+float SpatialIndex::getDistance(RealVector2D const& pos1, RealVector2D const& pos2) const
+{
+    return std::sqrt(getSquaredDistanceIntern(getCorrectedPosition(pos1), getCorrectedPosition(pos2)));
+}
+
+std::vector<int> SpatialIndex::getIndicesWithinRadius(RealVector2D const& pos, float radius) const
+{
+    std::vector<std::pair<float, int>> distancesAndIndices;
+    forEachWithinRadius(pos, radius, [&](int index, float distance) { distancesAndIndices.emplace_back(distance, index); });
+    std::sort(distancesAndIndices.begin(), distancesAndIndices.end());
+
+    std::vector<int> result;
+    result.reserve(distancesAndIndices.size());
+    for (auto const& [distance, index] : distancesAndIndices) {
+        result.emplace_back(index);
+    }
+    return result;
+}
+
+std::vector<std::vector<int>> SpatialIndex::getIndicesWithinRadius(std::vector<RealVector2D> const& queryPositions, float radius) const
+{
+    std::vector<std::vector<int>> result(queryPositions.size());
+    ParallelService::forEachRange(queryPositions.size(), [&](uint64_t startIndex, uint64_t endIndex) {
+        for (auto i = startIndex; i < endIndex; ++i) {
+            result[i] = getIndicesWithinRadius(queryPositions[i], radius);
+        }
+    });
+    return result;
+}
+
+bool SpatialIndex::isAnyCloserThan(RealVector2D const& pos, float distance) const
+{
+    auto result = false;
+    forEachWithinRadius(pos, distance, [&](int, float otherDistance) {
+        if (otherDistance < distance) {
+            result = true;
+        }
+    });
+    return result;
+}
+
+std::vector<int> SpatialIndex::getNearestIndices(RealVector2D const& pos, int numNeighbors) const
+{
+    if (_positions.empty() || numNeighbors <= 0) {
+        return {};
+    }
+
+    //enlarge the search radius until enough positions are found or all positions are covered
+    std::vector<std::pair<float, int>> distancesAndIndices;
+    auto maxDistance = getMaxDistance(getCorrectedPosition(pos));
+    for (auto radius = std::max(_slotSize.x, _slotSize.y);; radius *= 2) {
+        distancesAndIndices.clear();
+        forEachWithinRadius(pos, radius, [&](int index, float distance) { distancesAndIndices.emplace_back(distance, index); });
+        if (toInt(distancesAndIndices.size()) >= numNeighbors || radius >= maxDistance) {
+            break;
+        }
+    }
+
+    auto numResults = std::min(numNeighbors, toInt(distancesAndIndices.size()));
+    std::partial_sort(distancesAndIndices.begin(), distancesAndIndices.begin() + numResults, distancesAndIndices.end());
+
+    std::vector<int> result(numResults);
+    for (int i = 0; i < numResults; ++i) {
+        result[i] = distancesAndIndices[i].second;
+    }
+    return result;
+}
+
+void SpatialIndex::rebuild()
+{
+    auto numPositions = toInt(_positions.size());
+    initTable(numPositions);
+
+    _lowerBound = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    _upperBound = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    std::vector<int> slots(numPositions);
+    std::vector<RealVector2D> correctedPositions(numPositions);
+    for (int i = 0; i < numPositions; ++i) {
+        auto const& pos = _positions[i];
+        _lowerBound = {std::min(_lowerBound.x, pos.x), std::min(_lowerBound.y, pos.y)};
+        _upperBound = {std::max(_upperBound.x, pos.x), std::max(_upperBound.y, pos.y)};
+        correctedPositions[i] = getCorrectedPosition(pos);
+        slots[i] = getTableSlot(correctedPositions[i]);
+        ++_slotStartIndices[slots[i] + 1];
+    }
+    for (size_t slot = 1; slot < _slotStartIndices.size(); ++slot) {
+        _slotStartIndices[slot] += _slotStartIndices[slot - 1];
+    }
+    _entries.resize(numPositions);
+    auto insertIndices = _slotStartIndices;
+    for (int i = 0; i < numPositions; ++i) {
+        _entries[insertIndices[slots[i]]++] = {correctedPositions[i], i};
+    }
+}
+
+void SpatialIndex::initTable(int numPositions)
+{
+    auto log2TableSize = getLog2(std::clamp(getNextPowerOfTwo(numPositions), MinTableSize, MaxTableSize));
+    _tableSize = {1 << (log2TableSize / 2), 1 << (log2TableSize - log2TableSize / 2)};
+
+    //more table slots than world slots would stay empty
+    if (_spaceCalculator) {
+        _tableSize.x = std::min(_tableSize.x, getNextPowerOfTwo(_numWorldSlots.x));
+        _tableSize.y = std::min(_tableSize.y, getNextPowerOfTwo(_numWorldSlots.y));
+    }
+    auto tableSize = _tableSize.x * _tableSize.y;
+    _slotStartIndices.assign(tableSize + 1, 0);
+    _insertedHeadIndices.assign(tableSize, -1);
+    _insertedNextIndices.clear();
+    _insertedEntries.clear();
+}
+
+RealVector2D SpatialIndex::getCorrectedPosition(RealVector2D const& pos) const
+{
+    return _spaceCalculator ? _spaceCalculator->getCorrectedPosition(pos) : pos;
+}
+
+float SpatialIndex::getSquaredDistanceIntern(RealVector2D const& correctedPos1, RealVector2D const& correctedPos2) const
+{
+    auto displacement = correctedPos2 - correctedPos1;
+    if (_spaceCalculator) {
+        displacement = {getCorrectedDisplacement(displacement.x, _worldSize.x), getCorrectedDisplacement(displacement.y, _worldSize.y)};
+    }
+    return displacement.x * displacement.x + displacement.y * displacement.y;
+}
+
+int SpatialIndex::getTableSlot(RealVector2D const& correctedPos) const
+{
+    auto slotX = static_cast<int64_t>(std::floor(correctedPos.x / _slotSize.x));
+    auto slotY = static_cast<int64_t>(std::floor(correctedPos.y / _slotSize.y));
+    if (_spaceCalculator) {
+        slotX = std::clamp(slotX, int64_t(0), int64_t(_numWorldSlots.x - 1));
+        slotY = std::clamp(slotY, int64_t(0), int64_t(_numWorldSlots.y - 1));
+    }
+    return toInt(slotY & (_tableSize.y - 1)) * _tableSize.x + toInt(slotX & (_tableSize.x - 1));
+}
+
+int SpatialIndex::getQuerySlots(float value, float radius, float slotSize, int numWorldSlots, int tableSize, QuerySlots& result) const
+{
+    auto startSlot = static_cast<int64_t>(std::floor((value - radius) / slotSize));
+    auto endSlot = static_cast<int64_t>(std::floor((value + radius) / slotSize));
+    auto numSlots = endSlot - startSlot + 1;
+    if (numWorldSlots > 0 && numSlots >= numWorldSlots) {
+        startSlot = 0;
+        numSlots = numWorldSlots;
+    }
+    if (numSlots >= tableSize || numSlots > MaxQuerySlotsPerAxis) {
+        return AllSlots;
+    }
+    for (int i = 0; i < numSlots; ++i) {
+        auto slot = startSlot + i;
+        if (numWorldSlots > 0) {
+            slot = ((slot % numWorldSlots) + numWorldSlots) % numWorldSlots;
+        }
+        result[i] = toInt(slot & (tableSize - 1));
+    }
+
+    //wrapped world slots can be mapped to the same table slot if the table size does not divide the number of world slots
+    if (numWorldSlots > tableSize && numWorldSlots % tableSize != 0) {
+        std::sort(result.begin(), result.begin() + numSlots);
+        return toInt(std::unique(result.begin(), result.begin() + numSlots) - result.begin());
+    }
+    return toInt(numSlots);
+}
+
+float SpatialIndex::getMaxDistance(RealVector2D const& correctedPos) const
+{
+    if (_spaceCalculator) {
+        return std::sqrt(_worldSize.x * _worldSize.x + _worldSize.y * _worldSize.y) / 2;
+    }
+    auto maxX = std::max(std::abs(correctedPos.x - _lowerBound.x), std::abs(correctedPos.x - _upperBound.x));
+    auto maxY = std::max(std::abs(correctedPos.y - _lowerBound.y), std::abs(correctedPos.y - _upperBound.y));
+    return std::sqrt(maxX * maxX + maxY * maxY);
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include "Base/Vector2D.h"
+
+#include "SpaceCalculator.h"
+
+//uniform grid for neighborhood queries on positions of descriptions
+//a periodic index covers a world and measures distances on the torus as SpaceCalculator does,
+//a non-periodic index is meant for patterns which are not placed in a world and measures euclidean distances
+//the slots of the world (or of the unbounded plane) are mapped onto a table whose size follows the number of positions,
+//candidates from slots sharing the same table entry are sorted out by the distance check
+//build() sorts the positions by table entry via counting sort, positions inserted afterwards are chained per table entry until the next rebuild
+//queries do not modify the index and can be executed concurrently
+class SpatialIndex
+{
+public:
+    explicit SpatialIndex(float minSlotSize = 1.0f);
+    SpatialIndex(IntVector2D const& worldSize, float minSlotSize);
+
+    //replaces the content, the i-th position gets index i
+    void build(std::vector<RealVector2D> const& positions);
+
+    //returns the index of the new position
+    int insert(RealVector2D const& pos);
+
+    void clear();
+
+    int getNumPositions() const { return static_cast<int>(_positions.size()); }
+    RealVector2D const& getPosition(int index) const { return _positions[index]; }
+    float getDistance(RealVector2D const& pos1, RealVector2D const& pos2) const;
+
+    //calls func(index, distance) for all positions within the distance of radius (inclusive), in no particular order
+    template <typename Func>
+    void forEachWithinRadius(RealVector2D const& pos, float radius, Func const& func) const;
+
+    //sorted by distance
+    std::vector<int> getIndicesWithinRadius(RealVector2D const& pos, float radius) const;
+
+    //same as above for many query positions which are processed in parallel
+    std::vector<std::vector<int>> getIndicesWithinRadius(std::vector<RealVector2D> const& queryPositions, float radius) const;
+
+    //returns true if there is a position with a distance strictly smaller than the given distance
+    bool isAnyCloserThan(RealVector2D const& pos, float distance) const;
+
+    //returns the indices of the nearest positions sorted by distance
+    std::vector<int> getNearestIndices(RealVector2D const& pos, int numNeighbors) const;
+
+private:
+    static auto constexpr MinTableSize = 1 << 8;
+    static auto constexpr MaxTableSize = 1 << 22;
+    static auto constexpr MaxQuerySlotsPerAxis = 32;
+    static auto constexpr AllSlots = -1;
+
+    struct Entry
+    {
+        RealVector2D pos;  //corrected position in case of a periodic index
+        int index;
+    };
+    using QuerySlots = std::array<int, MaxQuerySlotsPerAxis>;
+
+    void rebuild();
+    void initTable(int numPositions);
+    RealVector2D getCorrectedPosition(RealVector2D const& pos) const;
+    float getSquaredDistanceIntern(RealVector2D const& correctedPos1, RealVector2D const& correctedPos2) const;
+    int getTableSlot(RealVector2D const& correctedPos) const;
+    int getQuerySlots(float value, float radius, float slotSize, int numWorldSlots, int tableSize, QuerySlots& result) const;
+    float getMaxDistance(RealVector2D const& correctedPos) const;
+
+    std::optional<SpaceCalculator> _spaceCalculator;  //only for a periodic index
+    RealVector2D _worldSize;
+
+    RealVector2D _slotSize;
+    IntVector2D _numWorldSlots;  //only used for a periodic index
+    IntVector2D _tableSize;      //powers of two
+    RealVector2D _lowerBound;    //bounding box of all positions for a non-periodic index
+    RealVector2D _upperBound;
+
+    std::vector<RealVector2D> _positions;
+
+    //entries of the last build sorted by table slot
+    std::vector<int> _slotStartIndices;
+    std::vector<Entry> _entries;
+
+    //entries inserted since the last build
+    std::vector<int> _insertedHeadIndices;
+    std::vector<int> _insertedNextIndices;
+    std::vector<Entry> _insertedEntries;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+void SpatialIndex::forEachWithinRadius(RealVector2D const& pos, float radius, Func const& func) const
+{
+    if (_positions.empty() || radius < 0) {
+        return;
+    }
+    auto correctedPos = getCorrectedPosition(pos);
+    auto squaredRadius = radius * radius;
+
+    auto processEntry = [&](Entry const& entry) {
+        auto squaredDistance = getSquaredDistanceIntern(correctedPos, entry.pos);
+        if (squaredDistance <= squaredRadius) {
+            func(entry.index, std::sqrt(squaredDistance));
+        }
+    };
+    auto processSlot = [&](int slot) {
+        for (auto i = _slotStartIndices[slot]; i < _slotStartIndices[slot + 1]; ++i) {
+            processEntry(_entries[i]);
+        }
+        for (auto i = _insertedHeadIndices[slot]; i != -1; i = _insertedNextIndices[i]) {
+            processEntry(_insertedEntries[i]);
+        }
+    };
+
+    QuerySlots slotsX;
+    QuerySlots slotsY;
+    auto numSlotsX = getQuerySlots(correctedPos.x, radius, _slotSize.x, _spaceCalculator ? _numWorldSlots.x : 0, _tableSize.x, slotsX);
+    auto numSlotsY = getQuerySlots(correctedPos.y, radius, _slotSize.y, _spaceCalculator ? _numWorldSlots.y : 0, _tableSize.y, slotsY);
+    auto forEachSlot = [](int numSlots, int tableSize, QuerySlots const& slots, auto const& slotFunc) {
+        if (numSlots == AllSlots) {
+            for (int i = 0; i < tableSize; ++i) {
+                slotFunc(i);
+            }
+        } else {
+            for (int i = 0; i < numSlots; ++i) {
+                slotFunc(slots[i]);
+            }
+        }
+    };
+    forEachSlot(numSlotsY, _tableSize.y, slotsY, [&](int slotY) {
+        forEachSlot(numSlotsX, _tableSize.x, slotsX, [&](int slotX) { processSlot(slotY * _tableSize.x + slotX); });
+    });
+}
@@ -0,0 +1,91 @@
+#include "StatisticsColumnService.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+    auto constexpr NumLanes = 4;
+
+    //independent lanes allow the compiler to vectorize the loop without reassociating floating point operations
+    template <typename Operation>
+    double reduce(double const* values, size_t count, double initialValue, Operation const& operation)
+    {
+        double lanes[NumLanes] = {initialValue, initialValue, initialValue, initialValue};
+        size_t i = 0;
+        for (; i + NumLanes <= count; i += NumLanes) {
+            for (int j = 0; j < NumLanes; ++j) {
+                lanes[j] = operation(lanes[j], values[i + j]);
+            }
+        }
+        for (; i < count; ++i) {
+            lanes[0] = operation(lanes[0], values[i]);
+        }
+        return operation(operation(lanes[0], lanes[1]), operation(lanes[2], lanes[3]));
+    }
+}
+
+double StatisticsColumnService::getSum(double const* values, size_t count)
+{
+    return reduce(values, count, 0.0, [](double lhs, double rhs) { return lhs + rhs; });
+}
+
+double StatisticsColumnService::getMin(double const* values, size_t count)
+{
+    return reduce(values, count, std::numeric_limits<double>::max(), [](double lhs, double rhs) { return rhs < lhs ? rhs : lhs; });
+}
+
+double StatisticsColumnService::getMax(double const* values, size_t count)
+{
+    return reduce(values, count, std::numeric_limits<double>::lowest(), [](double lhs, double rhs) { return rhs > lhs ? rhs : lhs; });
+}
+
+size_t StatisticsColumnService::findFirstIndex(double const* timePoints, size_t count, double time)
+{
+    return std::lower_bound(timePoints, timePoints + count, time) - timePoints;
+}
+
+std::vector<size_t>
+StatisticsColumnService::decimateMinMax(double const* timePoints, double const* values, size_t count, double startTime, double endTime, int numBuckets)
+{
+    std::vector<size_t> result;
+    auto first = findFirstIndex(timePoints, count, startTime);
+    auto last = static_cast<size_t>(std::upper_bound(timePoints + first, timePoints + count, endTime) - timePoints);
+    if (first > 0) {
+        result.emplace_back(first - 1);
+    }
+
+    //no decimation needed
+    if (numBuckets <= 0 || last - first <= 2 * static_cast<size_t>(numBuckets)) {
+        result.resize(result.size() + (last - first));
+        std::iota(result.end() - (last - first), result.end(), first);
+        return result;
+    }
+
+    result.reserve(2 * numBuckets + 2);
+    auto bucketDuration = (endTime - startTime) / numBuckets;
+    auto bucketBegin = first;
+    while (bucketBegin < last) {
+        auto bucket = std::floor((timePoints[bucketBegin] - startTime) / bucketDuration);
+        auto bucketEnd = findFirstIndex(timePoints + bucketBegin, last - bucketBegin, startTime + (bucket + 1) * bucketDuration) + bucketBegin;
+        bucketEnd = std::max(bucketEnd, bucketBegin + 1);
+
+        auto bucketValues = values + bucketBegin;
+        auto bucketSize = bucketEnd - bucketBegin;
+        auto minIndex = static_cast<size_t>(std::find(bucketValues, bucketValues + bucketSize, getMin(bucketValues, bucketSize)) - values);
+        auto maxIndex = static_cast<size_t>(std::find(bucketValues, bucketValues + bucketSize, getMax(bucketValues, bucketSize)) - values);
+        minIndex = std::min(minIndex, bucketEnd - 1);  //in case of NaNs
+        maxIndex = std::min(maxIndex, bucketEnd - 1);
+        result.emplace_back(std::min(minIndex, maxIndex));
+        if (minIndex != maxIndex) {
+            result.emplace_back(std::max(minIndex, maxIndex));
+        }
+        bucketBegin = bucketEnd;
+    }
+    if (result.back() != last - 1) {
+        result.emplace_back(last - 1);
+    }
+    return result;
+}
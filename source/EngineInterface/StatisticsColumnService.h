@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+//kernels operating on contiguous statistics columns (see StatisticsColumns)
+class StatisticsColumnService
+{
+public:
+    static double getSum(double const* values, size_t count);
+    static double getMin(double const* values, size_t count);
+    static double getMax(double const* values, size_t count);
+
+    //returns the index of the first time point >= time, timePoints must be sorted
+    static size_t findFirstIndex(double const* timePoints, size_t count, double time);
+
+    //returns sorted indices of the minimum and maximum value within each of numBuckets equal time intervals of [startTime, endTime]
+    //the entry preceding startTime and the last entry of the range are always included in order to draw a continuous line
+    static std::vector<size_t>
+    decimateMinMax(double const* timePoints, double const* values, size_t count, double startTime, double endTime, int numBuckets);
+};
@@ -0,0 +1,72 @@
+#include "StatisticsColumns.h"
+
+#include <algorithm>
+#include <type_traits>
+
+static_assert(std::is_standard_layout_v<DataPointCollection>);
+static_assert(sizeof(DataPointCollection) == StatisticsColumns::NumColumns * sizeof(double), "DataPointCollection must only consist of doubles");
+
+namespace
+{
+    auto constexpr MinCapacity = size_t(64);
+}
+
+int StatisticsColumns::getColumnIndex(DataPoint DataPointCollection::*dataPoint, int colorIndex)
+{
+    DataPointCollection dataPoints;
+    auto offset = reinterpret_cast<double const*>(&(dataPoints.*dataPoint)) - reinterpret_cast<double const*>(&dataPoints);
+    return static_cast<int>(offset) + colorIndex;
+}
+
+StatisticsColumns::StatisticsColumns(size_t size)
+    : _size(size)
+    , _capacity(size)
+    , _values(size * NumColumns)
+{}
+
+DataPointCollection StatisticsColumns::getRow(size_t row) const
+{
+    DataPointCollection result;
+    auto resultValues = reinterpret_cast<double*>(&result);
+    for (int i = 0; i < NumColumns; ++i) {
+        resultValues[i] = getColumn(i)[row];
+    }
+    return result;
+}
+
+void StatisticsColumns::setRow(size_t row, DataPointCollection const& dataPoint)
+{
+    auto values = reinterpret_cast<double const*>(&dataPoint);
+    for (int i = 0; i < NumColumns; ++i) {
+        getColumn(i)[row] = values[i];
+    }
+}
+
+void StatisticsColumns::pushBack(DataPointCollection const& dataPoint)
+{
+    if (_size == _capacity) {
+        reserve(std::max(_capacity * 2, MinCapacity));
+    }
+    setRow(_size++, dataPoint);
+}
+
+void StatisticsColumns::eraseFront(size_t numRows)
+{
+    numRows = std::min(numRows, _size);
+    for (int i = 0; i < NumColumns; ++i) {
+        auto column = getColumn(i);
+        std::copy(column + numRows, column + _size, column);
+    }
+    _size -= numRows;
+}
+
+void StatisticsColumns::reserve(size_t capacity)
+{
+    std::vector<double> values(capacity * NumColumns);
+    for (int i = 0; i < NumColumns; ++i) {
+        auto column = getColumn(i);
+        std::copy(column, column + _size, values.data() + i * capacity);
+    }
+    _values = std::move(values);
+    _capacity = capacity;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "DataPointCollection.h"
+
+//statistics stored column-wise: each value of a DataPointCollection (time, system clock and each color and sum of each data point)
+//forms a contiguous column, such that operations on single metrics do not need to stride over whole rows
+class StatisticsColumns
+{
+public:
+    static auto constexpr NumColumns = static_cast<int>(sizeof(DataPointCollection) / sizeof(double));
+    static auto constexpr TimeColumn = 0;
+    static auto constexpr SystemClockColumn = 1;
+
+    //colorIndex == MAX_COLORS refers to the summed values
+    static int getColumnIndex(DataPoint DataPointCollection::*dataPoint, int colorIndex);
+
+    StatisticsColumns() = default;
+    explicit StatisticsColumns(size_t size);
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    double const* getColumn(int columnIndex) const { return _values.data() + columnIndex * _capacity; }
+    double* getColumn(int columnIndex) { return _values.data() + columnIndex * _capacity; }
+
+    //row-view adapter
+    DataPointCollection getRow(size_t row) const;
+    void setRow(size_t row, DataPointCollection const& dataPoint);
+    void pushBack(DataPointCollection const& dataPoint);
+    void eraseFront(size_t numRows);
+
+private:
+    void reserve(size_t capacity);
+
+    size_t _size = 0;
+    size_t _capacity = 0;
+    std::vector<double> _values;
+};
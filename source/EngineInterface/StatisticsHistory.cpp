@@ -1,24 +1,344 @@
 #include "StatisticsHistory.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <mutex>
 
-StatisticsHistoryData StatisticsHistory::getCopiedData() const
+#include "Base/Definitions.h"
+
+#include "StatisticsColumnService.h"
+
+namespace
 {
-    std::lock_guard lock(_mutex);
-    auto copy = _data;
-    return copy;
+    auto constexpr NumLevels = 12;
+    auto constexpr LevelCapacity = size_t(256);  //minimum number of most recent buckets retained per level
+    auto constexpr AggregationFactor = 4;  //number of buckets of a level which are aggregated into one bucket of the next level
+
+    struct Buckets
+    {
+        StatisticsColumns mean;
+        StatisticsColumns minimum;
+        StatisticsColumns maximum;
+
+        Buckets(size_t size)
+            : mean(size)
+            , minimum(size)
+            , maximum(size)
+        {}
+
+        void setRow(size_t row, DataPointCollection const& dataPoint)
+        {
+            mean.setRow(row, dataPoint);
+            minimum.setRow(row, dataPoint);
+            maximum.setRow(row, dataPoint);
+        }
+
+        void copyRows(size_t sourceRow, size_t numRows, Buckets& target, size_t targetRow) const
+        {
+            for (auto [source, targetColumns] :
+                 {std::make_pair(&mean, &target.mean), std::make_pair(&minimum, &target.minimum), std::make_pair(&maximum, &target.maximum)}) {
+                for (int i = 0; i < StatisticsColumns::NumColumns; ++i) {
+                    auto sourceColumn = source->getColumn(i) + sourceRow;
+                    std::copy(sourceColumn, sourceColumn + numRows, targetColumns->getColumn(i) + targetRow);
+                }
+            }
+        }
+
+        //the aggregated bucket is located at the time of its first data point
+        void aggregateRows(size_t sourceRow, size_t numRows, Buckets& target, size_t targetRow) const
+        {
+            for (int i = 0; i < StatisticsColumns::NumColumns; ++i) {
+                if (i == StatisticsColumns::TimeColumn || i == StatisticsColumns::SystemClockColumn) {
+                    auto value = mean.getColumn(i)[sourceRow];
+                    target.mean.getColumn(i)[targetRow] = value;
+                    target.minimum.getColumn(i)[targetRow] = value;
+                    target.maximum.getColumn(i)[targetRow] = value;
+                    continue;
+                }
+                target.mean.getColumn(i)[targetRow] = StatisticsColumnService::getSum(mean.getColumn(i) + sourceRow, numRows) / toDouble(numRows);
+                target.minimum.getColumn(i)[targetRow] = StatisticsColumnService::getMin(minimum.getColumn(i) + sourceRow, numRows);
+                target.maximum.getColumn(i)[targetRow] = StatisticsColumnService::getMax(maximum.getColumn(i) + sourceRow, numRows);
+            }
+        }
+    };
+
+    //the buffer may contain further buckets which are not part of the view
+    struct LevelView
+    {
+        std::shared_ptr<Buckets const> buffer;
+        size_t begin = 0;
+        size_t size = 0;
+
+        double const* getTimePoints() const { return buffer->mean.getColumn(StatisticsColumns::TimeColumn) + begin; }
+        double getFrontTime() const { return getTimePoints()[0]; }
+        double getBackTime() const { return getTimePoints()[size - 1]; }
+    };
+}
+
+StatisticsHistorySnapshot::StatisticsHistorySnapshot(StatisticsHistoryData data)
+    : _size(data.size())
+{
+    _buffer = std::make_shared<StatisticsHistoryData const>(std::move(data));
 }
 
-std::mutex& StatisticsHistory::getMutex() const
+struct StatisticsHistory::Impl
+{
+    struct Level
+    {
+        std::atomic<std::shared_ptr<LevelView const>> view;
+
+        //only accessed by the writer, buckets behind the current view can be written since no reader refers to them
+        std::shared_ptr<Buckets> writableBuffer;
+        int numNonAggregatedBuckets = 0;
+    };
+    std::array<Level, NumLevels> levels;
+    std::atomic<uint64_t> version = 0;
+    std::mutex writeMutex;
+
+    LevelView getView(int levelIndex) const
+    {
+        auto result = levels[levelIndex].view.load(std::memory_order_acquire);
+        return result ? *result : LevelView();
+    }
+
+    std::array<LevelView, NumLevels> getViews() const
+    {
+        std::array<LevelView, NumLevels> result;
+        for (int i = 0; i < NumLevels; ++i) {
+            result[i] = getView(i);
+        }
+        return result;
+    }
+
+    void publish(int levelIndex, std::shared_ptr<Buckets const> const& buffer, size_t begin, size_t size)
+    {
+        auto newView = std::make_shared<LevelView>();
+        newView->buffer = buffer;
+        newView->begin = begin;
+        newView->size = size;
+        levels[levelIndex].view.store(std::move(newView), std::memory_order_release);
+    }
+
+    //copies the most recent buckets into a new buffer with spare capacity and drops the older ones
+    //the returned view refers to the new buffer but is not published yet
+    LevelView reallocate(int levelIndex, LevelView const& view, size_t numRetainedBuckets)
+    {
+        auto& level = levels[levelIndex];
+        level.writableBuffer = std::make_shared<Buckets>(std::max(numRetainedBuckets * 2, LevelCapacity * 2));
+        if (numRetainedBuckets > 0) {
+            view.buffer->copyRows(view.begin + view.size - numRetainedBuckets, numRetainedBuckets, *level.writableBuffer, 0);
+        }
+        return LevelView{level.writableBuffer, 0, numRetainedBuckets};
+    }
+
+    //writeBucket writes the new bucket to the given row of the given buffer
+    void append(int levelIndex, std::function<void(Buckets&, size_t)> const& writeBucket)
+    {
+        auto& level = levels[levelIndex];
+        auto view = getView(levelIndex);
+        if (!level.writableBuffer || level.writableBuffer != view.buffer || view.begin + view.size == level.writableBuffer->mean.size()) {
+            auto isCoarsestLevel = levelIndex == NumLevels - 1;
+            view = reallocate(levelIndex, view, isCoarsestLevel ? view.size : std::min(view.size, LevelCapacity));
+        }
+        writeBucket(*level.writableBuffer, view.begin + view.size);
+        publish(levelIndex, level.writableBuffer, view.begin, view.size + 1);
+
+        if (levelIndex < NumLevels - 1 && ++level.numNonAggregatedBuckets == AggregationFactor) {
+            level.numNonAggregatedBuckets = 0;
+            auto const& source = *level.writableBuffer;
+            auto sourceRow = view.begin + view.size + 1 - AggregationFactor;
+            append(levelIndex + 1, [&](Buckets& target, size_t targetRow) { source.aggregateRows(sourceRow, AggregationFactor, target, targetRow); });
+        }
+    }
+
+    void clear()
+    {
+        for (int i = 0; i < NumLevels; ++i) {
+            levels[i].writableBuffer.reset();
+            levels[i].numNonAggregatedBuckets = 0;
+            publish(i, nullptr, 0, 0);
+        }
+    }
+};
+
+StatisticsHistory::StatisticsHistory()
+    : _impl(std::make_unique<Impl>())
+{}
+
+StatisticsHistory::~StatisticsHistory() = default;
+
+StatisticsHistorySnapshot StatisticsHistory::getSnapshot() const
 {
-    return _mutex;
+    auto result = query(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max(), std::numeric_limits<int>::max());
+    StatisticsHistoryData data;
+    data.reserve(result.mean.size());
+    for (size_t i = 0; i < result.mean.size(); ++i) {
+        data.emplace_back(result.mean.getRow(i));
+    }
+    return data;
 }
 
-StatisticsHistoryData& StatisticsHistory::getDataRef()
+StatisticsHistoryQueryResult StatisticsHistory::query(double startTime, double endTime, int maxDataPoints) const
 {
-    return _data;
+    struct Section
+    {
+        LevelView view;
+        size_t first;
+        size_t last;
+    };
+    std::vector<Section> sections;  //from recent to old
+
+    auto views = _impl->getViews();
+    auto coarsestLevel = NumLevels - 1;
+    while (coarsestLevel > 0 && views[coarsestLevel].size == 0) {
+        --coarsestLevel;
+    }
+
+    auto oldestTime = std::numeric_limits<double>::max();
+    for (auto const& view : views) {
+        if (view.size > 0) {
+            oldestTime = std::min(oldestTime, view.getFrontTime());
+        }
+    }
+    auto rangeStartTime = std::max(startTime, oldestTime);
+
+    auto timeLimit = endTime;
+    auto isTimeLimitInclusive = true;
+    for (int i = 0; i <= coarsestLevel; ++i) {
+        auto const& view = views[i];
+        if (view.size == 0) {
+            continue;
+        }
+        auto timePoints = view.getTimePoints();
+        auto first = StatisticsColumnService::findFirstIndex(timePoints, view.size, startTime);
+        auto last = isTimeLimitInclusive ? static_cast<size_t>(std::upper_bound(timePoints, timePoints + view.size, timeLimit) - timePoints)
+                                         : StatisticsColumnService::findFirstIndex(timePoints, view.size, timeLimit);
+        first = std::min(first, last);
+
+        //resolution too fine for the requested range => use a coarser level
+        if (i < coarsestLevel) {
+            auto isTooFine = last - first > static_cast<size_t>(maxDataPoints);
+            if (view.size > 1) {
+                auto timeDelta = (view.getBackTime() - view.getFrontTime()) / toDouble(view.size - 1);
+                isTooFine |= (std::min(timeLimit, view.getBackTime()) - rangeStartTime) > timeDelta * maxDataPoints;
+            }
+            if (isTooFine) {
+                continue;
+            }
+        }
+        if (first < last) {
+            sections.emplace_back(Section{view, first, last});
+        }
+
+        //the remaining older part of the range is only available in coarser levels
+        if (view.getFrontTime() <= startTime) {
+            break;
+        }
+        timeLimit = view.getFrontTime();
+        isTimeLimitInclusive = false;
+    }
+
+    //the most recent data point is always included in order to show the current values
+    auto finestLevel = std::find_if(views.begin(), views.end(), [](LevelView const& view) { return view.size > 0; });
+    if (finestLevel != views.end() && finestLevel->getBackTime() <= endTime && finestLevel->getBackTime() >= startTime) {
+        auto isIncluded = !sections.empty() && sections.front().view.getTimePoints()[sections.front().last - 1] >= finestLevel->getBackTime();
+        if (!isIncluded) {
+            sections.insert(sections.begin(), Section{*finestLevel, finestLevel->size - 1, finestLevel->size});
+        }
+    }
+
+    size_t numBuckets = 0;
+    for (auto const& section : sections) {
+        numBuckets += section.last - section.first;
+    }
+    Buckets buckets(numBuckets);
+    size_t row = 0;
+    for (auto section = sections.rbegin(); section != sections.rend(); ++section) {
+        auto numSectionBuckets = section->last - section->first;
+        section->view.buffer->copyRows(section->view.begin + section->first, numSectionBuckets, buckets, row);
+        row += numSectionBuckets;
+    }
+    return StatisticsHistoryQueryResult{std::move(buckets.mean), std::move(buckets.minimum), std::move(buckets.maximum)};
+}
+
+std::optional<std::pair<double, double>> StatisticsHistory::getTimeInterval() const
+{
+    std::optional<std::pair<double, double>> result;
+    for (auto const& view : _impl->getViews()) {
+        if (view.size == 0) {
+            continue;
+        }
+        if (!result) {
+            result = std::make_pair(view.getFrontTime(), view.getBackTime());
+        } else {
+            result->first = std::min(result->first, view.getFrontTime());
+        }
+    }
+    return result;
+}
+
+std::optional<DataPointCollection> StatisticsHistory::getLastDataPoint() const
+{
+    for (auto const& view : _impl->getViews()) {
+        if (view.size > 0) {
+            return view.buffer->mean.getRow(view.begin + view.size - 1);
+        }
+    }
+    return std::nullopt;
+}
+
+uint64_t StatisticsHistory::getVersion() const
+{
+    return _impl->version.load();
+}
+
+void StatisticsHistory::append(DataPointCollection const& dataPoint)
+{
+    std::lock_guard lock(_impl->writeMutex);
+    _impl->append(0, [&](Buckets& target, size_t targetRow) { target.setRow(targetRow, dataPoint); });
+    ++_impl->version;
+}
+
+void StatisticsHistory::replaceBack(DataPointCollection const& dataPoint)
+{
+    std::lock_guard lock(_impl->writeMutex);
+    auto views = _impl->getViews();
+    auto level = static_cast<int>(std::find_if(views.begin(), views.end(), [](LevelView const& view) { return view.size > 0; }) - views.begin());
+    if (level == NumLevels) {
+        return;
+    }
+
+    //readers may still refer to the last bucket, hence a new buffer is needed
+    //an already aggregated bucket is kept in the coarser levels
+    auto view = _impl->reallocate(level, views[level], views[level].size);
+    _impl->levels[level].writableBuffer->setRow(view.size - 1, dataPoint);
+    _impl->publish(level, view.buffer, view.begin, view.size);
+    ++_impl->version;
+}
+
+void StatisticsHistory::set(StatisticsHistorySnapshot const& snapshot)
+{
+    std::lock_guard lock(_impl->writeMutex);
+    _impl->clear();
+
+    //the data points are kept at their resolution in the coarsest level, new data points will be aggregated behind them
+    if (!snapshot.empty()) {
+        auto& level = _impl->levels[NumLevels - 1];
+        level.writableBuffer = std::make_shared<Buckets>(std::max(snapshot.size() * 2, LevelCapacity * 2));
+        for (size_t i = 0; i < snapshot.size(); ++i) {
+            level.writableBuffer->setRow(i, snapshot[i]);
+        }
+        _impl->publish(NumLevels - 1, level.writableBuffer, 0, snapshot.size());
+    }
+    ++_impl->version;
 }
 
-StatisticsHistoryData const& StatisticsHistory::getDataRef() const
+void StatisticsHistory::clear()
 {
-    return _data;
+    std::lock_guard lock(_impl->writeMutex);
+    _impl->clear();
+    ++_impl->version;
 }
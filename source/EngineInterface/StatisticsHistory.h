@@ -1,23 +1,76 @@
 #pragma once
 
-#include <mutex>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include "DataPointCollection.h"
 #include "Definitions.h"
+#include "StatisticsColumns.h"
 
 using StatisticsHistoryData = std::vector<DataPointCollection>;
 
+//immutable view of a statistics history, copying a snapshot shares the data points instead of copying them
+class StatisticsHistorySnapshot
+{
+public:
+    StatisticsHistorySnapshot() = default;
+    StatisticsHistorySnapshot(StatisticsHistoryData data);
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+    DataPointCollection const* data() const { return _buffer ? _buffer->data() : nullptr; }
+    DataPointCollection const* begin() const { return data(); }
+    DataPointCollection const* end() const { return data() + _size; }
+    DataPointCollection const& operator[](size_t index) const { return (*_buffer)[index]; }
+    DataPointCollection const& front() const { return (*_buffer)[0]; }
+    DataPointCollection const& back() const { return (*_buffer)[_size - 1]; }
+
+private:
+    std::shared_ptr<StatisticsHistoryData const> _buffer;
+    size_t _size = 0;
+};
+
+//data points of a queried time range, row i of each column set refers to the same bucket of aggregated data points
+struct StatisticsHistoryQueryResult
+{
+    StatisticsColumns mean;
+    StatisticsColumns minimum;
+    StatisticsColumns maximum;
+};
+
+//the history is stored as a pyramid of levels: level 0 contains the data points at full resolution and each further level
+//aggregates a fixed number of buckets of the previous level into one bucket carrying mean, minimum and maximum
+//each level is stored column-wise (see StatisticsColumns)
+//all levels except the coarsest one only retain their most recent buckets, older time ranges are covered by the coarser levels
+//the history is written by a single thread (see _StatisticsService) while other threads can query it without blocking it
 class StatisticsHistory
 {
 public:
-    StatisticsHistoryData getCopiedData() const;
+    StatisticsHistory();
+    ~StatisticsHistory();
+
+    //returns the finest resolution available for each time range for the whole history, e.g. for serialization
+    StatisticsHistorySnapshot getSnapshot() const;
+
+    //returns [startTime, endTime] at the finest resolution which needs about maxDataPoints buckets for the range (e.g. the plot width in pixels)
+    //older parts of the range which are no longer retained at that resolution are taken from coarser levels
+    StatisticsHistoryQueryResult query(double startTime, double endTime, int maxDataPoints) const;
+
+    std::optional<std::pair<double, double>> getTimeInterval() const;
+    std::optional<DataPointCollection> getLastDataPoint() const;
+
+    //is incremented on each change and can be used to cache query results
+    uint64_t getVersion() const;
 
-    std::mutex& getMutex() const;
-    StatisticsHistoryData& getDataRef();
-    StatisticsHistoryData const& getDataRef() const;
+    void append(DataPointCollection const& dataPoint);
+    void replaceBack(DataPointCollection const& dataPoint);
+    void set(StatisticsHistorySnapshot const& snapshot);
+    void clear();
 
 private:
-    mutable std::mutex _mutex;
-    StatisticsHistoryData _data;
+    struct Impl;
+    std::unique_ptr<Impl> _impl;
 };
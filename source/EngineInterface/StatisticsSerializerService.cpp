@@ -0,0 +1,280 @@
+#include "StatisticsSerializerService.h"
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+
+static_assert(std::endian::native == std::endian::little, "Statistics data is stored in little-endian byte order.");
+
+std::string const StatisticsSerializerService::FormatMarker = "alien.statistics";
+
+namespace
+{
+    //column ids must never be changed or reused: 0 = time, 1 = system clock,
+    //the values of the i-th data point are stored in the columns 2 + 8 * i + [0, 7] (the last one for the accumulated value)
+    auto constexpr Column_Time = 0u;
+    auto constexpr Column_SystemClock = 1u;
+    auto constexpr Column_FirstDataPoint = 2u;
+
+    template <typename Func>
+    void forEachValue(DataPointCollection& dataPoints, Func const& func)
+    {
+        func(Column_Time, dataPoints.time);
+        func(Column_SystemClock, dataPoints.systemClock);
+
+        //new data points must be added at the end
+        DataPoint* dataPointsInOrder[] = {
+            &dataPoints.numCells,
+            &dataPoints.numSelfReplicators,
+            &dataPoints.numViruses,
+            &dataPoints.numConnections,
+            &dataPoints.numParticles,
+            &dataPoints.averageGenomeCells,
+            &dataPoints.totalEnergy,
+            &dataPoints.numCreatedCells,
+            &dataPoints.numAttacks,
+            &dataPoints.numMuscleActivities,
+            &dataPoints.numDefenderActivities,
+            &dataPoints.numTransmitterActivities,
+            &dataPoints.numInjectionActivities,
+            &dataPoints.numCompletedInjections,
+            &dataPoints.numNervePulses,
+            &dataPoints.numNeuronActivities,
+            &dataPoints.numSensorActivities,
+            &dataPoints.numSensorMatches,
+            &dataPoints.numReconnectorCreated,
+            &dataPoints.numReconnectorRemoved,
+            &dataPoints.numDetonations,
+            &dataPoints.numColonies,
+            &dataPoints.averageGenomeComplexity,
+            &dataPoints.maxGenomeComplexityOfColonies,
+            &dataPoints.varianceGenomeComplexity};
+        auto columnId = Column_FirstDataPoint;
+        for (auto const& dataPoint : dataPointsInOrder) {
+            for (int i = 0; i < MAX_COLORS; ++i) {
+                func(columnId++, dataPoint->values[i]);
+            }
+            func(columnId++, dataPoint->summedValues);
+        }
+    }
+
+    std::vector<uint32_t> getColumnIds()
+    {
+        std::vector<uint32_t> result;
+        DataPointCollection dataPoints;
+        forEachValue(dataPoints, [&](uint32_t columnId, double&) { result.emplace_back(columnId); });
+        return result;
+    }
+
+    template <typename T>
+    void write(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool read(std::istream& stream, T& value)
+    {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return stream.gcount() == sizeof(T);
+    }
+
+    void writeHeader(std::ostream& stream, std::vector<uint32_t> const& columnIds)
+    {
+        stream.write(StatisticsSerializerService::FormatMarker.data(), StatisticsSerializerService::FormatMarker.size());
+        write(stream, StatisticsSerializerService::FormatVersion);
+        write(stream, static_cast<uint32_t>(columnIds.size()));
+        stream.write(reinterpret_cast<char const*>(columnIds.data()), columnIds.size() * sizeof(uint32_t));
+    }
+
+    std::vector<uint32_t> readHeader(std::istream& stream)
+    {
+        std::string marker(StatisticsSerializerService::FormatMarker.size(), '\0');
+        stream.read(marker.data(), marker.size());
+        if (marker != StatisticsSerializerService::FormatMarker) {
+            throw std::runtime_error("Unknown statistics format.");
+        }
+        uint32_t formatVersion = 0;
+        uint32_t numColumns = 0;
+        if (!read(stream, formatVersion) || !read(stream, numColumns)) {
+            throw std::runtime_error("Statistics header incomplete.");
+        }
+        if (formatVersion > StatisticsSerializerService::FormatVersion) {
+            throw std::runtime_error("Statistics format version not supported.");
+        }
+        std::vector<uint32_t> result(numColumns);
+        auto numBytes = static_cast<std::streamsize>(numColumns * sizeof(uint32_t));
+        stream.read(reinterpret_cast<char*>(result.data()), numBytes);
+        if (stream.gcount() != numBytes) {
+            throw std::runtime_error("Statistics header incomplete.");
+        }
+        return result;
+    }
+
+    void writeRowGroup(std::ostream& stream, std::span<DataPointCollection const> statistics, size_t startRow, size_t numColumns)
+    {
+        auto numRows = statistics.size() - startRow;
+        if (numRows == 0) {
+            return;
+        }
+        std::vector<double> values(numColumns * numRows);
+        for (size_t row = 0; row < numRows; ++row) {
+            size_t column = 0;
+            forEachValue(const_cast<DataPointCollection&>(statistics[startRow + row]), [&](uint32_t, double& value) {
+                values[column * numRows + row] = value;
+                ++column;
+            });
+        }
+        write(stream, static_cast<uint64_t>(numRows));
+        stream.write(reinterpret_cast<char const*>(values.data()), values.size() * sizeof(double));
+    }
+
+    //row groups which are incomplete (e.g. due to an interrupted append) are ignored
+    void readRowGroups(StatisticsHistoryData& statistics, std::istream& stream, std::vector<uint32_t> const& columnIds)
+    {
+        std::vector<int> columnIndexById;
+        for (size_t i = 0; i < columnIds.size(); ++i) {
+            if (columnIds[i] >= columnIndexById.size()) {
+                columnIndexById.resize(columnIds[i] + 1, -1);
+            }
+            columnIndexById[columnIds[i]] = static_cast<int>(i);
+        }
+
+        std::vector<double> values;
+        uint64_t numRows = 0;
+        while (read(stream, numRows)) {
+            values.resize(numRows * columnIds.size());
+            auto numBytes = static_cast<std::streamsize>(values.size() * sizeof(double));
+            stream.read(reinterpret_cast<char*>(values.data()), numBytes);
+            if (stream.gcount() != numBytes) {
+                break;
+            }
+            auto startRow = statistics.size();
+            statistics.resize(startRow + numRows);
+            for (uint64_t row = 0; row < numRows; ++row) {
+                forEachValue(statistics[startRow + row], [&](uint32_t columnId, double& value) {
+                    if (columnId < columnIndexById.size() && columnIndexById[columnId] != -1) {
+                        value = values[columnIndexById[columnId] * numRows + row];
+                    }
+                });
+            }
+        }
+    }
+
+    //returns the number of rows in the file if they are a prefix of statistics (checked by means of the last row)
+    //an incomplete row group at the end of the file is removed
+    std::optional<uint64_t> getNumAppendableRows(std::string const& filename, std::span<DataPointCollection const> statistics, std::vector<uint32_t> const& columnIds)
+    {
+        std::error_code errorCode;
+        auto fileSize = std::filesystem::file_size(filename, errorCode);
+        if (errorCode) {
+            return std::nullopt;
+        }
+        uint64_t numRows = 0;
+        uint64_t validSize = 0;
+        std::vector<double> lastRow(columnIds.size());
+        {
+            std::ifstream stream(filename, std::ios::binary);
+            try {
+                if (readHeader(stream) != columnIds) {
+                    return std::nullopt;
+                }
+            } catch (std::runtime_error const&) {
+                return std::nullopt;
+            }
+            validSize = static_cast<uint64_t>(stream.tellg());
+
+            uint64_t numRowsInGroup = 0;
+            std::optional<uint64_t> lastGroupDataPos;
+            uint64_t numRowsInLastGroup = 0;
+            while (read(stream, numRowsInGroup)) {
+                auto dataPos = static_cast<uint64_t>(stream.tellg());
+                auto endPos = dataPos + numRowsInGroup * columnIds.size() * sizeof(double);
+                if (endPos > fileSize) {
+                    break;
+                }
+                if (numRowsInGroup > 0) {
+                    lastGroupDataPos = dataPos;
+                    numRowsInLastGroup = numRowsInGroup;
+                }
+                numRows += numRowsInGroup;
+                validSize = endPos;
+                stream.seekg(static_cast<std::streamoff>(endPos));
+            }
+            if (numRows > statistics.size()) {
+                return std::nullopt;
+            }
+            if (lastGroupDataPos) {
+                stream.clear();
+                for (size_t column = 0; column < columnIds.size(); ++column) {
+                    auto pos = *lastGroupDataPos + (column * numRowsInLastGroup + numRowsInLastGroup - 1) * sizeof(double);
+                    stream.seekg(static_cast<std::streamoff>(pos));
+                    if (!read(stream, lastRow[column])) {
+                        return std::nullopt;
+                    }
+                }
+            }
+        }
+        if (numRows > 0) {
+            size_t column = 0;
+            bool equal = true;
+            forEachValue(const_cast<DataPointCollection&>(statistics[numRows - 1]), [&](uint32_t, double& value) {
+                equal &= std::memcmp(&value, &lastRow[column], sizeof(double)) == 0;
+                ++column;
+            });
+            if (!equal) {
+                return std::nullopt;
+            }
+        }
+        if (validSize < fileSize) {
+            std::filesystem::resize_file(filename, validSize);
+        }
+        return numRows;
+    }
+}
+
+void StatisticsSerializerService::serialize(std::span<DataPointCollection const> statistics, std::ostream& stream)
+{
+    auto columnIds = getColumnIds();
+    writeHeader(stream, columnIds);
+    writeRowGroup(stream, statistics, 0, columnIds.size());
+}
+
+void StatisticsSerializerService::deserialize(StatisticsHistoryData& statistics, std::istream& stream)
+{
+    statistics.clear();
+    auto columnIds = readHeader(stream);
+    readRowGroups(statistics, stream, columnIds);
+}
+
+bool StatisticsSerializerService::isBinaryFormat(std::istream& stream)
+{
+    auto pos = stream.tellg();
+    std::string marker(FormatMarker.size(), '\0');
+    stream.read(marker.data(), marker.size());
+    auto result = stream.gcount() == static_cast<std::streamsize>(marker.size()) && marker == FormatMarker;
+    stream.clear();
+    stream.seekg(pos);
+    return result;
+}
+
+void StatisticsSerializerService::serializeToFile(std::string const& filename, std::span<DataPointCollection const> statistics)
+{
+    auto columnIds = getColumnIds();
+    if (auto numRows = getNumAppendableRows(filename, statistics, columnIds)) {
+        std::ofstream stream(filename, std::ios::binary | std::ios::app);
+        writeRowGroup(stream, statistics, *numRows, columnIds.size());
+        if (!stream) {
+            throw std::runtime_error("Could not append to statistics file.");
+        }
+    } else {
+        std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+        serialize(statistics, stream);
+        if (!stream) {
+            throw std::runtime_error("Could not write statistics file.");
+        }
+    }
+}
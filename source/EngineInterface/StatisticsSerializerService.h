@@ -0,0 +1,27 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <span>
+
+#include "Base/Definitions.h"
+
+#include "StatisticsHistory.h"
+
+//binary columnar format for statistics histories: a header with a field-presence table followed by row groups
+//each row group stores its values column by column, new rows are appended as further row groups
+class StatisticsSerializerService
+{
+public:
+    static std::string const FormatMarker;
+    static uint32_t constexpr FormatVersion = 1;
+
+    static void serialize(std::span<DataPointCollection const> statistics, std::ostream& stream);
+    static void deserialize(StatisticsHistoryData& statistics, std::istream& stream);
+
+    //checks the format marker without consuming the stream
+    static bool isBinaryFormat(std::istream& stream);
+
+    //only appends the rows which are not yet contained in the file, the file is rewritten if its rows are not a prefix of statistics
+    static void serializeToFile(std::string const& filename, std::span<DataPointCollection const> statistics);
+};
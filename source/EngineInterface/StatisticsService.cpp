@@ -0,0 +1,78 @@
+#include "StatisticsService.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Definitions.h"
+
+#include "StatisticsConverterService.h"
+
+void _StatisticsService::addDataPoint(StatisticsHistory& history, TimelineStatistics const& newRawStatistics, uint64_t timestep)
+{
+    auto lastDataPoint = history.getLastDataPoint();
+
+    if (lastDataPoint && lastDataPoint->time > toDouble(timestep) + NEAR_ZERO) {
+        history.clear();
+        lastDataPoint.reset();
+    }
+
+    if (!_lastRawStatistics || !lastDataPoint || toDouble(timestep) - lastDataPoint->time > TimestepDelta / 100 * (_numDataPoints + 1)) {
+        auto newDataPoint = [&] {
+            if (!_lastRawStatistics && lastDataPoint) {
+
+                //reuse last entry if no raw statistics is available
+                auto result = *lastDataPoint;
+                result.time = toDouble(timestep);
+                return result;
+            } else {
+                return StatisticsConverterService::convert(newRawStatistics, timestep, toDouble(timestep), _lastRawStatistics, _lastTimestep);
+            }
+        }();
+
+        _lastRawStatistics = newRawStatistics;
+        _lastTimestep = timestep;
+        _accumulatedDataPoint = _accumulatedDataPoint.has_value() ? *_accumulatedDataPoint + newDataPoint : newDataPoint;
+        ++_numDataPoints;
+    }
+
+    if (_accumulatedDataPoint.has_value() && (!lastDataPoint || toDouble(timestep) - lastDataPoint->time > TimestepDelta)) {
+        auto newDataPoint = *_accumulatedDataPoint / _numDataPoints;
+        _numDataPoints = 0;
+        _accumulatedDataPoint.reset();
+
+        //replace last entry if timestep has not changed
+        if (lastDataPoint && std::abs(lastDataPoint->time - toDouble(timestep)) < NEAR_ZERO) {
+            history.replaceBack(newDataPoint);
+        } else {
+            history.append(newDataPoint);
+        }
+    }
+}
+
+void _StatisticsService::resetTime(StatisticsHistory& history, uint64_t timestep)
+{
+    auto data = history.getSnapshot();
+    if (data.empty()) {
+        return;
+    }
+
+    StatisticsHistoryData newData;
+    newData.reserve(data.size());
+    for (auto const& dataPoint : data) {
+        if (dataPoint.time < toDouble(timestep)) {
+            newData.emplace_back(dataPoint);
+        }
+    }
+    history.set(std::move(newData));
+    _accumulatedDataPoint.reset();
+    _numDataPoints = 0;
+}
+
+void _StatisticsService::rewriteHistory(StatisticsHistory& history, StatisticsHistorySnapshot const& newHistoryData)
+{
+    _accumulatedDataPoint.reset();
+    _numDataPoints = 0;
+    _lastRawStatistics.reset();
+    _lastTimestep.reset();
+    history.set(newHistoryData);
+}
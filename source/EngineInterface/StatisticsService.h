@@ -1,19 +1,23 @@
+#pragma once
+
 #include <optional>
 
-#include "EngineInterface/StatisticsHistory.h"
-#include "Definitions.cuh"
+#include "DataPointCollection.h"
+#include "RawStatisticsData.h"
+#include "StatisticsHistory.h"
+
+#include "Definitions.h"
 
 class _StatisticsService
 {
 public:
     void addDataPoint(StatisticsHistory& history, TimelineStatistics const& newRawStatistics, uint64_t timestep);
     void resetTime(StatisticsHistory& history, uint64_t timestep);
-    void rewriteHistory(StatisticsHistory& history, StatisticsHistoryData const& newHistoryData, uint64_t timestep);
+    void rewriteHistory(StatisticsHistory& history, StatisticsHistorySnapshot const& newHistoryData);
 
 private:
-    static auto constexpr DefaultTimeStepDelta = 10.0;
-
-    double _longtermTimestepDelta = DefaultTimeStepDelta;
+    //time steps between data points at full resolution, coarser resolutions are aggregated by the history
+    static auto constexpr TimestepDelta = 10.0;
 
     int _numDataPoints = 0;
     std::optional<DataPointCollection> _accumulatedDataPoint;
@@ -0,0 +1,26 @@
+#include "TimestepBatchService.h"
+
+#include <algorithm>
+
+int TimestepBatchService::calcBatchSize(float averageTimestepDuration, int tpsRestriction)
+{
+    if (tpsRestriction > 0 || averageTimestepDuration <= 0) {
+        return 1;
+    }
+    return static_cast<int>(std::clamp(TargetBatchDuration / averageTimestepDuration, 1.0f, static_cast<float>(MaxTimestepsPerBatch)));
+}
+
+int TimestepBatchService::calcBatch(int batchSize, std::function<void()> const& calcTimestep, std::function<bool()> const& isInterrupted)
+{
+    auto result = 0;
+    do {
+        calcTimestep();
+        ++result;
+    } while (result < batchSize && !isInterrupted());
+    return result;
+}
+
+float TimestepBatchService::calcAverageTimestepDuration(float averageTimestepDuration, float lastTimestepDuration)
+{
+    return averageTimestepDuration > 0 ? averageTimestepDuration * 0.9f + lastTimestepDuration * 0.1f : lastTimestepDuration;
+}
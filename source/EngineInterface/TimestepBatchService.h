@@ -0,0 +1,21 @@
+#pragma once
+
+#include <functional>
+
+//small worlds are calculated in batches of time steps to reduce the host overhead per time step
+//a batch is interrupted as soon as another thread requests access or submits a command
+class TimestepBatchService
+{
+public:
+    static auto constexpr TargetBatchDuration = 2000.0f;  //in microseconds
+    static auto constexpr MaxTimestepsPerBatch = 64;
+
+    //averageTimestepDuration in microseconds, 0 if not measured yet
+    static int calcBatchSize(float averageTimestepDuration, int tpsRestriction);
+
+    //calculates at least one time step and continues until the batch size is reached or isInterrupted returns true
+    //returns the number of calculated time steps
+    static int calcBatch(int batchSize, std::function<void()> const& calcTimestep, std::function<bool()> const& isInterrupted);
+
+    static float calcAverageTimestepDuration(float averageTimestepDuration, float lastTimestepDuration);
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+//usage of the host buffers for data transfers between CPU and GPU
+struct TransferBufferStatistics
+{
+    uint64_t numHits = 0;
+    uint64_t numMisses = 0;
+    uint64_t allocatedBytes = 0;
+    uint64_t numLeasedBuffers = 0;
+};
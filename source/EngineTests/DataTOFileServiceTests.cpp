@@ -0,0 +1,117 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include <gtest/gtest.h>
+
+#include "EngineImpl/DataTOFileService.h"
+#include "EngineInterface/SerializerService.h"
+
+class DataTOFileServiceTests : public ::testing::Test
+{
+public:
+    DataTOFileServiceTests() { _dataTO.init({2, 1, 3}); }
+    ~DataTOFileServiceTests() { _dataTO.destroy(); }
+
+protected:
+    //positions in the file header: marker, 4 x uint32_t, program version, 7 x uint64_t
+    static auto constexpr ProgramVersionPos = 8 + 4 * sizeof(uint32_t);
+    static auto constexpr LayoutOffsetPos = ProgramVersionPos + 32 + 6 * sizeof(uint64_t);
+
+    void SetUp() override
+    {
+        _filename = (std::filesystem::temp_directory_path() / "alien_DataTOFileServiceTests.sim").string();
+
+        *_dataTO.numCells = 2;
+        *_dataTO.numParticles = 1;
+        *_dataTO.numAuxiliaryData = 3;
+        std::memset(_dataTO.cells, 0, sizeof(CellTO) * 2);
+        std::memset(_dataTO.particles, 0, sizeof(ParticleTO));
+        _dataTO.cells[0].id = 1;
+        _dataTO.cells[1].id = 2;
+        _dataTO.cells[1].energy = 100.0f;
+        _dataTO.particles[0].id = 3;
+        for (int i = 0; i < 3; ++i) {
+            _dataTO.auxiliaryData[i] = static_cast<uint8_t>(i + 10);
+        }
+    }
+
+    void TearDown() override { std::filesystem::remove(_filename); }
+
+    std::string readFile() const
+    {
+        std::ifstream stream(_filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(std::string const& content) const
+    {
+        std::ofstream stream(_filename, std::ios::binary | std::ios::trunc);
+        stream << content;
+    }
+
+    std::string _filename;
+    DataTO _dataTO;
+};
+
+TEST_F(DataTOFileServiceTests, writeAndMap)
+{
+    DataTOFileService::writeToFile(_filename, _dataTO);
+    EXPECT_TRUE(SerializerService::isSnapshotFile(_filename));
+
+    auto mappedDataTO = DataTOFileService::mapFromFile(_filename);
+    ASSERT_EQ(2, *mappedDataTO.dataTO.numCells);
+    ASSERT_EQ(1, *mappedDataTO.dataTO.numParticles);
+    ASSERT_EQ(3, *mappedDataTO.dataTO.numAuxiliaryData);
+    EXPECT_EQ(2, mappedDataTO.dataTO.cells[1].id);
+    EXPECT_EQ(100.0f, mappedDataTO.dataTO.cells[1].energy);
+    EXPECT_EQ(3, mappedDataTO.dataTO.particles[0].id);
+    EXPECT_EQ(12, mappedDataTO.dataTO.auxiliaryData[2]);
+}
+
+TEST_F(DataTOFileServiceTests, otherProgramVersionWithSameLayout)
+{
+    DataTOFileService::writeToFile(_filename, _dataTO);
+    auto content = readFile();
+    content.replace(ProgramVersionPos, 5, "0.0.1");
+    writeFile(content);
+
+    auto mappedDataTO = DataTOFileService::mapFromFile(_filename);
+    EXPECT_EQ(2, *mappedDataTO.dataTO.numCells);
+}
+
+TEST_F(DataTOFileServiceTests, differentLayout)
+{
+    DataTOFileService::writeToFile(_filename, _dataTO);
+    auto content = readFile();
+
+    //the offset of the layout table is the last header field, the table starts with the sizes of CellTO, ParticleTO and CellFunctionTO
+    uint64_t layoutOffset;
+    std::memcpy(&layoutOffset, content.data() + LayoutOffsetPos, sizeof(layoutOffset));
+    auto cellFunctionTOSizePos = layoutOffset + 2 * sizeof(uint32_t);
+    uint32_t cellFunctionTOSize;
+    std::memcpy(&cellFunctionTOSize, content.data() + cellFunctionTOSizePos, sizeof(cellFunctionTOSize));
+    ++cellFunctionTOSize;
+    std::memcpy(content.data() + cellFunctionTOSizePos, &cellFunctionTOSize, sizeof(cellFunctionTOSize));
+    writeFile(content);
+
+    EXPECT_THROW(DataTOFileService::mapFromFile(_filename), std::runtime_error);
+}
+
+TEST_F(DataTOFileServiceTests, truncatedFile)
+{
+    DataTOFileService::writeToFile(_filename, _dataTO);
+    auto content = readFile();
+    writeFile(content.substr(0, content.size() - 1));
+
+    EXPECT_THROW(DataTOFileService::mapFromFile(_filename), std::runtime_error);
+}
+
+TEST_F(DataTOFileServiceTests, noSnapshotFile)
+{
+    writeFile("no snapshot");
+
+    EXPECT_FALSE(SerializerService::isSnapshotFile(_filename));
+    EXPECT_THROW(DataTOFileService::mapFromFile(_filename), std::runtime_error);
+}
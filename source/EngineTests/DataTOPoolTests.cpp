@@ -0,0 +1,60 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "EngineImpl/DataTOPool.h"
+
+class DataTOPoolTests : public ::testing::Test
+{
+protected:
+    ArraySizes const SmallSizes{100, 100, 1000};
+    ArraySizes const LargeSizes{10000, 10000, 100000};
+};
+
+TEST_F(DataTOPoolTests, freeBufferReused)
+{
+    auto pool = std::make_shared<_DataTOPool>(false);
+    pool->acquire(SmallSizes);
+    auto allocatedBytes = pool->getStatistics().allocatedBytes;
+
+    pool->acquire(SmallSizes);
+
+    auto statistics = pool->getStatistics();
+    EXPECT_EQ(1, statistics.numHits);
+    EXPECT_EQ(1, statistics.numMisses);
+    EXPECT_EQ(allocatedBytes, statistics.allocatedBytes);
+}
+
+TEST_F(DataTOPoolTests, freeBytesLimited)
+{
+    auto pool = std::make_shared<_DataTOPool>(false, 1);
+    {
+        auto smallLease = pool->acquire(SmallSizes);
+        auto largeLease = pool->acquire(LargeSizes);
+    }
+    auto statistics = pool->getStatistics();
+    EXPECT_EQ(0, statistics.numLeasedBuffers);
+
+    //only the buffer released last is kept
+    auto lease = pool->acquire(SmallSizes);
+    EXPECT_EQ(1, pool->getStatistics().numHits);
+    EXPECT_EQ(statistics.allocatedBytes, pool->getStatistics().allocatedBytes);
+    EXPECT_LT(lease.getCapacities().cellArraySize, LargeSizes.cellArraySize);
+}
+
+TEST_F(DataTOPoolTests, idleBuffersEvicted)
+{
+    auto referencePool = std::make_shared<_DataTOPool>(false);
+    auto referenceLease = referencePool->acquire(SmallSizes);
+
+    auto pool = std::make_shared<_DataTOPool>(false, _DataTOPool::DefaultMaxFreeBytes, std::chrono::milliseconds(10));
+    pool->acquire(LargeSizes);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    auto lease = pool->acquire(SmallSizes);
+
+    auto statistics = pool->getStatistics();
+    EXPECT_EQ(0, statistics.numHits);
+    EXPECT_EQ(2, statistics.numMisses);
+    EXPECT_EQ(referencePool->getStatistics().allocatedBytes, statistics.allocatedBytes);
+}
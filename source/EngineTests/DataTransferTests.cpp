@@ -1,8 +1,12 @@
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include "Base/NumberGenerator.h"
+#include "EngineInterface/ClusteredDataReader.h"
 #include "EngineInterface/DescriptionEditService.h"
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
 #include "EngineInterface/SimulationFacade.h"
 #include "IntegrationTestFramework.h"
 
@@ -146,3 +150,107 @@ TEST_F(DataTransferTests, largeData)
         EXPECT_EQ(data.particles.size() + newData.particles.size(), actualData.particles.size());
     }
 }
+
+TEST_F(DataTransferTests, clusteredData)
+{
+    DataDescription data;
+    for (int x = 0; x < 10; ++x) {
+        for (int y = 0; y < 10; ++y) {
+            data.add(DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters()
+                                                            .width(x + 1)
+                                                            .height(y + 1)
+                                                            .center({toFloat(x) * 50.0f + 25.0f, toFloat(y) * 50.0f + 25.0f})));
+        }
+    }
+
+    _simulationFacade->setSimulationData(data);
+    auto actualData = _simulationFacade->getClusteredSimulationData();
+
+    ASSERT_EQ(100, actualData.clusters.size());
+    std::vector<size_t> actualClusterSizes;
+    for (auto const& cluster : actualData.clusters) {
+        actualClusterSizes.emplace_back(cluster.cells.size());
+    }
+    std::vector<size_t> expectedClusterSizes;
+    for (int x = 0; x < 10; ++x) {
+        for (int y = 0; y < 10; ++y) {
+            expectedClusterSizes.emplace_back((x + 1) * (y + 1));
+        }
+    }
+    std::ranges::sort(actualClusterSizes);
+    std::ranges::sort(expectedClusterSizes);
+    EXPECT_EQ(expectedClusterSizes, actualClusterSizes);
+    EXPECT_TRUE(compare(data, DataDescription(actualData)));
+}
+
+TEST_F(DataTransferTests, identicalGenomes)
+{
+    auto genome1 = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+    auto genome2 = GenomeDescriptionService::convertDescriptionToBytes(
+        GenomeDescription().setCells({CellGenomeDescription(), CellGenomeDescription().setCellFunction(NerveGenomeDescription())}));
+
+    DataDescription data;
+    for (int i = 0; i < 100; ++i) {
+        auto const& genome = i % 3 == 0 ? genome2 : genome1;
+        auto pos = RealVector2D{toFloat(i % 10) * 10.0f + 5.0f, toFloat(i / 10) * 10.0f + 5.0f};
+        if (i % 2 == 0) {
+            data.addCell(CellDescription().setId(i + 1).setPos(pos).setCellFunction(ConstructorDescription().setGenome(genome)));
+        } else {
+            data.addCell(CellDescription().setId(i + 1).setPos(pos).setCellFunction(InjectorDescription().setGenome(genome)));
+        }
+    }
+
+    _simulationFacade->setSimulationData(data);
+    auto actualData = _simulationFacade->getSimulationData();
+
+    EXPECT_TRUE(compare(data, actualData));
+}
+
+TEST_F(DataTransferTests, transferBuffersReused)
+{
+    auto data = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(50).height(50).center({100.0f, 100.0f}));
+
+    _simulationFacade->setSimulationData(data);
+    _simulationFacade->getSimulationData();
+    auto origStatistics = _simulationFacade->getTransferBufferStatistics();
+
+    for (int i = 0; i < 3; ++i) {
+        _simulationFacade->getSimulationData();
+    }
+    auto statistics = _simulationFacade->getTransferBufferStatistics();
+
+    EXPECT_EQ(origStatistics.numHits + 3, statistics.numHits);
+    EXPECT_EQ(origStatistics.numMisses, statistics.numMisses);
+    EXPECT_EQ(origStatistics.allocatedBytes, statistics.allocatedBytes);
+    EXPECT_EQ(0, statistics.numLeasedBuffers);
+}
+
+TEST_F(DataTransferTests, clusteredDataReaderUsesChunkSizedBuffers)
+{
+    auto pattern = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(3).height(3).center({10.0f, 10.0f}));
+    auto data = DescriptionEditService::randomMultiply(
+                    pattern, DescriptionEditService::RandomMultiplyParameters().number(1000).seed(1), _simulationFacade->getWorldSize(), DataDescription())
+                    .data;
+    for (int i = 0; i < 1000; ++i) {
+        data.addParticle(ParticleDescription().setId(100000 + i).setPos({toFloat(i % 100) * 10.0f, toFloat(i / 100) * 10.0f}).setEnergy(10.0f));
+    }
+    _simulationFacade->setSimulationData(data);
+    auto expectedData = _simulationFacade->getClusteredSimulationData();
+    auto origStatistics = _simulationFacade->getTransferBufferStatistics();
+
+    //no buffer for the whole simulation is held while reading
+    auto reader = _simulationFacade->getClusteredSimulationDataReader();
+    EXPECT_EQ(0, _simulationFacade->getTransferBufferStatistics().numLeasedBuffers);
+
+    ClusteredDataDescription actualData;
+    while (auto chunk = reader->readNextChunk()) {
+        actualData.addClusters(chunk->clusters);
+        actualData.addParticles(chunk->particles);
+        EXPECT_EQ(0, _simulationFacade->getTransferBufferStatistics().numLeasedBuffers);
+    }
+    auto statistics = _simulationFacade->getTransferBufferStatistics();
+    EXPECT_LE(statistics.allocatedBytes, origStatistics.allocatedBytes);
+
+    EXPECT_EQ(expectedData.clusters.size(), actualData.clusters.size());
+    EXPECT_TRUE(compare(DataDescription(expectedData), DataDescription(actualData)));
+}
@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "EngineImpl/DescriptionConverter.h"
+
+//counts the heap allocations of the test binary for the allocation benchmark
+namespace
+{
+    std::atomic<uint64_t> numAllocations{0};
+}
+
+void* operator new(std::size_t size)
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto result = std::malloc(size > 0 ? size : 1)) {
+        return result;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+class DescriptionConverterTests : public ::testing::Test
+{
+protected:
+    DescriptionConverterTests()
+        : _converter(SimulationParameters())
+    {}
+
+    ~DescriptionConverterTests() override
+    {
+        if (_dataTO.numCells) {
+            _dataTO.destroy();
+        }
+    }
+
+    //cells are connected to chains of the given lengths, the cells of the chains are shuffled in the cell array
+    DataTO const& createChains(std::vector<int> const& chainLengths)
+    {
+        auto numCells = 0;
+        for (auto const& chainLength : chainLengths) {
+            numCells += chainLength;
+        }
+        std::vector<int> positions(numCells);
+        std::iota(positions.begin(), positions.end(), 0);
+        std::shuffle(positions.begin(), positions.end(), _randomEngine);
+
+        _dataTO.init({toUInt64(numCells), 0, 0});
+        *_dataTO.numCells = numCells;
+        for (int i = 0; i < numCells; ++i) {
+            _dataTO.cells[i].numConnections = 0;
+        }
+        auto index = 0;
+        for (auto const& chainLength : chainLengths) {
+            for (int i = 1; i < chainLength; ++i) {
+                connect(positions[index + i - 1], positions[index + i]);
+            }
+            index += chainLength;
+        }
+        return _dataTO;
+    }
+
+    void connect(int cellIndex1, int cellIndex2)
+    {
+        auto& cell1 = _dataTO.cells[cellIndex1];
+        auto& cell2 = _dataTO.cells[cellIndex2];
+        cell1.connections[cell1.numConnections++].cellIndex = cellIndex2;
+        cell2.connections[cell2.numConnections++].cellIndex = cellIndex1;
+    }
+
+    //breadth-first scan with a hash set of unvisited cells as done before the union-find
+    std::vector<std::vector<int>> calcClustersViaBreadthFirstScan(DataTO const& dataTO) const
+    {
+        std::unordered_set<int> freeCellIndices;
+        for (int i = 0; i < toInt(*dataTO.numCells); ++i) {
+            freeCellIndices.insert(i);
+        }
+        std::vector<std::vector<int>> result;
+        while (!freeCellIndices.empty()) {
+            std::vector<int> cluster;
+            std::queue<int> cellIndicesToVisit;
+            auto startIndex = *freeCellIndices.begin();
+            freeCellIndices.erase(startIndex);
+            cellIndicesToVisit.push(startIndex);
+            while (!cellIndicesToVisit.empty()) {
+                auto cellIndex = cellIndicesToVisit.front();
+                cellIndicesToVisit.pop();
+                cluster.emplace_back(cellIndex);
+                auto const& cellTO = dataTO.cells[cellIndex];
+                for (int i = 0; i < cellTO.numConnections; ++i) {
+                    auto connectedIndex = cellTO.connections[i].cellIndex;
+                    if (freeCellIndices.erase(connectedIndex) == 1) {
+                        cellIndicesToVisit.push(connectedIndex);
+                    }
+                }
+            }
+            result.emplace_back(std::move(cluster));
+        }
+        return result;
+    }
+
+    //clusters as sorted cell indices ordered by their smallest cell index
+    std::vector<std::vector<int>> normalize(std::vector<std::vector<int>> clusters) const
+    {
+        for (auto& cluster : clusters) {
+            std::sort(cluster.begin(), cluster.end());
+        }
+        std::sort(clusters.begin(), clusters.end());
+        return clusters;
+    }
+
+    std::vector<std::vector<int>> toVector(DescriptionConverter::CellClusters const& cellClusters) const
+    {
+        std::vector<std::vector<int>> result;
+        for (uint64_t i = 0; i < cellClusters.getNumClusters(); ++i) {
+            result.emplace_back(
+                cellClusters.cellIndices.begin() + cellClusters.clusterStartIndices[i], cellClusters.cellIndices.begin() + cellClusters.clusterStartIndices[i + 1]);
+        }
+        return result;
+    }
+
+    int toInt(uint64_t value) const { return static_cast<int>(value); }
+    uint64_t toUInt64(int value) const { return static_cast<uint64_t>(value); }
+
+    DescriptionConverter _converter;
+    DataTO _dataTO;
+    std::mt19937 _randomEngine{42};
+};
+
+TEST_F(DescriptionConverterTests, calcCellClusters)
+{
+    auto const& dataTO = createChains({1, 5, 1, 1000, 2, 37});
+
+    auto cellClusters = _converter.calcCellClusters(dataTO);
+
+    ASSERT_EQ(6, cellClusters.getNumClusters());
+    EXPECT_EQ(normalize(calcClustersViaBreadthFirstScan(dataTO)), normalize(toVector(cellClusters)));
+
+    //clusters are ordered by their smallest cell index
+    for (uint64_t i = 1; i < cellClusters.getNumClusters(); ++i) {
+        EXPECT_LT(cellClusters.cellIndices[cellClusters.clusterStartIndices[i - 1]], cellClusters.cellIndices[cellClusters.clusterStartIndices[i]]);
+    }
+}
+
+//compares the timings with the former cluster detection, run with --gtest_also_run_disabled_tests
+TEST_F(DescriptionConverterTests, DISABLED_calcCellClustersBenchmark)
+{
+    //many small creatures and a few large structures
+    std::vector<int> chainLengths(50000, 10);
+    chainLengths.insert(chainLengths.end(), 5, 50000);
+    auto const& dataTO = createChains(chainLengths);
+
+    auto measure = [](auto const& func) {
+        auto constexpr NumIterations = 3;
+        auto startTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < NumIterations; ++i) {
+            func();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count() / NumIterations;
+    };
+    std::vector<std::vector<int>> breadthFirstClusters;
+    DescriptionConverter::CellClusters unionFindClusters;
+    auto breadthFirstTime = measure([&] { breadthFirstClusters = calcClustersViaBreadthFirstScan(dataTO); });
+    auto unionFindTime = measure([&] { unionFindClusters = _converter.calcCellClusters(dataTO); });
+
+    std::cout << "[          ] " << *dataTO.numCells << " cells in " << chainLengths.size() << " clusters" << std::endl;
+    std::cout << "[          ] cluster detection: " << breadthFirstTime << " ms (breadth-first scan), " << unionFindTime << " ms (union-find)" << std::endl;
+    EXPECT_EQ(normalize(breadthFirstClusters), normalize(toVector(unionFindClusters)));
+}
+
+namespace
+{
+    //neuron and activity data as stored in nested vectors before the fixed-size arrays
+    struct NestedNeuronData
+    {
+        std::vector<std::vector<float>> weights;
+        std::vector<float> biases;
+        std::vector<NeuronActivationFunction> activationFunctions;
+        std::vector<float> activityChannels;
+    };
+
+    struct FlatNeuronData
+    {
+        NeuronDescription neuron;
+        ActivityDescription activity;
+    };
+
+    //transfer data with weights and biases stored consecutively as in the auxiliary data
+    std::vector<float> createWeightsAndBiases()
+    {
+        std::vector<float> result(MAX_CHANNELS * (MAX_CHANNELS + 1));
+        std::iota(result.begin(), result.end(), 0.0f);
+        return result;
+    }
+
+    //conversion from transfer data as done by the former splitWeightsAndBias
+    void convertToNestedNeuronData(std::vector<float> const& weightsAndBiases, ActivityChannels const& activityChannels, std::vector<NestedNeuronData>& result)
+    {
+        for (auto& data : result) {
+            std::vector<float> weightsAndBiasesCopy(weightsAndBiases.begin(), weightsAndBiases.end());
+            data.weights = std::vector<std::vector<float>>(MAX_CHANNELS, std::vector<float>(MAX_CHANNELS, 0));
+            for (int row = 0; row < MAX_CHANNELS; ++row) {
+                for (int col = 0; col < MAX_CHANNELS; ++col) {
+                    data.weights[row][col] = weightsAndBiasesCopy[col + row * MAX_CHANNELS];
+                }
+            }
+            data.biases = std::vector<float>(weightsAndBiasesCopy.begin() + MAX_CHANNELS * MAX_CHANNELS, weightsAndBiasesCopy.end());
+            data.activationFunctions = std::vector<NeuronActivationFunction>(MAX_CHANNELS, NeuronActivationFunction_Sigmoid);
+            data.activityChannels = std::vector<float>(activityChannels.begin(), activityChannels.end());
+        }
+    }
+
+    void convertToFlatNeuronData(std::vector<float> const& weightsAndBiases, ActivityChannels const& activityChannels, std::vector<FlatNeuronData>& result)
+    {
+        for (auto& data : result) {
+            std::memcpy(data.neuron.weights.data(), weightsAndBiases.data(), sizeof(NeuronWeights));
+            std::memcpy(data.neuron.biases.data(), weightsAndBiases.data() + MAX_CHANNELS * MAX_CHANNELS, sizeof(NeuronBiases));
+            data.neuron.activationFunctions.fill(NeuronActivationFunction_Sigmoid);
+            data.activity.channels = activityChannels;
+        }
+    }
+
+    template <typename Func>
+    uint64_t countAllocations(Func const& func)
+    {
+        auto origNumAllocations = numAllocations.load();
+        func();
+        return numAllocations.load() - origNumAllocations;
+    }
+}
+
+TEST_F(DescriptionConverterTests, neuronDataAllocations)
+{
+    auto constexpr NumNeurons = 10;
+    auto weightsAndBiases = createWeightsAndBiases();
+    ActivityChannels activityChannels = {1.0f, 0.0f, -1.0f};
+
+    std::vector<NestedNeuronData> nestedData(NumNeurons);
+    convertToNestedNeuronData(weightsAndBiases, activityChannels, nestedData);
+    std::vector<FlatNeuronData> flatData(NumNeurons);
+    EXPECT_EQ(0, countAllocations([&] { convertToFlatNeuronData(weightsAndBiases, activityChannels, flatData); }));
+
+    //descriptions are copied e.g. when passed between the engine, the editors and the serializer
+    //the flat data only needs the allocation of the containing vector
+    std::vector<NestedNeuronData> nestedCopy;
+    EXPECT_EQ(1 + NumNeurons * (MAX_CHANNELS + 4), countAllocations([&] { nestedCopy = nestedData; }));
+    std::vector<FlatNeuronData> flatCopy;
+    EXPECT_EQ(1, countAllocations([&] { flatCopy = flatData; }));
+
+    for (int i = 0; i < NumNeurons; ++i) {
+        for (int row = 0; row < MAX_CHANNELS; ++row) {
+            for (int col = 0; col < MAX_CHANNELS; ++col) {
+                EXPECT_EQ(nestedCopy[i].weights[row][col], flatCopy[i].neuron.weights[row][col]);
+            }
+            EXPECT_EQ(nestedCopy[i].biases[row], flatCopy[i].neuron.biases[row]);
+        }
+    }
+}
+
+//compares the timings with the former nested neuron data, run with --gtest_also_run_disabled_tests
+TEST_F(DescriptionConverterTests, DISABLED_neuronDataBenchmark)
+{
+    auto constexpr NumNeurons = 100000;
+    auto weightsAndBiases = createWeightsAndBiases();
+    ActivityChannels activityChannels = {1.0f, 0.0f, -1.0f};
+
+    auto measure = [](auto const& func) {
+        auto startTime = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    };
+    std::vector<NestedNeuronData> nestedData(NumNeurons);
+    auto nestedConversionTime = measure([&] { convertToNestedNeuronData(weightsAndBiases, activityChannels, nestedData); });
+    std::vector<FlatNeuronData> flatData(NumNeurons);
+    auto flatConversionTime = measure([&] { convertToFlatNeuronData(weightsAndBiases, activityChannels, flatData); });
+
+    std::vector<NestedNeuronData> nestedCopy;
+    auto nestedCopyingTime = measure([&] { nestedCopy = nestedData; });
+    std::vector<FlatNeuronData> flatCopy;
+    auto flatCopyingTime = measure([&] { flatCopy = flatData; });
+
+    std::cout << "[          ] " << NumNeurons << " neurons" << std::endl;
+    std::cout << "[          ] conversion: " << nestedConversionTime << " ms (nested), " << flatConversionTime << " ms (flat)" << std::endl;
+    std::cout << "[          ] copying: " << nestedCopyingTime << " ms (nested), " << flatCopyingTime << " ms (flat)" << std::endl;
+}
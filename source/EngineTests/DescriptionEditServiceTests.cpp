@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/SpaceCalculator.h"
+
+class DescriptionEditServiceTests : public ::testing::Test
+{
+protected:
+    DataDescription createPattern() const
+    {
+        return DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(3).height(3).center({10.0f, 10.0f}));
+    }
+
+    //checks the distances between cells of different copies, cells of the same copy are identified by their creature id
+    bool areCopiesOverlapping(DataDescription const& data, IntVector2D const& worldSize, float distance) const
+    {
+        SpaceCalculator spaceCalculator(worldSize);
+        for (size_t i = 0; i < data.cells.size(); ++i) {
+            for (size_t j = i + 1; j < data.cells.size(); ++j) {
+                auto const& cell1 = data.cells.at(i);
+                auto const& cell2 = data.cells.at(j);
+                if (cell1.creatureId != cell2.creatureId && spaceCalculator.distance(cell1.pos, cell2.pos) < distance) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+TEST_F(DescriptionEditServiceTests, randomMultiplyWithoutOverlappingCheck)
+{
+    auto pattern = createPattern();
+    auto result = DescriptionEditService::randomMultiply(
+        pattern, DescriptionEditService::RandomMultiplyParameters().number(50).seed(1), {100, 100}, DataDescription());
+
+    EXPECT_EQ(50, result.numCopies);
+    EXPECT_EQ(1.0f, result.fillRate);
+    EXPECT_EQ(pattern.cells.size() * 51, result.data.cells.size());
+}
+
+TEST_F(DescriptionEditServiceTests, randomMultiplyWithOverlappingCheck)
+{
+    IntVector2D worldSize{200, 200};
+    auto pattern = createPattern();
+    auto result = DescriptionEditService::randomMultiply(
+        pattern, DescriptionEditService::RandomMultiplyParameters().number(300).overlappingCheck(true).seed(1), worldSize, pattern);
+
+    EXPECT_EQ(300, result.numCopies);
+    EXPECT_EQ(1.0f, result.fillRate);
+    EXPECT_EQ(pattern.cells.size() * 301, result.data.cells.size());
+
+    //the original pattern is part of the existent data
+    result.data.cells.erase(result.data.cells.begin(), result.data.cells.begin() + pattern.cells.size());
+    EXPECT_FALSE(areCopiesOverlapping(result.data, worldSize, 2.0f));
+}
+
+TEST_F(DescriptionEditServiceTests, randomMultiplyReportsFillRate)
+{
+    IntVector2D worldSize{20, 20};
+    auto pattern = createPattern();
+    auto result = DescriptionEditService::randomMultiply(
+        pattern, DescriptionEditService::RandomMultiplyParameters().number(100).overlappingCheck(true).seed(1), worldSize, DataDescription());
+
+    EXPECT_LT(0, result.numCopies);
+    EXPECT_GT(100, result.numCopies);
+    EXPECT_FLOAT_EQ(static_cast<float>(result.numCopies) / 100, result.fillRate);
+    EXPECT_EQ(pattern.cells.size() * (result.numCopies + 1), result.data.cells.size());
+}
+
+TEST_F(DescriptionEditServiceTests, randomMultiplyIsDeterministic)
+{
+    auto pattern = createPattern();
+    auto parameters = DescriptionEditService::RandomMultiplyParameters().number(200).overlappingCheck(true).seed(7);
+    auto result1 = DescriptionEditService::randomMultiply(pattern, parameters, {150, 150}, DataDescription());
+    auto result2 = DescriptionEditService::randomMultiply(pattern, parameters, {150, 150}, DataDescription());
+
+    ASSERT_EQ(result1.data.cells.size(), result2.data.cells.size());
+    for (size_t i = 0; i < result1.data.cells.size(); ++i) {
+        EXPECT_EQ(result1.data.cells.at(i).pos, result2.data.cells.at(i).pos);
+    }
+}
@@ -1,14 +1,32 @@
 #include "IntegrationTestFramework.h"
 
+#include <cstdlib>
+#include <string>
+
 #include <boost/range/combine.hpp>
 
 #include "Base/Math.h"
 #include "EngineInterface/SimulationParameters.h"
+#include "EngineCpu/SimulationFacadeCpu.h"
 #include "EngineImpl/SimulationFacadeImpl.h"
 
+namespace
+{
+    //the engine tests run against the CPU engine if the environment variable ALIEN_ENGINE is set to "cpu"
+    bool isCpuEngineSelected()
+    {
+        auto engine = std::getenv("ALIEN_ENGINE");
+        return engine && std::string(engine) == "cpu";
+    }
+}
+
 IntegrationTestFramework::IntegrationTestFramework(std::optional<SimulationParameters> const& parameters_, IntVector2D const& universeSize)
 {
-    _simulationFacade = std::make_shared<_SimulationFacadeImpl>();
+    if (isCpuEngineSelected()) {
+        _simulationFacade = std::make_shared<_SimulationFacadeCpu>();
+    } else {
+        _simulationFacade = std::make_shared<_SimulationFacadeImpl>();
+    }
     GeneralSettings generalSettings{universeSize.x, universeSize.y};
     SimulationParameters parameters;
     if (parameters_) {
@@ -132,6 +150,11 @@ bool IntegrationTestFramework::approxCompare(std::vector<float> const& expected,
     return true;
 }
 
+bool IntegrationTestFramework::approxCompare(std::vector<float> const& expected, ActivityChannels const& actual) const
+{
+    return approxCompare(expected, std::vector<float>(actual.begin(), actual.end()));
+}
+
 bool IntegrationTestFramework::compare(DataDescription left, DataDescription right) const
 {
     std::sort(left.cells.begin(), left.cells.end(), [](auto const& left, auto const& right) { return left.id < right.id; });
@@ -27,6 +27,7 @@ protected:
     bool approxCompare(float expected, float actual, float precision = 0.001f) const;
     bool approxCompare(RealVector2D const& expected, RealVector2D const& actual) const;
     bool approxCompare(std::vector<float> const& expected, std::vector<float> const& actual) const;
+    bool approxCompare(std::vector<float> const& expected, ActivityChannels const& actual) const;
 
     bool compare(DataDescription left, DataDescription right) const;
     bool compare(CellDescription left, CellDescription right) const;
@@ -0,0 +1,68 @@
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/MetricsService.h"
+
+class MetricsServiceTests : public ::testing::Test
+{
+protected:
+    void SetUp() override { MetricsService::get().reset(); }
+    void TearDown() override
+    {
+        MetricsService::get().setEnabled(false);
+        MetricsService::get().reset();
+    }
+
+    bool contains(std::string const& text, std::string const& pattern) const { return text.find(pattern) != std::string::npos; }
+};
+
+TEST_F(MetricsServiceTests, disabled)
+{
+    MetricsService::get().setEnabled(false);
+    MetricsService::incrementCounter("test.counter");
+    {
+        MEASURE_SCOPE("test.timer");
+    }
+
+    auto dump = MetricsService::get().getMetricsDump();
+    EXPECT_FALSE(contains(dump, "test.counter"));
+    EXPECT_FALSE(contains(dump, "test.timer"));
+}
+
+TEST_F(MetricsServiceTests, countersAndTimersFromSeveralThreads)
+{
+    auto constexpr NumThreads = 4;
+    auto constexpr NumIterations = 1000;
+
+    MetricsService::get().setEnabled(true);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NumThreads; ++i) {
+        threads.emplace_back([] {
+            MetricsService::setThreadName("test thread");
+            for (int j = 0; j < NumIterations; ++j) {
+                MEASURE_SCOPE("test.timer");
+                MetricsService::incrementCounter("test.counter");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    MetricsService::setGauge("test.gauge", 42.0);
+    MetricsService::get().setEnabled(false);
+
+    auto dump = MetricsService::get().getMetricsDump();
+    EXPECT_TRUE(contains(dump, "test.counter " + std::to_string(NumThreads * NumIterations)));
+    EXPECT_TRUE(contains(dump, "test.timer " + std::to_string(NumThreads * NumIterations) + " "));
+    EXPECT_TRUE(contains(dump, "test.gauge 42.000"));
+    EXPECT_TRUE(contains(dump, "dropped events: 0"));
+    EXPECT_EQ(NumThreads * NumIterations, MetricsService::get().getCounter("test.counter"));
+    EXPECT_EQ(0, MetricsService::get().getCounter("test.unknown"));
+
+    auto trace = MetricsService::get().getChromeTraceJson();
+    EXPECT_TRUE(contains(trace, "\"traceEvents\""));
+    EXPECT_TRUE(contains(trace, "\"name\":\"test.timer\""));
+    EXPECT_TRUE(contains(trace, "\"name\":\"test thread\""));
+}
@@ -0,0 +1,90 @@
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/NumberGenerator.h"
+
+class NumberGeneratorTests : public ::testing::Test
+{
+protected:
+    void SetUp() override { _origSeed = NumberGenerator::get().getSeed(); }
+    void TearDown() override { NumberGenerator::get().setSeed(_origSeed); }
+
+    std::vector<uint32_t> getRandomInts(int number) const
+    {
+        std::vector<uint32_t> result;
+        for (int i = 0; i < number; ++i) {
+            result.emplace_back(NumberGenerator::get().getRandomInt());
+        }
+        return result;
+    }
+
+    std::vector<uint32_t> getRandomInts(RandomStream stream, int number) const
+    {
+        std::vector<uint32_t> result;
+        for (int i = 0; i < number; ++i) {
+            result.emplace_back(stream.getRandomInt());
+        }
+        return result;
+    }
+
+    uint64_t _origSeed = 0;
+};
+
+TEST_F(NumberGeneratorTests, sameSeedGivesSameSequence)
+{
+    auto& numberGenerator = NumberGenerator::get();
+    numberGenerator.setSeed(42);
+    EXPECT_EQ(42, numberGenerator.getSeed());
+    auto sequence1 = getRandomInts(1000);
+
+    numberGenerator.setSeed(42);
+    auto sequence2 = getRandomInts(1000);
+
+    numberGenerator.setSeed(43);
+    auto sequence3 = getRandomInts(1000);
+
+    EXPECT_EQ(sequence1, sequence2);
+    EXPECT_NE(sequence1, sequence3);
+}
+
+TEST_F(NumberGeneratorTests, createStreamIsIndependentOfThread)
+{
+    auto constexpr NumThreads = 4;
+    auto constexpr NumStreams = 16;
+
+    auto& numberGenerator = NumberGenerator::get();
+    numberGenerator.setSeed(7);
+    std::vector<std::vector<uint32_t>> expectedSequences;
+    for (int i = 0; i < NumStreams; ++i) {
+        expectedSequences.emplace_back(getRandomInts(numberGenerator.createStream(i), 100));
+    }
+    EXPECT_NE(expectedSequences[0], expectedSequences[1]);
+
+    //the streams are created in reverse order and distributed over several threads
+    std::vector<std::vector<uint32_t>> sequences(NumStreams);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NumThreads; ++i) {
+        threads.emplace_back([&, i] {
+            for (int streamId = NumStreams - 1 - i; streamId >= 0; streamId -= NumThreads) {
+                sequences[streamId] = getRandomInts(numberGenerator.createStream(streamId), 100);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(expectedSequences, sequences);
+}
+
+TEST_F(NumberGeneratorTests, createStreamIsUnaffectedByThreadStreams)
+{
+    auto& numberGenerator = NumberGenerator::get();
+    numberGenerator.setSeed(7);
+    auto expectedSequence = getRandomInts(numberGenerator.createStream(3), 100);
+
+    numberGenerator.setSeed(7);
+    getRandomInts(1000);
+    EXPECT_EQ(expectedSequence, getRandomInts(numberGenerator.createStream(3), 100));
+}
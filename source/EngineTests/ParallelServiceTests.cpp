@@ -0,0 +1,72 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/ParallelService.h"
+
+class ParallelServiceTests : public ::testing::Test
+{
+protected:
+    uint64_t calcSum(uint64_t numTasks) const
+    {
+        std::atomic<uint64_t> result{0};
+        ParallelService::forEach(numTasks, [&](uint64_t index) { result += index; });
+        return result.load();
+    }
+};
+
+TEST_F(ParallelServiceTests, forEachFromSeveralThreads)
+{
+    auto constexpr NumThreads = 4;
+    auto constexpr NumTasks = 1000;
+
+    std::vector<std::thread> threads;
+    std::vector<uint64_t> sums(NumThreads, 0);
+    for (int i = 0; i < NumThreads; ++i) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < 100; ++j) {
+                sums[i] += calcSum(NumTasks);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto const& sum : sums) {
+        EXPECT_EQ(100 * NumTasks * (NumTasks - 1) / 2, sum);
+    }
+}
+
+TEST_F(ParallelServiceTests, forEachRethrowsException)
+{
+    EXPECT_THROW(
+        ParallelService::forEach(
+            100,
+            [](uint64_t index) {
+                if (index == 42) {
+                    throw std::runtime_error("test");
+                }
+            }),
+        std::runtime_error);
+    EXPECT_EQ(4950, calcSum(100));
+}
+
+TEST_F(ParallelServiceTests, async)
+{
+    std::vector<std::future<uint64_t>> results;
+    for (uint64_t i = 0; i < 100; ++i) {
+        results.emplace_back(ParallelService::async([this, i] { return calcSum(i); }));
+    }
+    for (uint64_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(i * (i - 1) / 2, results[i].get());
+    }
+
+    auto failingResult = ParallelService::async([] {
+        throw std::runtime_error("test");
+        return 0;
+    });
+    EXPECT_THROW(failingResult.get(), std::runtime_error);
+}
@@ -0,0 +1,481 @@
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <gtest/gtest.h>
+
+#include "Base/NumberGenerator.h"
+#include "EngineImpl/DataTOFileService.h"
+#include "EngineInterface/AuxiliaryDataParserService.h"
+#include "EngineInterface/BlockCompressionService.h"
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineInterface/SerializerService.h"
+#include "EngineInterface/SimulationFacade.h"
+#include "IntegrationTestFramework.h"
+
+class SerializerTests : public IntegrationTestFramework
+{
+public:
+    SerializerTests()
+        : IntegrationTestFramework()
+    {}
+
+    ~SerializerTests() = default;
+
+protected:
+    ClusteredDataDescription serializeAndDeserialize(ClusteredDataDescription const& data) const
+    {
+        DeserializedSimulation input;
+        input.mainData = data;
+
+        SerializedSimulation serializedSimulation;
+        EXPECT_TRUE(SerializerService::serializeSimulationToStrings(serializedSimulation, input));
+
+        DeserializedSimulation output;
+        EXPECT_TRUE(SerializerService::deserializeSimulationFromStrings(output, serializedSimulation));
+        return output.mainData;
+    }
+
+    AuxiliaryData createAuxiliaryDataWithSpotsAndSources() const
+    {
+        AuxiliaryData result;
+        result.timestep = 1234;
+        result.realTime = std::chrono::milliseconds(5678);
+        result.zoom = 2.5f;
+        result.center = {100.5f, 200.25f};
+        result.generalSettings.worldSizeX = 1000;
+        result.generalSettings.worldSizeY = 500;
+
+        auto& parameters = result.simulationParameters;
+        parameters.cellGlowRadius = 1.0f / 3;
+        parameters.baseValues.radiationAbsorption[3] = 0.123456789f;
+        parameters.numRadiationSources = 2;
+        parameters.radiationSources[0].posX = 10.0f;
+        parameters.radiationSources[1].shapeType = RadiationSourceShapeType_Rectangular;
+        parameters.radiationSources[1].shapeData.rectangularRadiationSource.width = 50.0f;
+        parameters.numSpots = 2;
+        parameters.spots[0].color = 0xff00ff;
+        parameters.spots[0].flowType = FlowType_Radial;
+        parameters.spots[0].values.friction = 0.5f;
+        parameters.spots[0].activatedValues.friction = true;
+        parameters.spots[0].values.cellFunctionAttackerFoodChainColorMatrix[2][5] = 0.25f;
+        parameters.spots[0].activatedValues.cellFunctionAttackerFoodChainColorMatrix = true;
+        parameters.spots[1].shapeType = SpotShapeType_Rectangular;
+        parameters.spots[1].shapeData.rectangularSpot.width = 300.0f;
+        parameters.spots[1].values.cellMinEnergy[1] = 12.0f;
+        parameters.spots[1].activatedValues.cellMinEnergy = true;
+        return result;
+    }
+
+    std::string encodeViaPropertyTree(AuxiliaryData const& data) const
+    {
+        std::stringstream stream;
+        boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::encodeAuxiliaryData(data));
+        return stream.str();
+    }
+
+    AuxiliaryData decodeViaPropertyTree(std::string const& json) const
+    {
+        std::stringstream stream(json);
+        boost::property_tree::ptree tree;
+        boost::property_tree::read_json(stream, tree);
+        return AuxiliaryDataParserService::decodeAuxiliaryData(tree);
+    }
+
+    void checkEquality(AuxiliaryData const& expected, AuxiliaryData const& actual) const
+    {
+        EXPECT_EQ(expected.timestep, actual.timestep);
+        EXPECT_EQ(expected.realTime, actual.realTime);
+        EXPECT_EQ(expected.zoom, actual.zoom);
+        EXPECT_EQ(expected.center, actual.center);
+        EXPECT_EQ(expected.generalSettings.worldSizeX, actual.generalSettings.worldSizeX);
+        EXPECT_EQ(expected.generalSettings.worldSizeY, actual.generalSettings.worldSizeY);
+        EXPECT_TRUE(expected.simulationParameters == actual.simulationParameters);
+    }
+};
+
+TEST_F(SerializerTests, cellFunctions)
+{
+    NeuronDescription neuron;
+    neuron.weights[2][1] = 1.0f;
+    neuron.biases[3] = -0.5f;
+
+    auto data = DataDescription().addCells({
+        CellDescription().setId(1).setPos({1.0f, 1.0f}).setCellFunction(neuron).setInputExecutionOrderNumber(2),
+        CellDescription().setId(2).setPos({2.0f, 1.0f}).setCellFunction(TransmitterDescription()),
+        CellDescription().setId(3).setPos({3.0f, 1.0f}).setCellFunction(ConstructorDescription().setGenomeGeneration(2)),
+        CellDescription().setId(4).setPos({4.0f, 1.0f}).setCellFunction(SensorDescription().setFixedAngle(45.0f).setMinRange(3)),
+        CellDescription().setId(5).setPos({5.0f, 1.0f}).setCellFunction(NerveDescription().setPulseMode(2)),
+        CellDescription().setId(6).setPos({6.0f, 1.0f}).setCellFunction(AttackerDescription()),
+        CellDescription().setId(7).setPos({7.0f, 1.0f}).setCellFunction(InjectorDescription()),
+        CellDescription().setId(8).setPos({8.0f, 1.0f}).setCellFunction(MuscleDescription()),
+        CellDescription().setId(9).setPos({9.0f, 1.0f}).setCellFunction(DefenderDescription()),
+        CellDescription().setId(10).setPos({10.0f, 1.0f}).setCellFunction(ReconnectorDescription().setRestrictToColor(2)),
+        CellDescription().setId(11).setPos({11.0f, 1.0f}).setCellFunction(DetonatorDescription().setCountDown(5)),
+        CellDescription().setId(12).setPos({12.0f, 1.0f}).setMetadata(CellMetadataDescription().setName("name").setDescription("description")),
+    });
+    for (uint64_t id = 1; id < 12; ++id) {
+        data.addConnection(id, id + 1);
+    }
+    data.addParticle(ParticleDescription().setId(13).setPos({1.0f, 5.0f}).setEnergy(10.0f).setColor(3));
+
+    _simulationFacade->setSimulationData(data);
+    auto clusteredData = _simulationFacade->getClusteredSimulationData();
+
+    auto actualData = serializeAndDeserialize(clusteredData);
+
+    EXPECT_EQ(clusteredData, actualData);
+}
+
+TEST_F(SerializerTests, largeData)
+{
+    auto data = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(300).height(300).center({500.0f, 500.0f}));
+
+    _simulationFacade->setSimulationData(data);
+    auto clusteredData = _simulationFacade->getClusteredSimulationData();
+
+    auto actualData = serializeAndDeserialize(clusteredData);
+
+    EXPECT_EQ(clusteredData, actualData);
+}
+
+TEST_F(SerializerTests, identicalGenomes)
+{
+    auto genome1 = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+    auto genome2 = GenomeDescriptionService::convertDescriptionToBytes(
+        GenomeDescription().setCells({CellGenomeDescription(), CellGenomeDescription().setCellFunction(NerveGenomeDescription())}));
+
+    DataDescription data;
+    for (int i = 0; i < 20; ++i) {
+        auto const& genome = i % 3 == 0 ? genome2 : genome1;
+        auto pos = RealVector2D{toFloat(i) * 5.0f + 5.0f, 10.0f};
+        if (i % 2 == 0) {
+            data.addCell(CellDescription().setId(i + 1).setPos(pos).setCellFunction(ConstructorDescription().setGenome(genome)));
+        } else {
+            data.addCell(CellDescription().setId(i + 1).setPos(pos).setCellFunction(InjectorDescription().setGenome(genome)));
+        }
+    }
+
+    _simulationFacade->setSimulationData(data);
+    auto clusteredData = _simulationFacade->getClusteredSimulationData();
+
+    auto actualData = serializeAndDeserialize(clusteredData);
+
+    EXPECT_EQ(clusteredData, actualData);
+}
+
+TEST_F(SerializerTests, genomeOfOlderEncodingVersion)
+{
+    auto subgenome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+    auto genome = GenomeDescription().setCells(
+        {CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(subgenome)), CellGenomeDescription().setColor(2)});
+
+    auto oldSpec = GenomeEncodingSpecification().numRepetitions(false).concatenationAngle1(false).concatenationAngle2(false);
+    auto oldSubgenome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}), oldSpec);
+    auto oldGenome = GenomeDescriptionService::convertDescriptionToBytes(
+        GenomeDescription().setCells(
+            {CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(oldSubgenome)), CellGenomeDescription().setColor(2)}),
+        oldSpec);
+
+    EXPECT_EQ(GenomeDescriptionService::convertDescriptionToBytes(genome), GenomeDescriptionService::convertToCurrentEncoding(oldGenome, 1));
+    EXPECT_THROW(GenomeDescriptionService::convertToCurrentEncoding(oldGenome, GenomeDescriptionService::EncodingVersion + 1), std::runtime_error);
+}
+
+TEST_F(SerializerTests, compressionSettings)
+{
+    auto data = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(100).height(100).center({500.0f, 500.0f}));
+
+    _simulationFacade->setSimulationData(data);
+    auto clusteredData = _simulationFacade->getClusteredSimulationData();
+
+    DeserializedSimulation input;
+    input.mainData = clusteredData;
+    for (auto const& compressionSettings :
+         {CompressionSettings().codec(CompressionCodec_None), CompressionSettings().codec(CompressionCodec_Zlib).level(1).blockSize(4096)}) {
+        SerializedSimulation serializedSimulation;
+        EXPECT_TRUE(SerializerService::serializeSimulationToStrings(serializedSimulation, input, compressionSettings));
+
+        DeserializedSimulation output;
+        EXPECT_TRUE(SerializerService::deserializeSimulationFromStrings(output, serializedSimulation));
+        EXPECT_EQ(clusteredData, output.mainData);
+    }
+}
+
+TEST_F(SerializerTests, blockContainerOfFormatVersion1)
+{
+    //layout of version 1: marker, version, codec, total size, number of blocks, block index, blocks
+    std::string data = "block container with a leading index";
+    std::vector<uint64_t> blockSizes = {10, 10, data.size() - 20};
+
+    std::ostringstream oldContainer;
+    auto writeValue = [&](auto value) { oldContainer.write(reinterpret_cast<char const*>(&value), sizeof(value)); };
+    oldContainer.write("ALIENBLK", 8);
+    writeValue(uint32_t(1));
+    writeValue(uint32_t(CompressionCodec_None));
+    writeValue(uint64_t(data.size()));
+    writeValue(uint64_t(blockSizes.size()));
+    for (auto const& blockSize : blockSizes) {
+        writeValue(blockSize);
+        writeValue(blockSize);
+    }
+    oldContainer << data;
+
+    std::istringstream stream(oldContainer.str());
+    std::string actualData;
+    BlockCompressionService::decompress(actualData, stream);
+    EXPECT_EQ(data, actualData);
+
+    std::istringstream truncatedStream(oldContainer.str().substr(0, oldContainer.str().size() - 1));
+    EXPECT_THROW(BlockCompressionService::decompress(actualData, truncatedStream), std::runtime_error);
+
+    auto newerContainer = oldContainer.str();
+    uint32_t newerVersion = 3;
+    std::memcpy(newerContainer.data() + 8, &newerVersion, sizeof(newerVersion));
+    std::istringstream newerStream(newerContainer);
+    EXPECT_THROW(BlockCompressionService::decompress(actualData, newerStream), std::runtime_error);
+}
+
+TEST_F(SerializerTests, chunkedSave)
+{
+    DataDescription data;
+    for (int x = 0; x < 30; ++x) {
+        for (int y = 0; y < 30; ++y) {
+            data.add(DescriptionEditService::createRect(
+                DescriptionEditService::CreateRectParameters().width(15).height(15).center({toFloat(x) * 30.0f + 15.0f, toFloat(y) * 30.0f + 15.0f})));
+        }
+    }
+    data.addParticle(ParticleDescription().setId(1).setPos({10.0f, 10.0f}).setEnergy(10.0f));
+
+    _simulationFacade->setSimulationData(data);
+    auto clusteredData = _simulationFacade->getClusteredSimulationData();
+
+    auto filename = (std::filesystem::temp_directory_path() / "alien_chunked_save_test.sim").string();
+    DeserializedSimulation input;
+    EXPECT_TRUE(SerializerService::serializeSimulationToFiles(filename, input, _simulationFacade->getClusteredSimulationDataReader()));
+
+    DeserializedSimulation output;
+    EXPECT_TRUE(SerializerService::deserializeSimulationFromFiles(output, filename));
+    EXPECT_EQ(clusteredData, output.mainData);
+}
+
+TEST_F(SerializerTests, headerAndRegion)
+{
+    DataDescription data;
+    for (int x = 0; x < 10; ++x) {
+        for (int y = 0; y < 10; ++y) {
+            data.add(DescriptionEditService::createRect(
+                DescriptionEditService::CreateRectParameters().width(5).height(5).center({toFloat(x) * 100.0f + 50.0f, toFloat(y) * 100.0f + 50.0f})));
+            data.addParticle(ParticleDescription().setId(NumberGenerator::get().getId()).setPos({toFloat(x) * 100.0f + 20.0f, toFloat(y) * 100.0f + 20.0f}));
+        }
+    }
+    _simulationFacade->setSimulationData(data);
+    auto clusteredData = _simulationFacade->getClusteredSimulationData();
+
+    auto filename = (std::filesystem::temp_directory_path() / "alien_region_test.sim").string();
+    DeserializedSimulation input;
+    input.mainData = clusteredData;
+    input.auxiliaryData.timestep = 42;
+    input.auxiliaryData.realTime = std::chrono::milliseconds(0);
+    input.auxiliaryData.generalSettings = _simulationFacade->getGeneralSettings();
+    EXPECT_TRUE(SerializerService::serializeSimulationToFiles(filename, input));
+
+    SimulationFileHeader header;
+    ASSERT_TRUE(SerializerService::deserializeSimulationHeaderFromFile(header, filename));
+    EXPECT_EQ((IntVector2D{1000, 1000}), header.worldSize);
+    EXPECT_EQ(42, header.timestep);
+    EXPECT_EQ(100, header.getNumClusters());
+    EXPECT_EQ(2500, header.getNumCells());
+    EXPECT_EQ(100, header.getNumParticles());
+
+    DeserializedSimulation output;
+    ASSERT_TRUE(SerializerService::deserializeSimulationRegionFromFiles(output, filename, {200.0f, 200.0f}, {400.0f, 400.0f}));
+    EXPECT_EQ(4, output.mainData.clusters.size());
+    EXPECT_EQ(4, output.mainData.particles.size());
+    for (auto const& cluster : output.mainData.clusters) {
+        EXPECT_EQ(25, cluster.cells.size());
+        for (auto const& cell : cluster.cells) {
+            EXPECT_TRUE(cell.pos.x > 200.0f && cell.pos.x < 400.0f && cell.pos.y > 200.0f && cell.pos.y < 400.0f);
+        }
+    }
+    for (auto const& particle : output.mainData.particles) {
+        EXPECT_TRUE(particle.pos.x > 200.0f && particle.pos.x < 400.0f && particle.pos.y > 200.0f && particle.pos.y < 400.0f);
+    }
+    EXPECT_EQ(42, output.auxiliaryData.timestep);
+
+    DeserializedSimulation completeOutput;
+    EXPECT_TRUE(SerializerService::deserializeSimulationFromFiles(completeOutput, filename));
+    EXPECT_EQ(clusteredData.clusters.size(), completeOutput.mainData.clusters.size());
+    EXPECT_EQ(clusteredData.particles.size(), completeOutput.mainData.particles.size());
+}
+
+TEST_F(SerializerTests, snapshotFileViaRegularLoadPath)
+{
+    auto filename = (std::filesystem::temp_directory_path() / "alien_snapshot_test.sim").string();
+    DataTO dataTO;
+    dataTO.init({1, 1, 1});
+    DataTOFileService::writeToFile(filename, dataTO);
+    dataTO.destroy();
+
+    DeserializedSimulation input;
+    input.auxiliaryData.timestep = 42;
+    EXPECT_TRUE(SerializerService::serializeSimulationWithoutMainDataToFiles(filename, input));
+
+    DeserializedSimulation output;
+    EXPECT_TRUE(SerializerService::deserializeSimulationFromFiles(output, filename));
+    ASSERT_TRUE(output.snapshotFilename.has_value());
+    EXPECT_EQ(filename, *output.snapshotFilename);
+    EXPECT_TRUE(output.mainData.isEmpty());
+    EXPECT_EQ(42, output.auxiliaryData.timestep);
+}
+
+TEST_F(SerializerTests, statisticsAppendedOnSave)
+{
+    auto createStatistics = [](int numRows, double timeFactor) {
+        StatisticsHistoryData result;
+        for (int i = 0; i < numRows; ++i) {
+            DataPointCollection dataPoints;
+            dataPoints.time = toDouble(i) * timeFactor;
+            dataPoints.numCells.values[2] = toDouble(i * 10);
+            dataPoints.numCells.summedValues = toDouble(i * 10);
+            dataPoints.varianceGenomeComplexity.summedValues = 0.5;
+            result.emplace_back(dataPoints);
+        }
+        return result;
+    };
+    auto checkStatistics = [](StatisticsHistorySnapshot const& expected, StatisticsHistorySnapshot const& actual) {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(expected[i].time, actual[i].time);
+            EXPECT_EQ(expected[i].numCells.values[2], actual[i].numCells.values[2]);
+            EXPECT_EQ(expected[i].numCells.summedValues, actual[i].numCells.summedValues);
+            EXPECT_EQ(expected[i].varianceGenomeComplexity.summedValues, actual[i].varianceGenomeComplexity.summedValues);
+        }
+    };
+
+    auto filename = (std::filesystem::temp_directory_path() / "alien_statistics_test.sim").string();
+    std::filesystem::remove(std::filesystem::path(filename).replace_extension(".statistics.bin"));
+
+    //first save, then a save of an extended history (appended) and of a different history (rewritten)
+    for (auto const& [numRows, timeFactor] : std::vector<std::pair<int, double>>{{100, 1.0}, {150, 1.0}, {80, 2.0}}) {
+        DeserializedSimulation input;
+        input.auxiliaryData.realTime = std::chrono::milliseconds(0);
+        input.statistics = createStatistics(numRows, timeFactor);
+        EXPECT_TRUE(SerializerService::serializeSimulationWithoutMainDataToFiles(filename, input));
+
+        DeserializedSimulation output;
+        EXPECT_TRUE(SerializerService::deserializeSimulationWithoutMainDataFromFiles(output, filename));
+        checkStatistics(input.statistics, output.statistics);
+    }
+}
+
+TEST_F(SerializerTests, settingsJsonCompatibility)
+{
+    auto data = createAuxiliaryDataWithSpotsAndSources();
+
+    auto json = AuxiliaryDataParserService::encodeAuxiliaryDataToJson(data);
+    EXPECT_EQ(encodeViaPropertyTree(data), json);
+
+    auto parameterJson = AuxiliaryDataParserService::encodeSimulationParametersToJson(data.simulationParameters);
+    std::stringstream parameterStream;
+    boost::property_tree::json_parser::write_json(parameterStream, AuxiliaryDataParserService::encodeSimulationParameters(data.simulationParameters));
+    EXPECT_EQ(parameterStream.str(), parameterJson);
+
+    auto decodedData = AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json);
+    checkEquality(decodeViaPropertyTree(json), decodedData);
+    EXPECT_EQ(json, AuxiliaryDataParserService::encodeAuxiliaryDataToJson(decodedData));
+    EXPECT_TRUE(data.simulationParameters == AuxiliaryDataParserService::decodeSimulationParametersFromJson(parameterJson));
+}
+
+TEST_F(SerializerTests, settingsJsonDecodingOfModifiedFiles)
+{
+    auto data = createAuxiliaryDataWithSpotsAndSources();
+    auto json = encodeViaPropertyTree(data);
+
+    //values missing or not convertible are replaced by defaults as with the property tree
+    for (auto const& [from, to] : std::vector<std::pair<std::string, std::string>>{
+             {"\"zoom\": \"2.50000000\"", "\"zoom\": 3"},
+             {"\"x\": \"1000\"", "\"x\": \"1000.5\""},
+             {"\"real time\": \"5678\",", ""},
+             {"\"friction\": {", "\"friction\": { \"unknown\": [1, 2, {\"a\": null}], "},
+         }) {
+        auto modifiedJson = json;
+        auto pos = modifiedJson.find(from);
+        ASSERT_NE(std::string::npos, pos);
+        modifiedJson.replace(pos, from.size(), to);
+        checkEquality(decodeViaPropertyTree(modifiedJson), AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(modifiedJson));
+    }
+    EXPECT_THROW(AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json.substr(0, json.size() / 2)), std::runtime_error);
+}
+
+TEST_F(SerializerTests, settingsJsonWithAllSpotsAndSources)
+{
+    auto data = createAuxiliaryDataWithSpotsAndSources();
+    data.simulationParameters.numSpots = MAX_SPOTS;
+    data.simulationParameters.numRadiationSources = MAX_RADIATION_SOURCES;
+
+    auto json = AuxiliaryDataParserService::encodeAuxiliaryDataToJson(data);
+    EXPECT_EQ(encodeViaPropertyTree(data), json);
+
+    auto decodedData = AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json);
+    checkEquality(decodeViaPropertyTree(json), decodedData);
+    EXPECT_EQ(json, AuxiliaryDataParserService::encodeAuxiliaryDataToJson(decodedData));
+}
+
+//compares the timings with the property tree, run with --gtest_also_run_disabled_tests
+TEST_F(SerializerTests, DISABLED_settingsJsonBenchmark)
+{
+    auto data = createAuxiliaryDataWithSpotsAndSources();
+    data.simulationParameters.numSpots = MAX_SPOTS;
+    data.simulationParameters.numRadiationSources = MAX_RADIATION_SOURCES;
+    auto json = AuxiliaryDataParserService::encodeAuxiliaryDataToJson(data);
+
+    auto measure = [](auto const& func) {
+        auto constexpr NumIterations = 20;
+        auto startTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < NumIterations; ++i) {
+            func();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count() / NumIterations;
+    };
+    auto propertyTreeEncodeTime = measure([&] { encodeViaPropertyTree(data); });
+    auto propertyTreeDecodeTime = measure([&] { decodeViaPropertyTree(json); });
+    auto encodeTime = measure([&] { AuxiliaryDataParserService::encodeAuxiliaryDataToJson(data); });
+    auto decodeTime = measure([&] { AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json); });
+
+    std::cout << "[          ] settings with " << json.size() << " bytes" << std::endl;
+    std::cout << "[          ] encoding: " << propertyTreeEncodeTime << " ms (property tree), " << encodeTime << " ms (settings codec)" << std::endl;
+    std::cout << "[          ] decoding: " << propertyTreeDecodeTime << " ms (property tree), " << decodeTime << " ms (settings codec)" << std::endl;
+}
+
+TEST_F(SerializerTests, rotateSimulationFiles)
+{
+    auto directory = std::filesystem::temp_directory_path() / "alien_rotation_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    auto filename = (directory / "autosave.sim").string();
+
+    auto constexpr NumSlots = 3;
+    for (uint64_t timestep = 1; timestep <= 4; ++timestep) {
+        SerializerService::rotateSimulationFiles(filename, NumSlots);
+
+        DeserializedSimulation input;
+        input.auxiliaryData.timestep = timestep;
+        input.auxiliaryData.realTime = std::chrono::milliseconds(0);
+        EXPECT_TRUE(SerializerService::serializeSimulationToFiles(filename, input));
+        EXPECT_LT(0, SerializerService::getSimulationFilesSize(filename));
+    }
+
+    for (auto const& [slotFilename, expectedTimestep] :
+         std::vector<std::pair<std::filesystem::path, uint64_t>>{{"autosave.sim", 4}, {"autosave.1.sim", 3}, {"autosave.2.sim", 2}}) {
+        DeserializedSimulation output;
+        EXPECT_TRUE(SerializerService::deserializeSimulationFromFiles(output, (directory / slotFilename).string()));
+        EXPECT_EQ(expectedTimestep, output.auxiliaryData.timestep);
+    }
+    EXPECT_FALSE(std::filesystem::exists(directory / "autosave.3.sim"));
+    EXPECT_FALSE(std::filesystem::exists(directory / "autosave.3.settings.json"));
+}
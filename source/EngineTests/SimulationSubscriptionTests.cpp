@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationFacade.h"
+#include "EngineInterface/SimulationSubscription.h"
+
+#include "IntegrationTestFramework.h"
+
+class SimulationSubscriptionTests : public IntegrationTestFramework
+{
+public:
+    SimulationSubscriptionTests()
+        : IntegrationTestFramework(std::nullopt, {100, 100})
+    {}
+
+    ~SimulationSubscriptionTests() = default;
+
+protected:
+    void setSimpleData()
+    {
+        DataDescription data;
+        data.addCells({
+            CellDescription().setId(1).setPos({10.0f, 10.0f}).setMaxConnections(2),
+            CellDescription().setId(2).setPos({11.0f, 10.0f}).setMaxConnections(2),
+        });
+        data.addConnection(1, 2);
+        data.addParticle(ParticleDescription().setId(3).setPos({50.0f, 50.0f}).setEnergy(10.0f));
+        _simulationFacade->setSimulationData(data);
+    }
+};
+
+TEST_F(SimulationSubscriptionTests, versionsUnchangedByReadAccesses)
+{
+    setSimpleData();
+
+    auto versions = _simulationFacade->getVersions();
+    _simulationFacade->getSimulationData();
+    _simulationFacade->getSelectionShallowData();
+    _simulationFacade->getInspectedSimulationData({1, 3});
+    _simulationFacade->getSimulationParameters();
+
+    EXPECT_EQ(versions, _simulationFacade->getVersions());
+}
+
+TEST_F(SimulationSubscriptionTests, versionsIncreasedByTimesteps)
+{
+    setSimpleData();
+
+    auto versions = _simulationFacade->getVersions();
+    _simulationFacade->calcTimesteps(1);
+    auto newVersions = _simulationFacade->getVersions();
+
+    EXPECT_GT(newVersions.entities, versions.entities);
+    EXPECT_EQ(newVersions.parameters, versions.parameters);
+}
+
+TEST_F(SimulationSubscriptionTests, pollSimulationParameters)
+{
+    SimulationSubscription subscription(_simulationFacade);
+    EXPECT_TRUE(subscription.pollSimulationParameters().has_value());
+    EXPECT_FALSE(subscription.pollSimulationParameters().has_value());
+
+    auto parameters = _simulationFacade->getSimulationParameters();
+    parameters.baseValues.friction = 0.5f;
+    _simulationFacade->setSimulationParameters(parameters);
+
+    auto polledParameters = subscription.pollSimulationParameters();
+    ASSERT_TRUE(polledParameters.has_value());
+    EXPECT_EQ(parameters, *polledParameters);
+    EXPECT_FALSE(subscription.pollSimulationParameters().has_value());
+}
+
+TEST_F(SimulationSubscriptionTests, pollSelectionShallowData)
+{
+    setSimpleData();
+
+    SimulationSubscription subscription(_simulationFacade);
+    auto selection = subscription.pollSelectionShallowData();
+    ASSERT_TRUE(selection.has_value());
+    EXPECT_EQ(0, selection->numCells);
+
+    _simulationFacade->calcTimesteps(1);
+    EXPECT_FALSE(subscription.pollSelectionShallowData().has_value());
+
+    _simulationFacade->setSelection({0, 0}, {20.0f, 20.0f});
+    selection = subscription.pollSelectionShallowData();
+    ASSERT_TRUE(selection.has_value());
+    EXPECT_EQ(2, selection->numCells);
+    EXPECT_EQ(0, selection->numParticles);
+    EXPECT_FALSE(subscription.pollSelectionShallowData().has_value());
+}
+
+TEST_F(SimulationSubscriptionTests, pollInspectedEntities)
+{
+    setSimpleData();
+
+    SimulationSubscription subscription(_simulationFacade);
+    auto changes = subscription.pollInspectedEntities({1, 3});
+    EXPECT_EQ(2, changes.changedEntities.size());
+    EXPECT_TRUE(changes.vanishedEntityIds.empty());
+    EXPECT_TRUE(subscription.pollInspectedEntities({1, 3}).isEmpty());
+
+    //only the changed entity is delivered
+    auto cell = getCell(_simulationFacade->getSimulationData(), 1);
+    cell.energy = 123.0f;
+    _simulationFacade->changeCell(cell);
+    changes = subscription.pollInspectedEntities({1, 3});
+    ASSERT_EQ(1, changes.changedEntities.size());
+    EXPECT_EQ(1, DescriptionEditService::getId(changes.changedEntities.front()));
+    EXPECT_TRUE(approxCompare(123.0f, std::get<CellDescription>(changes.changedEntities.front()).energy));
+
+    //newly subscribed entities are delivered even if nothing has changed
+    changes = subscription.pollInspectedEntities({1, 2, 3});
+    ASSERT_EQ(1, changes.changedEntities.size());
+    EXPECT_EQ(2, DescriptionEditService::getId(changes.changedEntities.front()));
+
+    //removed entities are reported once
+    DataDescription data;
+    data.addCell(CellDescription().setId(1).setPos({10.0f, 10.0f}).setEnergy(123.0f));
+    _simulationFacade->setSimulationData(data);
+    changes = subscription.pollInspectedEntities({1, 2, 3});
+    EXPECT_EQ(2, changes.vanishedEntityIds.size());
+    EXPECT_TRUE(subscription.pollInspectedEntities({1, 2, 3}).vanishedEntityIds.empty());
+}
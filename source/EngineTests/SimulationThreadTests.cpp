@@ -0,0 +1,253 @@
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "Base/MetricsService.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationFacade.h"
+
+#include "IntegrationTestFramework.h"
+
+class SimulationThreadTests : public IntegrationTestFramework
+{
+public:
+    SimulationThreadTests()
+        : IntegrationTestFramework(std::nullopt, {100, 100})
+    {}
+
+    ~SimulationThreadTests() = default;
+
+protected:
+    //CPU time of the whole process (all threads)
+    std::chrono::microseconds getProcessCpuTime() const
+    {
+#if defined(_WIN32)
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+        auto toMicroseconds = [](FILETIME const& time) {
+            return std::chrono::microseconds(((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10);
+        };
+        return toMicroseconds(kernelTime) + toMicroseconds(userTime);
+#else
+        return std::chrono::microseconds(static_cast<int64_t>(std::clock()) * 1000000 / CLOCKS_PER_SEC);
+#endif
+    }
+
+    //ratio between consumed CPU time and elapsed time
+    double measureCpuUsage(std::chrono::milliseconds const& duration) const
+    {
+        auto startCpuTime = getProcessCpuTime();
+        auto startTime = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(duration);
+        auto cpuTime = getProcessCpuTime() - startCpuTime;
+        auto elapsedTime = std::chrono::steady_clock::now() - startTime;
+        return std::chrono::duration<double>(cpuTime) / std::chrono::duration<double>(elapsedTime);
+    }
+
+    //returns the maximum and the mean duration in milliseconds of obtaining the simulation data
+    std::pair<double, double> measureAccessLatency() const
+    {
+        auto constexpr NumAccesses = 20;
+        auto maxDuration = 0.0;
+        auto sumDuration = 0.0;
+        for (int i = 0; i < NumAccesses; ++i) {
+            auto startTime = std::chrono::steady_clock::now();
+            _simulationFacade->getSimulationData();
+            auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+            maxDuration = std::max(maxDuration, duration);
+            sumDuration += duration;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return {maxDuration, sumDuration / NumAccesses};
+    }
+
+    void setSimpleData()
+    {
+        DataDescription data;
+        data.addCells({
+            CellDescription().setId(1).setPos({10.0f, 10.0f}).setMaxConnections(2),
+            CellDescription().setId(2).setPos({11.0f, 10.0f}).setMaxConnections(2),
+        });
+        data.addConnection(1, 2);
+        _simulationFacade->setSimulationData(data);
+    }
+};
+
+TEST_F(SimulationThreadTests, workerBlocksWhilePausedAndWakesOnAccess)
+{
+    auto constexpr NumAccesses = 5;
+
+    setSimpleData();
+    auto& metricsService = MetricsService::get();
+    metricsService.reset();
+    metricsService.setEnabled(true);
+
+    //the access returns only after the worker has granted it, afterwards the worker waits on its condition variable
+    _simulationFacade->getSimulationData();
+    auto wakeUps = metricsService.getCounter("engine.wakeUps");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(wakeUps, metricsService.getCounter("engine.wakeUps"));
+
+    //each access wakes the worker at most once
+    for (int i = 0; i < NumAccesses; ++i) {
+        _simulationFacade->getSimulationData();
+    }
+    auto newWakeUps = metricsService.getCounter("engine.wakeUps") - wakeUps;
+
+    metricsService.setEnabled(false);
+    metricsService.reset();
+    EXPECT_LE(newWakeUps, NumAccesses);
+}
+
+//measures the CPU usage of the idle worker, run with --gtest_also_run_disabled_tests
+TEST_F(SimulationThreadTests, DISABLED_idleBenchmark)
+{
+    setSimpleData();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto pausedCpuUsage = measureCpuUsage(std::chrono::milliseconds(500));
+
+    _simulationFacade->setTpsRestriction(20);
+    _simulationFacade->runSimulation();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto restrictedCpuUsage = measureCpuUsage(std::chrono::milliseconds(500));
+    _simulationFacade->pauseSimulation();
+
+    std::cout << "[          ] CPU usage while paused: " << pausedCpuUsage * 100 << " %" << std::endl;
+    std::cout << "[          ] CPU usage with 20 TPS restriction: " << restrictedCpuUsage * 100 << " %" << std::endl;
+}
+
+//measures the time until another thread obtains access to the simulation data, run with --gtest_also_run_disabled_tests
+TEST_F(SimulationThreadTests, DISABLED_accessLatencyBenchmark)
+{
+    setSimpleData();
+
+    auto [maxPausedLatency, meanPausedLatency] = measureAccessLatency();
+
+    _simulationFacade->runSimulation();
+    auto [maxRunningLatency, meanRunningLatency] = measureAccessLatency();
+
+    _simulationFacade->setTpsRestriction(20);
+    auto [maxRestrictedLatency, meanRestrictedLatency] = measureAccessLatency();
+    _simulationFacade->pauseSimulation();
+
+    std::cout << "[          ] access latency while paused: " << meanPausedLatency << " ms (mean), " << maxPausedLatency << " ms (max)" << std::endl;
+    std::cout << "[          ] access latency while running: " << meanRunningLatency << " ms (mean), " << maxRunningLatency << " ms (max)" << std::endl;
+    std::cout << "[          ] access latency with 20 TPS restriction: " << meanRestrictedLatency << " ms (mean), " << maxRestrictedLatency << " ms (max)"
+              << std::endl;
+}
+
+TEST_F(SimulationThreadTests, editingFromMultipleThreads)
+{
+    auto constexpr NumThreads = 4;
+    auto constexpr NumEditsPerThread = 50;
+
+    DataDescription data;
+    for (int i = 0; i < NumThreads; ++i) {
+        data.addCell(CellDescription().setId(i + 1).setPos({10.0f + toFloat(i) * 10, 10.0f}).setEnergy(100.0f));
+    }
+    _simulationFacade->setSimulationData(data);
+    _simulationFacade->runSimulation();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NumThreads; ++i) {
+        threads.emplace_back([&, i] {
+            auto cell = getCell(data, i + 1);
+            std::future<void> lastEdit;
+            for (int j = 0; j < NumEditsPerThread; ++j) {
+                cell.setEnergy(100.0f + toFloat(j + 1));
+                lastEdit = _simulationFacade->changeCell(cell);
+            }
+            lastEdit.wait();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    _simulationFacade->pauseSimulation();
+
+    auto actualData = _simulationFacade->getSimulationData();
+    for (int i = 0; i < NumThreads; ++i) {
+        EXPECT_TRUE(approxCompare(100.0f + toFloat(NumEditsPerThread), getCell(actualData, i + 1).energy));
+    }
+}
+
+TEST_F(SimulationThreadTests, editingIsVisibleToSubsequentReads)
+{
+    setSimpleData();
+    _simulationFacade->runSimulation();
+
+    auto data = _simulationFacade->getSimulationData();
+    auto cell = getCell(data, 1);
+    cell.setEnergy(123.0f);
+    _simulationFacade->changeCell(cell);
+    auto actualData = _simulationFacade->getSimulationData();
+    _simulationFacade->pauseSimulation();
+
+    EXPECT_TRUE(approxCompare(123.0f, getCell(actualData, 1).energy));
+}
+
+TEST_F(SimulationThreadTests, editingConnectedCell)
+{
+    setSimpleData();
+
+    auto data = _simulationFacade->getSimulationData();
+    auto cell = getCell(data, 1);
+    ASSERT_EQ(1, cell.connections.size());
+    cell.setEnergy(123.0f);
+    _simulationFacade->changeCell(cell).get();
+
+    _simulationFacade->calcTimesteps(10);
+    _simulationFacade->runSimulation();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto actualData = _simulationFacade->getSimulationData();
+    _simulationFacade->pauseSimulation();
+
+    EXPECT_EQ(2, actualData.cells.size());
+    EXPECT_EQ(1, getCell(actualData, 1).connections.size());
+    EXPECT_EQ(1, getCell(actualData, 2).connections.size());
+}
+
+TEST_F(SimulationThreadTests, failingEditKeepsEngineUsable)
+{
+    setSimpleData();
+    _simulationFacade->runSimulation();
+
+    //a constructor without genome header is rejected by the conversion
+    auto data = _simulationFacade->getSimulationData();
+    auto invalidCell = getCell(data, 1);
+    invalidCell.setCellFunction(ConstructorDescription().setGenome({}));
+    auto failingEdit = _simulationFacade->changeCell(invalidCell);
+    EXPECT_THROW(failingEdit.get(), std::runtime_error);
+
+    auto cell = getCell(data, 2);
+    cell.setEnergy(123.0f);
+    _simulationFacade->changeCell(cell).get();
+    auto actualData = _simulationFacade->getSimulationData();
+
+    auto timestep = _simulationFacade->getCurrentTimestep();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    _simulationFacade->pauseSimulation();
+
+    EXPECT_TRUE(approxCompare(123.0f, getCell(actualData, 2).energy));
+    EXPECT_GT(_simulationFacade->getCurrentTimestep(), timestep);
+}
+
+TEST_F(SimulationThreadTests, throughputOnSmallWorld)
+{
+    setSimpleData();
+    _simulationFacade->runSimulation();
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+
+    auto tps = _simulationFacade->getTps();
+    _simulationFacade->pauseSimulation();
+
+    EXPECT_GT(tps, 0.0f);
+}
@@ -0,0 +1,37 @@
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/SpaceCalculator.h"
+
+class SpaceCalculatorTests : public ::testing::Test
+{
+protected:
+    std::mt19937 _randomEngine{42};
+};
+
+TEST_F(SpaceCalculatorTests, positionsInsideWorldRemainUnchanged)
+{
+    SpaceCalculator spaceCalculator({1000, 700});
+    std::uniform_real_distribution<float> distributionX(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> distributionY(0.0f, 700.0f);
+    for (int i = 0; i < 10000; ++i) {
+        RealVector2D pos{distributionX(_randomEngine), distributionY(_randomEngine)};
+        EXPECT_EQ(pos, spaceCalculator.getCorrectedPosition(pos));
+    }
+}
+
+TEST_F(SpaceCalculatorTests, positionsOutsideWorldAreWrapped)
+{
+    SpaceCalculator spaceCalculator({1000, 700});
+    EXPECT_EQ(RealVector2D(999.75f, 0.5f), spaceCalculator.getCorrectedPosition({-0.25f, 700.5f}));
+    EXPECT_EQ(RealVector2D(3.5f, 699.75f), spaceCalculator.getCorrectedPosition({2003.5f, -1400.25f}));
+    EXPECT_EQ(RealVector2D(0.0f, 0.0f), spaceCalculator.getCorrectedPosition({1000.0f, 700.0f}));
+}
+
+TEST_F(SpaceCalculatorTests, distance)
+{
+    SpaceCalculator spaceCalculator({1000, 700});
+    EXPECT_FLOAT_EQ(2.0f, spaceCalculator.distance({999.0f, 10.0f}, {1.0f, 10.0f}));
+    EXPECT_FLOAT_EQ(5.0f, spaceCalculator.distance({1.0f, 698.0f}, {998.0f, 2.0f}));
+}
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/SpaceCalculator.h"
+#include "EngineInterface/SpatialIndex.h"
+
+class SpatialIndexTests : public ::testing::Test
+{
+protected:
+    std::vector<RealVector2D> createRandomPositions(int numPositions, RealVector2D const& lowerBound, RealVector2D const& upperBound)
+    {
+        std::uniform_real_distribution<float> distributionX(lowerBound.x, upperBound.x);
+        std::uniform_real_distribution<float> distributionY(lowerBound.y, upperBound.y);
+        std::vector<RealVector2D> result;
+        for (int i = 0; i < numPositions; ++i) {
+            result.emplace_back(RealVector2D{distributionX(_randomEngine), distributionY(_randomEngine)});
+        }
+        return result;
+    }
+
+    template <typename DistanceFunc>
+    std::vector<int>
+    getIndicesWithinRadiusBruteForce(std::vector<RealVector2D> const& positions, RealVector2D const& pos, float radius, DistanceFunc const& distanceFunc) const
+    {
+        std::vector<std::pair<float, int>> distancesAndIndices;
+        for (int i = 0; i < toInt(positions.size()); ++i) {
+            auto distance = distanceFunc(positions[i], pos);
+            if (distance <= radius) {
+                distancesAndIndices.emplace_back(distance, i);
+            }
+        }
+        std::sort(distancesAndIndices.begin(), distancesAndIndices.end());
+        std::vector<int> result;
+        for (auto const& [distance, index] : distancesAndIndices) {
+            result.emplace_back(index);
+        }
+        return result;
+    }
+
+    //the brute force results use a differently computed distance, hence positions close to the radius are ignored
+    template <typename DistanceFunc>
+    void expectSameIndices(
+        std::vector<int> const& expected,
+        std::vector<int> const& actual,
+        std::vector<RealVector2D> const& positions,
+        RealVector2D const& pos,
+        float radius,
+        DistanceFunc const& distanceFunc) const
+    {
+        auto isUnambiguous = [&](int index) { return std::abs(distanceFunc(positions[index], pos) - radius) > 1e-3f; };
+        std::vector<int> expectedUnambiguous;
+        std::copy_if(expected.begin(), expected.end(), std::back_inserter(expectedUnambiguous), isUnambiguous);
+        std::vector<int> actualUnambiguous;
+        std::copy_if(actual.begin(), actual.end(), std::back_inserter(actualUnambiguous), isUnambiguous);
+        std::sort(expectedUnambiguous.begin(), expectedUnambiguous.end());
+        std::sort(actualUnambiguous.begin(), actualUnambiguous.end());
+        EXPECT_EQ(expectedUnambiguous, actualUnambiguous);
+    }
+
+    int toInt(size_t value) const { return static_cast<int>(value); }
+
+    std::mt19937 _randomEngine{42};
+};
+
+TEST_F(SpatialIndexTests, radiusQueryNonPeriodic)
+{
+    auto positions = createRandomPositions(5000, {-100.0f, -50.0f}, {100.0f, 50.0f});
+    auto distanceFunc = [](RealVector2D const& pos1, RealVector2D const& pos2) {
+        auto delta = pos1 - pos2;
+        return std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    };
+
+    SpatialIndex index(1.5f);
+    index.build(std::vector<RealVector2D>(positions.begin(), positions.begin() + 1000));
+    for (int i = 1000; i < toInt(positions.size()); ++i) {
+        EXPECT_EQ(i, index.insert(positions[i]));
+    }
+    ASSERT_EQ(toInt(positions.size()), index.getNumPositions());
+
+    for (auto const& pos : createRandomPositions(200, {-120.0f, -70.0f}, {120.0f, 70.0f})) {
+        for (auto radius : {0.5f, 1.5f, 7.0f, 80.0f}) {
+            auto expected = getIndicesWithinRadiusBruteForce(positions, pos, radius, distanceFunc);
+            expectSameIndices(expected, index.getIndicesWithinRadius(pos, radius), positions, pos, radius, distanceFunc);
+        }
+    }
+}
+
+TEST_F(SpatialIndexTests, radiusQueryPeriodic)
+{
+    IntVector2D worldSize{100, 60};
+    SpaceCalculator spaceCalculator(worldSize);
+    auto distanceFunc = [&](RealVector2D const& pos1, RealVector2D const& pos2) { return spaceCalculator.distance(pos1, pos2); };
+
+    //positions outside the world are mapped into the world
+    auto positions = createRandomPositions(3000, {-50.0f, -30.0f}, {150.0f, 90.0f});
+
+    for (auto minSlotSize : {1.0f, 3.0f, 7.0f}) {
+        SpatialIndex index(worldSize, minSlotSize);
+        for (auto const& pos : positions) {
+            index.insert(pos);
+        }
+        for (auto const& pos : createRandomPositions(200, {0.0f, 0.0f}, {100.0f, 60.0f})) {
+            for (auto radius : {1.0f, 4.5f, 20.0f, 70.0f}) {
+                auto expected = getIndicesWithinRadiusBruteForce(positions, pos, radius, distanceFunc);
+                expectSameIndices(expected, index.getIndicesWithinRadius(pos, radius), positions, pos, radius, distanceFunc);
+            }
+        }
+    }
+}
+
+TEST_F(SpatialIndexTests, nearestNeighbors)
+{
+    IntVector2D worldSize{200, 200};
+    SpaceCalculator spaceCalculator(worldSize);
+    auto positions = createRandomPositions(2000, {0.0f, 0.0f}, {200.0f, 200.0f});
+
+    SpatialIndex index(worldSize, 1.0f);
+    index.build(positions);
+    for (auto const& pos : createRandomPositions(100, {0.0f, 0.0f}, {200.0f, 200.0f})) {
+        for (auto numNeighbors : {1, 5, 50}) {
+            std::vector<float> distances;
+            for (auto const& otherPos : positions) {
+                distances.emplace_back(spaceCalculator.distance(pos, otherPos));
+            }
+            std::sort(distances.begin(), distances.end());
+
+            auto result = index.getNearestIndices(pos, numNeighbors);
+            ASSERT_EQ(numNeighbors, toInt(result.size()));
+            for (int i = 0; i < numNeighbors; ++i) {
+                EXPECT_NEAR(distances[i], spaceCalculator.distance(pos, positions[result[i]]), 1e-3f);
+            }
+        }
+    }
+
+    SpatialIndex sparseIndex(1.0f);
+    sparseIndex.build({{0.0f, 0.0f}, {1000.0f, 0.0f}, {-500.0f, 3000.0f}});
+    EXPECT_EQ(std::vector<int>({1, 0, 2}), sparseIndex.getNearestIndices({900.0f, 0.0f}, 5));
+}
+
+TEST_F(SpatialIndexTests, parallelQueries)
+{
+    auto positions = createRandomPositions(100000, {0.0f, 0.0f}, {300.0f, 300.0f});
+    SpatialIndex index(1.0f);
+    index.build(positions);
+
+    auto results = index.getIndicesWithinRadius(positions, 1.0f);
+    ASSERT_EQ(positions.size(), results.size());
+    for (int i = 0; i < toInt(positions.size()); i += 997) {
+        EXPECT_EQ(index.getIndicesWithinRadius(positions[i], 1.0f), results[i]);
+    }
+}
+
+TEST_F(SpatialIndexTests, isAnyCloserThan)
+{
+    SpatialIndex index(IntVector2D{50, 50}, 1.0f);
+    index.insert({49.5f, 10.0f});
+    EXPECT_TRUE(index.isAnyCloserThan({0.5f, 10.0f}, 1.1f));
+    EXPECT_FALSE(index.isAnyCloserThan({0.5f, 10.0f}, 1.0f));
+    EXPECT_FALSE(index.isAnyCloserThan({25.0f, 10.0f}, 2.0f));
+
+    index.clear();
+    EXPECT_EQ(0, index.getNumPositions());
+    EXPECT_FALSE(index.isAnyCloserThan({49.5f, 10.0f}, 1.0f));
+}
+
+//timings for a million positions, run with --gtest_also_run_disabled_tests
+TEST_F(SpatialIndexTests, DISABLED_buildAndQueryBenchmark)
+{
+    auto constexpr NumPositions = 1000000;
+    auto positions = createRandomPositions(NumPositions, {0.0f, 0.0f}, {1000.0f, 1000.0f});
+
+    auto startTime = std::chrono::steady_clock::now();
+    SpatialIndex index(1.5f);
+    index.build(positions);
+    auto buildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    startTime = std::chrono::steady_clock::now();
+    auto results = index.getIndicesWithinRadius(positions, 1.5f);
+    auto queryTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::cout << "[          ] " << NumPositions << " positions: build " << buildTime << " ms, radius queries for all positions " << queryTime << " ms"
+              << std::endl;
+    EXPECT_EQ(NumPositions, toInt(results.size()));
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/StatisticsColumns.h"
+#include "EngineInterface/StatisticsColumnService.h"
+
+class StatisticsColumnsTests : public ::testing::Test
+{
+protected:
+    StatisticsColumns createColumns(int numRows) const
+    {
+        StatisticsColumns result;
+        for (int i = 0; i < numRows; ++i) {
+            DataPointCollection dataPoint;
+            dataPoint.time = toDouble(i);
+            dataPoint.systemClock = 1000.0 + i;
+            for (int j = 0; j < MAX_COLORS; ++j) {
+                dataPoint.numCells.values[j] = toDouble((i * 7 + j * 13) % 101);
+            }
+            dataPoint.numCells.summedValues = toDouble(i % 17);
+            result.pushBack(dataPoint);
+        }
+        return result;
+    }
+
+    double toDouble(int value) const { return static_cast<double>(value); }
+};
+
+TEST_F(StatisticsColumnsTests, rowRoundTrip)
+{
+    auto columns = createColumns(200);
+    ASSERT_EQ(200, columns.size());
+
+    auto numCellsColumn = columns.getColumn(StatisticsColumns::getColumnIndex(&DataPointCollection::numCells, 3));
+    for (int i = 0; i < 200; ++i) {
+        auto row = columns.getRow(i);
+        EXPECT_EQ(toDouble(i), row.time);
+        EXPECT_EQ(1000.0 + i, row.systemClock);
+        EXPECT_EQ(toDouble(i % 17), row.numCells.summedValues);
+        EXPECT_EQ(row.numCells.values[3], numCellsColumn[i]);
+    }
+
+    columns.eraseFront(50);
+    ASSERT_EQ(150, columns.size());
+    EXPECT_EQ(50.0, columns.getColumn(StatisticsColumns::TimeColumn)[0]);
+    EXPECT_EQ(toDouble(50 % 17), columns.getRow(0).numCells.summedValues);
+}
+
+TEST_F(StatisticsColumnsTests, kernels)
+{
+    for (auto count : {0, 1, 3, 4, 5, 17, 1000}) {
+        auto columns = createColumns(count);
+        auto values = columns.getColumn(StatisticsColumns::getColumnIndex(&DataPointCollection::numCells, MAX_COLORS));
+
+        auto expectedSum = 0.0;
+        auto expectedMin = std::numeric_limits<double>::infinity();
+        auto expectedMax = -std::numeric_limits<double>::infinity();
+        for (int i = 0; i < count; ++i) {
+            expectedSum += values[i];
+            expectedMin = std::min(expectedMin, values[i]);
+            expectedMax = std::max(expectedMax, values[i]);
+        }
+        EXPECT_EQ(expectedSum, StatisticsColumnService::getSum(values, count));
+        if (count > 0) {
+            EXPECT_EQ(expectedMin, StatisticsColumnService::getMin(values, count));
+            EXPECT_EQ(expectedMax, StatisticsColumnService::getMax(values, count));
+        }
+    }
+}
+
+TEST_F(StatisticsColumnsTests, decimateMinMaxKeepsExtremes)
+{
+    auto constexpr NumRows = 10000;
+    auto constexpr NumBuckets = 100;
+    auto columns = createColumns(NumRows);
+    auto timePoints = columns.getColumn(StatisticsColumns::TimeColumn);
+    auto values = columns.getColumn(StatisticsColumns::getColumnIndex(&DataPointCollection::numCells, MAX_COLORS));
+    values[1234] = 1e6;
+    values[5678] = -1e6;
+
+    auto indices = StatisticsColumnService::decimateMinMax(timePoints, values, NumRows, 1000.0, toDouble(NumRows - 1), NumBuckets);
+
+    EXPECT_LE(indices.size(), 2 * NumBuckets + 2);
+    EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+    EXPECT_EQ(999, indices.front());
+    EXPECT_EQ(NumRows - 1, indices.back());
+    EXPECT_TRUE(std::find(indices.begin(), indices.end(), 1234) != indices.end());
+    EXPECT_TRUE(std::find(indices.begin(), indices.end(), 5678) != indices.end());
+
+    auto allIndices = StatisticsColumnService::decimateMinMax(timePoints, values, 10, 0.0, 9.0, NumBuckets);
+    ASSERT_EQ(10, allIndices.size());
+    for (size_t i = 0; i < allIndices.size(); ++i) {
+        EXPECT_EQ(i, allIndices.at(i));
+    }
+}
+
+//compares the timings with the former row-wise aggregation, run with --gtest_also_run_disabled_tests
+TEST_F(StatisticsColumnsTests, DISABLED_rowWiseVersusColumnWiseBenchmark)
+{
+    auto constexpr NumRows = 100000;
+    auto columns = createColumns(NumRows);
+    std::vector<DataPointCollection> rows;
+    rows.reserve(NumRows);
+    for (int i = 0; i < NumRows; ++i) {
+        rows.emplace_back(columns.getRow(i));
+    }
+
+    auto measure = [](auto const& func) {
+        auto constexpr NumIterations = 20;
+        auto startTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < NumIterations; ++i) {
+            func();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count() / NumIterations;
+    };
+
+    //sum of all metrics as done before aggregating buckets
+    DataPointCollection rowSum;
+    auto rowSumTime = measure([&] {
+        rowSum = DataPointCollection();
+        for (auto const& row : rows) {
+            rowSum = rowSum + row;
+        }
+    });
+    std::vector<double> columnSum(StatisticsColumns::NumColumns);
+    auto columnSumTime = measure([&] {
+        for (int i = 0; i < StatisticsColumns::NumColumns; ++i) {
+            columnSum[i] = StatisticsColumnService::getSum(columns.getColumn(i), NumRows);
+        }
+    });
+
+    //maximum of a single metric as done for the plot bounds
+    auto const stride = sizeof(DataPointCollection) / sizeof(double);
+    auto rowValues = &rows.front().numCells.summedValues;
+    auto rowMax = 0.0;
+    auto rowMaxTime = measure([&] {
+        rowMax = rowValues[0];
+        for (size_t i = 1; i < NumRows; ++i) {
+            rowMax = std::max(rowMax, rowValues[i * stride]);
+        }
+    });
+    auto columnValues = columns.getColumn(StatisticsColumns::getColumnIndex(&DataPointCollection::numCells, MAX_COLORS));
+    auto columnMax = 0.0;
+    auto columnMaxTime = measure([&] { columnMax = StatisticsColumnService::getMax(columnValues, NumRows); });
+
+    std::cout << "[          ] " << NumRows << " data points with " << StatisticsColumns::NumColumns << " values" << std::endl;
+    std::cout << "[          ] sum of all values: " << rowSumTime << " ms (row-wise), " << columnSumTime << " ms (column-wise)" << std::endl;
+    std::cout << "[          ] maximum of one value: " << rowMaxTime << " ms (row-wise), " << columnMaxTime << " ms (column-wise)" << std::endl;
+
+    //all test values are integers, hence the summation order does not matter
+    auto rowSumValues = reinterpret_cast<double const*>(&rowSum);
+    for (int i = 0; i < StatisticsColumns::NumColumns; ++i) {
+        EXPECT_EQ(rowSumValues[i], columnSum[i]);
+    }
+    EXPECT_EQ(rowMax, columnMax);
+}
@@ -6,6 +6,7 @@
 #include "EngineInterface/SimulationFacade.h"
 #include "EngineInterface/GenomeDescriptionService.h"
 #include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/StatisticsHistory.h"
 
 #include "IntegrationTestFramework.h"
 
@@ -92,3 +93,101 @@ TEST_F(StatisticsTests, nonSelfReplicatorWithRepetitionsInGenome)
     EXPECT_EQ(0, statistics.timeline.timestep.numSelfReplicators[0]);
     EXPECT_EQ(00, statistics.timeline.timestep.numGenomeCells[0]);
 }
+
+TEST_F(StatisticsTests, historySnapshotUnaffectedByWriter)
+{
+    auto createDataPoint = [](double time) {
+        DataPointCollection result;
+        result.time = time;
+        return result;
+    };
+    StatisticsHistory history;
+    for (int i = 0; i < 100; ++i) {
+        history.append(createDataPoint(toDouble(i)));
+    }
+
+    auto snapshot = history.getSnapshot();
+    for (int i = 100; i < 200; ++i) {
+        history.append(createDataPoint(toDouble(i)));
+    }
+    history.replaceBack(createDataPoint(1000.0));
+
+    ASSERT_EQ(100, snapshot.size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(toDouble(i), snapshot[i].time);
+    }
+    auto newSnapshot = history.getSnapshot();
+    ASSERT_EQ(200, newSnapshot.size());
+    EXPECT_EQ(198.0, newSnapshot[198].time);
+    EXPECT_EQ(1000.0, newSnapshot.back().time);
+
+    history.clear();
+    EXPECT_TRUE(history.getSnapshot().empty());
+    EXPECT_EQ(100, snapshot.size());
+}
+
+TEST_F(StatisticsTests, historyQueryKeepsExtremesAndRecentDetails)
+{
+    StatisticsHistory history;
+    for (int i = 0; i < 100000; ++i) {
+        DataPointCollection dataPoint;
+        dataPoint.time = toDouble(i);
+        dataPoint.numCells.summedValues = i == 5000 ? 1000.0 : 1.0;
+        history.append(dataPoint);
+    }
+
+    auto timeInterval = history.getTimeInterval();
+    ASSERT_TRUE(timeInterval.has_value());
+    EXPECT_EQ(0.0, timeInterval->first);
+    EXPECT_EQ(99999.0, timeInterval->second);
+
+    //entire history at a coarse resolution
+    auto result = history.query(timeInterval->first, timeInterval->second, 500);
+    ASSERT_FALSE(result.mean.empty());
+    EXPECT_GE(1000, result.mean.size());
+    EXPECT_EQ(result.mean.size(), result.minimum.size());
+    EXPECT_EQ(result.mean.size(), result.maximum.size());
+
+    auto timePoints = result.mean.getColumn(StatisticsColumns::TimeColumn);
+    auto numCellsColumn = StatisticsColumns::getColumnIndex(&DataPointCollection::numCells, MAX_COLORS);
+    EXPECT_EQ(0.0, timePoints[0]);
+    EXPECT_EQ(99999.0, timePoints[result.mean.size() - 1]);
+    auto maxValue = 0.0;
+    auto maxMeanValue = 0.0;
+    for (size_t i = 0; i < result.mean.size(); ++i) {
+        if (i > 0) {
+            EXPECT_LT(timePoints[i - 1], timePoints[i]);
+        }
+        EXPECT_EQ(1.0, result.minimum.getColumn(numCellsColumn)[i]);
+        maxValue = std::max(maxValue, result.maximum.getColumn(numCellsColumn)[i]);
+        maxMeanValue = std::max(maxMeanValue, result.mean.getColumn(numCellsColumn)[i]);
+    }
+    EXPECT_EQ(1000.0, maxValue);
+    EXPECT_GT(1000.0, maxMeanValue);
+
+    //recent time range at full resolution
+    auto recentResult = history.query(99900.0, 99999.0, 500);
+    ASSERT_EQ(100, recentResult.mean.size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(toDouble(99900 + i), recentResult.mean.getRow(i).time);
+    }
+}
+
+TEST_F(StatisticsTests, historySetKeepsResolution)
+{
+    StatisticsHistory history;
+    for (int i = 0; i < 10000; ++i) {
+        DataPointCollection dataPoint;
+        dataPoint.time = toDouble(i);
+        history.append(dataPoint);
+    }
+    auto snapshot = history.getSnapshot();
+
+    StatisticsHistory restoredHistory;
+    restoredHistory.set(snapshot);
+    auto restoredSnapshot = restoredHistory.getSnapshot();
+    ASSERT_EQ(snapshot.size(), restoredSnapshot.size());
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        EXPECT_EQ(snapshot[i].time, restoredSnapshot[i].time);
+    }
+}
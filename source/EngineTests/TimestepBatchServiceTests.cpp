@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/TimestepBatchService.h"
+
+class TimestepBatchServiceTests : public ::testing::Test
+{};
+
+TEST_F(TimestepBatchServiceTests, batchSizeWithoutMeasurement)
+{
+    EXPECT_EQ(1, TimestepBatchService::calcBatchSize(0, 0));
+}
+
+TEST_F(TimestepBatchServiceTests, batchSizeForTargetDuration)
+{
+    EXPECT_EQ(20, TimestepBatchService::calcBatchSize(100.0f, 0));
+}
+
+TEST_F(TimestepBatchServiceTests, batchSizeIsCapped)
+{
+    EXPECT_EQ(TimestepBatchService::MaxTimestepsPerBatch, TimestepBatchService::calcBatchSize(10.0f, 0));
+    EXPECT_EQ(TimestepBatchService::MaxTimestepsPerBatch, TimestepBatchService::calcBatchSize(1e-9f, 0));
+}
+
+TEST_F(TimestepBatchServiceTests, batchSizeForSlowTimesteps)
+{
+    EXPECT_EQ(1, TimestepBatchService::calcBatchSize(TimestepBatchService::TargetBatchDuration * 10, 0));
+}
+
+TEST_F(TimestepBatchServiceTests, batchSizeWithTpsRestriction)
+{
+    EXPECT_EQ(1, TimestepBatchService::calcBatchSize(10.0f, 30));
+}
+
+TEST_F(TimestepBatchServiceTests, batchWithoutInterruption)
+{
+    auto timesteps = 0;
+    auto result = TimestepBatchService::calcBatch(10, [&] { ++timesteps; }, [] { return false; });
+
+    EXPECT_EQ(10, result);
+    EXPECT_EQ(10, timesteps);
+}
+
+TEST_F(TimestepBatchServiceTests, batchInterruptedByRequest)
+{
+    auto timesteps = 0;
+    auto isRequested = false;
+    auto result = TimestepBatchService::calcBatch(
+        TimestepBatchService::MaxTimestepsPerBatch,
+        [&] {
+            ++timesteps;
+            if (timesteps == 3) {
+                isRequested = true;
+            }
+        },
+        [&] { return isRequested; });
+
+    EXPECT_EQ(3, result);
+    EXPECT_EQ(3, timesteps);
+}
+
+TEST_F(TimestepBatchServiceTests, batchCalculatesAtLeastOneTimestep)
+{
+    auto timesteps = 0;
+    auto result = TimestepBatchService::calcBatch(10, [&] { ++timesteps; }, [] { return true; });
+
+    EXPECT_EQ(1, result);
+    EXPECT_EQ(1, timesteps);
+}
+
+TEST_F(TimestepBatchServiceTests, averageTimestepDuration)
+{
+    EXPECT_FLOAT_EQ(50.0f, TimestepBatchService::calcAverageTimestepDuration(0, 50.0f));
+    EXPECT_FLOAT_EQ(110.0f, TimestepBatchService::calcAverageTimestepDuration(100.0f, 200.0f));
+}
@@ -1430,9 +1430,9 @@ namespace
 
 void AlienImGui::NeuronSelection(
     NeuronSelectionParameters const& parameters,
-    std::vector<std::vector<float>>& weights,
-    std::vector<float>& biases,
-    std::vector<NeuronActivationFunction>& activationFunctions)
+    NeuronWeights& weights,
+    NeuronBiases& biases,
+    NeuronActivationFunctions& activationFunctions)
 {
     auto& selectedInput = getIdBasedValue(_neuronSelectedInput, 0);
     auto& selectedOutput = getIdBasedValue(_neuronSelectedOutput, 0);
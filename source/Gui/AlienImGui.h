@@ -9,6 +9,7 @@
 #include "EngineInterface/PreviewDescriptions.h"
 #include "Definitions.h"
 #include "EngineInterface/CellFunctionConstants.h"
+#include "EngineInterface/NeuronData.h"
 
 class AlienImGui
 {
@@ -333,9 +334,9 @@ public:
     };
     static void NeuronSelection(
         NeuronSelectionParameters const& parameters,
-        std::vector<std::vector<float>>& weights,
-        std::vector<float>& biases,
-        std::vector<NeuronActivationFunction>& activationFunctions);
+        NeuronWeights& weights,
+        NeuronBiases& biases,
+        NeuronActivationFunctions& activationFunctions);
 
     static void OnlineSymbol();
     static void LastDayOnlineSymbol();
@@ -1,28 +1,30 @@
 #include "AutosaveController.h"
 
+#include <thread>
+
 #include <imgui.h>
 
+#include "Base/LoggingService.h"
 #include "Base/Resources.h"
 #include "Base/GlobalSettings.h"
-#include "EngineInterface/SerializerService.h"
-#include "EngineInterface/SimulationFacade.h"
 
 #include "Viewport.h"
-#include "DelayedExecutionController.h"
 #include "OverlayMessageController.h"
-#include "SerializationHelperService.h"
 #include "MainLoopEntityController.h"
 
 namespace
 {
     auto constexpr MinutesForAutosave = 40;
+    auto constexpr AutosaveSenderId = "AutosaveController";
 }
 
-void AutosaveController::init(SimulationFacade const& simulationFacade)
+void AutosaveController::init(SimulationFacade const& simulationFacade, PersisterFacade const& persisterFacade)
 {
     _simulationFacade = simulationFacade;
+    _persisterFacade = persisterFacade;
     _startTimePoint = std::chrono::steady_clock::now();
     _on = GlobalSettings::get().getBool("controllers.auto save.active", true);
+    _numSlots = std::max(1, GlobalSettings::get().getInt("controllers.auto save.slots", _numSlots));
 
     MainLoopEntityController::get().registerObject(this);
 }
@@ -30,10 +32,14 @@ void AutosaveController::init(SimulationFacade const& simulationFacade)
 void AutosaveController::shutdown()
 {
     GlobalSettings::get().setBool("controllers.auto save.active", _on);
-    if (!_on) {
-        return;
+    GlobalSettings::get().setInt("controllers.auto save.slots", _numSlots);
+
+    //a running autosave is completed and, if activated, a final one is made before the persister is shut down
+    waitForSaveRequest();
+    if (_on) {
+        scheduleSave();
+        waitForSaveRequest();
     }
-    onSave();
 }
 
 bool AutosaveController::isOn() const
@@ -48,14 +54,15 @@ void AutosaveController::setOn(bool value)
 
 void AutosaveController::process()
 {
+    processSaveRequest();
+
     if (!_on) {
         return;
     }
 
     auto durationSinceStart = std::chrono::duration_cast<std::chrono::minutes>(std::chrono::steady_clock::now() - *_startTimePoint).count();
     if (durationSinceStart > 0 && durationSinceStart % MinutesForAutosave == 0 && !_alreadySaved) {
-        printOverlayMessage("Auto saving ...");
-        delayedExecution([=, this] { onSave(); });
+        scheduleSave();
         _alreadySaved = true;
     }
     if (durationSinceStart > 0 && durationSinceStart % MinutesForAutosave == 1 && _alreadySaved) {
@@ -63,8 +70,44 @@ void AutosaveController::process()
     }
 }
 
-void AutosaveController::onSave()
+void AutosaveController::scheduleSave()
 {
-    DeserializedSimulation sim = SerializationHelperService::getDeserializedSerialization(_simulationFacade);
-    SerializerService::serializeSimulationToFiles(Const::AutosaveFile, sim);
+    if (_saveRequestId) {
+        return;
+    }
+    printOverlayMessage("Auto saving ...");
+
+    auto senderInfo = SenderInfo{.senderId = SenderId{AutosaveSenderId}, .wishResultData = true, .wishErrorInfo = true};
+    auto requestData =
+        AutosaveSimulationRequestData{Const::AutosaveFile, _numSlots, Viewport::get().getZoomFactor(), Viewport::get().getCenterInWorldPos()};
+    _saveRequestId = _persisterFacade->scheduleAutosaveSimulation(senderInfo, requestData);
+}
+
+void AutosaveController::processSaveRequest()
+{
+    if (!_saveRequestId) {
+        return;
+    }
+    auto requestState = _persisterFacade->getRequestState(*_saveRequestId);
+    if (requestState == PersisterRequestState::Finished) {
+        auto result = _persisterFacade->fetchAutosaveSimulationData(*_saveRequestId);
+        log(Priority::Important,
+            "autosave of time step " + std::to_string(result.timestep) + " finished in " + std::to_string(result.duration.count()) + " ms, "
+                + std::to_string(result.bytesWritten) + " bytes written");
+        _saveRequestId.reset();
+    }
+    if (requestState == PersisterRequestState::Error) {
+        log(Priority::Important, _persisterFacade->fetchError(*_saveRequestId).message);
+        _saveRequestId.reset();
+    }
+}
+
+void AutosaveController::waitForSaveRequest()
+{
+    while (_saveRequestId) {
+        processSaveRequest();
+        if (_saveRequestId) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
 }
@@ -4,6 +4,7 @@
 
 #include "Base/Singleton.h"
 #include "EngineInterface/Definitions.h"
+#include "PersisterInterface/PersisterFacade.h"
 
 #include "Definitions.h"
 #include "MainLoopEntity.h"
@@ -13,7 +14,7 @@ class AutosaveController : public MainLoopEntity
     MAKE_SINGLETON(AutosaveController);
 
 public:
-    void init(SimulationFacade const& simulationFacade);
+    void init(SimulationFacade const& simulationFacade, PersisterFacade const& persisterFacade);
 
     bool isOn() const;
     void setOn(bool value);
@@ -22,11 +23,16 @@ private:
     void process() override;
     void shutdown() override;
 
-    void onSave();
+    void scheduleSave();
+    void processSaveRequest();
+    void waitForSaveRequest();
 
     SimulationFacade _simulationFacade;
+    PersisterFacade _persisterFacade;
 
     bool _on = true;
+    int _numSlots = 3;
     std::optional<std::chrono::steady_clock::time_point> _startTimePoint;
     bool _alreadySaved = false;
-};
\ No newline at end of file
+    std::optional<PersisterRequestId> _saveRequestId;
+};
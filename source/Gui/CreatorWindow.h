@@ -65,7 +65,7 @@ private:
 
     //drawing
     DataDescription _drawingDataDescription;
-    DescriptionEditService::Occupancy _drawingOccupancy;
+    SpatialIndex _drawingOccupancy;
     RealVector2D _lastDrawPos;
 
     CreationMode _mode = CreationMode_Drawing;
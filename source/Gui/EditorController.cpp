@@ -28,6 +28,7 @@ namespace
 void EditorController::init(SimulationFacade const& simulationFacade)
 {
     _simulationFacade = simulationFacade;
+    _subscription = SimulationSubscription(simulationFacade);
 
     SelectionWindow::get().init();
     EditorModel::get().init(_simulationFacade);
@@ -219,8 +220,24 @@ void EditorController::processInspectorWindows()
     for (auto const& entity : inspectedEntities) {
         entityIds.emplace_back(DescriptionEditService::getId(entity));
     }
-    auto inspectedData = _simulationFacade->getInspectedSimulationData(entityIds);
-    auto newInspectedEntities = DescriptionEditService::getObjects(inspectedData);
+    auto changes = _subscription.pollInspectedEntities(entityIds);
+    if (changes.isEmpty()) {
+        return;
+    }
+    std::unordered_map<uint64_t, CellOrParticleDescription> changedEntityById;
+    for (auto const& entity : changes.changedEntities) {
+        changedEntityById.emplace(DescriptionEditService::getId(entity), entity);
+    }
+    std::unordered_set<uint64_t> vanishedEntityIds(changes.vanishedEntityIds.begin(), changes.vanishedEntityIds.end());
+    std::vector<CellOrParticleDescription> newInspectedEntities;
+    for (auto const& entity : inspectedEntities) {
+        auto id = DescriptionEditService::getId(entity);
+        if (vanishedEntityIds.contains(id)) {
+            continue;
+        }
+        auto findResult = changedEntityById.find(id);
+        newInspectedEntities.emplace_back(findResult != changedEntityById.end() ? findResult->second : entity);
+    }
     EditorModel::get().setInspectedEntities(newInspectedEntities);
 
     inspectorWindows.clear();
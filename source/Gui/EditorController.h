@@ -3,6 +3,7 @@
 #include "Base/Definitions.h"
 #include "Base/Singleton.h"
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationSubscription.h"
 
 #include "Definitions.h"
 #include "MainLoopEntity.h"
@@ -44,6 +45,7 @@ private:
     void processInspectorWindows();
 
     SimulationFacade _simulationFacade;
+    SimulationSubscription _subscription;
 
     bool _on = false;   //#TODO weg!
 
@@ -6,6 +6,7 @@
 void EditorModel::init(SimulationFacade const& simulationFacade)
 {
     _simulationFacade = simulationFacade;
+    _subscription = SimulationSubscription(simulationFacade);
 
     clear();
 }
@@ -17,7 +18,9 @@ SelectionShallowData const& EditorModel::getSelectionShallowData() const
 
 void EditorModel::update()
 {
-    _selectionShallowData = _simulationFacade->getSelectionShallowData();
+    if (auto selectionShallowData = _subscription.pollSelectionShallowData()) {
+        _selectionShallowData = *selectionShallowData;
+    }
 }
 
 bool EditorModel::isSelectionEmpty() const
@@ -34,6 +37,7 @@ bool EditorModel::isCellSelectionEmpty() const
 void EditorModel::clear()
 {
     _selectionShallowData = SelectionShallowData();
+    _subscription.reset();
 }
 
 bool EditorModel::existsInspectedEntity(uint64_t id) const
@@ -4,6 +4,7 @@
 #include "Base/Singleton.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/SimulationSubscription.h"
 
 #include "Definitions.h"
 #include "InspectorWindow.h"
@@ -41,6 +42,7 @@ public:
 
 private:
     SimulationFacade _simulationFacade;
+    SimulationSubscription _subscription;
     SelectionShallowData _selectionShallowData;
 
     std::unordered_map<uint64_t, CellOrParticleDescription> _inspectedEntityById;
@@ -51,7 +51,11 @@ void FileTransferController::onOpenSimulation()
                         data.deserializedSimulation.auxiliaryData.timestep,
                         data.deserializedSimulation.auxiliaryData.generalSettings,
                         data.deserializedSimulation.auxiliaryData.simulationParameters);
-                    _simulationFacade->setClusteredSimulationData(data.deserializedSimulation.mainData);
+                    if (data.deserializedSimulation.snapshotFilename) {
+                        _simulationFacade->setSimulationDataFromSnapshotFile(*data.deserializedSimulation.snapshotFilename);
+                    } else {
+                        _simulationFacade->setClusteredSimulationData(data.deserializedSimulation.mainData);
+                    }
                     _simulationFacade->setStatisticsHistory(data.deserializedSimulation.statistics);
                     _simulationFacade->setRealTime(data.deserializedSimulation.auxiliaryData.realTime);
                 } catch (CudaMemoryAllocationException const& exception) {
@@ -21,6 +21,7 @@
 #include "implot.h"
 #include "Fonts/IconsFontAwesome5.h"
 
+#include "Base/MetricsService.h"
 #include "PersisterInterface/PersisterFacade.h"
 #include "EngineInterface/SerializerService.h"
 #include "EngineInterface/SimulationFacade.h"
@@ -117,7 +118,7 @@ _MainWindow::_MainWindow(SimulationFacade const& simulationFacade, PersisterFaca
 
     log(Priority::Important, "initialize windows");
     Viewport::get().init(_simulationFacade);
-    AutosaveController::get().init(_simulationFacade);
+    AutosaveController::get().init(_simulationFacade, _persisterFacade);
     EditorController::get().init(_simulationFacade);
     SimulationView::get().init(_simulationFacade);
     SimulationInteractionController::get().init(_simulationFacade);
@@ -228,6 +229,7 @@ void _MainWindow::shutdown()
     _persisterFacade->shutdown();
     _simulationFacade->closeSimulation();
     NetworkService::get().shutdown();
+    MetricsService::get().setEnabled(false);
 }
 
 void _MainWindow::initGlfwAndOpenGL()
@@ -536,6 +538,10 @@ void _MainWindow::processMenubar()
                 ImageToPatternDialog::get().show();
                 _toolsMenuToggled = false;
             }
+            if (ImGui::MenuItem("Export metrics trace")) {
+                onExportMetricsTrace();
+                _toolsMenuToggled = false;
+            }
             AlienImGui::EndMenuButton();
         }
 
@@ -552,6 +558,9 @@ void _MainWindow::processMenubar()
             if (ImGui::MenuItem("Network settings", "ALT+K")) {
                 NetworkSettingsDialog::get().open();
             }
+            if (ImGui::MenuItem("Metrics", "", MetricsService::isEnabled())) {
+                MetricsService::get().setEnabled(!MetricsService::isEnabled());
+            }
             AlienImGui::EndMenuButton();
         }
 
@@ -760,6 +769,16 @@ void _MainWindow::onExit()
     ExitDialog::get().open();
 }
 
+void _MainWindow::onExportMetricsTrace()
+{
+    GenericFileDialogs::get().showSaveFileDialog(
+        "Export metrics trace", "Trace file (*.json){.json},.*", std::filesystem::current_path().string(), [](std::filesystem::path const& path) {
+            if (!MetricsService::get().writeChromeTraceToFile(path)) {
+                MessageDialog::get().information("Export metrics trace", "The trace could not be saved to the specified file.");
+            }
+        });
+}
+
 void _MainWindow::finishFrame()
 {
     ImGui::Render();
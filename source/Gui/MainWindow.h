@@ -32,6 +32,7 @@ private:
     void onRunSimulation();
     void onPauseSimulation();
     void onExit();
+    void onExportMetricsTrace();
 
     void finishFrame();
 
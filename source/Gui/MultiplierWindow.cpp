@@ -155,13 +155,14 @@ void MultiplierWindow::onBuild()
             return DescriptionEditService::gridMultiply(_origSelection, _gridParameters);
         } else {
             auto data = _simulationFacade->getSimulationData();
-            auto overlappingCheckSuccessful = true;
-            auto result = DescriptionEditService::randomMultiply(
-                _origSelection, _randomParameters, _simulationFacade->getWorldSize(), std::move(data), overlappingCheckSuccessful);
-            if (!overlappingCheckSuccessful) {
-                MessageDialog::get().information("Random multiplication", "Non-overlapping copies could not be created.");
+            auto result = DescriptionEditService::randomMultiply(_origSelection, _randomParameters, _simulationFacade->getWorldSize(), data);
+            if (result.numCopies < _randomParameters._number) {
+                MessageDialog::get().information(
+                    "Random multiplication",
+                    "Only " + std::to_string(result.numCopies) + " of " + std::to_string(_randomParameters._number) + " non-overlapping copies ("
+                        + std::to_string(toInt(result.fillRate * 100)) + "%) could be created.");
             }
-            return result;
+            return result.data;
         }
     }();
     _simulationFacade->removeSelectedObjects(true);
@@ -81,7 +81,7 @@ void ResizeWorldDialog::onResizing()
     auto parameters = _simulationFacade->getSimulationParameters();
     auto content = _simulationFacade->getClusteredSimulationData();
     auto realtime = _simulationFacade->getRealTime();
-    auto const& statistics = _simulationFacade->getStatisticsHistory().getCopiedData();
+    auto statistics = _simulationFacade->getStatisticsHistory().getSnapshot();
     _simulationFacade->closeSimulation();
 
     IntVector2D origWorldSize{generalSettings.worldSizeX, generalSettings.worldSizeY};
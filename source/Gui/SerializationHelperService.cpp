@@ -5,6 +5,13 @@
 
 
 DeserializedSimulation SerializationHelperService::getDeserializedSerialization(SimulationFacade const& simulationFacade)
+{
+    auto result = getDeserializedSerializationWithoutMainData(simulationFacade);
+    result.mainData = simulationFacade->getClusteredSimulationData();
+    return result;
+}
+
+DeserializedSimulation SerializationHelperService::getDeserializedSerializationWithoutMainData(SimulationFacade const& simulationFacade)
 {
     DeserializedSimulation result;
     result.auxiliaryData.timestep = static_cast<uint32_t>(simulationFacade->getCurrentTimestep());
@@ -13,7 +20,6 @@ DeserializedSimulation SerializationHelperService::getDeserializedSerialization(
     result.auxiliaryData.center = Viewport::get().getCenterInWorldPos();
     result.auxiliaryData.generalSettings = simulationFacade->getGeneralSettings();
     result.auxiliaryData.simulationParameters = simulationFacade->getSimulationParameters();
-    result.statistics = simulationFacade->getStatisticsHistory().getCopiedData();
-    result.mainData = simulationFacade->getClusteredSimulationData();
+    result.statistics = simulationFacade->getStatisticsHistory().getSnapshot();
     return result;
 }
@@ -7,4 +7,5 @@ class SerializationHelperService
 {
 public:
     static DeserializedSimulation getDeserializedSerialization(SimulationFacade const& simulationFacade);
+    static DeserializedSimulation getDeserializedSerializationWithoutMainData(SimulationFacade const& simulationFacade);
 };
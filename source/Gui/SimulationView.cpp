@@ -25,6 +25,7 @@ namespace
 void SimulationView::init(SimulationFacade const& simulationFacade)
 {
     _simulationFacade = simulationFacade;
+    _subscription = SimulationSubscription(simulationFacade);
 
     _isCellDetailOverlayActive = GlobalSettings::get().getBool("settings.simulation view.overlay", _isCellDetailOverlayActive);
     _brightness = GlobalSettings::get().getFloat("windows.simulation view.brightness", _brightness);
@@ -146,6 +147,10 @@ void SimulationView::resize(IntVector2D const& size)
 
 void SimulationView::draw(bool renderSimulation)
 {
+    if (auto parameters = _subscription.pollSimulationParameters()) {
+        _parameters = *parameters;
+    }
+
     if (renderSimulation) {
         updateImageFromSimulation();
 
@@ -177,7 +182,7 @@ void SimulationView::draw(bool renderSimulation)
         glBindTexture(GL_TEXTURE_2D, _textureFramebufferId2);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
-        if (_simulationFacade->getSimulationParameters().markReferenceDomain) {
+        if (_parameters.markReferenceDomain) {
             markReferenceDomain();
         }
 
@@ -291,7 +296,7 @@ void SimulationView::updateImageFromSimulation()
     //draw overlay
     if (_overlay) {
         ImDrawList* drawList = ImGui::GetBackgroundDrawList();
-        auto parameters = _simulationFacade->getSimulationParameters();
+        auto const& parameters = _parameters;
         auto timestep = _simulationFacade->getCurrentTimestep();
         for (auto const& overlayElement : _overlay->elements) {
             if (_isCellDetailOverlayActive && overlayElement.cell) {
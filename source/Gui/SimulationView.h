@@ -6,6 +6,7 @@
 #include "Base/Definitions.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/OverlayDescriptions.h"
+#include "EngineInterface/SimulationSubscription.h"
 
 #include "Definitions.h"
 
@@ -66,4 +67,6 @@ private:
     float _motionBlur = DefaultMotionBlur;
 
     SimulationFacade _simulationFacade;
+    SimulationSubscription _subscription;
+    SimulationParameters _parameters;  //updated from _subscription each frame
 };
@@ -57,7 +57,11 @@ void StartupController::process()
                 deserializedSim.auxiliaryData.timestep,
                 deserializedSim.auxiliaryData.generalSettings,
                 deserializedSim.auxiliaryData.simulationParameters);
-            _simulationFacade->setClusteredSimulationData(deserializedSim.mainData);
+            if (deserializedSim.snapshotFilename) {
+                _simulationFacade->setSimulationDataFromSnapshotFile(*deserializedSim.snapshotFilename);
+            } else {
+                _simulationFacade->setClusteredSimulationData(deserializedSim.mainData);
+            }
             _simulationFacade->setStatisticsHistory(deserializedSim.statistics);
             _simulationFacade->setRealTime(deserializedSim.auxiliaryData.realTime);
             Viewport::get().setCenterInWorldPos(deserializedSim.auxiliaryData.center);
@@ -15,6 +15,7 @@
 #include "Base/StringHelper.h"
 #include "EngineInterface/Colors.h"
 #include "EngineInterface/SimulationFacade.h"
+#include "EngineInterface/StatisticsColumnService.h"
 #include "EngineInterface/StatisticsHistory.h"
 #include "EngineInterface/SerializerService.h"
 
@@ -299,6 +300,10 @@ void StatisticsWindow::processSettings()
 
 void StatisticsWindow::processTimelineStatistics()
 {
+    if (_plotMode == PlotMode_EntireHistory) {
+        updateLongtermStatistics(toInt(ImGui::GetContentRegionAvail().x - scale(RightColumnWidthTimeline)));
+    }
+
     ImGui::Spacing();
     AlienImGui::Group("Time step data");
     ImGui::PushID(1);
@@ -497,40 +502,70 @@ void StatisticsWindow::processPlot(int row, DataPoint DataPointCollection::*valu
     ImGui::PopID();
     ImGui::SameLine();
 
-    auto const& statisticsHistory = _simulationFacade->getStatisticsHistory();
-
-    std::lock_guard lock(statisticsHistory.getMutex());
-    auto longtermStatistics = &statisticsHistory.getDataRef();
-
-    //create dummy history if empty
-    std::vector dummy = {DataPointCollection()};
-    if (longtermStatistics->empty()) {
-        longtermStatistics = &dummy;
+    auto plotWidth = toInt(ImGui::GetContentRegionAvail().x);
+    auto startTime = 0.0;
+    auto endTime = 0.0;
+    if (_plotMode == PlotMode_RealTime) {
+        auto const& history = _timelineLiveStatistics.getDataPointCollectionHistory();
+        endTime = history.empty() ? 0.0 : history.getColumn(StatisticsColumns::TimeColumn)[history.size() - 1];
+        startTime = endTime - toDouble(_timeHorizonForLiveStatistics);
+    } else {
+        startTime = _longtermStatistics->startTime;
+        endTime = _longtermStatistics->endTime;
     }
 
-    auto const& dataPointCollectionHistory = _timelineLiveStatistics.getDataPointCollectionHistory();
-    auto count = _plotMode == 0 ? toInt(dataPointCollectionHistory.size()) : toInt(longtermStatistics->size());
-    auto startTime = _plotMode == 0 ? dataPointCollectionHistory.back().time - toDouble(_timeHorizonForLiveStatistics)
-        : longtermStatistics->back().time - (longtermStatistics->back().time - longtermStatistics->front().time) * toDouble(_timeHorizonForLongtermStatistics) / 100;
-    auto endTime = _plotMode == 0 ? dataPointCollectionHistory.back().time : longtermStatistics->back().time;
-    auto values = _plotMode == 0 ? &(dataPointCollectionHistory[0].*valuesPtr) : &((*longtermStatistics)[0].*valuesPtr);
-    auto timePoints = _plotMode == 0 ? &dataPointCollectionHistory[0].time : &(*longtermStatistics)[0].time;
-    auto systemClock = _plotMode == 0 ? nullptr : &(*longtermStatistics)[0].systemClock;
-
     switch (_plotType) {
     case 0:
-        plotSumColorsIntern(row, values, timePoints, systemClock, count, startTime, endTime, fracPartDecimals);
-        break;
-    case 1:
-        plotByColorIntern(row, values, timePoints, count, startTime, endTime, fracPartDecimals);
+        plotSumColorsIntern(row, createPlotSeries(StatisticsColumns::getColumnIndex(valuesPtr, MAX_COLORS), startTime, endTime, plotWidth), startTime, endTime, fracPartDecimals);
         break;
+    case 1: {
+        std::vector<PlotSeries> seriesByColor;
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            seriesByColor.emplace_back(createPlotSeries(StatisticsColumns::getColumnIndex(valuesPtr, i), startTime, endTime, plotWidth));
+        }
+        plotByColorIntern(row, seriesByColor, startTime, endTime, fracPartDecimals);
+    } break;
     default:
-        plotForColorIntern(row, values, _plotType - 2, timePoints, systemClock, count, startTime, endTime, fracPartDecimals);
+        plotForColorIntern(
+            row,
+            createPlotSeries(StatisticsColumns::getColumnIndex(valuesPtr, _plotType - 2), startTime, endTime, plotWidth),
+            _plotType - 2,
+            startTime,
+            endTime,
+            fracPartDecimals);
         break;
     }
     ImGui::Spacing();
 }
 
+void StatisticsWindow::updateLongtermStatistics(int plotWidth)
+{
+    auto const& history = _simulationFacade->getStatisticsHistory();
+    auto version = history.getVersion();
+    if (_longtermStatistics && _longtermStatistics->version == version && _longtermStatistics->timeHorizon == _timeHorizonForLongtermStatistics
+        && _longtermStatistics->plotWidth == plotWidth) {
+        return;
+    }
+
+    //the amount of queried data points only depends on the plot width and not on the length of the history
+    auto [firstTime, lastTime] = history.getTimeInterval().value_or(std::make_pair(0.0, 0.0));
+    LongtermStatistics result;
+    result.version = version;
+    result.timeHorizon = _timeHorizonForLongtermStatistics;
+    result.plotWidth = plotWidth;
+    result.startTime = lastTime - (lastTime - firstTime) * toDouble(_timeHorizonForLongtermStatistics) / 100;
+    result.endTime = lastTime;
+    result.data = history.query(result.startTime, result.endTime, std::max(1, plotWidth));
+
+    //create dummy history if empty
+    if (result.data.mean.empty()) {
+        result.data.mean.pushBack(DataPointCollection());
+        result.data.minimum.pushBack(DataPointCollection());
+        result.data.maximum.pushBack(DataPointCollection());
+    }
+    _longtermStatistics = std::move(result);
+}
+
 void StatisticsWindow::processBackground()
 {
     auto timepoint = std::chrono::steady_clock::now();
@@ -544,39 +579,49 @@ void StatisticsWindow::processBackground()
     }
 }
 
-namespace
+StatisticsWindow::PlotSeries StatisticsWindow::createPlotSeries(int columnIndex, double startTime, double endTime, int plotWidth) const
 {
-    double getMaxWithDataPointStride(double const* data, double const* timePoints, double startTime, int count)
-    {
-        auto constexpr strideDouble = sizeof(DataPointCollection) / sizeof(double);
+    auto const& columns = _plotMode == PlotMode_RealTime ? _timelineLiveStatistics.getDataPointCollectionHistory() : _longtermStatistics->data.mean;
+    auto minColumns = _plotMode == PlotMode_RealTime ? nullptr : &_longtermStatistics->data.minimum;
+    auto maxColumns = _plotMode == PlotMode_RealTime ? nullptr : &_longtermStatistics->data.maximum;
 
-        auto result = 0.0;
-        for (int i = count / 20; i < count; ++i) {
-            if (timePoints[i * strideDouble] >= startTime - NEAR_ZERO) {
-                result = std::max(result, data[i * strideDouble]);
-            }
-        }
+    auto count = columns.size();
+    auto timePoints = columns.getColumn(StatisticsColumns::TimeColumn);
+    auto values = columns.getColumn(columnIndex);
+
+    PlotSeries result;
+    if (count == 0) {
         return result;
     }
+    auto indices = StatisticsColumnService::decimateMinMax(timePoints, values, count, startTime, endTime, plotWidth);
+    auto gather = [&](std::vector<double>& target, double const* column) {
+        target.reserve(indices.size());
+        for (auto const& index : indices) {
+            target.emplace_back(column[index]);
+        }
+    };
+    gather(result.timePoints, timePoints);
+    gather(result.values, values);
+    if (_plotMode != PlotMode_RealTime) {
+        gather(result.systemClock, columns.getColumn(StatisticsColumns::SystemClockColumn));
+        gather(result.minValues, minColumns->getColumn(columnIndex));
+        gather(result.maxValues, maxColumns->getColumn(columnIndex));
+    }
+
+    //the first data points are not taken into account for the upper bound
+    auto first = std::max(StatisticsColumnService::findFirstIndex(timePoints, count, startTime - NEAR_ZERO), count / 20);
+    if (first < count) {
+        auto maxValues = maxColumns ? maxColumns->getColumn(columnIndex) : values;
+        result.maxValue = std::max(0.0, StatisticsColumnService::getMax(maxValues + first, count - first));
+    }
+    return result;
 }
 
-void StatisticsWindow::plotSumColorsIntern(
-    int row,
-    DataPoint const* dataPoints,
-    double const* timePoints,
-    double const* systemClock,
-    int count,
-    double startTime,
-    double endTime,
-    int fracPartDecimals)
+void StatisticsWindow::plotSumColorsIntern(int row, PlotSeries const& series, double startTime, double endTime, int fracPartDecimals)
 {
-    auto constexpr strideBytes = sizeof(DataPointCollection);
-    auto constexpr strideDouble = sizeof(DataPointCollection) / sizeof(double);
-
-    double const* plotDataY = reinterpret_cast<double const*>(dataPoints) + MAX_COLORS;
-    double upperBound = getMaxWithDataPointStride(plotDataY, timePoints, startTime, count);
-    double endValue = count > 0 ? plotDataY[(count - 1) * strideDouble] : 0.0;
-    upperBound = getUpperBound(upperBound);
+    auto count = toInt(series.values.size());
+    auto upperBound = getUpperBound(series.maxValue);
+    auto endValue = count > 0 ? series.values.back() : 0.0;
 
     ImGui::PushID(row);
     ImPlot::PushStyleColor(ImPlotCol_FrameBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
@@ -598,14 +643,19 @@ void StatisticsWindow::plotSumColorsIntern(
         }
         if (count > 0) {
             ImPlot::PushStyleColor(ImPlotCol_Line, color);
-            ImPlot::PlotLine("##", timePoints, plotDataY, count, 0, 0, strideBytes);
+            ImPlot::PlotLine("##", series.timePoints.data(), series.values.data(), count);
             ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.5f * ImGui::GetStyle().Alpha);
-            ImPlot::PlotShaded("##", timePoints, plotDataY, count, 0, 0, 0, strideBytes);
+            ImPlot::PlotShaded("##", series.timePoints.data(), series.values.data(), count);
             ImPlot::PopStyleVar();
+            if (!series.minValues.empty()) {
+                ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.3f * ImGui::GetStyle().Alpha);
+                ImPlot::PlotShaded("##", series.timePoints.data(), series.minValues.data(), series.maxValues.data(), count);
+                ImPlot::PopStyleVar();
+            }
             ImPlot::PopStyleColor();
         }
         if (ImGui::GetStyle().Alpha == 1.0f && ImPlot::IsPlotHovered() && count > 0) {
-            drawValuesAtMouseCursor(plotDataY, timePoints, systemClock, count, startTime, endTime, upperBound, fracPartDecimals);
+            drawValuesAtMouseCursor(series, startTime, endTime, upperBound, fracPartDecimals);
         }
         ImPlot::EndPlot();
     }
@@ -614,18 +664,11 @@ void StatisticsWindow::plotSumColorsIntern(
     ImGui::PopID();
 }
 
-void StatisticsWindow::plotByColorIntern(
-    int row,
-    DataPoint const* values,
-    double const* timePoints,
-    int count,
-    double startTime,
-    double endTime,
-    int fracPartDecimals)
+void StatisticsWindow::plotByColorIntern(int row, std::vector<PlotSeries> const& seriesByColor, double startTime, double endTime, int fracPartDecimals)
 {
     auto upperBound = 0.0;
-    for (int i = 0; i < MAX_COLORS; ++i) {
-        upperBound = std::max(upperBound, getMaxWithDataPointStride(reinterpret_cast<double const*>(values) + i, timePoints, startTime, count));
+    for (auto const& series : seriesByColor) {
+        upperBound = std::max(upperBound, series.maxValue);
     }
     upperBound = getUpperBound(upperBound);
 
@@ -651,9 +694,10 @@ void StatisticsWindow::plotByColorIntern(
             ImColor color(toInt((colorRaw >> 16) & 0xff), toInt((colorRaw >> 8) & 0xff), toInt(colorRaw & 0xff));
 
             ImPlot::PushStyleColor(ImPlotCol_Line, (ImU32)color);
-            auto endValue = count > 0 ? *(reinterpret_cast<double const*>(reinterpret_cast<DataPointCollection const*>(values) + (count - 1)) + i) : 0.0f;
+            auto const& series = seriesByColor.at(i);
+            auto endValue = !series.values.empty() ? series.values.back() : 0.0;
             auto labelId = StringHelper::format(toFloat(endValue), fracPartDecimals);
-            ImPlot::PlotLine(labelId.c_str(), timePoints, reinterpret_cast<double const*>(values) + i, count, 0, 0, sizeof(DataPointCollection));
+            ImPlot::PlotLine(labelId.c_str(), series.timePoints.data(), series.values.data(), toInt(series.values.size()));
             ImPlot::PopStyleColor();
             ImGui::PopID();
         }
@@ -665,24 +709,11 @@ void StatisticsWindow::plotByColorIntern(
     ImGui::PopID();
 }
 
-void StatisticsWindow::plotForColorIntern(
-    int row,
-    DataPoint const* values,
-    int colorIndex,
-    double const* timePoints,
-    double const* systemClock,
-    int count,
-    double startTime,
-    double endTime,
-    int fracPartDecimals)
+void StatisticsWindow::plotForColorIntern(int row, PlotSeries const& series, int colorIndex, double startTime, double endTime, int fracPartDecimals)
 {
-    auto constexpr strideBytes = sizeof(DataPointCollection);
-    auto constexpr strideDouble = sizeof(DataPointCollection) / sizeof(double);
-
-    auto valuesForColor = reinterpret_cast<double const*>(values) + colorIndex;
-    auto upperBound = getMaxWithDataPointStride(valuesForColor, timePoints, startTime, count);
-    upperBound = getUpperBound(upperBound);
-    auto endValue = count > 0 ? valuesForColor[(count - 1) * strideDouble] : 0.0;
+    auto count = toInt(series.values.size());
+    auto upperBound = getUpperBound(series.maxValue);
+    auto endValue = count > 0 ? series.values.back() : 0.0;
 
     ImGui::PushID(row);
     ImPlot::PushStyleColor(ImPlotCol_FrameBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
@@ -712,13 +743,18 @@ void StatisticsWindow::plotForColorIntern(
         }
         if (count > 0) {
             ImPlot::PushStyleColor(ImPlotCol_Line, color);
-            ImPlot::PlotLine("##", timePoints, valuesForColor, count, 0, 0, strideBytes);
+            ImPlot::PlotLine("##", series.timePoints.data(), series.values.data(), count);
             ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.5f * ImGui::GetStyle().Alpha);
-            ImPlot::PlotShaded("##", timePoints, valuesForColor, count, 0, 0, 0, strideBytes);
+            ImPlot::PlotShaded("##", series.timePoints.data(), series.values.data(), count);
             ImPlot::PopStyleVar();
+            if (!series.minValues.empty()) {
+                ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.3f * ImGui::GetStyle().Alpha);
+                ImPlot::PlotShaded("##", series.timePoints.data(), series.minValues.data(), series.maxValues.data(), count);
+                ImPlot::PopStyleVar();
+            }
             ImPlot::PopStyleColor();
             if (ImGui::GetStyle().Alpha == 1.0f && ImPlot::IsPlotHovered()) {
-                drawValuesAtMouseCursor(valuesForColor, timePoints, systemClock, count, startTime, endTime, upperBound, fracPartDecimals);
+                drawValuesAtMouseCursor(series, startTime, endTime, upperBound, fracPartDecimals);
             }
         }
         ImPlot::EndPlot();
@@ -776,38 +812,29 @@ namespace
     }
 }
 
-void StatisticsWindow::drawValuesAtMouseCursor(
-    double const* dataPoints,
-    double const* timePoints,
-    double const* systemClock,
-    int count,
-    double startTime,
-    double endTime,
-    double upperBound,
-    int fracPartDecimals)
+void StatisticsWindow::drawValuesAtMouseCursor(PlotSeries const& series, double startTime, double endTime, double upperBound, int fracPartDecimals)
 {
-    auto constexpr stride = sizeof(DataPointCollection) / sizeof(double);
-
+    auto count = toInt(series.values.size());
     auto mousePos = ImPlot::GetPlotMousePos();
     mousePos.x = std::max(startTime, std::min(endTime, mousePos.x));
-    mousePos.y = dataPoints[0];
+    mousePos.y = series.values[0];
 
     auto dateTimeString =
         [&] {
-        if (systemClock == nullptr) {
+        if (series.systemClock.empty()) {
             for (int i = 1; i < count; ++i) {
-                if (timePoints[i * stride] > mousePos.x) {
-                    mousePos.y = dataPoints[i * stride];
+                if (series.timePoints[i] > mousePos.x) {
+                    mousePos.y = series.values[i];
                     break;
                 }
             }
             return std::string();
         }
-        auto systemClockEntry = systemClock[0];
+        auto systemClockEntry = series.systemClock[0];
         for (int i = 1; i < count; ++i) {
-            if (timePoints[i * stride] > mousePos.x) {
-                mousePos.y = dataPoints[i * stride];
-                systemClockEntry = systemClock[i * stride];
+            if (series.timePoints[i] > mousePos.x) {
+                mousePos.y = series.values[i];
+                systemClockEntry = series.systemClock[i];
                 break;
             }
         }
@@ -5,6 +5,7 @@
 #include "Base/Singleton.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/StatisticsHistory.h"
 
 #include "Definitions.h"
 #include "AlienWindow.h"
@@ -31,44 +32,32 @@ private:
     void processSettings();
 
     void processTimelineStatistics();
+    void updateLongtermStatistics(int plotWidth);
 
     void processPlot(int row, DataPoint DataPointCollection::*valuesPtr, int fracPartDecimals = 0);
 
     void processBackground() override;
 
-    void plotSumColorsIntern(
-        int row,
-        DataPoint const* dataPoints,
-        double const* timePoints,
-        double const* systemClock,
-        int count,
-        double startTime,
-        double endTime,
-        int fracPartDecimals);
-    void plotByColorIntern(int row, DataPoint const* values, double const* timePoints, int count, double startTime, double endTime, int fracPartDecimals);
-    void plotForColorIntern(
-        int row,
-        DataPoint const* values,
-        int colorIndex,
-        double const* timePoints,
-        double const* systemClock,
-        int count,
-        double startTime,
-        double endTime,
-        int fracPartDecimals);
+    //plotted values of a single column, decimated to the plot width
+    struct PlotSeries
+    {
+        std::vector<double> timePoints;
+        std::vector<double> systemClock;  //empty for real-time statistics
+        std::vector<double> values;
+        std::vector<double> minValues;  //only available for long-term statistics
+        std::vector<double> maxValues;
+        double maxValue = 0;
+    };
+    PlotSeries createPlotSeries(int columnIndex, double startTime, double endTime, int plotWidth) const;
+
+    void plotSumColorsIntern(int row, PlotSeries const& series, double startTime, double endTime, int fracPartDecimals);
+    void plotByColorIntern(int row, std::vector<PlotSeries> const& seriesByColor, double startTime, double endTime, int fracPartDecimals);
+    void plotForColorIntern(int row, PlotSeries const& series, int colorIndex, double startTime, double endTime, int fracPartDecimals);
 
     void setPlotScale();
     double getUpperBound(double maxValue);
 
-    void drawValuesAtMouseCursor(
-        double const* dataPoints,
-        double const* timePoints,
-        double const* systemClock,
-        int count,
-        double startTime,
-        double endTime,
-        double upperBound,
-        int fracPartDecimals);
+    void drawValuesAtMouseCursor(PlotSeries const& series, double startTime, double endTime, double upperBound, int fracPartDecimals);
 
     void validationAndCorrection();
 
@@ -122,6 +111,18 @@ private:
     float _timeHorizonForLiveStatistics = 10.0f;  //in seconds
     float _timeHorizonForLongtermStatistics = 100.0f;  //in percent
     std::optional<std::chrono::steady_clock::time_point> _lastTimepoint;
+
+    //query result of the statistics history, only renewed if the history or the plotted range has changed
+    struct LongtermStatistics
+    {
+        uint64_t version = 0;
+        float timeHorizon = 0;
+        int plotWidth = 0;
+        double startTime = 0;
+        double endTime = 0;
+        StatisticsHistoryQueryResult data;
+    };
+    std::optional<LongtermStatistics> _longtermStatistics;
     TimelineLiveStatistics _timelineLiveStatistics;
     HistogramLiveStatistics _histogramLiveStatistics;
     TableLiveStatistics _tableLiveStatistics;
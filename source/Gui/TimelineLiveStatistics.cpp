@@ -5,9 +5,15 @@
 
 #include "Base/Definitions.h"
 #include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/StatisticsColumnService.h"
 #include "EngineInterface/StatisticsConverterService.h"
 
-std::vector<DataPointCollection> const& TimelineLiveStatistics::getDataPointCollectionHistory() const
+namespace
+{
+    auto constexpr TruncationMargin = 24.0;  //in seconds
+}
+
+StatisticsColumns const& TimelineLiveStatistics::getDataPointCollectionHistory() const
 {
     return _dataPointCollectionHistory;
 }
@@ -22,15 +28,21 @@ void TimelineLiveStatistics::update(TimelineStatistics const& data, uint64_t tim
     _timeSinceSimStart += toDouble(duration) / 1000;
 
     auto newDataPoint = StatisticsConverterService::convert(data, timestep, _timeSinceSimStart, _lastData, _lastTimestep);
-    _dataPointCollectionHistory.emplace_back(newDataPoint);
+    _dataPointCollectionHistory.pushBack(newDataPoint);
     _lastData = data;
     _lastTimestep = timestep;
     _lastTimepoint = timepoint;
 }
 
+//erasing rows moves all columns, hence old data points are erased in batches
 void TimelineLiveStatistics::truncate()
 {
-    if (!_dataPointCollectionHistory.empty() && _dataPointCollectionHistory.back().time - _dataPointCollectionHistory.front().time > (MaxLiveHistory + 1.0)) {
-        _dataPointCollectionHistory.erase(_dataPointCollectionHistory.begin());
+    auto size = _dataPointCollectionHistory.size();
+    if (size == 0) {
+        return;
+    }
+    auto timePoints = _dataPointCollectionHistory.getColumn(StatisticsColumns::TimeColumn);
+    if (timePoints[size - 1] - timePoints[0] > MaxLiveHistory + 1.0 + TruncationMargin) {
+        _dataPointCollectionHistory.eraseFront(StatisticsColumnService::findFirstIndex(timePoints, size, timePoints[size - 1] - (MaxLiveHistory + 1.0)));
     }
 }
@@ -7,13 +7,14 @@
 #include "EngineInterface/Colors.h"
 #include "EngineInterface/RawStatisticsData.h"
 #include "EngineInterface/DataPointCollection.h"
+#include "EngineInterface/StatisticsColumns.h"
 
 class TimelineLiveStatistics
 {
 public:
     static auto constexpr MaxLiveHistory = 240.0f;  //in seconds
 
-    std::vector<DataPointCollection> const& getDataPointCollectionHistory() const;
+    StatisticsColumns const& getDataPointCollectionHistory() const;
     void update(TimelineStatistics const& statistics, uint64_t timestep);
 
 private:
@@ -21,7 +22,7 @@ private:
 
     double _timeSinceSimStart = 0;  //in seconds
 
-    std::vector<DataPointCollection> _dataPointCollectionHistory;
+    StatisticsColumns _dataPointCollectionHistory;
 
     std::optional<uint64_t> _lastTimestep;
     std::optional<std::chrono::steady_clock::time_point> _lastTimepoint;
@@ -0,0 +1,61 @@
+#include "MetricsEndpointService.h"
+
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#include <cpp-httplib/httplib.h>
+
+#include "Base/LoggingService.h"
+#include "Base/MetricsService.h"
+
+MetricsEndpointService::MetricsEndpointService() = default;
+
+MetricsEndpointService::~MetricsEndpointService()
+{
+    stop();
+}
+
+bool MetricsEndpointService::start(int port)
+{
+    stop();
+
+    _server = std::make_unique<httplib::Server>();
+    _server->Get("/metrics", [](httplib::Request const&, httplib::Response& response) {
+        response.set_content(MetricsService::get().getMetricsDump(), "text/plain");
+    });
+    _server->Get("/trace", [](httplib::Request const&, httplib::Response& response) {
+        response.set_content(MetricsService::get().getChromeTraceJson(), "application/json");
+    });
+    _server->Post("/enable", [](httplib::Request const&, httplib::Response& response) {
+        MetricsService::get().setEnabled(true);
+        response.set_content("enabled", "text/plain");
+    });
+    _server->Post("/disable", [](httplib::Request const&, httplib::Response& response) {
+        MetricsService::get().setEnabled(false);
+        response.set_content("disabled", "text/plain");
+    });
+
+    if (!_server->bind_to_port("127.0.0.1", port)) {
+        log(Priority::Important, "metrics: port " + std::to_string(port) + " could not be bound");
+        _server.reset();
+        return false;
+    }
+    _thread = std::make_unique<std::thread>([this] { _server->listen_after_bind(); });
+    log(Priority::Important, "metrics: endpoint started on port " + std::to_string(port));
+    return true;
+}
+
+void MetricsEndpointService::stop()
+{
+    if (_server) {
+        _server->stop();
+    }
+    if (_thread) {
+        _thread->join();
+        _thread.reset();
+    }
+    _server.reset();
+}
+
+bool MetricsEndpointService::isRunning() const
+{
+    return _server != nullptr;
+}
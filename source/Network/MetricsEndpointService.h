@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+#include <thread>
+
+#include "Base/Singleton.h"
+
+namespace httplib
+{
+    class Server;
+}
+
+//local HTTP endpoint for the metrics of MetricsService, it only accepts connections from localhost
+//GET /metrics returns the metrics dump, GET /trace returns the Chrome trace JSON, POST /enable and POST /disable switch the collection
+//POST requests need a (possibly empty) body, e.g. curl -d "" http://localhost:<port>/enable
+class MetricsEndpointService
+{
+    MAKE_SINGLETON_NO_DEFAULT_CONSTRUCTION(MetricsEndpointService);
+
+public:
+    ~MetricsEndpointService();
+
+    bool start(int port);  //returns false if the port could not be bound
+    void stop();
+    bool isRunning() const;
+
+private:
+    MetricsEndpointService();
+
+    std::unique_ptr<httplib::Server> _server;
+    std::unique_ptr<std::thread> _thread;
+};
@@ -10,6 +10,7 @@
 
 #include "Base/GlobalSettings.h"
 #include "Base/LoggingService.h"
+#include "Base/MetricsService.h"
 #include "Base/Resources.h"
 
 #include "NetworkResourceParserService.h"
@@ -28,14 +29,17 @@ namespace
         }
     }
 
-    httplib::Result executeRequest(std::function<httplib::Result()> const& func, bool withRetry = true)
+    //metricName should name the requested resource and must be a string literal
+    httplib::Result executeRequest(char const* metricName, std::function<httplib::Result()> const& func, bool withRetry = true)
     {
+        MEASURE_SCOPE(metricName);
         auto attempt = 0;
         while (true) {
             auto result = func();
             if (result) {
                 return result;
             }
+            MetricsService::incrementCounter("network.failedAttempts");
             if (++attempt == 5 || !withRetry) {
                 throw std::runtime_error("Error connecting to the server.");
             }
@@ -112,7 +116,7 @@ bool NetworkService::createUser(std::string const& userName, std::string const&
     params.emplace("email", email);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/createuser.php", params); });
+        auto result = executeRequest("network.createuser", [&] { return client.Post("/alien-server/createuser.php", params); });
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -136,7 +140,7 @@ bool NetworkService::activateUser(std::string const& userName, std::string const
     }
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/activateuser.php", params); });
+        auto result = executeRequest("network.activateuser", [&] { return client.Post("/alien-server/activateuser.php", params); });
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -159,7 +163,7 @@ bool NetworkService::login(LoginErrorCode& errorCode, std::string const& userNam
     }
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/login.php", params); });
+        auto result = executeRequest("network.login", [&] { return client.Post("/alien-server/login.php", params); });
 
         auto boolResult = parseBoolResult(result->body);
         if (boolResult) {
@@ -194,7 +198,7 @@ bool NetworkService::logout()
         params.emplace("password", *_password);
 
         try {
-            result = executeRequest([&] { return client.Post("/alien-server/logout.php", params); });
+            result = executeRequest("network.logout", [&] { return client.Post("/alien-server/logout.php", params); });
         } catch (...) {
             logNetworkError();
             result = false;
@@ -219,7 +223,7 @@ void NetworkService::refreshLogin()
         params.emplace("password", *_password);
 
         try {
-            executeRequest([&] { return client.Post("/alien-server/refreshlogin.php", params); });
+            executeRequest("network.refreshlogin", [&] { return client.Post("/alien-server/refreshlogin.php", params); });
         } catch (...) {
         }
     }
@@ -237,7 +241,7 @@ bool NetworkService::deleteUser()
     params.emplace("password", *_password);
 
     try {
-        auto postResult = executeRequest([&] { return client.Post("/alien-server/deleteuser.php", params); });
+        auto postResult = executeRequest("network.deleteuser", [&] { return client.Post("/alien-server/deleteuser.php", params); });
 
         auto result = parseBoolResult(postResult->body);
         if (result) {
@@ -262,7 +266,7 @@ bool NetworkService::resetPassword(std::string const& userName, std::string cons
     params.emplace("email", email);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/resetpw.php", params); });
+        auto result = executeRequest("network.resetpw", [&] { return client.Post("/alien-server/resetpw.php", params); });
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -283,7 +287,7 @@ bool NetworkService::setNewPassword(std::string const& userName, std::string con
     params.emplace("activationCode", confirmationCode);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/setnewpw.php", params); });
+        auto result = executeRequest("network.setnewpw", [&] { return client.Post("/alien-server/setnewpw.php", params); });
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -306,7 +310,8 @@ bool NetworkService::getNetworkResources(std::vector<NetworkResourceRawTO>& resu
     }
 
     try {
-        auto postResult = executeRequest([&] { return client.Post("/alien-server/getversionedsimulationlist.php", params); }, withRetry);
+        auto postResult = executeRequest(
+            "network.getversionedsimulationlist", [&] { return client.Post("/alien-server/getversionedsimulationlist.php", params); }, withRetry);
 
         std::stringstream stream(postResult->body);
         boost::property_tree::ptree tree;
@@ -328,7 +333,7 @@ bool NetworkService::getUserList(std::vector<UserTO>& result, bool withRetry)
 
     try {
         httplib::Params params;
-        auto postResult = executeRequest([&] { return client.Post("/alien-server/getuserlist.php", params); }, withRetry);
+        auto postResult = executeRequest("network.getuserlist", [&] { return client.Post("/alien-server/getuserlist.php", params); }, withRetry);
 
         std::stringstream stream(postResult->body);
         boost::property_tree::ptree tree;
@@ -357,7 +362,7 @@ bool NetworkService::getEmojiTypeByResourceId(std::unordered_map<std::string, in
     params.emplace("password", *_password);
 
     try {
-        auto postResult = executeRequest([&] { return client.Post("/alien-server/getlikedsimulations.php", params); });
+        auto postResult = executeRequest("network.getlikedsimulations", [&] { return client.Post("/alien-server/getlikedsimulations.php", params); });
 
         std::stringstream stream(postResult->body);
         boost::property_tree::ptree tree;
@@ -386,7 +391,7 @@ bool NetworkService::getUserNamesForResourceAndEmojiType(std::set<std::string>&
     params.emplace("likeType", std::to_string(likeType));
 
     try {
-        auto postResult = executeRequest([&] { return client.Post("/alien-server/getuserlikes.php", params); });
+        auto postResult = executeRequest("network.getuserlikes", [&] { return client.Post("/alien-server/getuserlikes.php", params); });
 
         std::stringstream stream(postResult->body);
         boost::property_tree::ptree tree;
@@ -418,7 +423,7 @@ bool NetworkService::toggleReactToResource(std::string const& simId, int likeTyp
 
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/togglelikesimulation.php", params); });
+        auto result = executeRequest("network.togglelikesimulation", [&] { return client.Post("/alien-server/togglelikesimulation.php", params); });
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -468,7 +473,7 @@ bool NetworkService::uploadResource(
     };
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/uploadsimulation.php", items); });
+        auto result = executeRequest("network.uploadsimulation", [&] { return client.Post("/alien-server/uploadsimulation.php", items); });
         if (parseBoolResult(result->body)) {
             resourceId = parseValueFromKey<std::string>(result->body, "simId");
         } else {
@@ -526,7 +531,7 @@ bool NetworkService::replaceResource(
     };
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/replacesimulation.php", items); });
+        auto result = executeRequest("network.replacesimulation", [&] { return client.Post("/alien-server/replacesimulation.php", items); });
         if (!parseBoolResult(result->body)) {
             return false;
         }
@@ -571,7 +576,7 @@ bool NetworkService::downloadResource(std::string& mainData, std::string& auxili
                 for (int chunkIndex = 0; chunkIndex < 6; ++chunkIndex) {
                     auto paramsClone = params;
                     paramsClone.emplace("chunkIndex", std::to_string(chunkIndex));
-                    auto result = executeRequest([&] { return client.Get("/alien-server/downloadcontent.php", paramsClone, {}); });
+                    auto result = executeRequest("network.downloadcontent", [&] { return client.Get("/alien-server/downloadcontent.php", paramsClone, {}); });
                     if (result->body.empty()) {
                         break;
                     }
@@ -579,11 +584,11 @@ bool NetworkService::downloadResource(std::string& mainData, std::string& auxili
                 }
             }
             {
-                auto result = executeRequest([&] { return client.Get("/alien-server/downloadsettings.php", params, {}); });
+                auto result = executeRequest("network.downloadsettings", [&] { return client.Get("/alien-server/downloadsettings.php", params, {}); });
                 auxiliaryData = result->body;
             }
             {
-                auto result = executeRequest([&] { return client.Get("/alien-server/downloadstatistics.php", params, {}); });
+                auto result = executeRequest("network.downloadstatistics", [&] { return client.Get("/alien-server/downloadstatistics.php", params, {}); });
                 statistics = result->body;
             }
             _downloadCache.insertOrAssign(simId, ResourceData{mainData, auxiliaryData, statistics});
@@ -605,7 +610,7 @@ void NetworkService::incDownloadCounter(std::string const& simId)
 
         httplib::Params params;
         params.emplace("id", simId);
-        executeRequest([&] { return client.Get("/alien-server/incdownloadcount.php", params, {}); });
+        executeRequest("network.incdownloadcount", [&] { return client.Get("/alien-server/incdownloadcount.php", params, {}); });
     }
     catch(...) {
        //do nothing 
@@ -627,7 +632,7 @@ bool NetworkService::editResource(std::string const& simId, std::string const& n
     params.emplace("newDescription", newDescription);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/editsimulation.php", params); });
+        auto result = executeRequest("network.editsimulation", [&] { return client.Post("/alien-server/editsimulation.php", params); });
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -649,7 +654,7 @@ bool NetworkService::moveResource(std::string const& simId, WorkspaceType target
     params.emplace("targetWorkspace", std::to_string(targetWorkspace));
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/movesimulation.php", params); });
+        auto result = executeRequest("network.movesimulation", [&] { return client.Post("/alien-server/movesimulation.php", params); });
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -670,7 +675,7 @@ bool NetworkService::deleteResource(std::string const& simId)
     params.emplace("simId", simId);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/deletesimulation.php", params); });
+        auto result = executeRequest("network.deletesimulation", [&] { return client.Post("/alien-server/deletesimulation.php", params); });
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -692,7 +697,7 @@ bool NetworkService::appendResourceData(std::string const& resourceId, std::stri
     };
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/appendsimulationdata.php", items); });
+        auto result = executeRequest("network.appendsimulationdata", [&] { return client.Post("/alien-server/appendsimulationdata.php", items); });
         if (!parseBoolResult(result->body)) {
             return false;
         }
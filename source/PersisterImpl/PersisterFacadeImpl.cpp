@@ -66,6 +66,16 @@ SaveSimulationResultData _PersisterFacadeImpl::fetchSavedSimulationData(Persiste
     return fetchData<_SaveSimulationRequestResult, SaveSimulationResultData>(id);
 }
 
+PersisterRequestId _PersisterFacadeImpl::scheduleAutosaveSimulation(SenderInfo const& senderInfo, AutosaveSimulationRequestData const& data)
+{
+    return scheduleRequest<_AutosaveSimulationRequest>(senderInfo, data, true);
+}
+
+AutosaveSimulationResultData _PersisterFacadeImpl::fetchAutosaveSimulationData(PersisterRequestId const& id)
+{
+    return fetchData<_AutosaveSimulationRequestResult, AutosaveSimulationResultData>(id);
+}
+
 PersisterRequestId _PersisterFacadeImpl::scheduleReadSimulationFromFile(SenderInfo const& senderInfo, ReadSimulationRequestData const& data)
 {
     return scheduleRequest<_ReadSimulationRequest>(senderInfo, data);
@@ -25,6 +25,9 @@ public:
     PersisterRequestId scheduleSaveSimulationToFile(SenderInfo const& senderInfo, SaveSimulationRequestData const& data) override;
     SaveSimulationResultData fetchSavedSimulationData(PersisterRequestId const& id) override;
 
+    PersisterRequestId scheduleAutosaveSimulation(SenderInfo const& senderInfo, AutosaveSimulationRequestData const& data) override;
+    AutosaveSimulationResultData fetchAutosaveSimulationData(PersisterRequestId const& id) override;
+
     PersisterRequestId scheduleReadSimulationFromFile(SenderInfo const& senderInfo, ReadSimulationRequestData const& data) override;
     ReadSimulationResultData fetchReadSimulationData(PersisterRequestId const& id) override;
 
@@ -62,7 +65,7 @@ private:
     static auto constexpr MaxWorkerThreads = 4;
 
     template<typename Request, typename RequestData>
-    PersisterRequestId scheduleRequest(SenderInfo const& senderInfo, RequestData const& data);
+    PersisterRequestId scheduleRequest(SenderInfo const& senderInfo, RequestData const& data, bool prioritized = false);
 
     template <typename RequestResult, typename ResultData>
     ResultData fetchData(PersisterRequestId const& id);
@@ -80,12 +83,12 @@ private:
 /************************************************************************/
 
 template <typename Request, typename RequestData>
-PersisterRequestId _PersisterFacadeImpl::scheduleRequest(SenderInfo const& senderInfo, RequestData const& data)
+PersisterRequestId _PersisterFacadeImpl::scheduleRequest(SenderInfo const& senderInfo, RequestData const& data, bool prioritized)
 {
     auto requestId = generateNewRequestId();
     auto request = std::make_shared<Request>(requestId, senderInfo, data);
 
-    _worker->addRequest(request);
+    _worker->addRequest(request, prioritized);
 
     return requestId;
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+
+#include "PersisterInterface/AutosaveSimulationRequestData.h"
 #include "PersisterInterface/DeleteNetworkResourceRequestData.h"
 #include "PersisterInterface/DownloadNetworkResourceRequestData.h"
 #include "PersisterInterface/EditNetworkResourceRequestData.h"
@@ -20,17 +23,21 @@ class _PersisterRequest
 public:
     PersisterRequestId const& getRequestId() const { return _requestId; }
     SenderInfo const& getSenderInfo() const { return _senderInfo; }
+    std::chrono::steady_clock::time_point const& getCreationTimepoint() const { return _creationTimepoint; }
 
 protected:
     _PersisterRequest(PersisterRequestId const& requestId, SenderInfo const& senderInfo)
         : _requestId(requestId)
-        , _senderInfo(senderInfo) {}
+        , _senderInfo(senderInfo)
+        , _creationTimepoint(std::chrono::steady_clock::now())
+    {}
 
     virtual ~_PersisterRequest() = default;
 
 private:
     PersisterRequestId _requestId;
     SenderInfo _senderInfo;
+    std::chrono::steady_clock::time_point _creationTimepoint;
 };
 
 using PersisterRequest = std::shared_ptr<_PersisterRequest>;
@@ -59,6 +66,9 @@ using ConcreteRequest = std::shared_ptr<_ConcreteRequest<Data_t>>;
 using _SaveSimulationRequest = _ConcreteRequest<SaveSimulationRequestData>;
 using SaveSimulationRequest = std::shared_ptr<_SaveSimulationRequest>;
 
+using _AutosaveSimulationRequest = _ConcreteRequest<AutosaveSimulationRequestData>;
+using AutosaveSimulationRequest = std::shared_ptr<_AutosaveSimulationRequest>;
+
 using _ReadSimulationRequest = _ConcreteRequest<ReadSimulationRequestData>;
 using ReadSimulationRequest = std::shared_ptr<_ReadSimulationRequest>;
 
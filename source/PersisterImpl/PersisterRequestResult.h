@@ -1,5 +1,6 @@
 #pragma once
 
+#include "PersisterInterface/AutosaveSimulationResultData.h"
 #include "PersisterInterface/ReadSimulationResultData.h"
 #include "PersisterInterface/PersisterRequestId.h"
 #include "PersisterInterface/SaveSimulationResultData.h"
@@ -39,6 +40,7 @@ template <typename Data_t>
 using ConcreteRequestResult = std::shared_ptr<_ConcreteRequestResult<Data_t>>;
 
 using _SaveSimulationRequestResult = _ConcreteRequestResult<SaveSimulationResultData>;
+using _AutosaveSimulationRequestResult = _ConcreteRequestResult<AutosaveSimulationResultData>;
 using _ReadSimulationRequestResult = _ConcreteRequestResult<ReadSimulationResultData>;
 using _LoginRequestResult = _ConcreteRequestResult<LoginResultData>;
 using _GetNetworkResourcesRequestResult = _ConcreteRequestResult<GetNetworkResourcesResultData>;
@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <stdexcept>
 
 #include <Fonts/IconsFontAwesome5.h>
 
 #include "Base/LoggingService.h"
+#include "Base/MetricsService.h"
 #include "EngineInterface/GenomeDescriptionService.h"
 #include "EngineInterface/SerializerService.h"
 #include "EngineInterface/SimulationFacade.h"
@@ -19,6 +21,7 @@ _PersisterWorker::_PersisterWorker(SimulationFacade const& simulationFacade)
 
 void _PersisterWorker::runThreadLoop()
 {
+    MetricsService::setThreadName("persister worker");
     std::unique_lock lock(_requestMutex);
     while (!_isShutdown.load()) {
         _conditionVariable.wait(lock);
@@ -63,12 +66,17 @@ PersisterRequestState _PersisterWorker::getRequestState(PersisterRequestId const
     THROW_NOT_IMPLEMENTED();
 }
 
-void _PersisterWorker::addRequest(PersisterRequest const& job)
+void _PersisterWorker::addRequest(PersisterRequest const& job, bool prioritized)
 {
     {
         std::unique_lock uniqueLock(_requestMutex);
 
-        _openRequests.emplace_back(job);
+        if (prioritized) {
+            _openRequests.emplace_front(job);
+        } else {
+            _openRequests.emplace_back(job);
+        }
+        MetricsService::setGauge("persister.queueDepth", toDouble(_openRequests.size()));
     }
     _conditionVariable.notify_all();
 }
@@ -126,6 +134,8 @@ void _PersisterWorker::processRequests(std::unique_lock<std::mutex>& lock)
 
         auto request = _openRequests.front();
         _openRequests.pop_front();
+        MetricsService::setGauge("persister.queueDepth", toDouble(_openRequests.size()));
+        MetricsService::addDuration("persister.queueWait", request->getCreationTimepoint(), std::chrono::steady_clock::now());
 
         _inProgressRequests.push_back(request);
 
@@ -133,6 +143,9 @@ void _PersisterWorker::processRequests(std::unique_lock<std::mutex>& lock)
         if (auto const& concreteRequest = std::dynamic_pointer_cast<_SaveSimulationRequest>(request)) {
             processingResult = processRequest(lock, concreteRequest);
         }
+        if (auto const& concreteRequest = std::dynamic_pointer_cast<_AutosaveSimulationRequest>(request)) {
+            processingResult = processRequest(lock, concreteRequest);
+        }
         if (auto const& concreteRequest = std::dynamic_pointer_cast<_ReadSimulationRequest>(request)) {
             processingResult = processRequest(lock, concreteRequest);
         }
@@ -160,6 +173,10 @@ void _PersisterWorker::processRequests(std::unique_lock<std::mutex>& lock)
         auto inProgressJobsIter = std::ranges::find_if(
             _inProgressRequests, [&](PersisterRequest const& otherRequest) { return otherRequest->getRequestId() == request->getRequestId(); });
         _inProgressRequests.erase(inProgressJobsIter);
+        MetricsService::addDuration("persister.latency", request->getCreationTimepoint(), std::chrono::steady_clock::now());
+        if (std::holds_alternative<PersisterRequestError>(processingResult)) {
+            MetricsService::incrementCounter("persister.errors");
+        }
 
         if (std::holds_alternative<PersisterRequestResult>(processingResult)) {
             if (request->getSenderInfo().wishResultData) {
@@ -190,23 +207,18 @@ namespace
 auto _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, SaveSimulationRequest const& request) -> PersisterRequestResultOrError
 {
     UnlockGuard unlockGuard(lock);
+    MEASURE_SCOPE("persister.saveSimulation");
 
     auto const& requestData = request->getData();
 
     DeserializedSimulation deserializedData;
+    ClusteredDataReader mainDataReader;
     std::string simulationName;
     std::chrono::system_clock::time_point timePoint;
     try {
         simulationName = _simulationFacade->getSimulationName();
         timePoint = std::chrono::system_clock::now();
-        deserializedData.auxiliaryData.timestep = static_cast<uint32_t>(_simulationFacade->getCurrentTimestep());
-        deserializedData.auxiliaryData.realTime = _simulationFacade->getRealTime();
-        deserializedData.auxiliaryData.zoom = requestData.zoom;
-        deserializedData.auxiliaryData.center = requestData.center;
-        deserializedData.auxiliaryData.generalSettings = _simulationFacade->getGeneralSettings();
-        deserializedData.auxiliaryData.simulationParameters = _simulationFacade->getSimulationParameters();
-        deserializedData.statistics = _simulationFacade->getStatisticsHistory().getCopiedData();
-        deserializedData.mainData = _simulationFacade->getClusteredSimulationData();
+        obtainSimulationData(deserializedData, mainDataReader, requestData.zoom, requestData.center);
     } catch (...) {
         return std::make_shared<_PersisterRequestError>(
             request->getRequestId(),
@@ -215,7 +227,9 @@ auto _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, SaveSi
     }
 
     try {
-        SerializerService::serializeSimulationToFiles(requestData.filename, deserializedData);
+        if (!SerializerService::serializeSimulationToFiles(requestData.filename, deserializedData, mainDataReader)) {
+            throw std::runtime_error("Serialization failed.");
+        }
 
         return std::make_shared<_SaveSimulationRequestResult>(
             request->getRequestId(), SaveSimulationResultData{simulationName, deserializedData.auxiliaryData.timestep, timePoint});
@@ -227,9 +241,49 @@ auto _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, SaveSi
     }
 }
 
+auto _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, AutosaveSimulationRequest const& request) -> PersisterRequestResultOrError
+{
+    UnlockGuard unlockGuard(lock);
+    MEASURE_SCOPE("persister.autosaveSimulation");
+
+    auto const& requestData = request->getData();
+    auto startTimePoint = std::chrono::steady_clock::now();
+
+    DeserializedSimulation deserializedData;
+    ClusteredDataReader mainDataReader;
+    std::string simulationName;
+    try {
+        simulationName = _simulationFacade->getSimulationName();
+        obtainSimulationData(deserializedData, mainDataReader, requestData.zoom, requestData.center);
+    } catch (...) {
+        return std::make_shared<_PersisterRequestError>(
+            request->getRequestId(),
+            request->getSenderInfo().senderId,
+            PersisterErrorInfo{"The simulation could not be autosaved because no valid data could be obtained from the GPU."});
+    }
+
+    try {
+        SerializerService::rotateSimulationFiles(requestData.filename, requestData.numSlots);
+        if (!SerializerService::serializeSimulationToFiles(requestData.filename, deserializedData, mainDataReader)) {
+            throw std::runtime_error("Serialization failed.");
+        }
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimePoint);
+        auto bytesWritten = SerializerService::getSimulationFilesSize(requestData.filename);
+
+        return std::make_shared<_AutosaveSimulationRequestResult>(
+            request->getRequestId(), AutosaveSimulationResultData{simulationName, deserializedData.auxiliaryData.timestep, duration, bytesWritten});
+    } catch (...) {
+        return std::make_shared<_PersisterRequestError>(
+            request->getRequestId(),
+            request->getSenderInfo().senderId,
+            PersisterErrorInfo{"The simulation could not be autosaved because an error occurred when serializing the data to the file."});
+    }
+}
+
 auto _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, ReadSimulationRequest const& request) -> PersisterRequestResultOrError
 {
     UnlockGuard unlockGuard(lock);
+    MEASURE_SCOPE("persister.readSimulation");
 
     try {
         auto const& requestData = request->getData();
@@ -252,6 +306,7 @@ auto _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, ReadSi
 _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, LoginRequest const& request)
 {
     UnlockGuard unlockGuard(lock);
+    MEASURE_SCOPE("persister.login");
 
     auto const& requestData = request->getData();
 
@@ -273,6 +328,7 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
 _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, GetNetworkResourcesRequest const& request)
 {
     UnlockGuard unlockGuard(lock);
+    MEASURE_SCOPE("persister.getNetworkResources");
 
     NetworkService::get().refreshLogin();
 
@@ -302,6 +358,7 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
     DownloadNetworkResourceRequest const& request)
 {
     UnlockGuard unlockGuard(lock);
+    MEASURE_SCOPE("persister.downloadNetworkResource");
 
     auto const& requestData = request->getData();
     DownloadNetworkResourceResultData resultData;
@@ -357,6 +414,7 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
     UploadNetworkResourceRequest const& request)
 {
     UnlockGuard unlockGuard(lock);
+    MEASURE_SCOPE("persister.uploadNetworkResource");
 
     auto const& requestData = request->getData();
     DownloadNetworkResourceResultData resultData;
@@ -379,7 +437,7 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
             deserializedSim.auxiliaryData.center = simulationData.center;
             deserializedSim.auxiliaryData.generalSettings = _simulationFacade->getGeneralSettings();
             deserializedSim.auxiliaryData.simulationParameters = _simulationFacade->getSimulationParameters();
-            deserializedSim.statistics = _simulationFacade->getStatisticsHistory().getCopiedData();
+            deserializedSim.statistics = _simulationFacade->getStatisticsHistory().getSnapshot();
             deserializedSim.mainData = _simulationFacade->getClusteredSimulationData();
         } catch (...) {
             return std::make_shared<_PersisterRequestError>(
@@ -448,6 +506,7 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
     ReplaceNetworkResourceRequest const& request)
 {
     UnlockGuard unlockGuard(lock);
+    MEASURE_SCOPE("persister.replaceNetworkResource");
 
     auto const& requestData = request->getData();
 
@@ -469,7 +528,7 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
             deserializedSim.auxiliaryData.center = simulationData.center;
             deserializedSim.auxiliaryData.generalSettings = _simulationFacade->getGeneralSettings();
             deserializedSim.auxiliaryData.simulationParameters = _simulationFacade->getSimulationParameters();
-            deserializedSim.statistics = _simulationFacade->getStatisticsHistory().getCopiedData();
+            deserializedSim.statistics = _simulationFacade->getStatisticsHistory().getSnapshot();
             deserializedSim.mainData = _simulationFacade->getClusteredSimulationData();
         } catch (...) {
             return std::make_shared<_PersisterRequestError>(
@@ -523,6 +582,7 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
 _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, GetUserNamesForEmojiRequest const& request)
 {
     UnlockGuard unlockGuard(lock);
+    MEASURE_SCOPE("persister.getUserNamesForEmoji");
 
     auto const& requestData = request->getData();
 
@@ -542,6 +602,7 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
     DeleteNetworkResourceRequest const& request)
 {
     UnlockGuard unlockGuard(lock);
+    MEASURE_SCOPE("persister.deleteNetworkResource");
 
     auto const& requestData = request->getData();
 
@@ -552,3 +613,15 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
 
     return std::make_shared<_DeleteNetworkResourceRequestResult>(request->getRequestId(), DeleteNetworkResourceResultData{});
 }
+
+void _PersisterWorker::obtainSimulationData(DeserializedSimulation& data, ClusteredDataReader& mainDataReader, float zoom, RealVector2D const& center) const
+{
+    data.auxiliaryData.timestep = static_cast<uint32_t>(_simulationFacade->getCurrentTimestep());
+    data.auxiliaryData.realTime = _simulationFacade->getRealTime();
+    data.auxiliaryData.zoom = zoom;
+    data.auxiliaryData.center = center;
+    data.auxiliaryData.generalSettings = _simulationFacade->getGeneralSettings();
+    data.auxiliaryData.simulationParameters = _simulationFacade->getSimulationParameters();
+    data.statistics = _simulationFacade->getStatisticsHistory().getSnapshot();
+    mainDataReader = _simulationFacade->getClusteredSimulationDataReader();
+}
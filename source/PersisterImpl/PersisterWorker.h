@@ -24,7 +24,7 @@ public:
     bool isBusy() const;
     PersisterRequestState getRequestState(PersisterRequestId const& id) const;
 
-    void addRequest(PersisterRequest const& job);
+    void addRequest(PersisterRequest const& job, bool prioritized);
     PersisterRequestResult fetchRequestResult(PersisterRequestId const& id);   
     PersisterRequestError fetchJobError(PersisterRequestId const& id);   
 
@@ -35,6 +35,7 @@ private:
 
     using PersisterRequestResultOrError = std::variant<PersisterRequestResult, PersisterRequestError>;
     PersisterRequestResultOrError processRequest(std::unique_lock<std::mutex>& lock, SaveSimulationRequest const& job);
+    PersisterRequestResultOrError processRequest(std::unique_lock<std::mutex>& lock, AutosaveSimulationRequest const& request);
     PersisterRequestResultOrError processRequest(std::unique_lock<std::mutex>& lock, ReadSimulationRequest const& request);
     PersisterRequestResultOrError processRequest(std::unique_lock<std::mutex>& lock, LoginRequest const& request);
     PersisterRequestResultOrError processRequest(std::unique_lock<std::mutex>& lock, GetNetworkResourcesRequest const& request);
@@ -44,6 +45,9 @@ private:
     PersisterRequestResultOrError processRequest(std::unique_lock<std::mutex>& lock, GetUserNamesForEmojiRequest const& request);
     PersisterRequestResultOrError processRequest(std::unique_lock<std::mutex>& lock, DeleteNetworkResourceRequest const& request);
 
+    //only the readback of the main data blocks the simulation, it is converted chunk by chunk while serializing
+    void obtainSimulationData(DeserializedSimulation& data, ClusteredDataReader& mainDataReader, float zoom, RealVector2D const& center) const;
+
     SimulationFacade _simulationFacade;
 
     std::atomic<bool> _isShutdown{false};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+
+#include "Base/Vector2D.h"
+
+struct AutosaveSimulationRequestData
+{
+    std::string filename;
+    int numSlots = 1;  //previous autosaves are kept in the slots filename.1, ..., filename.(numSlots - 1) (in front of the extension)
+    float zoom = 1.0f;
+    RealVector2D center;
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+struct AutosaveSimulationResultData
+{
+    std::string name;
+    uint64_t timestep = 0;
+    std::chrono::milliseconds duration;  //from the GPU readback until all files are written
+    uint64_t bytesWritten = 0;
+};
@@ -5,6 +5,8 @@
 
 #include "EngineInterface/Definitions.h"
 
+#include "AutosaveSimulationRequestData.h"
+#include "AutosaveSimulationResultData.h"
 #include "Definitions.h"
 #include "DeleteNetworkResourceRequestData.h"
 #include "DeleteNetworkResourceResultData.h"
@@ -56,6 +58,10 @@ public:
     virtual PersisterRequestId scheduleSaveSimulationToFile(SenderInfo const& senderInfo, SaveSimulationRequestData const& data) = 0;
     virtual SaveSimulationResultData fetchSavedSimulationData(PersisterRequestId const& id) = 0;
 
+    //prioritized over all other requests in the queue, the GPU is only blocked for the readback
+    virtual PersisterRequestId scheduleAutosaveSimulation(SenderInfo const& senderInfo, AutosaveSimulationRequestData const& data) = 0;
+    virtual AutosaveSimulationResultData fetchAutosaveSimulationData(PersisterRequestId const& id) = 0;
+
     virtual PersisterRequestId scheduleReadSimulationFromFile(SenderInfo const& senderInfo, ReadSimulationRequestData const& data) = 0;
     virtual ReadSimulationResultData fetchReadSimulationData(PersisterRequestId const& id) = 0;
 